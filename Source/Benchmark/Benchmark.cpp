@@ -0,0 +1,116 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace benchmark
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BenchmarkRegistry::Add
+
+      Summary:  Registers a benchmark, called by BENCHMARK during
+                static initialization
+
+      Args:     PCSTR pszName
+                  Name the benchmark is run by
+                BenchmarkFunction benchmark
+                  Body of the benchmark
+
+      Returns:  BOOL
+                  Always TRUE
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL BenchmarkRegistry::Add(_In_ PCSTR pszName, _In_ BenchmarkFunction benchmark)
+    {
+        getBenchmarks().push_back(Benchmark{ .pszName = pszName, .Run = benchmark });
+
+        return TRUE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BenchmarkRegistry::Run
+
+      Summary:  Runs the benchmarks with the given names in the given
+                order. Benchmarks take seconds, so none runs unless it
+                is named, and without names the registered ones are
+                listed instead
+
+      Args:     INT iNumNames
+                  Number of names
+                const PCSTR* ppszNames
+                  Names of the benchmarks to run
+
+      Returns:  UINT
+                  Number of names no benchmark is registered by
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT BenchmarkRegistry::Run(_In_ INT iNumNames, _In_reads_(iNumNames) const PCSTR* ppszNames)
+    {
+        if (iNumNames == 0)
+        {
+            std::printf("Usage: Benchmark <name>...\nBenchmarks:\n");
+            for (const Benchmark& benchmark : getBenchmarks())
+            {
+                std::printf("  %s\n", benchmark.pszName);
+            }
+
+            return 0u;
+        }
+
+        UINT uNumUnknownNames = 0u;
+        for (INT i = 0; i < iNumNames; ++i)
+        {
+            auto it = std::find_if(
+                getBenchmarks().begin(),
+                getBenchmarks().end(),
+                [pszName = ppszNames[i]](const Benchmark& benchmark) { return std::strcmp(benchmark.pszName, pszName) == 0; }
+            );
+            if (it == getBenchmarks().end())
+            {
+                std::printf("Unknown benchmark %s\n", ppszNames[i]);
+                ++uNumUnknownNames;
+                continue;
+            }
+
+            std::printf("%s\n", it->pszName);
+            it->Run();
+        }
+
+        return uNumUnknownNames;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BenchmarkRegistry::GetMilliseconds
+
+      Summary:  Returns the performance counter in milliseconds, only
+                differences of it are meaningful
+
+      Returns:  DOUBLE
+                  Current time in milliseconds
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    DOUBLE BenchmarkRegistry::GetMilliseconds()
+    {
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER counter;
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&counter);
+
+        return static_cast<DOUBLE>(counter.QuadPart) * 1000.0 / static_cast<DOUBLE>(frequency.QuadPart);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BenchmarkRegistry::getBenchmarks
+
+      Summary:  Returns the registered benchmarks. A function local
+                static, so benchmarks in other translation units can
+                register before it would otherwise be constructed
+
+      Returns:  std::vector<Benchmark>&
+                  Registered benchmarks
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    std::vector<BenchmarkRegistry::Benchmark>& BenchmarkRegistry::getBenchmarks()
+    {
+        static std::vector<Benchmark> s_aBenchmarks;
+
+        return s_aBenchmarks;
+    }
+}
\ No newline at end of file
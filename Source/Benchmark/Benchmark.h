@@ -0,0 +1,66 @@
+/*+===================================================================
+  File:      BENCHMARK.H
+
+  Summary:   Benchmark header file contains declarations of the
+             BenchmarkRegistry class that collects and runs the
+             benchmarks, and of the macro they are written with.
+
+  Classes: BenchmarkRegistry
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+namespace benchmark
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    BenchmarkRegistry
+
+      Summary:  Benchmarks registered by BENCHMARK before main runs.
+                Only the benchmarks named on the command line run, each
+                prints its own timings
+
+      Methods:  Add
+                  Registers a benchmark
+                Run
+                  Runs the named benchmarks
+                GetMilliseconds
+                  Returns the current time in milliseconds
+                BenchmarkRegistry
+                  Constructor.
+                ~BenchmarkRegistry
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class BenchmarkRegistry final
+    {
+    public:
+        using BenchmarkFunction = void (*)();
+
+        BenchmarkRegistry() = delete;
+        BenchmarkRegistry(const BenchmarkRegistry& other) = delete;
+        BenchmarkRegistry(BenchmarkRegistry&& other) = delete;
+        BenchmarkRegistry& operator=(const BenchmarkRegistry& other) = delete;
+        BenchmarkRegistry& operator=(BenchmarkRegistry&& other) = delete;
+        ~BenchmarkRegistry() = delete;
+
+        static BOOL Add(_In_ PCSTR pszName, _In_ BenchmarkFunction benchmark);
+        static UINT Run(_In_ INT iNumNames, _In_reads_(iNumNames) const PCSTR* ppszNames);
+        static DOUBLE GetMilliseconds();
+
+    private:
+        struct Benchmark
+        {
+            PCSTR pszName;
+            BenchmarkFunction Run;
+        };
+
+        static std::vector<Benchmark>& getBenchmarks();
+    };
+}
+
+#define BENCHMARK(name) \
+    static void name##Benchmark(); \
+    static const BOOL name##Registered = benchmark::BenchmarkRegistry::Add(#name, name##Benchmark); \
+    static void name##Benchmark()
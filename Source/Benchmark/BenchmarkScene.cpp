@@ -0,0 +1,178 @@
+#include "BenchmarkScene.h"
+
+namespace benchmark
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BenchmarkCube::BenchmarkCube
+
+      Summary:  Constructor
+
+      Args:     const XMFLOAT4& outputColor
+                  Color of the cube
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BenchmarkCube::BenchmarkCube(_In_ const XMFLOAT4& outputColor)
+        : library::Renderable(outputColor)
+    {
+        // empty
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BenchmarkCube::Initialize
+
+      Summary:  Does nothing, the cube has no GPU buffers
+
+      Args:     ID3D11Device* pDevice
+                  Unused
+                ID3D11DeviceContext* pImmediateContext
+                  Unused
+
+      Returns:  HRESULT
+                  Always S_OK
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT BenchmarkCube::Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext)
+    {
+        UNREFERENCED_PARAMETER(pDevice);
+        UNREFERENCED_PARAMETER(pImmediateContext);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BenchmarkCube::Update
+
+      Summary:  Turns the cube around the Y axis
+
+      Args:     FLOAT deltaTime
+                  Time since the last update in seconds
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void BenchmarkCube::Update(_In_ FLOAT deltaTime)
+    {
+        RotateY(-deltaTime * 2.0f);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BenchmarkCube::GetNumVertices
+
+      Summary:  Returns the number of vertices of a cube
+
+      Returns:  UINT
+                  Number of vertices
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT BenchmarkCube::GetNumVertices() const
+    {
+        return 24u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BenchmarkCube::GetNumIndices
+
+      Summary:  Returns the number of indices of a cube
+
+      Returns:  UINT
+                  Number of indices
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT BenchmarkCube::GetNumIndices() const
+    {
+        return 36u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BenchmarkCube::getVertices
+
+      Summary:  Returns no vertices, the cube is never uploaded
+
+      Returns:  const library::SimpleVertex*
+                  Null
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const library::SimpleVertex* BenchmarkCube::getVertices() const
+    {
+        return nullptr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BenchmarkCube::getIndices
+
+      Summary:  Returns no indices, the cube is never uploaded
+
+      Returns:  const WORD*
+                  Null
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const WORD* BenchmarkCube::getIndices() const
+    {
+        return nullptr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BenchmarkPointLight::BenchmarkPointLight
+
+      Summary:  Constructor
+
+      Args:     const XMFLOAT4& position
+                  Position of the light
+                const XMFLOAT4& color
+                  Color of the light
+                FLOAT attenuationDistance
+                  Distance the light reaches
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BenchmarkPointLight::BenchmarkPointLight(_In_ const XMFLOAT4& position, _In_ const XMFLOAT4& color, _In_ FLOAT attenuationDistance)
+        : library::PointLight(position, color, attenuationDistance)
+    {
+        // empty
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BenchmarkPointLight::Update
+
+      Summary:  Moves the light around the origin and looks at it
+
+      Args:     FLOAT deltaTime
+                  Time since the last update in seconds
+
+      Modifies: [m_position, m_eye, m_at, m_up, m_view, m_uVersion].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void BenchmarkPointLight::Update(_In_ FLOAT deltaTime)
+    {
+        XMStoreFloat4(&m_position, XMVector3Transform(XMLoadFloat4(&m_position), XMMatrixRotationY(-2.0f * deltaTime)));
+        m_eye = XMLoadFloat4(&m_position);
+        m_at = XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f);
+        m_up = DEFAULT_UP;
+        m_view = XMMatrixLookAtLH(m_eye, m_at, m_up);
+        markDirty();
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: CreateBenchmarkScene
+
+      Summary:  Creates a scene on a height map with a grid of cubes
+                and a moving light in every light slot, the scene of
+                the game with many more objects
+
+      Args:     const std::filesystem::path& filePath
+                  Height map of the scene
+                UINT uNumCubes
+                  Number of cubes
+
+      Returns:  std::shared_ptr<library::Scene>
+                  The scene, nothing in it is initialized
+    -----------------------------------------------------------------F-F*/
+    std::shared_ptr<library::Scene> CreateBenchmarkScene(_In_ const std::filesystem::path& filePath, _In_ UINT uNumCubes)
+    {
+        std::shared_ptr<library::Scene> scene = std::make_shared<library::Scene>(filePath);
+
+        XMFLOAT4 color;
+        XMStoreFloat4(&color, Colors::White);
+        for (UINT i = 0u; i < uNumCubes; ++i)
+        {
+            std::shared_ptr<BenchmarkCube> cube = std::make_shared<BenchmarkCube>(color);
+            cube->Translate(XMVectorSet(static_cast<FLOAT>(i % 316u) * 2.0f, 0.0f, static_cast<FLOAT>(i / 316u) * 2.0f, 0.0f));
+            scene->AddRenderable(std::to_wstring(i).c_str(), cube);
+        }
+
+        for (UINT i = 0u; i < NUM_LIGHTS; ++i)
+        {
+            scene->AddPointLight(i, std::make_shared<BenchmarkPointLight>(XMFLOAT4(0.0f, 0.0f, -5.0f, 1.0f), color, 45.0f));
+        }
+
+        return scene;
+    }
+}
\ No newline at end of file
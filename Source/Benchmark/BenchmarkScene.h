@@ -0,0 +1,93 @@
+/*+===================================================================
+  File:      BENCHMARKSCENE.H
+
+  Summary:   BenchmarkScene header file contains declarations of the
+             large scene the scene and render benchmarks time, and of
+             its cubes and lights, which behave like the rotating
+             cubes and lights of the game without GPU resources.
+
+  Classes: BenchmarkCube, BenchmarkPointLight
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Light/PointLight.h"
+#include "Renderer/Renderable.h"
+#include "Scene/Scene.h"
+
+namespace benchmark
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    BenchmarkCube
+
+      Summary:  Cube that turns around the Y axis every update, as the
+                RotatingCube of the game does. It has the index count
+                of a cube and no GPU buffers, so the headless renderer
+                only records its draws
+
+      Methods:  Initialize
+                  Does nothing.
+                Update
+                  Turns the cube
+                GetNumVertices
+                  Returns the number of vertices of a cube
+                GetNumIndices
+                  Returns the number of indices of a cube
+                BenchmarkCube
+                  Constructor.
+                ~BenchmarkCube
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class BenchmarkCube final : public library::Renderable
+    {
+    public:
+        BenchmarkCube(_In_ const XMFLOAT4& outputColor);
+        BenchmarkCube(const BenchmarkCube& other) = delete;
+        BenchmarkCube(BenchmarkCube&& other) = delete;
+        BenchmarkCube& operator=(const BenchmarkCube& other) = delete;
+        BenchmarkCube& operator=(BenchmarkCube&& other) = delete;
+        ~BenchmarkCube() = default;
+
+        HRESULT Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext) override;
+        void Update(_In_ FLOAT deltaTime) override;
+
+        UINT GetNumVertices() const override;
+        UINT GetNumIndices() const override;
+
+    protected:
+        const library::SimpleVertex* getVertices() const override;
+        const WORD* getIndices() const override;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    BenchmarkPointLight
+
+      Summary:  Point light that circles the origin, as the
+                RotatingPointLight of the game does, so its shadow map
+                changes every frame
+
+      Methods:  Update
+                  Moves the light
+                BenchmarkPointLight
+                  Constructor.
+                ~BenchmarkPointLight
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class BenchmarkPointLight final : public library::PointLight
+    {
+    public:
+        BenchmarkPointLight(_In_ const XMFLOAT4& position, _In_ const XMFLOAT4& color, _In_ FLOAT attenuationDistance);
+        BenchmarkPointLight(const BenchmarkPointLight& other) = delete;
+        BenchmarkPointLight(BenchmarkPointLight&& other) = delete;
+        BenchmarkPointLight& operator=(const BenchmarkPointLight& other) = delete;
+        BenchmarkPointLight& operator=(BenchmarkPointLight&& other) = delete;
+        ~BenchmarkPointLight() = default;
+
+        void Update(_In_ FLOAT deltaTime) override;
+    };
+
+    std::shared_ptr<library::Scene> CreateBenchmarkScene(_In_ const std::filesystem::path& filePath, _In_ UINT uNumCubes);
+}
\ No newline at end of file
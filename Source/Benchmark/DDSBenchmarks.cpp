@@ -0,0 +1,110 @@
+#include "Benchmark.h"
+
+#include <cstdio>
+#include <fstream>
+
+#include "Texture/DDSParser.h"
+#include "Texture/MappedFile.h"
+
+using namespace benchmark;
+using namespace library;
+
+// Loads of each file per measurement, the files stay in the file cache after the first
+constexpr UINT NUM_PASSES = 100u;
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: touchDDSSurfaces
+
+  Summary:  Parses a DDS file and reads one byte of every page of its
+            surfaces, as the upload would, so that a mapped file pays
+            for its page faults
+
+  Args:     const uint8_t* pData
+              The whole DDS file
+            size_t uSize
+              Size of the file in bytes
+
+  Returns:  UINT
+              Sum of the bytes read, 0 if the file could not be parsed
+-----------------------------------------------------------------F-F*/
+static UINT touchDDSSurfaces(_In_reads_bytes_(uSize) const uint8_t* pData, _In_ size_t uSize)
+{
+    constexpr const size_t PAGE_SIZE = 4096u;
+
+    DDSTextureInfo info;
+    std::vector<DDSSurface> surfaces;
+    if (DDSParser::ParseHeader(pData, uSize, info) != eDDSStatus::OK
+        || DDSParser::GetSurfaces(info, uSize, surfaces) != eDDSStatus::OK)
+    {
+        return 0u;
+    }
+
+    UINT uSum = 0u;
+    for (const DDSSurface& surface : surfaces)
+    {
+        for (size_t uByte = 0u; uByte < surface.uNumBytes; uByte += PAGE_SIZE)
+        {
+            uSum += pData[surface.uOffset + uByte];
+        }
+    }
+
+    return uSum;
+}
+
+BENCHMARK(DDS)
+{
+    constexpr PCWSTR FILE_PATHS[] = { L"seafloor.dds", L"brickwall.dds", L"mollu.dds" };
+
+    for (PCWSTR pszFilePath : FILE_PATHS)
+    {
+        const std::filesystem::path filePath(pszFilePath);
+        UINT uReadSum = 0u;
+        UINT uMappedSum = 0u;
+        size_t uFileSize = 0u;
+
+        // Read into the heap, as the loader did before
+        const DOUBLE startTime = BenchmarkRegistry::GetMilliseconds();
+        for (UINT i = 0u; i < NUM_PASSES; ++i)
+        {
+            std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+            if (!file)
+            {
+                break;
+            }
+
+            std::vector<uint8_t> aFileData(static_cast<size_t>(file.tellg()));
+            file.seekg(0);
+            file.read(reinterpret_cast<char*>(aFileData.data()), static_cast<std::streamsize>(aFileData.size()));
+            uReadSum += touchDDSSurfaces(aFileData.data(), aFileData.size());
+            uFileSize = aFileData.size();
+        }
+        const DOUBLE readTime = BenchmarkRegistry::GetMilliseconds();
+
+        for (UINT i = 0u; i < NUM_PASSES; ++i)
+        {
+            MappedFile mappedFile;
+            if (!mappedFile.Open(filePath))
+            {
+                break;
+            }
+
+            uMappedSum += touchDDSSurfaces(mappedFile.GetData(), mappedFile.GetSize());
+        }
+        const DOUBLE endTime = BenchmarkRegistry::GetMilliseconds();
+
+        if (uFileSize == 0u)
+        {
+            std::printf("  %ls failed to load\n", pszFilePath);
+            continue;
+        }
+
+        std::printf(
+            "  %-14ls %8zu bytes, read %7.3f ms, mapped %7.3f ms per load%s\n",
+            pszFilePath,
+            uFileSize,
+            (readTime - startTime) / NUM_PASSES,
+            (endTime - readTime) / NUM_PASSES,
+            uReadSum == uMappedSum ? "" : ", contents differ"
+        );
+    }
+}
\ No newline at end of file
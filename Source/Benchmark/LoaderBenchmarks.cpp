@@ -0,0 +1,116 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+
+#include "Model/Model.h"
+#include "Renderer/AssetLoader.h"
+#include "Texture/Material.h"
+#include "Texture/Texture.h"
+
+using namespace benchmark;
+using namespace library;
+
+// Loads of the sample assets per thread count, the times are averaged over them
+constexpr UINT NUM_PASSES = 3u;
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: loadAssets
+
+  Summary:  Runs the CPU side of the scene start-up on a loader: the
+            models are read first, then the textures of their
+            materials are decoded, each into new objects
+
+  Args:     AssetLoader& loader
+              Loader to run the loads on
+            const std::vector<std::filesystem::path>& aModelPaths
+              Models to load
+
+  Returns:  HRESULT
+              Status code of the first failed load
+-----------------------------------------------------------------F-F*/
+static HRESULT loadAssets(_In_ AssetLoader& loader, _In_ const std::vector<std::filesystem::path>& aModelPaths)
+{
+    std::vector<std::shared_ptr<Model>> aModels;
+    std::vector<std::future<HRESULT>> aFutures;
+    for (const std::filesystem::path& modelPath : aModelPaths)
+    {
+        std::shared_ptr<Model> model = std::make_shared<Model>(modelPath);
+        aModels.push_back(model);
+        aFutures.push_back(loader.Submit([model] { return model->Load(); }));
+    }
+
+    HRESULT hr = AssetLoader::WaitAll(aFutures);
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    // New textures rather than the shared ones of the materials, which are decoded once
+    std::unordered_set<std::wstring> texturePaths;
+    std::vector<std::shared_ptr<Texture>> aTextures;
+    for (const std::shared_ptr<Model>& model : aModels)
+    {
+        for (UINT i = 0u; i < model->GetNumMaterials(); ++i)
+        {
+            const std::shared_ptr<Material>& material = model->GetMaterial(i);
+            for (Texture* pTexture : { material->pDiffuse.get(), material->pSpecularExponent.get(), material->pNormal.get() })
+            {
+                if (pTexture && texturePaths.insert(pTexture->GetFilePath().wstring()).second)
+                {
+                    std::shared_ptr<Texture> texture = std::make_shared<Texture>(pTexture->GetFilePath());
+                    aTextures.push_back(texture);
+                    aFutures.push_back(loader.Submit([texture] { return texture->Load(); }));
+                }
+            }
+        }
+    }
+
+    return AssetLoader::WaitAll(aFutures);
+}
+
+BENCHMARK(Loader)
+{
+    const std::vector<std::filesystem::path> aModelPaths =
+    {
+        L"Content/cyborg/cyborg.obj",
+        L"Content/Nanosuit/nanosuit.obj",
+        L"Content/BobLampClean/boblampclean.md5mesh",
+    };
+
+    // Cook the models and textures first, so every thread count reads the same caches
+    {
+        AssetLoader loader;
+        if (FAILED(loadAssets(loader, aModelPaths)))
+        {
+            std::printf("  The sample assets failed to load\n");
+            return;
+        }
+    }
+
+    // Powers of two up to one thread per core
+    const UINT uNumHardwareThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    std::vector<UINT> aNumThreads;
+    for (UINT uNumThreads = 1u; uNumThreads < uNumHardwareThreads; uNumThreads *= 2u)
+    {
+        aNumThreads.push_back(uNumThreads);
+    }
+    aNumThreads.push_back(uNumHardwareThreads);
+
+    DOUBLE singleThreadTime = 0.0;
+    for (UINT uNumThreads : aNumThreads)
+    {
+        AssetLoader loader(uNumThreads);
+
+        const DOUBLE startTime = BenchmarkRegistry::GetMilliseconds();
+        for (UINT i = 0u; i < NUM_PASSES; ++i)
+        {
+            loadAssets(loader, aModelPaths);
+        }
+        const DOUBLE time = (BenchmarkRegistry::GetMilliseconds() - startTime) / NUM_PASSES;
+
+        singleThreadTime = uNumThreads == 1u ? time : singleThreadTime;
+        std::printf("  %3u threads %8.2f ms, %5.2fx\n", uNumThreads, time, singleThreadTime / time);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+/*+===================================================================
+  File:      MAIN.CPP
+
+  Summary:   Runs the benchmarks named on the command line, such as
+             "Benchmark Model", and prints their timings. Content
+             paths are relative to Source/Game, so run it from there.
+             Returns a nonzero exit code if a name is unknown.
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+
+#include "Common.h"
+
+#include "Benchmark.h"
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: main
+
+  Summary:  Entry point of the benchmark runner
+
+  Args:     INT argc
+              Number of arguments, including the program name
+            CHAR* argv[]
+              Program name followed by the benchmark names
+
+  Returns:  INT
+              EXIT_SUCCESS if every name is known, EXIT_FAILURE
+              otherwise
+-----------------------------------------------------------------F-F*/
+INT main(_In_ INT argc, _In_reads_(argc) CHAR* argv[])
+{
+    return benchmark::BenchmarkRegistry::Run(argc - 1, argv + 1) == 0u ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include "Benchmark.h"
+
+#include <cstdio>
+
+#include "Model/Model.h"
+
+using namespace benchmark;
+using namespace library;
+
+// Loads of each model per measurement, the times are averaged over them
+constexpr UINT NUM_PASSES = 5u;
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: timeModelLoads
+
+  Summary:  Returns the average time of loading a model into a new
+            Model, the way the asset loader does
+
+  Args:     const std::filesystem::path& filePath
+              Path to the model
+
+  Returns:  DOUBLE
+              Milliseconds per load, negative if a load failed
+-----------------------------------------------------------------F-F*/
+static DOUBLE timeModelLoads(_In_ const std::filesystem::path& filePath)
+{
+    const DOUBLE startTime = BenchmarkRegistry::GetMilliseconds();
+    for (UINT i = 0u; i < NUM_PASSES; ++i)
+    {
+        Model model(filePath);
+        if (FAILED(model.Load()))
+        {
+            return -1.0;
+        }
+    }
+
+    return (BenchmarkRegistry::GetMilliseconds() - startTime) / NUM_PASSES;
+}
+
+BENCHMARK(Model)
+{
+    const PCWSTR apszFilePaths[] =
+    {
+        L"Content/cyborg/cyborg.obj",
+        L"Content/Nanosuit/nanosuit.obj",
+        L"Content/BobLampClean/boblampclean.md5mesh",
+    };
+
+    for (PCWSTR pszFilePath : apszFilePaths)
+    {
+        // Cold loads import the file with assimp every time
+        Model::SetCacheEnabled(FALSE);
+        const DOUBLE coldTime = timeModelLoads(pszFilePath);
+
+        // The first cached load cooks the model, the timed ones read it back
+        Model::SetCacheEnabled(TRUE);
+        timeModelLoads(pszFilePath);
+        const DOUBLE warmTime = timeModelLoads(pszFilePath);
+
+        if (coldTime < 0.0 || warmTime < 0.0)
+        {
+            std::printf("  %ls failed to load\n", pszFilePath);
+            continue;
+        }
+
+        std::printf("  %-44ls imported %8.2f ms, cooked %8.2f ms, %5.1fx\n", pszFilePath, coldTime, warmTime, coldTime / warmTime);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+#include "Benchmark.h"
+
+#include <cstdio>
+
+#include "BenchmarkScene.h"
+#include "Renderer/RecordingRenderContext.h"
+#include "Renderer/Renderer.h"
+#include "Scene/Voxel.h"
+#include "Shader/PixelShader.h"
+#include "Shader/ShadowVertexShader.h"
+#include "Shader/VertexShader.h"
+
+using namespace benchmark;
+using namespace library;
+
+// Cubes of the scene, on top of the voxels of the height map
+constexpr UINT NUM_CUBES = 100000u;
+
+// Frames rendered, the times are averaged over them
+constexpr UINT NUM_FRAMES = 100u;
+
+BENCHMARK(Render)
+{
+    constexpr PCWSTR PSZ_SCENE_NAME = L"RenderBenchmark";
+
+    std::shared_ptr<Scene> scene = CreateBenchmarkScene(L"HeightMap.txt", NUM_CUBES);
+
+    // The shaders are never compiled, the recorded draws bind null shaders
+    std::shared_ptr<VertexShader> vertexShader = std::make_shared<VertexShader>(L"Shaders/PhongShaders.fxh", "VSPhong", "vs_5_0");
+    std::shared_ptr<PixelShader> pixelShader = std::make_shared<PixelShader>(L"Shaders/PhongShaders.fxh", "PSPhong", "ps_5_0");
+    for (Voxel* pVoxel : scene->GetVoxels().GetObjects())
+    {
+        pVoxel->SetVertexShader(vertexShader);
+        pVoxel->SetPixelShader(pixelShader);
+    }
+    for (Renderable* pRenderable : scene->GetRenderables().GetObjects())
+    {
+        pRenderable->SetVertexShader(vertexShader);
+        pRenderable->SetPixelShader(pixelShader);
+    }
+
+    Renderer renderer;
+    renderer.AddScene(PSZ_SCENE_NAME, scene);
+    renderer.SetMainScene(PSZ_SCENE_NAME);
+    renderer.SetShadowMapVertexShader(std::make_shared<ShadowVertexShader>(L"Shaders/ShadowShaders.fxh", "VSShadow", "vs_5_0"));
+    if (FAILED(renderer.InitializeHeadless(800u, 600u)))
+    {
+        std::printf("  Initializing the headless renderer failed\n");
+        return;
+    }
+
+    RecordingRenderContext context;
+    context.SetCommandLogEnabled(FALSE);
+
+    const DOUBLE startTime = BenchmarkRegistry::GetMilliseconds();
+    UINT64 uNumDrawCalls = 0u;
+    for (UINT i = 0u; i < NUM_FRAMES; ++i)
+    {
+        renderer.Update(1.0f / 60.0f);
+        renderer.RenderHeadless(&context);
+        uNumDrawCalls += renderer.GetRenderStats().uNumDrawCalls;
+    }
+    const DOUBLE renderTime = BenchmarkRegistry::GetMilliseconds();
+
+    // One lookup per draw, as the renderer did before it cached the main scene
+    std::unordered_map<std::wstring, std::shared_ptr<Scene>> scenes;
+    scenes[PSZ_SCENE_NAME] = scene;
+    size_t uNumFound = 0u;
+    for (UINT64 i = 0u; i < uNumDrawCalls; ++i)
+    {
+        uNumFound += scenes[PSZ_SCENE_NAME] != nullptr ? 1u : 0u;
+    }
+    const DOUBLE endTime = BenchmarkRegistry::GetMilliseconds();
+
+    std::printf(
+        "  %u objects, %llu draws, %.3f ms per frame, %.3f ms per frame for %zu scene name lookups\n",
+        scene->GetRenderables().GetCount() + scene->GetVoxels().GetCount(),
+        uNumDrawCalls / NUM_FRAMES,
+        (renderTime - startTime) / NUM_FRAMES,
+        (endTime - renderTime) / NUM_FRAMES,
+        uNumFound / NUM_FRAMES
+    );
+}
\ No newline at end of file
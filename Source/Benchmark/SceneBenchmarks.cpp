@@ -0,0 +1,29 @@
+#include "Benchmark.h"
+
+#include <cstdio>
+
+#include "BenchmarkScene.h"
+
+using namespace benchmark;
+using namespace library;
+
+// Cubes of the scene, on top of the voxels of the height map
+constexpr UINT NUM_CUBES = 100000u;
+
+// Updates timed, the time is averaged over them
+constexpr UINT NUM_FRAMES = 100u;
+
+BENCHMARK(Scene)
+{
+    // The cubes are never initialized, so only the per-frame CPU work on the scene storage is measured
+    std::shared_ptr<Scene> scene = CreateBenchmarkScene(L"HeightMap.txt", NUM_CUBES);
+
+    const DOUBLE startTime = BenchmarkRegistry::GetMilliseconds();
+    for (UINT i = 0u; i < NUM_FRAMES; ++i)
+    {
+        scene->Update(1.0f / 60.0f);
+    }
+    const DOUBLE time = (BenchmarkRegistry::GetMilliseconds() - startTime) / NUM_FRAMES;
+
+    std::printf("  %u objects, %.3f ms per update\n", scene->GetRenderables().GetCount(), time);
+}
\ No newline at end of file
@@ -0,0 +1,130 @@
+#include "Benchmark.h"
+
+#include <cstdio>
+#include <unordered_map>
+
+#include "Scene/SceneObjectStore.h"
+
+using namespace benchmark;
+using namespace library;
+
+// Objects of the store, as many as the scene benchmark has cubes
+constexpr UINT NUM_OBJECTS = 100000u;
+
+// Updates timed, the time is averaged over them
+constexpr UINT NUM_FRAMES = 100u;
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+  Class:    StoreObject
+
+  Summary:  Object that turns every update the way Renderable::RotateY
+            does, with the interface the store needs and without the
+            GPU resources of a renderable
+
+  Methods:  Update
+              Turns the object and bumps its version
+            GetVersion
+              Returns the version
+            GetWorldMatrix
+              Returns the world matrix
+            GetLocalBounds
+              Returns the unit box
+            StoreObject
+              Constructor.
+            ~StoreObject
+              Destructor.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class StoreObject
+{
+public:
+    StoreObject(_In_ FLOAT x, _In_ FLOAT z)
+        : m_world(XMMatrixTranslation(x, 0.0f, z))
+        , m_uVersion(0u)
+        , m_localBounds()
+    {
+        // empty
+    }
+
+    StoreObject(const StoreObject& other) = delete;
+    StoreObject(StoreObject&& other) = delete;
+    StoreObject& operator=(const StoreObject& other) = delete;
+    StoreObject& operator=(StoreObject&& other) = delete;
+    virtual ~StoreObject() = default;
+
+    virtual void Update(_In_ FLOAT deltaTime)
+    {
+        m_world = XMMatrixMultiply(m_world, XMMatrixRotationY(-deltaTime * 2.0f));
+        ++m_uVersion;
+    }
+
+    UINT64 GetVersion() const
+    {
+        return m_uVersion;
+    }
+
+    const XMMATRIX& GetWorldMatrix() const
+    {
+        return m_world;
+    }
+
+    const BoundingBox& GetLocalBounds() const
+    {
+        return m_localBounds;
+    }
+
+private:
+    XMMATRIX m_world;
+    UINT64 m_uVersion;
+    BoundingBox m_localBounds;
+};
+
+BENCHMARK(SceneStore)
+{
+    // The same objects in the dense store and in a name keyed map, as the scene kept them before
+    SceneObjectStore<StoreObject> store;
+    std::unordered_map<std::wstring, std::shared_ptr<StoreObject>> objects;
+    for (UINT i = 0u; i < NUM_OBJECTS; ++i)
+    {
+        std::shared_ptr<StoreObject> object = std::make_shared<StoreObject>(static_cast<FLOAT>(i % 316u) * 2.0f, static_cast<FLOAT>(i / 316u) * 2.0f);
+        store.Add(object);
+        objects[std::to_wstring(i)] = object;
+    }
+
+    const DOUBLE startTime = BenchmarkRegistry::GetMilliseconds();
+    for (UINT i = 0u; i < NUM_FRAMES; ++i)
+    {
+        store.Update(1.0f / 60.0f);
+    }
+    const DOUBLE storeTime = BenchmarkRegistry::GetMilliseconds();
+
+    // The map is walked twice, once to update and once to read the transforms, as the renderer did per draw
+    FLOAT checksum = 0.0f;
+    for (UINT i = 0u; i < NUM_FRAMES; ++i)
+    {
+        for (const auto& [szName, object] : objects)
+        {
+            object->Update(1.0f / 60.0f);
+        }
+
+        for (const auto& [szName, object] : objects)
+        {
+            XMFLOAT4X4 world;
+            BoundingBox bounds;
+            XMStoreFloat4x4(&world, object->GetWorldMatrix());
+            object->GetLocalBounds().Transform(bounds, object->GetWorldMatrix());
+            checksum += world(3, 0) + bounds.Center.x;
+        }
+    }
+    const DOUBLE mapTime = BenchmarkRegistry::GetMilliseconds();
+
+    const DOUBLE storeMs = (storeTime - startTime) / NUM_FRAMES;
+    const DOUBLE mapMs = (mapTime - storeTime) / NUM_FRAMES;
+    std::printf(
+        "  %u objects, dense store %.3f ms, name map %.3f ms per update, %.2fx%s\n",
+        store.GetCount(),
+        storeMs,
+        mapMs,
+        mapMs / storeMs,
+        checksum != checksum ? ", bad transforms" : ""
+    );
+}
\ No newline at end of file
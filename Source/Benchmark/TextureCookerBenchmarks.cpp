@@ -0,0 +1,83 @@
+#include "Benchmark.h"
+
+#include <cstdio>
+
+#include "Texture/TextureCooker.h"
+
+using namespace benchmark;
+using namespace library;
+
+// Width and height of the image, as large as the model textures
+constexpr UINT IMAGE_SIZE = 1024u;
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: timeMips
+
+  Summary:  Times the generation of the mip chain of an image
+
+  Args:     const std::vector<BYTE>& aPixels
+              RGBA8 pixels of the image
+            BOOL bNormalMap
+              Whether the image stores normals
+            PCSTR pszName
+              Name of the case in the output
+-----------------------------------------------------------------F-F*/
+static void timeMips(_In_ const std::vector<BYTE>& aPixels, _In_ BOOL bNormalMap, _In_ PCSTR pszName)
+{
+    std::vector<std::vector<BYTE>> aMips;
+
+    const DOUBLE startTime = BenchmarkRegistry::GetMilliseconds();
+    TextureCooker::GenerateMips(IMAGE_SIZE, IMAGE_SIZE, aPixels, bNormalMap, aMips);
+    const DOUBLE time = BenchmarkRegistry::GetMilliseconds() - startTime;
+
+    std::printf("  %-12s %2zu levels, %8.2f ms, %6.1f Mtexels/s\n", pszName, aMips.size(), time, IMAGE_SIZE * IMAGE_SIZE / time / 1000.0);
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: timeEncode
+
+  Summary:  Times the compression of the top level of an image
+
+  Args:     const std::vector<BYTE>& aPixels
+              RGBA8 pixels of the image
+            eTextureFormat format
+              BC format
+            PCSTR pszName
+              Name of the case in the output
+-----------------------------------------------------------------F-F*/
+static void timeEncode(_In_ const std::vector<BYTE>& aPixels, _In_ eTextureFormat format, _In_ PCSTR pszName)
+{
+    std::vector<BYTE> aBlocks;
+
+    const DOUBLE startTime = BenchmarkRegistry::GetMilliseconds();
+    TextureCooker::EncodeBlocks(format, IMAGE_SIZE, IMAGE_SIZE, aPixels.data(), aBlocks);
+    const DOUBLE time = BenchmarkRegistry::GetMilliseconds() - startTime;
+
+    std::printf(
+        "  %-12s %2.0f:1,     %8.2f ms, %6.1f Mtexels/s\n",
+        pszName,
+        static_cast<DOUBLE>(aPixels.size()) / static_cast<DOUBLE>(aBlocks.size()),
+        time,
+        IMAGE_SIZE * IMAGE_SIZE / time / 1000.0
+    );
+}
+
+BENCHMARK(TextureCooker)
+{
+    // Smooth gradients with a little noise, so the blocks are neither flat nor random
+    std::vector<BYTE> aPixels(IMAGE_SIZE * IMAGE_SIZE * 4u);
+    UINT uSeed = 12345u;
+    for (size_t i = 0u; i < aPixels.size(); ++i)
+    {
+        uSeed = uSeed * 1664525u + 1013904223u;
+        size_t uTexel = i / 4u;
+        aPixels[i] = static_cast<BYTE>((uTexel % IMAGE_SIZE + uTexel / IMAGE_SIZE * (i % 4u)) / 8u + (uSeed >> 28u));
+    }
+
+    timeMips(aPixels, FALSE, "color mips");
+    timeMips(aPixels, TRUE, "normal mips");
+    timeEncode(aPixels, eTextureFormat::BC1, "BC1");
+    timeEncode(aPixels, eTextureFormat::BC3, "BC3");
+    timeEncode(aPixels, eTextureFormat::BC5, "BC5");
+    timeEncode(aPixels, eTextureFormat::BC7, "BC7");
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include "Benchmark.h"
+
+#include <cstdio>
+
+#include "Scene/TransformHierarchy.h"
+
+using namespace benchmark;
+using namespace library;
+
+// Nodes of the chain, each the child of the one before
+constexpr UINT NUM_DEEP_NODES = 10000u;
+
+// Nodes of the tree whose nodes are all children of one root
+constexpr UINT NUM_WIDE_NODES = 100000u;
+
+// Updates timed, the time is averaged over them
+constexpr UINT NUM_FRAMES = 100u;
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: timeTransformUpdates
+
+  Summary:  Times the update of a transform hierarchy after the local
+            rotation of one node changes every frame
+
+  Args:     TransformHierarchy& transforms
+              Hierarchy to update
+            UINT uNode
+              Node that is rotated
+            PCSTR pszName
+              Name of the case in the output
+-----------------------------------------------------------------F-F*/
+static void timeTransformUpdates(_In_ TransformHierarchy& transforms, _In_ UINT uNode, _In_ PCSTR pszName)
+{
+    transforms.Update();
+
+    const DOUBLE startTime = BenchmarkRegistry::GetMilliseconds();
+    for (UINT i = 0u; i < NUM_FRAMES; ++i)
+    {
+        XMFLOAT4 rotation;
+        XMStoreFloat4(&rotation, XMQuaternionRotationRollPitchYaw(0.0f, static_cast<FLOAT>(i) * 0.01f, 0.0f));
+        transforms.SetRotation(uNode, rotation);
+        transforms.Update();
+    }
+    const DOUBLE time = (BenchmarkRegistry::GetMilliseconds() - startTime) / NUM_FRAMES;
+
+    std::printf("  %-10s %6u nodes, %6u recomputed, %9.4f ms per update\n", pszName, transforms.GetNumNodes(), transforms.GetNumUpdated(), time);
+}
+
+BENCHMARK(Transform)
+{
+    // Changing the root recomputes every node, changing a leaf only the leaf
+    TransformHierarchy deep;
+    UINT uLeaf = deep.AddNode(TransformHierarchy::NO_PARENT);
+    for (UINT i = 1u; i < NUM_DEEP_NODES; ++i)
+    {
+        uLeaf = deep.AddNode(uLeaf);
+        deep.SetTranslation(uLeaf, XMFLOAT3(0.0f, 1.0f, 0.0f));
+    }
+    timeTransformUpdates(deep, 0u, "deep root");
+    timeTransformUpdates(deep, uLeaf, "deep leaf");
+
+    TransformHierarchy wide;
+    const UINT uRoot = wide.AddNode(TransformHierarchy::NO_PARENT);
+    for (UINT i = 1u; i < NUM_WIDE_NODES; ++i)
+    {
+        uLeaf = wide.AddNode(uRoot);
+        wide.SetTranslation(uLeaf, XMFLOAT3(static_cast<FLOAT>(i % 316u) * 2.0f, 0.0f, static_cast<FLOAT>(i / 316u) * 2.0f));
+    }
+    timeTransformUpdates(wide, uRoot, "wide root");
+    timeTransformUpdates(wide, uLeaf, "wide leaf");
+}
\ No newline at end of file
@@ -22,7 +22,7 @@ PlanetCube::PlanetCube(const std::filesystem::path& textureFilePath)
   Args:     FLOAT deltaTime
 			  Elapsed time
 
-  Modifies: [m_world].
+  Modifies: [m_world, m_uVersion].
 M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 void PlanetCube::Update(_In_ FLOAT deltaTime)
 {
@@ -42,5 +42,5 @@ void PlanetCube::Update(_In_ FLOAT deltaTime)
 
 	static XMMATRIX s_scale = XMMatrixScaling(0.5f, 0.5f, 0.5f);
 
-	m_world = s_scale * s_spin * s_translate * s_orbit;
+	SetWorldMatrix(s_scale * s_spin * s_translate * s_orbit);
 }
\ No newline at end of file
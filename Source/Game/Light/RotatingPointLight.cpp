@@ -24,7 +24,7 @@ RotatingPointLight::RotatingPointLight(_In_ const XMFLOAT4& position, _In_ const
   Args:     FLOAT deltaTime
 
   Modifies: [m_position, m_eye, m_eye, m_at,
-			m_view].
+			m_view, m_uVersion].
 M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 void RotatingPointLight::Update(_In_ FLOAT deltaTime)
 {
@@ -39,4 +39,6 @@ void RotatingPointLight::Update(_In_ FLOAT deltaTime)
     m_at = XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f);
     m_up = DEFAULT_UP;
     m_view = XMMatrixLookAtLH(m_eye, m_at, m_up);
+
+    markDirty();
 }
\ No newline at end of file
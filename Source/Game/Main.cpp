@@ -21,8 +21,12 @@
 #include "Scene/Scene.h"
 #include "Scene/Voxel.h"
 #include "Cube/Cube.h"
+#include "Shader/FullscreenVertexShader.h"
+#include "Shader/ShaderCache.h"
 #include "Shader/SkinningVertexShader.h"
 #include "Shader/SkyMapVertexShader.h"
+#include "Texture/TextureCache.h"
+#include "Texture/TextureCooker.h"
 
 /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
   Function: wWinMain
@@ -52,10 +56,71 @@ INT WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
 #endif
 
     UNREFERENCED_PARAMETER(hPrevInstance);
-    UNREFERENCED_PARAMETER(lpCmdLine);
+
+    // Measure a cold start by bypassing the model and shader caches and the texture cooker
+    if (wcsstr(lpCmdLine, L"-coldstart"))
+    {
+        library::Model::SetCacheEnabled(FALSE);
+        library::ShaderCache::SetCacheEnabled(FALSE);
+        library::TextureCooker::SetEnabled(FALSE);
+    }
+
+    // Cook color textures to BC7 rather than BC1 and BC3
+    if (wcsstr(lpCmdLine, L"-bc7"))
+    {
+        library::TextureCooker::SetHighQuality(TRUE);
+    }
+
+    // Create textures with their small mips only and stream the rest in as they come into view
+    if (wcsstr(lpCmdLine, L"-streaming"))
+    {
+        library::Texture::SetStreamingEnabled(TRUE);
+    }
 
     std::unique_ptr<library::Game> game = std::make_unique<library::Game>(L"Game Graphics Programming");
 
+    // Write the render statistics to the debug output once a second
+    if (wcsstr(lpCmdLine, L"-renderstats"))
+    {
+        game->GetRenderer()->SetRenderStatsDumpInterval(60u);
+    }
+
+    // Light the voxel terrain once per pixel from a G-buffer
+    if (wcsstr(lpCmdLine, L"-deferred"))
+    {
+        game->GetRenderer()->SetRenderPath(library::eRenderPath::DEFERRED);
+    }
+
+    // Shade every pixel of the voxels and models once over a depth pre-pass
+    if (wcsstr(lpCmdLine, L"-zprepass"))
+    {
+        game->GetRenderer()->SetDepthPrepass(TRUE, TRUE);
+    }
+
+    // Skip the voxels and models hidden behind the voxel terrain
+    if (wcsstr(lpCmdLine, L"-occlusion"))
+    {
+        game->GetRenderer()->SetOcclusionCulling(TRUE);
+    }
+
+    // Render at most the given number of point light shadow maps per frame, the others stay stale until their turn
+    if (PCWSTR pszShadowBudget = wcsstr(lpCmdLine, L"-shadowbudget "))
+    {
+        game->GetRenderer()->SetShadowBudget(static_cast<UINT>(wcstoul(pszShadowBudget + wcslen(L"-shadowbudget "), nullptr, 10)));
+    }
+
+    // Render on the WARP software rasterizer, for machines without a GPU such as the build servers
+    if (wcsstr(lpCmdLine, L"-warp"))
+    {
+        game->GetRenderer()->SetDriverType(D3D_DRIVER_TYPE_WARP);
+    }
+
+    // Quit after the given number of frames
+    if (PCWSTR pszFrames = wcsstr(lpCmdLine, L"-frames "))
+    {
+        game->SetFrameLimit(static_cast<UINT>(wcstoul(pszFrames + wcslen(L"-frames "), nullptr, 10)));
+    }
+
     std::ofstream sceneFile;
     sceneFile.open("HeightMap.txt");
     constexpr const UINT MAP_WIDTH = 256u;
@@ -256,6 +321,12 @@ INT WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
     {
         return 0;
     }
+    // Deferred Lighting
+    std::shared_ptr<library::FullscreenVertexShader> deferredLightingVertexShader = std::make_shared<library::FullscreenVertexShader>(L"Shaders/DeferredShaders.fxh", "VSDeferredLighting", "vs_5_0");
+    if (FAILED(mainScene->AddVertexShader(L"DeferredLightingShader", deferredLightingVertexShader)))
+    {
+        return 0;
+    }
 
     // Phong Skinning
     std::shared_ptr<library::PixelShader> phongSkinningPixelShader = std::make_shared<library::PixelShader>(L"Shaders/SkinningShaders.fxh", "PSPhong", "ps_5_0");
@@ -275,6 +346,18 @@ INT WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
     {
         return 0;
     }
+    // Voxel G-buffer
+    std::shared_ptr<library::PixelShader> voxelGBufferPixelShader = std::make_shared<library::PixelShader>(L"Shaders/VoxelShaders.fxh", "PSVoxelGBuffer", "ps_5_0");
+    if (FAILED(mainScene->AddPixelShader(L"VoxelGBufferShader", voxelGBufferPixelShader)))
+    {
+        return 0;
+    }
+    // Deferred Lighting
+    std::shared_ptr<library::PixelShader> deferredLightingPixelShader = std::make_shared<library::PixelShader>(L"Shaders/DeferredShaders.fxh", "PSDeferredLighting", "ps_5_0");
+    if (FAILED(mainScene->AddPixelShader(L"DeferredLightingShader", deferredLightingPixelShader)))
+    {
+        return 0;
+    }
     // Light Cube
     std::shared_ptr<library::PixelShader> lightPixelShader = std::make_shared<library::PixelShader>(L"Shaders/PhongShaders.fxh", "PSLightCube", "ps_5_0");
     if (FAILED(mainScene->AddPixelShader(L"LightShader", lightPixelShader)))
@@ -299,12 +382,6 @@ INT WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
     {
         return 0;
     }
-    // Shadow
-    std::shared_ptr<library::PixelShader> shadowMapPixelShader = std::make_shared<library::PixelShader>(L"Shaders/ShadowShaders.fxh", "PSShadow", "ps_5_0");
-    if (FAILED(mainScene->AddPixelShader(L"ShadowMapShader", shadowMapPixelShader)))
-    {
-        return 0;
-    }
 
     // Load Material
     std::shared_ptr<library::Model> cyborg = std::make_shared<library::Model>(L"Content/cyborg/cyborg.obj");
@@ -323,8 +400,8 @@ INT WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
     }
 
     std::shared_ptr<library::Material> voxelMaterial = std::make_shared<library::Material>(L"VoxelMaterial");
-    voxelMaterial->pDiffuse = std::make_shared<library::Texture>("Content/Cube/diffuse.png");
-    voxelMaterial->pNormal = std::make_shared<library::Texture>("Content/Cube/normal.png");
+    voxelMaterial->pDiffuse = library::TextureCache::GetTexture("Content/Cube/diffuse.png");
+    voxelMaterial->pNormal = library::TextureCache::GetTexture("Content/Cube/normal.png");
 
     if (FAILED(mainScene->AddMaterial(voxelMaterial)))
     {
@@ -346,7 +423,8 @@ INT WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
         return 0;
     }
 
-    game->GetRenderer()->SetShadowMapShaders(shadowMapVertexShader, shadowMapPixelShader);
+    game->GetRenderer()->SetShadowMapVertexShader(shadowMapVertexShader);
+    game->GetRenderer()->SetDeferredShaders(voxelGBufferPixelShader, deferredLightingVertexShader, deferredLightingPixelShader);
 
     std::shared_ptr<library::Skybox> skybox = std::make_shared<library::Skybox>(L"Content/Common/Maskonaive2_1024.dds", 1000.0f);
     skybox->SetVertexShader(cubeMapVertexShader);
@@ -381,6 +459,38 @@ INT WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
         return 0;
     }
 
+    // The sun shadows the whole terrain through cascades fitted to the camera
+    std::shared_ptr<library::DirectionalLight> sunLight = std::make_shared<library::DirectionalLight>(
+        XMFLOAT4(0.577f, -0.577f, 0.577f, 0.0f),
+        XMFLOAT4(0.5f, 0.5f, 0.5f, 1.0f)
+        );
+    mainScene->SetDirectionalLight(sunLight);
+
+    // A grid of local lights above the terrain, binned into clusters so every pixel only shades the ones that reach it
+    constexpr const UINT NUM_LOCAL_LIGHTS_PER_SIDE = 32u;
+    const XMFLOAT4 aLocalLightColors[] =
+    {
+        XMFLOAT4(80.0f, 24.0f, 8.0f, 1.0f),
+        XMFLOAT4(8.0f, 40.0f, 80.0f, 1.0f),
+        XMFLOAT4(24.0f, 80.0f, 16.0f, 1.0f),
+        XMFLOAT4(64.0f, 16.0f, 72.0f, 1.0f),
+    };
+    for (UINT z = 0u; z < NUM_LOCAL_LIGHTS_PER_SIDE; ++z)
+    {
+        for (UINT x = 0u; x < NUM_LOCAL_LIGHTS_PER_SIDE; ++x)
+        {
+            std::shared_ptr<library::PointLight> localLight = std::make_shared<library::PointLight>(
+                XMFLOAT4(-248.0f + 16.0f * static_cast<FLOAT>(x), 26.0f, -248.0f + 16.0f * static_cast<FLOAT>(z), 1.0f),
+                aLocalLightColors[(x + z) % ARRAYSIZE(aLocalLightColors)],
+                32.0f
+                );
+            if (FAILED(mainScene->AddLocalLight(localLight)))
+            {
+                return 0;
+            }
+        }
+    }
+
     if (FAILED(game->GetRenderer()->AddScene(L"VoxelMap", mainScene)))
     {
         return 0;
@@ -393,7 +503,8 @@ INT WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
 
     if (FAILED(game->Initialize(hInstance, nCmdShow)))
     {
-        return 0;
+        // Scripted runs see the failure in the exit code
+        return EXIT_FAILURE;
     }
 
     return game->Run();
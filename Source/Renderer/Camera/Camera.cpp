@@ -1,5 +1,7 @@
 #include "Camera/Camera.h"
 
+#include "Renderer/VersionCounter.h"
+
 namespace library
 {
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -10,11 +12,10 @@ namespace library
       Modifies: [m_yaw, m_pitch, m_moveLeftRight, m_moveBackForward,
                  m_moveUpDown, m_travelSpeed, m_rotationSpeed, 
                  m_padding, m_cameraForward, m_cameraRight, m_cameraUp, 
-                 m_eye, m_at, m_up, m_rotation, m_view].
+                 m_eye, m_at, m_up, m_rotation, m_view, m_uVersion].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     Camera::Camera(_In_ const XMVECTOR& position)
-        : m_cbChangeOnCameraMovement()
-        , m_yaw(0.0f)
+        : m_yaw(0.0f)
         , m_pitch(0.0f)
         , m_moveLeftRight(0.0f)
         , m_moveBackForward(0.0f)
@@ -30,6 +31,7 @@ namespace library
         , m_up(XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f))
         , m_rotation(XMMatrixIdentity())
         , m_view(XMMatrixLookAtLH(m_eye, m_at, m_up))
+        , m_uVersion(VersionCounter::Next())
     {
         // empty
     }
@@ -87,16 +89,18 @@ namespace library
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Camera::GetConstantBuffer
+      Method:   Camera::GetVersion
 
-      Summary:  Returns the constant buffer
+      Summary:  Returns the version of the view matrix. It only changes
+                when the view matrix does, so the camera constants of a
+                still camera need no upload
 
-      Returns:  ComPtr<ID3D11Buffer>&
-                  The constant buffer
+      Returns:  UINT64
+                  Version taken from VersionCounter
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    ComPtr<ID3D11Buffer>& Camera::GetConstantBuffer()
+    UINT64 Camera::GetVersion() const
     {
-        return m_cbChangeOnCameraMovement;
+        return m_uVersion;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -160,42 +164,6 @@ namespace library
         Update(deltaTime);
     }
 
-    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Camera::Initialize
-
-      Summary:  Initialize the view matrix constant buffers
-
-      Args:     ID3D11Device* pDevice
-                  Pointer to a Direct3D 11 device
-
-      Modifies: [m_cbChangeOnCameraMovement].
-    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    HRESULT Camera::Initialize(_In_ ID3D11Device* device)
-    {
-        HRESULT hr = S_OK;
-
-        D3D11_BUFFER_DESC bd =
-        {
-            .ByteWidth = sizeof(CBChangeOnCameraMovement),
-            .Usage = D3D11_USAGE_DEFAULT,
-            .BindFlags = D3D11_BIND_CONSTANT_BUFFER,
-            .CPUAccessFlags = 0u
-        };
-        hr = device->CreateBuffer(&bd, nullptr, m_cbChangeOnCameraMovement.GetAddressOf());
-        if (FAILED(hr))
-        {
-            MessageBox(
-                nullptr,
-                L"Call to CreateCameraBuffer failed!",
-                L"Game Graphics Programming",
-                NULL
-            );
-            return hr;
-        }
-
-        return hr;
-    }
-
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Camera::Update
 
@@ -206,7 +174,8 @@ namespace library
 
       Modifies: [m_rotation, m_at, m_cameraRight, m_cameraUp, 
                  m_cameraForward, m_eye, m_moveLeftRight, 
-                 m_moveBackForward, m_moveUpDown, m_up, m_view].
+                 m_moveBackForward, m_moveUpDown, m_up, m_view,
+                 m_uVersion].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     void Camera::Update(_In_ FLOAT deltaTime)
     {
@@ -235,6 +204,12 @@ namespace library
         m_moveUpDown = 0.0f;
 
         // Determine the view matrix
-        m_view = XMMatrixLookAtLH(m_eye, m_at, m_up);
+        XMMATRIX view = XMMatrixLookAtLH(m_eye, m_at, m_up);
+        if (!XMVector4Equal(view.r[0], m_view.r[0]) || !XMVector4Equal(view.r[1], m_view.r[1]) ||
+            !XMVector4Equal(view.r[2], m_view.r[2]) || !XMVector4Equal(view.r[3], m_view.r[3]))
+        {
+            m_view = view;
+            m_uVersion = VersionCounter::Next();
+        }
     }
 }
\ No newline at end of file
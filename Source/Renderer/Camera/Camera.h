@@ -31,12 +31,10 @@ namespace library
                   Getter for the up vector
                 GetView
                   Getter for the view transform matrix
-                GetConstantBuffer
-                  Get the constant buffer containing the view transform
+                GetVersion
+                  Getter for the version of the view transform matrix
                 HandleInput
                   Handles the keyboard / mouse input
-                Initialize
-                  Initialize the view matrix constant buffers
                 Update
                   Update the camera according to the input
                 Camera
@@ -59,18 +57,15 @@ namespace library
         const XMVECTOR& GetAt() const;
         const XMVECTOR& GetUp() const;
         const XMMATRIX& GetView() const;
-        ComPtr<ID3D11Buffer>& GetConstantBuffer();
+        UINT64 GetVersion() const;
 
         virtual void HandleInput(_In_ const DirectionsInput& directions, _In_ const MouseRelativeMovement& mouseRelativeMovement, _In_ FLOAT deltaTime);
-        virtual HRESULT Initialize(_In_ ID3D11Device* device);
         virtual void Update(_In_ FLOAT deltaTime);
     protected:
         static constexpr const XMVECTORF32 DEFAULT_FORWARD = { 0.0f, 0.0f, 1.0f, 0.0f };
         static constexpr const XMVECTORF32 DEFAULT_RIGHT = { 1.0f, 0.0f, 0.0f, 0.0f };
         static constexpr const XMVECTORF32 DEFAULT_UP = { 0.0f, 1.0f, 0.0f, 0.0f };
 
-        ComPtr<ID3D11Buffer> m_cbChangeOnCameraMovement;
-
         FLOAT m_yaw;
         FLOAT m_pitch;
 
@@ -93,5 +88,7 @@ namespace library
 
         XMMATRIX m_rotation;
         XMMATRIX m_view;
+
+        UINT64 m_uVersion;
     };
 }
\ No newline at end of file
@@ -30,6 +30,7 @@
 #include <d3d11_4.h>
 #include <d3dcompiler.h>
 #include <directxcolors.h>
+#include <DirectXCollision.h>
 
 #define _CRTDBG_MAP_ALLOC
 #include <stdlib.h>
@@ -104,4 +105,34 @@ namespace library
         TROPICAL_RAIN_FOREST,
         COUNT,
     };
+
+    // Starting value of the 64-bit FNV-1a hash computed by HashBytes
+    constexpr UINT64 HASH_OFFSET_BASIS = 14695981039346656037ull;
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: HashBytes
+
+      Summary:  Continues a 64-bit FNV-1a hash with the given bytes
+
+      Args:     UINT64 uHash
+                  Hash of the previous bytes
+                const void* pData
+                  Bytes to hash
+                size_t uSize
+                  Number of bytes
+
+      Returns:  UINT64
+                  Updated hash
+    -----------------------------------------------------------------F-F*/
+    inline UINT64 HashBytes(_In_ UINT64 uHash, _In_reads_bytes_(uSize) const void* pData, _In_ size_t uSize)
+    {
+        const BYTE* pBytes = static_cast<const BYTE*>(pData);
+        for (size_t i = 0u; i < uSize; ++i)
+        {
+            uHash ^= pBytes[i];
+            uHash *= 1099511628211ull;
+        }
+
+        return uHash;
+    }
 }
\ No newline at end of file
@@ -10,12 +10,14 @@ namespace library
       Args:     PCWSTR pszGameName
                   Name of the game
 
-      Modifies: [m_pszGameName, m_mainWindow, m_renderer].
+      Modifies: [m_pszGameName, m_mainWindow, m_renderer,
+                 m_uFrameLimit].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     Game::Game(_In_ PCWSTR pszGameName)
         : m_pszGameName(pszGameName)
         , m_mainWindow(std::make_unique<MainWindow>())
         , m_renderer(std::make_unique<Renderer>())
+        , m_uFrameLimit(0u)
     {
         // empty
     }
@@ -54,7 +56,9 @@ namespace library
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Game::Run
 
-      Summary:  Runs the game loop
+      Summary:  Runs the game loop until the window is closed or the
+                frame limit is reached. Profiling builds write the
+                trace of the last frames to ProfilerTrace.json on exit
 
       Returns:  INT
                   Status code to return to the operating system
@@ -67,6 +71,7 @@ namespace library
         LARGE_INTEGER Frequency;
 
         FLOAT deltaTime;
+        UINT uNumFrames = 0u;
 
         QueryPerformanceFrequency(&Frequency);
         QueryPerformanceCounter(&LastTime);
@@ -98,12 +103,39 @@ namespace library
                 // Render
                 m_renderer->Update(deltaTime);
                 m_renderer->Render();
+
+                PROFILE_FRAME();
+
+                if (m_uFrameLimit > 0u && ++uNumFrames == m_uFrameLimit)
+                {
+                    PostQuitMessage(0);
+                }
             }
         }
 
+#if PROFILER_ENABLED
+        Profiler::ExportChromeTrace(L"ProfilerTrace.json");
+#endif
+
         return static_cast<INT>(msg.wParam);
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Game::SetFrameLimit
+
+      Summary:  Set after how many rendered frames Run quits, so a
+                scripted run renders a fixed number of frames
+
+      Args:     UINT uNumFrames
+                  Number of frames, 0 runs until the window is closed
+
+      Modifies: [m_uFrameLimit].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Game::SetFrameLimit(_In_ UINT uNumFrames)
+    {
+        m_uFrameLimit = uNumFrames;
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Game::GetGameName
 
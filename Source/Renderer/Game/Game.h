@@ -27,6 +27,8 @@ namespace library
                   Initializes the components of the game
                 Run
                   Runs the game loop
+                SetFrameLimit
+                  Sets after how many frames the game loop quits
                 GetGameName
                   Returns the name of the game
                 GetWindow
@@ -52,6 +54,7 @@ namespace library
 
         HRESULT Initialize(_In_ HINSTANCE hInstance, _In_ INT nCmdShow);
         INT Run();
+        void SetFrameLimit(_In_ UINT uNumFrames);
 
         PCWSTR GetGameName() const;
         std::unique_ptr<MainWindow>& GetWindow();
@@ -60,5 +63,6 @@ namespace library
         PCWSTR m_pszGameName;
         std::unique_ptr<MainWindow> m_mainWindow;
         std::unique_ptr<Renderer> m_renderer;
+        UINT m_uFrameLimit;
     };
 }
\ No newline at end of file
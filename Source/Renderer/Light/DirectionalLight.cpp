@@ -0,0 +1,107 @@
+#include "Light/DirectionalLight.h"
+
+#include "Renderer/VersionCounter.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DirectionalLight::DirectionalLight
+
+      Summary:  Constructor
+
+      Args:     const XMFLOAT4& direction
+                  Direction the light travels in, normalized here
+                const XMFLOAT4& color
+                  Color of the light
+
+      Modifies: [m_direction, m_color, m_uVersion].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    DirectionalLight::DirectionalLight(_In_ const XMFLOAT4& direction, _In_ const XMFLOAT4& color)
+        : m_direction()
+        , m_color(color)
+        , m_uVersion(VersionCounter::Next())
+    {
+        XMStoreFloat4(&m_direction, XMVector3Normalize(XMVectorSetW(XMLoadFloat4(&direction), 0.0f)));
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DirectionalLight::GetDirection
+
+      Summary:  Returns the direction the light travels in
+
+      Returns:  const XMFLOAT4&
+                  Normalized direction, w is 0
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const XMFLOAT4& DirectionalLight::GetDirection() const
+    {
+        return m_direction;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DirectionalLight::GetColor
+
+      Summary:  Returns the color of the light
+
+      Returns:  const XMFLOAT4&
+                  Color of the light
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const XMFLOAT4& DirectionalLight::GetColor() const
+    {
+        return m_color;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DirectionalLight::GetVersion
+
+      Summary:  Returns the version of the light, it grows whenever
+                the direction changes
+
+      Returns:  UINT64
+                  Version taken from VersionCounter
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 DirectionalLight::GetVersion() const
+    {
+        return m_uVersion;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DirectionalLight::SetDirection
+
+      Summary:  Replaces the direction of the light
+
+      Args:     const XMFLOAT4& direction
+                  Direction the light travels in, normalized here
+
+      Modifies: [m_direction, m_uVersion].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void DirectionalLight::SetDirection(_In_ const XMFLOAT4& direction)
+    {
+        XMStoreFloat4(&m_direction, XMVector3Normalize(XMVectorSetW(XMLoadFloat4(&direction), 0.0f)));
+        markDirty();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DirectionalLight::Update
+
+      Summary:  Updates the light every frame
+
+      Args:     FLOAT deltaTime
+                  Elapsed time
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void DirectionalLight::Update(_In_ FLOAT deltaTime)
+    {
+        UNREFERENCED_PARAMETER(deltaTime);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DirectionalLight::markDirty
+
+      Summary:  Takes a new version after the light changed
+
+      Modifies: [m_uVersion].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void DirectionalLight::markDirty()
+    {
+        m_uVersion = VersionCounter::Next();
+    }
+}
\ No newline at end of file
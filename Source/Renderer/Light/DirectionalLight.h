@@ -0,0 +1,67 @@
+/*+===================================================================
+  File:      DIRECTIONALLIGHT.H
+
+  Summary:   DirectionalLight header file contains declaration of
+             class DirectionalLight, a light infinitely far away that
+             lights the whole scene from one direction.
+
+  Classes:  DirectionalLight
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    DirectionalLight
+
+      Summary:  Light whose rays are parallel, like the sun. It has no
+                position, its shadows are rendered into cascades
+                fitted to the view of the camera
+
+      Methods:  GetDirection
+                  Returns the direction the light travels in
+                GetColor
+                  Returns the color of the light
+                GetVersion
+                  Returns the version of the light
+                SetDirection
+                  Replaces the direction of the light
+                Update
+                  Updates the light
+                DirectionalLight
+                  Constructor.
+                ~DirectionalLight
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class DirectionalLight
+    {
+    public:
+        DirectionalLight() = delete;
+        DirectionalLight(_In_ const XMFLOAT4& direction, _In_ const XMFLOAT4& color);
+        DirectionalLight(const DirectionalLight& other) = default;
+        DirectionalLight(DirectionalLight&& other) = default;
+        DirectionalLight& operator=(const DirectionalLight& other) = default;
+        DirectionalLight& operator=(DirectionalLight&& other) = default;
+        virtual ~DirectionalLight() = default;
+
+        const XMFLOAT4& GetDirection() const;
+        const XMFLOAT4& GetColor() const;
+        UINT64 GetVersion() const;
+
+        void SetDirection(_In_ const XMFLOAT4& direction);
+
+        virtual void Update(_In_ FLOAT deltaTime);
+
+    protected:
+        void markDirty();
+
+    protected:
+        XMFLOAT4 m_direction;
+        XMFLOAT4 m_color;
+        UINT64 m_uVersion;
+    };
+}
\ No newline at end of file
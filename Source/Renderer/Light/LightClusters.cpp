@@ -0,0 +1,539 @@
+#include "Light/LightClusters.h"
+
+#include <cmath>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusters::GetClusterIndex
+
+      Summary:  Returns the index of a cluster of the grid. Clusters
+                are ordered by slice, so a range of slices is a range
+                of clusters
+
+      Args:     UINT uX
+                  Tile along x
+                UINT uY
+                  Tile along y, 0 is the top row of the screen
+                UINT uZ
+                  Slice of the view depth
+
+      Returns:  UINT
+                  Index of the cluster
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT LightClusters::GetClusterIndex(_In_ UINT uX, _In_ UINT uY, _In_ UINT uZ)
+    {
+        return (uZ * NUM_CLUSTERS_Y + uY) * NUM_CLUSTERS_X + uX;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusters::LightClusters
+
+      Summary:  Constructor
+
+      Args:     UINT uNumThreads
+                  Maximum number of threads a build runs on, the
+                  calling thread included
+
+      Modifies: [m_workers, m_uNumThreads, m_projection,
+                 m_aPlanesXNormalX, m_aPlanesXNormalZ,
+                 m_aPlanesYNormalY, m_aPlanesYNormalZ, m_nearZ,
+                 m_farZ, m_sliceScale, m_sliceBias, m_aViewSpheres,
+                 m_aLightBounds, m_aVisible, m_aVisibleLights,
+                 m_aClusterRanges, m_aLightIndices].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    LightClusters::LightClusters(_In_ UINT uNumThreads)
+        : m_workers(uNumThreads > 1u ? std::make_unique<AssetLoader>(uNumThreads - 1u) : nullptr)
+        , m_uNumThreads(uNumThreads > 1u ? uNumThreads : 1u)
+        , m_projection()
+        , m_aPlanesXNormalX()
+        , m_aPlanesXNormalZ()
+        , m_aPlanesYNormalY()
+        , m_aPlanesYNormalZ()
+        , m_nearZ(0.0f)
+        , m_farZ(0.0f)
+        , m_sliceScale(0.0f)
+        , m_sliceBias(0.0f)
+        , m_aViewSpheres()
+        , m_aLightBounds()
+        , m_aVisible()
+        , m_aVisibleLights()
+        , m_aClusterRanges(NUM_CLUSTERS, XMUINT2(0u, 0u))
+        , m_aLightIndices()
+    {
+        // empty
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusters::Build
+
+      Summary:  Bins the lights into the clusters of the view. The
+                light spheres are bounded on the worker threads in
+                partitions of lights, then counted and written in
+                partitions of slices. Lights outside the view are in
+                no cluster
+
+      Args:     const XMMATRIX& cameraView
+                  View matrix of the camera
+                const XMMATRIX& cameraProjection
+                  Left handed perspective projection of the camera
+                const std::vector<ClusterLight>& aLights
+                  World position and radius, and color of the lights
+
+      Modifies: [m_projection, m_aPlanesXNormalX, m_aPlanesXNormalZ,
+                 m_aPlanesYNormalY, m_aPlanesYNormalZ, m_nearZ,
+                 m_farZ, m_sliceScale, m_sliceBias, m_aViewSpheres,
+                 m_aLightBounds, m_aVisible, m_aVisibleLights,
+                 m_aClusterRanges, m_aLightIndices].
+
+      Returns:  HRESULT
+                  Status code, the first failure of a worker
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT LightClusters::Build(
+        _In_ const XMMATRIX& cameraView,
+        _In_ const XMMATRIX& cameraProjection,
+        _In_ const std::vector<ClusterLight>& aLights
+    )
+    {
+        PROFILE_SCOPE("LightClusters::Build");
+
+        updatePlanes(cameraProjection);
+
+        const UINT uNumLights = static_cast<UINT>(aLights.size());
+        m_aViewSpheres.resize(uNumLights);
+        m_aLightBounds.resize(uNumLights);
+        m_aVisible.resize(uNumLights);
+
+        UINT uNumPartitions = uNumLights / MIN_LIGHTS_PER_THREAD;
+        uNumPartitions = uNumPartitions < m_uNumThreads ? uNumPartitions : m_uNumThreads;
+        HRESULT hr = AssetLoader::ParallelFor(
+            m_workers.get(),
+            uNumLights,
+            uNumPartitions > 1u ? uNumPartitions : 1u,
+            [this, &cameraView, &aLights](_In_ UINT uBegin, _In_ UINT uEnd)
+            {
+                computeLightBounds(cameraView, aLights, uBegin, uEnd);
+            }
+        );
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        m_aVisibleLights.clear();
+        for (UINT i = 0u; i < uNumLights; ++i)
+        {
+            if (m_aVisible[i])
+            {
+                m_aVisibleLights.push_back(i);
+            }
+        }
+
+        // Every partition of slices owns its clusters, so the passes write without synchronization
+        uNumPartitions = m_aVisibleLights.size() < MIN_LIGHTS_PER_THREAD ? 1u : m_uNumThreads;
+        uNumPartitions = uNumPartitions < NUM_CLUSTERS_Z ? uNumPartitions : NUM_CLUSTERS_Z;
+
+        m_aClusterRanges.assign(NUM_CLUSTERS, XMUINT2(0u, 0u));
+        hr = AssetLoader::ParallelFor(m_workers.get(), NUM_CLUSTERS_Z, uNumPartitions, [this](_In_ UINT uBegin, _In_ UINT uEnd) { countLights(uBegin, uEnd); });
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        // The counts become offsets, the fill pass counts the lights again as it writes them
+        UINT uNumIndices = 0u;
+        for (XMUINT2& range : m_aClusterRanges)
+        {
+            range.x = uNumIndices;
+            uNumIndices += range.y;
+            range.y = 0u;
+        }
+        m_aLightIndices.resize(uNumIndices);
+
+        return AssetLoader::ParallelFor(m_workers.get(), NUM_CLUSTERS_Z, uNumPartitions, [this](_In_ UINT uBegin, _In_ UINT uEnd) { fillLights(uBegin, uEnd); });
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusters::GetSlice
+
+      Summary:  Returns the slice a view depth falls in. Slices grow
+                exponentially with the depth, the first one reaches
+                from the near plane to the minimum slice depth
+
+      Args:     FLOAT viewDepth
+                  Depth in view space
+
+      Returns:  UINT
+                  Slice, clamped to the grid
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT LightClusters::GetSlice(_In_ FLOAT viewDepth) const
+    {
+        if (viewDepth <= 0.0f)
+        {
+            return 0u;
+        }
+
+        const FLOAT slice = std::log(viewDepth) * m_sliceScale + m_sliceBias;
+        if (!(slice > 0.0f))
+        {
+            return 0u;
+        }
+
+        const UINT uSlice = static_cast<UINT>(slice);
+        return uSlice < NUM_CLUSTERS_Z ? uSlice : NUM_CLUSTERS_Z - 1u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusters::GetLightBounds
+
+      Summary:  Returns the clusters a light of the last build reaches
+
+      Args:     UINT uLight
+                  Index of the light
+                ClusterLightBounds& outBounds
+                  Receives the inclusive range of clusters along each
+                  axis
+
+      Returns:  BOOL
+                  TRUE if the light is inside the view
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL LightClusters::GetLightBounds(_In_ UINT uLight, _Out_ ClusterLightBounds& outBounds) const
+    {
+        assert(uLight < m_aLightBounds.size());
+
+        outBounds = m_aLightBounds[uLight];
+        return m_aVisible[uLight];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusters::GetClusterRanges
+
+      Summary:  Returns the lights of every cluster, x is the offset
+                of the first light index and y the number of lights
+
+      Returns:  const std::vector<XMUINT2>&
+                  Ranges of the light indices, one per cluster
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::vector<XMUINT2>& LightClusters::GetClusterRanges() const
+    {
+        return m_aClusterRanges;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusters::GetLightIndices
+
+      Summary:  Returns the light indices of all clusters, the ranges
+                of the clusters index into it
+
+      Returns:  const std::vector<UINT>&
+                  Indices into the lights of the last build
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::vector<UINT>& LightClusters::GetLightIndices() const
+    {
+        return m_aLightIndices;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusters::GetSliceScale
+
+      Summary:  Returns the scale of the logarithm of the view depth,
+                the slice is log(depth) * scale + bias
+
+      Returns:  FLOAT
+                  Scale of the slice function
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT LightClusters::GetSliceScale() const
+    {
+        return m_sliceScale;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusters::GetSliceBias
+
+      Summary:  Returns the bias of the logarithm of the view depth,
+                the slice is log(depth) * scale + bias
+
+      Returns:  FLOAT
+                  Bias of the slice function
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT LightClusters::GetSliceBias() const
+    {
+        return m_sliceBias;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusters::GetNumVisibleLights
+
+      Summary:  Returns the number of lights of the last build that are
+                inside the view
+
+      Returns:  UINT
+                  Number of binned lights
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT LightClusters::GetNumVisibleLights() const
+    {
+        return static_cast<UINT>(m_aVisibleLights.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusters::updatePlanes
+
+      Summary:  Rebuilds the tile planes and the slice function when
+                the projection changed. The planes go through the eye
+                and a tile boundary of the normalized device
+                coordinates, their normals point to the right and up
+                and are stored a component per vector, four planes at
+                a time
+
+      Args:     const XMMATRIX& cameraProjection
+                  Left handed perspective projection of the camera
+
+      Modifies: [m_projection, m_aPlanesXNormalX, m_aPlanesXNormalZ,
+                 m_aPlanesYNormalY, m_aPlanesYNormalZ, m_nearZ,
+                 m_farZ, m_sliceScale, m_sliceBias].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void LightClusters::updatePlanes(_In_ const XMMATRIX& cameraProjection)
+    {
+        XMFLOAT4X4 projection;
+        XMStoreFloat4x4(&projection, cameraProjection);
+        if (memcmp(&projection, &m_projection, sizeof(projection)) == 0)
+        {
+            return;
+        }
+        m_projection = projection;
+
+        // Near and far plane, read back from the projection
+        m_nearZ = -projection._43 / projection._33;
+        m_farZ = projection._43 / (1.0f - projection._33);
+
+        FLOAT aNormalsX[NUM_PLANE_VECTORS_X * 4u] = {};
+        FLOAT aDepthsX[NUM_PLANE_VECTORS_X * 4u] = {};
+        for (UINT i = 0u; i <= NUM_CLUSTERS_X; ++i)
+        {
+            const FLOAT boundary = -1.0f + 2.0f * static_cast<FLOAT>(i) / static_cast<FLOAT>(NUM_CLUSTERS_X);
+            const FLOAT length = std::sqrt(projection._11 * projection._11 + boundary * boundary);
+            aNormalsX[i] = projection._11 / length;
+            aDepthsX[i] = -boundary / length;
+        }
+
+        FLOAT aNormalsY[NUM_PLANE_VECTORS_Y * 4u] = {};
+        FLOAT aDepthsY[NUM_PLANE_VECTORS_Y * 4u] = {};
+        for (UINT i = 0u; i <= NUM_CLUSTERS_Y; ++i)
+        {
+            const FLOAT boundary = -1.0f + 2.0f * static_cast<FLOAT>(i) / static_cast<FLOAT>(NUM_CLUSTERS_Y);
+            const FLOAT length = std::sqrt(projection._22 * projection._22 + boundary * boundary);
+            aNormalsY[i] = projection._22 / length;
+            aDepthsY[i] = -boundary / length;
+        }
+
+        for (UINT i = 0u; i < NUM_PLANE_VECTORS_X; ++i)
+        {
+            m_aPlanesXNormalX[i] = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&aNormalsX[i * 4u]));
+            m_aPlanesXNormalZ[i] = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&aDepthsX[i * 4u]));
+        }
+
+        for (UINT i = 0u; i < NUM_PLANE_VECTORS_Y; ++i)
+        {
+            m_aPlanesYNormalY[i] = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&aNormalsY[i * 4u]));
+            m_aPlanesYNormalZ[i] = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&aDepthsY[i * 4u]));
+        }
+
+        // Slice 0 ends at the minimum slice depth, the others split the rest of the view exponentially
+        const FLOAT sliceNearZ = m_nearZ > MIN_SLICE_DEPTH ? m_nearZ : MIN_SLICE_DEPTH;
+        m_sliceScale = static_cast<FLOAT>(NUM_CLUSTERS_Z - 1u) / std::log(m_farZ / sliceNearZ);
+        m_sliceBias = 1.0f - std::log(sliceNearZ) * m_sliceScale;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusters::computeLightBounds
+
+      Summary:  Transforms a range of light spheres into view space
+                and finds the clusters they reach. A sphere is right of
+                a tile boundary when its signed distance to the plane
+                exceeds its radius and left of it when the distance is
+                below the negative radius, the tiles it reaches lie
+                between the boundaries it is wholly on one side of.
+                Spheres that cross the eye plane reach every tile
+
+      Args:     const XMMATRIX& cameraView
+                  View matrix of the camera
+                const std::vector<ClusterLight>& aLights
+                  The lights of the build
+                UINT uBegin
+                  First light of the range
+                UINT uEnd
+                  One past the last light of the range
+
+      Modifies: [m_aViewSpheres, m_aLightBounds, m_aVisible].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void LightClusters::computeLightBounds(
+        _In_ const XMMATRIX& cameraView,
+        _In_ const std::vector<ClusterLight>& aLights,
+        _In_ UINT uBegin,
+        _In_ UINT uEnd
+    )
+    {
+        if (uBegin == uEnd)
+        {
+            return;
+        }
+
+        XMVector3TransformCoordStream(
+            reinterpret_cast<XMFLOAT3*>(&m_aViewSpheres[uBegin]),
+            sizeof(XMFLOAT4),
+            reinterpret_cast<const XMFLOAT3*>(&aLights[uBegin].PositionAndRadius),
+            sizeof(ClusterLight),
+            uEnd - uBegin,
+            cameraView
+        );
+
+        // Number of planes of a set the sphere is wholly on the positive and on the negative side of
+        const XMVECTOR one = XMVectorSplatOne();
+        auto countSides = [&one](
+            _In_ const XMVECTOR& offset,
+            _In_ const XMVECTOR& depth,
+            _In_ const XMVECTOR& radius,
+            _In_reads_(uNumVectors) const XMVECTOR* aNormals,
+            _In_reads_(uNumVectors) const XMVECTOR* aDepths,
+            _In_ UINT uNumVectors,
+            _Out_ UINT& uOutPositive,
+            _Out_ UINT& uOutNegative
+        )
+        {
+            const XMVECTOR negativeRadius = XMVectorNegate(radius);
+            XMVECTOR positive = XMVectorZero();
+            XMVECTOR negative = XMVectorZero();
+            for (UINT i = 0u; i < uNumVectors; ++i)
+            {
+                const XMVECTOR distance = XMVectorMultiplyAdd(offset, aNormals[i], XMVectorMultiply(depth, aDepths[i]));
+                positive = XMVectorAdd(positive, XMVectorAndInt(XMVectorGreater(distance, radius), one));
+                negative = XMVectorAdd(negative, XMVectorAndInt(XMVectorLess(distance, negativeRadius), one));
+            }
+            uOutPositive = static_cast<UINT>(XMVectorGetX(XMVectorSum(positive)));
+            uOutNegative = static_cast<UINT>(XMVectorGetX(XMVectorSum(negative)));
+        };
+
+        for (UINT i = uBegin; i < uEnd; ++i)
+        {
+            XMFLOAT4& sphere = m_aViewSpheres[i];
+            sphere.w = aLights[i].PositionAndRadius.w;
+
+            const FLOAT minZ = sphere.z - sphere.w;
+            const FLOAT maxZ = sphere.z + sphere.w;
+            m_aVisible[i] = sphere.w > 0.0f && maxZ > m_nearZ && minZ < m_farZ;
+            if (!m_aVisible[i])
+            {
+                continue;
+            }
+
+            ClusterLightBounds& bounds = m_aLightBounds[i];
+            bounds =
+            {
+                .uMinX = 0u,
+                .uMaxX = NUM_CLUSTERS_X - 1u,
+                .uMinY = 0u,
+                .uMaxY = NUM_CLUSTERS_Y - 1u,
+                .uMinZ = GetSlice(minZ),
+                .uMaxZ = GetSlice(maxZ < m_farZ ? maxZ : m_farZ)
+            };
+
+            if (minZ <= 0.0f)
+            {
+                continue;
+            }
+
+            const XMVECTOR depth = XMVectorReplicate(sphere.z);
+            const XMVECTOR radius = XMVectorReplicate(sphere.w);
+
+            UINT uRight = 0u;
+            UINT uLeft = 0u;
+            countSides(XMVectorReplicate(sphere.x), depth, radius, m_aPlanesXNormalX, m_aPlanesXNormalZ, NUM_PLANE_VECTORS_X, uRight, uLeft);
+
+            UINT uAbove = 0u;
+            UINT uBelow = 0u;
+            countSides(XMVectorReplicate(sphere.y), depth, radius, m_aPlanesYNormalY, m_aPlanesYNormalZ, NUM_PLANE_VECTORS_Y, uAbove, uBelow);
+
+            // Wholly beyond the outermost boundary of a side
+            if (uRight > NUM_CLUSTERS_X || uLeft > NUM_CLUSTERS_X || uAbove > NUM_CLUSTERS_Y || uBelow > NUM_CLUSTERS_Y)
+            {
+                m_aVisible[i] = FALSE;
+                continue;
+            }
+
+            bounds.uMinX = uRight > 0u ? uRight - 1u : 0u;
+            bounds.uMaxX = uLeft > 0u ? NUM_CLUSTERS_X - uLeft : NUM_CLUSTERS_X - 1u;
+
+            // The planes count up from the bottom of the screen, the tiles down from the top
+            bounds.uMinY = uBelow > 0u ? uBelow - 1u : 0u;
+            bounds.uMaxY = uAbove > 0u ? NUM_CLUSTERS_Y - uAbove : NUM_CLUSTERS_Y - 1u;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusters::countLights
+
+      Summary:  Counts the visible lights of the clusters of a range of
+                slices into the y of their ranges
+
+      Args:     UINT uBeginSlice
+                  First slice of the range
+                UINT uEndSlice
+                  One past the last slice of the range
+
+      Modifies: [m_aClusterRanges].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void LightClusters::countLights(_In_ UINT uBeginSlice, _In_ UINT uEndSlice)
+    {
+        for (UINT uLight : m_aVisibleLights)
+        {
+            const ClusterLightBounds& bounds = m_aLightBounds[uLight];
+            const UINT uBeginZ = bounds.uMinZ > uBeginSlice ? bounds.uMinZ : uBeginSlice;
+            const UINT uEndZ = bounds.uMaxZ + 1u < uEndSlice ? bounds.uMaxZ + 1u : uEndSlice;
+            for (UINT z = uBeginZ; z < uEndZ; ++z)
+            {
+                for (UINT y = bounds.uMinY; y <= bounds.uMaxY; ++y)
+                {
+                    for (UINT x = bounds.uMinX; x <= bounds.uMaxX; ++x)
+                    {
+                        ++m_aClusterRanges[GetClusterIndex(x, y, z)].y;
+                    }
+                }
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusters::fillLights
+
+      Summary:  Writes the visible lights of the clusters of a range
+                of slices behind the offsets of their ranges
+
+      Args:     UINT uBeginSlice
+                  First slice of the range
+                UINT uEndSlice
+                  One past the last slice of the range
+
+      Modifies: [m_aClusterRanges, m_aLightIndices].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void LightClusters::fillLights(_In_ UINT uBeginSlice, _In_ UINT uEndSlice)
+    {
+        for (UINT uLight : m_aVisibleLights)
+        {
+            const ClusterLightBounds& bounds = m_aLightBounds[uLight];
+            const UINT uBeginZ = bounds.uMinZ > uBeginSlice ? bounds.uMinZ : uBeginSlice;
+            const UINT uEndZ = bounds.uMaxZ + 1u < uEndSlice ? bounds.uMaxZ + 1u : uEndSlice;
+            for (UINT z = uBeginZ; z < uEndZ; ++z)
+            {
+                for (UINT y = bounds.uMinY; y <= bounds.uMaxY; ++y)
+                {
+                    for (UINT x = bounds.uMinX; x <= bounds.uMaxX; ++x)
+                    {
+                        XMUINT2& range = m_aClusterRanges[GetClusterIndex(x, y, z)];
+                        m_aLightIndices[range.x + range.y] = uLight;
+                        ++range.y;
+                    }
+                }
+            }
+        }
+    }
+}
\ No newline at end of file
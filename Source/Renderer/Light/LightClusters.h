@@ -0,0 +1,144 @@
+/*+===================================================================
+  File:      LIGHTCLUSTERS.H
+
+  Summary:   LightClusters header file contains declaration of class
+             LightClusters that splits the view of the camera into a
+             grid of clusters and bins the local lights into the
+             clusters they reach, for clustered forward shading.
+
+  Classes:  LightClusters
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Profiler/Profiler.h"
+#include "Renderer/AssetLoader.h"
+#include "Renderer/DataTypes.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   ClusterLightBounds
+
+      Summary:  Inclusive range of clusters a light reaches along each
+                axis of the grid. Tile 0 along y is the top row of the
+                screen
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct ClusterLightBounds
+    {
+        UINT uMinX;
+        UINT uMaxX;
+        UINT uMinY;
+        UINT uMaxY;
+        UINT uMinZ;
+        UINT uMaxZ;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    LightClusters
+
+      Summary:  Froxel grid of the camera frustum, free of any device
+                so it can run and be checked on the CPU alone. The grid
+                is split in screen tiles along x and y and in
+                exponential slices of the view depth along z, the first
+                slice reaching from the near plane to the minimum slice
+                depth. Build transforms the light spheres into view
+                space, tests them against the tile planes four planes
+                at a time, and bins them in parallel partitions of
+                slices, which own disjoint clusters, in two passes:
+                one counts the lights of every cluster, and after a
+                prefix sum one writes their indices. The lights of a
+                cluster are in the order of the input
+
+      Methods:  Build
+                  Bins the lights into the clusters of the view
+                GetClusterIndex
+                  Returns the index of a cluster of the grid
+                GetSlice
+                  Returns the slice a view depth falls in
+                GetLightBounds
+                  Returns the clusters a light reaches
+                GetClusterRanges
+                  Returns the offset and count of the lights of every
+                  cluster
+                GetLightIndices
+                  Returns the light indices of all clusters
+                GetSliceScale
+                  Returns the scale of the logarithm of the view depth
+                GetSliceBias
+                  Returns the bias of the logarithm of the view depth
+                GetNumVisibleLights
+                  Returns the number of lights inside the view
+                LightClusters
+                  Constructor.
+                ~LightClusters
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class LightClusters final
+    {
+    public:
+        static constexpr UINT NUM_CLUSTERS_X = 16u;
+        static constexpr UINT NUM_CLUSTERS_Y = 9u;
+        static constexpr UINT NUM_CLUSTERS_Z = 24u;
+        static constexpr UINT NUM_CLUSTERS = NUM_CLUSTERS_X * NUM_CLUSTERS_Y * NUM_CLUSTERS_Z;
+        static constexpr FLOAT MIN_SLICE_DEPTH = 1.0f;
+        static constexpr UINT MIN_LIGHTS_PER_THREAD = 64u;
+
+        static UINT GetClusterIndex(_In_ UINT uX, _In_ UINT uY, _In_ UINT uZ);
+
+        LightClusters() = delete;
+        LightClusters(_In_ UINT uNumThreads);
+        LightClusters(const LightClusters& other) = delete;
+        LightClusters(LightClusters&& other) = delete;
+        LightClusters& operator=(const LightClusters& other) = delete;
+        LightClusters& operator=(LightClusters&& other) = delete;
+        ~LightClusters() = default;
+
+        HRESULT Build(
+            _In_ const XMMATRIX& cameraView,
+            _In_ const XMMATRIX& cameraProjection,
+            _In_ const std::vector<ClusterLight>& aLights
+        );
+
+        UINT GetSlice(_In_ FLOAT viewDepth) const;
+        BOOL GetLightBounds(_In_ UINT uLight, _Out_ ClusterLightBounds& outBounds) const;
+        const std::vector<XMUINT2>& GetClusterRanges() const;
+        const std::vector<UINT>& GetLightIndices() const;
+        FLOAT GetSliceScale() const;
+        FLOAT GetSliceBias() const;
+        UINT GetNumVisibleLights() const;
+
+    private:
+        void updatePlanes(_In_ const XMMATRIX& cameraProjection);
+        void computeLightBounds(_In_ const XMMATRIX& cameraView, _In_ const std::vector<ClusterLight>& aLights, _In_ UINT uBegin, _In_ UINT uEnd);
+        void countLights(_In_ UINT uBeginSlice, _In_ UINT uEndSlice);
+        void fillLights(_In_ UINT uBeginSlice, _In_ UINT uEndSlice);
+
+    private:
+        // Tile planes are padded to whole vectors with zero normals, which never count as inside or outside
+        static constexpr UINT NUM_PLANE_VECTORS_X = (NUM_CLUSTERS_X + 1u + 3u) / 4u;
+        static constexpr UINT NUM_PLANE_VECTORS_Y = (NUM_CLUSTERS_Y + 1u + 3u) / 4u;
+
+    private:
+        std::unique_ptr<AssetLoader> m_workers;
+        UINT m_uNumThreads;
+        XMFLOAT4X4 m_projection;
+        XMVECTOR m_aPlanesXNormalX[NUM_PLANE_VECTORS_X];
+        XMVECTOR m_aPlanesXNormalZ[NUM_PLANE_VECTORS_X];
+        XMVECTOR m_aPlanesYNormalY[NUM_PLANE_VECTORS_Y];
+        XMVECTOR m_aPlanesYNormalZ[NUM_PLANE_VECTORS_Y];
+        FLOAT m_nearZ;
+        FLOAT m_farZ;
+        FLOAT m_sliceScale;
+        FLOAT m_sliceBias;
+        std::vector<XMFLOAT4> m_aViewSpheres;
+        std::vector<ClusterLightBounds> m_aLightBounds;
+        std::vector<BYTE> m_aVisible;
+        std::vector<UINT> m_aVisibleLights;
+        std::vector<XMUINT2> m_aClusterRanges;
+        std::vector<UINT> m_aLightIndices;
+    };
+}
\ No newline at end of file
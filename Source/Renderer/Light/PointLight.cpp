@@ -1,6 +1,7 @@
 #include "Light/PointLight.h"
 
 #include "Renderer/DataTypes.h"
+#include "Renderer/VersionCounter.h"
 
 namespace library
 {
@@ -16,7 +17,7 @@ namespace library
                 FLOAT attenuationDistance
                   Attenuation distance
 
-      Modifies: [m_position, m_color, m_attenuationDistance].
+      Modifies: [m_position, m_color, m_attenuationDistance, m_uVersion].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     PointLight::PointLight(_In_ const XMFLOAT4& position, _In_ const XMFLOAT4& color, _In_ FLOAT attenuationDistance)
         : m_position(position)
@@ -27,6 +28,7 @@ namespace library
         , m_view(XMMatrixIdentity())
         , m_projection(XMMatrixIdentity())
         , m_attenuationDistance(attenuationDistance)
+        , m_uVersion(VersionCounter::Next())
     {
         // empty
     }
@@ -70,6 +72,21 @@ namespace library
         return m_attenuationDistance;
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PointLight::GetVersion
+
+      Summary:  Returns the version of the light. Derived lights that
+                move call markDirty, so the light constants are only
+                uploaded when a light changed
+
+      Returns:  UINT64
+                  Version taken from VersionCounter
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 PointLight::GetVersion() const
+    {
+        return m_uVersion;
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   PointLight::Update
 
@@ -115,11 +132,24 @@ namespace library
       Args:     UINT uWidth
                 UINT uHeight
 
-      Modifies: [m_projection]
+      Modifies: [m_projection, m_uVersion]
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     void PointLight::Initialize(_In_ UINT uWidth, _In_ UINT uHeight)
     {
         // Initialize the projection matrix
         m_projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, static_cast<FLOAT>(uWidth) / static_cast<FLOAT>(uHeight), 0.01f, 1000.0f);
+        markDirty();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PointLight::markDirty
+
+      Summary:  Takes a new version after the light changed
+
+      Modifies: [m_uVersion].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void PointLight::markDirty()
+    {
+        m_uVersion = VersionCounter::Next();
     }
 }
\ No newline at end of file
@@ -16,6 +16,8 @@ namespace library
                   Returns the position of the light
                 GetColor
                   Returns the color of the light
+                GetVersion
+                  Returns the version of the light
                 Update
                   Updates the light
                 PointLight
@@ -39,10 +41,14 @@ namespace library
         const XMMATRIX& GetViewMatrix() const;
         const XMMATRIX& GetProjectionMatrix() const;
         FLOAT GetAttenuationDistance() const;
+        UINT64 GetVersion() const;
 
         virtual void Initialize(_In_ UINT uWidth, _In_ UINT uHeight);
         virtual void Update(_In_ FLOAT deltaTime);
 
+    protected:
+        void markDirty();
+
     protected:
         XMFLOAT4 m_position;
         XMFLOAT4 m_color;
@@ -53,6 +59,7 @@ namespace library
         XMMATRIX m_projection;
 
         FLOAT m_attenuationDistance;
+        UINT64 m_uVersion;
 
         static constexpr const XMVECTORF32 DEFAULT_UP = { 0.0f, 1.0f, 0.0f, 0.0f };
     };
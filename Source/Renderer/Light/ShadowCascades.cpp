@@ -0,0 +1,341 @@
+#include "Light/ShadowCascades.h"
+
+#include "Renderer/VersionCounter.h"
+
+#include <cmath>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowCascades::ComputeSplits
+
+      Summary:  Computes the view depths the cascades are split at with
+                the practical split scheme. Logarithmic splits keep the
+                ratio of view to shadow texels even but crowd the
+                cascades at the near plane, uniform splits do the
+                opposite, lambda blends them
+
+      Args:     FLOAT nearZ
+                  View depth the first cascade starts at
+                FLOAT farZ
+                  View depth the last cascade ends at
+                FLOAT lambda
+                  0 for uniform, 1 for logarithmic splits
+                UINT uNumCascades
+                  Number of cascades
+                FLOAT* aSplits
+                  Receives uNumCascades + 1 depths, the first is nearZ
+                  and the last is farZ
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ShadowCascades::ComputeSplits(
+        _In_ FLOAT nearZ,
+        _In_ FLOAT farZ,
+        _In_ FLOAT lambda,
+        _In_ UINT uNumCascades,
+        _Out_writes_(uNumCascades + 1) FLOAT* aSplits
+    )
+    {
+        aSplits[0] = nearZ;
+        for (UINT i = 1u; i < uNumCascades; ++i)
+        {
+            const FLOAT fraction = static_cast<FLOAT>(i) / static_cast<FLOAT>(uNumCascades);
+            const FLOAT logarithmic = nearZ * std::pow(farZ / nearZ, fraction);
+            const FLOAT uniform = nearZ + (farZ - nearZ) * fraction;
+            aSplits[i] = lambda * logarithmic + (1.0f - lambda) * uniform;
+        }
+        aSplits[uNumCascades] = farZ;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowCascades::ShadowCascades
+
+      Summary:  Constructor
+
+      Modifies: [m_view, m_lightDirection, m_aProjections, m_aBounds,
+                 m_aSplits, m_aTexelSizes, m_auVersions,
+                 m_splitLambda, m_shadowDistance, m_casterDistance].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ShadowCascades::ShadowCascades()
+        : m_view(XMMatrixIdentity())
+        , m_lightDirection()
+        , m_aProjections()
+        , m_aBounds()
+        , m_aSplits()
+        , m_aTexelSizes()
+        , m_auVersions()
+        , m_splitLambda(DEFAULT_SPLIT_LAMBDA)
+        , m_shadowDistance(DEFAULT_SHADOW_DISTANCE)
+        , m_casterDistance(DEFAULT_CASTER_DISTANCE)
+    {
+        // empty
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowCascades::Fit
+
+      Summary:  Fits the cascades to the view of the camera. The
+                version of a cascade only grows when its projection
+                changed, which with snapping happens when the camera
+                moved by a whole texel of the cascade
+
+      Args:     const XMMATRIX& cameraView
+                  View matrix of the camera
+                const XMMATRIX& cameraProjection
+                  Left handed perspective projection of the camera
+                const XMFLOAT4& lightDirection
+                  Normalized direction the light travels in
+                UINT uShadowMapSize
+                  Width and height of a cascade in texels
+
+      Modifies: [m_view, m_lightDirection, m_aProjections, m_aBounds,
+                 m_aSplits, m_aTexelSizes, m_auVersions].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ShadowCascades::Fit(
+        _In_ const XMMATRIX& cameraView,
+        _In_ const XMMATRIX& cameraProjection,
+        _In_ const XMFLOAT4& lightDirection,
+        _In_ UINT uShadowMapSize
+    )
+    {
+        // Near and far plane and the slopes of the frustum sides, read back from the projection
+        XMFLOAT4X4 projection;
+        XMStoreFloat4x4(&projection, cameraProjection);
+        const FLOAT nearZ = -projection._43 / projection._33;
+        const FLOAT farZ = projection._43 / (1.0f - projection._33);
+        const FLOAT slopeX = 1.0f / projection._11;
+        const FLOAT slopeY = 1.0f / projection._22;
+
+        ComputeSplits(nearZ, farZ < m_shadowDistance ? farZ : m_shadowDistance, m_splitLambda, NUM_CASCADES, m_aSplits);
+
+        // The light looks along its direction from the origin, the cascades move in its projection only
+        const BOOL bLightChanged = memcmp(&m_lightDirection, &lightDirection, sizeof(lightDirection)) != 0;
+        if (bLightChanged)
+        {
+            m_lightDirection = lightDirection;
+
+            const XMVECTOR up = std::fabs(lightDirection.y) > 0.99f ? XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f) : XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+            m_view = XMMatrixLookToLH(XMVectorZero(), XMLoadFloat4(&lightDirection), up);
+        }
+
+        const XMMATRIX inverseView = XMMatrixInverse(nullptr, m_view);
+        const XMMATRIX inverseCameraView = XMMatrixInverse(nullptr, cameraView);
+        for (UINT i = 0u; i < NUM_CASCADES; ++i)
+        {
+            // Corners of the slice of the view frustum in world space
+            XMVECTOR aCorners[8];
+            XMVECTOR center = XMVectorZero();
+            for (UINT j = 0u; j < ARRAYSIZE(aCorners); ++j)
+            {
+                const FLOAT z = m_aSplits[i + j / 4u];
+                const FLOAT x = (j & 1u) ? z * slopeX : -z * slopeX;
+                const FLOAT y = (j & 2u) ? z * slopeY : -z * slopeY;
+                aCorners[j] = XMVector3TransformCoord(XMVectorSet(x, y, z, 1.0f), inverseCameraView);
+                center = XMVectorAdd(center, aCorners[j]);
+            }
+            center = XMVectorScale(center, 1.0f / static_cast<FLOAT>(ARRAYSIZE(aCorners)));
+
+            // The radius only depends on the split depths, it is rounded up so float noise does not change it
+            FLOAT radius = 0.0f;
+            for (const XMVECTOR& corner : aCorners)
+            {
+                const FLOAT distance = XMVectorGetX(XMVector3Length(XMVectorSubtract(corner, center)));
+                radius = distance > radius ? distance : radius;
+            }
+            radius = std::ceil(radius * 16.0f) / 16.0f;
+
+            // Snap the center to whole texels, so the texels of the cascade stay put in the world
+            const FLOAT texelSize = 2.0f * radius / static_cast<FLOAT>(uShadowMapSize);
+            XMFLOAT3 lightCenter;
+            XMStoreFloat3(&lightCenter, XMVector3TransformCoord(center, m_view));
+            lightCenter.x = std::floor(lightCenter.x / texelSize) * texelSize;
+            lightCenter.y = std::floor(lightCenter.y / texelSize) * texelSize;
+            lightCenter.z = std::floor(lightCenter.z / texelSize) * texelSize;
+
+            const FLOAT nearLight = lightCenter.z - radius - m_casterDistance;
+            const FLOAT farLight = lightCenter.z + radius;
+            XMStoreFloat4x4(
+                &projection,
+                XMMatrixOrthographicOffCenterLH(
+                    lightCenter.x - radius,
+                    lightCenter.x + radius,
+                    lightCenter.y - radius,
+                    lightCenter.y + radius,
+                    nearLight,
+                    farLight
+                )
+            );
+            if (bLightChanged || memcmp(&projection, &m_aProjections[i], sizeof(projection)) != 0)
+            {
+                m_aProjections[i] = projection;
+                m_auVersions[i] = VersionCounter::Next();
+            }
+
+            const BoundingOrientedBox lightBounds(
+                XMFLOAT3(lightCenter.x, lightCenter.y, (nearLight + farLight) * 0.5f),
+                XMFLOAT3(radius, radius, (farLight - nearLight) * 0.5f),
+                XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f)
+            );
+            lightBounds.Transform(m_aBounds[i], inverseView);
+            m_aTexelSizes[i] = texelSize;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowCascades::SetSplitLambda
+
+      Summary:  Sets the blend of logarithmic and uniform splits
+
+      Args:     FLOAT lambda
+                  0 for uniform, 1 for logarithmic splits, clamped
+
+      Modifies: [m_splitLambda].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ShadowCascades::SetSplitLambda(_In_ FLOAT lambda)
+    {
+        m_splitLambda = lambda < 0.0f ? 0.0f : (lambda > 1.0f ? 1.0f : lambda);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowCascades::SetShadowDistance
+
+      Summary:  Sets how far from the camera shadows are rendered. The
+                cascades end at the far plane of the camera if it is
+                closer
+
+      Args:     FLOAT distance
+                  View depth the last cascade ends at
+
+      Modifies: [m_shadowDistance].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ShadowCascades::SetShadowDistance(_In_ FLOAT distance)
+    {
+        m_shadowDistance = distance;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowCascades::SetCasterDistance
+
+      Summary:  Sets how far towards the light the depth range of a
+                cascade reaches beyond its slice, casters further away
+                are clipped
+
+      Args:     FLOAT distance
+                  Distance along the light
+
+      Modifies: [m_casterDistance].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ShadowCascades::SetCasterDistance(_In_ FLOAT distance)
+    {
+        m_casterDistance = distance;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowCascades::GetViewMatrix
+
+      Summary:  Returns the view matrix of the light, shared by every
+                cascade
+
+      Returns:  const XMMATRIX&
+                  View matrix
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const XMMATRIX& ShadowCascades::GetViewMatrix() const
+    {
+        return m_view;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowCascades::GetProjectionMatrix
+
+      Summary:  Returns the orthographic projection of a cascade
+
+      Args:     UINT uCascade
+                  Index of the cascade
+
+      Returns:  XMMATRIX
+                  Projection matrix
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    XMMATRIX ShadowCascades::GetProjectionMatrix(_In_ UINT uCascade) const
+    {
+        assert(uCascade < NUM_CASCADES);
+
+        return XMLoadFloat4x4(&m_aProjections[uCascade]);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowCascades::GetSplitDepth
+
+      Summary:  Returns the view depth where a cascade ends and the
+                next one begins
+
+      Args:     UINT uCascade
+                  Index of the cascade
+
+      Returns:  FLOAT
+                  View depth
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT ShadowCascades::GetSplitDepth(_In_ UINT uCascade) const
+    {
+        assert(uCascade < NUM_CASCADES);
+
+        return m_aSplits[uCascade + 1u];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowCascades::GetTexelSize
+
+      Summary:  Returns the world size of a texel of a cascade, used to
+                offset receivers against acne
+
+      Args:     UINT uCascade
+                  Index of the cascade
+
+      Returns:  FLOAT
+                  Width of a texel
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT ShadowCascades::GetTexelSize(_In_ UINT uCascade) const
+    {
+        assert(uCascade < NUM_CASCADES);
+
+        return m_aTexelSizes[uCascade];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowCascades::GetBounds
+
+      Summary:  Returns the world space box the projection of a cascade
+                covers. Only casters intersecting it are drawn into the
+                cascade
+
+      Args:     UINT uCascade
+                  Index of the cascade
+
+      Returns:  const BoundingOrientedBox&
+                  Bounds of the cascade
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const BoundingOrientedBox& ShadowCascades::GetBounds(_In_ UINT uCascade) const
+    {
+        assert(uCascade < NUM_CASCADES);
+
+        return m_aBounds[uCascade];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowCascades::GetVersion
+
+      Summary:  Returns the version of the view and projection of a
+                cascade
+
+      Args:     UINT uCascade
+                  Index of the cascade
+
+      Returns:  UINT64
+                  Version taken from VersionCounter, 0 before the
+                  first fit
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 ShadowCascades::GetVersion(_In_ UINT uCascade) const
+    {
+        assert(uCascade < NUM_CASCADES);
+
+        return m_auVersions[uCascade];
+    }
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+/*+===================================================================
+  File:      SHADOWCASCADES.H
+
+  Summary:   ShadowCascades header file contains declaration of class
+             ShadowCascades that splits the view of the camera into
+             depth ranges and fits an orthographic shadow projection
+             of a directional light to each of them.
+
+  Classes:  ShadowCascades
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/DataTypes.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    ShadowCascades
+
+      Summary:  Cascaded shadow map fitting, free of any device so it
+                can run and be checked on the CPU alone. The view of
+                the camera up to the shadow distance is split with the
+                practical split scheme, a blend of logarithmic and
+                uniform splits. Each slice is enclosed in a bounding
+                sphere, so the size of a cascade does not change when
+                the camera turns, and the sphere is projected along
+                the light with its center snapped to whole texels of
+                the shadow map, so the shadow does not shimmer when
+                the camera moves. The depth range of a cascade reaches
+                back towards the light by the caster distance to keep
+                casters outside the view. The bounds of a cascade are
+                the box its projection covers, for culling casters
+
+      Methods:  ComputeSplits
+                  Computes the practical split depths
+                Fit
+                  Fits the cascades to the view of the camera
+                SetSplitLambda
+                  Sets the blend of logarithmic and uniform splits
+                SetShadowDistance
+                  Sets how far from the camera shadows are rendered
+                SetCasterDistance
+                  Sets how far towards the light casters are kept
+                GetViewMatrix
+                  Returns the view matrix of the light
+                GetProjectionMatrix
+                  Returns the projection matrix of a cascade
+                GetSplitDepth
+                  Returns the view depth where a cascade ends
+                GetTexelSize
+                  Returns the world size of a texel of a cascade
+                GetBounds
+                  Returns the box a cascade covers
+                GetVersion
+                  Returns the version of the projection of a cascade
+                ShadowCascades
+                  Constructor.
+                ~ShadowCascades
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class ShadowCascades final
+    {
+    public:
+        static constexpr FLOAT DEFAULT_SPLIT_LAMBDA = 0.75f;
+        static constexpr FLOAT DEFAULT_SHADOW_DISTANCE = 256.0f;
+        static constexpr FLOAT DEFAULT_CASTER_DISTANCE = 512.0f;
+
+        static void ComputeSplits(
+            _In_ FLOAT nearZ,
+            _In_ FLOAT farZ,
+            _In_ FLOAT lambda,
+            _In_ UINT uNumCascades,
+            _Out_writes_(uNumCascades + 1) FLOAT* aSplits
+        );
+
+        ShadowCascades();
+        ShadowCascades(const ShadowCascades& other) = delete;
+        ShadowCascades(ShadowCascades&& other) = delete;
+        ShadowCascades& operator=(const ShadowCascades& other) = delete;
+        ShadowCascades& operator=(ShadowCascades&& other) = delete;
+        ~ShadowCascades() = default;
+
+        void Fit(
+            _In_ const XMMATRIX& cameraView,
+            _In_ const XMMATRIX& cameraProjection,
+            _In_ const XMFLOAT4& lightDirection,
+            _In_ UINT uShadowMapSize
+        );
+
+        void SetSplitLambda(_In_ FLOAT lambda);
+        void SetShadowDistance(_In_ FLOAT distance);
+        void SetCasterDistance(_In_ FLOAT distance);
+
+        const XMMATRIX& GetViewMatrix() const;
+        XMMATRIX GetProjectionMatrix(_In_ UINT uCascade) const;
+        FLOAT GetSplitDepth(_In_ UINT uCascade) const;
+        FLOAT GetTexelSize(_In_ UINT uCascade) const;
+        const BoundingOrientedBox& GetBounds(_In_ UINT uCascade) const;
+        UINT64 GetVersion(_In_ UINT uCascade) const;
+
+    private:
+        XMMATRIX m_view;
+        XMFLOAT4 m_lightDirection;
+        XMFLOAT4X4 m_aProjections[NUM_CASCADES];
+        BoundingOrientedBox m_aBounds[NUM_CASCADES];
+        FLOAT m_aSplits[NUM_CASCADES + 1];
+        FLOAT m_aTexelSizes[NUM_CASCADES];
+        UINT64 m_auVersions[NUM_CASCADES];
+        FLOAT m_splitLambda;
+        FLOAT m_shadowDistance;
+        FLOAT m_casterDistance;
+    };
+}
\ No newline at end of file
@@ -1,9 +1,14 @@
 #include "Model/Model.h"
 
+#include "Model/RecordingIOSystem.h"
+#include "Texture/TextureCache.h"
+
 #include "assimp/Importer.hpp"	// C++ importer interface
 #include "assimp/scene.h"		// output data structure
 #include "assimp/postprocess.h"	// post processing flags
 
+#include <typeinfo>
+
 namespace library
 {
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -60,7 +65,7 @@ namespace library
         return XMLoadFloat4(&float4);
     }
 
-    std::unique_ptr<Assimp::Importer> Model::sm_pImporter = std::make_unique<Assimp::Importer>();
+    BOOL Model::sm_bCacheEnabled = TRUE;
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Model::Model
@@ -70,17 +75,18 @@ namespace library
       Args:     const std::filesystem::path& filePath
                   Path to the model to load
 
-      Modifies: [m_filePath, m_animationBuffer, m_skinningConstantBuffer,
-                 m_skinningConstantBuffer, m_aVertices, m_aAnimationData,
+      Modifies: [m_filePath, m_animationBuffer, m_aVertices,
+                 m_aAnimationData,
                  m_aIndices, m_aBoneData, m_aBoneInfo, m_aTransforms,
                  m_aBoneInfo, m_aTransforms, m_boneNameToIndexMap,
-                 m_pScene, m_timeSinceLoaded, m_globalInverseTransform].
+                 m_aNodes, m_aAnimations, m_aNodeChannelIndices,
+                 m_aNodeTransforms, m_timeSinceLoaded, m_bIsLoaded,
+                 m_globalInverseTransform].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     Model::Model(_In_ const std::filesystem::path& filePath)
         : Renderable(XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f))
         , m_filePath(filePath)
         , m_animationBuffer()
-        , m_skinningConstantBuffer()
         , m_aVertices(std::vector<SimpleVertex>())
         , m_aAnimationData(std::vector<AnimationData>())
         , m_aIndices(std::vector<WORD>())
@@ -88,30 +94,144 @@ namespace library
         , m_aBoneInfo(std::vector<BoneInfo>())
         , m_aTransforms(std::vector<XMMATRIX>())
         , m_boneNameToIndexMap(std::unordered_map<std::string, UINT>())
-        , m_pScene(nullptr)
+        , m_aNodes(std::vector<CookedNode>())
+        , m_aAnimations(std::vector<CookedAnimation>())
+        , m_aNodeChannelIndices(std::vector<INT>())
+        , m_aNodeTransforms(std::vector<XMMATRIX>())
         , m_timeSinceLoaded(0.0f)
+        , m_bIsLoaded(FALSE)
         , m_globalInverseTransform(XMMatrixIdentity())
     {
         // empty
     }
 
-    Model::~Model()
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::Load
+
+      Summary:  Load the 3d model into system memory. The cooked model
+                is read from the model cache if it is up to date,
+                otherwise the model file is imported with assimp and
+                the result is written to the cache. Textures are
+                created but not loaded. Neither the device nor the
+                context is used, so models can load on worker threads
+
+      Modifies: [m_globalInverseTransform, m_aNodeChannelIndices,
+                 m_bIsLoaded].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Model::Load()
     {
-        delete m_pScene;
+        LARGE_INTEGER Frequency;
+        LARGE_INTEGER StartTime;
+        LARGE_INTEGER EndTime;
+        QueryPerformanceFrequency(&Frequency);
+        QueryPerformanceCounter(&StartTime);
+
+        XMVECTOR det = XMMatrixDeterminant(m_world);
+        m_globalInverseTransform = XMMatrixInverse(&det, m_world);
+
+        // Subclasses may cook the same file differently, so the type is part of the key
+        UINT64 uCacheKey = 0ull;
+        BOOL bHasCacheKey = sm_bCacheEnabled
+            && SUCCEEDED(ModelCache::ComputeKey(m_filePath, ASSIMP_LOAD_FLAGS, typeid(*this).name(), uCacheKey));
+
+        CookedModel cookedModel;
+        BOOL bLoadedFromCache = bHasCacheKey && SUCCEEDED(ModelCache::Load(m_filePath, uCacheKey, cookedModel));
+
+        if (bLoadedFromCache)
+        {
+            initFromCookedModel(cookedModel);
+        }
+        else
+        {
+            // Every load owns its importer, an importer can only read one file at a time
+            Assimp::Importer importer;
+
+            // Record the other files the import reads, the importer owns the file system
+            RecordingIOSystem* pIOSystem = new RecordingIOSystem();
+            importer.SetIOHandler(pIOSystem);
+
+            // Read the 3D model file, the scene is freed with the importer
+            const aiScene* pScene = importer.ReadFile(
+                m_filePath.string().c_str(),
+                ASSIMP_LOAD_FLAGS
+            );
+
+            // Initialize the model
+            if (!pScene)
+            {
+                OutputDebugString(L"Error parsing ");
+                OutputDebugString(m_filePath.c_str());
+                OutputDebugString(L": ");
+                OutputDebugStringA(importer.GetErrorString());
+                OutputDebugString(L"\n");
+
+                return E_FAIL;
+            }
+
+            initFromScene(pScene, m_filePath);
+
+            if (bHasCacheKey)
+            {
+                cook(cookedModel);
+                for (const std::wstring& szOpenedFile : pIOSystem->GetOpenedFiles())
+                {
+                    if (std::filesystem::path(szOpenedFile) != m_filePath.lexically_normal())
+                    {
+                        cookedModel.aDependencies.push_back(szOpenedFile);
+                    }
+                }
+
+                if (FAILED(ModelCache::Save(m_filePath, uCacheKey, cookedModel)))
+                {
+                    OutputDebugString(L"Error writing model cache of ");
+                    OutputDebugString(m_filePath.c_str());
+                    OutputDebugString(L"\n");
+                }
+            }
+        }
+
+        QueryPerformanceCounter(&EndTime);
+
+        CHAR szDebugMessage[64];
+        sprintf_s(
+            szDebugMessage,
+            "\" in %.2f ms\n",
+            static_cast<DOUBLE>(EndTime.QuadPart - StartTime.QuadPart) * 1000.0 / static_cast<DOUBLE>(Frequency.QuadPart)
+        );
+        OutputDebugString(bLoadedFromCache ? L"Loaded cooked model \"" : L"Imported model \"");
+        OutputDebugString(m_filePath.c_str());
+        OutputDebugStringA(szDebugMessage);
+
+        // Map the channels of the played animation to the nodes they animate
+        if (!m_aAnimations.empty())
+        {
+            m_aNodeChannelIndices.assign(m_aNodes.size(), -1);
+            for (UINT i = 0u; i < m_aAnimations[0].aChannels.size(); ++i)
+            {
+                m_aNodeChannelIndices[m_aAnimations[0].aChannels[i].uNodeIndex] = static_cast<INT>(i);
+            }
+        }
+
+        m_bIsLoaded = TRUE;
+
+        return S_OK;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Model::Initialize
 
-      Summary:  Load and initialize the 3d model and create buffers
+      Summary:  Load the 3d model if it is not loaded yet, then create
+                its buffers and textures
 
       Args:     ID3D11Device* pDevice
                   The Direct3D device to create the buffers
                 ID3D11DeviceContext* pImmediateContext
                   The Direct3D context to set buffers
 
-      Modifies: [m_pScene, m_globalInverseTransform, m_animationBuffer,
-                 m_skinningConstantBuffer].
+      Modifies: [m_animationBuffer].
 
       Returns:  HRESULT
                   Status code
@@ -120,33 +240,34 @@ namespace library
     {
         HRESULT hr = S_OK;
 
-        // Read the 3D model file
-        m_pScene = sm_pImporter->ReadFile(
-            m_filePath.string().c_str(),
-            ASSIMP_LOAD_FLAGS
-        );
-
-        // Application is now responsible of deleting this scene
-        m_pScene = sm_pImporter->GetOrphanedScene();
+        if (!m_bIsLoaded)
+        {
+            hr = Load();
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+        }
 
-        // Initialize the model
-        if (m_pScene)
+        hr = initialize(pDevice, pImmediateContext);
+        if (FAILED(hr))
         {
-            XMVECTOR det = XMMatrixDeterminant(m_world);
-            m_globalInverseTransform = XMMatrixInverse(&det, m_world);
-            hr = initFromScene(pDevice, pImmediateContext, m_pScene, m_filePath);
+            return hr;
         }
-        else
+
+        // A missing texture is reported by the texture and does not fail the model
+        for (const std::shared_ptr<Material>& material : m_aMaterials)
         {
-            hr = E_FAIL;
-            OutputDebugString(L"Error parsing ");
-            OutputDebugString(m_filePath.c_str());
-            OutputDebugString(L": ");
-            OutputDebugStringA(sm_pImporter->GetErrorString());
-            OutputDebugString(L"\n");
+            for (const std::shared_ptr<Texture>& texture : { material->pDiffuse, material->pSpecularExponent, material->pNormal })
+            {
+                if (texture)
+                {
+                    texture->Initialize(pDevice, pImmediateContext);
+                }
+            }
         }
 
-        if ((m_pScene != nullptr) && m_pScene->HasAnimations())
+        if (!m_aAnimationData.empty())
         {
             // Create the animation buffer
             D3D11_BUFFER_DESC aBufferDesc =
@@ -177,28 +298,6 @@ namespace library
             }
         }
 
-        // Create the skinning constant buffer
-        D3D11_BUFFER_DESC scBufferDesc =
-        {
-            .ByteWidth = static_cast<UINT>(sizeof(CBSkinning)),
-            .Usage = D3D11_USAGE_DEFAULT,
-            .BindFlags = D3D11_BIND_CONSTANT_BUFFER,
-            .CPUAccessFlags = 0u,
-            .MiscFlags = 0u,
-            .StructureByteStride = 0u
-        };
-        hr = pDevice->CreateBuffer(&scBufferDesc, nullptr, m_skinningConstantBuffer.GetAddressOf());
-        if (FAILED(hr))
-        {
-            MessageBox(
-                nullptr,
-                L"Call to CreateSkinningConstantBuffer failed!",
-                L"Game Graphics Programming",
-                NULL
-            );
-            return hr;
-        }
-
         return hr;
     }
 
@@ -210,25 +309,31 @@ namespace library
       Args:     FLOAT deltaTime
                   Time difference of a frame
 
-      Modifies: [m_aTransforms].
+      Modifies: [m_aTransforms, m_uVersion].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     void Model::Update(_In_ FLOAT deltaTime)
     {
+        PROFILE_SCOPE("Model::Update");
+
         m_timeSinceLoaded += deltaTime;
 
-        if (m_pScene->HasAnimations())
+        if (!m_aAnimations.empty())
         {
-            FLOAT ticksPerSecond = static_cast<FLOAT>(m_pScene->mAnimations[0]->mTicksPerSecond != 0.0 ? m_pScene->mAnimations[0]->mTicksPerSecond : 25.0f);
+            const CookedAnimation& animation = m_aAnimations[0];
+            FLOAT ticksPerSecond = animation.TicksPerSecond != 0.0f ? animation.TicksPerSecond : 25.0f;
             FLOAT timeInTicks = m_timeSinceLoaded * ticksPerSecond;
-            FLOAT animationTimeTicks = fmod(timeInTicks, static_cast<FLOAT>(m_pScene->mAnimations[0]->mDuration));
-            if (m_pScene->mRootNode != nullptr)
+            FLOAT animationTimeTicks = fmod(timeInTicks, animation.Duration);
+            if (!m_aNodes.empty())
             {
-                readNodeHierarchy(animationTimeTicks, m_pScene->mRootNode, XMMatrixIdentity());
+                readNodeHierarchy(animationTimeTicks);
                 m_aTransforms.resize(m_aBoneInfo.size());
                 for (UINT i = 0u; i < m_aTransforms.size(); ++i)
                 {
                     m_aTransforms[i] = m_aBoneInfo[i].FinalTransformation;
                 }
+
+                // The bone transforms are part of the shader constants
+                markDirty();
             }
         }
     }
@@ -246,19 +351,6 @@ namespace library
         return m_animationBuffer;
     }
 
-    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Model::GetSkinningConstantBuffer
-
-      Summary:  Returns the skinning constant buffer
-
-      Returns:  ComPtr<ID3D11Buffer>&
-
-    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    ComPtr<ID3D11Buffer>& Model::GetSkinningConstantBuffer()
-    {
-        return m_skinningConstantBuffer;
-    }
-
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Model::GetNumVertices
 
@@ -311,6 +403,80 @@ namespace library
         return m_boneNameToIndexMap;
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::SetCacheEnabled
+
+      Summary:  Enables or disables the cooked model cache. When
+                disabled, models are always imported with assimp
+
+      Args:     BOOL bEnabled
+                  TRUE to use the cache
+
+      Modifies: [sm_bCacheEnabled].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Model::SetCacheEnabled(_In_ BOOL bEnabled)
+    {
+        sm_bCacheEnabled = bEnabled;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::cook
+
+      Summary:  Copies the final runtime data of the model so that it
+                can be written to the model cache
+
+      Args:     CookedModel& outModel
+                  Cooked model
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Model::cook(_Inout_ CookedModel& outModel) const
+    {
+        outModel.aVertices = m_aVertices;
+        outModel.aNormalData = m_aNormalData;
+        outModel.aAnimationData = m_aAnimationData;
+        outModel.aIndices = m_aIndices;
+
+        outModel.aMeshes.resize(m_aMeshes.size());
+        for (size_t i = 0u; i < m_aMeshes.size(); ++i)
+        {
+            outModel.aMeshes[i] =
+            {
+                .uNumIndices = m_aMeshes[i].uNumIndices,
+                .uBaseVertex = m_aMeshes[i].uBaseVertex,
+                .uBaseIndex = m_aMeshes[i].uBaseIndex,
+                .uMaterialIndex = m_aMeshes[i].uMaterialIndex
+            };
+        }
+
+        outModel.aMaterials.resize(m_aMaterials.size());
+        for (size_t i = 0u; i < m_aMaterials.size(); ++i)
+        {
+            if (m_aMaterials[i]->pDiffuse)
+            {
+                outModel.aMaterials[i].szDiffusePath = m_aMaterials[i]->pDiffuse->GetFilePath().wstring();
+            }
+
+            if (m_aMaterials[i]->pSpecularExponent)
+            {
+                outModel.aMaterials[i].szSpecularPath = m_aMaterials[i]->pSpecularExponent->GetFilePath().wstring();
+            }
+
+            if (m_aMaterials[i]->pNormal)
+            {
+                outModel.aMaterials[i].szNormalPath = m_aMaterials[i]->pNormal->GetFilePath().wstring();
+            }
+        }
+
+        outModel.aBones.resize(m_aBoneInfo.size());
+        for (const auto& [szName, uBoneIndex] : m_boneNameToIndexMap)
+        {
+            outModel.aBones[uBoneIndex].szName = szName;
+            XMStoreFloat4x4(&outModel.aBones[uBoneIndex].OffsetMatrix, m_aBoneInfo[uBoneIndex].OffsetMatrix);
+        }
+
+        outModel.aNodes = m_aNodes;
+        outModel.aAnimations = m_aAnimations;
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
         Method:   Model::countVerticesAndIndices
 
@@ -346,33 +512,6 @@ namespace library
         uOutNumIndices = uNumIndices;
     }
 
-    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-        Method:   Model::findNodeAnimOrNull
-
-        Summary:  Find the aiNodeAnim with the givne node name in the given animation
-
-        Args:     const aiAnimation* pAnimation
-                    Pointer to an assimp animation object
-                  PCSTR pszNodeName
-                    Node name to find
-
-        Returns:  aiNodeAnim* or nullptr
-     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    const aiNodeAnim* Model::findNodeAnimOrNull(_In_ const aiAnimation* pAnimation, _In_ PCSTR pszNodeName)
-    {
-        for (UINT i = 0u; i < pAnimation->mNumChannels; ++i)
-        {
-            const aiNodeAnim* pNodeAnim = pAnimation->mChannels[i];
-
-            if (strncmp(pNodeAnim->mNodeName.data, pszNodeName, pNodeAnim->mNodeName.length) == 0)
-            {
-                return pNodeAnim;
-            }
-        }
-
-        return nullptr;
-    }
-
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
         Method:   Model::findPosition
 
@@ -380,19 +519,19 @@ namespace library
 
         Args:     FLOAT animationTimeTicks
                     Animation time
-                  const aiNodeAnim* pNodeAnim
-                     Pointer to an assimp node anim object
+                  const CookedChannel& channel
+                     Animation channel of the node
 
         Returns:  UINT
                     Index of the key
      M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    UINT Model::findPosition(_In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim)
+    UINT Model::findPosition(_In_ FLOAT animationTimeTicks, _In_ const CookedChannel& channel)
     {
-        assert(pNodeAnim->mNumPositionKeys > 0);
+        assert(!channel.aPositionKeys.empty());
 
-        for (UINT i = 0u; i < pNodeAnim->mNumPositionKeys - 1; ++i)
+        for (UINT i = 0u; i < channel.aPositionKeys.size() - 1; ++i)
         {
-            FLOAT t = static_cast<FLOAT>(pNodeAnim->mPositionKeys[i + 1].mTime);
+            FLOAT t = channel.aPositionKeys[i + 1].Time;
 
             if (animationTimeTicks < t)
             {
@@ -410,19 +549,19 @@ namespace library
 
         Args:     FLOAT animationTimeTicks
                     Animation time
-                  const aiNodeAnim* pNodeAnim
-                     Pointer to an assimp node anim object
+                  const CookedChannel& channel
+                     Animation channel of the node
 
         Returns:  UINT
                     Index of the key
      M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    UINT Model::findRotation(_In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim)
+    UINT Model::findRotation(_In_ FLOAT animationTimeTicks, _In_ const CookedChannel& channel)
     {
-        assert(pNodeAnim->mNumRotationKeys > 0);
+        assert(!channel.aRotationKeys.empty());
 
-        for (UINT i = 0u; i < pNodeAnim->mNumRotationKeys - 1; ++i)
+        for (UINT i = 0u; i < channel.aRotationKeys.size() - 1; ++i)
         {
-            FLOAT t = static_cast<FLOAT>(pNodeAnim->mRotationKeys[i + 1].mTime);
+            FLOAT t = channel.aRotationKeys[i + 1].Time;
 
             if (animationTimeTicks < t)
             {
@@ -440,19 +579,19 @@ namespace library
 
         Args:     FLOAT animationTimeTicks
                     Animation time
-                  const aiNodeAnim* pNodeAnim
-                     Pointer to an assimp node anim object
+                  const CookedChannel& channel
+                     Animation channel of the node
 
         Returns:  UINT
                     Index of the key
      M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    UINT Model::findScaling(_In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim)
+    UINT Model::findScaling(_In_ FLOAT animationTimeTicks, _In_ const CookedChannel& channel)
     {
-        assert(pNodeAnim->mNumScalingKeys > 0);
+        assert(!channel.aScalingKeys.empty());
 
-        for (UINT i = 0u; i < pNodeAnim->mNumScalingKeys - 1; ++i)
+        for (UINT i = 0u; i < channel.aScalingKeys.size() - 1; ++i)
         {
-            FLOAT t = static_cast<FLOAT>(pNodeAnim->mScalingKeys[i + 1].mTime);
+            FLOAT t = channel.aScalingKeys[i + 1].Time;
 
             if (animationTimeTicks < t)
             {
@@ -537,32 +676,168 @@ namespace library
         }
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::initAnimations
+
+      Summary:  Copy the animation clips of a given assimp scene,
+                channels refer to nodes by their index in the
+                flattened node hierarchy
+
+      Args:     const aiScene* pScene
+                  Assimp scene
+
+      Modifies: [m_aAnimations].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Model::initAnimations(_In_ const aiScene* pScene)
+    {
+        std::unordered_map<std::string, UINT> nodeNameToIndexMap;
+        for (UINT i = 0u; i < m_aNodes.size(); ++i)
+        {
+            nodeNameToIndexMap.emplace(m_aNodes[i].szName, i);
+        }
+
+        m_aAnimations.resize(pScene->mNumAnimations);
+        for (UINT i = 0u; i < pScene->mNumAnimations; ++i)
+        {
+            const aiAnimation* pAnimation = pScene->mAnimations[i];
+            CookedAnimation& animation = m_aAnimations[i];
+            animation.Duration = static_cast<FLOAT>(pAnimation->mDuration);
+            animation.TicksPerSecond = static_cast<FLOAT>(pAnimation->mTicksPerSecond);
+
+            for (UINT j = 0u; j < pAnimation->mNumChannels; ++j)
+            {
+                const aiNodeAnim* pNodeAnim = pAnimation->mChannels[j];
+
+                auto node = nodeNameToIndexMap.find(pNodeAnim->mNodeName.C_Str());
+                if (node == nodeNameToIndexMap.end())
+                {
+                    continue;
+                }
+
+                CookedChannel channel =
+                {
+                    .uNodeIndex = node->second
+                };
+
+                channel.aPositionKeys.reserve(pNodeAnim->mNumPositionKeys);
+                for (UINT k = 0u; k < pNodeAnim->mNumPositionKeys; ++k)
+                {
+                    channel.aPositionKeys.push_back(
+                        CookedVectorKey
+                        {
+                            .Time = static_cast<FLOAT>(pNodeAnim->mPositionKeys[k].mTime),
+                            .Value = ConvertVector3dToFloat3(pNodeAnim->mPositionKeys[k].mValue)
+                        }
+                    );
+                }
+
+                channel.aRotationKeys.resize(pNodeAnim->mNumRotationKeys);
+                for (UINT k = 0u; k < pNodeAnim->mNumRotationKeys; ++k)
+                {
+                    channel.aRotationKeys[k].Time = static_cast<FLOAT>(pNodeAnim->mRotationKeys[k].mTime);
+                    XMStoreFloat4(&channel.aRotationKeys[k].Value, ConvertQuaternionToVector(pNodeAnim->mRotationKeys[k].mValue));
+                }
+
+                channel.aScalingKeys.reserve(pNodeAnim->mNumScalingKeys);
+                for (UINT k = 0u; k < pNodeAnim->mNumScalingKeys; ++k)
+                {
+                    channel.aScalingKeys.push_back(
+                        CookedVectorKey
+                        {
+                            .Time = static_cast<FLOAT>(pNodeAnim->mScalingKeys[k].mTime),
+                            .Value = ConvertVector3dToFloat3(pNodeAnim->mScalingKeys[k].mValue)
+                        }
+                    );
+                }
+
+                animation.aChannels.push_back(std::move(channel));
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::initFromCookedModel
+
+      Summary:  Initialize the model from a cooked model read from
+                the model cache
+
+      Args:     CookedModel& model
+                  Cooked model, its contents are moved into the model
+
+      Modifies: [m_aVertices, m_aNormalData, m_aAnimationData,
+                 m_aIndices, m_aMeshes, m_aMaterials, m_aBoneInfo,
+                 m_boneNameToIndexMap, m_aNodes, m_aAnimations,
+                 m_bHasNormalMap].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Model::initFromCookedModel(_In_ CookedModel& model)
+    {
+        m_aVertices = std::move(model.aVertices);
+        m_aNormalData = std::move(model.aNormalData);
+        m_aAnimationData = std::move(model.aAnimationData);
+        m_aIndices = std::move(model.aIndices);
+
+        m_aMeshes.resize(model.aMeshes.size());
+        for (size_t i = 0u; i < model.aMeshes.size(); ++i)
+        {
+            m_aMeshes[i].uNumIndices = model.aMeshes[i].uNumIndices;
+            m_aMeshes[i].uBaseVertex = model.aMeshes[i].uBaseVertex;
+            m_aMeshes[i].uBaseIndex = model.aMeshes[i].uBaseIndex;
+            m_aMeshes[i].uMaterialIndex = model.aMeshes[i].uMaterialIndex;
+        }
+
+        for (size_t i = 0u; i < model.aMaterials.size(); ++i)
+        {
+            const CookedMaterial& cookedMaterial = model.aMaterials[i];
+
+            std::string szName = m_filePath.string() + std::to_string(i);
+            std::wstring pwszName(szName.length(), L' ');
+            std::copy(szName.begin(), szName.end(), pwszName.begin());
+            std::shared_ptr<Material> material = std::make_shared<Material>(pwszName);
+
+            if (!cookedMaterial.szDiffusePath.empty())
+            {
+                material->pDiffuse = TextureCache::GetTexture(cookedMaterial.szDiffusePath);
+            }
+
+            if (!cookedMaterial.szSpecularPath.empty())
+            {
+                material->pSpecularExponent = TextureCache::GetTexture(cookedMaterial.szSpecularPath);
+            }
+
+            if (!cookedMaterial.szNormalPath.empty())
+            {
+                material->pNormal = TextureCache::GetTexture(cookedMaterial.szNormalPath);
+                m_bHasNormalMap = true;
+                markDirty();
+            }
+
+            m_aMaterials.push_back(material);
+        }
+
+        m_aBoneInfo.reserve(model.aBones.size());
+        for (UINT i = 0u; i < model.aBones.size(); ++i)
+        {
+            m_aBoneInfo.push_back(BoneInfo(XMLoadFloat4x4(&model.aBones[i].OffsetMatrix)));
+            m_boneNameToIndexMap[model.aBones[i].szName] = i;
+        }
+
+        m_aNodes = std::move(model.aNodes);
+        m_aAnimations = std::move(model.aAnimations);
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Model::initFromScene
 
-      Summary:  Initialize all meshes in a given assimp scene
+      Summary:  Initialize all meshes, materials, the node hierarchy
+                and the animations in a given assimp scene
 
-      Args:     ID3D11Device* pDevice
-                  The Direct3D device to create the buffers
-                ID3D11DeviceContext* pImmediateContext
-                  The Direct3D context to set buffers
-                const aiScene* pScene
+      Args:     const aiScene* pScene
                   Assimp scene
                 const std::filesystem::path& filePath
                   Path to the model
-
-      Returns:  HRESULT
-                  Status code
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    HRESULT Model::initFromScene(
-        _In_ ID3D11Device* pDevice,
-        _In_ ID3D11DeviceContext* pImmediateContext,
-        _In_ const aiScene* pScene,
-        _In_ const std::filesystem::path& filePath
-    )
+    void Model::initFromScene(_In_ const aiScene* pScene, _In_ const std::filesystem::path& filePath)
     {
-        HRESULT hr = S_OK;
-
         m_aMeshes.resize(pScene->mNumMeshes);
 
         UINT uNumVertices = 0u;
@@ -574,13 +849,12 @@ namespace library
 
         initAllMeshes(pScene);
 
-        hr = initMaterials(pDevice, pImmediateContext, pScene, filePath);
-        if (FAILED(hr))
-        {
-            return hr;
-        }
+        initMaterials(pScene, filePath);
+
+        initNodeHierarchy(pScene->mRootNode, -1);
+        initAnimations(pScene);
 
-        if (m_pScene->HasAnimations())
+        if (pScene->HasAnimations())
         {
             for (size_t i = 0; i < m_aVertices.size(); ++i)
             {
@@ -593,14 +867,6 @@ namespace library
                 );
             }
         }
-
-        hr = initialize(pDevice, pImmediateContext);
-        if (FAILED(hr))
-        {
-            return hr;
-        }
-
-        return hr;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -608,27 +874,13 @@ namespace library
 
       Summary:  Initialize all materials in a given assimp scene
 
-      Args:     ID3D11Device* pDevice
-                  The Direct3D device to create the buffers
-                ID3D11DeviceContext* pImmediateContext
-                  The Direct3D context to set buffers
-                const aiScene* pScene
+      Args:     const aiScene* pScene
                   Assimp scene
                 const std::filesystem::path& filePath
                   Path to the model
-
-      Returns:  HRESULT
-                  Status code
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    HRESULT Model::initMaterials(
-        _In_ ID3D11Device* pDevice,
-        _In_ ID3D11DeviceContext* pImmediateContext,
-        _In_ const aiScene* pScene,
-        _In_ const std::filesystem::path& filePath
-    )
+    void Model::initMaterials(_In_ const aiScene* pScene, _In_ const std::filesystem::path& filePath)
     {
-        HRESULT hr = S_OK;
-
         // Extract the directory part from the file name
         std::filesystem::path parentDirectory = filePath.parent_path();
 
@@ -642,10 +894,8 @@ namespace library
             std::copy(szName.begin(), szName.end(), pwszName.begin());
             m_aMaterials.push_back(std::make_shared<Material>(pwszName));
 
-            loadTextures(pDevice, pImmediateContext, parentDirectory, pMaterial, i);
+            loadTextures(parentDirectory, pMaterial, i);
         }
-
-        return hr;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -691,6 +941,50 @@ namespace library
         }
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::initNodeHierarchy
+
+      Summary:  Flatten the given assimp node and its descendants in
+                depth-first order
+
+      Args:     const aiNode* pNode
+                  Pointer to an assimp node object
+                INT iParentIndex
+                  Index of the parent node, -1 for the root
+
+      Modifies: [m_aNodes].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Model::initNodeHierarchy(_In_ const aiNode* pNode, _In_ INT iParentIndex)
+    {
+        if (!pNode)
+        {
+            return;
+        }
+
+        CookedNode node =
+        {
+            .szName = pNode->mName.C_Str(),
+            .iParentIndex = iParentIndex,
+            .iBoneIndex = -1
+        };
+
+        auto bone = m_boneNameToIndexMap.find(node.szName);
+        if (bone != m_boneNameToIndexMap.end())
+        {
+            node.iBoneIndex = static_cast<INT>(bone->second);
+        }
+
+        XMStoreFloat4x4(&node.Transformation, ConvertMatrix(pNode->mTransformation));
+
+        INT iNodeIndex = static_cast<INT>(m_aNodes.size());
+        m_aNodes.push_back(std::move(node));
+
+        for (UINT i = 0u; i < pNode->mNumChildren; ++i)
+        {
+            initNodeHierarchy(pNode->mChildren[i], iNodeIndex);
+        }
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Model::initSingleMesh
 
@@ -762,30 +1056,29 @@ namespace library
                   Translate vector
                 FLOAT animationTimeTicks
                   Animation time
-                const aiNodeAnim* pNodeAnim
-                  Pointer to an assimp node anim object
+                const CookedChannel& channel
+                  Animation channel of the node
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    void Model::interpolatePosition(_Inout_ XMFLOAT3& outTranslate, _In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim)
+    void Model::interpolatePosition(_Inout_ XMFLOAT3& outTranslate, _In_ FLOAT animationTimeTicks, _In_ const CookedChannel& channel)
     {
-        if (pNodeAnim->mNumPositionKeys == 1)
+        if (channel.aPositionKeys.size() == 1)
         {
-            outTranslate = ConvertVector3dToFloat3(pNodeAnim->mPositionKeys[0].mValue);
+            outTranslate = channel.aPositionKeys[0].Value;
             return;
         }
 
-        UINT uPositionIndex = findPosition(animationTimeTicks, pNodeAnim);
+        UINT uPositionIndex = findPosition(animationTimeTicks, channel);
         UINT uNextPositionIndex = uPositionIndex + 1u;
-        assert(uNextPositionIndex < pNodeAnim->mNumPositionKeys);
+        assert(uNextPositionIndex < channel.aPositionKeys.size());
 
-        FLOAT t1 = static_cast<FLOAT>(pNodeAnim->mPositionKeys[uPositionIndex].mTime);
-        FLOAT t2 = static_cast<FLOAT>(pNodeAnim->mPositionKeys[uNextPositionIndex].mTime);
+        FLOAT t1 = channel.aPositionKeys[uPositionIndex].Time;
+        FLOAT t2 = channel.aPositionKeys[uNextPositionIndex].Time;
         FLOAT deltaTime = t2 - t1;
         FLOAT factor = (animationTimeTicks - t1) / deltaTime;
         assert(factor >= 0.0f && factor <= 1.0f);
-        const aiVector3D& start = pNodeAnim->mPositionKeys[uPositionIndex].mValue;
-        const aiVector3D& end = pNodeAnim->mPositionKeys[uNextPositionIndex].mValue;
-        aiVector3D delta = end - start;
-        outTranslate = ConvertVector3dToFloat3(start + factor * delta);
+        XMVECTOR start = XMLoadFloat3(&channel.aPositionKeys[uPositionIndex].Value);
+        XMVECTOR end = XMLoadFloat3(&channel.aPositionKeys[uNextPositionIndex].Value);
+        XMStoreFloat3(&outTranslate, XMVectorLerp(start, end, factor));
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -797,32 +1090,28 @@ namespace library
                   Quaternion vector
                 FLOAT animationTimeTicks
                   Animation time
-                const aiNodeAnim* pNodeAnim
-                  Pointer to an assimp node anim object
+                const CookedChannel& channel
+                  Animation channel of the node
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    void Model::interpolateRotation(_Inout_ XMVECTOR& outQuaternion, _In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim)
+    void Model::interpolateRotation(_Inout_ XMVECTOR& outQuaternion, _In_ FLOAT animationTimeTicks, _In_ const CookedChannel& channel)
     {
-        if (pNodeAnim->mNumRotationKeys == 1)
+        if (channel.aRotationKeys.size() == 1)
         {
-            outQuaternion = ConvertQuaternionToVector(pNodeAnim->mRotationKeys[0].mValue);
+            outQuaternion = XMLoadFloat4(&channel.aRotationKeys[0].Value);
             return;
         }
 
-        UINT uRotationIndex = findRotation(animationTimeTicks, pNodeAnim);
+        UINT uRotationIndex = findRotation(animationTimeTicks, channel);
         UINT uNextRotationIndex = uRotationIndex + 1;
-        assert(uNextRotationIndex < pNodeAnim->mNumRotationKeys);
-        FLOAT t1 = static_cast<FLOAT>(pNodeAnim->mRotationKeys[uRotationIndex].mTime);
-        FLOAT t2 = static_cast<FLOAT>(pNodeAnim->mRotationKeys[uNextRotationIndex].mTime);
+        assert(uNextRotationIndex < channel.aRotationKeys.size());
+        FLOAT t1 = channel.aRotationKeys[uRotationIndex].Time;
+        FLOAT t2 = channel.aRotationKeys[uNextRotationIndex].Time;
         FLOAT deltaTime = t2 - t1;
         FLOAT factor = (animationTimeTicks - t1) / deltaTime;
         assert(factor >= 0.0f && factor <= 1.0f);
-        aiQuaternion outQ;
-        const aiQuaternion& startRotationQ = pNodeAnim->mRotationKeys[uRotationIndex].mValue;
-        const aiQuaternion& endRotationQ = pNodeAnim->mRotationKeys[uNextRotationIndex].mValue;
-        aiQuaternion::Interpolate(outQ, startRotationQ, endRotationQ, factor);
-        outQ = startRotationQ;
-        outQ.Normalize();
-        outQuaternion = ConvertQuaternionToVector(outQ);
+        XMVECTOR startRotationQ = XMLoadFloat4(&channel.aRotationKeys[uRotationIndex].Value);
+        XMVECTOR endRotationQ = XMLoadFloat4(&channel.aRotationKeys[uNextRotationIndex].Value);
+        outQuaternion = XMQuaternionNormalize(XMQuaternionSlerp(startRotationQ, endRotationQ, factor));
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -834,56 +1123,49 @@ namespace library
                   Scaling vector
                 FLOAT animationTimeTicks
                   Animation time
-                const aiNodeAnim* pNodeAnim
-                  Pointer to an assimp node anim object
+                const CookedChannel& channel
+                  Animation channel of the node
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    void Model::interpolateScaling(_Inout_ XMFLOAT3& outScale, _In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim)
+    void Model::interpolateScaling(_Inout_ XMFLOAT3& outScale, _In_ FLOAT animationTimeTicks, _In_ const CookedChannel& channel)
     {
-        if (pNodeAnim->mNumScalingKeys == 1)
+        if (channel.aScalingKeys.size() == 1)
         {
-            outScale = ConvertVector3dToFloat3(pNodeAnim->mScalingKeys[0].mValue);
+            outScale = channel.aScalingKeys[0].Value;
             return;
         }
 
-        UINT uScalingIndex = findScaling(animationTimeTicks, pNodeAnim);
+        UINT uScalingIndex = findScaling(animationTimeTicks, channel);
         UINT uNextScalingIndex = uScalingIndex + 1;
-        assert(uNextScalingIndex < pNodeAnim->mNumScalingKeys);
-        FLOAT t1 = static_cast<FLOAT>(pNodeAnim->mScalingKeys[uScalingIndex].mTime);
-        FLOAT t2 = static_cast<FLOAT>(pNodeAnim->mScalingKeys[uNextScalingIndex].mTime);
+        assert(uNextScalingIndex < channel.aScalingKeys.size());
+        FLOAT t1 = channel.aScalingKeys[uScalingIndex].Time;
+        FLOAT t2 = channel.aScalingKeys[uNextScalingIndex].Time;
         FLOAT deltaTime = t2 - t1;
         FLOAT factor = (animationTimeTicks - t1) / deltaTime;
         assert(factor >= 0.0f && factor <= 1.0f);
-        const aiVector3D& start = pNodeAnim->mScalingKeys[uScalingIndex].mValue;
-        const aiVector3D& end = pNodeAnim->mScalingKeys[uNextScalingIndex].mValue;
-        aiVector3D delta = end - start;
-        outScale = ConvertVector3dToFloat3(start + factor * delta);
+        XMVECTOR start = XMLoadFloat3(&channel.aScalingKeys[uScalingIndex].Value);
+        XMVECTOR end = XMLoadFloat3(&channel.aScalingKeys[uNextScalingIndex].Value);
+        XMStoreFloat3(&outScale, XMVectorLerp(start, end, factor));
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Model::loadDiffuseTexture
 
-      Summary:  Load a diffuse texture from given path
+      Summary:  Create a diffuse texture from given path. The texture
+                is loaded and initialized later
 
-      Args:     ID3D11Device* pDevice
-                  The Direct3D device to create the buffers
-                ID3D11DeviceContext* pImmediateContext
-                  The Direct3D context to set buffers
-                const std::filesystem::path& parentDirectory
+      Args:     const std::filesystem::path& parentDirectory
                   Parent path to the model
                 const aiMaterial* pMaterial
                   Pointer to an assimp material object
                 UINT uIndex
                   Index to a material
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    HRESULT Model::loadDiffuseTexture(
-        _In_ ID3D11Device* pDevice,
-        _In_ ID3D11DeviceContext* pImmediateContext,
+    void Model::loadDiffuseTexture(
         _In_ const std::filesystem::path& parentDirectory,
         _In_ const aiMaterial* pMaterial,
         _In_ UINT uIndex
     )
     {
-        HRESULT hr = S_OK;
         m_aMaterials[uIndex]->pDiffuse = nullptr;
 
         if (pMaterial->GetTextureCount(aiTextureType_DIFFUSE) > 0)
@@ -901,53 +1183,30 @@ namespace library
 
                 std::filesystem::path fullPath = parentDirectory / szPath;
 
-                m_aMaterials[uIndex]->pDiffuse = std::make_shared<Texture>(fullPath);
-
-                hr = m_aMaterials[uIndex]->pDiffuse->Initialize(pDevice, pImmediateContext);
-                if (FAILED(hr))
-                {
-                    OutputDebugString(L"Error loading diffuse texture \"");
-                    OutputDebugString(fullPath.c_str());
-                    OutputDebugString(L"\"\n");
-
-                    return hr;
-                }
-
-                OutputDebugString(L"Loaded diffuse texture \"");
-                OutputDebugString(fullPath.c_str());
-                OutputDebugString(L"\"\n");
+                m_aMaterials[uIndex]->pDiffuse = TextureCache::GetTexture(fullPath);
             }
         }
-
-        return hr;
     }
 
-
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-       Method:   Model::loadSpecularTexture
-
-       Summary:  Load a specular texture from given path
-
-       Args:     ID3D11Device* pDevice
-                   The Direct3D device to create the buffers
-                 ID3D11DeviceContext* pImmediateContext
-                   The Direct3D context to set buffers
-                 const std::filesystem::path& parentDirectory
-                   Parent path to the model
-                 const aiMaterial* pMaterial
-                   Pointer to an assimp material object
-                 UINT uIndex
-                   Index to a material
-     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    HRESULT Model::loadSpecularTexture(
-        _In_ ID3D11Device* pDevice,
-        _In_ ID3D11DeviceContext* pImmediateContext,
+      Method:   Model::loadSpecularTexture
+
+      Summary:  Create a specular texture from given path. The texture
+                is loaded and initialized later
+
+      Args:     const std::filesystem::path& parentDirectory
+                  Parent path to the model
+                const aiMaterial* pMaterial
+                  Pointer to an assimp material object
+                UINT uIndex
+                  Index to a material
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Model::loadSpecularTexture(
         _In_ const std::filesystem::path& parentDirectory,
         _In_ const aiMaterial* pMaterial,
         _In_ UINT uIndex
     )
     {
-        HRESULT hr = S_OK;
         m_aMaterials[uIndex]->pSpecularExponent = nullptr;
 
         if (pMaterial->GetTextureCount(aiTextureType_SHININESS) > 0)
@@ -965,46 +1224,30 @@ namespace library
 
                 std::filesystem::path fullPath = parentDirectory / szPath;
 
-                m_aMaterials[uIndex]->pSpecularExponent = std::make_shared<Texture>(fullPath);
-
-                hr = m_aMaterials[uIndex]->pSpecularExponent->Initialize(pDevice, pImmediateContext);
-                if (FAILED(hr))
-                {
-                    OutputDebugString(L"Error loading specular texture \"");
-                    OutputDebugString(fullPath.c_str());
-                    OutputDebugString(L"\"\n");
-
-                    return hr;
-                }
-
-                OutputDebugString(L"Loaded specular texture \"");
-                OutputDebugString(fullPath.c_str());
-                OutputDebugString(L"\"\n");
+                m_aMaterials[uIndex]->pSpecularExponent = TextureCache::GetTexture(fullPath);
             }
         }
-
-        return hr;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Model::loadNormalTexture
 
-      Summary:  Load a normal texture from given path
+      Summary:  Create a normal texture from given path. The texture
+                is loaded and initialized later
 
-      Args:     ID3D11Device* pDevice
-                  The Direct3D device to create the buffers
-                ID3D11DeviceContext* pImmediateContext
-                  The Direct3D context to set buffers
-                const std::filesystem::path& parentDirectory
+      Args:     const std::filesystem::path& parentDirectory
                   Parent path to the model
                 const aiMaterial* pMaterial
                   Pointer to an assimp material object
                 UINT uIndex
                   Index to a material
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    HRESULT Model::loadNormalTexture(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext, _In_ const std::filesystem::path& parentDirectory, _In_ const aiMaterial* pMaterial, _In_ UINT uIndex)
+    void Model::loadNormalTexture(
+        _In_ const std::filesystem::path& parentDirectory,
+        _In_ const aiMaterial* pMaterial,
+        _In_ UINT uIndex
+    )
     {
-        HRESULT hr = S_OK;
         m_aMaterials[uIndex]->pNormal = nullptr;
 
         if (pMaterial->GetTextureCount(aiTextureType_HEIGHT) > 0)
@@ -1022,117 +1265,88 @@ namespace library
 
                 std::filesystem::path fullPath = parentDirectory / szPath;
 
-                m_aMaterials[uIndex]->pNormal = std::make_shared<Texture>(fullPath);
+                m_aMaterials[uIndex]->pNormal = TextureCache::GetTexture(fullPath);
                 m_bHasNormalMap = true;
-
-                if (FAILED(hr))
-                {
-                    OutputDebugString(L"Error loading normal texture \"");
-                    OutputDebugString(fullPath.c_str());
-                    OutputDebugString(L"\"\n");
-
-                    return hr;
-                }
-
-                OutputDebugString(L"Loaded normal texture \"");
-                OutputDebugString(fullPath.c_str());
-                OutputDebugString(L"\"\n");
+                markDirty();
             }
         }
-
-        return hr;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Model::loadTextures
 
-      Summary:  Load a specular texture from given path
+      Summary:  Create the textures of a material from given path
 
-      Args:     ID3D11Device* pDevice
-                  The Direct3D device to create the buffers
-                ID3D11DeviceContext* pImmediateContext
-                  The Direct3D context to set buffers
-                const std::filesystem::path& parentDirectory
+      Args:     const std::filesystem::path& parentDirectory
                   Parent path to the model
                 const aiMaterial* pMaterial
                   Pointer to an assimp material object
                 UINT uIndex
                   Index to a material
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    HRESULT Model::loadTextures(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext, _In_ const std::filesystem::path& parentDirectory, _In_ const aiMaterial* pMaterial, _In_ UINT uIndex)
+    void Model::loadTextures(_In_ const std::filesystem::path& parentDirectory, _In_ const aiMaterial* pMaterial, _In_ UINT uIndex)
     {
-        HRESULT hr = loadDiffuseTexture(pDevice, pImmediateContext, parentDirectory, pMaterial, uIndex);
-        if (FAILED(hr))
-        {
-            return hr;
-        }
-
-        hr = loadSpecularTexture(pDevice, pImmediateContext, parentDirectory, pMaterial, uIndex);
-        if (FAILED(hr))
-        {
-            return hr;
-        }
-
-        hr = loadNormalTexture(pDevice, pImmediateContext, parentDirectory, pMaterial, uIndex);
-        if (FAILED(hr))
-        {
-            return hr;
-        }
-
-        return hr;
+        loadDiffuseTexture(parentDirectory, pMaterial, uIndex);
+        loadSpecularTexture(parentDirectory, pMaterial, uIndex);
+        loadNormalTexture(parentDirectory, pMaterial, uIndex);
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Model::readNodeHierarchy
 
-      Summary:  Calculate bone transformation of the given assimp node
+      Summary:  Calculate bone transformations of the node hierarchy.
+                Nodes are stored parents first, so a single pass
+                over them visits every parent before its children
 
       Args:     FLOAT animationTimeTicks
                   Animation time
-               const aiNode* pNode
-                  Pointer to an assimp node object
-                const XMMATRIX& parentTransform
-                  Parent transform in hierarchy
+
+      Modifies: [m_aNodeTransforms, m_aBoneInfo].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    void Model::readNodeHierarchy(_In_ FLOAT animationTimeTicks, _In_ const aiNode* pNode, _In_ const XMMATRIX& parentTransform)
+    void Model::readNodeHierarchy(_In_ FLOAT animationTimeTicks)
     {
-        PCSTR NodeName(pNode->mName.C_Str());
-        const aiAnimation* pAnimation = m_pScene->mAnimations[0];
-        XMMATRIX NodeTransform(ConvertMatrix(pNode->mTransformation));
-        const aiNodeAnim* pNodeAnim = findNodeAnimOrNull(pAnimation, pNode->mName.C_Str());
+        const CookedAnimation& animation = m_aAnimations[0];
+        m_aNodeTransforms.resize(m_aNodes.size());
 
-        if (pNodeAnim)
+        for (size_t i = 0u; i < m_aNodes.size(); ++i)
         {
-            // Interpolate scaling and generate scaling transformation matrix
-            XMFLOAT3 scaling = XMFLOAT3();
-            interpolateScaling(scaling, animationTimeTicks, pNodeAnim);
-            XMMATRIX scalingM = XMMatrixScaling(scaling.x, scaling.y, scaling.z);
-
-            // Interpolate rotation and generate rotation transformation matrix
-            XMVECTOR rotation = XMVECTOR();
-            interpolateRotation(rotation, animationTimeTicks, pNodeAnim);
-            XMMATRIX rotationM = XMMatrixRotationQuaternion(rotation);
-
-            // Interpolate translation and generate translation transformation matrix
-            XMFLOAT3 translation = XMFLOAT3();
-            interpolatePosition(translation, animationTimeTicks, pNodeAnim);
-            XMMATRIX translationM = XMMatrixTranslation(translation.x, translation.y, translation.z);
-
-            // Combine the above transformations
-            NodeTransform = scalingM * rotationM * translationM;
-        }
+            const CookedNode& node = m_aNodes[i];
+            XMMATRIX NodeTransform = XMLoadFloat4x4(&node.Transformation);
+            INT iChannelIndex = m_aNodeChannelIndices[i];
 
-        XMMATRIX globalTransformation = NodeTransform * parentTransform;
+            if (iChannelIndex >= 0)
+            {
+                const CookedChannel& channel = animation.aChannels[iChannelIndex];
 
-        if (m_boneNameToIndexMap.find(NodeName) != m_boneNameToIndexMap.end())
-        {
-            UINT uBoneIndex = m_boneNameToIndexMap[NodeName];
-            m_aBoneInfo[uBoneIndex].FinalTransformation = m_aBoneInfo[uBoneIndex].OffsetMatrix * globalTransformation * m_globalInverseTransform;
-        }
+                // Interpolate scaling and generate scaling transformation matrix
+                XMFLOAT3 scaling = XMFLOAT3();
+                interpolateScaling(scaling, animationTimeTicks, channel);
+                XMMATRIX scalingM = XMMatrixScaling(scaling.x, scaling.y, scaling.z);
 
-        for (UINT i = 0u; i < pNode->mNumChildren; ++i)
-        {
-            readNodeHierarchy(animationTimeTicks, pNode->mChildren[i], globalTransformation);
+                // Interpolate rotation and generate rotation transformation matrix
+                XMVECTOR rotation = XMVECTOR();
+                interpolateRotation(rotation, animationTimeTicks, channel);
+                XMMATRIX rotationM = XMMatrixRotationQuaternion(rotation);
+
+                // Interpolate translation and generate translation transformation matrix
+                XMFLOAT3 translation = XMFLOAT3();
+                interpolatePosition(translation, animationTimeTicks, channel);
+                XMMATRIX translationM = XMMatrixTranslation(translation.x, translation.y, translation.z);
+
+                // Combine the above transformations
+                NodeTransform = scalingM * rotationM * translationM;
+            }
+
+            XMMATRIX globalTransformation = node.iParentIndex >= 0
+                ? NodeTransform * m_aNodeTransforms[node.iParentIndex]
+                : NodeTransform;
+            m_aNodeTransforms[i] = globalTransformation;
+
+            if (node.iBoneIndex >= 0)
+            {
+                BoneInfo& boneInfo = m_aBoneInfo[node.iBoneIndex];
+                boneInfo.FinalTransformation = boneInfo.OffsetMatrix * globalTransformation * m_globalInverseTransform;
+            }
         }
     }
 
@@ -12,6 +12,8 @@
 #pragma once
 
 #include "Common.h"
+#include "Model/ModelCache.h"
+#include "Profiler/Profiler.h"
 #include "Renderer/DataTypes.h"
 #include "Renderer/Renderable.h"
 #include "Shader/PixelShader.h"
@@ -21,15 +23,8 @@
 struct aiScene;
 struct aiMesh;
 struct aiMaterial;
-struct aiAnimation;
 struct aiBone;
 struct aiNode;
-struct aiNodeAnim;
-
-namespace Assimp
-{
-    class Importer;
-}
 
 namespace library
 {
@@ -38,7 +33,11 @@ namespace library
 
       Summary:  Model class is a renderable from model files
 
-      Methods:  Initialize
+      Methods:  Load
+                  Imports the model file, or reads it from the model
+                  cache, without touching the device so that it can
+                  run on a worker thread
+                Initialize
                   Pure virtual function that initializes the object
                 Update
                   Pure virtual function that updates the object each
@@ -47,8 +46,6 @@ namespace library
                   Returns the vertex buffer
                 GetIndexBuffer
                   Returns the index buffer
-                GetConstantBuffer
-                  Returns the constant buffer
                 GetWorldMatrix
                   Returns the world matrix
                 GetNumVertices
@@ -57,6 +54,8 @@ namespace library
                 GetNumIndices
                   Pure virtual function that returns the number of
                   indices
+                SetCacheEnabled
+                  Enables or disables the cooked model cache
                 Model
                   Constructor.
                 ~Model
@@ -71,13 +70,13 @@ namespace library
         Model(Model&& other) = delete;
         Model& operator=(const Model& other) = delete;
         Model& operator=(Model&& other) = delete;
-        virtual ~Model();
+        virtual ~Model() = default;
 
+        virtual HRESULT Load();
         virtual HRESULT Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext);
         virtual void Update(_In_ FLOAT deltaTime) override;
 
         ComPtr<ID3D11Buffer>& GetAnimationBuffer();
-        ComPtr<ID3D11Buffer>& GetSkinningConstantBuffer();
 
         virtual UINT GetNumVertices() const override;
         virtual UINT GetNumIndices() const override;
@@ -85,6 +84,8 @@ namespace library
         std::vector<XMMATRIX>& GetBoneTransforms();
         const std::unordered_map<std::string, UINT>& GetBoneNameToIndexMap() const;
 
+        static void SetCacheEnabled(_In_ BOOL bEnabled);
+
     protected:
         struct VertexBoneData
         {
@@ -104,10 +105,6 @@ namespace library
                 aBoneIds[uNumBones] = uBoneId;
                 aWeights[uNumBones] = weight;
 
-                static CHAR szDebugMessage[256];
-                sprintf_s(szDebugMessage, "\t\t\tBone %d, weight: %f, index %u\n", uBoneId, weight, uNumBones);
-                OutputDebugStringA(szDebugMessage);
-
                 ++uNumBones;
             }
 
@@ -129,72 +126,40 @@ namespace library
             XMMATRIX FinalTransformation;
         };
 
+        void cook(_Inout_ CookedModel& outModel) const;
         void countVerticesAndIndices(_Inout_ UINT& uOutNumVertices, _Inout_ UINT& uOutNumIndices, _In_ const aiScene* pScene);
-        const aiNodeAnim* findNodeAnimOrNull(_In_ const aiAnimation* pAnimation, _In_ PCSTR pszNodeName);
-        UINT findPosition(_In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim);
-        UINT findRotation(_In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim);
-        UINT findScaling(_In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim);
+        UINT findPosition(_In_ FLOAT animationTimeTicks, _In_ const CookedChannel& channel);
+        UINT findRotation(_In_ FLOAT animationTimeTicks, _In_ const CookedChannel& channel);
+        UINT findScaling(_In_ FLOAT animationTimeTicks, _In_ const CookedChannel& channel);
         UINT getBoneId(_In_ const aiBone* pBone);
         const virtual SimpleVertex* getVertices() const override;
         virtual const WORD* getIndices() const override;
         void initAllMeshes(_In_ const aiScene* pScene);
-        HRESULT initFromScene(
-            _In_ ID3D11Device* pDevice,
-            _In_ ID3D11DeviceContext* pImmediateContext,
-            _In_ const aiScene* pScene,
-            _In_ const std::filesystem::path& filePath
-        );
-        HRESULT initMaterials(
-            _In_ ID3D11Device* pDevice,
-            _In_ ID3D11DeviceContext* pImmediateContext,
-            _In_ const aiScene* pScene,
-            _In_ const std::filesystem::path& filePath
-        );
+        void initAnimations(_In_ const aiScene* pScene);
+        void initFromCookedModel(_In_ CookedModel& model);
+        void initFromScene(_In_ const aiScene* pScene, _In_ const std::filesystem::path& filePath);
+        void initMaterials(_In_ const aiScene* pScene, _In_ const std::filesystem::path& filePath);
         void initMeshBones(_In_ UINT uMeshIndex, _In_ const aiMesh* pMesh);
         void initMeshSingleBone(_In_ UINT uBoneIndex, _In_ const aiBone* pBone);
+        void initNodeHierarchy(_In_ const aiNode* pNode, _In_ INT iParentIndex);
         virtual void initSingleMesh(_In_ UINT uMeshIndex, _In_ const aiMesh* pMesh);
-        void interpolatePosition(_Inout_ XMFLOAT3& outTranslate, _In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim);
-        void interpolateRotation(_Inout_ XMVECTOR& outQuaternion, _In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim);
-        void interpolateScaling(_Inout_ XMFLOAT3& outScale, _In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim);
-        HRESULT loadDiffuseTexture(
-            _In_ ID3D11Device* pDevice,
-            _In_ ID3D11DeviceContext* pImmediateContext,
-            _In_ const std::filesystem::path& parentDirectory,
-            _In_ const aiMaterial* pMaterial,
-            _In_ UINT uIndex
-        );
-        HRESULT loadSpecularTexture(
-            _In_ ID3D11Device* pDevice,
-            _In_ ID3D11DeviceContext* pImmediateContext,
-            _In_ const std::filesystem::path& parentDirectory,
-            _In_ const aiMaterial* pMaterial,
-            _In_ UINT uIndex
-        );
-        HRESULT loadNormalTexture(
-            _In_ ID3D11Device* pDevice,
-            _In_ ID3D11DeviceContext* pImmediateContext,
-            _In_ const std::filesystem::path& parentDirectory,
-            _In_ const aiMaterial* pMaterial,
-            _In_ UINT uIndex
-        );
-        HRESULT loadTextures(
-            _In_ ID3D11Device* pDevice,
-            _In_ ID3D11DeviceContext* pImmediateContext,
-            _In_ const std::filesystem::path& parentDirectory,
-            _In_ const aiMaterial* pMaterial,
-            _In_ UINT uIndex
-        );
-        void readNodeHierarchy(_In_ FLOAT animationTimeTicks, _In_ const aiNode* pNode, _In_ const XMMATRIX& parentTransform);
+        void interpolatePosition(_Inout_ XMFLOAT3& outTranslate, _In_ FLOAT animationTimeTicks, _In_ const CookedChannel& channel);
+        void interpolateRotation(_Inout_ XMVECTOR& outQuaternion, _In_ FLOAT animationTimeTicks, _In_ const CookedChannel& channel);
+        void interpolateScaling(_Inout_ XMFLOAT3& outScale, _In_ FLOAT animationTimeTicks, _In_ const CookedChannel& channel);
+        void loadDiffuseTexture(_In_ const std::filesystem::path& parentDirectory, _In_ const aiMaterial* pMaterial, _In_ UINT uIndex);
+        void loadSpecularTexture(_In_ const std::filesystem::path& parentDirectory, _In_ const aiMaterial* pMaterial, _In_ UINT uIndex);
+        void loadNormalTexture(_In_ const std::filesystem::path& parentDirectory, _In_ const aiMaterial* pMaterial, _In_ UINT uIndex);
+        void loadTextures(_In_ const std::filesystem::path& parentDirectory, _In_ const aiMaterial* pMaterial, _In_ UINT uIndex);
+        void readNodeHierarchy(_In_ FLOAT animationTimeTicks);
         void reserveSpace(_In_ UINT uNumVertices, _In_ UINT uNumIndices);
 
     protected:
-        static std::unique_ptr<Assimp::Importer> sm_pImporter;
+        static BOOL sm_bCacheEnabled;
 
     protected:
         std::filesystem::path m_filePath;
 
         ComPtr<ID3D11Buffer> m_animationBuffer;
-        ComPtr<ID3D11Buffer> m_skinningConstantBuffer;
 
         std::vector<SimpleVertex> m_aVertices;
         std::vector<AnimationData> m_aAnimationData;
@@ -204,9 +169,13 @@ namespace library
         std::vector<XMMATRIX> m_aTransforms;
         std::unordered_map<std::string, UINT> m_boneNameToIndexMap;
 
-        const aiScene* m_pScene;
+        std::vector<CookedNode> m_aNodes;
+        std::vector<CookedAnimation> m_aAnimations;
+        std::vector<INT> m_aNodeChannelIndices;
+        std::vector<XMMATRIX> m_aNodeTransforms;
 
         float m_timeSinceLoaded;
+        BOOL m_bIsLoaded;
 
         XMMATRIX m_globalInverseTransform;
 
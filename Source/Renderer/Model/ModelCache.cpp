@@ -0,0 +1,671 @@
+#include "Model/ModelCache.h"
+
+#include "Texture/MappedFile.h"
+
+namespace library
+{
+    std::filesystem::path ModelCache::sm_cacheDirectory = L"Cache/Models";
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ModelCache::ComputeKey
+
+      Summary:  Hashes the contents and the path of the source file
+                together with the import flags, the importer variant
+                and the cache version
+
+      Args:     const std::filesystem::path& sourcePath
+                  Path to the model file
+                UINT uImportFlags
+                  Assimp post processing flags
+                PCSTR pszVariant
+                  Name of the importer, different importers may cook
+                  the same file differently
+                UINT64& uOutKey
+                  Computed key
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT ModelCache::ComputeKey(
+        _In_ const std::filesystem::path& sourcePath,
+        _In_ UINT uImportFlags,
+        _In_ PCSTR pszVariant,
+        _Out_ UINT64& uOutKey
+    )
+    {
+        uOutKey = 0ull;
+
+        std::error_code errorCode;
+        uintmax_t uFileSize = std::filesystem::file_size(sourcePath, errorCode);
+        if (errorCode)
+        {
+            return HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND);
+        }
+
+        UINT64 uHash = HASH_OFFSET_BASIS;
+
+        // Empty files can not be mapped and leave the hash as it is
+        if (uFileSize > 0u)
+        {
+            MappedFile sourceFile;
+            if (!sourceFile.Open(sourcePath))
+            {
+                return HRESULT_FROM_WIN32(ERROR_OPEN_FAILED);
+            }
+
+            uHash = HashBytes(uHash, sourceFile.GetData(), sourceFile.GetSize());
+        }
+
+        std::wstring szPath = sourcePath.lexically_normal().generic_wstring();
+        uHash = HashBytes(uHash, szPath.data(), szPath.size() * sizeof(WCHAR));
+        uHash = HashBytes(uHash, &uImportFlags, sizeof(uImportFlags));
+        uHash = HashBytes(uHash, pszVariant, strlen(pszVariant));
+
+        UINT uVersion = VERSION;
+        uHash = HashBytes(uHash, &uVersion, sizeof(uVersion));
+
+        uOutKey = uHash;
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ModelCache::Load
+
+      Summary:  Memory-maps the cache file of the given key and reads
+                the cooked model from it. The model is rejected if one
+                of the files it references changed since it was cooked
+
+      Args:     const std::filesystem::path& sourcePath
+                  Path to the model file
+                UINT64 uKey
+                  Key computed by ComputeKey
+                CookedModel& outModel
+                  Cooked model
+
+      Returns:  HRESULT
+                  Status code, failure means a cache miss
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT ModelCache::Load(_In_ const std::filesystem::path& sourcePath, _In_ UINT64 uKey, _Out_ CookedModel& outModel)
+    {
+        outModel = CookedModel();
+
+        std::filesystem::path cacheFilePath = getCacheFilePath(sourcePath, uKey);
+
+        MappedFile cacheFile;
+        if (!cacheFile.Open(cacheFilePath))
+        {
+            return HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND);
+        }
+
+        UINT64 uDependencyKey = 0ull;
+        HRESULT hr = read(cacheFile.GetData(), cacheFile.GetSize(), uKey, uDependencyKey, outModel);
+        cacheFile.Close();
+
+        if (FAILED(hr))
+        {
+            outModel = CookedModel();
+
+            OutputDebugString(L"Ignoring corrupted model cache \"");
+            OutputDebugString(cacheFilePath.c_str());
+            OutputDebugString(L"\"\n");
+
+            return hr;
+        }
+
+        // Edited material libraries and textures leave the key of the model file unchanged
+        if (computeDependencyKey(outModel) != uDependencyKey)
+        {
+            outModel = CookedModel();
+
+            OutputDebugString(L"Ignoring out of date model cache \"");
+            OutputDebugString(cacheFilePath.c_str());
+            OutputDebugString(L"\"\n");
+
+            return E_FAIL;
+        }
+
+        return hr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ModelCache::Save
+
+      Summary:  Writes the cooked model to the cache file of the given
+                key. The file is written next to the destination and
+                then moved over it, so a crash never leaves a partial
+                cache file behind
+
+      Args:     const std::filesystem::path& sourcePath
+                  Path to the model file
+                UINT64 uKey
+                  Key computed by ComputeKey
+                const CookedModel& model
+                  Cooked model
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT ModelCache::Save(_In_ const std::filesystem::path& sourcePath, _In_ UINT64 uKey, _In_ const CookedModel& model)
+    {
+        std::error_code errorCode;
+        std::filesystem::create_directories(sm_cacheDirectory, errorCode);
+        if (errorCode)
+        {
+            return HRESULT_FROM_WIN32(errorCode.value());
+        }
+
+        std::vector<BYTE> aBuffer;
+        write(aBuffer, uKey, model);
+
+        std::filesystem::path cacheFilePath = getCacheFilePath(sourcePath, uKey);
+        std::filesystem::path tempFilePath = cacheFilePath;
+        tempFilePath += L".tmp";
+
+        HANDLE hFile = CreateFile(
+            tempFilePath.c_str(),
+            GENERIC_WRITE,
+            0u,
+            nullptr,
+            CREATE_ALWAYS,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+            nullptr
+        );
+        if (hFile == INVALID_HANDLE_VALUE)
+        {
+            return HRESULT_FROM_WIN32(GetLastError());
+        }
+
+        DWORD dwBytesWritten = 0u;
+        BOOL bWritten = WriteFile(hFile, aBuffer.data(), static_cast<DWORD>(aBuffer.size()), &dwBytesWritten, nullptr);
+        CloseHandle(hFile);
+
+        if (!bWritten || dwBytesWritten != aBuffer.size())
+        {
+            DeleteFile(tempFilePath.c_str());
+            return E_FAIL;
+        }
+
+        if (!MoveFileEx(tempFilePath.c_str(), cacheFilePath.c_str(), MOVEFILE_REPLACE_EXISTING))
+        {
+            HRESULT hr = HRESULT_FROM_WIN32(GetLastError());
+            DeleteFile(tempFilePath.c_str());
+            return hr;
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ModelCache::SetCacheDirectory
+
+      Summary:  Sets the directory that holds the cache files
+
+      Args:     const std::filesystem::path& cacheDirectory
+                  Directory of the cache files
+
+      Modifies: [sm_cacheDirectory].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ModelCache::SetCacheDirectory(_In_ const std::filesystem::path& cacheDirectory)
+    {
+        sm_cacheDirectory = cacheDirectory;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ModelCache::getCacheFilePath
+
+      Summary:  Returns the path to the cache file of the given key
+
+      Args:     const std::filesystem::path& sourcePath
+                  Path to the model file
+                UINT64 uKey
+                  Key computed by ComputeKey
+
+      Returns:  std::filesystem::path
+                  Path to the cache file
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    std::filesystem::path ModelCache::getCacheFilePath(_In_ const std::filesystem::path& sourcePath, _In_ UINT64 uKey)
+    {
+        WCHAR szKey[17];
+        swprintf_s(szKey, L"%016llx", uKey);
+
+        return sm_cacheDirectory / (sourcePath.stem().wstring() + L"_" + szKey + L".mdlc");
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ModelCache::computeDependencyKey
+
+      Summary:  Hashes the paths, sizes and last write times of the
+                dependencies and the material textures of a cooked
+                model. Missing files hash without a size or time, so
+                creating one later changes the key too
+
+      Args:     const CookedModel& model
+                  Cooked model
+
+      Returns:  UINT64
+                  Key of the referenced files
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 ModelCache::computeDependencyKey(_In_ const CookedModel& model)
+    {
+        std::vector<std::wstring> aPaths = model.aDependencies;
+        for (const CookedMaterial& material : model.aMaterials)
+        {
+            aPaths.push_back(material.szDiffusePath);
+            aPaths.push_back(material.szSpecularPath);
+            aPaths.push_back(material.szNormalPath);
+        }
+
+        UINT64 uHash = HASH_OFFSET_BASIS;
+        for (const std::wstring& szPath : aPaths)
+        {
+            if (szPath.empty())
+            {
+                continue;
+            }
+
+            uHash = HashBytes(uHash, szPath.data(), szPath.size() * sizeof(WCHAR));
+
+            std::error_code errorCode;
+            UINT64 uSize = static_cast<UINT64>(std::filesystem::file_size(szPath, errorCode));
+            uSize = errorCode ? 0ull : uSize;
+
+            std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(szPath, errorCode);
+            INT64 iWriteTime = errorCode ? 0ll : static_cast<INT64>(writeTime.time_since_epoch().count());
+
+            uHash = HashBytes(uHash, &uSize, sizeof(uSize));
+            uHash = HashBytes(uHash, &iWriteTime, sizeof(iWriteTime));
+        }
+
+        return uHash;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ModelCache::read
+
+      Summary:  Parses a cooked model, every read is bounds checked so
+                truncated or corrupted files are rejected
+
+      Args:     const BYTE* pData
+                  Contents of the cache file
+                size_t uSize
+                  Size of the cache file
+                UINT64 uKey
+                  Expected key
+                UINT64& uOutDependencyKey
+                  Key of the referenced files when the model was
+                  cooked
+                CookedModel& outModel
+                  Cooked model
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT ModelCache::read(
+        _In_reads_bytes_(uSize) const BYTE* pData,
+        _In_ size_t uSize,
+        _In_ UINT64 uKey,
+        _Out_ UINT64& uOutDependencyKey,
+        _Out_ CookedModel& outModel
+    )
+    {
+        uOutDependencyKey = 0ull;
+
+        const BYTE* pCursor = pData;
+        const BYTE* pEnd = pData + uSize;
+
+        UINT uMagic = 0u;
+        UINT uVersion = 0u;
+        UINT64 uFileKey = 0ull;
+        if (!readValue(pCursor, pEnd, uMagic) || uMagic != MAGIC
+            || !readValue(pCursor, pEnd, uVersion) || uVersion != VERSION
+            || !readValue(pCursor, pEnd, uFileKey) || uFileKey != uKey)
+        {
+            return E_FAIL;
+        }
+
+        UINT uNumDependencies = 0u;
+        if (!readValue(pCursor, pEnd, uOutDependencyKey) || !readValue(pCursor, pEnd, uNumDependencies))
+        {
+            return E_FAIL;
+        }
+        outModel.aDependencies.resize(uNumDependencies);
+        for (std::wstring& szDependency : outModel.aDependencies)
+        {
+            if (!readString(pCursor, pEnd, szDependency))
+            {
+                return E_FAIL;
+            }
+        }
+
+        if (!readArray(pCursor, pEnd, outModel.aVertices)
+            || !readArray(pCursor, pEnd, outModel.aNormalData)
+            || !readArray(pCursor, pEnd, outModel.aAnimationData)
+            || !readArray(pCursor, pEnd, outModel.aIndices)
+            || !readArray(pCursor, pEnd, outModel.aMeshes))
+        {
+            return E_FAIL;
+        }
+
+        UINT uNumMaterials = 0u;
+        if (!readValue(pCursor, pEnd, uNumMaterials))
+        {
+            return E_FAIL;
+        }
+        outModel.aMaterials.resize(uNumMaterials);
+        for (CookedMaterial& material : outModel.aMaterials)
+        {
+            if (!readString(pCursor, pEnd, material.szDiffusePath)
+                || !readString(pCursor, pEnd, material.szSpecularPath)
+                || !readString(pCursor, pEnd, material.szNormalPath))
+            {
+                return E_FAIL;
+            }
+        }
+
+        UINT uNumBones = 0u;
+        if (!readValue(pCursor, pEnd, uNumBones))
+        {
+            return E_FAIL;
+        }
+        outModel.aBones.resize(uNumBones);
+        for (CookedBone& bone : outModel.aBones)
+        {
+            if (!readString(pCursor, pEnd, bone.szName) || !readValue(pCursor, pEnd, bone.OffsetMatrix))
+            {
+                return E_FAIL;
+            }
+        }
+
+        UINT uNumNodes = 0u;
+        if (!readValue(pCursor, pEnd, uNumNodes))
+        {
+            return E_FAIL;
+        }
+        outModel.aNodes.resize(uNumNodes);
+        for (UINT i = 0u; i < uNumNodes; ++i)
+        {
+            CookedNode& node = outModel.aNodes[i];
+            if (!readString(pCursor, pEnd, node.szName)
+                || !readValue(pCursor, pEnd, node.iParentIndex)
+                || !readValue(pCursor, pEnd, node.iBoneIndex)
+                || !readValue(pCursor, pEnd, node.Transformation))
+            {
+                return E_FAIL;
+            }
+
+            // Parents must precede their children and bones must exist
+            if (node.iParentIndex >= static_cast<INT>(i) || node.iBoneIndex >= static_cast<INT>(uNumBones))
+            {
+                return E_FAIL;
+            }
+        }
+
+        UINT uNumAnimations = 0u;
+        if (!readValue(pCursor, pEnd, uNumAnimations))
+        {
+            return E_FAIL;
+        }
+        outModel.aAnimations.resize(uNumAnimations);
+        for (CookedAnimation& animation : outModel.aAnimations)
+        {
+            UINT uNumChannels = 0u;
+            if (!readValue(pCursor, pEnd, animation.Duration)
+                || !readValue(pCursor, pEnd, animation.TicksPerSecond)
+                || !readValue(pCursor, pEnd, uNumChannels))
+            {
+                return E_FAIL;
+            }
+
+            animation.aChannels.resize(uNumChannels);
+            for (CookedChannel& channel : animation.aChannels)
+            {
+                if (!readValue(pCursor, pEnd, channel.uNodeIndex)
+                    || channel.uNodeIndex >= uNumNodes
+                    || !readArray(pCursor, pEnd, channel.aPositionKeys)
+                    || !readArray(pCursor, pEnd, channel.aRotationKeys)
+                    || !readArray(pCursor, pEnd, channel.aScalingKeys))
+                {
+                    return E_FAIL;
+                }
+            }
+        }
+
+        return pCursor == pEnd ? S_OK : E_FAIL;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ModelCache::write
+
+      Summary:  Serializes a cooked model in the layout read expects
+
+      Args:     std::vector<BYTE>& aBuffer
+                  Buffer to append to
+                UINT64 uKey
+                  Key computed by ComputeKey
+                const CookedModel& model
+                  Cooked model
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ModelCache::write(_Inout_ std::vector<BYTE>& aBuffer, _In_ UINT64 uKey, _In_ const CookedModel& model)
+    {
+        aBuffer.reserve(
+            model.aVertices.size() * (sizeof(SimpleVertex) + sizeof(NormalData))
+            + model.aAnimationData.size() * sizeof(AnimationData)
+            + model.aIndices.size() * sizeof(WORD)
+            + 4096u
+        );
+
+        writeValue(aBuffer, MAGIC);
+        writeValue(aBuffer, VERSION);
+        writeValue(aBuffer, uKey);
+
+        writeValue(aBuffer, computeDependencyKey(model));
+        writeValue(aBuffer, static_cast<UINT>(model.aDependencies.size()));
+        for (const std::wstring& szDependency : model.aDependencies)
+        {
+            writeString(aBuffer, szDependency);
+        }
+
+        writeArray(aBuffer, model.aVertices);
+        writeArray(aBuffer, model.aNormalData);
+        writeArray(aBuffer, model.aAnimationData);
+        writeArray(aBuffer, model.aIndices);
+        writeArray(aBuffer, model.aMeshes);
+
+        writeValue(aBuffer, static_cast<UINT>(model.aMaterials.size()));
+        for (const CookedMaterial& material : model.aMaterials)
+        {
+            writeString(aBuffer, material.szDiffusePath);
+            writeString(aBuffer, material.szSpecularPath);
+            writeString(aBuffer, material.szNormalPath);
+        }
+
+        writeValue(aBuffer, static_cast<UINT>(model.aBones.size()));
+        for (const CookedBone& bone : model.aBones)
+        {
+            writeString(aBuffer, bone.szName);
+            writeValue(aBuffer, bone.OffsetMatrix);
+        }
+
+        writeValue(aBuffer, static_cast<UINT>(model.aNodes.size()));
+        for (const CookedNode& node : model.aNodes)
+        {
+            writeString(aBuffer, node.szName);
+            writeValue(aBuffer, node.iParentIndex);
+            writeValue(aBuffer, node.iBoneIndex);
+            writeValue(aBuffer, node.Transformation);
+        }
+
+        writeValue(aBuffer, static_cast<UINT>(model.aAnimations.size()));
+        for (const CookedAnimation& animation : model.aAnimations)
+        {
+            writeValue(aBuffer, animation.Duration);
+            writeValue(aBuffer, animation.TicksPerSecond);
+            writeValue(aBuffer, static_cast<UINT>(animation.aChannels.size()));
+
+            for (const CookedChannel& channel : animation.aChannels)
+            {
+                writeValue(aBuffer, channel.uNodeIndex);
+                writeArray(aBuffer, channel.aPositionKeys);
+                writeArray(aBuffer, channel.aRotationKeys);
+                writeArray(aBuffer, channel.aScalingKeys);
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ModelCache::readValue
+
+      Summary:  Reads a trivially copyable value and advances the
+                cursor
+
+      Args:     const BYTE*& pCursor
+                  Current read position
+                const BYTE* pEnd
+                  End of the data
+                T& outValue
+                  Value read
+
+      Returns:  BOOL
+                  FALSE if there is not enough data left
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    template <typename T>
+    BOOL ModelCache::readValue(_Inout_ const BYTE*& pCursor, _In_ const BYTE* pEnd, _Out_ T& outValue)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        if (static_cast<size_t>(pEnd - pCursor) < sizeof(T))
+        {
+            return FALSE;
+        }
+
+        memcpy(&outValue, pCursor, sizeof(T));
+        pCursor += sizeof(T);
+
+        return TRUE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ModelCache::readArray
+
+      Summary:  Reads a count followed by that many trivially copyable
+                values and advances the cursor
+
+      Args:     const BYTE*& pCursor
+                  Current read position
+                const BYTE* pEnd
+                  End of the data
+                std::vector<T>& aOutValues
+                  Values read
+
+      Returns:  BOOL
+                  FALSE if there is not enough data left
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    template <typename T>
+    BOOL ModelCache::readArray(_Inout_ const BYTE*& pCursor, _In_ const BYTE* pEnd, _Out_ std::vector<T>& aOutValues)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        UINT uCount = 0u;
+        if (!readValue(pCursor, pEnd, uCount) || static_cast<size_t>(pEnd - pCursor) / sizeof(T) < uCount)
+        {
+            return FALSE;
+        }
+
+        aOutValues.resize(uCount);
+        memcpy(aOutValues.data(), pCursor, uCount * sizeof(T));
+        pCursor += uCount * sizeof(T);
+
+        return TRUE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ModelCache::readString
+
+      Summary:  Reads a length prefixed string and advances the cursor
+
+      Args:     const BYTE*& pCursor
+                  Current read position
+                const BYTE* pEnd
+                  End of the data
+                std::basic_string<T>& outString
+                  String read
+
+      Returns:  BOOL
+                  FALSE if there is not enough data left
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    template <typename T>
+    BOOL ModelCache::readString(_Inout_ const BYTE*& pCursor, _In_ const BYTE* pEnd, _Out_ std::basic_string<T>& outString)
+    {
+        UINT uLength = 0u;
+        if (!readValue(pCursor, pEnd, uLength) || static_cast<size_t>(pEnd - pCursor) / sizeof(T) < uLength)
+        {
+            return FALSE;
+        }
+
+        outString.resize(uLength);
+        memcpy(outString.data(), pCursor, uLength * sizeof(T));
+        pCursor += uLength * sizeof(T);
+
+        return TRUE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ModelCache::writeValue
+
+      Summary:  Appends a trivially copyable value
+
+      Args:     std::vector<BYTE>& aBuffer
+                  Buffer to append to
+                const T& value
+                  Value to write
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    template <typename T>
+    void ModelCache::writeValue(_Inout_ std::vector<BYTE>& aBuffer, _In_ const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        const BYTE* pBytes = reinterpret_cast<const BYTE*>(&value);
+        aBuffer.insert(aBuffer.end(), pBytes, pBytes + sizeof(T));
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ModelCache::writeArray
+
+      Summary:  Appends a count followed by the values
+
+      Args:     std::vector<BYTE>& aBuffer
+                  Buffer to append to
+                const std::vector<T>& aValues
+                  Values to write
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    template <typename T>
+    void ModelCache::writeArray(_Inout_ std::vector<BYTE>& aBuffer, _In_ const std::vector<T>& aValues)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        writeValue(aBuffer, static_cast<UINT>(aValues.size()));
+
+        const BYTE* pBytes = reinterpret_cast<const BYTE*>(aValues.data());
+        aBuffer.insert(aBuffer.end(), pBytes, pBytes + aValues.size() * sizeof(T));
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ModelCache::writeString
+
+      Summary:  Appends a length prefixed string
+
+      Args:     std::vector<BYTE>& aBuffer
+                  Buffer to append to
+                const std::basic_string<T>& string
+                  String to write
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    template <typename T>
+    void ModelCache::writeString(_Inout_ std::vector<BYTE>& aBuffer, _In_ const std::basic_string<T>& string)
+    {
+        writeValue(aBuffer, static_cast<UINT>(string.size()));
+
+        const BYTE* pBytes = reinterpret_cast<const BYTE*>(string.data());
+        aBuffer.insert(aBuffer.end(), pBytes, pBytes + string.size() * sizeof(T));
+    }
+}
\ No newline at end of file
@@ -0,0 +1,215 @@
+/*+===================================================================
+  File:      MODELCACHE.H
+
+  Summary:   ModelCache header file contains declarations of the
+             cooked model data and the ModelCache class that stores
+             it in a binary cache file so that models do not need to
+             be re-imported by assimp on every launch.
+
+  Classes: ModelCache
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/DataTypes.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   CookedMeshEntry
+
+      Summary:  Draw range and material of a single mesh
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct CookedMeshEntry
+    {
+        UINT uNumIndices;
+        UINT uBaseVertex;
+        UINT uBaseIndex;
+        UINT uMaterialIndex;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   CookedMaterial
+
+      Summary:  Resolved texture paths of a material, empty if the
+                material does not have the texture
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct CookedMaterial
+    {
+        std::wstring szDiffusePath;
+        std::wstring szSpecularPath;
+        std::wstring szNormalPath;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   CookedBone
+
+      Summary:  Name and offset matrix of a bone
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct CookedBone
+    {
+        std::string szName;
+        XMFLOAT4X4 OffsetMatrix;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   CookedNode
+
+      Summary:  Node of the flattened scene hierarchy. Nodes are
+                stored in depth-first order so that a parent always
+                precedes its children
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct CookedNode
+    {
+        std::string szName;
+        INT iParentIndex;
+        INT iBoneIndex;
+        XMFLOAT4X4 Transformation;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   CookedVectorKey
+
+      Summary:  Position or scaling key frame
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct CookedVectorKey
+    {
+        FLOAT Time;
+        XMFLOAT3 Value;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   CookedQuaternionKey
+
+      Summary:  Rotation key frame
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct CookedQuaternionKey
+    {
+        FLOAT Time;
+        XMFLOAT4 Value;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   CookedChannel
+
+      Summary:  Key frames animating a single node
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct CookedChannel
+    {
+        UINT uNodeIndex;
+        std::vector<CookedVectorKey> aPositionKeys;
+        std::vector<CookedQuaternionKey> aRotationKeys;
+        std::vector<CookedVectorKey> aScalingKeys;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   CookedAnimation
+
+      Summary:  Animation clip
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct CookedAnimation
+    {
+        FLOAT Duration;
+        FLOAT TicksPerSecond;
+        std::vector<CookedChannel> aChannels;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   CookedModel
+
+      Summary:  Final runtime data of a model, ready to be uploaded.
+                The dependencies are the files the import read besides
+                the model file, such as its material library
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct CookedModel
+    {
+        std::vector<SimpleVertex> aVertices;
+        std::vector<NormalData> aNormalData;
+        std::vector<AnimationData> aAnimationData;
+        std::vector<WORD> aIndices;
+        std::vector<CookedMeshEntry> aMeshes;
+        std::vector<CookedMaterial> aMaterials;
+        std::vector<CookedBone> aBones;
+        std::vector<CookedNode> aNodes;
+        std::vector<CookedAnimation> aAnimations;
+        std::vector<std::wstring> aDependencies;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    ModelCache
+
+      Summary:  Reads and writes cooked models. Cache files are keyed
+                by a hash of the source file contents, its path, the
+                import flags and the importer variant, so any change
+                to one of them results in a cache miss. The paths,
+                sizes and write times of the dependencies and of the
+                material textures are hashed into a second key stored
+                in the file, a cooked model whose referenced files
+                changed since it was written is a miss as well
+
+      Methods:  ComputeKey
+                  Hashes the source file and import settings
+                Load
+                  Memory-maps the cache file of the given key and
+                  reads the cooked model
+                Save
+                  Writes the cooked model to the cache file of the
+                  given key
+                SetCacheDirectory
+                  Sets the directory that holds the cache files
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class ModelCache
+    {
+    public:
+        static constexpr UINT MAGIC = 0x434c444du;  // "MDLC"
+        static constexpr UINT VERSION = 2u;
+
+        ModelCache() = delete;
+        ModelCache(const ModelCache& other) = delete;
+        ModelCache(ModelCache&& other) = delete;
+        ModelCache& operator=(const ModelCache& other) = delete;
+        ModelCache& operator=(ModelCache&& other) = delete;
+        ~ModelCache() = delete;
+
+        static HRESULT ComputeKey(
+            _In_ const std::filesystem::path& sourcePath,
+            _In_ UINT uImportFlags,
+            _In_ PCSTR pszVariant,
+            _Out_ UINT64& uOutKey
+        );
+        static HRESULT Load(_In_ const std::filesystem::path& sourcePath, _In_ UINT64 uKey, _Out_ CookedModel& outModel);
+        static HRESULT Save(_In_ const std::filesystem::path& sourcePath, _In_ UINT64 uKey, _In_ const CookedModel& model);
+        static void SetCacheDirectory(_In_ const std::filesystem::path& cacheDirectory);
+
+    private:
+        static std::filesystem::path getCacheFilePath(_In_ const std::filesystem::path& sourcePath, _In_ UINT64 uKey);
+        static UINT64 computeDependencyKey(_In_ const CookedModel& model);
+        static HRESULT read(
+            _In_reads_bytes_(uSize) const BYTE* pData,
+            _In_ size_t uSize,
+            _In_ UINT64 uKey,
+            _Out_ UINT64& uOutDependencyKey,
+            _Out_ CookedModel& outModel
+        );
+        static void write(_Inout_ std::vector<BYTE>& aBuffer, _In_ UINT64 uKey, _In_ const CookedModel& model);
+
+        template <typename T>
+        static BOOL readValue(_Inout_ const BYTE*& pCursor, _In_ const BYTE* pEnd, _Out_ T& outValue);
+        template <typename T>
+        static BOOL readArray(_Inout_ const BYTE*& pCursor, _In_ const BYTE* pEnd, _Out_ std::vector<T>& aOutValues);
+        template <typename T>
+        static BOOL readString(_Inout_ const BYTE*& pCursor, _In_ const BYTE* pEnd, _Out_ std::basic_string<T>& outString);
+        template <typename T>
+        static void writeValue(_Inout_ std::vector<BYTE>& aBuffer, _In_ const T& value);
+        template <typename T>
+        static void writeArray(_Inout_ std::vector<BYTE>& aBuffer, _In_ const std::vector<T>& aValues);
+        template <typename T>
+        static void writeString(_Inout_ std::vector<BYTE>& aBuffer, _In_ const std::basic_string<T>& string);
+
+    private:
+        static std::filesystem::path sm_cacheDirectory;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include "Model/RecordingIOSystem.h"
+
+#include <algorithm>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingIOSystem::RecordingIOSystem
+
+      Summary:  Constructor
+
+      Modifies: [m_aOpenedFiles].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    RecordingIOSystem::RecordingIOSystem()
+        : m_aOpenedFiles()
+    {
+        // empty
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingIOSystem::Open
+
+      Summary:  Opens a file with the default file system and records
+                its path if it exists
+
+      Args:     const char* pszFile
+                  Path to the file
+                const char* pszMode
+                  fopen mode
+
+      Modifies: [m_aOpenedFiles].
+
+      Returns:  Assimp::IOStream*
+                  Opened file, null if it can not be opened
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    Assimp::IOStream* RecordingIOSystem::Open(_In_ const char* pszFile, _In_ const char* pszMode)
+    {
+        Assimp::IOStream* pStream = Assimp::DefaultIOSystem::Open(pszFile, pszMode);
+        if (pStream)
+        {
+            std::wstring szPath = std::filesystem::path(pszFile).lexically_normal().wstring();
+            if (std::find(m_aOpenedFiles.begin(), m_aOpenedFiles.end(), szPath) == m_aOpenedFiles.end())
+            {
+                m_aOpenedFiles.push_back(szPath);
+            }
+        }
+
+        return pStream;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingIOSystem::GetOpenedFiles
+
+      Summary:  Returns the paths of the files opened so far, in the
+                order they were first opened
+
+      Returns:  const std::vector<std::wstring>&
+                  Normalized paths
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::vector<std::wstring>& RecordingIOSystem::GetOpenedFiles() const
+    {
+        return m_aOpenedFiles;
+    }
+}
\ No newline at end of file
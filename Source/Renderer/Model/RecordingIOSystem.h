@@ -0,0 +1,55 @@
+/*+===================================================================
+  File:      RECORDINGIOSYSTEM.H
+
+  Summary:   RecordingIOSystem header file contains declarations of
+             the RecordingIOSystem class, an assimp file system that
+             remembers every file an import opens.
+
+  Classes: RecordingIOSystem
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "assimp/DefaultIOSystem.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    RecordingIOSystem
+
+      Summary:  Default assimp file system that records the paths of
+                the files it opens, such as the material library of an
+                OBJ file or the animations of an MD5 mesh, so the model
+                cache can tell when one of them changes. The importer
+                takes ownership of it
+
+      Methods:  Open
+                  Opens a file and records its path
+                GetOpenedFiles
+                  Returns the paths of the opened files, each once
+                RecordingIOSystem
+                  Constructor.
+                ~RecordingIOSystem
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class RecordingIOSystem final : public Assimp::DefaultIOSystem
+    {
+    public:
+        RecordingIOSystem();
+        RecordingIOSystem(const RecordingIOSystem& other) = delete;
+        RecordingIOSystem(RecordingIOSystem&& other) = delete;
+        RecordingIOSystem& operator=(const RecordingIOSystem& other) = delete;
+        RecordingIOSystem& operator=(RecordingIOSystem&& other) = delete;
+        ~RecordingIOSystem() = default;
+
+        Assimp::IOStream* Open(_In_ const char* pszFile, _In_ const char* pszMode = "rb") override;
+
+        const std::vector<std::wstring>& GetOpenedFiles() const;
+
+    private:
+        std::vector<std::wstring> m_aOpenedFiles;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,169 @@
+#include "Profiler/D3D11GpuTimerBackend.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11GpuTimerBackend::D3D11GpuTimerBackend
+
+      Summary:  Constructor
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the queries
+                ID3D11DeviceContext* pImmediateContext
+                  The immediate context to issue the queries on
+
+      Modifies: [m_d3dDevice, m_immediateContext, m_aDisjointQueries,
+                 m_aTimestampQueries, m_uNumTimestamps].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    D3D11GpuTimerBackend::D3D11GpuTimerBackend(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext)
+        : m_d3dDevice(pDevice)
+        , m_immediateContext(pImmediateContext)
+        , m_aDisjointQueries()
+        , m_aTimestampQueries()
+        , m_uNumTimestamps(0u)
+    {
+        // empty
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11GpuTimerBackend::Initialize
+
+      Summary:  Creates one disjoint query and uNumTimestamps timestamp
+                queries for every frame in flight
+
+      Args:     UINT uNumFrames
+                  Number of frames in flight
+                UINT uNumTimestamps
+                  Number of timestamps of a frame
+
+      Modifies: [m_aDisjointQueries, m_aTimestampQueries,
+                 m_uNumTimestamps].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT D3D11GpuTimerBackend::Initialize(_In_ UINT uNumFrames, _In_ UINT uNumTimestamps)
+    {
+        HRESULT hr = S_OK;
+
+        m_uNumTimestamps = uNumTimestamps;
+        m_aDisjointQueries.resize(uNumFrames);
+        m_aTimestampQueries.resize(static_cast<size_t>(uNumFrames) * uNumTimestamps);
+
+        D3D11_QUERY_DESC queryDesc =
+        {
+            .Query = D3D11_QUERY_TIMESTAMP_DISJOINT,
+            .MiscFlags = 0u
+        };
+        for (ComPtr<ID3D11Query>& query : m_aDisjointQueries)
+        {
+            hr = m_d3dDevice->CreateQuery(&queryDesc, query.ReleaseAndGetAddressOf());
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+        }
+
+        queryDesc.Query = D3D11_QUERY_TIMESTAMP;
+        for (ComPtr<ID3D11Query>& query : m_aTimestampQueries)
+        {
+            hr = m_d3dDevice->CreateQuery(&queryDesc, query.ReleaseAndGetAddressOf());
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+        }
+
+        return hr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11GpuTimerBackend::BeginFrame
+
+      Summary:  Begins the disjoint query of a frame
+
+      Args:     UINT uFrame
+                  Index of the frame in flight
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11GpuTimerBackend::BeginFrame(_In_ UINT uFrame)
+    {
+        m_immediateContext->Begin(m_aDisjointQueries[uFrame].Get());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11GpuTimerBackend::WriteTimestamp
+
+      Summary:  Ends a timestamp query, which records the time the GPU
+                reaches it
+
+      Args:     UINT uFrame
+                  Index of the frame in flight
+                UINT uTimestamp
+                  Index of the timestamp
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11GpuTimerBackend::WriteTimestamp(_In_ UINT uFrame, _In_ UINT uTimestamp)
+    {
+        m_immediateContext->End(m_aTimestampQueries[uFrame * m_uNumTimestamps + uTimestamp].Get());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11GpuTimerBackend::EndFrame
+
+      Summary:  Ends the disjoint query of a frame
+
+      Args:     UINT uFrame
+                  Index of the frame in flight
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11GpuTimerBackend::EndFrame(_In_ UINT uFrame)
+    {
+        m_immediateContext->End(m_aDisjointQueries[uFrame].Get());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11GpuTimerBackend::GetFrequency
+
+      Summary:  Polls the disjoint query of a frame
+
+      Args:     UINT uFrame
+                  Index of the frame in flight
+                UINT64& uOutFrequency
+                  Ticks per second of the timestamps
+                BOOL& bOutDisjoint
+                  Whether the timestamps of the frame are unreliable
+
+      Returns:  HRESULT
+                  S_OK when ready, S_FALSE while the GPU is not done
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT D3D11GpuTimerBackend::GetFrequency(_In_ UINT uFrame, _Out_ UINT64& uOutFrequency, _Out_ BOOL& bOutDisjoint)
+    {
+        D3D11_QUERY_DATA_TIMESTAMP_DISJOINT disjoint = {};
+        HRESULT hr = m_immediateContext->GetData(m_aDisjointQueries[uFrame].Get(), &disjoint, sizeof(disjoint), D3D11_ASYNC_GETDATA_DONOTFLUSH);
+
+        uOutFrequency = disjoint.Frequency;
+        bOutDisjoint = disjoint.Disjoint;
+
+        return hr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11GpuTimerBackend::GetTimestamp
+
+      Summary:  Polls a timestamp query of a frame
+
+      Args:     UINT uFrame
+                  Index of the frame in flight
+                UINT uTimestamp
+                  Index of the timestamp
+                UINT64& uOutTimestamp
+                  GPU ticks when the timestamp was reached
+
+      Returns:  HRESULT
+                  S_OK when ready, S_FALSE while the GPU is not done
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT D3D11GpuTimerBackend::GetTimestamp(_In_ UINT uFrame, _In_ UINT uTimestamp, _Out_ UINT64& uOutTimestamp)
+    {
+        uOutTimestamp = 0u;
+
+        return m_immediateContext->GetData(m_aTimestampQueries[uFrame * m_uNumTimestamps + uTimestamp].Get(), &uOutTimestamp, sizeof(uOutTimestamp), D3D11_ASYNC_GETDATA_DONOTFLUSH);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+/*+===================================================================
+  File:      D3D11GPUTIMERBACKEND.H
+
+  Summary:   D3D11GpuTimerBackend header file contains declarations of
+             the D3D11GpuTimerBackend class that measures passes with
+             Direct3D 11 timestamp queries.
+
+  Classes: D3D11GpuTimerBackend
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Profiler/GpuTimerBackend.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    D3D11GpuTimerBackend
+
+      Summary:  GPU timer backend built on D3D11_QUERY_TIMESTAMP and
+                D3D11_QUERY_TIMESTAMP_DISJOINT queries issued on the
+                immediate context. Polls with
+                D3D11_ASYNC_GETDATA_DONOTFLUSH so reading a result
+                never flushes or stalls
+
+      Methods:  Initialize
+                  Creates the queries
+                BeginFrame
+                  Begins the disjoint query of a frame
+                WriteTimestamp
+                  Ends a timestamp query of a frame
+                EndFrame
+                  Ends the disjoint query of a frame
+                GetFrequency
+                  Polls the disjoint query of a frame
+                GetTimestamp
+                  Polls a timestamp query of a frame
+                D3D11GpuTimerBackend
+                  Constructor.
+                ~D3D11GpuTimerBackend
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class D3D11GpuTimerBackend final : public GpuTimerBackend
+    {
+    public:
+        D3D11GpuTimerBackend(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext);
+        D3D11GpuTimerBackend(const D3D11GpuTimerBackend& other) = delete;
+        D3D11GpuTimerBackend(D3D11GpuTimerBackend&& other) = delete;
+        D3D11GpuTimerBackend& operator=(const D3D11GpuTimerBackend& other) = delete;
+        D3D11GpuTimerBackend& operator=(D3D11GpuTimerBackend&& other) = delete;
+        ~D3D11GpuTimerBackend() = default;
+
+        HRESULT Initialize(_In_ UINT uNumFrames, _In_ UINT uNumTimestamps) override;
+
+        void BeginFrame(_In_ UINT uFrame) override;
+        void WriteTimestamp(_In_ UINT uFrame, _In_ UINT uTimestamp) override;
+        void EndFrame(_In_ UINT uFrame) override;
+
+        HRESULT GetFrequency(_In_ UINT uFrame, _Out_ UINT64& uOutFrequency, _Out_ BOOL& bOutDisjoint) override;
+        HRESULT GetTimestamp(_In_ UINT uFrame, _In_ UINT uTimestamp, _Out_ UINT64& uOutTimestamp) override;
+
+    private:
+        ComPtr<ID3D11Device> m_d3dDevice;
+        ComPtr<ID3D11DeviceContext> m_immediateContext;
+        std::vector<ComPtr<ID3D11Query>> m_aDisjointQueries;
+        std::vector<ComPtr<ID3D11Query>> m_aTimestampQueries;
+        UINT m_uNumTimestamps;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,300 @@
+#include "Profiler/GpuProfiler.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   GpuProfiler::GpuProfiler
+
+      Summary:  Constructor
+
+      Args:     std::unique_ptr<GpuTimerBackend> backend
+                  The queries to time with
+
+      Modifies: [m_backend, m_aaScopeNames, m_abPending,
+                 m_uNumIssuedFrames, m_bInFrame, m_aLastTimings,
+                 m_lastFrameMs, m_uNumCollectedFrames,
+                 m_uNumDroppedFrames].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    GpuProfiler::GpuProfiler(_In_ std::unique_ptr<GpuTimerBackend> backend)
+        : m_backend(std::move(backend))
+        , m_aaScopeNames()
+        , m_abPending()
+        , m_uNumIssuedFrames(0u)
+        , m_bInFrame(FALSE)
+        , m_aLastTimings()
+        , m_lastFrameMs(0.0f)
+        , m_uNumCollectedFrames(0u)
+        , m_uNumDroppedFrames(0u)
+    {
+        m_abPending.fill(FALSE);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   GpuProfiler::Initialize
+
+      Summary:  Creates the queries of every frame in flight
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT GpuProfiler::Initialize()
+    {
+        return m_backend->Initialize(NUM_FRAMES, NUM_TIMESTAMPS);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   GpuProfiler::BeginFrame
+
+      Summary:  Starts timing a frame in the next slot. If that slot is
+                still waiting for the GPU, its results are dropped
+                instead of waited for
+
+      Modifies: [m_aaScopeNames, m_abPending, m_bInFrame,
+                 m_uNumDroppedFrames].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void GpuProfiler::BeginFrame()
+    {
+        const UINT uFrame = static_cast<UINT>(m_uNumIssuedFrames % NUM_FRAMES);
+        if (m_abPending[uFrame] && !collect(uFrame))
+        {
+            m_abPending[uFrame] = FALSE;
+            ++m_uNumDroppedFrames;
+        }
+
+        m_aaScopeNames[uFrame].clear();
+        m_backend->BeginFrame(uFrame);
+        m_backend->WriteTimestamp(uFrame, 0u);
+        m_bInFrame = TRUE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   GpuProfiler::BeginScope
+
+      Summary:  Starts timing a scope of the frame
+
+      Args:     PCSTR pszName
+                  Name of the scope, must outlive the profiler
+
+      Modifies: [m_aaScopeNames].
+
+      Returns:  UINT
+                  Handle to the scope, INVALID_SCOPE outside a frame or
+                  when a frame has MAX_SCOPES scopes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT GpuProfiler::BeginScope(_In_ PCSTR pszName)
+    {
+        const UINT uFrame = static_cast<UINT>(m_uNumIssuedFrames % NUM_FRAMES);
+        if (!m_bInFrame || m_aaScopeNames[uFrame].size() >= MAX_SCOPES)
+        {
+            return INVALID_SCOPE;
+        }
+
+        const UINT uScope = static_cast<UINT>(m_aaScopeNames[uFrame].size());
+        m_aaScopeNames[uFrame].push_back(pszName);
+        m_backend->WriteTimestamp(uFrame, 2u + 2u * uScope);
+
+        return uScope;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   GpuProfiler::EndScope
+
+      Summary:  Stops timing a scope of the frame
+
+      Args:     UINT uScope
+                  Handle returned by BeginScope
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void GpuProfiler::EndScope(_In_ UINT uScope)
+    {
+        if (uScope == INVALID_SCOPE || !m_bInFrame)
+        {
+            return;
+        }
+
+        m_backend->WriteTimestamp(static_cast<UINT>(m_uNumIssuedFrames % NUM_FRAMES), 3u + 2u * uScope);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   GpuProfiler::EndFrame
+
+      Summary:  Stops timing the frame, then collects the frames in
+                flight oldest first until one is not finished. The GPU
+                finishes frames in order, so later frames cannot be
+                ready either
+
+      Modifies: [m_abPending, m_uNumIssuedFrames, m_bInFrame].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void GpuProfiler::EndFrame()
+    {
+        if (!m_bInFrame)
+        {
+            return;
+        }
+
+        const UINT uFrame = static_cast<UINT>(m_uNumIssuedFrames % NUM_FRAMES);
+        m_backend->WriteTimestamp(uFrame, 1u);
+        m_backend->EndFrame(uFrame);
+        m_abPending[uFrame] = TRUE;
+        m_bInFrame = FALSE;
+        ++m_uNumIssuedFrames;
+
+        for (UINT i = 0u; i < NUM_FRAMES; ++i)
+        {
+            const UINT uOldestFrame = static_cast<UINT>((m_uNumIssuedFrames + i) % NUM_FRAMES);
+            if (m_abPending[uOldestFrame] && !collect(uOldestFrame))
+            {
+                break;
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   GpuProfiler::GetLastTimings
+
+      Summary:  Returns the scopes of the last collected frame
+
+      Returns:  const std::vector<ProfilerGpuEvent>&
+                  Timed scopes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::vector<ProfilerGpuEvent>& GpuProfiler::GetLastTimings() const
+    {
+        return m_aLastTimings;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   GpuProfiler::GetLastFrameMs
+
+      Summary:  Returns the GPU time of the last collected frame
+
+      Returns:  FLOAT
+                  Milliseconds
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT GpuProfiler::GetLastFrameMs() const
+    {
+        return m_lastFrameMs;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   GpuProfiler::GetNumCollectedFrames
+
+      Summary:  Returns the number of frames whose results were read
+
+      Returns:  UINT64
+                  Number of collected frames
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 GpuProfiler::GetNumCollectedFrames() const
+    {
+        return m_uNumCollectedFrames;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   GpuProfiler::GetNumDroppedFrames
+
+      Summary:  Returns the number of frames that were not ready in
+                time or disjoint
+
+      Returns:  UINT64
+                  Number of dropped frames
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 GpuProfiler::GetNumDroppedFrames() const
+    {
+        return m_uNumDroppedFrames;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   GpuProfiler::collect
+
+      Summary:  Reads the results of a frame in flight if they are all
+                ready and reports its scopes to the profiler. Frames
+                with disjoint timestamps are dropped
+
+      Args:     UINT uFrame
+                  Index of the frame in flight
+
+      Modifies: [m_abPending, m_aLastTimings, m_lastFrameMs,
+                 m_uNumCollectedFrames, m_uNumDroppedFrames].
+
+      Returns:  BOOL
+                  FALSE if the frame is not finished yet
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL GpuProfiler::collect(_In_ UINT uFrame)
+    {
+        UINT64 uFrequency = 0u;
+        BOOL bDisjoint = FALSE;
+        if (m_backend->GetFrequency(uFrame, uFrequency, bDisjoint) != S_OK)
+        {
+            return FALSE;
+        }
+
+        const UINT uNumTimestamps = 2u + 2u * static_cast<UINT>(m_aaScopeNames[uFrame].size());
+        std::array<UINT64, NUM_TIMESTAMPS> auTimestamps = {};
+        for (UINT i = 0u; i < uNumTimestamps; ++i)
+        {
+            if (m_backend->GetTimestamp(uFrame, i, auTimestamps[i]) != S_OK)
+            {
+                return FALSE;
+            }
+        }
+
+        m_abPending[uFrame] = FALSE;
+        if (bDisjoint || uFrequency == 0u)
+        {
+            ++m_uNumDroppedFrames;
+            return TRUE;
+        }
+
+        auto toMs = [uFrequency, uBegin = auTimestamps[0]](_In_ UINT64 uTimestamp)
+        {
+            return static_cast<FLOAT>(static_cast<DOUBLE>(uTimestamp - uBegin) * 1000.0 / static_cast<DOUBLE>(uFrequency));
+        };
+
+        m_lastFrameMs = toMs(auTimestamps[1]);
+        m_aLastTimings.clear();
+        m_aLastTimings.push_back(ProfilerGpuEvent{ .pszName = "GPU frame", .startMs = 0.0f, .durationMs = m_lastFrameMs });
+        for (UINT i = 0u; i < m_aaScopeNames[uFrame].size(); ++i)
+        {
+            const FLOAT startMs = toMs(auTimestamps[2u + 2u * i]);
+            m_aLastTimings.push_back(ProfilerGpuEvent{ .pszName = m_aaScopeNames[uFrame][i], .startMs = startMs, .durationMs = toMs(auTimestamps[3u + 2u * i]) - startMs });
+        }
+
+        for (const ProfilerGpuEvent& event : m_aLastTimings)
+        {
+            Profiler::RecordGpuEvent(event);
+        }
+        ++m_uNumCollectedFrames;
+
+        return TRUE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   GpuProfileScope::GpuProfileScope
+
+      Summary:  Constructor, starts timing
+
+      Args:     GpuProfiler* pGpuProfiler
+                  The GPU profiler, may be null
+                PCSTR pszName
+                  Name of the scope, must outlive the profiler
+
+      Modifies: [m_pGpuProfiler, m_uScope].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    GpuProfileScope::GpuProfileScope(_In_opt_ GpuProfiler* pGpuProfiler, _In_ PCSTR pszName)
+        : m_pGpuProfiler(pGpuProfiler)
+        , m_uScope(pGpuProfiler ? pGpuProfiler->BeginScope(pszName) : GpuProfiler::INVALID_SCOPE)
+    {
+        // empty
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   GpuProfileScope::~GpuProfileScope
+
+      Summary:  Destructor, stops timing
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    GpuProfileScope::~GpuProfileScope()
+    {
+        if (m_pGpuProfiler)
+        {
+            m_pGpuProfiler->EndScope(m_uScope);
+        }
+    }
+}
\ No newline at end of file
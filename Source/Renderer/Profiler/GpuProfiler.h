@@ -0,0 +1,132 @@
+/*+===================================================================
+  File:      GPUPROFILER.H
+
+  Summary:   GpuProfiler header file contains declarations of the GPU
+             profiler that times render passes with timestamp queries
+             and reports them to the Profiler.
+
+  Classes: GpuProfiler, GpuProfileScope
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Profiler/GpuTimerBackend.h"
+#include "Profiler/Profiler.h"
+
+#include <array>
+
+#if PROFILER_ENABLED
+#define PROFILE_GPU_SCOPE(pGpuProfiler, pszName) library::GpuProfileScope PROFILER_CONCAT(gpuProfileScope, __LINE__)(pGpuProfiler, pszName)
+#else
+#define PROFILE_GPU_SCOPE(pGpuProfiler, pszName) ((void)0)
+#endif
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    GpuProfiler
+
+      Summary:  Times scopes of a frame on the GPU. NUM_FRAMES frames
+                are in flight, each with its own queries, and results
+                are only polled, so the CPU never waits for the GPU.
+                Finished frames are collected oldest first at the end
+                of every frame and handed to Profiler::RecordGpuEvent.
+                A frame whose queries are still pending when its slot
+                comes around again, or whose timestamps are disjoint,
+                is dropped. Must be used on the thread that owns the
+                immediate context
+
+      Methods:  Initialize
+                  Creates the queries of the backend
+                BeginFrame
+                  Starts timing a frame
+                BeginScope
+                  Starts timing a scope of the frame
+                EndScope
+                  Stops timing a scope of the frame
+                EndFrame
+                  Stops timing the frame and collects finished frames
+                GetLastTimings
+                  Returns the scopes of the last collected frame
+                GetLastFrameMs
+                  Returns the GPU time of the last collected frame
+                GetNumCollectedFrames
+                  Returns the number of collected frames
+                GetNumDroppedFrames
+                  Returns the number of frames without results
+                GpuProfiler
+                  Constructor.
+                ~GpuProfiler
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class GpuProfiler final
+    {
+    public:
+        static constexpr UINT NUM_FRAMES = 3u;
+        static constexpr UINT MAX_SCOPES = 15u;
+        static constexpr UINT NUM_TIMESTAMPS = 2u + 2u * MAX_SCOPES;
+        static constexpr UINT INVALID_SCOPE = UINT_MAX;
+
+        GpuProfiler(_In_ std::unique_ptr<GpuTimerBackend> backend);
+        GpuProfiler(const GpuProfiler& other) = delete;
+        GpuProfiler(GpuProfiler&& other) = delete;
+        GpuProfiler& operator=(const GpuProfiler& other) = delete;
+        GpuProfiler& operator=(GpuProfiler&& other) = delete;
+        ~GpuProfiler() = default;
+
+        HRESULT Initialize();
+
+        void BeginFrame();
+        UINT BeginScope(_In_ PCSTR pszName);
+        void EndScope(_In_ UINT uScope);
+        void EndFrame();
+
+        const std::vector<ProfilerGpuEvent>& GetLastTimings() const;
+        FLOAT GetLastFrameMs() const;
+        UINT64 GetNumCollectedFrames() const;
+        UINT64 GetNumDroppedFrames() const;
+
+    private:
+        BOOL collect(_In_ UINT uFrame);
+
+    private:
+        std::unique_ptr<GpuTimerBackend> m_backend;
+        std::array<std::vector<PCSTR>, NUM_FRAMES> m_aaScopeNames;
+        std::array<BOOL, NUM_FRAMES> m_abPending;
+        UINT64 m_uNumIssuedFrames;
+        BOOL m_bInFrame;
+        std::vector<ProfilerGpuEvent> m_aLastTimings;
+        FLOAT m_lastFrameMs;
+        UINT64 m_uNumCollectedFrames;
+        UINT64 m_uNumDroppedFrames;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    GpuProfileScope
+
+      Summary:  Times the GPU work recorded in the enclosing scope, does
+                nothing without a profiler
+
+      Methods:  GpuProfileScope
+                  Constructor.
+                ~GpuProfileScope
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class GpuProfileScope final
+    {
+    public:
+        GpuProfileScope(_In_opt_ GpuProfiler* pGpuProfiler, _In_ PCSTR pszName);
+        GpuProfileScope(const GpuProfileScope& other) = delete;
+        GpuProfileScope(GpuProfileScope&& other) = delete;
+        GpuProfileScope& operator=(const GpuProfileScope& other) = delete;
+        GpuProfileScope& operator=(GpuProfileScope&& other) = delete;
+        ~GpuProfileScope();
+
+    private:
+        GpuProfiler* m_pGpuProfiler;
+        UINT m_uScope;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+/*+===================================================================
+  File:      GPUTIMERBACKEND.H
+
+  Summary:   GpuTimerBackend header file contains declarations of the
+             GpuTimerBackend class, the query interface the GPU
+             profiler measures passes with.
+
+  Classes: GpuTimerBackend
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    GpuTimerBackend
+
+      Summary:  Ring of query sets, one per frame in flight. A frame
+                brackets its timestamps with a disjoint query that
+                gives the frequency of the timestamps and whether they
+                are valid. Results are polled and never waited for
+
+      Methods:  Initialize
+                  Creates the queries
+                BeginFrame
+                  Begins the disjoint query of a frame
+                WriteTimestamp
+                  Writes a timestamp of a frame
+                EndFrame
+                  Ends the disjoint query of a frame
+                GetFrequency
+                  Polls the disjoint query of a frame
+                GetTimestamp
+                  Polls a timestamp of a frame
+                GpuTimerBackend
+                  Constructor.
+                ~GpuTimerBackend
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class GpuTimerBackend
+    {
+    public:
+        GpuTimerBackend() = default;
+        GpuTimerBackend(const GpuTimerBackend& other) = delete;
+        GpuTimerBackend(GpuTimerBackend&& other) = delete;
+        GpuTimerBackend& operator=(const GpuTimerBackend& other) = delete;
+        GpuTimerBackend& operator=(GpuTimerBackend&& other) = delete;
+        virtual ~GpuTimerBackend() = default;
+
+        virtual HRESULT Initialize(_In_ UINT uNumFrames, _In_ UINT uNumTimestamps) = 0;
+
+        virtual void BeginFrame(_In_ UINT uFrame) = 0;
+        virtual void WriteTimestamp(_In_ UINT uFrame, _In_ UINT uTimestamp) = 0;
+        virtual void EndFrame(_In_ UINT uFrame) = 0;
+
+        virtual HRESULT GetFrequency(_In_ UINT uFrame, _Out_ UINT64& uOutFrequency, _Out_ BOOL& bOutDisjoint) = 0;
+        virtual HRESULT GetTimestamp(_In_ UINT uFrame, _In_ UINT uTimestamp, _Out_ UINT64& uOutTimestamp) = 0;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,233 @@
+#include "Profiler/MockGpuTimerBackend.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MockGpuTimerBackend::MockGpuTimerBackend
+
+      Summary:  Constructor
+
+      Args:     UINT uLatency
+                  Number of frames that have to end after a frame
+                  before its results are ready
+                UINT64 uFrequency
+                  Simulated ticks per second
+                UINT64 uTicksPerTimestamp
+                  Ticks the clock advances by at every timestamp
+
+      Modifies: [m_uLatency, m_uFrequency, m_uTicksPerTimestamp,
+                 m_uClock, m_uNumFramesEnded, m_uNumTimestamps,
+                 m_auTimestamps, m_auReadyAt, m_abDisjoint, m_bDisjoint,
+                 m_uNumPolls, m_uNumPollsNotReady].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    MockGpuTimerBackend::MockGpuTimerBackend(_In_ UINT uLatency, _In_ UINT64 uFrequency, _In_ UINT64 uTicksPerTimestamp)
+        : m_uLatency(uLatency)
+        , m_uFrequency(uFrequency)
+        , m_uTicksPerTimestamp(uTicksPerTimestamp)
+        , m_uClock(0u)
+        , m_uNumFramesEnded(0u)
+        , m_uNumTimestamps(0u)
+        , m_auTimestamps()
+        , m_auReadyAt()
+        , m_abDisjoint()
+        , m_bDisjoint(FALSE)
+        , m_uNumPolls(0u)
+        , m_uNumPollsNotReady(0u)
+    {
+        // empty
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MockGpuTimerBackend::Initialize
+
+      Summary:  Allocates the simulated queries
+
+      Args:     UINT uNumFrames
+                  Number of frames in flight
+                UINT uNumTimestamps
+                  Number of timestamps of a frame
+
+      Modifies: [m_uNumTimestamps, m_auTimestamps, m_auReadyAt,
+                 m_abDisjoint].
+
+      Returns:  HRESULT
+                  Always S_OK
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT MockGpuTimerBackend::Initialize(_In_ UINT uNumFrames, _In_ UINT uNumTimestamps)
+    {
+        m_uNumTimestamps = uNumTimestamps;
+        m_auTimestamps.assign(static_cast<size_t>(uNumFrames) * uNumTimestamps, 0u);
+        m_auReadyAt.assign(uNumFrames, UINT64_MAX);
+        m_abDisjoint.assign(uNumFrames, FALSE);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MockGpuTimerBackend::BeginFrame
+
+      Summary:  Marks a frame as not ready
+
+      Args:     UINT uFrame
+                  Index of the frame in flight
+
+      Modifies: [m_auReadyAt, m_abDisjoint].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void MockGpuTimerBackend::BeginFrame(_In_ UINT uFrame)
+    {
+        m_auReadyAt[uFrame] = UINT64_MAX;
+        m_abDisjoint[uFrame] = m_bDisjoint;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MockGpuTimerBackend::WriteTimestamp
+
+      Summary:  Advances the simulated clock and stores it
+
+      Args:     UINT uFrame
+                  Index of the frame in flight
+                UINT uTimestamp
+                  Index of the timestamp
+
+      Modifies: [m_uClock, m_auTimestamps].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void MockGpuTimerBackend::WriteTimestamp(_In_ UINT uFrame, _In_ UINT uTimestamp)
+    {
+        m_uClock += m_uTicksPerTimestamp;
+        m_auTimestamps[uFrame * m_uNumTimestamps + uTimestamp] = m_uClock;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MockGpuTimerBackend::EndFrame
+
+      Summary:  Schedules the results of a frame to become ready after
+                uLatency more frames have ended
+
+      Args:     UINT uFrame
+                  Index of the frame in flight
+
+      Modifies: [m_uNumFramesEnded, m_auReadyAt].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void MockGpuTimerBackend::EndFrame(_In_ UINT uFrame)
+    {
+        ++m_uNumFramesEnded;
+        m_auReadyAt[uFrame] = m_uNumFramesEnded + m_uLatency;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MockGpuTimerBackend::GetFrequency
+
+      Summary:  Polls the frequency of a frame
+
+      Args:     UINT uFrame
+                  Index of the frame in flight
+                UINT64& uOutFrequency
+                  Simulated ticks per second
+                BOOL& bOutDisjoint
+                  Whether the frame was set to be disjoint
+
+      Modifies: [m_uNumPolls, m_uNumPollsNotReady].
+
+      Returns:  HRESULT
+                  S_OK when ready, S_FALSE otherwise
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT MockGpuTimerBackend::GetFrequency(_In_ UINT uFrame, _Out_ UINT64& uOutFrequency, _Out_ BOOL& bOutDisjoint)
+    {
+        uOutFrequency = m_uFrequency;
+        bOutDisjoint = m_abDisjoint[uFrame];
+
+        return isReady(uFrame) ? S_OK : S_FALSE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MockGpuTimerBackend::GetTimestamp
+
+      Summary:  Polls a timestamp of a frame
+
+      Args:     UINT uFrame
+                  Index of the frame in flight
+                UINT uTimestamp
+                  Index of the timestamp
+                UINT64& uOutTimestamp
+                  Simulated clock when the timestamp was written
+
+      Modifies: [m_uNumPolls, m_uNumPollsNotReady].
+
+      Returns:  HRESULT
+                  S_OK when ready, S_FALSE otherwise
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT MockGpuTimerBackend::GetTimestamp(_In_ UINT uFrame, _In_ UINT uTimestamp, _Out_ UINT64& uOutTimestamp)
+    {
+        uOutTimestamp = m_auTimestamps[uFrame * m_uNumTimestamps + uTimestamp];
+
+        return isReady(uFrame) ? S_OK : S_FALSE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MockGpuTimerBackend::SetDisjoint
+
+      Summary:  Reports the frames begun from now on as disjoint
+
+      Args:     BOOL bDisjoint
+                  Whether the frames are disjoint
+
+      Modifies: [m_bDisjoint].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void MockGpuTimerBackend::SetDisjoint(_In_ BOOL bDisjoint)
+    {
+        m_bDisjoint = bDisjoint;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MockGpuTimerBackend::GetNumPolls
+
+      Summary:  Returns the number of polls
+
+      Returns:  UINT
+                  Number of polls
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT MockGpuTimerBackend::GetNumPolls() const
+    {
+        return m_uNumPolls;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MockGpuTimerBackend::GetNumPollsNotReady
+
+      Summary:  Returns the number of polls of results that were not
+                ready
+
+      Returns:  UINT
+                  Number of polls that were not ready
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT MockGpuTimerBackend::GetNumPollsNotReady() const
+    {
+        return m_uNumPollsNotReady;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MockGpuTimerBackend::isReady
+
+      Summary:  Counts a poll and returns whether the results of a
+                frame are ready
+
+      Args:     UINT uFrame
+                  Index of the frame in flight
+
+      Modifies: [m_uNumPolls, m_uNumPollsNotReady].
+
+      Returns:  BOOL
+                  TRUE if ready
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL MockGpuTimerBackend::isReady(_In_ UINT uFrame)
+    {
+        ++m_uNumPolls;
+        if (m_uNumFramesEnded < m_auReadyAt[uFrame])
+        {
+            ++m_uNumPollsNotReady;
+            return FALSE;
+        }
+
+        return TRUE;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+/*+===================================================================
+  File:      MOCKGPUTIMERBACKEND.H
+
+  Summary:   MockGpuTimerBackend header file contains declarations of
+             the MockGpuTimerBackend class that simulates GPU queries
+             with a fixed latency, so the GPU profiler can be checked
+             without a device.
+
+  Classes: MockGpuTimerBackend
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Profiler/GpuTimerBackend.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    MockGpuTimerBackend
+
+      Summary:  GPU timer backend whose results become ready uLatency
+                frames after the frame that wrote them ended. Every
+                timestamp advances a simulated clock by a fixed number
+                of ticks. Polls are counted, so a test can check that
+                the profiler never asks for a result too early
+
+      Methods:  Initialize
+                  Allocates the simulated queries
+                BeginFrame
+                  Marks a frame as not ready
+                WriteTimestamp
+                  Advances the clock and stores it
+                EndFrame
+                  Schedules the results of a frame
+                GetFrequency
+                  Polls the frequency of a frame
+                GetTimestamp
+                  Polls a timestamp of a frame
+                SetDisjoint
+                  Reports the following frames as disjoint
+                GetNumPolls
+                  Returns the number of polls
+                GetNumPollsNotReady
+                  Returns the number of polls of results that were
+                  not ready
+                MockGpuTimerBackend
+                  Constructor.
+                ~MockGpuTimerBackend
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class MockGpuTimerBackend final : public GpuTimerBackend
+    {
+    public:
+        MockGpuTimerBackend(_In_ UINT uLatency, _In_ UINT64 uFrequency, _In_ UINT64 uTicksPerTimestamp);
+        MockGpuTimerBackend(const MockGpuTimerBackend& other) = delete;
+        MockGpuTimerBackend(MockGpuTimerBackend&& other) = delete;
+        MockGpuTimerBackend& operator=(const MockGpuTimerBackend& other) = delete;
+        MockGpuTimerBackend& operator=(MockGpuTimerBackend&& other) = delete;
+        ~MockGpuTimerBackend() = default;
+
+        HRESULT Initialize(_In_ UINT uNumFrames, _In_ UINT uNumTimestamps) override;
+
+        void BeginFrame(_In_ UINT uFrame) override;
+        void WriteTimestamp(_In_ UINT uFrame, _In_ UINT uTimestamp) override;
+        void EndFrame(_In_ UINT uFrame) override;
+
+        HRESULT GetFrequency(_In_ UINT uFrame, _Out_ UINT64& uOutFrequency, _Out_ BOOL& bOutDisjoint) override;
+        HRESULT GetTimestamp(_In_ UINT uFrame, _In_ UINT uTimestamp, _Out_ UINT64& uOutTimestamp) override;
+
+        void SetDisjoint(_In_ BOOL bDisjoint);
+
+        UINT GetNumPolls() const;
+        UINT GetNumPollsNotReady() const;
+
+    private:
+        BOOL isReady(_In_ UINT uFrame);
+
+    private:
+        UINT m_uLatency;
+        UINT64 m_uFrequency;
+        UINT64 m_uTicksPerTimestamp;
+        UINT64 m_uClock;
+        UINT64 m_uNumFramesEnded;
+        UINT m_uNumTimestamps;
+        std::vector<UINT64> m_auTimestamps;
+        std::vector<UINT64> m_auReadyAt;
+        std::vector<BOOL> m_abDisjoint;
+        BOOL m_bDisjoint;
+        UINT m_uNumPolls;
+        UINT m_uNumPollsNotReady;
+    };
+}
\ No newline at end of file
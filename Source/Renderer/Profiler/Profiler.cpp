@@ -0,0 +1,423 @@
+#include "Profiler/Profiler.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <string_view>
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   ProfilerRing
+
+      Summary:  Single producer, single consumer ring of events. Only
+                the owning thread advances uWriteIndex and only the
+                thread that ends frames advances uReadIndex
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct ProfilerRing
+    {
+        std::array<ProfilerEvent, Profiler::RING_CAPACITY> aEvents;
+        std::atomic<UINT64> uWriteIndex;
+        std::atomic<UINT64> uReadIndex;
+        std::atomic<UINT> uNumDropped;
+        DWORD dwThreadId;
+    };
+
+    std::vector<std::unique_ptr<ProfilerRing>> Profiler::sm_aRings;
+    std::mutex Profiler::sm_ringsMutex;
+    std::deque<ProfilerFrame> Profiler::sm_aFrames;
+    std::vector<ProfilerGpuEvent> Profiler::sm_aPendingGpuEvents;
+    UINT64 Profiler::sm_uFrameIndex = 0u;
+    LONGLONG Profiler::sm_llFrameStart = Profiler::GetTimestamp();
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Profiler::RecordEvent
+
+      Summary:  Writes a timed scope to the ring of the calling thread,
+                drops it if the ring is full
+
+      Args:     PCSTR pszName
+                  Name of the scope, must outlive the profiler
+                LONGLONG llStart
+                  Performance counter at the start of the scope
+                LONGLONG llEnd
+                  Performance counter at the end of the scope
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Profiler::RecordEvent(_In_ PCSTR pszName, _In_ LONGLONG llStart, _In_ LONGLONG llEnd)
+    {
+        ProfilerRing* pRing = getThreadRing();
+
+        const UINT64 uWriteIndex = pRing->uWriteIndex.load(std::memory_order_relaxed);
+        if (uWriteIndex - pRing->uReadIndex.load(std::memory_order_acquire) >= RING_CAPACITY)
+        {
+            pRing->uNumDropped.fetch_add(1u, std::memory_order_relaxed);
+            return;
+        }
+
+        pRing->aEvents[uWriteIndex % RING_CAPACITY] = ProfilerEvent{ .pszName = pszName, .llStart = llStart, .llEnd = llEnd, .dwThreadId = pRing->dwThreadId };
+        pRing->uWriteIndex.store(uWriteIndex + 1u, std::memory_order_release);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Profiler::RecordGpuEvent
+
+      Summary:  Adds a GPU timed scope to the current frame. Must be
+                called on the thread that ends frames
+
+      Args:     const ProfilerGpuEvent& event
+                  GPU timed scope, its name must outlive the profiler
+
+      Modifies: [sm_aPendingGpuEvents].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Profiler::RecordGpuEvent(_In_ const ProfilerGpuEvent& event)
+    {
+        sm_aPendingGpuEvents.push_back(event);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Profiler::EndFrame
+
+      Summary:  Reads the rings of every thread, sums the CPU and GPU
+                events up per scope name and keeps them as the current
+                frame. The next frame starts now
+
+      Modifies: [sm_aFrames, sm_aPendingGpuEvents, sm_uFrameIndex,
+                 sm_llFrameStart].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Profiler::EndFrame()
+    {
+        const LONGLONG llFrameEnd = GetTimestamp();
+
+        ProfilerFrame frame =
+        {
+            .uFrameIndex = sm_uFrameIndex++,
+            .llStart = sm_llFrameStart,
+            .llEnd = llFrameEnd,
+            .dwThreadId = GetCurrentThreadId(),
+            .aEvents = std::vector<ProfilerEvent>(),
+            .aScopes = std::vector<ProfilerScopeStats>(),
+            .aGpuEvents = std::move(sm_aPendingGpuEvents),
+            .aGpuScopes = std::vector<ProfilerScopeStats>()
+        };
+        sm_llFrameStart = llFrameEnd;
+        sm_aPendingGpuEvents.clear();
+
+        {
+            std::lock_guard<std::mutex> lock(sm_ringsMutex);
+
+            for (const std::unique_ptr<ProfilerRing>& ring : sm_aRings)
+            {
+                UINT64 uReadIndex = ring->uReadIndex.load(std::memory_order_relaxed);
+                const UINT64 uWriteIndex = ring->uWriteIndex.load(std::memory_order_acquire);
+                for (; uReadIndex < uWriteIndex; ++uReadIndex)
+                {
+                    frame.aEvents.push_back(ring->aEvents[uReadIndex % RING_CAPACITY]);
+                }
+                ring->uReadIndex.store(uReadIndex, std::memory_order_release);
+            }
+        }
+
+        for (const ProfilerEvent& event : frame.aEvents)
+        {
+            addToScopes(frame.aScopes, event.pszName, TicksToMilliseconds(event.llEnd - event.llStart));
+        }
+
+        for (const ProfilerGpuEvent& event : frame.aGpuEvents)
+        {
+            addToScopes(frame.aGpuScopes, event.pszName, event.durationMs);
+        }
+
+        sm_aFrames.push_back(std::move(frame));
+        while (sm_aFrames.size() > MAX_FRAMES)
+        {
+            sm_aFrames.pop_front();
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Profiler::Reset
+
+      Summary:  Removes the kept frames, the events waiting in the
+                rings and the pending GPU events, and restarts the
+                dropped event count and the current frame. Must be
+                called on the thread that ends frames
+
+      Modifies: [sm_aRings, sm_aFrames, sm_aPendingGpuEvents,
+                 sm_llFrameStart].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Profiler::Reset()
+    {
+        {
+            std::lock_guard<std::mutex> lock(sm_ringsMutex);
+
+            for (const std::unique_ptr<ProfilerRing>& ring : sm_aRings)
+            {
+                ring->uReadIndex.store(ring->uWriteIndex.load(std::memory_order_acquire), std::memory_order_release);
+                ring->uNumDropped.store(0u, std::memory_order_relaxed);
+            }
+        }
+
+        sm_aFrames.clear();
+        sm_aPendingGpuEvents.clear();
+        sm_llFrameStart = GetTimestamp();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Profiler::GetFrames
+
+      Summary:  Returns the kept frames, oldest first
+
+      Returns:  const std::deque<ProfilerFrame>&
+                  Kept frames
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::deque<ProfilerFrame>& Profiler::GetFrames()
+    {
+        return sm_aFrames;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Profiler::GetNumDroppedEvents
+
+      Summary:  Returns the number of events lost to full rings
+
+      Returns:  UINT
+                  Number of dropped events
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Profiler::GetNumDroppedEvents()
+    {
+        std::lock_guard<std::mutex> lock(sm_ringsMutex);
+
+        UINT uNumDropped = 0u;
+        for (const std::unique_ptr<ProfilerRing>& ring : sm_aRings)
+        {
+            uNumDropped += ring->uNumDropped.load(std::memory_order_relaxed);
+        }
+
+        return uNumDropped;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Profiler::ExportChromeTrace
+
+      Summary:  Writes the kept frames in the Trace Event Format read by
+                chrome://tracing and Perfetto. Every frame is a scope on
+                the thread that ended it, times are microseconds since
+                the start of the oldest frame. GPU events go to a
+                separate "GPU" track, placed relative to the start of
+                the frame that collected them since GPU and CPU clocks
+                are not correlated. Times are converted in double
+                precision, a float loses microseconds minutes into a
+                capture
+
+      Args:     const std::filesystem::path& filePath
+                  Path of the JSON file
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Profiler::ExportChromeTrace(_In_ const std::filesystem::path& filePath)
+    {
+        const LONGLONG llOrigin = sm_aFrames.empty() ? 0ll : sm_aFrames.front().llStart;
+        const DOUBLE ticksPerUs = static_cast<DOUBLE>(getFrequency()) / 1000000.0;
+
+        std::string szJson = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        szJson += "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"GPU\"}}";
+        auto writeEvent = [&szJson, llOrigin, ticksPerUs](_In_ PCSTR pszName, _In_ PCSTR pszCategory, _In_ LONGLONG llStart, _In_ LONGLONG llEnd, _In_ DWORD dwThreadId)
+        {
+            std::string szName;
+            for (PCSTR pszChar = pszName; *pszChar != '\0'; ++pszChar)
+            {
+                if (*pszChar == '"' || *pszChar == '\\')
+                {
+                    szName += '\\';
+                }
+                szName += *pszChar;
+            }
+
+            CHAR szEvent[128];
+            sprintf_s(
+                szEvent,
+                "\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%lu,\"ts\":%.3f,\"dur\":%.3f}",
+                pszCategory,
+                static_cast<unsigned long>(dwThreadId),
+                static_cast<DOUBLE>(llStart - llOrigin) / ticksPerUs,
+                static_cast<DOUBLE>(llEnd - llStart) / ticksPerUs
+            );
+
+            szJson += ",\n{\"name\":\"";
+            szJson += szName;
+            szJson += szEvent;
+        };
+
+        for (const ProfilerFrame& frame : sm_aFrames)
+        {
+            writeEvent("Frame", "frame", frame.llStart, frame.llEnd, frame.dwThreadId);
+            for (const ProfilerEvent& event : frame.aEvents)
+            {
+                writeEvent(event.pszName, "cpu", event.llStart, event.llEnd, event.dwThreadId);
+            }
+            for (const ProfilerGpuEvent& event : frame.aGpuEvents)
+            {
+                const LONGLONG llStart = frame.llStart + static_cast<LONGLONG>(static_cast<DOUBLE>(event.startMs) * 1000.0 * ticksPerUs);
+                writeEvent(event.pszName, "gpu", llStart, llStart + static_cast<LONGLONG>(static_cast<DOUBLE>(event.durationMs) * 1000.0 * ticksPerUs), 0u);
+            }
+        }
+        szJson += "\n]}\n";
+
+        HANDLE hFile = CreateFile(filePath.c_str(), GENERIC_WRITE, 0u, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (hFile == INVALID_HANDLE_VALUE)
+        {
+            return HRESULT_FROM_WIN32(GetLastError());
+        }
+
+        DWORD dwBytesWritten = 0u;
+        BOOL bWritten = WriteFile(hFile, szJson.data(), static_cast<DWORD>(szJson.size()), &dwBytesWritten, nullptr);
+        CloseHandle(hFile);
+
+        if (!bWritten || dwBytesWritten != szJson.size())
+        {
+            return E_FAIL;
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Profiler::GetTimestamp
+
+      Summary:  Returns the current performance counter
+
+      Returns:  LONGLONG
+                  Performance counter ticks
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    LONGLONG Profiler::GetTimestamp()
+    {
+        LARGE_INTEGER counter;
+        QueryPerformanceCounter(&counter);
+
+        return counter.QuadPart;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Profiler::TicksToMilliseconds
+
+      Summary:  Converts performance counter ticks to milliseconds
+
+      Args:     LONGLONG llTicks
+                  Performance counter ticks
+
+      Returns:  FLOAT
+                  Milliseconds
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT Profiler::TicksToMilliseconds(_In_ LONGLONG llTicks)
+    {
+        return static_cast<FLOAT>(static_cast<DOUBLE>(llTicks) * 1000.0 / static_cast<DOUBLE>(getFrequency()));
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Profiler::getFrequency
+
+      Summary:  Returns the performance counter frequency, queried once
+
+      Returns:  LONGLONG
+                  Ticks per second
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    LONGLONG Profiler::getFrequency()
+    {
+        static const LONGLONG s_llFrequency = []()
+        {
+            LARGE_INTEGER frequency;
+            QueryPerformanceFrequency(&frequency);
+
+            return frequency.QuadPart;
+        }();
+
+        return s_llFrequency;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Profiler::getThreadRing
+
+      Summary:  Returns the ring of the calling thread, the first call
+                on a thread creates and registers it. Rings live as
+                long as the profiler, so events of finished threads
+                are still collected
+
+      Modifies: [sm_aRings].
+
+      Returns:  ProfilerRing*
+                  Ring of the calling thread
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ProfilerRing* Profiler::getThreadRing()
+    {
+        thread_local ProfilerRing* s_pRing = nullptr;
+        if (!s_pRing)
+        {
+            std::unique_ptr<ProfilerRing> ring = std::make_unique<ProfilerRing>();
+            ring->uWriteIndex = 0u;
+            ring->uReadIndex = 0u;
+            ring->uNumDropped = 0u;
+            ring->dwThreadId = GetCurrentThreadId();
+            s_pRing = ring.get();
+
+            std::lock_guard<std::mutex> lock(sm_ringsMutex);
+            sm_aRings.push_back(std::move(ring));
+        }
+
+        return s_pRing;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Profiler::addToScopes
+
+      Summary:  Adds a call of a scope to the aggregates of a frame
+
+      Args:     std::vector<ProfilerScopeStats>& aScopes
+                  Aggregates of the frame
+                PCSTR pszName
+                  Name of the scope
+                FLOAT durationMs
+                  Duration of the call
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Profiler::addToScopes(_Inout_ std::vector<ProfilerScopeStats>& aScopes, _In_ PCSTR pszName, _In_ FLOAT durationMs)
+    {
+        auto it = std::find_if(aScopes.begin(), aScopes.end(),
+            [pszName](const ProfilerScopeStats& scope) { return std::string_view(scope.pszName) == pszName; });
+        if (it == aScopes.end())
+        {
+            aScopes.push_back(ProfilerScopeStats{ .pszName = pszName, .uNumCalls = 0u, .totalMs = 0.0f, .maxMs = 0.0f });
+            it = aScopes.end() - 1;
+        }
+
+        ++it->uNumCalls;
+        it->totalMs += durationMs;
+        it->maxMs = durationMs > it->maxMs ? durationMs : it->maxMs;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ProfileScope::ProfileScope
+
+      Summary:  Constructor, starts timing
+
+      Args:     PCSTR pszName
+                  Name of the scope, must outlive the profiler
+
+      Modifies: [m_pszName, m_llStart].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ProfileScope::ProfileScope(_In_ PCSTR pszName)
+        : m_pszName(pszName)
+        , m_llStart(Profiler::GetTimestamp())
+    {
+        // empty
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ProfileScope::~ProfileScope
+
+      Summary:  Destructor, records the timed scope
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ProfileScope::~ProfileScope()
+    {
+        Profiler::RecordEvent(m_pszName, m_llStart, Profiler::GetTimestamp());
+    }
+}
\ No newline at end of file
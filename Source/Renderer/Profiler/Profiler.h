@@ -0,0 +1,200 @@
+/*+===================================================================
+  File:      PROFILER.H
+
+  Summary:   Profiler header file contains declarations of the
+             profiler that times named CPU scopes on every thread,
+             collects GPU pass timings, sums them up per frame and
+             exports them as a Chrome trace.
+
+  Classes: Profiler, ProfileScope
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include <deque>
+#include <mutex>
+
+#if defined(DEBUG) || defined(_DEBUG) || defined(PROFILE)
+#define PROFILER_ENABLED 1
+#else
+#define PROFILER_ENABLED 0
+#endif
+
+#define PROFILER_CONCAT_INNER(a, b) a##b
+#define PROFILER_CONCAT(a, b) PROFILER_CONCAT_INNER(a, b)
+
+#if PROFILER_ENABLED
+#define PROFILE_SCOPE(pszName) library::ProfileScope PROFILER_CONCAT(profileScope, __LINE__)(pszName)
+#define PROFILE_FRAME() library::Profiler::EndFrame()
+#else
+#define PROFILE_SCOPE(pszName) ((void)0)
+#define PROFILE_FRAME() ((void)0)
+#endif
+
+namespace library
+{
+    struct ProfilerRing;
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   ProfilerEvent
+
+      Summary:  Timed scope. pszName must outlive the profiler, start
+                and end are performance counter ticks
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct ProfilerEvent
+    {
+        PCSTR pszName;
+        LONGLONG llStart;
+        LONGLONG llEnd;
+        DWORD dwThreadId;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   ProfilerGpuEvent
+
+      Summary:  GPU timed scope. Times are milliseconds since the start
+                of the GPU frame it was measured in
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct ProfilerGpuEvent
+    {
+        PCSTR pszName;
+        FLOAT startMs;
+        FLOAT durationMs;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   ProfilerScopeStats
+
+      Summary:  Calls and time of one scope name in a frame, summed up
+                over every thread
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct ProfilerScopeStats
+    {
+        PCSTR pszName;
+        UINT uNumCalls;
+        FLOAT totalMs;
+        FLOAT maxMs;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   ProfilerFrame
+
+      Summary:  Events and per-scope aggregates of one frame. Events
+                belong to the frame in which they were collected, so
+                GPU events lag the CPU frame they were recorded in by
+                the latency of the GPU queries
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct ProfilerFrame
+    {
+        UINT64 uFrameIndex;
+        LONGLONG llStart;
+        LONGLONG llEnd;
+        DWORD dwThreadId;
+        std::vector<ProfilerEvent> aEvents;
+        std::vector<ProfilerScopeStats> aScopes;
+        std::vector<ProfilerGpuEvent> aGpuEvents;
+        std::vector<ProfilerScopeStats> aGpuScopes;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    Profiler
+
+      Summary:  Collects the scopes timed by ProfileScope. Every thread
+                writes to its own ring buffer without locking, the
+                thread that ends a frame reads the rings and keeps the
+                last MAX_FRAMES frames. Events of a full ring are
+                dropped and counted. Use the PROFILE_SCOPE and
+                PROFILE_FRAME macros, they compile out unless DEBUG,
+                _DEBUG or PROFILE is defined
+
+      Methods:  RecordEvent
+                  Writes a timed scope to the ring of the calling
+                  thread
+                RecordGpuEvent
+                  Adds a GPU timed scope to the current frame
+                EndFrame
+                  Collects the events of the frame and starts the
+                  next one
+                Reset
+                  Removes the kept frames and the events not collected
+                  yet
+                GetFrames
+                  Returns the kept frames, oldest first
+                GetNumDroppedEvents
+                  Returns the number of events lost to full rings
+                ExportChromeTrace
+                  Writes the kept frames as Chrome trace JSON
+                GetTimestamp
+                  Returns the current performance counter
+                TicksToMilliseconds
+                  Converts performance counter ticks to milliseconds
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class Profiler
+    {
+    public:
+        static constexpr UINT RING_CAPACITY = 4096u;
+        static constexpr UINT MAX_FRAMES = 300u;
+
+        Profiler() = delete;
+        Profiler(const Profiler& other) = delete;
+        Profiler(Profiler&& other) = delete;
+        Profiler& operator=(const Profiler& other) = delete;
+        Profiler& operator=(Profiler&& other) = delete;
+        ~Profiler() = delete;
+
+        static void RecordEvent(_In_ PCSTR pszName, _In_ LONGLONG llStart, _In_ LONGLONG llEnd);
+        static void RecordGpuEvent(_In_ const ProfilerGpuEvent& event);
+        static void EndFrame();
+        static void Reset();
+
+        static const std::deque<ProfilerFrame>& GetFrames();
+        static UINT GetNumDroppedEvents();
+
+        static HRESULT ExportChromeTrace(_In_ const std::filesystem::path& filePath);
+
+        static LONGLONG GetTimestamp();
+        static FLOAT TicksToMilliseconds(_In_ LONGLONG llTicks);
+
+    private:
+        static LONGLONG getFrequency();
+        static ProfilerRing* getThreadRing();
+        static void addToScopes(_Inout_ std::vector<ProfilerScopeStats>& aScopes, _In_ PCSTR pszName, _In_ FLOAT durationMs);
+
+    private:
+        static std::vector<std::unique_ptr<ProfilerRing>> sm_aRings;
+        static std::mutex sm_ringsMutex;
+        static std::deque<ProfilerFrame> sm_aFrames;
+        static std::vector<ProfilerGpuEvent> sm_aPendingGpuEvents;
+        static UINT64 sm_uFrameIndex;
+        static LONGLONG sm_llFrameStart;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    ProfileScope
+
+      Summary:  Times the enclosing scope and records it to the
+                profiler when it is left
+
+      Methods:  ProfileScope
+                  Constructor.
+                ~ProfileScope
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class ProfileScope final
+    {
+    public:
+        ProfileScope(_In_ PCSTR pszName);
+        ProfileScope(const ProfileScope& other) = delete;
+        ProfileScope(ProfileScope&& other) = delete;
+        ProfileScope& operator=(const ProfileScope& other) = delete;
+        ProfileScope& operator=(ProfileScope&& other) = delete;
+        ~ProfileScope();
+
+    private:
+        PCSTR m_pszName;
+        LONGLONG m_llStart;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,296 @@
+#include "Renderer/AssetLoader.h"
+
+namespace library
+{
+    UINT AssetLoader::sm_uDefaultNumThreads = 0u;
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AssetLoader::AssetLoader
+
+      Summary:  Constructor, starts the default number of worker
+                threads
+
+      Modifies: [m_aWorkers, m_tasks, m_mutex, m_condition,
+                 m_bStopping].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    AssetLoader::AssetLoader()
+        : AssetLoader(GetDefaultNumThreads())
+    {
+        // empty
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AssetLoader::AssetLoader
+
+      Summary:  Constructor, starts the worker threads
+
+      Args:     UINT uNumThreads
+                  Number of worker threads, at least one is started
+
+      Modifies: [m_aWorkers, m_tasks, m_mutex, m_condition,
+                 m_bStopping].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    AssetLoader::AssetLoader(_In_ UINT uNumThreads)
+        : m_aWorkers()
+        , m_tasks()
+        , m_mutex()
+        , m_condition()
+        , m_bStopping(FALSE)
+    {
+        uNumThreads = uNumThreads > 0u ? uNumThreads : 1u;
+
+        m_aWorkers.reserve(uNumThreads);
+        for (UINT i = 0u; i < uNumThreads; ++i)
+        {
+            m_aWorkers.emplace_back(&AssetLoader::workerMain, this);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AssetLoader::~AssetLoader
+
+      Summary:  Destructor, lets the workers drain the queue and joins
+                them
+
+      Modifies: [m_aWorkers, m_bStopping].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    AssetLoader::~AssetLoader()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_bStopping = TRUE;
+        }
+        m_condition.notify_all();
+
+        for (std::thread& worker : m_aWorkers)
+        {
+            worker.join();
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AssetLoader::Submit
+
+      Summary:  Queues a task to run on one of the worker threads
+
+      Args:     std::function<HRESULT()> task
+                  Task to run
+
+      Modifies: [m_tasks].
+
+      Returns:  std::future<HRESULT>
+                  Result of the task
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    std::future<HRESULT> AssetLoader::Submit(_In_ std::function<HRESULT()> task)
+    {
+        std::packaged_task<HRESULT()> packagedTask(std::move(task));
+        std::future<HRESULT> future = packagedTask.get_future();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.push_back(std::move(packagedTask));
+        }
+        m_condition.notify_one();
+
+        return future;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AssetLoader::WaitAll
+
+      Summary:  Waits for every given future, even after a failure,
+                so no task is still running when the caller continues
+
+      Args:     std::vector<std::future<HRESULT>>& aFutures
+                  Futures to wait for, cleared on return
+
+      Returns:  HRESULT
+                  First failed status code, S_OK if every task
+                  succeeded
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT AssetLoader::WaitAll(_Inout_ std::vector<std::future<HRESULT>>& aFutures)
+    {
+        HRESULT hr = S_OK;
+
+        for (std::future<HRESULT>& future : aFutures)
+        {
+            HRESULT taskHr = future.get();
+            if (SUCCEEDED(hr) && FAILED(taskHr))
+            {
+                hr = taskHr;
+            }
+        }
+
+        aFutures.clear();
+
+        return hr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AssetLoader::GetPartition
+
+      Summary:  Returns the range of items of a partition. Partitions
+                are contiguous, in item order, and differ in size by
+                at most one item
+
+      Args:     UINT uNumItems
+                  Number of items
+                UINT uNumPartitions
+                  Number of partitions
+                UINT uPartition
+                  Index of the partition
+                UINT& uOutBegin
+                  First item of the partition
+                UINT& uOutEnd
+                  One past the last item of the partition
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void AssetLoader::GetPartition(_In_ UINT uNumItems, _In_ UINT uNumPartitions, _In_ UINT uPartition, _Out_ UINT& uOutBegin, _Out_ UINT& uOutEnd)
+    {
+        assert(uPartition < uNumPartitions);
+
+        uOutBegin = static_cast<UINT>(static_cast<UINT64>(uNumItems) * uPartition / uNumPartitions);
+        uOutEnd = static_cast<UINT>(static_cast<UINT64>(uNumItems) * (uPartition + 1u) / uNumPartitions);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AssetLoader::ParallelFor
+
+      Summary:  Runs a function over contiguous partitions of items,
+                the first partition on the calling thread and the
+                others on the worker threads, and waits for all of them
+
+      Args:     AssetLoader* pWorkers
+                  Worker threads, null if there is only one partition
+                UINT uNumItems
+                  Number of items
+                UINT uNumPartitions
+                  Number of partitions, at most one more than the
+                  number of worker threads
+                const std::function<void(UINT, UINT)>& run
+                  Runs the items [uBegin, uEnd). Called concurrently,
+                  partitions must only write state they own
+
+      Returns:  HRESULT
+                  Status code, the first failure of a worker
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT AssetLoader::ParallelFor(
+        _In_opt_ AssetLoader* pWorkers,
+        _In_ UINT uNumItems,
+        _In_ UINT uNumPartitions,
+        _In_ const std::function<void(UINT, UINT)>& run
+    )
+    {
+        assert(uNumPartitions >= 1u && (uNumPartitions == 1u || (pWorkers && uNumPartitions <= pWorkers->GetNumThreads() + 1u)));
+
+        std::vector<std::future<HRESULT>> aFutures;
+        aFutures.reserve(uNumPartitions);
+        for (UINT i = 1u; i < uNumPartitions; ++i)
+        {
+            aFutures.push_back(pWorkers->Submit(
+                [&run, uNumItems, uNumPartitions, i]()
+                {
+                    UINT uBegin = 0u;
+                    UINT uEnd = 0u;
+                    GetPartition(uNumItems, uNumPartitions, i, uBegin, uEnd);
+                    run(uBegin, uEnd);
+
+                    return S_OK;
+                }
+            ));
+        }
+
+        UINT uBegin = 0u;
+        UINT uEnd = 0u;
+        GetPartition(uNumItems, uNumPartitions, 0u, uBegin, uEnd);
+        run(uBegin, uEnd);
+
+        return AssetLoader::WaitAll(aFutures);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AssetLoader::GetNumThreads
+
+      Summary:  Returns the number of worker threads
+
+      Returns:  UINT
+                  Number of worker threads
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT AssetLoader::GetNumThreads() const
+    {
+        return static_cast<UINT>(m_aWorkers.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AssetLoader::GetDefaultNumThreads
+
+      Summary:  Returns the number of threads new loaders start
+
+      Returns:  UINT
+                  Overridden number of threads, or the number of
+                  hardware threads
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT AssetLoader::GetDefaultNumThreads()
+    {
+        if (sm_uDefaultNumThreads > 0u)
+        {
+            return sm_uDefaultNumThreads;
+        }
+
+        UINT uNumHardwareThreads = std::thread::hardware_concurrency();
+
+        return uNumHardwareThreads > 0u ? uNumHardwareThreads : 1u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AssetLoader::SetDefaultNumThreads
+
+      Summary:  Overrides the number of threads new loaders start
+
+      Args:     UINT uNumThreads
+                  Number of threads, 0 uses one per hardware thread
+
+      Modifies: [sm_uDefaultNumThreads].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void AssetLoader::SetDefaultNumThreads(_In_ UINT uNumThreads)
+    {
+        sm_uDefaultNumThreads = uNumThreads;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AssetLoader::workerMain
+
+      Summary:  Runs queued tasks until the loader is destroyed. COM
+                is initialized on every worker for WIC decoding
+
+      Modifies: [m_tasks].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void AssetLoader::workerMain()
+    {
+        HRESULT hrCom = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+
+        for (;;)
+        {
+            std::packaged_task<HRESULT()> task;
+
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condition.wait(lock, [this] { return m_bStopping || !m_tasks.empty(); });
+
+                if (m_tasks.empty())
+                {
+                    break;
+                }
+
+                task = std::move(m_tasks.front());
+                m_tasks.pop_front();
+            }
+
+            task();
+        }
+
+        if (SUCCEEDED(hrCom))
+        {
+            CoUninitialize();
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+/*+===================================================================
+  File:      ASSETLOADER.H
+
+  Summary:   AssetLoader header file contains declarations of the
+             AssetLoader class, a pool of worker threads that run
+             the CPU side of asset loading (file parsing, image
+             decoding and shader compilation) in parallel.
+
+  Classes: AssetLoader
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    AssetLoader
+
+      Summary:  Runs loading tasks on worker threads and hands back a
+                future for each of them. Tasks must not touch the
+                immediate context, GPU work that needs it is left to
+                the thread that owns the device
+
+      Methods:  Submit
+                  Queues a task and returns its future
+                WaitAll
+                  Waits for the given futures and returns the first
+                  failure
+                GetPartition
+                  Returns the range of items of a partition
+                ParallelFor
+                  Runs a function over partitions of items on the
+                  calling thread and worker threads
+                GetNumThreads
+                  Returns the number of worker threads
+                GetDefaultNumThreads
+                  Returns the number of threads new loaders start
+                SetDefaultNumThreads
+                  Overrides the number of threads new loaders start,
+                  0 uses one per hardware thread
+                AssetLoader
+                  Constructor.
+                ~AssetLoader
+                  Destructor, finishes queued tasks and joins the
+                  worker threads.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class AssetLoader final
+    {
+    public:
+        AssetLoader();
+        AssetLoader(_In_ UINT uNumThreads);
+        AssetLoader(const AssetLoader& other) = delete;
+        AssetLoader(AssetLoader&& other) = delete;
+        AssetLoader& operator=(const AssetLoader& other) = delete;
+        AssetLoader& operator=(AssetLoader&& other) = delete;
+        ~AssetLoader();
+
+        std::future<HRESULT> Submit(_In_ std::function<HRESULT()> task);
+        static HRESULT WaitAll(_Inout_ std::vector<std::future<HRESULT>>& aFutures);
+
+        static void GetPartition(_In_ UINT uNumItems, _In_ UINT uNumPartitions, _In_ UINT uPartition, _Out_ UINT& uOutBegin, _Out_ UINT& uOutEnd);
+        static HRESULT ParallelFor(
+            _In_opt_ AssetLoader* pWorkers,
+            _In_ UINT uNumItems,
+            _In_ UINT uNumPartitions,
+            _In_ const std::function<void(UINT, UINT)>& run
+        );
+
+        UINT GetNumThreads() const;
+
+        static UINT GetDefaultNumThreads();
+        static void SetDefaultNumThreads(_In_ UINT uNumThreads);
+
+    private:
+        void workerMain();
+
+    private:
+        static UINT sm_uDefaultNumThreads;
+
+    private:
+        std::vector<std::thread> m_aWorkers;
+        std::deque<std::packaged_task<HRESULT()>> m_tasks;
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        BOOL m_bStopping;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,126 @@
+#include "Renderer/CommandRecorder.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandRecorder::CommandRecorder
+
+      Summary:  Constructor, starts one worker thread for every
+                context but the first, which is recorded on the
+                calling thread
+
+      Args:     UINT uNumContexts
+                  Maximum number of partitions, at least one
+
+      Modifies: [m_uNumContexts, m_uNumRecorded, m_workers].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    CommandRecorder::CommandRecorder(_In_ UINT uNumContexts)
+        : m_uNumContexts(uNumContexts > 0u ? uNumContexts : 1u)
+        , m_uNumRecorded(0u)
+        , m_workers(m_uNumContexts > 1u ? std::make_unique<AssetLoader>(m_uNumContexts - 1u) : nullptr)
+    {
+        // empty
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandRecorder::Record
+
+      Summary:  Splits the items into contiguous partitions of at least
+                MIN_ITEMS_PER_CONTEXT items and records them in
+                parallel. Waits until every partition is recorded
+
+      Args:     UINT uNumItems
+                  Number of items to record
+                const RecordFunction& record
+                  Records the items [uBegin, uEnd) to the given
+                  context. Called concurrently, it must only read
+                  shared state
+
+      Modifies: [m_uNumRecorded].
+
+      Returns:  HRESULT
+                  Status code of the first partition that failed
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT CommandRecorder::Record(_In_ UINT uNumItems, _In_ const RecordFunction& record)
+    {
+        // Round down, so no partition is smaller than the minimum unless all items fit in one
+        UINT uNumPartitions = uNumItems / MIN_ITEMS_PER_CONTEXT;
+        uNumPartitions = uNumPartitions > 0u ? uNumPartitions : (uNumItems > 0u ? 1u : 0u);
+        uNumPartitions = uNumPartitions < m_uNumContexts ? uNumPartitions : m_uNumContexts;
+        m_uNumRecorded = uNumPartitions;
+
+        auto recordPartition = [this, uNumItems, uNumPartitions, &record](_In_ UINT uPartition)
+        {
+            PROFILE_SCOPE("CommandRecorder::Record");
+
+            UINT uBegin = 0u;
+            UINT uEnd = 0u;
+            AssetLoader::GetPartition(uNumItems, uNumPartitions, uPartition, uBegin, uEnd);
+
+            record(beginRecording(uPartition, uBegin, uEnd), uBegin, uEnd);
+
+            return endRecording(uPartition);
+        };
+
+        std::vector<std::future<HRESULT>> aFutures;
+        aFutures.reserve(uNumPartitions);
+        for (UINT i = 1u; i < uNumPartitions; ++i)
+        {
+            aFutures.push_back(m_workers->Submit([&recordPartition, i]() { return recordPartition(i); }));
+        }
+
+        HRESULT hr = uNumPartitions > 0u ? recordPartition(0u) : S_OK;
+
+        HRESULT workersHr = AssetLoader::WaitAll(aFutures);
+
+        return FAILED(hr) ? hr : workersHr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandRecorder::Submit
+
+      Summary:  Plays the recordings of the last Record back in
+                partition order
+
+      Args:     RenderContext* pImmediateContext
+                  The immediate context to play the recordings on
+
+      Modifies: [m_uNumRecorded].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CommandRecorder::Submit(_In_opt_ RenderContext* pImmediateContext)
+    {
+        for (UINT i = 0u; i < m_uNumRecorded; ++i)
+        {
+            submitRecording(pImmediateContext, i);
+        }
+
+        m_uNumRecorded = 0u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandRecorder::GetNumContexts
+
+      Summary:  Returns the maximum number of partitions
+
+      Returns:  UINT
+                  Number of contexts
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT CommandRecorder::GetNumContexts() const
+    {
+        return m_uNumContexts;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandRecorder::GetNumRecorded
+
+      Summary:  Returns the number of partitions recorded by the last
+                Record that are not submitted yet
+
+      Returns:  UINT
+                  Number of recorded partitions
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT CommandRecorder::GetNumRecorded() const
+    {
+        return m_uNumRecorded;
+    }
+}
\ No newline at end of file
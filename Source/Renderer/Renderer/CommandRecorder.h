@@ -0,0 +1,80 @@
+/*+===================================================================
+  File:      COMMANDRECORDER.H
+
+  Summary:   CommandRecorder header file contains declarations of the
+             CommandRecorder class, the base class of recorders that
+             split a list of draws into contiguous partitions, record
+             each partition on its own thread and submit the
+             recordings in partition order.
+
+  Classes: CommandRecorder
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Profiler/Profiler.h"
+#include "Renderer/AssetLoader.h"
+#include "Renderer/RenderContext.h"
+
+#include <functional>
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    CommandRecorder
+
+      Summary:  Base class for command recorders. Record partitions the
+                items, records the first partition on the calling
+                thread and the others on worker threads, and Submit
+                plays the recordings back in partition order so the
+                result matches recording everything on one context
+
+      Methods:  Record
+                  Records the items in parallel partitions
+                Submit
+                  Plays the recordings of the last Record back in
+                  partition order
+                GetNumContexts
+                  Returns the maximum number of partitions
+                GetNumRecorded
+                  Returns the number of partitions of the last Record
+                CommandRecorder
+                  Constructor.
+                ~CommandRecorder
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class CommandRecorder
+    {
+    public:
+        static constexpr UINT MIN_ITEMS_PER_CONTEXT = 32u;
+
+        using RecordFunction = std::function<void(_In_opt_ RenderContext* pContext, _In_ UINT uBegin, _In_ UINT uEnd)>;
+
+    public:
+        CommandRecorder(_In_ UINT uNumContexts);
+        CommandRecorder(const CommandRecorder& other) = delete;
+        CommandRecorder(CommandRecorder&& other) = delete;
+        CommandRecorder& operator=(const CommandRecorder& other) = delete;
+        CommandRecorder& operator=(CommandRecorder&& other) = delete;
+        virtual ~CommandRecorder() = default;
+
+        HRESULT Record(_In_ UINT uNumItems, _In_ const RecordFunction& record);
+        void Submit(_In_opt_ RenderContext* pImmediateContext);
+
+        UINT GetNumContexts() const;
+        UINT GetNumRecorded() const;
+
+    protected:
+        virtual RenderContext* beginRecording(_In_ UINT uContext, _In_ UINT uBegin, _In_ UINT uEnd) = 0;
+        virtual HRESULT endRecording(_In_ UINT uContext) = 0;
+        virtual void submitRecording(_In_opt_ RenderContext* pImmediateContext, _In_ UINT uContext) = 0;
+
+    protected:
+        UINT m_uNumContexts;
+        UINT m_uNumRecorded;
+        std::unique_ptr<AssetLoader> m_workers;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,337 @@
+#include "Renderer/ConstantBufferRing.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::ConstantBufferRing
+
+      Summary:  Constructor. The ring starts without capacity, the
+                first EndFrame sizes it
+
+      Modifies: [m_aFrameData, m_uCapacity, m_uHead, m_uFrameOffset,
+                 m_uRetainedSize, m_uGeneration, m_bFrameDiscarding,
+                 m_bFramePlaced, m_bDiscardNeeded].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ConstantBufferRing::ConstantBufferRing()
+        : m_aFrameData()
+        , m_uCapacity(0u)
+        , m_uHead(0u)
+        , m_uFrameOffset(0u)
+        , m_uRetainedSize(0u)
+        , m_uGeneration(0u)
+        , m_bFrameDiscarding(FALSE)
+        , m_bFramePlaced(FALSE)
+        , m_bDiscardNeeded(TRUE)
+    {
+        // empty
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::BeginFrame
+
+      Summary:  Drops the data of the previous frame and starts
+                allocating a new one
+
+      Modifies: [m_aFrameData, m_uRetainedSize].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ConstantBufferRing::BeginFrame()
+    {
+        m_aFrameData.clear();
+        m_uRetainedSize = 0u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::Retain
+
+      Summary:  Checks whether a placed allocation of an earlier frame
+                still holds the data of the owner at the given version.
+                Retained allocations are used as they are, nothing is
+                copied into the frame
+
+      Args:     const ConstantBufferAllocation& allocation
+                  Allocation the owner used last
+                const void* pOwner
+                  Object the data belongs to
+                UINT64 uVersion
+                  Current version of the data
+
+      Modifies: [m_uRetainedSize].
+
+      Returns:  BOOL
+                  TRUE if the allocation can be used again, FALSE if
+                  the data has to be allocated
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL ConstantBufferRing::Retain(_In_ const ConstantBufferAllocation& allocation, _In_opt_ const void* pOwner, _In_ UINT64 uVersion)
+    {
+        if (m_bDiscardNeeded || !allocation.bPlaced || allocation.uGeneration != m_uGeneration ||
+            allocation.pOwner != pOwner || allocation.uVersion != uVersion)
+        {
+            return FALSE;
+        }
+
+        m_uRetainedSize += allocation.uSize;
+
+        return TRUE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::Allocate
+
+      Summary:  Copies constant buffer data to the end of the frame.
+                The allocation is padded to ALIGNMENT bytes, the
+                granularity of constant buffer offsets
+
+      Args:     const void* pData
+                  The constant buffer data
+                UINT uSize
+                  Size of the data in bytes
+                const void* pOwner
+                  Object the data belongs to
+                UINT64 uVersion
+                  Version of the data
+
+      Modifies: [m_aFrameData].
+
+      Returns:  ConstantBufferAllocation
+                  Range of the data in the frame
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ConstantBufferAllocation ConstantBufferRing::Allocate(_In_reads_bytes_(uSize) const void* pData, _In_ UINT uSize, _In_opt_ const void* pOwner, _In_ UINT64 uVersion)
+    {
+        const ConstantBufferAllocation allocation =
+        {
+            .uOffset = static_cast<UINT>(m_aFrameData.size()),
+            .uSize = (uSize + ALIGNMENT - 1u) / ALIGNMENT * ALIGNMENT,
+            .pOwner = pOwner,
+            .uVersion = uVersion,
+            .uGeneration = 0u,
+            .bPlaced = FALSE
+        };
+
+        m_aFrameData.resize(static_cast<size_t>(allocation.uOffset) + allocation.uSize);
+        memcpy(m_aFrameData.data() + allocation.uOffset, pData, uSize);
+
+        return allocation;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::EndFrame
+
+      Summary:  Places the frame right after the previous one. A frame
+                that does not fit in front of the end of the buffer is
+                placed at the start and discards the buffer, a frame
+                larger than the buffer doubles the capacity until it
+                fits. Every discard starts a new generation. A frame
+                that retained allocations cannot discard, as they would
+                be lost with the buffer, so it is not placed and has to
+                be allocated again without retaining
+
+      Modifies: [m_uCapacity, m_uHead, m_uFrameOffset, m_uGeneration,
+                 m_bFrameDiscarding, m_bFramePlaced, m_bDiscardNeeded].
+
+      Returns:  BOOL
+                  TRUE if the capacity grew and the buffer has to be
+                  recreated with GetCapacity bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL ConstantBufferRing::EndFrame()
+    {
+        const UINT uFrameSize = GetFrameSize();
+
+        BOOL bGrown = FALSE;
+        if (uFrameSize > m_uCapacity)
+        {
+            m_uCapacity = m_uCapacity > MIN_CAPACITY ? m_uCapacity : MIN_CAPACITY;
+            while (m_uCapacity < uFrameSize)
+            {
+                m_uCapacity *= 2u;
+            }
+            m_bDiscardNeeded = TRUE;
+            bGrown = TRUE;
+        }
+
+        m_bFrameDiscarding = m_bDiscardNeeded || m_uHead + uFrameSize > m_uCapacity;
+        if (m_bFrameDiscarding)
+        {
+            ++m_uGeneration;
+        }
+
+        m_bFramePlaced = !m_bFrameDiscarding || m_uRetainedSize == 0u;
+        if (!m_bFramePlaced)
+        {
+            m_bDiscardNeeded = TRUE;
+            return bGrown;
+        }
+
+        m_uFrameOffset = m_bFrameDiscarding ? 0u : m_uHead;
+        m_uHead = m_uFrameOffset + uFrameSize;
+        m_bDiscardNeeded = FALSE;
+
+        return bGrown;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::Place
+
+      Summary:  Makes an allocation of the placed frame relative to the
+                start of the buffer and stamps it with the generation,
+                so later frames can retain it. Retained and empty
+                allocations are left as they are
+
+      Args:     ConstantBufferAllocation& allocation
+                  An allocation of the current frame
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ConstantBufferRing::Place(_Inout_ ConstantBufferAllocation& allocation) const
+    {
+        assert(m_bFramePlaced);
+
+        if (!allocation.bPlaced && allocation.uSize > 0u)
+        {
+            allocation.uOffset += m_uFrameOffset;
+            allocation.uGeneration = m_uGeneration;
+            allocation.bPlaced = TRUE;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::Reset
+
+      Summary:  Makes the next frame start at the beginning of the
+                buffer and discard it, used when the buffer is
+                recreated or cannot be mapped without overwriting
+
+      Modifies: [m_uHead, m_bDiscardNeeded].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ConstantBufferRing::Reset()
+    {
+        m_uHead = 0u;
+        m_bDiscardNeeded = TRUE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::GetFrameData
+
+      Summary:  Returns the data allocated in the frame
+
+      Returns:  const BYTE*
+                  Data of the frame, GetFrameSize bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const BYTE* ConstantBufferRing::GetFrameData() const
+    {
+        return m_aFrameData.data();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::GetFrameSize
+
+      Summary:  Returns the size of the data allocated in the frame
+
+      Returns:  UINT
+                  Size of the frame in bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT ConstantBufferRing::GetFrameSize() const
+    {
+        return static_cast<UINT>(m_aFrameData.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::GetFrameOffset
+
+      Summary:  Returns where EndFrame placed the frame
+
+      Returns:  UINT
+                  Offset of the frame in the buffer in bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT ConstantBufferRing::GetFrameOffset() const
+    {
+        return m_uFrameOffset;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::IsFrameDiscarding
+
+      Summary:  Returns whether the frame has to be written with
+                WRITE_DISCARD instead of WRITE_NO_OVERWRITE
+
+      Returns:  BOOL
+                  TRUE if the frame discards the buffer
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL ConstantBufferRing::IsFrameDiscarding() const
+    {
+        return m_bFrameDiscarding;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::IsFramePlaced
+
+      Summary:  Returns whether EndFrame placed the frame. A frame that
+                is not placed retained data of a discarded buffer and
+                has to be allocated again
+
+      Returns:  BOOL
+                  TRUE if the frame is placed
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL ConstantBufferRing::IsFramePlaced() const
+    {
+        return m_bFramePlaced;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::GetRetainedSize
+
+      Summary:  Returns the size of the allocations the frame retained
+                instead of copying them
+
+      Returns:  UINT
+                  Size of the retained allocations in bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT ConstantBufferRing::GetRetainedSize() const
+    {
+        return m_uRetainedSize;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::GetCapacity
+
+      Summary:  Returns the size of the buffer the ring allocates from
+
+      Returns:  UINT
+                  Size of the buffer in bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT ConstantBufferRing::GetCapacity() const
+    {
+        return m_uCapacity;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::GetFirstConstant
+
+      Summary:  Returns the first shader constant of an allocation of
+                the placed frame, as VSSetConstantBuffers1 takes it
+
+      Args:     const ConstantBufferAllocation& allocation
+                  An allocation of the current frame, placed or not
+
+      Returns:  UINT
+                  Index of the first 16 byte constant in the buffer
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT ConstantBufferRing::GetFirstConstant(_In_ const ConstantBufferAllocation& allocation) const
+    {
+        return ((allocation.bPlaced ? 0u : m_uFrameOffset) + allocation.uOffset) / CONSTANT_SIZE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::GetNumConstants
+
+      Summary:  Returns the number of shader constants of an
+                allocation, always a multiple of 16
+
+      Args:     const ConstantBufferAllocation& allocation
+                  An allocation
+
+      Returns:  UINT
+                  Number of 16 byte constants
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT ConstantBufferRing::GetNumConstants(_In_ const ConstantBufferAllocation& allocation)
+    {
+        return allocation.uSize / CONSTANT_SIZE;
+    }
+}
\ No newline at end of file
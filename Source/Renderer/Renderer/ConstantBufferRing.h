@@ -0,0 +1,134 @@
+/*+===================================================================
+  File:      CONSTANTBUFFERRING.H
+
+  Summary:   ConstantBufferRing header file contains declarations of
+             the ConstantBufferRing class that sub-allocates the
+             constant buffer data of a frame from one dynamic buffer.
+
+  Classes: ConstantBufferRing
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   ConstantBufferAllocation
+
+      Summary:  Range of constant buffer data allocated in a frame.
+                uOffset is relative to the start of the frame until
+                the allocation is placed, then relative to the start of
+                the buffer. uSize is rounded up to the alignment of the
+                ring. pOwner and uVersion identify the data, so an
+                allocation whose owner did not change can be retained
+                by later frames of the same generation
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct ConstantBufferAllocation
+    {
+        UINT uOffset;
+        UINT uSize;
+        const void* pOwner;
+        UINT64 uVersion;
+        UINT64 uGeneration;
+        BOOL bPlaced;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    ConstantBufferRing
+
+      Summary:  Linear allocator for the constant buffer data of a
+                frame. Allocations are packed into a CPU side copy of
+                the frame, which EndFrame places after the data of the
+                previous frame so the frame is written with a single
+                WRITE_NO_OVERWRITE map. A frame that does not fit in
+                front of the end of the buffer wraps to the start with
+                a WRITE_DISCARD map. The ring needs no device, the
+                caller owns the buffer and writes the frame to it.
+                Data written by earlier frames stays valid until the
+                next discard starts a new generation, so allocations
+                whose data did not change are retained instead of
+                being copied again
+
+      Methods:  BeginFrame
+                  Starts allocating the data of a frame
+                Retain
+                  Reuses an allocation of an earlier frame
+                Allocate
+                  Copies constant buffer data into the frame
+                EndFrame
+                  Places the frame in the buffer
+                Place
+                  Makes an allocation relative to the buffer
+                Reset
+                  Makes the next frame discard the buffer
+                GetFrameData
+                  Returns the data of the frame
+                GetFrameSize
+                  Returns the size of the frame
+                GetFrameOffset
+                  Returns the offset of the frame in the buffer
+                IsFrameDiscarding
+                  Returns whether the frame discards the buffer
+                IsFramePlaced
+                  Returns whether EndFrame placed the frame
+                GetRetainedSize
+                  Returns the size of the retained allocations
+                GetCapacity
+                  Returns the size of the buffer
+                GetFirstConstant
+                  Returns the first shader constant of an allocation
+                GetNumConstants
+                  Returns the number of shader constants of an
+                  allocation
+                ConstantBufferRing
+                  Constructor.
+                ~ConstantBufferRing
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class ConstantBufferRing final
+    {
+    public:
+        static constexpr UINT CONSTANT_SIZE = 16u;
+        static constexpr UINT ALIGNMENT = 16u * CONSTANT_SIZE;
+        static constexpr UINT MIN_CAPACITY = 256u * 1024u;
+
+        ConstantBufferRing();
+        ConstantBufferRing(const ConstantBufferRing& other) = delete;
+        ConstantBufferRing(ConstantBufferRing&& other) = delete;
+        ConstantBufferRing& operator=(const ConstantBufferRing& other) = delete;
+        ConstantBufferRing& operator=(ConstantBufferRing&& other) = delete;
+        ~ConstantBufferRing() = default;
+
+        void BeginFrame();
+        BOOL Retain(_In_ const ConstantBufferAllocation& allocation, _In_opt_ const void* pOwner, _In_ UINT64 uVersion);
+        ConstantBufferAllocation Allocate(_In_reads_bytes_(uSize) const void* pData, _In_ UINT uSize, _In_opt_ const void* pOwner, _In_ UINT64 uVersion);
+        BOOL EndFrame();
+        void Place(_Inout_ ConstantBufferAllocation& allocation) const;
+        void Reset();
+
+        const BYTE* GetFrameData() const;
+        UINT GetFrameSize() const;
+        UINT GetFrameOffset() const;
+        BOOL IsFrameDiscarding() const;
+        BOOL IsFramePlaced() const;
+        UINT GetRetainedSize() const;
+        UINT GetCapacity() const;
+        UINT GetFirstConstant(_In_ const ConstantBufferAllocation& allocation) const;
+
+        static UINT GetNumConstants(_In_ const ConstantBufferAllocation& allocation);
+
+    private:
+        std::vector<BYTE> m_aFrameData;
+        UINT m_uCapacity;
+        UINT m_uHead;
+        UINT m_uFrameOffset;
+        UINT m_uRetainedSize;
+        UINT64 m_uGeneration;
+        BOOL m_bFrameDiscarding;
+        BOOL m_bFramePlaced;
+        BOOL m_bDiscardNeeded;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,497 @@
+#include "Renderer/D3D11RenderContext.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderContext::D3D11RenderContext
+
+      Summary:  Constructor
+
+      Args:     ID3D11DeviceContext* pContext
+                  The Direct3D context to forward the calls to
+
+      Modifies: [m_context, m_context1].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    D3D11RenderContext::D3D11RenderContext(_In_ ID3D11DeviceContext* pContext)
+        : RenderContext()
+        , m_context(pContext)
+        , m_context1()
+    {
+        // Null on a Direct3D 11.0 runtime, the renderer checks for constant buffer offsets before drawing
+        m_context.As(&m_context1);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderContext::GetDeviceContext
+
+      Summary:  Returns the wrapped device context
+
+      Returns:  ID3D11DeviceContext*
+                  The Direct3D context
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ID3D11DeviceContext* D3D11RenderContext::GetDeviceContext() const
+    {
+        return m_context.Get();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderContext::IASetPrimitiveTopology
+
+      Summary:  Forwards to ID3D11DeviceContext::IASetPrimitiveTopology
+
+      Args:     D3D11_PRIMITIVE_TOPOLOGY topology
+
+      Modifies: [m_topology].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderContext::IASetPrimitiveTopology(_In_ D3D11_PRIMITIVE_TOPOLOGY topology)
+    {
+        m_topology = topology;
+
+        m_context->IASetPrimitiveTopology(topology);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderContext::IASetInputLayout
+
+      Summary:  Forwards to ID3D11DeviceContext::IASetInputLayout
+
+      Args:     ID3D11InputLayout* pInputLayout
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderContext::IASetInputLayout(_In_opt_ ID3D11InputLayout* pInputLayout)
+    {
+        m_context->IASetInputLayout(pInputLayout);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderContext::IASetVertexBuffers
+
+      Summary:  Forwards to ID3D11DeviceContext::IASetVertexBuffers
+
+      Args:     UINT uStartSlot
+                UINT uNumBuffers
+                ID3D11Buffer* const* ppVertexBuffers
+                const UINT* puStrides
+                const UINT* puOffsets
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderContext::IASetVertexBuffers(
+        _In_ UINT uStartSlot,
+        _In_ UINT uNumBuffers,
+        _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppVertexBuffers,
+        _In_reads_opt_(uNumBuffers) const UINT* puStrides,
+        _In_reads_opt_(uNumBuffers) const UINT* puOffsets
+    )
+    {
+        m_context->IASetVertexBuffers(uStartSlot, uNumBuffers, ppVertexBuffers, puStrides, puOffsets);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderContext::IASetIndexBuffer
+
+      Summary:  Forwards to ID3D11DeviceContext::IASetIndexBuffer
+
+      Args:     ID3D11Buffer* pIndexBuffer
+                DXGI_FORMAT format
+                UINT uOffset
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderContext::IASetIndexBuffer(_In_opt_ ID3D11Buffer* pIndexBuffer, _In_ DXGI_FORMAT format, _In_ UINT uOffset)
+    {
+        m_context->IASetIndexBuffer(pIndexBuffer, format, uOffset);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderContext::VSSetShader
+
+      Summary:  Forwards to ID3D11DeviceContext::VSSetShader
+
+      Args:     ID3D11VertexShader* pVertexShader
+                ID3D11ClassInstance* const* ppClassInstances
+                UINT uNumClassInstances
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderContext::VSSetShader(
+        _In_opt_ ID3D11VertexShader* pVertexShader,
+        _In_reads_opt_(uNumClassInstances) ID3D11ClassInstance* const* ppClassInstances,
+        _In_ UINT uNumClassInstances
+    )
+    {
+        ++m_stats.uNumShaderBinds;
+
+        m_context->VSSetShader(pVertexShader, ppClassInstances, uNumClassInstances);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderContext::VSSetConstantBuffers
+
+      Summary:  Forwards to ID3D11DeviceContext::VSSetConstantBuffers
+
+      Args:     UINT uStartSlot
+                UINT uNumBuffers
+                ID3D11Buffer* const* ppConstantBuffers
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderContext::VSSetConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers)
+    {
+        m_stats.uNumConstantBufferBinds += uNumBuffers;
+
+        m_context->VSSetConstantBuffers(uStartSlot, uNumBuffers, ppConstantBuffers);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderContext::VSSetConstantBuffers1
+
+      Summary:  Forwards to ID3D11DeviceContext1::VSSetConstantBuffers1
+
+      Args:     UINT uStartSlot
+                UINT uNumBuffers
+                ID3D11Buffer* const* ppConstantBuffers
+                const UINT* puFirstConstant
+                const UINT* puNumConstants
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderContext::VSSetConstantBuffers1(
+        _In_ UINT uStartSlot,
+        _In_ UINT uNumBuffers,
+        _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers,
+        _In_reads_opt_(uNumBuffers) const UINT* puFirstConstant,
+        _In_reads_opt_(uNumBuffers) const UINT* puNumConstants
+    )
+    {
+        m_stats.uNumConstantBufferBinds += uNumBuffers;
+
+        m_context1->VSSetConstantBuffers1(uStartSlot, uNumBuffers, ppConstantBuffers, puFirstConstant, puNumConstants);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderContext::PSSetShader
+
+      Summary:  Forwards to ID3D11DeviceContext::PSSetShader
+
+      Args:     ID3D11PixelShader* pPixelShader
+                ID3D11ClassInstance* const* ppClassInstances
+                UINT uNumClassInstances
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderContext::PSSetShader(
+        _In_opt_ ID3D11PixelShader* pPixelShader,
+        _In_reads_opt_(uNumClassInstances) ID3D11ClassInstance* const* ppClassInstances,
+        _In_ UINT uNumClassInstances
+    )
+    {
+        ++m_stats.uNumShaderBinds;
+
+        m_context->PSSetShader(pPixelShader, ppClassInstances, uNumClassInstances);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderContext::PSSetConstantBuffers
+
+      Summary:  Forwards to ID3D11DeviceContext::PSSetConstantBuffers
+
+      Args:     UINT uStartSlot
+                UINT uNumBuffers
+                ID3D11Buffer* const* ppConstantBuffers
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderContext::PSSetConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers)
+    {
+        m_stats.uNumConstantBufferBinds += uNumBuffers;
+
+        m_context->PSSetConstantBuffers(uStartSlot, uNumBuffers, ppConstantBuffers);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderContext::PSSetConstantBuffers1
+
+      Summary:  Forwards to ID3D11DeviceContext1::PSSetConstantBuffers1
+
+      Args:     UINT uStartSlot
+                UINT uNumBuffers
+                ID3D11Buffer* const* ppConstantBuffers
+                const UINT* puFirstConstant
+                const UINT* puNumConstants
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderContext::PSSetConstantBuffers1(
+        _In_ UINT uStartSlot,
+        _In_ UINT uNumBuffers,
+        _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers,
+        _In_reads_opt_(uNumBuffers) const UINT* puFirstConstant,
+        _In_reads_opt_(uNumBuffers) const UINT* puNumConstants
+    )
+    {
+        m_stats.uNumConstantBufferBinds += uNumBuffers;
+
+        m_context1->PSSetConstantBuffers1(uStartSlot, uNumBuffers, ppConstantBuffers, puFirstConstant, puNumConstants);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderContext::PSSetShaderResources
+
+      Summary:  Forwards to ID3D11DeviceContext::PSSetShaderResources
+
+      Args:     UINT uStartSlot
+                UINT uNumViews
+                ID3D11ShaderResourceView* const* ppShaderResourceViews
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderContext::PSSetShaderResources(_In_ UINT uStartSlot, _In_ UINT uNumViews, _In_reads_opt_(uNumViews) ID3D11ShaderResourceView* const* ppShaderResourceViews)
+    {
+        m_stats.uNumShaderResourceBinds += uNumViews;
+
+        m_context->PSSetShaderResources(uStartSlot, uNumViews, ppShaderResourceViews);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderContext::PSSetSamplers
+
+      Summary:  Forwards to ID3D11DeviceContext::PSSetSamplers
+
+      Args:     UINT uStartSlot
+                UINT uNumSamplers
+                ID3D11SamplerState* const* ppSamplers
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderContext::PSSetSamplers(_In_ UINT uStartSlot, _In_ UINT uNumSamplers, _In_reads_opt_(uNumSamplers) ID3D11SamplerState* const* ppSamplers)
+    {
+        m_stats.uNumSamplerBinds += uNumSamplers;
+
+        m_context->PSSetSamplers(uStartSlot, uNumSamplers, ppSamplers);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderContext::RSSetViewports
+
+      Summary:  Forwards to ID3D11DeviceContext::RSSetViewports
+
+      Args:     UINT uNumViewports
+                const D3D11_VIEWPORT* pViewports
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderContext::RSSetViewports(_In_ UINT uNumViewports, _In_reads_opt_(uNumViewports) const D3D11_VIEWPORT* pViewports)
+    {
+        m_context->RSSetViewports(uNumViewports, pViewports);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderContext::RSSetState
+
+      Summary:  Forwards to ID3D11DeviceContext::RSSetState
+
+      Args:     ID3D11RasterizerState* pRasterizerState
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderContext::RSSetState(_In_opt_ ID3D11RasterizerState* pRasterizerState)
+    {
+        m_context->RSSetState(pRasterizerState);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderContext::OMSetRenderTargets
+
+      Summary:  Forwards to ID3D11DeviceContext::OMSetRenderTargets
+
+      Args:     UINT uNumViews
+                ID3D11RenderTargetView* const* ppRenderTargetViews
+                ID3D11DepthStencilView* pDepthStencilView
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderContext::OMSetRenderTargets(
+        _In_ UINT uNumViews,
+        _In_reads_opt_(uNumViews) ID3D11RenderTargetView* const* ppRenderTargetViews,
+        _In_opt_ ID3D11DepthStencilView* pDepthStencilView
+    )
+    {
+        m_context->OMSetRenderTargets(uNumViews, ppRenderTargetViews, pDepthStencilView);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderContext::OMSetDepthStencilState
+
+      Summary:  Forwards to ID3D11DeviceContext::OMSetDepthStencilState
+
+      Args:     ID3D11DepthStencilState* pDepthStencilState
+                UINT uStencilRef
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderContext::OMSetDepthStencilState(_In_opt_ ID3D11DepthStencilState* pDepthStencilState, _In_ UINT uStencilRef)
+    {
+        m_context->OMSetDepthStencilState(pDepthStencilState, uStencilRef);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderContext::ClearRenderTargetView
+
+      Summary:  Forwards to ID3D11DeviceContext::ClearRenderTargetView
+
+      Args:     ID3D11RenderTargetView* pRenderTargetView
+                const FLOAT aColorRGBA[4]
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderContext::ClearRenderTargetView(_In_opt_ ID3D11RenderTargetView* pRenderTargetView, _In_ const FLOAT aColorRGBA[4])
+    {
+        m_context->ClearRenderTargetView(pRenderTargetView, aColorRGBA);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderContext::ClearDepthStencilView
+
+      Summary:  Forwards to ID3D11DeviceContext::ClearDepthStencilView
+
+      Args:     ID3D11DepthStencilView* pDepthStencilView
+                UINT uClearFlags
+                FLOAT depth
+                UINT8 stencil
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderContext::ClearDepthStencilView(_In_opt_ ID3D11DepthStencilView* pDepthStencilView, _In_ UINT uClearFlags, _In_ FLOAT depth, _In_ UINT8 stencil)
+    {
+        m_context->ClearDepthStencilView(pDepthStencilView, uClearFlags, depth, stencil);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderContext::UpdateConstantBuffer
+
+      Summary:  Replaces the whole contents of a constant buffer through
+                UpdateSubresource
+
+      Args:     ID3D11Buffer* pConstantBuffer
+                const void* pData
+                UINT uDataSize
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderContext::UpdateConstantBuffer(_In_opt_ ID3D11Buffer* pConstantBuffer, _In_reads_bytes_(uDataSize) const void* pData, _In_ UINT uDataSize)
+    {
+        ++m_stats.uNumUploads;
+        m_stats.uNumUploadedBytes += uDataSize;
+
+        m_context->UpdateSubresource(pConstantBuffer, 0u, nullptr, pData, 0u, 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderContext::UpdateDynamicConstantBuffer
+
+      Summary:  Maps a dynamic constant buffer and copies the data to
+                the given offset. WRITE_NO_OVERWRITE promises not to
+                touch data the GPU may still read, which the caller
+                guarantees by writing behind the previous frames
+
+      Args:     ID3D11Buffer* pConstantBuffer
+                UINT uOffset
+                  Offset of the data in the buffer in bytes
+                const void* pData
+                UINT uDataSize
+                BOOL bDiscard
+                  TRUE to map with WRITE_DISCARD, FALSE to map with
+                  WRITE_NO_OVERWRITE
+
+      Modifies: [m_stats].
+
+      Returns:  HRESULT
+                  Status code of the map
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT D3D11RenderContext::UpdateDynamicConstantBuffer(
+        _In_opt_ ID3D11Buffer* pConstantBuffer,
+        _In_ UINT uOffset,
+        _In_reads_bytes_(uDataSize) const void* pData,
+        _In_ UINT uDataSize,
+        _In_ BOOL bDiscard
+    )
+    {
+        if (!pConstantBuffer)
+        {
+            return E_INVALIDARG;
+        }
+
+        D3D11_MAPPED_SUBRESOURCE mappedSubresource = {};
+        HRESULT hr = m_context->Map(pConstantBuffer, 0u, bDiscard ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE, 0u, &mappedSubresource);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        memcpy(static_cast<BYTE*>(mappedSubresource.pData) + uOffset, pData, uDataSize);
+        m_context->Unmap(pConstantBuffer, 0u);
+
+        ++m_stats.uNumUploads;
+        m_stats.uNumUploadedBytes += uDataSize;
+
+        return hr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderContext::Draw
+
+      Summary:  Forwards to ID3D11DeviceContext::Draw
+
+      Args:     UINT uVertexCount
+                UINT uStartVertexLocation
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderContext::Draw(_In_ UINT uVertexCount, _In_ UINT uStartVertexLocation)
+    {
+        countDraw(uVertexCount, 1u);
+
+        m_context->Draw(uVertexCount, uStartVertexLocation);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderContext::DrawIndexed
+
+      Summary:  Forwards to ID3D11DeviceContext::DrawIndexed
+
+      Args:     UINT uIndexCount
+                UINT uStartIndexLocation
+                INT iBaseVertexLocation
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderContext::DrawIndexed(_In_ UINT uIndexCount, _In_ UINT uStartIndexLocation, _In_ INT iBaseVertexLocation)
+    {
+        countDraw(uIndexCount, 1u);
+
+        m_context->DrawIndexed(uIndexCount, uStartIndexLocation, iBaseVertexLocation);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderContext::DrawIndexedInstanced
+
+      Summary:  Forwards to ID3D11DeviceContext::DrawIndexedInstanced
+
+      Args:     UINT uIndexCountPerInstance
+                UINT uInstanceCount
+                UINT uStartIndexLocation
+                INT iBaseVertexLocation
+                UINT uStartInstanceLocation
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderContext::DrawIndexedInstanced(
+        _In_ UINT uIndexCountPerInstance,
+        _In_ UINT uInstanceCount,
+        _In_ UINT uStartIndexLocation,
+        _In_ INT iBaseVertexLocation,
+        _In_ UINT uStartInstanceLocation
+    )
+    {
+        countDraw(uIndexCountPerInstance, uInstanceCount);
+
+        m_context->DrawIndexedInstanced(uIndexCountPerInstance, uInstanceCount, uStartIndexLocation, iBaseVertexLocation, uStartInstanceLocation);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderContext::ExecuteCommandList
+
+      Summary:  Forwards to ID3D11DeviceContext::ExecuteCommandList
+
+      Args:     ID3D11CommandList* pCommandList
+                BOOL bRestoreContextState
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderContext::ExecuteCommandList(_In_opt_ ID3D11CommandList* pCommandList, _In_ BOOL bRestoreContextState)
+    {
+        m_context->ExecuteCommandList(pCommandList, bRestoreContextState);
+    }
+}
\ No newline at end of file
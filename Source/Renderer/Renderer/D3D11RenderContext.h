@@ -0,0 +1,124 @@
+/*+===================================================================
+  File:      D3D11RENDERCONTEXT.H
+
+  Summary:   D3D11RenderContext header file contains declarations of
+             the D3D11RenderContext class that forwards the render
+             context calls to a Direct3D 11 device context.
+
+  Classes: D3D11RenderContext
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/RenderContext.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    D3D11RenderContext
+
+      Summary:  Render context backed by an immediate or a deferred
+                Direct3D 11 device context. Constant buffer offsets
+                need the Direct3D 11.1 interface of the context
+
+      Methods:  GetDeviceContext
+                  Returns the wrapped device context
+                D3D11RenderContext
+                  Constructor.
+                ~D3D11RenderContext
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class D3D11RenderContext final : public RenderContext
+    {
+    public:
+        D3D11RenderContext(_In_ ID3D11DeviceContext* pContext);
+        D3D11RenderContext(const D3D11RenderContext& other) = delete;
+        D3D11RenderContext(D3D11RenderContext&& other) = delete;
+        D3D11RenderContext& operator=(const D3D11RenderContext& other) = delete;
+        D3D11RenderContext& operator=(D3D11RenderContext&& other) = delete;
+        ~D3D11RenderContext() = default;
+
+        ID3D11DeviceContext* GetDeviceContext() const;
+
+        void IASetPrimitiveTopology(_In_ D3D11_PRIMITIVE_TOPOLOGY topology) override;
+        void IASetInputLayout(_In_opt_ ID3D11InputLayout* pInputLayout) override;
+        void IASetVertexBuffers(
+            _In_ UINT uStartSlot,
+            _In_ UINT uNumBuffers,
+            _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppVertexBuffers,
+            _In_reads_opt_(uNumBuffers) const UINT* puStrides,
+            _In_reads_opt_(uNumBuffers) const UINT* puOffsets
+        ) override;
+        void IASetIndexBuffer(_In_opt_ ID3D11Buffer* pIndexBuffer, _In_ DXGI_FORMAT format, _In_ UINT uOffset) override;
+
+        void VSSetShader(
+            _In_opt_ ID3D11VertexShader* pVertexShader,
+            _In_reads_opt_(uNumClassInstances) ID3D11ClassInstance* const* ppClassInstances,
+            _In_ UINT uNumClassInstances
+        ) override;
+        void VSSetConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers) override;
+        void VSSetConstantBuffers1(
+            _In_ UINT uStartSlot,
+            _In_ UINT uNumBuffers,
+            _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers,
+            _In_reads_opt_(uNumBuffers) const UINT* puFirstConstant,
+            _In_reads_opt_(uNumBuffers) const UINT* puNumConstants
+        ) override;
+
+        void PSSetShader(
+            _In_opt_ ID3D11PixelShader* pPixelShader,
+            _In_reads_opt_(uNumClassInstances) ID3D11ClassInstance* const* ppClassInstances,
+            _In_ UINT uNumClassInstances
+        ) override;
+        void PSSetConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers) override;
+        void PSSetConstantBuffers1(
+            _In_ UINT uStartSlot,
+            _In_ UINT uNumBuffers,
+            _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers,
+            _In_reads_opt_(uNumBuffers) const UINT* puFirstConstant,
+            _In_reads_opt_(uNumBuffers) const UINT* puNumConstants
+        ) override;
+        void PSSetShaderResources(_In_ UINT uStartSlot, _In_ UINT uNumViews, _In_reads_opt_(uNumViews) ID3D11ShaderResourceView* const* ppShaderResourceViews) override;
+        void PSSetSamplers(_In_ UINT uStartSlot, _In_ UINT uNumSamplers, _In_reads_opt_(uNumSamplers) ID3D11SamplerState* const* ppSamplers) override;
+
+        void RSSetViewports(_In_ UINT uNumViewports, _In_reads_opt_(uNumViewports) const D3D11_VIEWPORT* pViewports) override;
+        void RSSetState(_In_opt_ ID3D11RasterizerState* pRasterizerState) override;
+        void OMSetRenderTargets(
+            _In_ UINT uNumViews,
+            _In_reads_opt_(uNumViews) ID3D11RenderTargetView* const* ppRenderTargetViews,
+            _In_opt_ ID3D11DepthStencilView* pDepthStencilView
+        ) override;
+        void OMSetDepthStencilState(_In_opt_ ID3D11DepthStencilState* pDepthStencilState, _In_ UINT uStencilRef) override;
+
+        void ClearRenderTargetView(_In_opt_ ID3D11RenderTargetView* pRenderTargetView, _In_ const FLOAT aColorRGBA[4]) override;
+        void ClearDepthStencilView(_In_opt_ ID3D11DepthStencilView* pDepthStencilView, _In_ UINT uClearFlags, _In_ FLOAT depth, _In_ UINT8 stencil) override;
+
+        void UpdateConstantBuffer(_In_opt_ ID3D11Buffer* pConstantBuffer, _In_reads_bytes_(uDataSize) const void* pData, _In_ UINT uDataSize) override;
+        HRESULT UpdateDynamicConstantBuffer(
+            _In_opt_ ID3D11Buffer* pConstantBuffer,
+            _In_ UINT uOffset,
+            _In_reads_bytes_(uDataSize) const void* pData,
+            _In_ UINT uDataSize,
+            _In_ BOOL bDiscard
+        ) override;
+
+        void Draw(_In_ UINT uVertexCount, _In_ UINT uStartVertexLocation) override;
+        void DrawIndexed(_In_ UINT uIndexCount, _In_ UINT uStartIndexLocation, _In_ INT iBaseVertexLocation) override;
+        void DrawIndexedInstanced(
+            _In_ UINT uIndexCountPerInstance,
+            _In_ UINT uInstanceCount,
+            _In_ UINT uStartIndexLocation,
+            _In_ INT iBaseVertexLocation,
+            _In_ UINT uStartInstanceLocation
+        ) override;
+
+        void ExecuteCommandList(_In_opt_ ID3D11CommandList* pCommandList, _In_ BOOL bRestoreContextState) override;
+
+    private:
+        ComPtr<ID3D11DeviceContext> m_context;
+        ComPtr<ID3D11DeviceContext1> m_context1;
+    };
+}
\ No newline at end of file
@@ -5,6 +5,8 @@
 namespace library
 {
 #define NUM_LIGHTS (2)
+#define NUM_CASCADES (4)
+#define NUM_GBUFFER_TARGETS (2)
 #define MAX_NUM_BONES (256)
 #define MAX_NUM_BONES_PER_VERTEX (16)
 
@@ -70,13 +72,38 @@ namespace library
 		XMMATRIX LightProjections[NUM_LIGHTS];
 		XMFLOAT4 LightAttenuationDistance[NUM_LIGHTS];
 		PointLightData PointLights[NUM_LIGHTS];
+		XMFLOAT4 LightShadowIndices[NUM_LIGHTS];
 	};
 
 	struct CBShadowMatrix
 	{
 		XMMATRIX World;
+		BOOL IsVoxel;
+	};
+
+	struct CBShadowLight
+	{
 		XMMATRIX View;
 		XMMATRIX Projection;
-		BOOL IsVoxel;
+	};
+
+	struct CBCascades
+	{
+		XMMATRIX CascadeViewProjections[NUM_CASCADES];
+		XMFLOAT4 CascadeSplits[NUM_CASCADES];
+		XMFLOAT4 DirectionalLightDirection;
+		XMFLOAT4 DirectionalLightColor;
+	};
+
+	struct ClusterLight
+	{
+		XMFLOAT4 PositionAndRadius;
+		XMFLOAT4 Color;
+	};
+
+	struct CBClusters
+	{
+		XMUINT4 ClusterCounts;
+		XMFLOAT4 ClusterScales;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include "Renderer/DeferredCommandRecorder.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DeferredCommandRecorder::DeferredCommandRecorder
+
+      Summary:  Constructor
+
+      Args:     UINT uNumContexts
+                  Number of deferred contexts
+
+      Modifies: [m_aDeferredContexts, m_aRenderContexts,
+                 m_aCommandLists].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    DeferredCommandRecorder::DeferredCommandRecorder(_In_ UINT uNumContexts)
+        : CommandRecorder(uNumContexts)
+        , m_aDeferredContexts()
+        , m_aRenderContexts()
+        , m_aCommandLists()
+    {
+        // empty
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DeferredCommandRecorder::Initialize
+
+      Summary:  Creates one deferred context per partition
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the contexts
+
+      Modifies: [m_aDeferredContexts, m_aRenderContexts,
+                 m_aCommandLists].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT DeferredCommandRecorder::Initialize(_In_ ID3D11Device* pDevice)
+    {
+        HRESULT hr = S_OK;
+
+        m_aDeferredContexts.resize(m_uNumContexts);
+        m_aRenderContexts.resize(m_uNumContexts);
+        m_aCommandLists.resize(m_uNumContexts);
+        for (UINT i = 0u; i < m_uNumContexts; ++i)
+        {
+            hr = pDevice->CreateDeferredContext(0u, m_aDeferredContexts[i].ReleaseAndGetAddressOf());
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+
+            m_aRenderContexts[i] = std::make_unique<D3D11RenderContext>(m_aDeferredContexts[i].Get());
+        }
+
+        return hr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DeferredCommandRecorder::beginRecording
+
+      Summary:  Returns the deferred context of a partition
+
+      Args:     UINT uContext
+                  Index of the partition
+                UINT uBegin
+                  First item of the partition
+                UINT uEnd
+                  One past the last item of the partition
+
+      Returns:  RenderContext*
+                  Deferred context to record to
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    RenderContext* DeferredCommandRecorder::beginRecording(_In_ UINT uContext, _In_ UINT uBegin, _In_ UINT uEnd)
+    {
+        UNREFERENCED_PARAMETER(uBegin);
+        UNREFERENCED_PARAMETER(uEnd);
+
+        return m_aRenderContexts[uContext].get();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DeferredCommandRecorder::endRecording
+
+      Summary:  Closes the command list of a partition. The deferred
+                context is reset to the default state
+
+      Args:     UINT uContext
+                  Index of the partition
+
+      Modifies: [m_aCommandLists].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT DeferredCommandRecorder::endRecording(_In_ UINT uContext)
+    {
+        return m_aDeferredContexts[uContext]->FinishCommandList(FALSE, m_aCommandLists[uContext].ReleaseAndGetAddressOf());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DeferredCommandRecorder::submitRecording
+
+      Summary:  Executes and releases the command list of a partition
+                and adds the counters of its deferred context to the
+                immediate context
+
+      Args:     RenderContext* pImmediateContext
+                  The immediate context to execute the list on
+                UINT uContext
+                  Index of the partition
+
+      Modifies: [m_aRenderContexts, m_aCommandLists].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void DeferredCommandRecorder::submitRecording(_In_opt_ RenderContext* pImmediateContext, _In_ UINT uContext)
+    {
+        if (pImmediateContext && m_aCommandLists[uContext])
+        {
+            pImmediateContext->ExecuteCommandList(m_aCommandLists[uContext].Get(), FALSE);
+            pImmediateContext->AddStats(m_aRenderContexts[uContext]->GetStats());
+        }
+
+        m_aRenderContexts[uContext]->ResetStats();
+        m_aCommandLists[uContext].Reset();
+    }
+}
\ No newline at end of file
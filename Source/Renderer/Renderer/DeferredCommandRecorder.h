@@ -0,0 +1,60 @@
+/*+===================================================================
+  File:      DEFERREDCOMMANDRECORDER.H
+
+  Summary:   DeferredCommandRecorder header file contains declarations
+             of the DeferredCommandRecorder class that records draws
+             into Direct3D 11 deferred contexts.
+
+  Classes: DeferredCommandRecorder
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/CommandRecorder.h"
+#include "Renderer/D3D11RenderContext.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    DeferredCommandRecorder
+
+      Summary:  Records every partition into its own deferred context
+                and executes the resulting command lists on the
+                immediate context. Deferred contexts start from the
+                default pipeline state, so every partition has to bind
+                the state it draws with, and the immediate context is
+                reset to the default state after a submit
+
+      Methods:  Initialize
+                  Creates the deferred contexts
+                DeferredCommandRecorder
+                  Constructor.
+                ~DeferredCommandRecorder
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class DeferredCommandRecorder final : public CommandRecorder
+    {
+    public:
+        DeferredCommandRecorder(_In_ UINT uNumContexts);
+        DeferredCommandRecorder(const DeferredCommandRecorder& other) = delete;
+        DeferredCommandRecorder(DeferredCommandRecorder&& other) = delete;
+        DeferredCommandRecorder& operator=(const DeferredCommandRecorder& other) = delete;
+        DeferredCommandRecorder& operator=(DeferredCommandRecorder&& other) = delete;
+        ~DeferredCommandRecorder() = default;
+
+        HRESULT Initialize(_In_ ID3D11Device* pDevice);
+
+    protected:
+        RenderContext* beginRecording(_In_ UINT uContext, _In_ UINT uBegin, _In_ UINT uEnd) override;
+        HRESULT endRecording(_In_ UINT uContext) override;
+        void submitRecording(_In_opt_ RenderContext* pImmediateContext, _In_ UINT uContext) override;
+
+    private:
+        std::vector<ComPtr<ID3D11DeviceContext>> m_aDeferredContexts;
+        std::vector<std::unique_ptr<D3D11RenderContext>> m_aRenderContexts;
+        std::vector<ComPtr<ID3D11CommandList>> m_aCommandLists;
+    };
+}
\ No newline at end of file
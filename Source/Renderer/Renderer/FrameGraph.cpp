@@ -0,0 +1,827 @@
+#include "Renderer/FrameGraph.h"
+
+#include <algorithm>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameGraph::FrameGraph
+
+      Summary:  Constructor
+
+      Modifies: [m_aPasses, m_aTextures, m_aPhysicalTextures,
+                 m_aSteps, m_aTrace, m_uCompileTraceSize].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FrameGraph::FrameGraph()
+        : m_aPasses()
+        , m_aTextures()
+        , m_aPhysicalTextures()
+        , m_aSteps()
+        , m_aTrace()
+        , m_uCompileTraceSize(0u)
+    {
+        // empty
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameGraph::ImportRenderTarget
+
+      Summary:  Adds a render target that is created and owned by the
+                caller
+
+      Args:     PCWSTR pszName
+                  Name of the texture
+                ID3D11RenderTargetView* pRenderTargetView
+                  Render target view of the texture
+                ID3D11ShaderResourceView* pShaderResourceView
+                  Shader resource view of the texture, null if the
+                  texture is never sampled
+
+      Modifies: [m_aTextures].
+
+      Returns:  UINT
+                  Handle to the texture
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT FrameGraph::ImportRenderTarget(
+        _In_ PCWSTR pszName,
+        _In_ ID3D11RenderTargetView* pRenderTargetView,
+        _In_opt_ ID3D11ShaderResourceView* pShaderResourceView
+    )
+    {
+        m_aTextures.push_back(
+            Resource
+            {
+                .szName = pszName,
+                .Desc = {},
+                .bImported = TRUE,
+                .bOutput = FALSE,
+                .iPhysicalIndex = -1,
+                .renderTargetView = pRenderTargetView,
+                .depthStencilView = nullptr,
+                .shaderResourceView = pShaderResourceView
+            }
+        );
+
+        return static_cast<UINT>(m_aTextures.size() - 1u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameGraph::ImportDepthStencil
+
+      Summary:  Adds a depth stencil that is created and owned by the
+                caller
+
+      Args:     PCWSTR pszName
+                  Name of the texture
+                ID3D11DepthStencilView* pDepthStencilView
+                  Depth stencil view of the texture
+                ID3D11ShaderResourceView* pShaderResourceView
+                  Shader resource view of the texture, null if the
+                  texture is never sampled
+
+      Modifies: [m_aTextures].
+
+      Returns:  UINT
+                  Handle to the texture
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT FrameGraph::ImportDepthStencil(
+        _In_ PCWSTR pszName,
+        _In_ ID3D11DepthStencilView* pDepthStencilView,
+        _In_opt_ ID3D11ShaderResourceView* pShaderResourceView
+    )
+    {
+        m_aTextures.push_back(
+            Resource
+            {
+                .szName = pszName,
+                .Desc = {},
+                .bImported = TRUE,
+                .bOutput = FALSE,
+                .iPhysicalIndex = -1,
+                .renderTargetView = nullptr,
+                .depthStencilView = pDepthStencilView,
+                .shaderResourceView = pShaderResourceView
+            }
+        );
+
+        return static_cast<UINT>(m_aTextures.size() - 1u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameGraph::CreateTexture
+
+      Summary:  Adds a transient texture. It is only allocated if a
+                pass that is not culled uses it, and it may share
+                memory with another transient texture of the same
+                description whose lifetime does not overlap
+
+      Args:     PCWSTR pszName
+                  Name of the texture
+                const FrameGraphTextureDesc& desc
+                  Size and format of the texture
+
+      Modifies: [m_aTextures].
+
+      Returns:  UINT
+                  Handle to the texture
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT FrameGraph::CreateTexture(_In_ PCWSTR pszName, _In_ const FrameGraphTextureDesc& desc)
+    {
+        m_aTextures.push_back(
+            Resource
+            {
+                .szName = pszName,
+                .Desc = desc,
+                .bImported = FALSE,
+                .bOutput = FALSE,
+                .iPhysicalIndex = -1,
+                .renderTargetView = nullptr,
+                .depthStencilView = nullptr,
+                .shaderResourceView = nullptr
+            }
+        );
+
+        return static_cast<UINT>(m_aTextures.size() - 1u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameGraph::MarkOutput
+
+      Summary:  Marks a texture as a result of the frame, the passes
+                writing it and the passes they depend on are never
+                culled
+
+      Args:     UINT uTexture
+                  Handle to the texture
+
+      Modifies: [m_aTextures].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void FrameGraph::MarkOutput(_In_ UINT uTexture)
+    {
+        assert(uTexture < m_aTextures.size());
+        m_aTextures[uTexture].bOutput = TRUE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameGraph::AddPass
+
+      Summary:  Adds a render pass. The pass binds its own render
+                targets and shaders when executed
+
+      Args:     PCWSTR pszName
+                  Name of the pass
+                ExecuteFunction execute
+                  Records the commands of the pass
+
+      Modifies: [m_aPasses].
+
+      Returns:  UINT
+                  Handle to the pass
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT FrameGraph::AddPass(_In_ PCWSTR pszName, _In_ ExecuteFunction execute)
+    {
+        m_aPasses.push_back(
+            Pass
+            {
+                .szName = pszName,
+                .Execute = std::move(execute),
+                .aReads = {},
+                .aWrites = {},
+                .bCulled = FALSE
+            }
+        );
+
+        return static_cast<UINT>(m_aPasses.size() - 1u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameGraph::ReadTexture
+
+      Summary:  Declares that a pass samples a texture. The pass runs
+                after the passes writing the texture that were added
+                before it and before those added after it, or after
+                every writer if none was added before it. The slot is
+                unbound before the texture is written again
+
+      Args:     UINT uPass
+                  Handle to the pass
+                UINT uTexture
+                  Handle to the texture
+                UINT uSlot
+                  Pixel shader slot the pass binds the texture to
+
+      Modifies: [m_aPasses].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void FrameGraph::ReadTexture(_In_ UINT uPass, _In_ UINT uTexture, _In_ UINT uSlot)
+    {
+        assert(uPass < m_aPasses.size() && uTexture < m_aTextures.size());
+        m_aPasses[uPass].aReads.push_back(TextureRead{ .uTexture = uTexture, .uSlot = uSlot });
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameGraph::ReadDepthStencil
+
+      Summary:  Declares that a pass tests against the depth of a depth
+                stencil without sampling it, so the passes writing the
+                depth before it are kept. A pass that also writes the
+                depth stencil stays ordered among its writers, and
+                nothing is unbound for the read
+
+      Args:     UINT uPass
+                  Handle to the pass
+                UINT uTexture
+                  Handle to the depth stencil
+
+      Modifies: [m_aPasses].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void FrameGraph::ReadDepthStencil(_In_ UINT uPass, _In_ UINT uTexture)
+    {
+        assert(uPass < m_aPasses.size() && uTexture < m_aTextures.size());
+        m_aPasses[uPass].aReads.push_back(TextureRead{ .uTexture = uTexture, .uSlot = NO_SLOT });
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameGraph::WriteTexture
+
+      Summary:  Declares that a pass renders to a texture. Passes
+                writing the same texture run in the order they were
+                added
+
+      Args:     UINT uPass
+                  Handle to the pass
+                UINT uTexture
+                  Handle to the texture
+
+      Modifies: [m_aPasses].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void FrameGraph::WriteTexture(_In_ UINT uPass, _In_ UINT uTexture)
+    {
+        assert(uPass < m_aPasses.size() && uTexture < m_aTextures.size());
+        m_aPasses[uPass].aWrites.push_back(uTexture);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameGraph::Compile
+
+      Summary:  Culls the passes that do not contribute to an output,
+                orders the remaining passes so that every texture is
+                read between the writers added around the reader,
+                assigns the transient textures to physical textures
+                and records where shader resources must be unbound.
+                Does not need a device
+
+      Modifies: [m_aPasses, m_aTextures, m_aPhysicalTextures,
+                 m_aSteps, m_aTrace, m_uCompileTraceSize].
+
+      Returns:  HRESULT
+                  Status code, E_FAIL if the passes form a cycle
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT FrameGraph::Compile()
+    {
+        m_aPhysicalTextures.clear();
+        m_aSteps.clear();
+        m_aTrace.clear();
+        m_uCompileTraceSize = 0u;
+
+        const UINT uNumPasses = static_cast<UINT>(m_aPasses.size());
+        const UINT uNumTextures = static_cast<UINT>(m_aTextures.size());
+
+        // Keep the passes writing an output, then the passes writing a texture a kept pass reads
+        std::vector<BOOL> abRequired(uNumTextures, FALSE);
+        for (UINT i = 0u; i < uNumTextures; ++i)
+        {
+            abRequired[i] = m_aTextures[i].bOutput;
+        }
+
+        for (Pass& pass : m_aPasses)
+        {
+            pass.bCulled = TRUE;
+        }
+
+        BOOL bChanged = TRUE;
+        while (bChanged)
+        {
+            bChanged = FALSE;
+            for (Pass& pass : m_aPasses)
+            {
+                if (!pass.bCulled)
+                {
+                    continue;
+                }
+
+                for (UINT uTexture : pass.aWrites)
+                {
+                    if (abRequired[uTexture])
+                    {
+                        pass.bCulled = FALSE;
+                        break;
+                    }
+                }
+
+                if (!pass.bCulled)
+                {
+                    for (const TextureRead& read : pass.aReads)
+                    {
+                        abRequired[read.uTexture] = TRUE;
+                    }
+                    bChanged = TRUE;
+                }
+            }
+        }
+
+        // Writers of a texture run in the order they were added. A reader runs after the last writer added before
+        // it and before the next one, so a pass can sample what the earlier passes wrote while later passes keep
+        // writing the texture. A reader added before every writer waits for all of them
+        std::vector<std::vector<UINT>> aaSuccessors(uNumPasses);
+        std::vector<UINT> aNumPredecessors(uNumPasses, 0u);
+        for (UINT uTexture = 0u; uTexture < uNumTextures; ++uTexture)
+        {
+            std::vector<UINT> aWriters;
+            std::vector<UINT> aReaders;
+            for (UINT i = 0u; i < uNumPasses; ++i)
+            {
+                if (m_aPasses[i].bCulled)
+                {
+                    continue;
+                }
+
+                const std::vector<UINT>& aWrites = m_aPasses[i].aWrites;
+                if (std::find(aWrites.begin(), aWrites.end(), uTexture) != aWrites.end())
+                {
+                    aWriters.push_back(i);
+                }
+                else
+                {
+                    for (const TextureRead& read : m_aPasses[i].aReads)
+                    {
+                        if (read.uTexture == uTexture)
+                        {
+                            aReaders.push_back(i);
+                            break;
+                        }
+                    }
+                }
+            }
+
+            for (size_t i = 1u; i < aWriters.size(); ++i)
+            {
+                aaSuccessors[aWriters[i - 1u]].push_back(aWriters[i]);
+                ++aNumPredecessors[aWriters[i]];
+            }
+
+            if (aWriters.empty())
+            {
+                continue;
+            }
+
+            for (UINT uReader : aReaders)
+            {
+                std::vector<UINT>::const_iterator next = std::upper_bound(aWriters.cbegin(), aWriters.cend(), uReader);
+                if (next == aWriters.cbegin())
+                {
+                    aaSuccessors[aWriters.back()].push_back(uReader);
+                    ++aNumPredecessors[uReader];
+                    continue;
+                }
+
+                aaSuccessors[*(next - 1)].push_back(uReader);
+                ++aNumPredecessors[uReader];
+
+                if (next != aWriters.cend())
+                {
+                    aaSuccessors[uReader].push_back(*next);
+                    ++aNumPredecessors[*next];
+                }
+            }
+        }
+
+        // Topological sort, ties keep the order in which the passes were added
+        std::vector<UINT> aOrder;
+        std::vector<BOOL> abScheduled(uNumPasses, FALSE);
+        UINT uNumLive = 0u;
+        for (const Pass& pass : m_aPasses)
+        {
+            uNumLive += pass.bCulled ? 0u : 1u;
+        }
+
+        while (aOrder.size() < uNumLive)
+        {
+            UINT uNext = uNumPasses;
+            for (UINT i = 0u; i < uNumPasses; ++i)
+            {
+                if (!m_aPasses[i].bCulled && !abScheduled[i] && aNumPredecessors[i] == 0u)
+                {
+                    uNext = i;
+                    break;
+                }
+            }
+
+            if (uNext == uNumPasses)
+            {
+                OutputDebugString(L"Frame graph has a cycle between its passes\n");
+                return E_FAIL;
+            }
+
+            abScheduled[uNext] = TRUE;
+            aOrder.push_back(uNext);
+            for (UINT uSuccessor : aaSuccessors[uNext])
+            {
+                --aNumPredecessors[uSuccessor];
+            }
+        }
+
+        for (const Pass& pass : m_aPasses)
+        {
+            if (pass.bCulled)
+            {
+                m_aTrace.push_back(FrameGraphTraceEntry{ .Event = eFrameGraphTraceEvent::CULL_PASS, .szName = pass.szName, .uValue = 0u });
+            }
+        }
+
+        // Lifetimes of the transient textures in the executed order
+        const UINT uUnused = static_cast<UINT>(-1);
+        std::vector<UINT> aFirstUse(uNumTextures, uUnused);
+        std::vector<UINT> aLastUse(uNumTextures, 0u);
+        for (UINT uPosition = 0u; uPosition < aOrder.size(); ++uPosition)
+        {
+            const Pass& pass = m_aPasses[aOrder[uPosition]];
+
+            std::vector<UINT> aUsed = pass.aWrites;
+            for (const TextureRead& read : pass.aReads)
+            {
+                aUsed.push_back(read.uTexture);
+            }
+
+            for (UINT uTexture : aUsed)
+            {
+                aFirstUse[uTexture] = aFirstUse[uTexture] == uUnused ? uPosition : aFirstUse[uTexture];
+                aLastUse[uTexture] = uPosition;
+            }
+        }
+
+        // Alias transient textures with the same description whose lifetimes do not overlap
+        for (UINT uPosition = 0u; uPosition < aOrder.size(); ++uPosition)
+        {
+            for (UINT uTexture = 0u; uTexture < uNumTextures; ++uTexture)
+            {
+                Resource& texture = m_aTextures[uTexture];
+                if (texture.bImported || aFirstUse[uTexture] != uPosition)
+                {
+                    continue;
+                }
+
+                texture.iPhysicalIndex = -1;
+                for (UINT i = 0u; i < m_aPhysicalTextures.size(); ++i)
+                {
+                    const FrameGraphTextureDesc& desc = m_aPhysicalTextures[i].Desc;
+                    if (desc.uWidth == texture.Desc.uWidth && desc.uHeight == texture.Desc.uHeight && desc.Format == texture.Desc.Format
+                        && m_aPhysicalTextures[i].uLastUse < uPosition)
+                    {
+                        texture.iPhysicalIndex = static_cast<INT>(i);
+                        break;
+                    }
+                }
+
+                if (texture.iPhysicalIndex < 0)
+                {
+                    m_aPhysicalTextures.push_back(PhysicalTexture{ .Desc = texture.Desc, .uLastUse = 0u });
+                    texture.iPhysicalIndex = static_cast<INT>(m_aPhysicalTextures.size() - 1u);
+                }
+
+                m_aPhysicalTextures[texture.iPhysicalIndex].uLastUse = aLastUse[uTexture];
+                m_aTrace.push_back(
+                    FrameGraphTraceEntry
+                    {
+                        .Event = eFrameGraphTraceEvent::ALLOCATE_TEXTURE,
+                        .szName = texture.szName,
+                        .uValue = static_cast<UINT>(texture.iPhysicalIndex)
+                    }
+                );
+            }
+        }
+
+        // Unbind every slot a texture is sampled from before a pass renders to it
+        for (UINT uPass : aOrder)
+        {
+            std::vector<UINT> aSlots;
+            for (UINT uTexture : m_aPasses[uPass].aWrites)
+            {
+                UINT uKey = getPhysicalKey(uTexture);
+                for (UINT uReader : aOrder)
+                {
+                    for (const TextureRead& read : m_aPasses[uReader].aReads)
+                    {
+                        if (read.uSlot != NO_SLOT && getPhysicalKey(read.uTexture) == uKey
+                            && std::find(aSlots.begin(), aSlots.end(), read.uSlot) == aSlots.end())
+                        {
+                            aSlots.push_back(read.uSlot);
+                        }
+                    }
+                }
+            }
+
+            for (UINT uSlot : aSlots)
+            {
+                m_aSteps.push_back(Step{ .bUnbind = TRUE, .uIndex = uSlot });
+            }
+            m_aSteps.push_back(Step{ .bUnbind = FALSE, .uIndex = uPass });
+        }
+
+        m_uCompileTraceSize = m_aTrace.size();
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameGraph::Realize
+
+      Summary:  Creates the physical textures that do not exist yet
+                and hands their views to the transient textures
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the textures
+
+      Modifies: [m_aPhysicalTextures, m_aTextures].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT FrameGraph::Realize(_In_ ID3D11Device* pDevice)
+    {
+        HRESULT hr = S_OK;
+
+        for (PhysicalTexture& physicalTexture : m_aPhysicalTextures)
+        {
+            if (physicalTexture.texture)
+            {
+                continue;
+            }
+
+            const FrameGraphTextureDesc& desc = physicalTexture.Desc;
+            BOOL bDepth = isDepthFormat(desc.Format);
+
+            // Depth textures are created typeless so that they can also be sampled
+            DXGI_FORMAT textureFormat = desc.Format;
+            DXGI_FORMAT viewFormat = desc.Format;
+            if (desc.Format == DXGI_FORMAT_D24_UNORM_S8_UINT)
+            {
+                textureFormat = DXGI_FORMAT_R24G8_TYPELESS;
+                viewFormat = DXGI_FORMAT_R24_UNORM_X8_TYPELESS;
+            }
+            else if (desc.Format == DXGI_FORMAT_D32_FLOAT)
+            {
+                textureFormat = DXGI_FORMAT_R32_TYPELESS;
+                viewFormat = DXGI_FORMAT_R32_FLOAT;
+            }
+            else if (desc.Format == DXGI_FORMAT_D16_UNORM)
+            {
+                textureFormat = DXGI_FORMAT_R16_TYPELESS;
+                viewFormat = DXGI_FORMAT_R16_UNORM;
+            }
+            else if (desc.Format == DXGI_FORMAT_D32_FLOAT_S8X24_UINT)
+            {
+                textureFormat = DXGI_FORMAT_R32G8X24_TYPELESS;
+                viewFormat = DXGI_FORMAT_R32_FLOAT_X8X24_TYPELESS;
+            }
+
+            D3D11_TEXTURE2D_DESC textureDesc =
+            {
+                .Width = desc.uWidth,
+                .Height = desc.uHeight,
+                .MipLevels = 1u,
+                .ArraySize = 1u,
+                .Format = textureFormat,
+                .SampleDesc = {.Count = 1u, .Quality = 0u },
+                .Usage = D3D11_USAGE_DEFAULT,
+                .BindFlags = static_cast<UINT>(bDepth ? D3D11_BIND_DEPTH_STENCIL : D3D11_BIND_RENDER_TARGET) | D3D11_BIND_SHADER_RESOURCE,
+                .CPUAccessFlags = 0u,
+                .MiscFlags = 0u
+            };
+            hr = pDevice->CreateTexture2D(&textureDesc, nullptr, physicalTexture.texture.GetAddressOf());
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+
+            if (bDepth)
+            {
+                D3D11_DEPTH_STENCIL_VIEW_DESC dsvDesc =
+                {
+                    .Format = desc.Format,
+                    .ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2D,
+                    .Flags = 0u,
+                    .Texture2D = {.MipSlice = 0u }
+                };
+                hr = pDevice->CreateDepthStencilView(physicalTexture.texture.Get(), &dsvDesc, physicalTexture.depthStencilView.GetAddressOf());
+            }
+            else
+            {
+                hr = pDevice->CreateRenderTargetView(physicalTexture.texture.Get(), nullptr, physicalTexture.renderTargetView.GetAddressOf());
+            }
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+
+            D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc =
+            {
+                .Format = viewFormat,
+                .ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D,
+                .Texture2D = {.MostDetailedMip = 0u, .MipLevels = 1u }
+            };
+            hr = pDevice->CreateShaderResourceView(physicalTexture.texture.Get(), &srvDesc, physicalTexture.shaderResourceView.GetAddressOf());
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+        }
+
+        for (Resource& texture : m_aTextures)
+        {
+            if (texture.bImported || texture.iPhysicalIndex < 0)
+            {
+                continue;
+            }
+
+            const PhysicalTexture& physicalTexture = m_aPhysicalTextures[texture.iPhysicalIndex];
+            texture.renderTargetView = physicalTexture.renderTargetView;
+            texture.depthStencilView = physicalTexture.depthStencilView;
+            texture.shaderResourceView = physicalTexture.shaderResourceView;
+        }
+
+        return hr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameGraph::Execute
+
+      Summary:  Runs the compiled passes and unbinds shader resources
+                in between. With a null context nothing is recorded on
+                the device and only the trace is written
+
+      Args:     RenderContext* pContext
+                  The render context to record the passes to
+
+      Modifies: [m_aTrace].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void FrameGraph::Execute(_In_opt_ RenderContext* pContext)
+    {
+        m_aTrace.resize(m_uCompileTraceSize);
+
+        for (const Step& step : m_aSteps)
+        {
+            if (step.bUnbind)
+            {
+                if (pContext)
+                {
+                    ID3D11ShaderResourceView* const pNullView = nullptr;
+                    pContext->PSSetShaderResources(step.uIndex, 1u, &pNullView);
+                }
+
+                m_aTrace.push_back(FrameGraphTraceEntry{ .Event = eFrameGraphTraceEvent::UNBIND_SHADER_RESOURCE, .szName = L"", .uValue = step.uIndex });
+            }
+            else
+            {
+                const Pass& pass = m_aPasses[step.uIndex];
+                if (pContext && pass.Execute)
+                {
+                    pass.Execute(*this, pContext);
+                }
+
+                m_aTrace.push_back(FrameGraphTraceEntry{ .Event = eFrameGraphTraceEvent::EXECUTE_PASS, .szName = pass.szName, .uValue = 0u });
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameGraph::Reset
+
+      Summary:  Removes every pass and texture and releases the
+                physical textures
+
+      Modifies: [m_aPasses, m_aTextures, m_aPhysicalTextures,
+                 m_aSteps, m_aTrace, m_uCompileTraceSize].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void FrameGraph::Reset()
+    {
+        m_aPasses.clear();
+        m_aTextures.clear();
+        m_aPhysicalTextures.clear();
+        m_aSteps.clear();
+        m_aTrace.clear();
+        m_uCompileTraceSize = 0u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameGraph::GetRenderTargetView
+
+      Summary:  Returns the render target view of a texture
+
+      Args:     UINT uTexture
+                  Handle to the texture
+
+      Returns:  ID3D11RenderTargetView*
+                  Render target view, null for depth textures
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ID3D11RenderTargetView* FrameGraph::GetRenderTargetView(_In_ UINT uTexture) const
+    {
+        return m_aTextures[uTexture].renderTargetView.Get();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameGraph::GetDepthStencilView
+
+      Summary:  Returns the depth stencil view of a texture
+
+      Args:     UINT uTexture
+                  Handle to the texture
+
+      Returns:  ID3D11DepthStencilView*
+                  Depth stencil view, null for color textures
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ID3D11DepthStencilView* FrameGraph::GetDepthStencilView(_In_ UINT uTexture) const
+    {
+        return m_aTextures[uTexture].depthStencilView.Get();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameGraph::GetShaderResourceView
+
+      Summary:  Returns the shader resource view of a texture
+
+      Args:     UINT uTexture
+                  Handle to the texture
+
+      Returns:  ID3D11ShaderResourceView*
+                  Shader resource view
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ID3D11ShaderResourceView* FrameGraph::GetShaderResourceView(_In_ UINT uTexture) const
+    {
+        return m_aTextures[uTexture].shaderResourceView.Get();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameGraph::GetTrace
+
+      Summary:  Returns the culled passes and allocated textures of
+                the last compile followed by the unbinds and passes of
+                the last execute
+
+      Returns:  const std::vector<FrameGraphTraceEntry>&
+                  Trace entries
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::vector<FrameGraphTraceEntry>& FrameGraph::GetTrace() const
+    {
+        return m_aTrace;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameGraph::GetNumPhysicalTextures
+
+      Summary:  Returns the number of textures the transient textures
+                were aliased to
+
+      Returns:  UINT
+                  Number of physical textures
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT FrameGraph::GetNumPhysicalTextures() const
+    {
+        return static_cast<UINT>(m_aPhysicalTextures.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameGraph::isDepthFormat
+
+      Summary:  Returns whether the format is a depth stencil format
+
+      Args:     DXGI_FORMAT format
+                  Format of a transient texture
+
+      Returns:  BOOL
+                  TRUE for depth stencil formats
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL FrameGraph::isDepthFormat(_In_ DXGI_FORMAT format)
+    {
+        return format == DXGI_FORMAT_D24_UNORM_S8_UINT || format == DXGI_FORMAT_D32_FLOAT
+            || format == DXGI_FORMAT_D16_UNORM || format == DXGI_FORMAT_D32_FLOAT_S8X24_UINT;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameGraph::getPhysicalKey
+
+      Summary:  Returns a key that is equal for textures sharing
+                memory, imported textures never share memory
+
+      Args:     UINT uTexture
+                  Handle to the texture
+
+      Returns:  UINT
+                  Key of the memory of the texture
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT FrameGraph::getPhysicalKey(_In_ UINT uTexture) const
+    {
+        const Resource& texture = m_aTextures[uTexture];
+
+        return texture.bImported ? (0x80000000u | uTexture) : static_cast<UINT>(texture.iPhysicalIndex);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,217 @@
+/*+===================================================================
+  File:      FRAMEGRAPH.H
+
+  Summary:   FrameGraph header file contains declarations of the
+             FrameGraph class that orders the render passes of a
+             frame from the resources they read and write, culls the
+             passes nothing depends on, aliases transient render
+             targets and unbinds shader resources before they are
+             written.
+
+  Classes: FrameGraph
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/RenderContext.h"
+
+#include <functional>
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   FrameGraphTextureDesc
+
+      Summary:  Description of a transient texture. Depth formats
+                create a depth stencil view, any other format a render
+                target view, both also create a shader resource view
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct FrameGraphTextureDesc
+    {
+        UINT uWidth;
+        UINT uHeight;
+        DXGI_FORMAT Format;
+    };
+
+    /*E+E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E
+      Enum:     eFrameGraphTraceEvent
+
+      Summary:  Events recorded in the trace of a frame graph
+    E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E-E*/
+    enum class eFrameGraphTraceEvent
+    {
+        CULL_PASS,
+        ALLOCATE_TEXTURE,
+        UNBIND_SHADER_RESOURCE,
+        EXECUTE_PASS,
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   FrameGraphTraceEntry
+
+      Summary:  Entry of the trace. szName is the pass or the texture,
+                uValue the physical texture index or the pixel shader
+                slot
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct FrameGraphTraceEntry
+    {
+        eFrameGraphTraceEvent Event;
+        std::wstring szName;
+        UINT uValue;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    FrameGraph
+
+      Summary:  Render passes and the textures they use. Compile
+                works without a device, so the resulting order,
+                culling, aliasing and unbinds can be checked from the
+                trace. Realize creates the transient textures and
+                Execute runs the passes, with a null context it only
+                records the trace
+
+      Methods:  ImportRenderTarget
+                  Adds a render target owned by the caller
+                ImportDepthStencil
+                  Adds a depth stencil owned by the caller
+                CreateTexture
+                  Adds a transient texture owned by the graph
+                MarkOutput
+                  Keeps the passes writing the texture alive
+                AddPass
+                  Adds a render pass
+                ReadTexture
+                  Declares that a pass samples a texture at a pixel
+                  shader slot
+                ReadDepthStencil
+                  Declares that a pass tests against a depth stencil
+                WriteTexture
+                  Declares that a pass renders to a texture
+                Compile
+                  Orders and culls the passes and aliases transient
+                  textures
+                Realize
+                  Creates the transient textures
+                Execute
+                  Runs the compiled passes
+                Reset
+                  Removes every pass and texture
+                GetRenderTargetView
+                  Returns the render target view of a texture
+                GetDepthStencilView
+                  Returns the depth stencil view of a texture
+                GetShaderResourceView
+                  Returns the shader resource view of a texture
+                GetTrace
+                  Returns the compile and the last execute trace
+                GetNumPhysicalTextures
+                  Returns the number of textures after aliasing
+                FrameGraph
+                  Constructor.
+                ~FrameGraph
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class FrameGraph final
+    {
+    public:
+        using ExecuteFunction = std::function<void(_In_ const FrameGraph& graph, _In_ RenderContext* pContext)>;
+
+        FrameGraph();
+        FrameGraph(const FrameGraph& other) = delete;
+        FrameGraph(FrameGraph&& other) = delete;
+        FrameGraph& operator=(const FrameGraph& other) = delete;
+        FrameGraph& operator=(FrameGraph&& other) = delete;
+        ~FrameGraph() = default;
+
+        UINT ImportRenderTarget(
+            _In_ PCWSTR pszName,
+            _In_ ID3D11RenderTargetView* pRenderTargetView,
+            _In_opt_ ID3D11ShaderResourceView* pShaderResourceView
+        );
+        UINT ImportDepthStencil(
+            _In_ PCWSTR pszName,
+            _In_ ID3D11DepthStencilView* pDepthStencilView,
+            _In_opt_ ID3D11ShaderResourceView* pShaderResourceView
+        );
+        UINT CreateTexture(_In_ PCWSTR pszName, _In_ const FrameGraphTextureDesc& desc);
+        void MarkOutput(_In_ UINT uTexture);
+
+        UINT AddPass(_In_ PCWSTR pszName, _In_ ExecuteFunction execute);
+        void ReadTexture(_In_ UINT uPass, _In_ UINT uTexture, _In_ UINT uSlot);
+        void ReadDepthStencil(_In_ UINT uPass, _In_ UINT uTexture);
+        void WriteTexture(_In_ UINT uPass, _In_ UINT uTexture);
+
+        HRESULT Compile();
+        HRESULT Realize(_In_ ID3D11Device* pDevice);
+        void Execute(_In_opt_ RenderContext* pContext);
+        void Reset();
+
+        ID3D11RenderTargetView* GetRenderTargetView(_In_ UINT uTexture) const;
+        ID3D11DepthStencilView* GetDepthStencilView(_In_ UINT uTexture) const;
+        ID3D11ShaderResourceView* GetShaderResourceView(_In_ UINT uTexture) const;
+
+        const std::vector<FrameGraphTraceEntry>& GetTrace() const;
+        UINT GetNumPhysicalTextures() const;
+
+    private:
+        static BOOL isDepthFormat(_In_ DXGI_FORMAT format);
+        UINT getPhysicalKey(_In_ UINT uTexture) const;
+
+    private:
+        // Slot of the reads that bind the texture as the depth stencil instead of sampling it
+        static constexpr UINT NO_SLOT = static_cast<UINT>(-1);
+
+        struct TextureRead
+        {
+            UINT uTexture;
+            UINT uSlot;
+        };
+
+        struct Pass
+        {
+            std::wstring szName;
+            ExecuteFunction Execute;
+            std::vector<TextureRead> aReads;
+            std::vector<UINT> aWrites;
+            BOOL bCulled;
+        };
+
+        struct PhysicalTexture
+        {
+            FrameGraphTextureDesc Desc;
+            UINT uLastUse;
+            ComPtr<ID3D11Texture2D> texture;
+            ComPtr<ID3D11RenderTargetView> renderTargetView;
+            ComPtr<ID3D11DepthStencilView> depthStencilView;
+            ComPtr<ID3D11ShaderResourceView> shaderResourceView;
+        };
+
+        struct Resource
+        {
+            std::wstring szName;
+            FrameGraphTextureDesc Desc;
+            BOOL bImported;
+            BOOL bOutput;
+            INT iPhysicalIndex;
+            ComPtr<ID3D11RenderTargetView> renderTargetView;
+            ComPtr<ID3D11DepthStencilView> depthStencilView;
+            ComPtr<ID3D11ShaderResourceView> shaderResourceView;
+        };
+
+        struct Step
+        {
+            BOOL bUnbind;
+            UINT uIndex;
+        };
+
+        std::vector<Pass> m_aPasses;
+        std::vector<Resource> m_aTextures;
+        std::vector<PhysicalTexture> m_aPhysicalTextures;
+        std::vector<Step> m_aSteps;
+        std::vector<FrameGraphTraceEntry> m_aTrace;
+        size_t m_uCompileTraceSize;
+    };
+}
\ No newline at end of file
@@ -81,15 +81,38 @@ namespace library
         return static_cast<UINT>(m_aInstanceData.size());
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::GetInstanceBounds
+
+      Summary:  Returns the bounds of the mesh placed at every
+                instance, in the local space of the renderable. Needs
+                no device
+
+      Args:     std::vector<BoundingBox>& outBounds
+                  Bounds of every instance
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void InstancedRenderable::GetInstanceBounds(_Out_ std::vector<BoundingBox>& outBounds) const
+    {
+        BoundingBox meshBounds;
+        BoundingBox::CreateFromPoints(meshBounds, GetNumVertices(), &getVertices()->Position, sizeof(SimpleVertex));
+
+        outBounds.resize(m_aInstanceData.size());
+        for (size_t i = 0u; i < m_aInstanceData.size(); ++i)
+        {
+            meshBounds.Transform(outBounds[i], m_aInstanceData[i].Transformation);
+        }
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   InstancedRenderable::initializeInstance
 
-      Summary:  Creates an instance buffer
+      Summary:  Creates an instance buffer and grows the local bounds
+                to cover every instance
 
       Args:     ID3D11Device* pDevice
                   Pointer to a Direct3D 11 device
 
-      Modifies: [m_instanceBuffer].
+      Modifies: [m_instanceBuffer, m_localBounds, m_uVersion].
 
       Returns:  HRESULT
                   Status code
@@ -126,6 +149,16 @@ namespace library
             return hr;
         }
 
+        const BoundingBox meshBounds = m_localBounds;
+        meshBounds.Transform(m_localBounds, m_aInstanceData[0].Transformation);
+        for (size_t i = 1u; i < m_aInstanceData.size(); ++i)
+        {
+            BoundingBox instanceBounds;
+            meshBounds.Transform(instanceBounds, m_aInstanceData[i].Transformation);
+            BoundingBox::CreateMerged(m_localBounds, m_localBounds, instanceBounds);
+        }
+        markDirty();
+
         return hr;
     }
 }
\ No newline at end of file
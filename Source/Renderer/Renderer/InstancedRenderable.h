@@ -29,6 +29,8 @@ namespace library
                   Returns a instance buffer
                 GetNumInstances
                   Returns the number of instance data
+                GetInstanceBounds
+                  Returns the local bounds of every instance
                 initializeInstance
                   Initialize the instance buffer
                 InstancedRenderable
@@ -54,6 +56,7 @@ namespace library
 
         virtual ComPtr<ID3D11Buffer>& GetInstanceBuffer();
         virtual UINT GetNumInstances() const;
+        void GetInstanceBounds(_Out_ std::vector<BoundingBox>& outBounds) const;
 
         UINT GetNumVertices() const override = 0;
         UINT GetNumIndices() const override = 0;
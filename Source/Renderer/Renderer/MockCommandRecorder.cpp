@@ -0,0 +1,178 @@
+#include "Renderer/MockCommandRecorder.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MockCommandRecorder::MockCommandRecorder
+
+      Summary:  Constructor, creates one recording context per
+                partition that keeps its calls in order
+
+      Args:     UINT uNumContexts
+                  Maximum number of partitions
+
+      Modifies: [m_aRenderContexts, m_aEndRecordingResults, m_aEvents,
+                 m_mutex].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    MockCommandRecorder::MockCommandRecorder(_In_ UINT uNumContexts)
+        : CommandRecorder(uNumContexts)
+        , m_aRenderContexts()
+        , m_aEndRecordingResults(m_uNumContexts, S_OK)
+        , m_aEvents()
+        , m_mutex()
+    {
+        for (UINT i = 0u; i < m_uNumContexts; ++i)
+        {
+            m_aRenderContexts.push_back(std::make_unique<RecordingRenderContext>());
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MockCommandRecorder::GetEvents
+
+      Summary:  Returns a copy of the logged events
+
+      Returns:  std::vector<CommandRecorderEvent>
+                  Logged events
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    std::vector<CommandRecorderEvent> MockCommandRecorder::GetEvents()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return m_aEvents;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MockCommandRecorder::ClearEvents
+
+      Summary:  Removes the logged events
+
+      Modifies: [m_aEvents].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void MockCommandRecorder::ClearEvents()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_aEvents.clear();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MockCommandRecorder::GetRenderContext
+
+      Summary:  Returns the recording context of a partition. It holds
+                the calls of the partition until they are submitted
+
+      Args:     UINT uContext
+                  Index of the partition
+
+      Returns:  RecordingRenderContext&
+                  Recording context of the partition
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    RecordingRenderContext& MockCommandRecorder::GetRenderContext(_In_ UINT uContext)
+    {
+        return *m_aRenderContexts[uContext];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MockCommandRecorder::SetEndRecordingResult
+
+      Summary:  Sets the status code the end of a partition returns,
+                such as the failure of closing a command list
+
+      Args:     UINT uContext
+                  Index of the partition
+                HRESULT hr
+                  Status code of the end of the partition
+
+      Modifies: [m_aEndRecordingResults].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void MockCommandRecorder::SetEndRecordingResult(_In_ UINT uContext, _In_ HRESULT hr)
+    {
+        m_aEndRecordingResults[uContext] = hr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MockCommandRecorder::beginRecording
+
+      Summary:  Logs the start of a partition and clears its recording
+                context
+
+      Args:     UINT uContext
+                  Index of the partition
+                UINT uBegin
+                  First item of the partition
+                UINT uEnd
+                  One past the last item of the partition
+
+      Modifies: [m_aRenderContexts, m_aEvents].
+
+      Returns:  RenderContext*
+                  Recording context of the partition
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    RenderContext* MockCommandRecorder::beginRecording(_In_ UINT uContext, _In_ UINT uBegin, _In_ UINT uEnd)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_aEvents.push_back(CommandRecorderEvent{ .Event = eCommandRecorderEvent::BEGIN_RECORDING, .uContext = uContext, .uBegin = uBegin, .uEnd = uEnd });
+        }
+
+        m_aRenderContexts[uContext]->Reset();
+
+        return m_aRenderContexts[uContext].get();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MockCommandRecorder::endRecording
+
+      Summary:  Logs the end of a partition
+
+      Args:     UINT uContext
+                  Index of the partition
+
+      Modifies: [m_aEvents].
+
+      Returns:  HRESULT
+                  Status code set by SetEndRecordingResult, S_OK by
+                  default
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT MockCommandRecorder::endRecording(_In_ UINT uContext)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_aEvents.push_back(CommandRecorderEvent{ .Event = eCommandRecorderEvent::END_RECORDING, .uContext = uContext, .uBegin = 0u, .uEnd = 0u });
+
+        return m_aEndRecordingResults[uContext];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MockCommandRecorder::submitRecording
+
+      Summary:  Logs the submit of a partition. Like a deferred
+                context, a command list is executed and the counters
+                of the partition are added to the immediate context,
+                and the recording is dropped either way
+
+      Args:     RenderContext* pImmediateContext
+                  The immediate context, null to drop the recording
+                UINT uContext
+                  Index of the partition
+
+      Modifies: [m_aRenderContexts, m_aEvents].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void MockCommandRecorder::submitRecording(_In_opt_ RenderContext* pImmediateContext, _In_ UINT uContext)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_aEvents.push_back(CommandRecorderEvent{ .Event = eCommandRecorderEvent::SUBMIT, .uContext = uContext, .uBegin = 0u, .uEnd = 0u });
+        }
+
+        if (pImmediateContext)
+        {
+            pImmediateContext->ExecuteCommandList(nullptr, FALSE);
+            pImmediateContext->AddStats(m_aRenderContexts[uContext]->GetStats());
+        }
+        m_aRenderContexts[uContext]->Reset();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,102 @@
+/*+===================================================================
+  File:      MOCKCOMMANDRECORDER.H
+
+  Summary:   MockCommandRecorder header file contains declarations of
+             the MockCommandRecorder class that records the calls of
+             a CommandRecorder without a device, so partitioning,
+             submit order and failed recordings can be checked
+             headless.
+
+  Classes: MockCommandRecorder
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/CommandRecorder.h"
+#include "Renderer/RecordingRenderContext.h"
+
+#include <mutex>
+
+namespace library
+{
+    /*E+E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E
+      Enum:     eCommandRecorderEvent
+
+      Summary:  Calls recorded by the mock command recorder
+    E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E-E*/
+    enum class eCommandRecorderEvent
+    {
+        BEGIN_RECORDING,
+        END_RECORDING,
+        SUBMIT,
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   CommandRecorderEvent
+
+      Summary:  Call of the mock command recorder. uBegin and uEnd are
+                the item range of the partition, only set for
+                BEGIN_RECORDING
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct CommandRecorderEvent
+    {
+        eCommandRecorderEvent Event;
+        UINT uContext;
+        UINT uBegin;
+        UINT uEnd;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    MockCommandRecorder
+
+      Summary:  Command recorder that records every partition to its
+                own recording context and logs every call. Submitting
+                to an immediate context executes one command list and
+                adds the counters of the partition to it, submitting to
+                null drops the partition. Events of different
+                partitions interleave in the order the worker threads
+                reach them
+
+      Methods:  GetEvents
+                  Returns a copy of the logged events
+                ClearEvents
+                  Removes the logged events
+                GetRenderContext
+                  Returns the recording context of a partition
+                SetEndRecordingResult
+                  Sets the status code the end of a partition returns
+                MockCommandRecorder
+                  Constructor.
+                ~MockCommandRecorder
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class MockCommandRecorder final : public CommandRecorder
+    {
+    public:
+        MockCommandRecorder(_In_ UINT uNumContexts);
+        MockCommandRecorder(const MockCommandRecorder& other) = delete;
+        MockCommandRecorder(MockCommandRecorder&& other) = delete;
+        MockCommandRecorder& operator=(const MockCommandRecorder& other) = delete;
+        MockCommandRecorder& operator=(MockCommandRecorder&& other) = delete;
+        ~MockCommandRecorder() = default;
+
+        std::vector<CommandRecorderEvent> GetEvents();
+        void ClearEvents();
+        RecordingRenderContext& GetRenderContext(_In_ UINT uContext);
+        void SetEndRecordingResult(_In_ UINT uContext, _In_ HRESULT hr);
+
+    protected:
+        RenderContext* beginRecording(_In_ UINT uContext, _In_ UINT uBegin, _In_ UINT uEnd) override;
+        HRESULT endRecording(_In_ UINT uContext) override;
+        void submitRecording(_In_opt_ RenderContext* pImmediateContext, _In_ UINT uContext) override;
+
+    private:
+        std::vector<std::unique_ptr<RecordingRenderContext>> m_aRenderContexts;
+        std::vector<HRESULT> m_aEndRecordingResults;
+        std::vector<CommandRecorderEvent> m_aEvents;
+        std::mutex m_mutex;
+    };
+}
\ No newline at end of file
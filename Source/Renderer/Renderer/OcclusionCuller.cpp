@@ -0,0 +1,758 @@
+#include "Renderer/OcclusionCuller.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   OcclusionCuller::BuildColumnOccluders
+
+      Summary:  Merge axis aligned cubes of equal size into large
+                occluder boxes. Cubes stacked on the same footprint
+                form a column, which is solid if its cubes leave no
+                gap. The columns are grouped into square cells, and a
+                cell whose columns are all present and solid becomes
+                one box from the highest column bottom to the lowest
+                column top, which lies inside the cubes. Cells with
+                missing or hollow columns make no occluder
+
+      Args:     const std::vector<BoundingBox>& aCubes
+                  World bounds of the cubes
+                UINT uCellSize
+                  Number of columns along each side of a cell
+                std::vector<BoundingBox>& outOccluders
+                  The occluder boxes, ordered by cell
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void OcclusionCuller::BuildColumnOccluders(
+        _In_ const std::vector<BoundingBox>& aCubes,
+        _In_ UINT uCellSize,
+        _Out_ std::vector<BoundingBox>& outOccluders
+    )
+    {
+        outOccluders.clear();
+        if (aCubes.empty() || uCellSize == 0u)
+        {
+            return;
+        }
+
+        struct Span
+        {
+            XMFLOAT3 Min;
+            XMFLOAT3 Max;
+            FLOAT filled;
+            UINT uNumColumns;
+            BOOL bSolid;
+        };
+
+        auto getKey = [](_In_ INT x, _In_ INT z)
+        {
+            return (static_cast<UINT64>(static_cast<UINT>(x)) << 32u) | static_cast<UINT64>(static_cast<UINT>(z));
+        };
+
+        // Gather the cubes of every footprint into a column
+        const FLOAT width = 2.0f * aCubes[0].Extents.x;
+        const FLOAT depth = 2.0f * aCubes[0].Extents.z;
+        std::unordered_map<UINT64, Span> columns;
+        for (const BoundingBox& cube : aCubes)
+        {
+            const INT x = static_cast<INT>(std::lround(cube.Center.x / width));
+            const INT z = static_cast<INT>(std::lround(cube.Center.z / depth));
+            const XMFLOAT3 cubeMin(cube.Center.x - cube.Extents.x, cube.Center.y - cube.Extents.y, cube.Center.z - cube.Extents.z);
+            const XMFLOAT3 cubeMax(cube.Center.x + cube.Extents.x, cube.Center.y + cube.Extents.y, cube.Center.z + cube.Extents.z);
+
+            auto it = columns.find(getKey(x, z));
+            if (it == columns.end())
+            {
+                columns.emplace(getKey(x, z), Span{ .Min = cubeMin, .Max = cubeMax, .filled = 2.0f * cube.Extents.y, .uNumColumns = 1u, .bSolid = TRUE });
+                continue;
+            }
+
+            Span& column = it->second;
+            column.Min.y = cubeMin.y < column.Min.y ? cubeMin.y : column.Min.y;
+            column.Max.y = cubeMax.y > column.Max.y ? cubeMax.y : column.Max.y;
+            column.filled += 2.0f * cube.Extents.y;
+        }
+
+        // Group the columns into cells, a cell keeps the vertical range inside all of its columns
+        std::unordered_map<UINT64, Span> cells;
+        for (const std::pair<const UINT64, Span>& entry : columns)
+        {
+            const INT x = static_cast<INT>(static_cast<UINT>(entry.first >> 32u));
+            const INT z = static_cast<INT>(static_cast<UINT>(entry.first & 0xFFFFFFFFu));
+            const INT cellX = static_cast<INT>(std::floor(static_cast<FLOAT>(x) / static_cast<FLOAT>(uCellSize)));
+            const INT cellZ = static_cast<INT>(std::floor(static_cast<FLOAT>(z) / static_cast<FLOAT>(uCellSize)));
+
+            const Span& column = entry.second;
+            const BOOL bSolid = column.filled >= 0.999f * (column.Max.y - column.Min.y);
+
+            auto it = cells.find(getKey(cellX, cellZ));
+            if (it == cells.end())
+            {
+                cells.emplace(getKey(cellX, cellZ), Span{ .Min = column.Min, .Max = column.Max, .filled = 0.0f, .uNumColumns = 1u, .bSolid = bSolid });
+                continue;
+            }
+
+            Span& cell = it->second;
+            cell.Min.x = column.Min.x < cell.Min.x ? column.Min.x : cell.Min.x;
+            cell.Min.z = column.Min.z < cell.Min.z ? column.Min.z : cell.Min.z;
+            cell.Max.x = column.Max.x > cell.Max.x ? column.Max.x : cell.Max.x;
+            cell.Max.z = column.Max.z > cell.Max.z ? column.Max.z : cell.Max.z;
+            cell.Min.y = column.Min.y > cell.Min.y ? column.Min.y : cell.Min.y;
+            cell.Max.y = column.Max.y < cell.Max.y ? column.Max.y : cell.Max.y;
+            ++cell.uNumColumns;
+            cell.bSolid = cell.bSolid && bSolid;
+        }
+
+        std::vector<UINT64> aCellKeys;
+        aCellKeys.reserve(cells.size());
+        for (const std::pair<const UINT64, Span>& entry : cells)
+        {
+            const Span& cell = entry.second;
+            if (cell.bSolid && cell.uNumColumns == uCellSize * uCellSize && cell.Max.y > cell.Min.y)
+            {
+                aCellKeys.push_back(entry.first);
+            }
+        }
+        std::sort(aCellKeys.begin(), aCellKeys.end());
+
+        outOccluders.reserve(aCellKeys.size());
+        for (UINT64 uKey : aCellKeys)
+        {
+            const Span& cell = cells[uKey];
+            BoundingBox occluder;
+            BoundingBox::CreateFromPoints(occluder, XMLoadFloat3(&cell.Min), XMLoadFloat3(&cell.Max));
+            outOccluders.push_back(occluder);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   OcclusionCuller::OcclusionCuller
+
+      Summary:  Constructor
+
+      Args:     UINT uNumThreads
+                  Maximum number of threads a rasterization runs on,
+                  the calling thread included
+
+      Modifies: [m_workers, m_uNumThreads, m_frustum,
+                 m_viewProjection, m_eye, m_aTriangles, m_aLevels,
+                 m_uNumOccluderTriangles, m_uNumVisible,
+                 m_uNumHidden].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    OcclusionCuller::OcclusionCuller(_In_ UINT uNumThreads)
+        : m_workers(uNumThreads > 1u ? std::make_unique<AssetLoader>(uNumThreads - 1u) : nullptr)
+        , m_uNumThreads(uNumThreads > 1u ? uNumThreads : 1u)
+        , m_frustum()
+        , m_viewProjection()
+        , m_eye()
+        , m_aTriangles()
+        , m_aLevels()
+        , m_uNumOccluderTriangles(0u)
+        , m_uNumVisible(0u)
+        , m_uNumHidden(0u)
+    {
+        // Nothing occludes until the first rasterization
+        for (UINT uLevel = 0u; uLevel < NUM_LEVELS; ++uLevel)
+        {
+            m_aLevels[uLevel].assign(static_cast<size_t>(getLevelWidth(uLevel)) * getLevelHeight(uLevel), 1.0f);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   OcclusionCuller::Rasterize
+
+      Summary:  Renders the occluders seen from the camera into the
+                depth buffer and builds its pyramid. The triangles are
+                set up on the worker threads in partitions of
+                occluders, then rasterized in partitions of rows.
+                Occluders outside the view or reaching behind the
+                camera are left out
+
+      Args:     const XMMATRIX& cameraView
+                  View matrix of the camera
+                const XMMATRIX& cameraProjection
+                  Projection matrix of the camera
+                const std::vector<BoundingBox>& aOccluders
+                  World bounds of solid occluder boxes
+
+      Modifies: [m_frustum, m_viewProjection, m_eye, m_aTriangles,
+                 m_aLevels, m_uNumOccluderTriangles, m_uNumVisible,
+                 m_uNumHidden].
+
+      Returns:  HRESULT
+                  Status code, the first failure of a worker
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT OcclusionCuller::Rasterize(
+        _In_ const XMMATRIX& cameraView,
+        _In_ const XMMATRIX& cameraProjection,
+        _In_ const std::vector<BoundingBox>& aOccluders
+    )
+    {
+        PROFILE_SCOPE("OcclusionCuller::Rasterize");
+
+        const XMMATRIX inverseView = XMMatrixInverse(nullptr, cameraView);
+        m_frustum = BoundingFrustum(cameraProjection);
+        m_frustum.Transform(m_frustum, inverseView);
+        XMStoreFloat4x4(&m_viewProjection, XMMatrixMultiply(cameraView, cameraProjection));
+        XMStoreFloat3(&m_eye, inverseView.r[3]);
+
+        std::fill(m_aLevels[0].begin(), m_aLevels[0].end(), 1.0f);
+        m_uNumVisible = 0u;
+        m_uNumHidden = 0u;
+
+        const UINT uNumOccluders = static_cast<UINT>(aOccluders.size());
+        m_aTriangles.resize(static_cast<size_t>(uNumOccluders) * MAX_TRIANGLES_PER_OCCLUDER);
+
+        UINT uNumPartitions = uNumOccluders / MIN_OCCLUDERS_PER_THREAD;
+        uNumPartitions = uNumPartitions < 1u ? 1u : (uNumPartitions > m_uNumThreads ? m_uNumThreads : uNumPartitions);
+        HRESULT hr = AssetLoader::ParallelFor(
+            m_workers.get(),
+            uNumOccluders,
+            uNumPartitions,
+            [this, &aOccluders](_In_ UINT uBegin, _In_ UINT uEnd)
+            {
+                setupTriangles(aOccluders, uBegin, uEnd);
+            }
+        );
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        m_uNumOccluderTriangles = 0u;
+        for (const OcclusionTriangle& triangle : m_aTriangles)
+        {
+            m_uNumOccluderTriangles += triangle.uMinX <= triangle.uMaxX ? 1u : 0u;
+        }
+
+        // Bands of rows own disjoint pixels, so they are rasterized without synchronization
+        if (m_uNumOccluderTriangles > 0u)
+        {
+            hr = AssetLoader::ParallelFor(
+                m_workers.get(),
+                DEPTH_HEIGHT,
+                m_uNumThreads < DEPTH_HEIGHT ? m_uNumThreads : DEPTH_HEIGHT,
+                [this](_In_ UINT uBeginRow, _In_ UINT uEndRow)
+                {
+                    rasterizeRows(uBeginRow, uEndRow);
+                }
+            );
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+        }
+
+        buildPyramid();
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   OcclusionCuller::IsVisible
+
+      Summary:  Returns whether a bounding box may be visible over the
+                occluders of the last rasterization. The texels of the
+                pyramid covering its screen rectangle are read from
+                the finest level where it spans fewer than
+                MAX_TEST_TEXELS of them along each axis
+
+      Args:     const BoundingBox& bounds
+                  World bounds to test
+
+      Returns:  BOOL
+                  FALSE if the box is outside the view or behind the
+                  occluders
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL OcclusionCuller::IsVisible(_In_ const BoundingBox& bounds) const
+    {
+        if (m_frustum.Contains(bounds) == DISJOINT)
+        {
+            return FALSE;
+        }
+
+        XMFLOAT3 aCorners[BoundingBox::CORNER_COUNT];
+        bounds.GetCorners(aCorners);
+
+        const XMMATRIX viewProjection = XMLoadFloat4x4(&m_viewProjection);
+        FLOAT minX = 1.0f;
+        FLOAT minY = 1.0f;
+        FLOAT maxX = -1.0f;
+        FLOAT maxY = -1.0f;
+        FLOAT minZ = 1.0f;
+        for (const XMFLOAT3& corner : aCorners)
+        {
+            XMFLOAT4 clip;
+            XMStoreFloat4(&clip, XMVector4Transform(XMVectorSet(corner.x, corner.y, corner.z, 1.0f), viewProjection));
+            if (clip.w <= 1e-4f)
+            {
+                return TRUE;
+            }
+
+            const FLOAT x = clip.x / clip.w;
+            const FLOAT y = clip.y / clip.w;
+            const FLOAT z = clip.z / clip.w;
+            minX = x < minX ? x : minX;
+            minY = y < minY ? y : minY;
+            maxX = x > maxX ? x : maxX;
+            maxY = y > maxY ? y : maxY;
+            minZ = z < minZ ? z : minZ;
+        }
+
+        minX = minX < -1.0f ? -1.0f : minX;
+        minY = minY < -1.0f ? -1.0f : minY;
+        maxX = maxX > 1.0f ? 1.0f : maxX;
+        maxY = maxY > 1.0f ? 1.0f : maxY;
+        if (minX > maxX || minY > maxY)
+        {
+            return FALSE;
+        }
+
+        // Row 0 is the top of the screen, where y is 1 in normalized device coordinates
+        UINT uMinX = static_cast<UINT>((minX * 0.5f + 0.5f) * static_cast<FLOAT>(DEPTH_WIDTH));
+        UINT uMaxX = static_cast<UINT>((maxX * 0.5f + 0.5f) * static_cast<FLOAT>(DEPTH_WIDTH));
+        UINT uMinY = static_cast<UINT>((0.5f - maxY * 0.5f) * static_cast<FLOAT>(DEPTH_HEIGHT));
+        UINT uMaxY = static_cast<UINT>((0.5f - minY * 0.5f) * static_cast<FLOAT>(DEPTH_HEIGHT));
+        uMinX = uMinX > DEPTH_WIDTH - 1u ? DEPTH_WIDTH - 1u : uMinX;
+        uMaxX = uMaxX > DEPTH_WIDTH - 1u ? DEPTH_WIDTH - 1u : uMaxX;
+        uMinY = uMinY > DEPTH_HEIGHT - 1u ? DEPTH_HEIGHT - 1u : uMinY;
+        uMaxY = uMaxY > DEPTH_HEIGHT - 1u ? DEPTH_HEIGHT - 1u : uMaxY;
+
+        UINT uLevel = 0u;
+        while (uLevel < NUM_LEVELS - 1u &&
+               ((uMaxX >> uLevel) - (uMinX >> uLevel) >= MAX_TEST_TEXELS || (uMaxY >> uLevel) - (uMinY >> uLevel) >= MAX_TEST_TEXELS))
+        {
+            ++uLevel;
+        }
+
+        for (UINT uY = uMinY >> uLevel; uY <= uMaxY >> uLevel; ++uY)
+        {
+            for (UINT uX = uMinX >> uLevel; uX <= uMaxX >> uLevel; ++uX)
+            {
+                if (GetDepth(uX, uY, uLevel) >= minZ)
+                {
+                    return TRUE;
+                }
+            }
+        }
+
+        return FALSE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   OcclusionCuller::TestBounds
+
+      Summary:  Tests bounding boxes and adds them to the visible and
+                hidden counts of the last rasterization
+
+      Args:     const std::vector<BoundingBox>& aBounds
+                  World bounds to test
+                std::vector<BYTE>& outVisible
+                  1 for every box that may be visible, 0 for the
+                  hidden ones
+
+      Modifies: [m_uNumVisible, m_uNumHidden].
+
+      Returns:  UINT
+                  Number of hidden boxes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT OcclusionCuller::TestBounds(_In_ const std::vector<BoundingBox>& aBounds, _Out_ std::vector<BYTE>& outVisible)
+    {
+        outVisible.resize(aBounds.size());
+
+        UINT uNumHidden = 0u;
+        for (size_t i = 0u; i < aBounds.size(); ++i)
+        {
+            outVisible[i] = IsVisible(aBounds[i]) ? 1u : 0u;
+            uNumHidden += outVisible[i] ? 0u : 1u;
+        }
+
+        m_uNumHidden += uNumHidden;
+        m_uNumVisible += static_cast<UINT>(aBounds.size()) - uNumHidden;
+
+        return uNumHidden;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   OcclusionCuller::GetDepth
+
+      Summary:  Returns the depth of a texel of the pyramid. Level 0
+                is the nearest depth of every pixel, the other levels
+                the farthest depth of the texels below
+
+      Args:     UINT uX
+                  Column of the texel
+                UINT uY
+                  Row of the texel, 0 is the top of the screen
+                UINT uLevel
+                  Level of the pyramid
+
+      Returns:  FLOAT
+                  Depth of the texel, 1 where nothing was rasterized
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT OcclusionCuller::GetDepth(_In_ UINT uX, _In_ UINT uY, _In_ UINT uLevel) const
+    {
+        assert(uLevel < NUM_LEVELS && uX < getLevelWidth(uLevel) && uY < getLevelHeight(uLevel));
+
+        return m_aLevels[uLevel][static_cast<size_t>(uY) * getLevelWidth(uLevel) + uX];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   OcclusionCuller::GetNumOccluderTriangles
+
+      Summary:  Returns the number of triangles the last rasterization
+                rendered
+
+      Returns:  UINT
+                  Number of occluder triangles
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT OcclusionCuller::GetNumOccluderTriangles() const
+    {
+        return m_uNumOccluderTriangles;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   OcclusionCuller::GetNumVisible
+
+      Summary:  Returns the number of boxes TestBounds found visible
+                since the last rasterization
+
+      Returns:  UINT
+                  Number of visible boxes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT OcclusionCuller::GetNumVisible() const
+    {
+        return m_uNumVisible;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   OcclusionCuller::GetNumHidden
+
+      Summary:  Returns the number of boxes TestBounds found hidden
+                since the last rasterization
+
+      Returns:  UINT
+                  Number of hidden boxes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT OcclusionCuller::GetNumHidden() const
+    {
+        return m_uNumHidden;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   OcclusionCuller::setupTriangle
+
+      Summary:  Set up the edge functions, depth plane and pixel range
+                of a triangle. The winding is made counterclockwise on
+                the screen, degenerate triangles are empty
+
+      Args:     XMFLOAT3 a
+                  First vertex, in pixels with the depth in z
+                XMFLOAT3 b
+                  Second vertex
+                XMFLOAT3 c
+                  Third vertex
+                OcclusionTriangle& outTriangle
+                  The set up triangle
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void OcclusionCuller::setupTriangle(_In_ XMFLOAT3 a, _In_ XMFLOAT3 b, _In_ XMFLOAT3 c, _Out_ OcclusionTriangle& outTriangle)
+    {
+        outTriangle = {};
+        outTriangle.uMinX = 1u;
+        outTriangle.uMaxX = 0u;
+
+        FLOAT area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+        if (std::fabs(area) < 1e-6f)
+        {
+            return;
+        }
+        if (area < 0.0f)
+        {
+            std::swap(b, c);
+            area = -area;
+        }
+
+        // Each edge function is the doubled area spanned with the edge, positive on the side of the third vertex
+        const XMFLOAT3* const apVertices[3] = { &a, &b, &c };
+        for (UINT i = 0u; i < 3u; ++i)
+        {
+            const XMFLOAT3& p = *apVertices[i];
+            const XMFLOAT3& q = *apVertices[(i + 1u) % 3u];
+            const FLOAT edgeA = p.y - q.y;
+            const FLOAT edgeB = q.x - p.x;
+            outTriangle.aEdges[i] = XMFLOAT3(edgeA, edgeB, -(edgeA * p.x + edgeB * p.y));
+        }
+
+        // The edge opposite of a vertex weighs its depth
+        const XMFLOAT3& edgeAB = outTriangle.aEdges[0];
+        const XMFLOAT3& edgeBC = outTriangle.aEdges[1];
+        const XMFLOAT3& edgeCA = outTriangle.aEdges[2];
+        outTriangle.DepthPlane = XMFLOAT3(
+            (edgeBC.x * a.z + edgeCA.x * b.z + edgeAB.x * c.z) / area,
+            (edgeBC.y * a.z + edgeCA.y * b.z + edgeAB.y * c.z) / area,
+            (edgeBC.z * a.z + edgeCA.z * b.z + edgeAB.z * c.z) / area
+        );
+
+        // Pixels whose center lies within the bounds of the triangle
+        const FLOAT minX = std::ceil((a.x < b.x ? (a.x < c.x ? a.x : c.x) : (b.x < c.x ? b.x : c.x)) - 0.5f);
+        const FLOAT maxX = std::floor((a.x > b.x ? (a.x > c.x ? a.x : c.x) : (b.x > c.x ? b.x : c.x)) - 0.5f);
+        const FLOAT minY = std::ceil((a.y < b.y ? (a.y < c.y ? a.y : c.y) : (b.y < c.y ? b.y : c.y)) - 0.5f);
+        const FLOAT maxY = std::floor((a.y > b.y ? (a.y > c.y ? a.y : c.y) : (b.y > c.y ? b.y : c.y)) - 0.5f);
+        if (maxX < 0.0f || maxY < 0.0f || minX > static_cast<FLOAT>(DEPTH_WIDTH - 1u) || minY > static_cast<FLOAT>(DEPTH_HEIGHT - 1u) || minX > maxX || minY > maxY)
+        {
+            return;
+        }
+
+        outTriangle.uMinX = minX < 0.0f ? 0u : static_cast<UINT>(minX);
+        outTriangle.uMaxX = maxX > static_cast<FLOAT>(DEPTH_WIDTH - 1u) ? DEPTH_WIDTH - 1u : static_cast<UINT>(maxX);
+        outTriangle.uMinY = minY < 0.0f ? 0u : static_cast<UINT>(minY);
+        outTriangle.uMaxY = maxY > static_cast<FLOAT>(DEPTH_HEIGHT - 1u) ? DEPTH_HEIGHT - 1u : static_cast<UINT>(maxY);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   OcclusionCuller::getLevelWidth
+
+      Summary:  Returns the width of a level of the pyramid
+
+      Args:     UINT uLevel
+                  Level of the pyramid
+
+      Returns:  UINT
+                  Width in texels
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT OcclusionCuller::getLevelWidth(_In_ UINT uLevel)
+    {
+        return (DEPTH_WIDTH >> uLevel) > 0u ? DEPTH_WIDTH >> uLevel : 1u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   OcclusionCuller::getLevelHeight
+
+      Summary:  Returns the height of a level of the pyramid
+
+      Args:     UINT uLevel
+                  Level of the pyramid
+
+      Returns:  UINT
+                  Height in texels
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT OcclusionCuller::getLevelHeight(_In_ UINT uLevel)
+    {
+        return (DEPTH_HEIGHT >> uLevel) > 0u ? DEPTH_HEIGHT >> uLevel : 1u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   OcclusionCuller::setupTriangles
+
+      Summary:  Set up the triangles of the faces of occluders
+                [uBegin, uEnd) that face the camera. A face faces the
+                camera if the eye is on the outer side of its plane
+
+      Args:     const std::vector<BoundingBox>& aOccluders
+                  World bounds of the occluders
+                UINT uBegin
+                  First occluder
+                UINT uEnd
+                  Occluder past the last one
+
+      Modifies: [m_aTriangles].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void OcclusionCuller::setupTriangles(_In_ const std::vector<BoundingBox>& aOccluders, _In_ UINT uBegin, _In_ UINT uEnd)
+    {
+        // Corners of every face of a box, in the order of BoundingBox::GetCorners
+        static constexpr UINT FACES[6][4] =
+        {
+            { 1u, 5u, 6u, 2u },
+            { 0u, 4u, 7u, 3u },
+            { 3u, 2u, 6u, 7u },
+            { 0u, 1u, 5u, 4u },
+            { 0u, 1u, 2u, 3u },
+            { 4u, 5u, 6u, 7u },
+        };
+
+        const XMMATRIX viewProjection = XMLoadFloat4x4(&m_viewProjection);
+        for (UINT i = uBegin; i < uEnd; ++i)
+        {
+            OcclusionTriangle* pTriangles = &m_aTriangles[static_cast<size_t>(i) * MAX_TRIANGLES_PER_OCCLUDER];
+            for (UINT j = 0u; j < MAX_TRIANGLES_PER_OCCLUDER; ++j)
+            {
+                pTriangles[j] = {};
+                pTriangles[j].uMinX = 1u;
+                pTriangles[j].uMaxX = 0u;
+            }
+
+            const BoundingBox& occluder = aOccluders[i];
+            if (m_frustum.Contains(occluder) == DISJOINT)
+            {
+                continue;
+            }
+
+            XMFLOAT3 aCorners[BoundingBox::CORNER_COUNT];
+            occluder.GetCorners(aCorners);
+
+            XMFLOAT3 aScreen[BoundingBox::CORNER_COUNT];
+            BOOL bBehind = FALSE;
+            for (UINT j = 0u; j < BoundingBox::CORNER_COUNT; ++j)
+            {
+                XMFLOAT4 clip;
+                XMStoreFloat4(&clip, XMVector4Transform(XMVectorSet(aCorners[j].x, aCorners[j].y, aCorners[j].z, 1.0f), viewProjection));
+                if (clip.w <= 1e-4f)
+                {
+                    bBehind = TRUE;
+                    break;
+                }
+                aScreen[j] = XMFLOAT3(
+                    (clip.x / clip.w * 0.5f + 0.5f) * static_cast<FLOAT>(DEPTH_WIDTH),
+                    (0.5f - clip.y / clip.w * 0.5f) * static_cast<FLOAT>(DEPTH_HEIGHT),
+                    clip.z / clip.w
+                );
+            }
+
+            // An occluder reaching behind the camera would need clipping, leaving it out only hides less
+            if (bBehind)
+            {
+                continue;
+            }
+
+            const BOOL abFacing[6] =
+            {
+                m_eye.x > occluder.Center.x + occluder.Extents.x,
+                m_eye.x < occluder.Center.x - occluder.Extents.x,
+                m_eye.y > occluder.Center.y + occluder.Extents.y,
+                m_eye.y < occluder.Center.y - occluder.Extents.y,
+                m_eye.z > occluder.Center.z + occluder.Extents.z,
+                m_eye.z < occluder.Center.z - occluder.Extents.z,
+            };
+
+            UINT uNumTriangles = 0u;
+            for (UINT uFace = 0u; uFace < 6u; ++uFace)
+            {
+                if (!abFacing[uFace])
+                {
+                    continue;
+                }
+
+                const UINT* auCorners = FACES[uFace];
+                setupTriangle(aScreen[auCorners[0]], aScreen[auCorners[1]], aScreen[auCorners[2]], pTriangles[uNumTriangles++]);
+                setupTriangle(aScreen[auCorners[0]], aScreen[auCorners[2]], aScreen[auCorners[3]], pTriangles[uNumTriangles++]);
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   OcclusionCuller::rasterizeRows
+
+      Summary:  Rasterize every triangle into rows [uBeginRow,
+                uEndRow) of the depth buffer, evaluating the edge
+                functions and the depth of four pixels at a time and
+                keeping the nearest depth
+
+      Args:     UINT uBeginRow
+                  First row
+                UINT uEndRow
+                  Row past the last one
+
+      Modifies: [m_aLevels].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void OcclusionCuller::rasterizeRows(_In_ UINT uBeginRow, _In_ UINT uEndRow)
+    {
+        FLOAT* pDepth = m_aLevels[0].data();
+        const XMVECTOR pixelOffsets = XMVectorSet(0.5f, 1.5f, 2.5f, 3.5f);
+        const XMVECTOR zero = XMVectorZero();
+
+        for (const OcclusionTriangle& triangle : m_aTriangles)
+        {
+            if (triangle.uMinX > triangle.uMaxX)
+            {
+                continue;
+            }
+
+            const UINT uBeginY = triangle.uMinY > uBeginRow ? triangle.uMinY : uBeginRow;
+            const UINT uEndY = triangle.uMaxY + 1u < uEndRow ? triangle.uMaxY + 1u : uEndRow;
+            if (uBeginY >= uEndY)
+            {
+                continue;
+            }
+
+            const XMVECTOR edge0A = XMVectorReplicate(triangle.aEdges[0].x);
+            const XMVECTOR edge1A = XMVectorReplicate(triangle.aEdges[1].x);
+            const XMVECTOR edge2A = XMVectorReplicate(triangle.aEdges[2].x);
+            const XMVECTOR depthA = XMVectorReplicate(triangle.DepthPlane.x);
+
+            // Rows are whole vectors of four pixels, DEPTH_WIDTH is a multiple of four
+            const UINT uBeginX = triangle.uMinX & ~3u;
+            for (UINT uY = uBeginY; uY < uEndY; ++uY)
+            {
+                const FLOAT py = static_cast<FLOAT>(uY) + 0.5f;
+                const XMVECTOR edge0Row = XMVectorReplicate(triangle.aEdges[0].y * py + triangle.aEdges[0].z);
+                const XMVECTOR edge1Row = XMVectorReplicate(triangle.aEdges[1].y * py + triangle.aEdges[1].z);
+                const XMVECTOR edge2Row = XMVectorReplicate(triangle.aEdges[2].y * py + triangle.aEdges[2].z);
+                const XMVECTOR depthRow = XMVectorReplicate(triangle.DepthPlane.y * py + triangle.DepthPlane.z);
+
+                FLOAT* pRow = pDepth + static_cast<size_t>(uY) * DEPTH_WIDTH;
+                for (UINT uX = uBeginX; uX <= triangle.uMaxX; uX += 4u)
+                {
+                    const XMVECTOR px = XMVectorAdd(XMVectorReplicate(static_cast<FLOAT>(uX)), pixelOffsets);
+                    const XMVECTOR inside = XMVectorAndInt(
+                        XMVectorAndInt(
+                            XMVectorGreaterOrEqual(XMVectorMultiplyAdd(edge0A, px, edge0Row), zero),
+                            XMVectorGreaterOrEqual(XMVectorMultiplyAdd(edge1A, px, edge1Row), zero)
+                        ),
+                        XMVectorGreaterOrEqual(XMVectorMultiplyAdd(edge2A, px, edge2Row), zero)
+                    );
+                    if (XMVector4EqualInt(inside, XMVectorFalseInt()))
+                    {
+                        continue;
+                    }
+
+                    // Occluders between the camera and the near plane clamp to the nearest depth
+                    const XMVECTOR depth = XMVectorMax(XMVectorMultiplyAdd(depthA, px, depthRow), zero);
+                    const XMVECTOR current = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(pRow + uX));
+                    XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(pRow + uX), XMVectorSelect(current, XMVectorMin(current, depth), inside));
+                }
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   OcclusionCuller::buildPyramid
+
+      Summary:  Build every level of the pyramid from the one below,
+                each texel keeping the farthest depth of the up to four
+                texels it covers
+
+      Modifies: [m_aLevels].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void OcclusionCuller::buildPyramid()
+    {
+        for (UINT uLevel = 1u; uLevel < NUM_LEVELS; ++uLevel)
+        {
+            const std::vector<FLOAT>& aBelow = m_aLevels[uLevel - 1u];
+            const UINT uBelowWidth = getLevelWidth(uLevel - 1u);
+            const UINT uBelowHeight = getLevelHeight(uLevel - 1u);
+            std::vector<FLOAT>& aLevel = m_aLevels[uLevel];
+            const UINT uWidth = getLevelWidth(uLevel);
+            const UINT uHeight = getLevelHeight(uLevel);
+
+            for (UINT uY = 0u; uY < uHeight; ++uY)
+            {
+                const UINT uY0 = 2u * uY < uBelowHeight ? 2u * uY : uBelowHeight - 1u;
+                const UINT uY1 = 2u * uY + 1u < uBelowHeight ? 2u * uY + 1u : uBelowHeight - 1u;
+                for (UINT uX = 0u; uX < uWidth; ++uX)
+                {
+                    const UINT uX0 = 2u * uX < uBelowWidth ? 2u * uX : uBelowWidth - 1u;
+                    const UINT uX1 = 2u * uX + 1u < uBelowWidth ? 2u * uX + 1u : uBelowWidth - 1u;
+
+                    const FLOAT depth0 = aBelow[static_cast<size_t>(uY0) * uBelowWidth + uX0];
+                    const FLOAT depth1 = aBelow[static_cast<size_t>(uY0) * uBelowWidth + uX1];
+                    const FLOAT depth2 = aBelow[static_cast<size_t>(uY1) * uBelowWidth + uX0];
+                    const FLOAT depth3 = aBelow[static_cast<size_t>(uY1) * uBelowWidth + uX1];
+                    const FLOAT depth01 = depth0 > depth1 ? depth0 : depth1;
+                    const FLOAT depth23 = depth2 > depth3 ? depth2 : depth3;
+                    aLevel[static_cast<size_t>(uY) * uWidth + uX] = depth01 > depth23 ? depth01 : depth23;
+                }
+            }
+        }
+    }
+}
\ No newline at end of file
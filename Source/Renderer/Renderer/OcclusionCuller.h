@@ -0,0 +1,141 @@
+/*+===================================================================
+  File:      OCCLUSIONCULLER.H
+
+  Summary:   OcclusionCuller header file contains declaration of class
+             OcclusionCuller that rasterizes large occluders into a
+             small depth buffer on the CPU and tests bounding boxes
+             against its hierarchical depth.
+
+  Classes:  OcclusionCuller
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Profiler/Profiler.h"
+#include "Renderer/AssetLoader.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   OcclusionTriangle
+
+      Summary:  Set up occluder triangle in pixels of the depth buffer.
+                Edges holds the three edge functions, a pixel center is
+                inside where all of them are positive. DepthPlane gives
+                the depth at a pixel center. The pixel range is
+                inclusive, a triangle with uMinX past uMaxX is empty
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct OcclusionTriangle
+    {
+        XMFLOAT3 aEdges[3];
+        XMFLOAT3 DepthPlane;
+        UINT uMinX;
+        UINT uMaxX;
+        UINT uMinY;
+        UINT uMaxY;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    OcclusionCuller
+
+      Summary:  Software occlusion culling, free of any device so it
+                can run and be checked on the CPU alone. Occluders are
+                solid boxes. Rasterize sets up the faces of the boxes
+                facing the camera in parallel partitions of boxes, and
+                rasterizes them four pixels at a time in parallel bands
+                of rows, which own disjoint pixels, keeping the
+                nearest depth. A pyramid then keeps the farthest depth
+                of every 2x2 block of the level below. A bounding box
+                is hidden if its nearest depth is behind the farthest
+                occluder depth over its screen rectangle, read from
+                the level where the rectangle spans a few texels.
+                Boxes outside the view are hidden, boxes reaching
+                behind the camera are visible
+
+      Methods:  BuildColumnOccluders
+                  Merges stacked cubes into large occluder boxes
+                Rasterize
+                  Renders the occluders seen from the camera
+                IsVisible
+                  Returns whether a bounding box may be visible
+                TestBounds
+                  Tests bounding boxes and counts the hidden ones
+                GetDepth
+                  Returns the depth of a texel of the pyramid
+                GetNumOccluderTriangles
+                  Returns the number of rasterized triangles
+                GetNumVisible
+                  Returns the number of boxes tested visible
+                GetNumHidden
+                  Returns the number of boxes tested hidden
+                OcclusionCuller
+                  Constructor.
+                ~OcclusionCuller
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class OcclusionCuller final
+    {
+    public:
+        static constexpr UINT DEPTH_WIDTH = 256u;
+        static constexpr UINT DEPTH_HEIGHT = 128u;
+        static constexpr UINT NUM_LEVELS = 9u;
+        static constexpr UINT MAX_TEST_TEXELS = 4u;
+        static constexpr UINT MIN_OCCLUDERS_PER_THREAD = 64u;
+        static constexpr UINT DEFAULT_CELL_SIZE = 4u;
+
+        static void BuildColumnOccluders(
+            _In_ const std::vector<BoundingBox>& aCubes,
+            _In_ UINT uCellSize,
+            _Out_ std::vector<BoundingBox>& outOccluders
+        );
+
+        OcclusionCuller() = delete;
+        OcclusionCuller(_In_ UINT uNumThreads);
+        OcclusionCuller(const OcclusionCuller& other) = delete;
+        OcclusionCuller(OcclusionCuller&& other) = delete;
+        OcclusionCuller& operator=(const OcclusionCuller& other) = delete;
+        OcclusionCuller& operator=(OcclusionCuller&& other) = delete;
+        ~OcclusionCuller() = default;
+
+        HRESULT Rasterize(
+            _In_ const XMMATRIX& cameraView,
+            _In_ const XMMATRIX& cameraProjection,
+            _In_ const std::vector<BoundingBox>& aOccluders
+        );
+
+        BOOL IsVisible(_In_ const BoundingBox& bounds) const;
+        UINT TestBounds(_In_ const std::vector<BoundingBox>& aBounds, _Out_ std::vector<BYTE>& outVisible);
+        FLOAT GetDepth(_In_ UINT uX, _In_ UINT uY, _In_ UINT uLevel) const;
+        UINT GetNumOccluderTriangles() const;
+        UINT GetNumVisible() const;
+        UINT GetNumHidden() const;
+
+    private:
+        static void setupTriangle(_In_ XMFLOAT3 a, _In_ XMFLOAT3 b, _In_ XMFLOAT3 c, _Out_ OcclusionTriangle& outTriangle);
+        static UINT getLevelWidth(_In_ UINT uLevel);
+        static UINT getLevelHeight(_In_ UINT uLevel);
+
+        void setupTriangles(_In_ const std::vector<BoundingBox>& aOccluders, _In_ UINT uBegin, _In_ UINT uEnd);
+        void rasterizeRows(_In_ UINT uBeginRow, _In_ UINT uEndRow);
+        void buildPyramid();
+
+    private:
+        // Every box has at most three faces towards the camera, of two triangles each
+        static constexpr UINT MAX_TRIANGLES_PER_OCCLUDER = 6u;
+
+    private:
+        std::unique_ptr<AssetLoader> m_workers;
+        UINT m_uNumThreads;
+        BoundingFrustum m_frustum;
+        XMFLOAT4X4 m_viewProjection;
+        XMFLOAT3 m_eye;
+        std::vector<OcclusionTriangle> m_aTriangles;
+        std::vector<FLOAT> m_aLevels[NUM_LEVELS];
+        UINT m_uNumOccluderTriangles;
+        UINT m_uNumVisible;
+        UINT m_uNumHidden;
+    };
+}
\ No newline at end of file
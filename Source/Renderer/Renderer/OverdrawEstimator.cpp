@@ -0,0 +1,245 @@
+#include "Renderer/OverdrawEstimator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   OverdrawEstimator::OverdrawEstimator
+
+      Summary:  Constructor
+
+      Modifies: [m_frustum, m_viewProjection, m_uWidth, m_uHeight,
+                 m_aNumLayers, m_aNumShadedLayers, m_aPrepassed].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    OverdrawEstimator::OverdrawEstimator()
+        : m_frustum()
+        , m_viewProjection()
+        , m_uWidth(0u)
+        , m_uHeight(0u)
+        , m_aNumLayers(GRID_WIDTH * GRID_HEIGHT, 0u)
+        , m_aNumShadedLayers(GRID_WIDTH * GRID_HEIGHT, 0u)
+        , m_aPrepassed(GRID_WIDTH * GRID_HEIGHT, 0u)
+    {
+        // empty
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   OverdrawEstimator::Begin
+
+      Summary:  Clear the grid and set the view the objects of a
+                frame are seen from
+
+      Args:     const XMMATRIX& view
+                  View matrix of the camera
+                const XMMATRIX& projection
+                  Projection matrix of the camera
+                UINT uWidth
+                  Width of the back buffer
+                UINT uHeight
+                  Height of the back buffer
+
+      Modifies: [m_frustum, m_viewProjection, m_uWidth, m_uHeight,
+                 m_aNumLayers, m_aNumShadedLayers, m_aPrepassed].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void OverdrawEstimator::Begin(_In_ const XMMATRIX& view, _In_ const XMMATRIX& projection, _In_ UINT uWidth, _In_ UINT uHeight)
+    {
+        m_frustum = BoundingFrustum(projection);
+        m_frustum.Transform(m_frustum, XMMatrixInverse(nullptr, view));
+        XMStoreFloat4x4(&m_viewProjection, XMMatrixMultiply(view, projection));
+
+        m_uWidth = uWidth;
+        m_uHeight = uHeight;
+
+        std::fill(m_aNumLayers.begin(), m_aNumLayers.end(), 0u);
+        std::fill(m_aNumShadedLayers.begin(), m_aNumShadedLayers.end(), 0u);
+        std::fill(m_aPrepassed.begin(), m_aPrepassed.end(), static_cast<BYTE>(0u));
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   OverdrawEstimator::AddBounds
+
+      Summary:  Add a layer to every cell the screen rectangle of an
+                object covers. Objects outside the view cover nothing
+
+      Args:     const BoundingBox& bounds
+                  World bounds of the object
+                BOOL bDepthPrepass
+                  Whether the depth pre-pass renders the object, so
+                  its colour pass only shades the front layer
+
+      Modifies: [m_aNumLayers, m_aNumShadedLayers, m_aPrepassed].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void OverdrawEstimator::AddBounds(_In_ const BoundingBox& bounds, _In_ BOOL bDepthPrepass)
+    {
+        if (m_frustum.Contains(bounds) == DISJOINT)
+        {
+            return;
+        }
+
+        XMUINT4 rect;
+        if (!getCellRect(bounds, rect))
+        {
+            return;
+        }
+
+        for (UINT uY = rect.y; uY < rect.w; ++uY)
+        {
+            for (UINT uX = rect.x; uX < rect.z; ++uX)
+            {
+                const UINT uCell = uY * GRID_WIDTH + uX;
+                ++m_aNumLayers[uCell];
+                if (bDepthPrepass)
+                {
+                    m_aPrepassed[uCell] = 1u;
+                }
+                else
+                {
+                    ++m_aNumShadedLayers[uCell];
+                }
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   OverdrawEstimator::GetNumFragments
+
+      Summary:  Returns the fragments the scene passes rasterize, one
+                per pixel of every layer
+
+      Returns:  UINT64
+                  Estimated number of fragments
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 OverdrawEstimator::GetNumFragments() const
+    {
+        UINT64 uNumCells = 0u;
+        for (UINT uNumLayers : m_aNumLayers)
+        {
+            uNumCells += uNumLayers;
+        }
+
+        return toPixels(uNumCells);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   OverdrawEstimator::GetNumShadedFragments
+
+      Summary:  Returns the fragments the scene passes shade. The
+                layers without depth pre-pass are all shaded, the ones
+                with it only once per pixel
+
+      Returns:  UINT64
+                  Estimated number of shaded fragments
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 OverdrawEstimator::GetNumShadedFragments() const
+    {
+        UINT64 uNumCells = 0u;
+        for (UINT uCell = 0u; uCell < GRID_WIDTH * GRID_HEIGHT; ++uCell)
+        {
+            uNumCells += m_aNumShadedLayers[uCell] + m_aPrepassed[uCell];
+        }
+
+        return toPixels(uNumCells);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   OverdrawEstimator::GetNumCoveredPixels
+
+      Summary:  Returns the pixels at least one object covers
+
+      Returns:  UINT64
+                  Estimated number of covered pixels
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 OverdrawEstimator::GetNumCoveredPixels() const
+    {
+        UINT64 uNumCells = 0u;
+        for (UINT uNumLayers : m_aNumLayers)
+        {
+            uNumCells += uNumLayers > 0u ? 1u : 0u;
+        }
+
+        return toPixels(uNumCells);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   OverdrawEstimator::getCellRect
+
+      Summary:  Find the cells the screen rectangle of a box covers.
+                A box reaching behind the camera covers the whole
+                screen
+
+      Args:     const BoundingBox& bounds
+                  World bounds of the object
+                XMUINT4& outRect
+                  First column, first row, and the column and row
+                  past the last ones
+
+      Returns:  BOOL
+                  FALSE if the rectangle covers no cell
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL OverdrawEstimator::getCellRect(_In_ const BoundingBox& bounds, _Out_ XMUINT4& outRect) const
+    {
+        outRect = XMUINT4(0u, 0u, GRID_WIDTH, GRID_HEIGHT);
+
+        XMFLOAT3 aCorners[BoundingBox::CORNER_COUNT];
+        bounds.GetCorners(aCorners);
+
+        const XMMATRIX viewProjection = XMLoadFloat4x4(&m_viewProjection);
+        FLOAT minX = 1.0f;
+        FLOAT minY = 1.0f;
+        FLOAT maxX = -1.0f;
+        FLOAT maxY = -1.0f;
+        for (const XMFLOAT3& corner : aCorners)
+        {
+            XMFLOAT4 clip;
+            XMStoreFloat4(&clip, XMVector4Transform(XMVectorSet(corner.x, corner.y, corner.z, 1.0f), viewProjection));
+            if (clip.w <= 1e-4f)
+            {
+                return TRUE;
+            }
+
+            const FLOAT x = clip.x / clip.w;
+            const FLOAT y = clip.y / clip.w;
+            minX = x < minX ? x : minX;
+            minY = y < minY ? y : minY;
+            maxX = x > maxX ? x : maxX;
+            maxY = y > maxY ? y : maxY;
+        }
+
+        minX = minX < -1.0f ? -1.0f : minX;
+        minY = minY < -1.0f ? -1.0f : minY;
+        maxX = maxX > 1.0f ? 1.0f : maxX;
+        maxY = maxY > 1.0f ? 1.0f : maxY;
+        if (minX >= maxX || minY >= maxY)
+        {
+            return FALSE;
+        }
+
+        // Row 0 is the top of the screen, where y is 1 in normalized device coordinates
+        outRect.x = static_cast<UINT>(std::floor((minX * 0.5f + 0.5f) * static_cast<FLOAT>(GRID_WIDTH)));
+        outRect.y = static_cast<UINT>(std::floor((0.5f - maxY * 0.5f) * static_cast<FLOAT>(GRID_HEIGHT)));
+        outRect.z = static_cast<UINT>(std::ceil((maxX * 0.5f + 0.5f) * static_cast<FLOAT>(GRID_WIDTH)));
+        outRect.w = static_cast<UINT>(std::ceil((0.5f - minY * 0.5f) * static_cast<FLOAT>(GRID_HEIGHT)));
+        outRect.z = outRect.z > GRID_WIDTH ? GRID_WIDTH : outRect.z;
+        outRect.w = outRect.w > GRID_HEIGHT ? GRID_HEIGHT : outRect.w;
+
+        return outRect.x < outRect.z && outRect.y < outRect.w;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   OverdrawEstimator::toPixels
+
+      Summary:  Scale a number of cells to the pixels they cover
+
+      Args:     UINT64 uNumCells
+                  Number of cells, a cell counted once per layer
+
+      Returns:  UINT64
+                  Number of pixels
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 OverdrawEstimator::toPixels(_In_ UINT64 uNumCells) const
+    {
+        return uNumCells * m_uWidth * m_uHeight / (GRID_WIDTH * GRID_HEIGHT);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+/*+===================================================================
+  File:      OVERDRAWESTIMATOR.H
+
+  Summary:   OverdrawEstimator header file contains declaration of
+             class OverdrawEstimator that estimates on the CPU how
+             many fragments the scene passes rasterize and shade.
+
+  Classes:  OverdrawEstimator
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    OverdrawEstimator
+
+      Summary:  Software estimate of the overdraw of a frame, free of
+                any device. The screen is split in a coarse grid of
+                cells, and every object inside the view covers the
+                cells of the screen rectangle of its bounds. A cell
+                counts the layers of objects covering it, and apart
+                the layers of objects without depth pre-pass. Every
+                layer is rasterized, but the colour pass of the
+                objects that had a depth pre-pass only shades the
+                front layer of them. Occlusion between the layers is
+                not known, so the counts are upper bounds
+
+      Methods:  Begin
+                  Clears the grid for the view of a frame
+                AddBounds
+                  Adds the layers an object covers
+                GetNumFragments
+                  Returns the fragments the scene passes rasterize
+                GetNumShadedFragments
+                  Returns the fragments the scene passes shade
+                GetNumCoveredPixels
+                  Returns the pixels covered by any object
+                OverdrawEstimator
+                  Constructor.
+                ~OverdrawEstimator
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class OverdrawEstimator final
+    {
+    public:
+        static constexpr UINT GRID_WIDTH = 64u;
+        static constexpr UINT GRID_HEIGHT = 36u;
+
+        OverdrawEstimator();
+        OverdrawEstimator(const OverdrawEstimator& other) = delete;
+        OverdrawEstimator(OverdrawEstimator&& other) = delete;
+        OverdrawEstimator& operator=(const OverdrawEstimator& other) = delete;
+        OverdrawEstimator& operator=(OverdrawEstimator&& other) = delete;
+        ~OverdrawEstimator() = default;
+
+        void Begin(_In_ const XMMATRIX& view, _In_ const XMMATRIX& projection, _In_ UINT uWidth, _In_ UINT uHeight);
+        void AddBounds(_In_ const BoundingBox& bounds, _In_ BOOL bDepthPrepass);
+
+        UINT64 GetNumFragments() const;
+        UINT64 GetNumShadedFragments() const;
+        UINT64 GetNumCoveredPixels() const;
+
+    private:
+        BOOL getCellRect(_In_ const BoundingBox& bounds, _Out_ XMUINT4& outRect) const;
+        UINT64 toPixels(_In_ UINT64 uNumCells) const;
+
+    private:
+        BoundingFrustum m_frustum;
+        XMFLOAT4X4 m_viewProjection;
+        UINT m_uWidth;
+        UINT m_uHeight;
+        std::vector<UINT> m_aNumLayers;
+        std::vector<UINT> m_aNumShadedLayers;
+        std::vector<BYTE> m_aPrepassed;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,712 @@
+#include "Renderer/RecordingRenderContext.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderContext::RecordingRenderContext
+
+      Summary:  Constructor
+
+      Modifies: [m_aCommands, m_auNumCalls, m_uNumIndices,
+                 m_uNumInstances, m_uNumUploadedBytes,
+                 m_bCommandLogEnabled].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    RecordingRenderContext::RecordingRenderContext()
+        : RenderContext()
+        , m_aCommands()
+        , m_auNumCalls()
+        , m_uNumIndices(0ull)
+        , m_uNumInstances(0ull)
+        , m_uNumUploadedBytes(0ull)
+        , m_bCommandLogEnabled(TRUE)
+    {
+        // empty
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderContext::Reset
+
+      Summary:  Clears the counters and the recorded calls
+
+      Modifies: [m_aCommands, m_auNumCalls, m_uNumIndices,
+                 m_uNumInstances, m_uNumUploadedBytes, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RecordingRenderContext::Reset()
+    {
+        m_aCommands.clear();
+        m_auNumCalls.fill(0u);
+        m_uNumIndices = 0ull;
+        m_uNumInstances = 0ull;
+        m_uNumUploadedBytes = 0ull;
+        ResetStats();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderContext::SetCommandLogEnabled
+
+      Summary:  Keeps or drops the calls in order. Long benchmarks
+                only need the counters
+
+      Args:     BOOL bEnabled
+                  TRUE to keep the calls
+
+      Modifies: [m_bCommandLogEnabled].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RecordingRenderContext::SetCommandLogEnabled(_In_ BOOL bEnabled)
+    {
+        m_bCommandLogEnabled = bEnabled;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderContext::GetCommands
+
+      Summary:  Returns the recorded calls in the order they were made
+
+      Returns:  const std::vector<RecordedRenderCommand>&
+                  Recorded calls
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::vector<RecordedRenderCommand>& RecordingRenderContext::GetCommands() const
+    {
+        return m_aCommands;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderContext::GetNumCalls
+
+      Summary:  Returns how often a call was made
+
+      Args:     eRenderCommand command
+                  The call
+
+      Returns:  UINT
+                  Number of calls
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT RecordingRenderContext::GetNumCalls(_In_ eRenderCommand command) const
+    {
+        return m_auNumCalls[static_cast<size_t>(command)];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderContext::GetNumDrawCalls
+
+      Summary:  Returns the number of draw calls without an index
+                buffer, indexed and instanced draw calls
+
+      Returns:  UINT
+                  Number of draw calls
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT RecordingRenderContext::GetNumDrawCalls() const
+    {
+        return GetNumCalls(eRenderCommand::DRAW) + GetNumCalls(eRenderCommand::DRAW_INDEXED) + GetNumCalls(eRenderCommand::DRAW_INDEXED_INSTANCED);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderContext::GetNumIndices
+
+      Summary:  Returns the number of drawn indices, counted once per
+                instance
+
+      Returns:  UINT64
+                  Number of indices
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 RecordingRenderContext::GetNumIndices() const
+    {
+        return m_uNumIndices;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderContext::GetNumInstances
+
+      Summary:  Returns the number of drawn instances, a draw that is
+                not instanced counts as one
+
+      Returns:  UINT64
+                  Number of instances
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 RecordingRenderContext::GetNumInstances() const
+    {
+        return m_uNumInstances;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderContext::GetNumUploadedBytes
+
+      Summary:  Returns the number of bytes uploaded to constant
+                buffers
+
+      Returns:  UINT64
+                  Number of bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 RecordingRenderContext::GetNumUploadedBytes() const
+    {
+        return m_uNumUploadedBytes;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderContext::IASetPrimitiveTopology
+
+      Summary:  Records the call
+
+      Args:     D3D11_PRIMITIVE_TOPOLOGY topology
+
+      Modifies: [m_aCommands, m_auNumCalls, m_topology].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RecordingRenderContext::IASetPrimitiveTopology(_In_ D3D11_PRIMITIVE_TOPOLOGY topology)
+    {
+        m_topology = topology;
+        record(eRenderCommand::SET_PRIMITIVE_TOPOLOGY, 0u, 1u, 0u, 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderContext::IASetInputLayout
+
+      Summary:  Records the call
+
+      Args:     ID3D11InputLayout* pInputLayout
+
+      Modifies: [m_aCommands, m_auNumCalls].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RecordingRenderContext::IASetInputLayout(_In_opt_ ID3D11InputLayout* pInputLayout)
+    {
+        UNREFERENCED_PARAMETER(pInputLayout);
+
+        record(eRenderCommand::SET_INPUT_LAYOUT, 0u, 1u, 0u, 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderContext::IASetVertexBuffers
+
+      Summary:  Records the call
+
+      Args:     UINT uStartSlot
+                UINT uNumBuffers
+                ID3D11Buffer* const* ppVertexBuffers
+                const UINT* puStrides
+                const UINT* puOffsets
+
+      Modifies: [m_aCommands, m_auNumCalls].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RecordingRenderContext::IASetVertexBuffers(
+        _In_ UINT uStartSlot,
+        _In_ UINT uNumBuffers,
+        _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppVertexBuffers,
+        _In_reads_opt_(uNumBuffers) const UINT* puStrides,
+        _In_reads_opt_(uNumBuffers) const UINT* puOffsets
+    )
+    {
+        UNREFERENCED_PARAMETER(ppVertexBuffers);
+        UNREFERENCED_PARAMETER(puStrides);
+        UNREFERENCED_PARAMETER(puOffsets);
+
+        record(eRenderCommand::SET_VERTEX_BUFFERS, uStartSlot, uNumBuffers, 0u, 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderContext::IASetIndexBuffer
+
+      Summary:  Records the call
+
+      Args:     ID3D11Buffer* pIndexBuffer
+                DXGI_FORMAT format
+                UINT uOffset
+
+      Modifies: [m_aCommands, m_auNumCalls].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RecordingRenderContext::IASetIndexBuffer(_In_opt_ ID3D11Buffer* pIndexBuffer, _In_ DXGI_FORMAT format, _In_ UINT uOffset)
+    {
+        UNREFERENCED_PARAMETER(pIndexBuffer);
+        UNREFERENCED_PARAMETER(format);
+        UNREFERENCED_PARAMETER(uOffset);
+
+        record(eRenderCommand::SET_INDEX_BUFFER, 0u, 1u, 0u, 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderContext::VSSetShader
+
+      Summary:  Records the call
+
+      Args:     ID3D11VertexShader* pVertexShader
+                ID3D11ClassInstance* const* ppClassInstances
+                UINT uNumClassInstances
+
+      Modifies: [m_aCommands, m_auNumCalls, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RecordingRenderContext::VSSetShader(
+        _In_opt_ ID3D11VertexShader* pVertexShader,
+        _In_reads_opt_(uNumClassInstances) ID3D11ClassInstance* const* ppClassInstances,
+        _In_ UINT uNumClassInstances
+    )
+    {
+        UNREFERENCED_PARAMETER(pVertexShader);
+        UNREFERENCED_PARAMETER(ppClassInstances);
+        UNREFERENCED_PARAMETER(uNumClassInstances);
+
+        ++m_stats.uNumShaderBinds;
+        record(eRenderCommand::SET_VERTEX_SHADER, 0u, 1u, 0u, 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderContext::VSSetConstantBuffers
+
+      Summary:  Records the call
+
+      Args:     UINT uStartSlot
+                UINT uNumBuffers
+                ID3D11Buffer* const* ppConstantBuffers
+
+      Modifies: [m_aCommands, m_auNumCalls, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RecordingRenderContext::VSSetConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers)
+    {
+        UNREFERENCED_PARAMETER(ppConstantBuffers);
+
+        m_stats.uNumConstantBufferBinds += uNumBuffers;
+        record(eRenderCommand::SET_VERTEX_CONSTANT_BUFFERS, uStartSlot, uNumBuffers, 0u, 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderContext::VSSetConstantBuffers1
+
+      Summary:  Records the call
+
+      Args:     UINT uStartSlot
+                UINT uNumBuffers
+                ID3D11Buffer* const* ppConstantBuffers
+                const UINT* puFirstConstant
+                const UINT* puNumConstants
+
+      Modifies: [m_aCommands, m_auNumCalls, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RecordingRenderContext::VSSetConstantBuffers1(
+        _In_ UINT uStartSlot,
+        _In_ UINT uNumBuffers,
+        _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers,
+        _In_reads_opt_(uNumBuffers) const UINT* puFirstConstant,
+        _In_reads_opt_(uNumBuffers) const UINT* puNumConstants
+    )
+    {
+        UNREFERENCED_PARAMETER(ppConstantBuffers);
+        UNREFERENCED_PARAMETER(puFirstConstant);
+        UNREFERENCED_PARAMETER(puNumConstants);
+
+        m_stats.uNumConstantBufferBinds += uNumBuffers;
+        record(eRenderCommand::SET_VERTEX_CONSTANT_BUFFERS1, uStartSlot, uNumBuffers, 0u, 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderContext::PSSetShader
+
+      Summary:  Records the call
+
+      Args:     ID3D11PixelShader* pPixelShader
+                ID3D11ClassInstance* const* ppClassInstances
+                UINT uNumClassInstances
+
+      Modifies: [m_aCommands, m_auNumCalls, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RecordingRenderContext::PSSetShader(
+        _In_opt_ ID3D11PixelShader* pPixelShader,
+        _In_reads_opt_(uNumClassInstances) ID3D11ClassInstance* const* ppClassInstances,
+        _In_ UINT uNumClassInstances
+    )
+    {
+        UNREFERENCED_PARAMETER(pPixelShader);
+        UNREFERENCED_PARAMETER(ppClassInstances);
+        UNREFERENCED_PARAMETER(uNumClassInstances);
+
+        ++m_stats.uNumShaderBinds;
+        record(eRenderCommand::SET_PIXEL_SHADER, 0u, 1u, 0u, 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderContext::PSSetConstantBuffers
+
+      Summary:  Records the call
+
+      Args:     UINT uStartSlot
+                UINT uNumBuffers
+                ID3D11Buffer* const* ppConstantBuffers
+
+      Modifies: [m_aCommands, m_auNumCalls, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RecordingRenderContext::PSSetConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers)
+    {
+        UNREFERENCED_PARAMETER(ppConstantBuffers);
+
+        m_stats.uNumConstantBufferBinds += uNumBuffers;
+        record(eRenderCommand::SET_PIXEL_CONSTANT_BUFFERS, uStartSlot, uNumBuffers, 0u, 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderContext::PSSetConstantBuffers1
+
+      Summary:  Records the call
+
+      Args:     UINT uStartSlot
+                UINT uNumBuffers
+                ID3D11Buffer* const* ppConstantBuffers
+                const UINT* puFirstConstant
+                const UINT* puNumConstants
+
+      Modifies: [m_aCommands, m_auNumCalls, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RecordingRenderContext::PSSetConstantBuffers1(
+        _In_ UINT uStartSlot,
+        _In_ UINT uNumBuffers,
+        _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers,
+        _In_reads_opt_(uNumBuffers) const UINT* puFirstConstant,
+        _In_reads_opt_(uNumBuffers) const UINT* puNumConstants
+    )
+    {
+        UNREFERENCED_PARAMETER(ppConstantBuffers);
+        UNREFERENCED_PARAMETER(puFirstConstant);
+        UNREFERENCED_PARAMETER(puNumConstants);
+
+        m_stats.uNumConstantBufferBinds += uNumBuffers;
+        record(eRenderCommand::SET_PIXEL_CONSTANT_BUFFERS1, uStartSlot, uNumBuffers, 0u, 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderContext::PSSetShaderResources
+
+      Summary:  Records the call
+
+      Args:     UINT uStartSlot
+                UINT uNumViews
+                ID3D11ShaderResourceView* const* ppShaderResourceViews
+
+      Modifies: [m_aCommands, m_auNumCalls, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RecordingRenderContext::PSSetShaderResources(_In_ UINT uStartSlot, _In_ UINT uNumViews, _In_reads_opt_(uNumViews) ID3D11ShaderResourceView* const* ppShaderResourceViews)
+    {
+        UNREFERENCED_PARAMETER(ppShaderResourceViews);
+
+        m_stats.uNumShaderResourceBinds += uNumViews;
+        record(eRenderCommand::SET_PIXEL_SHADER_RESOURCES, uStartSlot, uNumViews, 0u, 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderContext::PSSetSamplers
+
+      Summary:  Records the call
+
+      Args:     UINT uStartSlot
+                UINT uNumSamplers
+                ID3D11SamplerState* const* ppSamplers
+
+      Modifies: [m_aCommands, m_auNumCalls, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RecordingRenderContext::PSSetSamplers(_In_ UINT uStartSlot, _In_ UINT uNumSamplers, _In_reads_opt_(uNumSamplers) ID3D11SamplerState* const* ppSamplers)
+    {
+        UNREFERENCED_PARAMETER(ppSamplers);
+
+        m_stats.uNumSamplerBinds += uNumSamplers;
+        record(eRenderCommand::SET_PIXEL_SAMPLERS, uStartSlot, uNumSamplers, 0u, 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderContext::RSSetViewports
+
+      Summary:  Records the call
+
+      Args:     UINT uNumViewports
+                const D3D11_VIEWPORT* pViewports
+
+      Modifies: [m_aCommands, m_auNumCalls].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RecordingRenderContext::RSSetViewports(_In_ UINT uNumViewports, _In_reads_opt_(uNumViewports) const D3D11_VIEWPORT* pViewports)
+    {
+        UNREFERENCED_PARAMETER(pViewports);
+
+        record(eRenderCommand::SET_VIEWPORTS, 0u, uNumViewports, 0u, 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderContext::RSSetState
+
+      Summary:  Records the call
+
+      Args:     ID3D11RasterizerState* pRasterizerState
+
+      Modifies: [m_aCommands, m_auNumCalls].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RecordingRenderContext::RSSetState(_In_opt_ ID3D11RasterizerState* pRasterizerState)
+    {
+        UNREFERENCED_PARAMETER(pRasterizerState);
+
+        record(eRenderCommand::SET_RASTERIZER_STATE, 0u, 1u, 0u, 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderContext::OMSetRenderTargets
+
+      Summary:  Records the call
+
+      Args:     UINT uNumViews
+                ID3D11RenderTargetView* const* ppRenderTargetViews
+                ID3D11DepthStencilView* pDepthStencilView
+
+      Modifies: [m_aCommands, m_auNumCalls].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RecordingRenderContext::OMSetRenderTargets(
+        _In_ UINT uNumViews,
+        _In_reads_opt_(uNumViews) ID3D11RenderTargetView* const* ppRenderTargetViews,
+        _In_opt_ ID3D11DepthStencilView* pDepthStencilView
+    )
+    {
+        UNREFERENCED_PARAMETER(ppRenderTargetViews);
+        UNREFERENCED_PARAMETER(pDepthStencilView);
+
+        record(eRenderCommand::SET_RENDER_TARGETS, 0u, uNumViews, 0u, 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderContext::OMSetDepthStencilState
+
+      Summary:  Records the call
+
+      Args:     ID3D11DepthStencilState* pDepthStencilState
+                UINT uStencilRef
+
+      Modifies: [m_aCommands, m_auNumCalls].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RecordingRenderContext::OMSetDepthStencilState(_In_opt_ ID3D11DepthStencilState* pDepthStencilState, _In_ UINT uStencilRef)
+    {
+        UNREFERENCED_PARAMETER(pDepthStencilState);
+        UNREFERENCED_PARAMETER(uStencilRef);
+
+        record(eRenderCommand::SET_DEPTH_STENCIL_STATE, 0u, 1u, 0u, 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderContext::ClearRenderTargetView
+
+      Summary:  Records the call
+
+      Args:     ID3D11RenderTargetView* pRenderTargetView
+                const FLOAT aColorRGBA[4]
+
+      Modifies: [m_aCommands, m_auNumCalls].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RecordingRenderContext::ClearRenderTargetView(_In_opt_ ID3D11RenderTargetView* pRenderTargetView, _In_ const FLOAT aColorRGBA[4])
+    {
+        UNREFERENCED_PARAMETER(pRenderTargetView);
+        UNREFERENCED_PARAMETER(aColorRGBA);
+
+        record(eRenderCommand::CLEAR_RENDER_TARGET, 0u, 1u, 0u, 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderContext::ClearDepthStencilView
+
+      Summary:  Records the call
+
+      Args:     ID3D11DepthStencilView* pDepthStencilView
+                UINT uClearFlags
+                FLOAT depth
+                UINT8 stencil
+
+      Modifies: [m_aCommands, m_auNumCalls].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RecordingRenderContext::ClearDepthStencilView(_In_opt_ ID3D11DepthStencilView* pDepthStencilView, _In_ UINT uClearFlags, _In_ FLOAT depth, _In_ UINT8 stencil)
+    {
+        UNREFERENCED_PARAMETER(pDepthStencilView);
+        UNREFERENCED_PARAMETER(uClearFlags);
+        UNREFERENCED_PARAMETER(depth);
+        UNREFERENCED_PARAMETER(stencil);
+
+        record(eRenderCommand::CLEAR_DEPTH_STENCIL, 0u, 1u, 0u, 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderContext::UpdateConstantBuffer
+
+      Summary:  Records and counts a constant buffer upload
+
+      Args:     ID3D11Buffer* pConstantBuffer
+                const void* pData
+                UINT uDataSize
+
+      Modifies: [m_aCommands, m_auNumCalls, m_uNumUploadedBytes,
+                 m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RecordingRenderContext::UpdateConstantBuffer(_In_opt_ ID3D11Buffer* pConstantBuffer, _In_reads_bytes_(uDataSize) const void* pData, _In_ UINT uDataSize)
+    {
+        UNREFERENCED_PARAMETER(pConstantBuffer);
+        UNREFERENCED_PARAMETER(pData);
+
+        m_uNumUploadedBytes += uDataSize;
+        ++m_stats.uNumUploads;
+        m_stats.uNumUploadedBytes += uDataSize;
+        record(eRenderCommand::UPDATE_CONSTANT_BUFFER, 0u, 1u, 0u, uDataSize);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderContext::UpdateDynamicConstantBuffer
+
+      Summary:  Records and counts a dynamic constant buffer upload
+
+      Args:     ID3D11Buffer* pConstantBuffer
+                UINT uOffset
+                const void* pData
+                UINT uDataSize
+                BOOL bDiscard
+
+      Modifies: [m_aCommands, m_auNumCalls, m_uNumUploadedBytes,
+                 m_stats].
+
+      Returns:  HRESULT
+                  Always S_OK
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT RecordingRenderContext::UpdateDynamicConstantBuffer(
+        _In_opt_ ID3D11Buffer* pConstantBuffer,
+        _In_ UINT uOffset,
+        _In_reads_bytes_(uDataSize) const void* pData,
+        _In_ UINT uDataSize,
+        _In_ BOOL bDiscard
+    )
+    {
+        UNREFERENCED_PARAMETER(pConstantBuffer);
+        UNREFERENCED_PARAMETER(uOffset);
+        UNREFERENCED_PARAMETER(pData);
+        UNREFERENCED_PARAMETER(bDiscard);
+
+        m_uNumUploadedBytes += uDataSize;
+        ++m_stats.uNumUploads;
+        m_stats.uNumUploadedBytes += uDataSize;
+        record(eRenderCommand::UPDATE_DYNAMIC_CONSTANT_BUFFER, 0u, 1u, 0u, uDataSize);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderContext::Draw
+
+      Summary:  Records and counts a draw without an index buffer,
+                which adds no indices
+
+      Args:     UINT uVertexCount
+                UINT uStartVertexLocation
+
+      Modifies: [m_aCommands, m_auNumCalls, m_uNumInstances, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RecordingRenderContext::Draw(_In_ UINT uVertexCount, _In_ UINT uStartVertexLocation)
+    {
+        UNREFERENCED_PARAMETER(uStartVertexLocation);
+
+        m_uNumInstances += 1ull;
+        countDraw(uVertexCount, 1u);
+        record(eRenderCommand::DRAW, 0u, uVertexCount, 0u, 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderContext::DrawIndexed
+
+      Summary:  Records and counts an indexed draw
+
+      Args:     UINT uIndexCount
+                UINT uStartIndexLocation
+                INT iBaseVertexLocation
+
+      Modifies: [m_aCommands, m_auNumCalls, m_uNumIndices, m_uNumInstances,
+                 m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RecordingRenderContext::DrawIndexed(_In_ UINT uIndexCount, _In_ UINT uStartIndexLocation, _In_ INT iBaseVertexLocation)
+    {
+        UNREFERENCED_PARAMETER(uStartIndexLocation);
+        UNREFERENCED_PARAMETER(iBaseVertexLocation);
+
+        m_uNumIndices += uIndexCount;
+        m_uNumInstances += 1ull;
+        countDraw(uIndexCount, 1u);
+        record(eRenderCommand::DRAW_INDEXED, 0u, uIndexCount, 0u, 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderContext::DrawIndexedInstanced
+
+      Summary:  Records and counts an instanced draw
+
+      Args:     UINT uIndexCountPerInstance
+                UINT uInstanceCount
+                UINT uStartIndexLocation
+                INT iBaseVertexLocation
+                UINT uStartInstanceLocation
+
+      Modifies: [m_aCommands, m_auNumCalls, m_uNumIndices, m_uNumInstances,
+                 m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RecordingRenderContext::DrawIndexedInstanced(
+        _In_ UINT uIndexCountPerInstance,
+        _In_ UINT uInstanceCount,
+        _In_ UINT uStartIndexLocation,
+        _In_ INT iBaseVertexLocation,
+        _In_ UINT uStartInstanceLocation
+    )
+    {
+        UNREFERENCED_PARAMETER(uStartIndexLocation);
+        UNREFERENCED_PARAMETER(iBaseVertexLocation);
+        UNREFERENCED_PARAMETER(uStartInstanceLocation);
+
+        m_uNumIndices += static_cast<UINT64>(uIndexCountPerInstance) * uInstanceCount;
+        m_uNumInstances += uInstanceCount;
+        countDraw(uIndexCountPerInstance, uInstanceCount);
+        record(eRenderCommand::DRAW_INDEXED_INSTANCED, 0u, uIndexCountPerInstance, uInstanceCount, 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderContext::ExecuteCommandList
+
+      Summary:  Records the call
+
+      Args:     ID3D11CommandList* pCommandList
+                BOOL bRestoreContextState
+
+      Modifies: [m_aCommands, m_auNumCalls].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RecordingRenderContext::ExecuteCommandList(_In_opt_ ID3D11CommandList* pCommandList, _In_ BOOL bRestoreContextState)
+    {
+        UNREFERENCED_PARAMETER(pCommandList);
+        UNREFERENCED_PARAMETER(bRestoreContextState);
+
+        record(eRenderCommand::EXECUTE_COMMAND_LIST, 0u, 1u, 0u, 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderContext::record
+
+      Summary:  Counts a call and keeps it if the log is enabled
+
+      Args:     eRenderCommand command
+                  The call
+                UINT uStart
+                  First slot of a bind
+                UINT uCount
+                  Number of bound objects or drawn indices
+                UINT uNumInstances
+                  Number of instances of an instanced draw
+                UINT uNumBytes
+                  Number of uploaded bytes
+
+      Modifies: [m_aCommands, m_auNumCalls].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RecordingRenderContext::record(_In_ eRenderCommand command, _In_ UINT uStart, _In_ UINT uCount, _In_ UINT uNumInstances, _In_ UINT uNumBytes)
+    {
+        ++m_auNumCalls[static_cast<size_t>(command)];
+
+        if (m_bCommandLogEnabled)
+        {
+            m_aCommands.push_back(
+                RecordedRenderCommand
+                {
+                    .Command = command,
+                    .uStart = uStart,
+                    .uCount = uCount,
+                    .uNumInstances = uNumInstances,
+                    .uNumBytes = uNumBytes
+                }
+            );
+        }
+    }
+}
\ No newline at end of file
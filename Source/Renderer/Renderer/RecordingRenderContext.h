@@ -0,0 +1,213 @@
+/*+===================================================================
+  File:      RECORDINGRENDERCONTEXT.H
+
+  Summary:   RecordingRenderContext header file contains declarations
+             of the RecordingRenderContext class, a null render
+             backend that records and counts the calls of the render
+             passes instead of sending them to a device.
+
+  Classes: RecordingRenderContext
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/RenderContext.h"
+
+#include <array>
+
+namespace library
+{
+    /*E+E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E
+      Enum:     eRenderCommand
+
+      Summary:  Calls recorded by the recording render context, COUNT
+                is the number of commands
+    E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E-E*/
+    enum class eRenderCommand
+    {
+        SET_PRIMITIVE_TOPOLOGY,
+        SET_INPUT_LAYOUT,
+        SET_VERTEX_BUFFERS,
+        SET_INDEX_BUFFER,
+        SET_VERTEX_SHADER,
+        SET_VERTEX_CONSTANT_BUFFERS,
+        SET_VERTEX_CONSTANT_BUFFERS1,
+        SET_PIXEL_SHADER,
+        SET_PIXEL_CONSTANT_BUFFERS,
+        SET_PIXEL_CONSTANT_BUFFERS1,
+        SET_PIXEL_SHADER_RESOURCES,
+        SET_PIXEL_SAMPLERS,
+        SET_VIEWPORTS,
+        SET_RASTERIZER_STATE,
+        SET_RENDER_TARGETS,
+        SET_DEPTH_STENCIL_STATE,
+        CLEAR_RENDER_TARGET,
+        CLEAR_DEPTH_STENCIL,
+        UPDATE_CONSTANT_BUFFER,
+        UPDATE_DYNAMIC_CONSTANT_BUFFER,
+        DRAW,
+        DRAW_INDEXED,
+        DRAW_INDEXED_INSTANCED,
+        EXECUTE_COMMAND_LIST,
+        COUNT,
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   RecordedRenderCommand
+
+      Summary:  Recorded call. uStart and uCount are the first slot and
+                the number of bound objects of a bind, the index count
+                of a draw and 1 otherwise. uNumInstances is only set
+                for instanced draws, uNumBytes only for uploads
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct RecordedRenderCommand
+    {
+        eRenderCommand Command;
+        UINT uStart;
+        UINT uCount;
+        UINT uNumInstances;
+        UINT uNumBytes;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    RecordingRenderContext
+
+      Summary:  Render context that needs no device. It counts every
+                call, the drawn indices and instances and the uploaded
+                bytes, and optionally keeps the calls in order, so the
+                CPU side of rendering can be profiled and compared
+                between runs. One context must not be shared between
+                threads
+
+      Methods:  Reset
+                  Clears the counters and the recorded calls
+                SetCommandLogEnabled
+                  Keeps or drops the calls in order, counters are
+                  always kept
+                GetCommands
+                  Returns the recorded calls
+                GetNumCalls
+                  Returns how often a call was made
+                GetNumDrawCalls
+                  Returns the number of draw calls of every kind
+                GetNumIndices
+                  Returns the number of drawn indices of all instances
+                GetNumInstances
+                  Returns the number of drawn instances
+                GetNumUploadedBytes
+                  Returns the number of bytes uploaded to constant
+                  buffers
+                RecordingRenderContext
+                  Constructor.
+                ~RecordingRenderContext
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class RecordingRenderContext final : public RenderContext
+    {
+    public:
+        RecordingRenderContext();
+        RecordingRenderContext(const RecordingRenderContext& other) = delete;
+        RecordingRenderContext(RecordingRenderContext&& other) = delete;
+        RecordingRenderContext& operator=(const RecordingRenderContext& other) = delete;
+        RecordingRenderContext& operator=(RecordingRenderContext&& other) = delete;
+        ~RecordingRenderContext() = default;
+
+        void Reset();
+        void SetCommandLogEnabled(_In_ BOOL bEnabled);
+
+        const std::vector<RecordedRenderCommand>& GetCommands() const;
+        UINT GetNumCalls(_In_ eRenderCommand command) const;
+        UINT GetNumDrawCalls() const;
+        UINT64 GetNumIndices() const;
+        UINT64 GetNumInstances() const;
+        UINT64 GetNumUploadedBytes() const;
+
+        void IASetPrimitiveTopology(_In_ D3D11_PRIMITIVE_TOPOLOGY topology) override;
+        void IASetInputLayout(_In_opt_ ID3D11InputLayout* pInputLayout) override;
+        void IASetVertexBuffers(
+            _In_ UINT uStartSlot,
+            _In_ UINT uNumBuffers,
+            _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppVertexBuffers,
+            _In_reads_opt_(uNumBuffers) const UINT* puStrides,
+            _In_reads_opt_(uNumBuffers) const UINT* puOffsets
+        ) override;
+        void IASetIndexBuffer(_In_opt_ ID3D11Buffer* pIndexBuffer, _In_ DXGI_FORMAT format, _In_ UINT uOffset) override;
+
+        void VSSetShader(
+            _In_opt_ ID3D11VertexShader* pVertexShader,
+            _In_reads_opt_(uNumClassInstances) ID3D11ClassInstance* const* ppClassInstances,
+            _In_ UINT uNumClassInstances
+        ) override;
+        void VSSetConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers) override;
+        void VSSetConstantBuffers1(
+            _In_ UINT uStartSlot,
+            _In_ UINT uNumBuffers,
+            _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers,
+            _In_reads_opt_(uNumBuffers) const UINT* puFirstConstant,
+            _In_reads_opt_(uNumBuffers) const UINT* puNumConstants
+        ) override;
+
+        void PSSetShader(
+            _In_opt_ ID3D11PixelShader* pPixelShader,
+            _In_reads_opt_(uNumClassInstances) ID3D11ClassInstance* const* ppClassInstances,
+            _In_ UINT uNumClassInstances
+        ) override;
+        void PSSetConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers) override;
+        void PSSetConstantBuffers1(
+            _In_ UINT uStartSlot,
+            _In_ UINT uNumBuffers,
+            _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers,
+            _In_reads_opt_(uNumBuffers) const UINT* puFirstConstant,
+            _In_reads_opt_(uNumBuffers) const UINT* puNumConstants
+        ) override;
+        void PSSetShaderResources(_In_ UINT uStartSlot, _In_ UINT uNumViews, _In_reads_opt_(uNumViews) ID3D11ShaderResourceView* const* ppShaderResourceViews) override;
+        void PSSetSamplers(_In_ UINT uStartSlot, _In_ UINT uNumSamplers, _In_reads_opt_(uNumSamplers) ID3D11SamplerState* const* ppSamplers) override;
+
+        void RSSetViewports(_In_ UINT uNumViewports, _In_reads_opt_(uNumViewports) const D3D11_VIEWPORT* pViewports) override;
+        void RSSetState(_In_opt_ ID3D11RasterizerState* pRasterizerState) override;
+        void OMSetRenderTargets(
+            _In_ UINT uNumViews,
+            _In_reads_opt_(uNumViews) ID3D11RenderTargetView* const* ppRenderTargetViews,
+            _In_opt_ ID3D11DepthStencilView* pDepthStencilView
+        ) override;
+        void OMSetDepthStencilState(_In_opt_ ID3D11DepthStencilState* pDepthStencilState, _In_ UINT uStencilRef) override;
+
+        void ClearRenderTargetView(_In_opt_ ID3D11RenderTargetView* pRenderTargetView, _In_ const FLOAT aColorRGBA[4]) override;
+        void ClearDepthStencilView(_In_opt_ ID3D11DepthStencilView* pDepthStencilView, _In_ UINT uClearFlags, _In_ FLOAT depth, _In_ UINT8 stencil) override;
+
+        void UpdateConstantBuffer(_In_opt_ ID3D11Buffer* pConstantBuffer, _In_reads_bytes_(uDataSize) const void* pData, _In_ UINT uDataSize) override;
+        HRESULT UpdateDynamicConstantBuffer(
+            _In_opt_ ID3D11Buffer* pConstantBuffer,
+            _In_ UINT uOffset,
+            _In_reads_bytes_(uDataSize) const void* pData,
+            _In_ UINT uDataSize,
+            _In_ BOOL bDiscard
+        ) override;
+
+        void Draw(_In_ UINT uVertexCount, _In_ UINT uStartVertexLocation) override;
+        void DrawIndexed(_In_ UINT uIndexCount, _In_ UINT uStartIndexLocation, _In_ INT iBaseVertexLocation) override;
+        void DrawIndexedInstanced(
+            _In_ UINT uIndexCountPerInstance,
+            _In_ UINT uInstanceCount,
+            _In_ UINT uStartIndexLocation,
+            _In_ INT iBaseVertexLocation,
+            _In_ UINT uStartInstanceLocation
+        ) override;
+
+        void ExecuteCommandList(_In_opt_ ID3D11CommandList* pCommandList, _In_ BOOL bRestoreContextState) override;
+
+    private:
+        void record(_In_ eRenderCommand command, _In_ UINT uStart, _In_ UINT uCount, _In_ UINT uNumInstances, _In_ UINT uNumBytes);
+
+    private:
+        std::vector<RecordedRenderCommand> m_aCommands;
+        std::array<UINT, static_cast<size_t>(eRenderCommand::COUNT)> m_auNumCalls;
+        UINT64 m_uNumIndices;
+        UINT64 m_uNumInstances;
+        UINT64 m_uNumUploadedBytes;
+        BOOL m_bCommandLogEnabled;
+    };
+}
\ No newline at end of file
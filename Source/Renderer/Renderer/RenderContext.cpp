@@ -0,0 +1,110 @@
+#include "Renderer/RenderContext.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderContext::RenderContext
+
+      Summary:  Constructor
+
+      Modifies: [m_stats, m_topology].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    RenderContext::RenderContext()
+        : m_stats()
+        , m_topology(D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED)
+    {
+        // empty
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderContext::GetStats
+
+      Summary:  Returns the counters since the last reset
+
+      Returns:  const RenderStats&
+                  Counters of the context
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const RenderStats& RenderContext::GetStats() const
+    {
+        return m_stats;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderContext::ResetStats
+
+      Summary:  Clears the counters
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RenderContext::ResetStats()
+    {
+        m_stats = RenderStats();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderContext::AddStats
+
+      Summary:  Adds the counters of another context, used to merge
+                the work recorded on deferred contexts into the
+                immediate context that executes it
+
+      Args:     const RenderStats& stats
+                  Counters to add
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RenderContext::AddStats(_In_ const RenderStats& stats)
+    {
+        m_stats.uNumDrawCalls += stats.uNumDrawCalls;
+        m_stats.uNumInstances += stats.uNumInstances;
+        m_stats.uNumTriangles += stats.uNumTriangles;
+        m_stats.uNumUploads += stats.uNumUploads;
+        m_stats.uNumUploadedBytes += stats.uNumUploadedBytes;
+        m_stats.uNumRetainedBytes += stats.uNumRetainedBytes;
+        m_stats.uNumShaderBinds += stats.uNumShaderBinds;
+        m_stats.uNumConstantBufferBinds += stats.uNumConstantBufferBinds;
+        m_stats.uNumShaderResourceBinds += stats.uNumShaderResourceBinds;
+        m_stats.uNumSamplerBinds += stats.uNumSamplerBinds;
+        m_stats.uNumSubmittedObjects += stats.uNumSubmittedObjects;
+        m_stats.uNumCulledObjects += stats.uNumCulledObjects;
+        m_stats.uNumShadowMapUpdates += stats.uNumShadowMapUpdates;
+        m_stats.uNumEstimatedFragments += stats.uNumEstimatedFragments;
+        m_stats.uNumEstimatedShadedFragments += stats.uNumEstimatedShadedFragments;
+        m_stats.uNumEstimatedCoveredPixels += stats.uNumEstimatedCoveredPixels;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderContext::countDraw
+
+      Summary:  Counts a draw with the primitive topology last set on
+                the context. Topologies other than triangle lists and
+                strips add no triangles
+
+      Args:     UINT uIndexCountPerInstance
+                  Number of indices, or vertices of a draw without an
+                  index buffer, drawn per instance
+                UINT uInstanceCount
+                  Number of instances
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RenderContext::countDraw(_In_ UINT uIndexCountPerInstance, _In_ UINT uInstanceCount)
+    {
+        UINT uNumTrianglesPerInstance = 0u;
+        switch (m_topology)
+        {
+        case D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST:
+            uNumTrianglesPerInstance = uIndexCountPerInstance / 3u;
+            break;
+        case D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP:
+            uNumTrianglesPerInstance = uIndexCountPerInstance > 2u ? uIndexCountPerInstance - 2u : 0u;
+            break;
+        default:
+            break;
+        }
+
+        ++m_stats.uNumDrawCalls;
+        m_stats.uNumInstances += uInstanceCount;
+        m_stats.uNumTriangles += static_cast<UINT64>(uNumTrianglesPerInstance) * uInstanceCount;
+    }
+}
\ No newline at end of file
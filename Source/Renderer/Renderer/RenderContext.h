@@ -0,0 +1,168 @@
+/*+===================================================================
+  File:      RENDERCONTEXT.H
+
+  Summary:   RenderContext header file contains declarations of the
+             RenderContext class, the thin backend interface the
+             renderer records its draws, state binds and constant
+             buffer uploads through.
+
+  Classes: RenderContext
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/RenderStats.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    RenderContext
+
+      Summary:  Subset of ID3D11DeviceContext used by the render
+                passes. Methods keep the names and arguments of the
+                Direct3D calls they stand for, except
+                UpdateConstantBuffer and UpdateDynamicConstantBuffer,
+                which take the size of the uploaded data so that
+                backends can count the bytes without a device. Every backend counts the calls it
+                receives into RenderStats
+
+      Methods:  IASetPrimitiveTopology
+                IASetInputLayout
+                IASetVertexBuffers
+                IASetIndexBuffer
+                VSSetShader
+                VSSetConstantBuffers
+                VSSetConstantBuffers1
+                PSSetShader
+                PSSetConstantBuffers
+                PSSetConstantBuffers1
+                PSSetShaderResources
+                PSSetSamplers
+                RSSetViewports
+                RSSetState
+                OMSetRenderTargets
+                OMSetDepthStencilState
+                ClearRenderTargetView
+                ClearDepthStencilView
+                  Same as the ID3D11DeviceContext methods
+                UpdateConstantBuffer
+                  Replaces the contents of a constant buffer
+                UpdateDynamicConstantBuffer
+                  Writes a range of a dynamic constant buffer
+                Draw
+                DrawIndexed
+                DrawIndexedInstanced
+                ExecuteCommandList
+                  Same as the ID3D11DeviceContext methods
+                GetStats
+                  Returns the counters since the last reset
+                ResetStats
+                  Clears the counters
+                AddStats
+                  Adds the counters of another context
+                countDraw
+                  Counts a draw
+                RenderContext
+                  Constructor.
+                ~RenderContext
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class RenderContext
+    {
+    public:
+        RenderContext();
+        RenderContext(const RenderContext& other) = delete;
+        RenderContext(RenderContext&& other) = delete;
+        RenderContext& operator=(const RenderContext& other) = delete;
+        RenderContext& operator=(RenderContext&& other) = delete;
+        virtual ~RenderContext() = default;
+
+        virtual void IASetPrimitiveTopology(_In_ D3D11_PRIMITIVE_TOPOLOGY topology) = 0;
+        virtual void IASetInputLayout(_In_opt_ ID3D11InputLayout* pInputLayout) = 0;
+        virtual void IASetVertexBuffers(
+            _In_ UINT uStartSlot,
+            _In_ UINT uNumBuffers,
+            _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppVertexBuffers,
+            _In_reads_opt_(uNumBuffers) const UINT* puStrides,
+            _In_reads_opt_(uNumBuffers) const UINT* puOffsets
+        ) = 0;
+        virtual void IASetIndexBuffer(_In_opt_ ID3D11Buffer* pIndexBuffer, _In_ DXGI_FORMAT format, _In_ UINT uOffset) = 0;
+
+        virtual void VSSetShader(
+            _In_opt_ ID3D11VertexShader* pVertexShader,
+            _In_reads_opt_(uNumClassInstances) ID3D11ClassInstance* const* ppClassInstances,
+            _In_ UINT uNumClassInstances
+        ) = 0;
+        virtual void VSSetConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers) = 0;
+        virtual void VSSetConstantBuffers1(
+            _In_ UINT uStartSlot,
+            _In_ UINT uNumBuffers,
+            _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers,
+            _In_reads_opt_(uNumBuffers) const UINT* puFirstConstant,
+            _In_reads_opt_(uNumBuffers) const UINT* puNumConstants
+        ) = 0;
+
+        virtual void PSSetShader(
+            _In_opt_ ID3D11PixelShader* pPixelShader,
+            _In_reads_opt_(uNumClassInstances) ID3D11ClassInstance* const* ppClassInstances,
+            _In_ UINT uNumClassInstances
+        ) = 0;
+        virtual void PSSetConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers) = 0;
+        virtual void PSSetConstantBuffers1(
+            _In_ UINT uStartSlot,
+            _In_ UINT uNumBuffers,
+            _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers,
+            _In_reads_opt_(uNumBuffers) const UINT* puFirstConstant,
+            _In_reads_opt_(uNumBuffers) const UINT* puNumConstants
+        ) = 0;
+        virtual void PSSetShaderResources(_In_ UINT uStartSlot, _In_ UINT uNumViews, _In_reads_opt_(uNumViews) ID3D11ShaderResourceView* const* ppShaderResourceViews) = 0;
+        virtual void PSSetSamplers(_In_ UINT uStartSlot, _In_ UINT uNumSamplers, _In_reads_opt_(uNumSamplers) ID3D11SamplerState* const* ppSamplers) = 0;
+
+        virtual void RSSetViewports(_In_ UINT uNumViewports, _In_reads_opt_(uNumViewports) const D3D11_VIEWPORT* pViewports) = 0;
+        virtual void RSSetState(_In_opt_ ID3D11RasterizerState* pRasterizerState) = 0;
+        virtual void OMSetRenderTargets(
+            _In_ UINT uNumViews,
+            _In_reads_opt_(uNumViews) ID3D11RenderTargetView* const* ppRenderTargetViews,
+            _In_opt_ ID3D11DepthStencilView* pDepthStencilView
+        ) = 0;
+        virtual void OMSetDepthStencilState(_In_opt_ ID3D11DepthStencilState* pDepthStencilState, _In_ UINT uStencilRef) = 0;
+
+        virtual void ClearRenderTargetView(_In_opt_ ID3D11RenderTargetView* pRenderTargetView, _In_ const FLOAT aColorRGBA[4]) = 0;
+        virtual void ClearDepthStencilView(_In_opt_ ID3D11DepthStencilView* pDepthStencilView, _In_ UINT uClearFlags, _In_ FLOAT depth, _In_ UINT8 stencil) = 0;
+
+        virtual void UpdateConstantBuffer(_In_opt_ ID3D11Buffer* pConstantBuffer, _In_reads_bytes_(uDataSize) const void* pData, _In_ UINT uDataSize) = 0;
+        virtual HRESULT UpdateDynamicConstantBuffer(
+            _In_opt_ ID3D11Buffer* pConstantBuffer,
+            _In_ UINT uOffset,
+            _In_reads_bytes_(uDataSize) const void* pData,
+            _In_ UINT uDataSize,
+            _In_ BOOL bDiscard
+        ) = 0;
+
+        virtual void Draw(_In_ UINT uVertexCount, _In_ UINT uStartVertexLocation) = 0;
+        virtual void DrawIndexed(_In_ UINT uIndexCount, _In_ UINT uStartIndexLocation, _In_ INT iBaseVertexLocation) = 0;
+        virtual void DrawIndexedInstanced(
+            _In_ UINT uIndexCountPerInstance,
+            _In_ UINT uInstanceCount,
+            _In_ UINT uStartIndexLocation,
+            _In_ INT iBaseVertexLocation,
+            _In_ UINT uStartInstanceLocation
+        ) = 0;
+
+        virtual void ExecuteCommandList(_In_opt_ ID3D11CommandList* pCommandList, _In_ BOOL bRestoreContextState) = 0;
+
+        const RenderStats& GetStats() const;
+        void ResetStats();
+        void AddStats(_In_ const RenderStats& stats);
+
+    protected:
+        void countDraw(_In_ UINT uIndexCountPerInstance, _In_ UINT uInstanceCount);
+
+    protected:
+        RenderStats m_stats;
+        D3D11_PRIMITIVE_TOPOLOGY m_topology;
+    };
+}
\ No newline at end of file
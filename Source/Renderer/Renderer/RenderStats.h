@@ -0,0 +1,52 @@
+/*+===================================================================
+  File:      RENDERSTATS.H
+
+  Summary:   RenderStats header file contains declarations of the
+             RenderStats struct that counts the work a frame sends to
+             the GPU.
+
+  Classes: RenderStats
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   RenderStats
+
+      Summary:  Counters of one frame. Binds count the bound objects,
+                not the calls, so that a call binding three textures
+                counts three shader resource binds. Submitted objects
+                are the objects in the draw lists, culled objects the
+                ones left out of them. Retained bytes are constant
+                buffer data that did not change and was reused from an
+                earlier frame instead of being uploaded. Shadow map
+                updates are the shadow passes that rendered a slice.
+                The estimated fragments are what the scene passes
+                rasterize and shade over the covered pixels, taken
+                from the screen bounds of the objects on the CPU
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct RenderStats
+    {
+        UINT uNumDrawCalls;
+        UINT64 uNumInstances;
+        UINT64 uNumTriangles;
+        UINT uNumUploads;
+        UINT64 uNumUploadedBytes;
+        UINT64 uNumRetainedBytes;
+        UINT uNumShaderBinds;
+        UINT uNumConstantBufferBinds;
+        UINT uNumShaderResourceBinds;
+        UINT uNumSamplerBinds;
+        UINT uNumSubmittedObjects;
+        UINT uNumCulledObjects;
+        UINT uNumShadowMapUpdates;
+        UINT64 uNumEstimatedFragments;
+        UINT64 uNumEstimatedShadedFragments;
+        UINT64 uNumEstimatedCoveredPixels;
+    };
+}
\ No newline at end of file
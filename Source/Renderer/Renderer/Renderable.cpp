@@ -4,6 +4,7 @@
 #include "assimp/scene.h"		// output data structure
 #include "assimp/postprocess.h"	// post processing flags
 
+#include "Renderer/VersionCounter.h"
 #include "Texture/DDSTextureLoader.h"
 
 namespace library
@@ -16,15 +17,14 @@ namespace library
       Args:     const XMFLOAT4& outputColor
                   Default color to shader the renderable
 
-      Modifies: [m_vertexBuffer, m_indexBuffer, m_constantBuffer,
-                 m_normalBuffer, m_aMeshes, m_aMaterials, m_vertexShader,
+      Modifies: [m_vertexBuffer, m_indexBuffer, m_normalBuffer,
+                 m_aMeshes, m_aMaterials, m_vertexShader,
                  m_pixelShader, m_outputColor, m_world, m_bHasNormalMap
-                 m_aNormalData].
+                 m_uVersion, m_aNormalData].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     Renderable::Renderable(_In_ const XMFLOAT4& outputColor)
         : m_vertexBuffer()
         , m_indexBuffer()
-        , m_constantBuffer()
         , m_normalBuffer()
         , m_aMeshes(std::vector<BasicMeshEntry>())
         , m_aMaterials(std::vector<std::shared_ptr<Material>>())
@@ -35,6 +35,8 @@ namespace library
         , m_padding()
         , m_world(XMMatrixIdentity())
         , m_bHasNormalMap(FALSE)
+        , m_uVersion(VersionCounter::Next())
+        , m_localBounds()
     {
         // empty
     }
@@ -51,8 +53,8 @@ namespace library
                 PCWSTR pszTextureFileName
                   File name of the texture to usen
 
-      Modifies: [m_vertexBuffer, m_normalBuffer, m_indexBuffer
-                 m_constantBuffer].
+      Modifies: [m_vertexBuffer, m_normalBuffer, m_indexBuffer,
+                 m_localBounds, m_uVersion].
 
       Returns:  HRESULT
                   Status code
@@ -152,37 +154,8 @@ namespace library
             return hr;
         }
 
-        // Create the constant buffer
-        D3D11_BUFFER_DESC cBufferDesc =
-        {
-            .ByteWidth = sizeof(CBChangesEveryFrame),
-            .Usage = D3D11_USAGE_DEFAULT,
-            .BindFlags = D3D11_BIND_CONSTANT_BUFFER,
-            .CPUAccessFlags = 0u,
-            .MiscFlags = 0u,
-            .StructureByteStride = 0u
-        };
-        CBChangesEveryFrame cbChangesEveryFrame =
-        {
-            .World = XMMatrixTranspose(m_world),
-            .OutputColor = m_outputColor,
-            .HasNormalMap = m_bHasNormalMap
-        };
-        D3D11_SUBRESOURCE_DATA cInitData =
-        {
-            .pSysMem = &cbChangesEveryFrame,
-            .SysMemPitch = 0u,
-            .SysMemSlicePitch = 0u
-        };
-        if (FAILED(pDevice->CreateBuffer(&cBufferDesc, &cInitData, m_constantBuffer.GetAddressOf())))
-        {
-            MessageBox(
-                nullptr,
-                L"Call to CreateChangesEveryFrameBuffer failed!",
-                L"Game Graphics Programming",
-                NULL
-            );
-        }
+        BoundingBox::CreateFromPoints(m_localBounds, GetNumVertices(), &getVertices()->Position, sizeof(SimpleVertex));
+        markDirty();
 
         return hr;
     }
@@ -364,6 +337,7 @@ namespace library
         if (m_aMaterials[uMeshIndex]->pNormal)
         {
             m_bHasNormalMap = true;
+            markDirty();
         }
 
         return S_OK;
@@ -434,19 +408,6 @@ namespace library
         return m_indexBuffer;
     }
 
-    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Renderable::GetConstantBuffer
-
-      Summary:  Returns the constant buffer
-
-      Returns:  ComPtr<ID3D11Buffer>&
-                  Constant buffer
-    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    ComPtr<ID3D11Buffer>& Renderable::GetConstantBuffer()
-    {
-        return m_constantBuffer;
-    }
-
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderable::GetNormalBuffer
 
@@ -547,12 +508,13 @@ namespace library
       Args:     FLOAT angle
                   Angle of rotation around the x-axis, in radians
 
-      Modifies: [m_world].
+      Modifies: [m_world, m_uVersion].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     void Renderable::RotateX(_In_ FLOAT angle)
     {
         // m_world *= x-axis rotation by angle matrix
         m_world *= XMMatrixRotationX(angle);
+        markDirty();
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -563,12 +525,13 @@ namespace library
       Args:     FLOAT angle
                   Angle of rotation around the y-axis, in radians
 
-      Modifies: [m_world].
+      Modifies: [m_world, m_uVersion].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     void Renderable::RotateY(_In_ FLOAT angle)
     {
         // m_world *= y-axis rotation by angle matrix
         m_world *= XMMatrixRotationY(angle);
+        markDirty();
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -579,12 +542,13 @@ namespace library
       Args:     FLOAT angle
                   Angle of rotation around the z-axis, in radians
 
-      Modifies: [m_world].
+      Modifies: [m_world, m_uVersion].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     void Renderable::RotateZ(_In_ FLOAT angle)
     {
         // m_world *= z-axis rotation by angle matrix
         m_world *= XMMatrixRotationZ(angle);
+        markDirty();
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -599,12 +563,13 @@ namespace library
                 FLOAT roll
                   Angle of rotation around the z-axis, in radians
 
-      Modifies: [m_world].
+      Modifies: [m_world, m_uVersion].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     void Renderable::RotateRollPitchYaw(_In_ FLOAT pitch, _In_ FLOAT yaw, _In_ FLOAT roll)
     {
         // m_world *= x, y, z-axis rotation by pitch, yaw, roll matrix
         m_world *= XMMatrixRotationRollPitchYaw(pitch, yaw, roll);
+        markDirty();
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -619,12 +584,13 @@ namespace library
                 FLOAT scaleZ
                   Scaling factor along the z-axis.
 
-      Modifies: [m_world].
+      Modifies: [m_world, m_uVersion].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     void Renderable::Scale(_In_ FLOAT scaleX, _In_ FLOAT scaleY, _In_ FLOAT scaleZ)
     {
         // m_world *= x, y, z-axis scaling by scale factor matrix
         m_world *= XMMatrixScaling(scaleX, scaleY, scaleZ);
+        markDirty();
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -635,12 +601,13 @@ namespace library
       Args:     const XMVECTOR& offset
                   3D vector describing the translations along the x-axis, y-axis, and z-axis
 
-      Modifies: [m_world].
+      Modifies: [m_world, m_uVersion].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     void Renderable::Translate(_In_ const XMVECTOR& offset)
     {
         // m_world *= translate by offset vector matrix
         m_world *= XMMatrixTranslationFromVector(offset);
+        markDirty();
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -680,4 +647,63 @@ namespace library
     {
         return m_bHasNormalMap;
     }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderable::SetWorldMatrix
+
+      Summary:  Replaces the world matrix
+
+      Args:     const XMMATRIX& world
+                  The new world matrix
+
+      Modifies: [m_world, m_uVersion].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderable::SetWorldMatrix(_In_ const XMMATRIX& world)
+    {
+        m_world = world;
+        markDirty();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderable::GetVersion
+
+      Summary:  Returns the version of the shader constants of the
+                renderable. It changes whenever the world matrix, the
+                output color or the normal map flag, or the skinning of
+                a model changes, so unchanged constants need no upload
+
+      Returns:  UINT64
+                  Version taken from VersionCounter
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 Renderable::GetVersion() const
+    {
+        return m_uVersion;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderable::GetLocalBounds
+
+      Summary:  Returns the axis aligned bounds of the vertices in
+                object space, computed when the buffers are created
+
+      Returns:  const BoundingBox&
+                  Object space bounds
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const BoundingBox& Renderable::GetLocalBounds() const
+    {
+        return m_localBounds;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderable::markDirty
+
+      Summary:  Takes a new version after the shader constants of the
+                renderable changed
+
+      Modifies: [m_uVersion].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderable::markDirty()
+    {
+        m_uVersion = VersionCounter::Next();
+    }
 }
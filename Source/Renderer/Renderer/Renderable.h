@@ -35,10 +35,14 @@ namespace library
                   Returns the vertex buffer
                 GetIndexBuffer
                   Returns the index buffer
-                GetConstantBuffer
-                  Returns the constant buffer
                 GetWorldMatrix
                   Returns the world matrix
+                SetWorldMatrix
+                  Replaces the world matrix
+                GetVersion
+                  Returns the version of the shader constants
+                GetLocalBounds
+                  Returns the object space bounds
                 GetNumVertices
                   Pure virtual function that returns the number of
                   vertices
@@ -94,7 +98,6 @@ namespace library
         ComPtr<ID3D11InputLayout>& GetVertexLayout();
         ComPtr<ID3D11Buffer>& GetVertexBuffer();
         ComPtr<ID3D11Buffer>& GetIndexBuffer();
-        ComPtr<ID3D11Buffer>& GetConstantBuffer();
         ComPtr<ID3D11Buffer>& GetNormalBuffer();
 
         const XMMATRIX& GetWorldMatrix() const;
@@ -109,6 +112,10 @@ namespace library
         void RotateRollPitchYaw(_In_ FLOAT roll, _In_ FLOAT pitch, _In_ FLOAT yaw);
         void Scale(_In_ FLOAT scaleX, _In_ FLOAT scaleY, _In_ FLOAT scaleZ);
         void Translate(_In_ const XMVECTOR& offset);
+        void SetWorldMatrix(_In_ const XMMATRIX& world);
+
+        UINT64 GetVersion() const;
+        const BoundingBox& GetLocalBounds() const;
 
         virtual UINT GetNumVertices() const = 0;
         virtual UINT GetNumIndices() const = 0;
@@ -125,13 +132,13 @@ namespace library
             _In_ ID3D11DeviceContext* pImmediateContext
         );
 
+        void markDirty();
         void calculateNormalMapVectors();
         void calculateTangentBitangent(_In_ const SimpleVertex& v1, _In_ const SimpleVertex& v2, _In_ const SimpleVertex& v3, _Out_ XMFLOAT3& tangent, _Out_ XMFLOAT3& bitangent);
 
     protected:
         ComPtr<ID3D11Buffer> m_vertexBuffer;
         ComPtr<ID3D11Buffer> m_indexBuffer;
-        ComPtr<ID3D11Buffer> m_constantBuffer;
         ComPtr<ID3D11Buffer> m_normalBuffer;
 
         std::vector<BasicMeshEntry> m_aMeshes;
@@ -145,5 +152,7 @@ namespace library
         BYTE m_padding[8];
         XMMATRIX m_world;
         BOOL m_bHasNormalMap;
+        UINT64 m_uVersion;
+        BoundingBox m_localBounds;
     };
 }
\ No newline at end of file
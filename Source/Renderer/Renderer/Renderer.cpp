@@ -1,5 +1,9 @@
 #include "Renderer/Renderer.h"
 
+#include "Renderer/VersionCounter.h"
+
+#include <algorithm>
+
 namespace library
 {
 
@@ -8,16 +12,46 @@ namespace library
 
       Summary:  Constructor
 
-      Modifies: [m_driverType, m_featureLevel, m_d3dDevice, m_d3dDevice1,
+      Modifies: [m_driverType, m_requestedDriverType, m_featureLevel,
+                  m_d3dDevice, m_d3dDevice1,
                   m_immediateContext, m_immediateContext1, m_swapChain,
-                  m_swapChain1, m_renderTargetView, m_depthStencil,
-                  m_depthStencilView, m_cbChangeOnResize, m_cbShadowMatrix,
-                  m_pszMainSceneName, m_camera, m_projection, m_scenes
-                  m_invalidTexture, m_shadowMapTexture, m_shadowVertexShader,
-                  m_shadowPixelShader].
+                  m_swapChain1, m_renderTargetView, m_cbFrame,
+                  m_pMainScene, m_camera,
+                  m_projection, m_scenes m_invalidTexture,
+                  m_shadowMap, m_uShadowMapSize, m_shadowMapFormat,
+                  m_shadowVertexShader, m_aShadowLights, m_uShadowBudget,
+                  m_uShadowVersion, m_cascadeShadowMap,
+                  m_shadowCascades, m_aCascades, m_lightClusters,
+                  m_aClusterLights, m_uClusterLightsVersion,
+                  m_uClustersVersion, m_bClusterLightsDirty,
+                  m_bClustersDirty, m_clusterLightBuffer,
+                  m_clusterLightView, m_uClusterLightCapacity,
+                  m_clusterRangeBuffer, m_clusterRangeView,
+                  m_clusterIndexBuffer, m_clusterIndexView,
+                  m_uClusterIndexCapacity, m_renderPath,
+                  m_voxelGBufferPixelShader,
+                  m_deferredLightingVertexShader,
+                  m_deferredLightingPixelShader, m_depthEqualState,
+                  m_bDepthPrepassVoxels, m_bDepthPrepassModels,
+                  m_aDepthPrepassObjects, m_overdrawEstimator,
+                  m_occlusionCuller, m_bOcclusionCulling,
+                  m_aOccluders, m_uOccludersVersion,
+                  m_uNumOccluderVoxels, m_aVoxelVisible, m_aModelVisible,
+                  m_textureStreamer, m_uTextureStreamingBudget,
+                  m_frameGraph, m_commandRecorder,
+                  m_bHasCommandRecorder, m_aRenderableDrawList,
+                  m_aVoxelDrawList, m_aModelDrawList, m_pSkybox,
+                  m_viewport,
+                  m_renderContext, m_gpuProfiler, m_renderStats,
+                  m_uRenderStatsDumpInterval, m_uNumRenderedFrames,
+                  m_constantBufferRing, m_bCanMapNoOverwrite,
+                  m_frameConstants, m_aRenderableConstants,
+                  m_aVoxelConstants, m_aModelConstants,
+                  m_skyboxConstants].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     Renderer::Renderer()
         : m_driverType(D3D_DRIVER_TYPE_NULL)
+        , m_requestedDriverType(D3D_DRIVER_TYPE_UNKNOWN)
         , m_featureLevel(D3D_FEATURE_LEVEL_11_0)
         , m_d3dDevice()
         , m_d3dDevice1()
@@ -26,20 +60,75 @@ namespace library
         , m_swapChain()
         , m_swapChain1()
         , m_renderTargetView()
-        , m_depthStencil()
-        , m_depthStencilView()
-        , m_cbChangeOnResize()
-        , m_cbLights()
-        , m_cbShadowMatrix()
-        , m_pszMainSceneName(nullptr)
+        , m_cbFrame()
+        , m_pMainScene(nullptr)
         , m_padding{ '\0' }
         , m_camera(XMVectorSet(0.0f, 3.0f, -6.0f, 0.0f))
         , m_projection(XMMatrixIdentity())
         , m_scenes()
         , m_invalidTexture(std::make_shared<Texture>(L"Content/Common/InvalidTexture.png"))
-        , m_shadowMapTexture()
+        , m_shadowMap()
+        , m_uShadowMapSize(ShadowMap::DEFAULT_SIZE)
+        , m_shadowMapFormat(DXGI_FORMAT_D32_FLOAT)
         , m_shadowVertexShader()
-        , m_shadowPixelShader()
+        , m_aShadowLights()
+        , m_uShadowBudget(NUM_LIGHTS)
+        , m_uShadowVersion(0u)
+        , m_cascadeShadowMap()
+        , m_shadowCascades()
+        , m_aCascades()
+        , m_lightClusters()
+        , m_aClusterLights()
+        , m_uClusterLightsVersion(0u)
+        , m_uClustersVersion(0u)
+        , m_bClusterLightsDirty(FALSE)
+        , m_bClustersDirty(FALSE)
+        , m_clusterLightBuffer()
+        , m_clusterLightView()
+        , m_uClusterLightCapacity(0u)
+        , m_clusterRangeBuffer()
+        , m_clusterRangeView()
+        , m_clusterIndexBuffer()
+        , m_clusterIndexView()
+        , m_uClusterIndexCapacity(0u)
+        , m_renderPath(eRenderPath::FORWARD)
+        , m_voxelGBufferPixelShader()
+        , m_deferredLightingVertexShader()
+        , m_deferredLightingPixelShader()
+        , m_depthEqualState()
+        , m_bDepthPrepassVoxels(FALSE)
+        , m_bDepthPrepassModels(FALSE)
+        , m_aDepthPrepassObjects()
+        , m_overdrawEstimator()
+        , m_occlusionCuller()
+        , m_bOcclusionCulling(FALSE)
+        , m_aOccluders()
+        , m_uOccludersVersion(0u)
+        , m_uNumOccluderVoxels(0u)
+        , m_aVoxelVisible()
+        , m_aModelVisible()
+        , m_textureStreamer()
+        , m_uTextureStreamingBudget(TextureStreamer::DEFAULT_BUDGET)
+        , m_frameGraph()
+        , m_commandRecorder()
+        , m_bHasCommandRecorder(FALSE)
+        , m_aRenderableDrawList()
+        , m_aVoxelDrawList()
+        , m_aModelDrawList()
+        , m_pSkybox(nullptr)
+        , m_viewport()
+        , m_renderContext()
+        , m_gpuProfiler()
+        , m_renderStats()
+        , m_uRenderStatsDumpInterval(0u)
+        , m_uNumRenderedFrames(0u)
+        , m_constantBufferRing()
+        , m_bCanMapNoOverwrite(FALSE)
+        , m_frameConstants()
+        , m_aRenderableConstants()
+        , m_aVoxelConstants()
+        , m_aModelConstants()
+        , m_skyboxConstants()
     {
         // empty
     }
@@ -56,7 +145,15 @@ namespace library
                   m_d3dDevice1, m_immediateContext1, m_swapChain1,
                   m_swapChain, m_renderTargetView, m_vertexShader,
                   m_vertexLayout, m_pixelShader, m_vertexBuffer
-                  m_cbShadowMatrix].
+                  m_bCanMapNoOverwrite, m_lightClusters,
+                  m_occlusionCuller, m_textureStreamer,
+                  m_clusterLightBuffer, m_clusterLightView,
+                  m_uClusterLightCapacity, m_clusterRangeBuffer,
+                  m_clusterRangeView, m_clusterIndexBuffer,
+                  m_clusterIndexView, m_uClusterIndexCapacity,
+                  m_depthEqualState, m_frameGraph, m_commandRecorder,
+                  m_viewport, m_renderContext, m_gpuProfiler,
+                  m_constantBufferRing].
 
       Returns:  HRESULT
                   Status code
@@ -82,6 +179,12 @@ namespace library
             D3D_DRIVER_TYPE_REFERENCE,
         };
         UINT numDriverTypes = ARRAYSIZE(driverTypes);
+        if (m_requestedDriverType != D3D_DRIVER_TYPE_UNKNOWN)
+        {
+            // Only try the requested driver, such as WARP on a machine without a GPU
+            driverTypes[0] = m_requestedDriverType;
+            numDriverTypes = 1u;
+        }
 
         D3D_FEATURE_LEVEL featureLevels[] =
         {
@@ -201,43 +304,21 @@ namespace library
             return hr;
         }
 
-        // Create depth stencil texture
-        D3D11_TEXTURE2D_DESC descDepth =
-        {
-            .Width = uWidth,
-            .Height = uHeight,
-            .MipLevels = 1u,
-            .ArraySize = 1u,
-            .Format = DXGI_FORMAT_D24_UNORM_S8_UINT,
-            .SampleDesc = {.Count = 1u, .Quality = 0u },
-            .Usage = D3D11_USAGE_DEFAULT,
-            .BindFlags = D3D11_BIND_DEPTH_STENCIL,
-            .CPUAccessFlags = 0u,
-            .MiscFlags = 0u
-        };
-        hr = m_d3dDevice->CreateTexture2D(&descDepth, nullptr, m_depthStencil.GetAddressOf());
-        if (FAILED(hr))
-        {
-            return hr;
-        }
+        // Passes record to the immediate context through the render context
+        m_renderContext = std::make_unique<D3D11RenderContext>(m_immediateContext.Get());
 
-        // Create the depth stencil view
-        D3D11_DEPTH_STENCIL_VIEW_DESC descDSV =
-        {
-            .Format = descDepth.Format,
-            .ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2D,
-            .Texture2D = {.MipSlice = 0 }
-        };
-        hr = m_d3dDevice->CreateDepthStencilView(m_depthStencil.Get(), &descDSV, m_depthStencilView.GetAddressOf());
-        if (FAILED(hr))
+#if PROFILER_ENABLED
+        // Time the passes on the GPU, the renderer runs without timings if the queries fail
+        m_gpuProfiler = std::make_unique<GpuProfiler>(std::make_unique<D3D11GpuTimerBackend>(m_d3dDevice.Get(), m_immediateContext.Get()));
+        if (FAILED(m_gpuProfiler->Initialize()))
         {
-            return hr;
+            OutputDebugString(L"Creating GPU timestamp queries failed, passes are not timed on the GPU\n");
+            m_gpuProfiler.reset();
         }
-
-        m_immediateContext->OMSetRenderTargets(1, m_renderTargetView.GetAddressOf(), m_depthStencilView.Get());
+#endif
 
         // Setup the viewport
-        D3D11_VIEWPORT vp =
+        m_viewport =
         {
             .TopLeftX = 0.0f,
             .TopLeftY = 0.0f,
@@ -246,95 +327,238 @@ namespace library
             .MinDepth = 0.0f,
             .MaxDepth = 1.0f,
         };
-        m_immediateContext->RSSetViewports(1, &vp);
+        m_immediateContext->RSSetViewports(1, &m_viewport);
 
         // Set primitive topology
         m_immediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
-        // Create the constant buffers
-        D3D11_BUFFER_DESC bd =
-        {
-            .ByteWidth = sizeof(CBChangeOnResize),
-            .Usage = D3D11_USAGE_DEFAULT,
-            .BindFlags = D3D11_BIND_CONSTANT_BUFFER,
-            .CPUAccessFlags = 0
-        };
-        hr = m_d3dDevice->CreateBuffer(&bd, nullptr, m_cbChangeOnResize.GetAddressOf());
-        if (FAILED(hr))
+        // Constant buffer data of a frame is sub-allocated from one dynamic buffer and bound with offsets
+        D3D11_FEATURE_DATA_D3D11_OPTIONS options = {};
+        hr = m_d3dDevice->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options));
+        if (FAILED(hr) || !m_immediateContext1 || !options.ConstantBufferOffsetting)
         {
-            return hr;
+            MessageBox(
+                nullptr,
+                L"Constant buffer offsets require Direct3D 11.1!",
+                L"Game Graphics Programming",
+                NULL
+            );
+            return E_NOTIMPL;
         }
+        m_bCanMapNoOverwrite = options.MapNoOverwriteOnDynamicConstantBuffer;
 
         // Initialize the projection matrix
         m_projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, static_cast<FLOAT>(uWidth) / static_cast<FLOAT>(uHeight), 0.01f, 1000.0f);
 
-        CBChangeOnResize cbChangesOnResize =
+        // Retained constants hold the previous projection
+        m_constantBufferRing.Reset();
+
+        if (!m_pMainScene)
         {
-            .Projection = XMMatrixTranspose(m_projection)
-        };
-        m_immediateContext->UpdateSubresource(m_cbChangeOnResize.Get(), 0, nullptr, &cbChangesOnResize, 0, 0);
+            return E_FAIL;
+        }
+
+        hr = m_pMainScene->Initialize(m_d3dDevice.Get(), m_immediateContext.Get());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
 
-        bd.ByteWidth = sizeof(CBLights);
-        bd.Usage = D3D11_USAGE_DEFAULT;
-        bd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-        bd.CPUAccessFlags = 0u;
+        hr = m_invalidTexture->Initialize(m_d3dDevice.Get(), m_immediateContext.Get());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
 
-        hr = m_d3dDevice->CreateBuffer(&bd, nullptr, m_cbLights.GetAddressOf());
+        // Initialize a shadow map slice per light, the resolution does not depend on the window
+        m_shadowMap = std::make_shared<ShadowMap>(m_uShadowMapSize, m_shadowMapFormat, NUM_LIGHTS);
+        hr = m_shadowMap->Initialize(m_d3dDevice.Get());
         if (FAILED(hr))
         {
             return hr;
         }
 
-        m_camera.Initialize(m_d3dDevice.Get());
+        WCHAR szShadowMap[64];
+        swprintf_s(
+            szShadowMap,
+            L"Shadow map: %ux%u x %u, %llu KB\n",
+            m_uShadowMapSize,
+            m_uShadowMapSize,
+            m_shadowMap->GetNumSlices(),
+            m_shadowMap->GetMemorySize() / 1024u
+        );
+        OutputDebugString(szShadowMap);
+
+        // Initialize a slice per cascade of the directional light at the same resolution
+        m_cascadeShadowMap = std::make_shared<ShadowMap>(m_uShadowMapSize, m_shadowMapFormat, NUM_CASCADES);
+        hr = m_cascadeShadowMap->Initialize(m_d3dDevice.Get());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
 
-        if (!m_scenes.contains(m_pszMainSceneName))
+        swprintf_s(
+            szShadowMap,
+            L"Cascaded shadow map: %ux%u x %u, %llu KB\n",
+            m_uShadowMapSize,
+            m_uShadowMapSize,
+            m_cascadeShadowMap->GetNumSlices(),
+            m_cascadeShadowMap->GetMemorySize() / 1024u
+        );
+        OutputDebugString(szShadowMap);
+
+        // Initialize the point lights of main scene, the light projection matches the square shadow map
+        for (UINT i = 0; i < NUM_LIGHTS; ++i)
         {
-            return E_FAIL;
+            m_pMainScene->GetPointLight(i)->Initialize(m_uShadowMapSize, m_uShadowMapSize);
+        }
+
+        // Local lights are binned into clusters on the worker threads and read by the scene passes from structured buffers
+        m_lightClusters = std::make_unique<LightClusters>(AssetLoader::GetDefaultNumThreads());
+
+        // Occluders are rasterized on the worker threads too
+        m_occlusionCuller = std::make_unique<OcclusionCuller>(AssetLoader::GetDefaultNumThreads());
+
+        // Textures were created with their tail mips only, the rest is streamed in as they come into view
+        if (Texture::IsStreamingEnabled())
+        {
+            m_textureStreamer = std::make_unique<TextureStreamer>(m_uTextureStreamingBudget);
         }
 
-        hr = m_scenes[m_pszMainSceneName]->Initialize(m_d3dDevice.Get(), m_immediateContext.Get());
+        m_uClusterLightCapacity = INITIAL_CLUSTER_BUFFER_SIZE;
+        hr = createStructuredBuffer(sizeof(ClusterLight), m_uClusterLightCapacity, m_clusterLightBuffer, m_clusterLightView);
         if (FAILED(hr))
         {
             return hr;
         }
 
-        hr = m_invalidTexture->Initialize(m_d3dDevice.Get(), m_immediateContext.Get());
+        hr = createStructuredBuffer(sizeof(XMUINT2), LightClusters::NUM_CLUSTERS, m_clusterRangeBuffer, m_clusterRangeView);
         if (FAILED(hr))
         {
             return hr;
         }
 
-        // Create shadow matrix constant buffer
-        bd.ByteWidth = sizeof(CBShadowMatrix);
-        bd.Usage = D3D11_USAGE_DEFAULT;
-        bd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-        bd.CPUAccessFlags = 0u;
+        m_uClusterIndexCapacity = INITIAL_CLUSTER_BUFFER_SIZE;
+        hr = createStructuredBuffer(sizeof(UINT), m_uClusterIndexCapacity, m_clusterIndexBuffer, m_clusterIndexView);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
 
-        hr = m_d3dDevice->CreateBuffer(&bd, nullptr, m_cbShadowMatrix.GetAddressOf());
+        // Passes drawing over the depth pre-pass only shade the pixels whose depth it wrote
+        D3D11_DEPTH_STENCIL_DESC depthEqualDesc =
+        {
+            .DepthEnable = TRUE,
+            .DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ZERO,
+            .DepthFunc = D3D11_COMPARISON_EQUAL,
+            .StencilEnable = FALSE,
+            .StencilReadMask = D3D11_DEFAULT_STENCIL_READ_MASK,
+            .StencilWriteMask = D3D11_DEFAULT_STENCIL_WRITE_MASK,
+            .FrontFace = { D3D11_STENCIL_OP_KEEP, D3D11_STENCIL_OP_KEEP, D3D11_STENCIL_OP_KEEP, D3D11_COMPARISON_ALWAYS },
+            .BackFace = { D3D11_STENCIL_OP_KEEP, D3D11_STENCIL_OP_KEEP, D3D11_STENCIL_OP_KEEP, D3D11_COMPARISON_ALWAYS }
+        };
+        hr = m_d3dDevice->CreateDepthStencilState(&depthEqualDesc, m_depthEqualState.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        // Build the passes of a frame
+        hr = initializeFrameGraph(uWidth, uHeight);
         if (FAILED(hr))
         {
-            MessageBox(
-                nullptr,
-                L"Call to CreateShadowMatrixBuffer failed!",
-                L"Game Graphics Programming",
-                NULL
-            );
             return hr;
         }
 
-        // Initialize the shadow map texture
-        m_shadowMapTexture = std::make_shared<RenderTexture>(uWidth, uHeight);
-        m_shadowMapTexture->Initialize(m_d3dDevice.Get(), m_immediateContext.Get());
+        hr = m_frameGraph.Realize(m_d3dDevice.Get());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
 
-        // Initialize the point lights of main scene
-        for (UINT i = 0; i < NUM_LIGHTS; ++i)
+        // Record large passes on one deferred context per worker thread
+        UINT uNumContexts = AssetLoader::GetDefaultNumThreads();
+        if (!m_bHasCommandRecorder && uNumContexts > 1u)
         {
-            m_scenes[m_pszMainSceneName]->GetPointLight(i)->Initialize(uWidth, uHeight);
+            D3D11_FEATURE_DATA_THREADING threading = {};
+            hr = m_d3dDevice->CheckFeatureSupport(D3D11_FEATURE_THREADING, &threading, sizeof(threading));
+            if (SUCCEEDED(hr) && !threading.DriverCommandLists)
+            {
+                OutputDebugString(L"Driver has no native command lists, the runtime emulates them\n");
+            }
+
+            std::unique_ptr<DeferredCommandRecorder> commandRecorder = std::make_unique<DeferredCommandRecorder>(uNumContexts);
+            hr = commandRecorder->Initialize(m_d3dDevice.Get());
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+
+            m_commandRecorder = std::move(commandRecorder);
         }
 
         return hr;
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::InitializeHeadless
+
+      Summary:  Sets up the CPU side of the renderer without a device,
+                window or swap chain, so frames can be recorded to a
+                RecordingRenderContext with RenderHeadless. No GPU
+                resources are created, every view and buffer the
+                passes bind is null
+
+      Args:     UINT uWidth
+                  Width of the virtual back buffer
+                UINT uHeight
+                  Height of the virtual back buffer
+
+      Modifies: [m_viewport, m_projection, m_constantBufferRing,
+                 m_bCanMapNoOverwrite, m_shadowMap, m_cascadeShadowMap,
+                 m_lightClusters, m_occlusionCuller, m_frameGraph].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Renderer::InitializeHeadless(_In_ UINT uWidth, _In_ UINT uHeight)
+    {
+        if (!m_pMainScene)
+        {
+            return E_FAIL;
+        }
+
+        m_viewport =
+        {
+            .TopLeftX = 0.0f,
+            .TopLeftY = 0.0f,
+            .Width = static_cast<FLOAT>(uWidth),
+            .Height = static_cast<FLOAT>(uHeight),
+            .MinDepth = 0.0f,
+            .MaxDepth = 1.0f,
+        };
+
+        m_projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, static_cast<FLOAT>(uWidth) / static_cast<FLOAT>(uHeight), 0.01f, 1000.0f);
+
+        // Retained constants hold the previous projection. A recorded map has no driver to refuse no-overwrite
+        m_constantBufferRing.Reset();
+        m_bCanMapNoOverwrite = TRUE;
+
+        m_shadowMap = std::make_shared<ShadowMap>(m_uShadowMapSize, m_shadowMapFormat, NUM_LIGHTS);
+        m_cascadeShadowMap = std::make_shared<ShadowMap>(m_uShadowMapSize, m_shadowMapFormat, NUM_CASCADES);
+
+        for (UINT i = 0; i < NUM_LIGHTS; ++i)
+        {
+            m_pMainScene->GetPointLight(i)->Initialize(m_uShadowMapSize, m_uShadowMapSize);
+        }
+
+        m_lightClusters = std::make_unique<LightClusters>(AssetLoader::GetDefaultNumThreads());
+        m_occlusionCuller = std::make_unique<OcclusionCuller>(AssetLoader::GetDefaultNumThreads());
+
+        // The graph is compiled but never realized
+        return initializeFrameGraph(uWidth, uHeight);
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderer::AddScene
 
@@ -386,44 +610,232 @@ namespace library
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderer::SetMainScene
 
-      Summary:  Set the main scene
+      Summary:  Set the main scene. The name is only looked up here,
+                the frame works on the cached scene
 
       Args:     PCWSTR pszSceneName
                   The name of the scene
 
-      Modifies: [m_pszMainSceneName].
+      Modifies: [m_pMainScene].
 
       Returns:  HRESULT
                   Status code
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     HRESULT Renderer::SetMainScene(_In_ PCWSTR pszSceneName)
     {
-        if (!m_scenes.contains(pszSceneName))
+        auto it = m_scenes.find(pszSceneName);
+        if (it == m_scenes.end())
         {
             return E_FAIL;
         }
 
-        m_pszMainSceneName = pszSceneName;
+        m_pMainScene = it->second.get();
 
         return S_OK;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Renderer::SetShadowMapShaders
+      Method:   Renderer::SetShadowMapVertexShader
 
-      Summary:  Set shaders for the shadow mapping
+      Summary:  Set the vertex shader of the shadow pass. The pass
+                writes depth only and runs no pixel shader
 
       Args:     std::shared_ptr<ShadowVertexShader>
                   vertex shader
-                std::shared_ptr<PixelShader>
-                  pixel shader
 
-      Modifies: [m_shadowVertexShader, m_shadowPixelShader].
+      Modifies: [m_shadowVertexShader].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    void Renderer::SetShadowMapShaders(_In_ std::shared_ptr<ShadowVertexShader> vertexShader, _In_ std::shared_ptr<PixelShader> pixelShader)
+    void Renderer::SetShadowMapVertexShader(_In_ std::shared_ptr<ShadowVertexShader> vertexShader)
     {
         m_shadowVertexShader = move(vertexShader);
-        m_shadowPixelShader = move(pixelShader);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::SetShadowMapResolution
+
+      Summary:  Set the size and depth format of the shadow map. Takes
+                effect on the next Initialize
+
+      Args:     UINT uSize
+                  Width and height of the shadow map in texels
+                DXGI_FORMAT depthFormat
+                  DXGI_FORMAT_D32_FLOAT or DXGI_FORMAT_D16_UNORM
+
+      Modifies: [m_uShadowMapSize, m_shadowMapFormat].
+
+      Returns:  HRESULT
+                  Status code, E_INVALIDARG for an unsupported size or
+                  format
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Renderer::SetShadowMapResolution(_In_ UINT uSize, _In_ DXGI_FORMAT depthFormat)
+    {
+        if (uSize == 0u || uSize > D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION || !ShadowMap::IsSupportedFormat(depthFormat))
+        {
+            return E_INVALIDARG;
+        }
+
+        m_uShadowMapSize = uSize;
+        m_shadowMapFormat = depthFormat;
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::SetShadowBudget
+
+      Summary:  Set how many shadow maps are rendered per frame. Lights
+                over the budget keep their last shadow map until a
+                later frame renders it
+
+      Args:     UINT uNumShadowMaps
+                  Maximum number of shadow passes per frame, at least
+                  one
+
+      Modifies: [m_uShadowBudget].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::SetShadowBudget(_In_ UINT uNumShadowMaps)
+    {
+        m_uShadowBudget = uNumShadowMaps > 0u ? uNumShadowMaps : 1u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::GetShadowCascades
+
+      Summary:  Returns the cascades of the directional light, to
+                tune the split, the shadow distance and the caster
+                distance
+
+      Returns:  ShadowCascades&
+                  Cascades of the directional light
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ShadowCascades& Renderer::GetShadowCascades()
+    {
+        return m_shadowCascades;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::SetRenderPath
+
+      Summary:  Set whether the voxels are lit forward or deferred.
+                Takes effect on the next Initialize, the deferred path
+                needs the shaders of SetDeferredShaders
+
+      Args:     eRenderPath renderPath
+                  Path the voxels are lit with
+
+      Modifies: [m_renderPath].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::SetRenderPath(_In_ eRenderPath renderPath)
+    {
+        m_renderPath = renderPath;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::GetRenderPath
+
+      Summary:  Returns how the voxels are lit
+
+      Returns:  eRenderPath
+                  Path the voxels are lit with
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    eRenderPath Renderer::GetRenderPath() const
+    {
+        return m_renderPath;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::SetDeferredShaders
+
+      Summary:  Set the shaders of the deferred path. The scene that
+                holds them initializes them, like the shaders of its
+                objects
+
+      Args:     std::shared_ptr<PixelShader> voxelGBufferPixelShader
+                  Pixel shader writing the surface of the voxels to
+                  the G-buffer, it takes the output of their vertex
+                  shader
+                std::shared_ptr<FullscreenVertexShader>
+                  lightingVertexShader
+                  Vertex shader of the lighting pass
+                std::shared_ptr<PixelShader> lightingPixelShader
+                  Pixel shader lighting the G-buffer
+
+      Modifies: [m_voxelGBufferPixelShader,
+                 m_deferredLightingVertexShader,
+                 m_deferredLightingPixelShader].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::SetDeferredShaders(
+        _In_ std::shared_ptr<PixelShader> voxelGBufferPixelShader,
+        _In_ std::shared_ptr<FullscreenVertexShader> lightingVertexShader,
+        _In_ std::shared_ptr<PixelShader> lightingPixelShader
+    )
+    {
+        m_voxelGBufferPixelShader = move(voxelGBufferPixelShader);
+        m_deferredLightingVertexShader = move(lightingVertexShader);
+        m_deferredLightingPixelShader = move(lightingPixelShader);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::SetDepthPrepass
+
+      Summary:  Set which passes draw over a depth pre-pass. The
+                pre-pass writes the depth of the selected objects
+                before the scene passes, which then test for equal
+                depth without writing it, so every covered pixel is
+                shaded once. Skinned models are never pre-passed, the
+                pre-pass does not skin them. Takes effect on the next
+                frame
+
+      Args:     BOOL bVoxels
+                  Whether the voxels are pre-passed, on both render
+                  paths
+                BOOL bModels
+                  Whether the models that are not skinned are
+                  pre-passed
+
+      Modifies: [m_bDepthPrepassVoxels, m_bDepthPrepassModels].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::SetDepthPrepass(_In_ BOOL bVoxels, _In_ BOOL bModels)
+    {
+        m_bDepthPrepassVoxels = bVoxels;
+        m_bDepthPrepassModels = bModels;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::SetOcclusionCulling
+
+      Summary:  Set whether the scene passes skip the voxels and
+                models hidden behind the voxel terrain. Hidden objects
+                still cast shadows. Takes effect on the next frame
+
+      Args:     BOOL bEnabled
+                  Whether hidden objects are skipped
+
+      Modifies: [m_bOcclusionCulling].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::SetOcclusionCulling(_In_ BOOL bEnabled)
+    {
+        m_bOcclusionCulling = bEnabled;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::SetTextureStreamingBudget
+
+      Summary:  Set the bytes the streamed texture mips may take. The
+                tail mips are always resident and may exceed it
+
+      Args:     UINT64 uBudget
+                  Budget in bytes
+
+      Modifies: [m_uTextureStreamingBudget, m_textureStreamer].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::SetTextureStreamingBudget(_In_ UINT64 uBudget)
+    {
+        m_uTextureStreamingBudget = uBudget;
+        if (m_textureStreamer)
+        {
+            m_textureStreamer->SetBudget(uBudget);
+        }
     }
  
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -437,6 +849,8 @@ namespace library
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     void Renderer::HandleInput(_In_ const DirectionsInput& directions, _In_ const MouseRelativeMovement& mouseRelativeMovement, _In_ FLOAT deltaTime)
     {
+        PROFILE_SCOPE("Renderer::HandleInput");
+
         m_camera.HandleInput(directions, mouseRelativeMovement, deltaTime);
     }
 
@@ -450,7 +864,9 @@ namespace library
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     void Renderer::Update(_In_ FLOAT deltaTime)
     {
-        m_scenes[m_pszMainSceneName]->Update(deltaTime);
+        PROFILE_SCOPE("Renderer::Update");
+
+        m_pMainScene->Update(deltaTime);
 
         m_camera.Update(deltaTime);
     }
@@ -458,658 +874,2523 @@ namespace library
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderer::Render
 
-      Summary:  Render the frame
+      Summary:  Render the frame by executing the passes of the frame
+                graph. In profiling builds every pass is timed on the
+                GPU
+
+      Modifies: [m_renderStats, m_uNumRenderedFrames].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     void Renderer::Render()
     {
-        RenderSceneToTexture();
+        PROFILE_SCOPE("Renderer::Render");
 
-        // Clear the back buffer
-        m_immediateContext->ClearRenderTargetView(m_renderTargetView.Get(), Colors::MidnightBlue);
+        updateDrawLists();
+        updateShadows();
+        updateCascades();
+        updateClusters();
+        updateOcclusion();
+        updateTextureStreaming();
+        updateDepthPrepass();
 
-        // Clear the depth buffer to 1.0 (max depth)
-        m_immediateContext->ClearDepthStencilView(m_depthStencilView.Get(), D3D11_CLEAR_DEPTH, 1.0f, 0u);
+        m_renderContext->ResetStats();
 
-        // Update camera constant buffer
-        CBChangeOnCameraMovement cbChangeOnCameraMovement =
-        {
-            .View = XMMatrixTranspose(m_camera.GetView()),
-        };
-        XMStoreFloat4(&cbChangeOnCameraMovement.CameraPosition, m_camera.GetEye());
-        m_immediateContext->UpdateSubresource(m_camera.GetConstantBuffer().Get(), 0u, nullptr, &cbChangeOnCameraMovement, 0u, 0u);
+        updateConstantBuffers(m_renderContext.get());
+        uploadClusters(m_renderContext.get());
 
-        // Update lights constant buffer
-        CBLights cbLights = {};
-        for (UINT i = 0u; i < NUM_LIGHTS; ++i)
+        if (m_gpuProfiler)
         {
-            cbLights.LightPositions[i] = m_scenes[m_pszMainSceneName]->GetPointLight(i)->GetPosition();
-            cbLights.LightColors[i] = m_scenes[m_pszMainSceneName]->GetPointLight(i)->GetColor();
-            cbLights.LightViews[i] = XMMatrixTranspose(m_scenes[m_pszMainSceneName]->GetPointLight(i)->GetViewMatrix());
-            cbLights.LightProjections[i] = XMMatrixTranspose(m_scenes[m_pszMainSceneName]->GetPointLight(i)->GetProjectionMatrix());
+            m_gpuProfiler->BeginFrame();
+        }
 
-            FLOAT attenuationDistance = m_scenes[m_pszMainSceneName]->GetPointLight(i)->GetAttenuationDistance();
-            FLOAT attenuationDistanceSquared = attenuationDistance * attenuationDistance;
-            cbLights.LightAttenuationDistance[i] = XMFLOAT4(attenuationDistance, attenuationDistance, attenuationDistanceSquared, attenuationDistanceSquared);
-        };
-        m_immediateContext->UpdateSubresource(m_cbLights.Get(), 0u, nullptr, &cbLights, 0u, 0u);
+        m_frameGraph.Execute(m_renderContext.get());
 
-        // For all renderables
-        std::unordered_map<std::wstring, std::shared_ptr<Renderable>>::iterator renderable;
-        for (renderable = m_scenes[m_pszMainSceneName]->GetRenderables().begin(); renderable != m_scenes[m_pszMainSceneName]->GetRenderables().end(); ++renderable)
+        if (m_gpuProfiler)
         {
-            // Set the vertex buffer
-            UINT uStride = sizeof(SimpleVertex);
-            UINT uOffset = 0u;
-            m_immediateContext->IASetVertexBuffers(0u, 1u, renderable->second->GetVertexBuffer().GetAddressOf(), &uStride, &uOffset);
+            m_gpuProfiler->EndFrame();
+        }
 
-            // Set the normal buffer
-            uStride = sizeof(NormalData);
-            m_immediateContext->IASetVertexBuffers(1u, 1u, renderable->second->GetNormalBuffer().GetAddressOf(), &uStride, &uOffset);
+        collectRenderStats(m_renderContext.get());
 
-            // Set the index buffer
-            m_immediateContext->IASetIndexBuffer(renderable->second->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);
+        // Present the information rendered to the back buffer to the front buffer
+        m_swapChain->Present(0u, 0u);
+    }
 
-            // Set the input layout
-            m_immediateContext->IASetInputLayout(renderable->second->GetVertexLayout().Get());
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::RenderHeadless
 
-            // Update renderable constant buffer
-            CBChangesEveryFrame cbChangesEveryFrame =
-            {
-                .World = XMMatrixTranspose(renderable->second->GetWorldMatrix()),
-                .OutputColor = renderable->second->GetOutputColor(),
-                .HasNormalMap = renderable->second->HasNormalMap()
-            };
-            m_immediateContext->UpdateSubresource(renderable->second->GetConstantBuffer().Get(), 0u, nullptr, &cbChangesEveryFrame, 0u, 0u);
+      Summary:  Records the passes of a frame to the given context
+                without presenting
 
-            // Set the vertex shader and constant buffers
-            m_immediateContext->VSSetShader(renderable->second->GetVertexShader().Get(), nullptr, 0u);
-            m_immediateContext->VSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(2u, 1u, renderable->second->GetConstantBuffer().GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
+      Args:     RenderContext* pContext
+                  The render context to record the frame to
 
-            // Set the pixel shader and constant buffers
-            m_immediateContext->PSSetShader(renderable->second->GetPixelShader().Get(), nullptr, 0u);
-            m_immediateContext->PSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-            m_immediateContext->PSSetConstantBuffers(2u, 1u, renderable->second->GetConstantBuffer().GetAddressOf());
-            m_immediateContext->PSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
+      Modifies: [m_renderStats, m_uNumRenderedFrames].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::RenderHeadless(_In_ RenderContext* pContext)
+    {
+        updateDrawLists();
+        updateShadows();
+        updateCascades();
+        updateClusters();
+        updateOcclusion();
+        updateDepthPrepass();
 
-            if (renderable->second->HasTexture())
-            {
-                for (UINT i = 0u; i < renderable->second->GetNumMeshes(); ++i)
-                {
-                    const UINT uMaterialIndex = renderable->second->GetMesh(i).uMaterialIndex;
-                    if (renderable->second->GetMaterial(uMaterialIndex)->pDiffuse)
-                    {
-                        // Set texture resource view of the renderable into the pixel shader
-                        m_immediateContext->PSSetShaderResources(0u, 1u, renderable->second->GetMaterial(uMaterialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
+        pContext->ResetStats();
 
-                        // Set sampler state of the renderable into the pixel shader
-                        eTextureSamplerType textureSamplerType = renderable->second->GetMaterial(uMaterialIndex)->pDiffuse->GetSamplerType();
-                        m_immediateContext->PSSetSamplers(0u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-                    }
-                    if (renderable->second->GetMaterial(uMaterialIndex)->pNormal)
-                    {
-                        // Set texture resource view of the renderable into the pixel shader
-                        m_immediateContext->PSSetShaderResources(1u, 1u, renderable->second->GetMaterial(uMaterialIndex)->pNormal->GetTextureResourceView().GetAddressOf());
+        updateConstantBuffers(pContext);
+        uploadClusters(pContext);
 
-                        // Set sampler state of the renderable into the pixel shader
-                        eTextureSamplerType textureSamplerType = renderable->second->GetMaterial(uMaterialIndex)->pNormal->GetSamplerType();
-                        m_immediateContext->PSSetSamplers(1u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-                    }
+        m_frameGraph.Execute(pContext);
 
-                    // Set texture and sampler state of the shadow map into the pixel shader
-                    m_immediateContext->PSSetShaderResources(2u, 1u, m_shadowMapTexture->GetShaderResourceView().GetAddressOf());
-                    m_immediateContext->PSSetSamplers(2u, 1u, m_shadowMapTexture->GetSamplerState().GetAddressOf());
+        collectRenderStats(pContext);
+    }
 
-                    if (m_scenes[m_pszMainSceneName]->GetSkyBox() != nullptr)
-                    {
-                        for (UINT i = 0u; i < m_scenes[m_pszMainSceneName]->GetSkyBox()->GetNumMeshes(); ++i)
-                        {
-                            const UINT uMaterialIndex = m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMesh(i).uMaterialIndex;
-                            if (m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMaterial(uMaterialIndex)->pDiffuse)
-                            {
-                                // Set texture resource view of the skybox into the pixel shader
-                                m_immediateContext->PSSetShaderResources(3u, 1u, m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMaterial(uMaterialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::SetCommandRecorder
 
-                                // Set sampler state of the skybox into the pixel shader
-                                eTextureSamplerType textureSamplerType = m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMaterial(uMaterialIndex)->pDiffuse->GetSamplerType();
-                                m_immediateContext->PSSetSamplers(3u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-                            }
-                        }
-                    }
+      Summary:  Set the recorder that splits the draws of a pass across
+                worker threads. Set before Initialize to replace the
+                deferred context recorder, null records every draw on
+                the immediate context
 
-                    // Render the triangles
-                    m_immediateContext->DrawIndexed(renderable->second->GetMesh(i).uNumIndices,
-                                                    renderable->second->GetMesh(i).uBaseIndex,
-                                                    renderable->second->GetMesh(i).uBaseVertex);
-                }
-            }
-            else
-            {
-                // Set texture and sampler state of the shadow map into the pixel shader
-                m_immediateContext->PSSetShaderResources(2u, 1u, m_shadowMapTexture->GetShaderResourceView().GetAddressOf());
-                m_immediateContext->PSSetSamplers(2u, 1u, m_shadowMapTexture->GetSamplerState().GetAddressOf());
+      Args:     std::unique_ptr<CommandRecorder> commandRecorder
+                  The command recorder
 
-                if (m_scenes[m_pszMainSceneName]->GetSkyBox() != nullptr)
-                {
-                    for (UINT i = 0u; i < m_scenes[m_pszMainSceneName]->GetSkyBox()->GetNumMeshes(); ++i)
-                    {
-                        const UINT uMaterialIndex = m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMesh(i).uMaterialIndex;
-                        if (m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMaterial(uMaterialIndex)->pDiffuse)
-                        {
-                            // Set texture resource view of the skybox into the pixel shader
-                            m_immediateContext->PSSetShaderResources(3u, 1u, m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMaterial(uMaterialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
+      Modifies: [m_commandRecorder].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::SetCommandRecorder(_In_ std::unique_ptr<CommandRecorder> commandRecorder)
+    {
+        m_commandRecorder = std::move(commandRecorder);
+        m_bHasCommandRecorder = TRUE;
+    }
 
-                            // Set sampler state of the skybox into the pixel shader
-                            eTextureSamplerType textureSamplerType = m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMaterial(uMaterialIndex)->pDiffuse->GetSamplerType();
-                            m_immediateContext->PSSetSamplers(3u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-                        }
-                    }
-                }
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::GetRenderStats
 
-                // Render the triangles
-                m_immediateContext->DrawIndexed(renderable->second->GetNumIndices(), 0u, 0);
-            }
-        }
+      Summary:  Returns the counters of the last rendered frame.
+                Binds and draws of the deferred contexts are included
+                once their command lists are executed
 
-        // For all voxels in main scene
-        std::vector<std::shared_ptr<Voxel>>::iterator voxel;
-        for (voxel = m_scenes[m_pszMainSceneName]->GetVoxels().begin(); voxel != m_scenes[m_pszMainSceneName]->GetVoxels().end(); ++voxel)
-        {
-            // Set the vertex buffer
-            UINT uStride = sizeof(SimpleVertex);
-            UINT uOffset = 0u;
-            m_immediateContext->IASetVertexBuffers(0u, 1u, voxel->get()->GetVertexBuffer().GetAddressOf(), &uStride, &uOffset);
+      Returns:  const RenderStats&
+                  Counters of the last frame
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const RenderStats& Renderer::GetRenderStats() const
+    {
+        return m_renderStats;
+    }
 
-            // Set the normal buffer
-            uStride = sizeof(NormalData);
-            m_immediateContext->IASetVertexBuffers(1u, 1u, voxel->get()->GetNormalBuffer().GetAddressOf(), &uStride, &uOffset);
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::GetFrameGraph
 
-            // Set the instance buffer
-            uStride = sizeof(InstanceData);
-            m_immediateContext->IASetVertexBuffers(2u, 1u, voxel->get()->GetInstanceBuffer().GetAddressOf(), &uStride, &uOffset);
+      Summary:  Returns the frame graph of the render passes, its trace
+                holds the passes of the last rendered frame in the
+                order they ran
 
-            // Set the index buffer
-            m_immediateContext->IASetIndexBuffer(voxel->get()->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);
+      Returns:  const FrameGraph&
+                  Compiled frame graph
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const FrameGraph& Renderer::GetFrameGraph() const
+    {
+        return m_frameGraph;
+    }
 
-            // Set the input layout
-            m_immediateContext->IASetInputLayout(voxel->get()->GetVertexLayout().Get());
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::SetRenderStatsDumpInterval
+
+      Summary:  Set how often the counters are written to the debug
+                output
+
+      Args:     UINT uNumFrames
+                  Number of frames between two dumps, 0 disables the
+                  dump
+
+      Modifies: [m_uRenderStatsDumpInterval].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::SetRenderStatsDumpInterval(_In_ UINT uNumFrames)
+    {
+        m_uRenderStatsDumpInterval = uNumFrames;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::DumpRenderStats
+
+      Summary:  Write the counters of the last frame to the debug
+                output as one line
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::DumpRenderStats() const
+    {
+        // Fragments per covered pixel the scene passes rasterize and shade
+        const DOUBLE coveredPixels = m_renderStats.uNumEstimatedCoveredPixels > 0u ? static_cast<DOUBLE>(m_renderStats.uNumEstimatedCoveredPixels) : 1.0;
+        const DOUBLE overdraw = static_cast<DOUBLE>(m_renderStats.uNumEstimatedFragments) / coveredPixels;
+        const DOUBLE shadedOverdraw = static_cast<DOUBLE>(m_renderStats.uNumEstimatedShadedFragments) / coveredPixels;
+
+        WCHAR szStats[448];
+        swprintf_s(
+            szStats,
+            L"Frame %u: %u draws, %llu instances, %llu triangles, %u uploads (%llu bytes, %llu retained), %u shader, %u CB, %u SRV, %u sampler binds, %u submitted, %u culled, %u shadow maps, overdraw %.2f rasterized %.2f shaded over %llu pixels\n",
+            m_uNumRenderedFrames,
+            m_renderStats.uNumDrawCalls,
+            m_renderStats.uNumInstances,
+            m_renderStats.uNumTriangles,
+            m_renderStats.uNumUploads,
+            m_renderStats.uNumUploadedBytes,
+            m_renderStats.uNumRetainedBytes,
+            m_renderStats.uNumShaderBinds,
+            m_renderStats.uNumConstantBufferBinds,
+            m_renderStats.uNumShaderResourceBinds,
+            m_renderStats.uNumSamplerBinds,
+            m_renderStats.uNumSubmittedObjects,
+            m_renderStats.uNumCulledObjects,
+            m_renderStats.uNumShadowMapUpdates,
+            overdraw,
+            shadedOverdraw,
+            m_renderStats.uNumEstimatedCoveredPixels
+        );
+
+        OutputDebugString(szStats);
+
+        if (m_textureStreamer)
+        {
+            swprintf_s(
+                szStats,
+                L"Texture streaming: %llu of %llu bytes resident, %u loads pending, %u mips streamed, %u evicted\n",
+                m_textureStreamer->GetResidentSize(),
+                m_textureStreamer->GetBudget(),
+                m_textureStreamer->GetNumPendingLoads(),
+                m_textureStreamer->GetNumStreamedMips(),
+                m_textureStreamer->GetNumEvictedMips()
+            );
+
+            OutputDebugString(szStats);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::initializeFrameGraph
+
+      Summary:  Builds the passes of a frame. Every light has a shadow
+                pass that renders depth only into its slice of the
+                shadow map the scene passes sample, every cascade of
+                the directional light one that renders into its slice
+                of the cascaded shadow map the voxels sample. On the
+                deferred path the voxels write a G-buffer of albedo
+                with the material and packed normals, and a lighting
+                pass shades each of its pixels once before the forward
+                objects are drawn over it. A depth pre-pass renders
+                the depth of the objects SetDepthPrepass selects before
+                the scene passes, which draw them with an equal depth
+                test. The passes testing against the scene depth read
+                it, which keeps the pre-pass from being culled. The
+                graph is compiled, the caller realizes it
+
+      Args:     UINT uWidth
+                  Width of the back buffer
+                UINT uHeight
+                  Height of the back buffer
+
+      Modifies: [m_frameGraph].
+
+      Returns:  HRESULT
+                  Status code, E_FAIL for the deferred path without its
+                  shaders
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Renderer::initializeFrameGraph(_In_ UINT uWidth, _In_ UINT uHeight)
+    {
+        if (m_renderPath == eRenderPath::DEFERRED && (!m_voxelGBufferPixelShader || !m_deferredLightingVertexShader || !m_deferredLightingPixelShader))
+        {
+            return E_FAIL;
+        }
+
+        m_frameGraph.Reset();
+
+        const UINT uBackBuffer = m_frameGraph.ImportRenderTarget(L"BackBuffer", m_renderTargetView.Get(), nullptr);
+        m_frameGraph.MarkOutput(uBackBuffer);
+
+        const UINT uShadowMap = m_frameGraph.ImportDepthStencil(
+            L"ShadowMap",
+            m_shadowMap->GetDepthStencilView(0u).Get(),
+            m_shadowMap->GetShaderResourceView().Get()
+        );
+
+        const UINT uCascadeShadowMap = m_frameGraph.ImportDepthStencil(
+            L"CascadeShadowMap",
+            m_cascadeShadowMap->GetDepthStencilView(0u).Get(),
+            m_cascadeShadowMap->GetShaderResourceView().Get()
+        );
+
+        const FrameGraphTextureDesc depthDesc =
+        {
+            .uWidth = uWidth,
+            .uHeight = uHeight,
+            .Format = DXGI_FORMAT_D24_UNORM_S8_UINT
+        };
+        const UINT uSceneDepth = m_frameGraph.CreateTexture(L"SceneDepth", depthDesc);
+
+        // Render the depth of the scene from every light into its slice of the shadow map. Lights
+        // that updateShadows did not schedule this frame skip the pass and keep their slice
+        UINT uPass = 0u;
+        for (UINT uLight = 0u; uLight < NUM_LIGHTS; ++uLight)
+        {
+            const std::wstring szPassName = L"Shadow" + std::to_wstring(uLight);
+            uPass = m_frameGraph.AddPass(
+                szPassName.c_str(),
+                [this, uLight](_In_ const FrameGraph&, _In_ RenderContext* pContext)
+                {
+                    const ShadowLightState& state = m_aShadowLights[uLight];
+                    if (!state.bScheduled)
+                    {
+                        return;
+                    }
+
+                    PROFILE_SCOPE("Shadow pass");
+                    PROFILE_GPU_SCOPE(m_gpuProfiler.get(), "Shadow pass");
+
+                    const PassState passState =
+                    {
+                        .apRenderTargetViews = {},
+                        .pDepthStencilView = m_shadowMap->GetDepthStencilView(uLight).Get(),
+                        .pViewport = &m_shadowMap->GetViewport(),
+                        .pRasterizerState = m_shadowMap->GetRasterizerState().Get(),
+                        .pDepthStencilState = nullptr
+                    };
+                    bindPassState(pContext, passState);
+
+                    // Clear depth stencil view
+                    pContext->ClearDepthStencilView(passState.pDepthStencilView, D3D11_CLEAR_DEPTH, 1.0f, 0u);
+
+                    renderCasters(pContext, passState, state.aCasters, m_frameConstants.ShadowLights[uLight]);
+                }
+            );
+            m_frameGraph.WriteTexture(uPass, uShadowMap);
+        }
+
+        // Render the depth of the scene along the directional light into every cascade that
+        // updateCascades scheduled, each only draws the casters inside its bounds
+        for (UINT uCascade = 0u; uCascade < NUM_CASCADES; ++uCascade)
+        {
+            const std::wstring szPassName = L"Cascade" + std::to_wstring(uCascade);
+            uPass = m_frameGraph.AddPass(
+                szPassName.c_str(),
+                [this, uCascade](_In_ const FrameGraph&, _In_ RenderContext* pContext)
+                {
+                    const ShadowCascadeState& state = m_aCascades[uCascade];
+                    if (!state.bScheduled)
+                    {
+                        return;
+                    }
+
+                    PROFILE_SCOPE("Cascade pass");
+                    PROFILE_GPU_SCOPE(m_gpuProfiler.get(), "Cascade pass");
+
+                    const PassState passState =
+                    {
+                        .apRenderTargetViews = {},
+                        .pDepthStencilView = m_cascadeShadowMap->GetDepthStencilView(uCascade).Get(),
+                        .pViewport = &m_cascadeShadowMap->GetViewport(),
+                        .pRasterizerState = m_cascadeShadowMap->GetRasterizerState().Get(),
+                        .pDepthStencilState = nullptr
+                    };
+                    bindPassState(pContext, passState);
+
+                    // Clear depth stencil view
+                    pContext->ClearDepthStencilView(passState.pDepthStencilView, D3D11_CLEAR_DEPTH, 1.0f, 0u);
+
+                    renderCasters(pContext, passState, state.aCasters, m_frameConstants.CascadeLights[uCascade]);
+                }
+            );
+            m_frameGraph.WriteTexture(uPass, uCascadeShadowMap);
+        }
+
+        // Scene passes render to the back buffer in the order they are added
+        auto addScenePass = [this, uBackBuffer, uSceneDepth](_In_ PCWSTR pszName, _In_ PCSTR pszTimerName, _In_ FrameGraph::ExecuteFunction render)
+        {
+            UINT uScenePass = m_frameGraph.AddPass(
+                pszName,
+                [this, uBackBuffer, uSceneDepth, pszTimerName, render](_In_ const FrameGraph& graph, _In_ RenderContext* pContext)
+                {
+                    PROFILE_GPU_SCOPE(m_gpuProfiler.get(), pszTimerName);
+
+                    const PassState passState =
+                    {
+                        .apRenderTargetViews = { graph.GetRenderTargetView(uBackBuffer) },
+                        .pDepthStencilView = graph.GetDepthStencilView(uSceneDepth),
+                        .pViewport = &m_viewport,
+                        .pRasterizerState = nullptr,
+                        .pDepthStencilState = nullptr
+                    };
+                    bindPassState(pContext, passState);
+
+                    render(graph, pContext);
+                }
+            );
+            m_frameGraph.WriteTexture(uScenePass, uBackBuffer);
+            m_frameGraph.WriteTexture(uScenePass, uSceneDepth);
+
+            return uScenePass;
+        };
+
+        addScenePass(
+            L"BeginScene",
+            "BeginScene pass",
+            [this, uBackBuffer, uSceneDepth](_In_ const FrameGraph& graph, _In_ RenderContext* pContext)
+            {
+                // Clear the back buffer
+                pContext->ClearRenderTargetView(graph.GetRenderTargetView(uBackBuffer), Colors::MidnightBlue);
+
+                // Clear the depth buffer to 1.0 (max depth)
+                pContext->ClearDepthStencilView(graph.GetDepthStencilView(uSceneDepth), D3D11_CLEAR_DEPTH, 1.0f, 0u);
+            }
+        );
+
+        // Render the depth of the pre-passed objects with the position only layout of the shadow pass
+        uPass = m_frameGraph.AddPass(
+            L"DepthPrepass",
+            [this, uSceneDepth](_In_ const FrameGraph& graph, _In_ RenderContext* pContext)
+            {
+                if (m_aDepthPrepassObjects.empty())
+                {
+                    return;
+                }
+
+                PROFILE_SCOPE("Depth pre-pass");
+                PROFILE_GPU_SCOPE(m_gpuProfiler.get(), "DepthPrepass pass");
+
+                const PassState passState =
+                {
+                    .apRenderTargetViews = {},
+                    .pDepthStencilView = graph.GetDepthStencilView(uSceneDepth),
+                    .pViewport = &m_viewport,
+                    .pRasterizerState = nullptr,
+                    .pDepthStencilState = nullptr
+                };
+                bindPassState(pContext, passState);
+
+                renderCasters(pContext, passState, m_aDepthPrepassObjects, m_frameConstants.DepthPrepass);
+            }
+        );
+        m_frameGraph.WriteTexture(uPass, uSceneDepth);
+
+        if (m_renderPath == eRenderPath::DEFERRED)
+        {
+            // Albedo with the material in alpha, and the world normal folded onto an octahedron
+            const FrameGraphTextureDesc gBufferAlbedoDesc =
+            {
+                .uWidth = uWidth,
+                .uHeight = uHeight,
+                .Format = DXGI_FORMAT_R8G8B8A8_UNORM
+            };
+            const UINT uGBufferAlbedo = m_frameGraph.CreateTexture(L"GBufferAlbedo", gBufferAlbedoDesc);
+
+            const FrameGraphTextureDesc gBufferNormalDesc =
+            {
+                .uWidth = uWidth,
+                .uHeight = uHeight,
+                .Format = DXGI_FORMAT_R16G16_SNORM
+            };
+            const UINT uGBufferNormal = m_frameGraph.CreateTexture(L"GBufferNormal", gBufferNormalDesc);
+
+            // Render the surface of the voxels, overdrawn pixels only cost the G-buffer writes, none with the depth pre-pass
+            uPass = m_frameGraph.AddPass(
+                L"GBuffer",
+                [this, uGBufferAlbedo, uGBufferNormal, uSceneDepth](_In_ const FrameGraph& graph, _In_ RenderContext* pContext)
+                {
+                    PROFILE_GPU_SCOPE(m_gpuProfiler.get(), "GBuffer pass");
+
+                    const PassState passState =
+                    {
+                        .apRenderTargetViews = { graph.GetRenderTargetView(uGBufferAlbedo), graph.GetRenderTargetView(uGBufferNormal) },
+                        .pDepthStencilView = graph.GetDepthStencilView(uSceneDepth),
+                        .pViewport = &m_viewport,
+                        .pRasterizerState = nullptr,
+                        .pDepthStencilState = getSceneDepthStencilState(m_bDepthPrepassVoxels)
+                    };
+                    bindPassState(pContext, passState);
+
+                    // Material 0 marks the pixels no voxel covers
+                    pContext->ClearRenderTargetView(graph.GetRenderTargetView(uGBufferAlbedo), Colors::Transparent);
+                    pContext->ClearRenderTargetView(graph.GetRenderTargetView(uGBufferNormal), Colors::Transparent);
+
+                    recordDraws(
+                        pContext,
+                        passState,
+                        static_cast<UINT>(m_aVoxelDrawList.size()),
+                        [this](_In_opt_ RenderContext* pRecordContext, _In_ UINT uBegin, _In_ UINT uEnd)
+                        {
+                            for (UINT i = uBegin; i < uEnd; ++i)
+                            {
+                                if (m_aVoxelVisible[i])
+                                {
+                                    renderVoxel(pRecordContext, m_aVoxelDrawList[i], m_aVoxelConstants[i]);
+                                }
+                            }
+                        }
+                    );
+                }
+            );
+            m_frameGraph.WriteTexture(uPass, uGBufferAlbedo);
+            m_frameGraph.WriteTexture(uPass, uGBufferNormal);
+            m_frameGraph.WriteTexture(uPass, uSceneDepth);
+            m_frameGraph.ReadDepthStencil(uPass, uSceneDepth);
+            m_frameGraph.ReadTexture(uPass, uShadowMap, 2u);
+            m_frameGraph.ReadTexture(uPass, uCascadeShadowMap, 4u);
+
+            // Light every covered pixel once. The depth is sampled to rebuild the positions, so the pass has no depth stencil
+            uPass = m_frameGraph.AddPass(
+                L"DeferredLighting",
+                [this, uBackBuffer, uGBufferAlbedo, uGBufferNormal, uSceneDepth](_In_ const FrameGraph& graph, _In_ RenderContext* pContext)
+                {
+                    PROFILE_GPU_SCOPE(m_gpuProfiler.get(), "DeferredLighting pass");
+
+                    const PassState passState =
+                    {
+                        .apRenderTargetViews = { graph.GetRenderTargetView(uBackBuffer) },
+                        .pDepthStencilView = nullptr,
+                        .pViewport = &m_viewport,
+                        .pRasterizerState = nullptr,
+                        .pDepthStencilState = nullptr
+                    };
+                    bindPassState(pContext, passState);
+
+                    ID3D11ShaderResourceView* const apGBufferViews[] =
+                    {
+                        graph.GetShaderResourceView(uGBufferAlbedo),
+                        graph.GetShaderResourceView(uGBufferNormal),
+                        graph.GetShaderResourceView(uSceneDepth)
+                    };
+                    renderDeferredLighting(pContext, apGBufferViews);
+                }
+            );
+            m_frameGraph.WriteTexture(uPass, uBackBuffer);
+            m_frameGraph.ReadTexture(uPass, uGBufferAlbedo, 8u);
+            m_frameGraph.ReadTexture(uPass, uGBufferNormal, 9u);
+            m_frameGraph.ReadTexture(uPass, uSceneDepth, 10u);
+            m_frameGraph.ReadTexture(uPass, uCascadeShadowMap, 4u);
+        }
+
+        uPass = addScenePass(
+            L"Renderables",
+            "Renderables pass",
+            [this, uBackBuffer, uSceneDepth](_In_ const FrameGraph& graph, _In_ RenderContext* pContext)
+            {
+                const PassState passState =
+                {
+                    .apRenderTargetViews = { graph.GetRenderTargetView(uBackBuffer) },
+                    .pDepthStencilView = graph.GetDepthStencilView(uSceneDepth),
+                    .pViewport = &m_viewport,
+                    .pRasterizerState = nullptr,
+                    .pDepthStencilState = nullptr
+                };
+                recordDraws(
+                    pContext,
+                    passState,
+                    static_cast<UINT>(m_aRenderableDrawList.size()),
+                    [this](_In_opt_ RenderContext* pRecordContext, _In_ UINT uBegin, _In_ UINT uEnd)
+                    {
+                        for (UINT i = uBegin; i < uEnd; ++i)
+                        {
+                            renderRenderable(pRecordContext, m_aRenderableDrawList[i], m_aRenderableConstants[i]);
+                        }
+                    }
+                );
+            }
+        );
+        m_frameGraph.ReadDepthStencil(uPass, uSceneDepth);
+        m_frameGraph.ReadTexture(uPass, uShadowMap, 2u);
+
+        if (m_renderPath == eRenderPath::FORWARD)
+        {
+            uPass = addScenePass(
+                L"Voxels",
+                "Voxels pass",
+                [this, uBackBuffer, uSceneDepth](_In_ const FrameGraph& graph, _In_ RenderContext* pContext)
+                {
+                    const PassState passState =
+                    {
+                        .apRenderTargetViews = { graph.GetRenderTargetView(uBackBuffer) },
+                        .pDepthStencilView = graph.GetDepthStencilView(uSceneDepth),
+                        .pViewport = &m_viewport,
+                        .pRasterizerState = nullptr,
+                        .pDepthStencilState = getSceneDepthStencilState(m_bDepthPrepassVoxels)
+                    };
+                    pContext->OMSetDepthStencilState(passState.pDepthStencilState, 0u);
+
+                    recordDraws(
+                        pContext,
+                        passState,
+                        static_cast<UINT>(m_aVoxelDrawList.size()),
+                        [this](_In_opt_ RenderContext* pRecordContext, _In_ UINT uBegin, _In_ UINT uEnd)
+                        {
+                            for (UINT i = uBegin; i < uEnd; ++i)
+                            {
+                                if (m_aVoxelVisible[i])
+                                {
+                                    renderVoxel(pRecordContext, m_aVoxelDrawList[i], m_aVoxelConstants[i]);
+                                }
+                            }
+                        }
+                    );
+                }
+            );
+            m_frameGraph.ReadDepthStencil(uPass, uSceneDepth);
+            m_frameGraph.ReadTexture(uPass, uShadowMap, 2u);
+            m_frameGraph.ReadTexture(uPass, uCascadeShadowMap, 4u);
+        }
+
+        uPass = addScenePass(
+            L"Models",
+            "Models pass",
+            [this, uBackBuffer, uSceneDepth](_In_ const FrameGraph& graph, _In_ RenderContext* pContext)
+            {
+                const PassState passState =
+                {
+                    .apRenderTargetViews = { graph.GetRenderTargetView(uBackBuffer) },
+                    .pDepthStencilView = graph.GetDepthStencilView(uSceneDepth),
+                    .pViewport = &m_viewport,
+                    .pRasterizerState = nullptr,
+                    .pDepthStencilState = getSceneDepthStencilState(m_bDepthPrepassModels)
+                };
+                pContext->OMSetDepthStencilState(passState.pDepthStencilState, 0u);
+
+                recordDraws(
+                    pContext,
+                    passState,
+                    static_cast<UINT>(m_aModelDrawList.size()),
+                    [this, &passState](_In_opt_ RenderContext* pRecordContext, _In_ UINT uBegin, _In_ UINT uEnd)
+                    {
+                        for (UINT i = uBegin; i < uEnd; ++i)
+                        {
+                            if (!m_aModelVisible[i])
+                            {
+                                continue;
+                            }
+
+                            // Skinned models are not in the pre-pass and test their depth as usual
+                            const BOOL bSkinned = passState.pDepthStencilState && !m_aModelDrawList[i]->GetBoneTransforms().empty();
+                            if (bSkinned)
+                            {
+                                pRecordContext->OMSetDepthStencilState(nullptr, 0u);
+                            }
+
+                            renderModel(pRecordContext, m_aModelDrawList[i], m_aModelConstants[i]);
+
+                            if (bSkinned)
+                            {
+                                pRecordContext->OMSetDepthStencilState(passState.pDepthStencilState, 0u);
+                            }
+                        }
+                    }
+                );
+            }
+        );
+        m_frameGraph.ReadDepthStencil(uPass, uSceneDepth);
+        m_frameGraph.ReadTexture(uPass, uShadowMap, 2u);
+
+        uPass = addScenePass(L"Skybox", "Skybox pass", [this](_In_ const FrameGraph&, _In_ RenderContext* pContext) { renderSkybox(pContext); });
+        m_frameGraph.ReadDepthStencil(uPass, uSceneDepth);
+
+        return m_frameGraph.Compile();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::updateDrawLists
+
+      Summary:  Copy the dense object arrays and the skybox of the
+                main scene into the draw lists, so that the draws of a
+                pass can be split into index ranges and a scene change
+                during the frame does not move them
+
+      Modifies: [m_aRenderableDrawList, m_aVoxelDrawList,
+                 m_aModelDrawList, m_pSkybox].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::updateDrawLists()
+    {
+        PROFILE_SCOPE("Renderer::updateDrawLists");
+
+        m_aRenderableDrawList = m_pMainScene->GetRenderables().GetObjects();
+        m_aVoxelDrawList = m_pMainScene->GetVoxels().GetObjects();
+        m_aModelDrawList = m_pMainScene->GetModels().GetObjects();
+
+        m_pSkybox = m_pMainScene->GetSkyBox().get();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::updateShadows
+
+      Summary:  Decide which shadow maps are rendered this frame. A
+                light whose influence sphere does not reach the view
+                is skipped. The casters of a light are the objects
+                inside its frustum and its influence sphere, a caster
+                outside the sphere cannot be between the light and a
+                lit receiver. The slice of a light is only rendered
+                again if the light or one of its casters changed. The
+                lights that need a slice are rendered, ones without a
+                slice first and then the stalest, until the budget is
+                used up
+
+      Modifies: [m_aShadowLights, m_uShadowVersion].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::updateShadows()
+    {
+        PROFILE_SCOPE("Renderer::updateShadows");
+
+        BoundingFrustum viewFrustum(m_projection);
+        viewFrustum.Transform(viewFrustum, XMMatrixInverse(nullptr, m_camera.GetView()));
+
+        // The bounds are parallel to the draw lists, both come from the dense arrays of the scene
+        const std::vector<BoundingBox>* apBounds[] =
+        {
+            &m_pMainScene->GetRenderables().GetBounds(),
+            &m_pMainScene->GetVoxels().GetBounds(),
+            &m_pMainScene->GetModels().GetBounds()
+        };
+
+        UINT64 auCastersVersions[NUM_LIGHTS] = {};
+        UINT auCandidates[NUM_LIGHTS] = {};
+        UINT uNumCandidates = 0u;
+        for (UINT i = 0u; i < NUM_LIGHTS; ++i)
+        {
+            ShadowLightState& state = m_aShadowLights[i];
+            const PointLight* pLight = m_pMainScene->GetPointLight(i).get();
+
+            state.bScheduled = FALSE;
+            state.aCasters.clear();
+
+            const XMFLOAT4& position = pLight->GetPosition();
+            const BoundingSphere influence(XMFLOAT3(position.x, position.y, position.z), pLight->GetAttenuationDistance());
+            state.bVisible = viewFrustum.Intersects(influence);
+            if (!state.bVisible)
+            {
+                continue;
+            }
+
+            BoundingFrustum lightFrustum(pLight->GetProjectionMatrix());
+            lightFrustum.Transform(lightFrustum, XMMatrixInverse(nullptr, pLight->GetViewMatrix()));
+
+            UINT uFirstCaster = 0u;
+            for (const std::vector<BoundingBox>* pBounds : apBounds)
+            {
+                for (UINT j = 0u; j < pBounds->size(); ++j)
+                {
+                    const BoundingBox& bounds = (*pBounds)[j];
+                    if (influence.Intersects(bounds) && lightFrustum.Intersects(bounds))
+                    {
+                        state.aCasters.push_back(uFirstCaster + j);
+                    }
+                }
+                uFirstCaster += static_cast<UINT>(pBounds->size());
+            }
+
+            auCastersVersions[i] = getCastersVersion(state.aCasters);
+
+            if (!state.bRendered || state.uLightVersion != pLight->GetVersion() ||
+                state.uCastersVersion != auCastersVersions[i] || state.uNumCasters != state.aCasters.size())
+            {
+                auCandidates[uNumCandidates++] = i;
+            }
+        }
+
+        std::sort(
+            auCandidates,
+            auCandidates + uNumCandidates,
+            [this](_In_ UINT uLeft, _In_ UINT uRight)
+            {
+                const ShadowLightState& left = m_aShadowLights[uLeft];
+                const ShadowLightState& right = m_aShadowLights[uRight];
+                if (left.bRendered != right.bRendered)
+                {
+                    return !left.bRendered;
+                }
+                return left.uLastUpdateFrame < right.uLastUpdateFrame;
+            }
+        );
+
+        const UINT uNumScheduled = uNumCandidates < m_uShadowBudget ? uNumCandidates : m_uShadowBudget;
+        for (UINT i = 0u; i < uNumScheduled; ++i)
+        {
+            const UINT uLight = auCandidates[i];
+            ShadowLightState& state = m_aShadowLights[uLight];
+            if (!state.bRendered)
+            {
+                // The lights constants have to pick up the new slice
+                state.bRendered = TRUE;
+                m_uShadowVersion = VersionCounter::Next();
+            }
+
+            state.bScheduled = TRUE;
+            state.uLightVersion = m_pMainScene->GetPointLight(uLight)->GetVersion();
+            state.uCastersVersion = auCastersVersions[uLight];
+            state.uNumCasters = static_cast<UINT>(state.aCasters.size());
+            state.uLastUpdateFrame = m_uNumRenderedFrames;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::updateCascades
+
+      Summary:  Fit the cascades of the directional light to the view
+                and decide which of them are rendered this frame. The
+                casters of a cascade are the objects intersecting its
+                bounds, so the near cascades skip the voxel chunks far
+                from the camera. A cascade is only rendered again if
+                its snapped projection or one of its casters changed.
+                Cascades are not under the shadow budget, without a
+                directional light none is rendered
+
+      Modifies: [m_shadowCascades, m_aCascades].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::updateCascades()
+    {
+        PROFILE_SCOPE("Renderer::updateCascades");
+
+        const DirectionalLight* pLight = m_pMainScene->GetDirectionalLightOrNull();
+        if (pLight == nullptr)
+        {
+            for (ShadowCascadeState& state : m_aCascades)
+            {
+                state.bScheduled = FALSE;
+                state.aCasters.clear();
+            }
+            return;
+        }
+
+        m_shadowCascades.Fit(m_camera.GetView(), m_projection, pLight->GetDirection(), m_uShadowMapSize);
+
+        const std::vector<BoundingBox>* apBounds[] =
+        {
+            &m_pMainScene->GetRenderables().GetBounds(),
+            &m_pMainScene->GetVoxels().GetBounds(),
+            &m_pMainScene->GetModels().GetBounds()
+        };
+
+        for (UINT i = 0u; i < NUM_CASCADES; ++i)
+        {
+            ShadowCascadeState& state = m_aCascades[i];
+            const BoundingOrientedBox& cascadeBounds = m_shadowCascades.GetBounds(i);
+
+            state.aCasters.clear();
+            UINT uFirstCaster = 0u;
+            for (const std::vector<BoundingBox>* pBounds : apBounds)
+            {
+                for (UINT j = 0u; j < pBounds->size(); ++j)
+                {
+                    if (cascadeBounds.Intersects((*pBounds)[j]))
+                    {
+                        state.aCasters.push_back(uFirstCaster + j);
+                    }
+                }
+                uFirstCaster += static_cast<UINT>(pBounds->size());
+            }
+
+            const UINT64 uCastersVersion = getCastersVersion(state.aCasters);
+            state.bScheduled = !state.bRendered || state.uVersion != m_shadowCascades.GetVersion(i) ||
+                state.uCastersVersion != uCastersVersion || state.uNumCasters != state.aCasters.size();
+            if (state.bScheduled)
+            {
+                state.bRendered = TRUE;
+                state.uVersion = m_shadowCascades.GetVersion(i);
+                state.uCastersVersion = uCastersVersion;
+                state.uNumCasters = static_cast<UINT>(state.aCasters.size());
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::getCastersVersion
+
+      Summary:  Find the newest version of the casters of a shadow
+                map. A moved caster takes a version newer than every
+                other, so the newest version changes while it stays in
+                the shadow map. One that left it changes the number of
+                casters, unless another caster moved in and brought a
+                newer version
+
+      Args:     const std::vector<UINT>& aCasters
+                  Indices of the renderables, voxels and models, in
+                  this order
+
+      Returns:  UINT64
+                  Newest version, 0 without casters
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 Renderer::getCastersVersion(_In_ const std::vector<UINT>& aCasters) const
+    {
+        const UINT uNumRenderables = static_cast<UINT>(m_aRenderableDrawList.size());
+        const UINT uNumVoxels = static_cast<UINT>(m_aVoxelDrawList.size());
+
+        UINT64 uVersion = 0u;
+        for (UINT uCaster : aCasters)
+        {
+            if (uCaster < uNumRenderables)
+            {
+                uVersion = std::max(uVersion, m_aRenderableDrawList[uCaster]->GetVersion());
+            }
+            else if (uCaster < uNumRenderables + uNumVoxels)
+            {
+                uVersion = std::max(uVersion, m_aVoxelDrawList[uCaster - uNumRenderables]->GetVersion());
+            }
+            else
+            {
+                uVersion = std::max(uVersion, m_aModelDrawList[uCaster - uNumRenderables - uNumVoxels]->GetVersion());
+            }
+        }
+
+        return uVersion;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::updateClusters
+
+      Summary:  Bin the local lights of the main scene into the
+                clusters of the view. The lights are only gathered
+                when one of them changed, and only binned again when
+                they or the camera did
+
+      Modifies: [m_aClusterLights, m_uClusterLightsVersion,
+                 m_uClustersVersion, m_bClusterLightsDirty,
+                 m_bClustersDirty, m_lightClusters].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::updateClusters()
+    {
+        PROFILE_SCOPE("Renderer::updateClusters");
+
+        // A changed light takes the newest version, lights are never removed so an added one changes the count
+        const std::vector<std::shared_ptr<PointLight>>& aLocalLights = m_pMainScene->GetLocalLights();
+        UINT64 uLightsVersion = 0u;
+        for (const std::shared_ptr<PointLight>& localLight : aLocalLights)
+        {
+            uLightsVersion = std::max(uLightsVersion, localLight->GetVersion());
+        }
+
+        if (uLightsVersion != m_uClusterLightsVersion || aLocalLights.size() != m_aClusterLights.size())
+        {
+            m_aClusterLights.resize(aLocalLights.size());
+            for (size_t i = 0u; i < aLocalLights.size(); ++i)
+            {
+                const XMFLOAT4& position = aLocalLights[i]->GetPosition();
+                m_aClusterLights[i] =
+                {
+                    .PositionAndRadius = XMFLOAT4(position.x, position.y, position.z, aLocalLights[i]->GetAttenuationDistance()),
+                    .Color = aLocalLights[i]->GetColor()
+                };
+            }
+            m_uClusterLightsVersion = uLightsVersion;
+            m_bClusterLightsDirty = TRUE;
+
+            // No version is 0, so the clusters are binned again
+            m_uClustersVersion = 0u;
+        }
+
+        const UINT64 uClustersVersion = std::max(uLightsVersion, m_camera.GetVersion());
+        if (uClustersVersion == m_uClustersVersion)
+        {
+            return;
+        }
+
+        if (FAILED(m_lightClusters->Build(m_camera.GetView(), m_projection, m_aClusterLights)))
+        {
+            // Keep the clusters of the last frame and bin again in the next one
+            OutputDebugString(L"Binning the local lights into clusters failed\n");
+            return;
+        }
+        m_uClustersVersion = uClustersVersion;
+        m_bClustersDirty = TRUE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::updateOcclusion
+
+      Summary:  Find the voxels and models hidden behind the voxel
+                terrain. The stacked cubes of the voxels are merged
+                into large occluder boxes whenever a voxel changed,
+                which are rasterized from the camera on the CPU every
+                frame. The bounds of the voxels and models are tested
+                against the hierarchical depth. Without occlusion
+                culling every object is visible
+
+      Modifies: [m_aOccluders, m_uOccludersVersion,
+                 m_uNumOccluderVoxels, m_occlusionCuller,
+                 m_aVoxelVisible, m_aModelVisible].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::updateOcclusion()
+    {
+        PROFILE_SCOPE("Renderer::updateOcclusion");
+
+        m_aVoxelVisible.assign(m_aVoxelDrawList.size(), 1u);
+        m_aModelVisible.assign(m_aModelDrawList.size(), 1u);
+        if (!m_bOcclusionCulling)
+        {
+            return;
+        }
+
+        // A changed voxel takes the newest version, voxels are never removed so an added one changes the count
+        UINT64 uOccludersVersion = 0u;
+        for (const Voxel* pVoxel : m_aVoxelDrawList)
+        {
+            uOccludersVersion = std::max(uOccludersVersion, pVoxel->GetVersion());
+        }
+
+        if (uOccludersVersion != m_uOccludersVersion || m_aVoxelDrawList.size() != m_uNumOccluderVoxels)
+        {
+            const std::vector<XMFLOAT4X4>& aWorldMatrices = m_pMainScene->GetVoxels().GetWorldMatrices();
+            std::vector<BoundingBox> aCubes;
+            std::vector<BoundingBox> aInstanceBounds;
+            for (size_t i = 0u; i < m_aVoxelDrawList.size(); ++i)
+            {
+                m_aVoxelDrawList[i]->GetInstanceBounds(aInstanceBounds);
+
+                const XMMATRIX world = XMLoadFloat4x4(&aWorldMatrices[i]);
+                for (BoundingBox& instanceBounds : aInstanceBounds)
+                {
+                    instanceBounds.Transform(instanceBounds, world);
+                    aCubes.push_back(instanceBounds);
+                }
+            }
+
+            OcclusionCuller::BuildColumnOccluders(aCubes, OcclusionCuller::DEFAULT_CELL_SIZE, m_aOccluders);
+            m_uOccludersVersion = uOccludersVersion;
+            m_uNumOccluderVoxels = static_cast<UINT>(m_aVoxelDrawList.size());
+        }
+
+        if (FAILED(m_occlusionCuller->Rasterize(m_camera.GetView(), m_projection, m_aOccluders)))
+        {
+            // Draw every object rather than hide visible ones
+            OutputDebugString(L"Rasterizing the occluders failed, nothing is culled\n");
+            return;
+        }
+
+        m_occlusionCuller->TestBounds(m_pMainScene->GetVoxels().GetBounds(), m_aVoxelVisible);
+        m_occlusionCuller->TestBounds(m_pMainScene->GetModels().GetBounds(), m_aModelVisible);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::updateTextureStreaming
+
+      Summary:  Request the textures of the visible objects with the
+                pixels they cover and let the streamer load and drop
+                their mips. An object covers its size projected at the
+                nearest point of its bounds. A voxel repeats its
+                textures on every cube, so it covers the size of one
+                cube, other objects the diameter of their bounds. The
+                skybox fills the view
+
+      Modifies: [m_textureStreamer].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::updateTextureStreaming()
+    {
+        PROFILE_SCOPE("Renderer::updateTextureStreaming");
+
+        if (!m_textureStreamer)
+        {
+            return;
+        }
+
+        m_textureStreamer->BeginFrame();
+
+        // Pixels per world unit at a distance of one
+        const FLOAT pixelsPerUnit = XMVectorGetY(m_projection.r[1]) * m_viewport.Height * 0.5f;
+        const XMVECTOR eye = m_camera.GetEye();
+
+        auto requestTextures = [this](_In_ const Renderable* pRenderable, _In_ FLOAT screenSize)
+        {
+            for (UINT i = 0u; i < pRenderable->GetNumMaterials(); ++i)
+            {
+                const std::shared_ptr<Material>& material = pRenderable->GetMaterial(i);
+                m_textureStreamer->RequestTexture(material->pDiffuse, screenSize);
+                m_textureStreamer->RequestTexture(material->pSpecularExponent, screenSize);
+                m_textureStreamer->RequestTexture(material->pNormal, screenSize);
+            }
+        };
+        auto getScreenSize = [pixelsPerUnit, eye](_In_ const BoundingBox& bounds, _In_ FLOAT size)
+        {
+            const XMVECTOR center = XMLoadFloat3(&bounds.Center);
+            const XMVECTOR extents = XMLoadFloat3(&bounds.Extents);
+            const XMVECTOR nearest = XMVectorClamp(eye, XMVectorSubtract(center, extents), XMVectorAdd(center, extents));
+            const FLOAT distance = XMVectorGetX(XMVector3Length(XMVectorSubtract(nearest, eye)));
+
+            return size * pixelsPerUnit / (distance > 1.0f ? distance : 1.0f);
+        };
+
+        const std::vector<BoundingBox>& aRenderableBounds = m_pMainScene->GetRenderables().GetBounds();
+        for (size_t i = 0u; i < m_aRenderableDrawList.size(); ++i)
+        {
+            requestTextures(m_aRenderableDrawList[i], getScreenSize(aRenderableBounds[i], 2.0f * XMVectorGetX(XMVector3Length(XMLoadFloat3(&aRenderableBounds[i].Extents)))));
+        }
+
+        const std::vector<BoundingBox>& aVoxelBounds = m_pMainScene->GetVoxels().GetBounds();
+        for (size_t i = 0u; i < m_aVoxelDrawList.size(); ++i)
+        {
+            if (m_aVoxelVisible[i])
+            {
+                requestTextures(m_aVoxelDrawList[i], getScreenSize(aVoxelBounds[i], 2.0f));
+            }
+        }
+
+        const std::vector<BoundingBox>& aModelBounds = m_pMainScene->GetModels().GetBounds();
+        for (size_t i = 0u; i < m_aModelDrawList.size(); ++i)
+        {
+            if (m_aModelVisible[i])
+            {
+                requestTextures(m_aModelDrawList[i], getScreenSize(aModelBounds[i], 2.0f * XMVectorGetX(XMVector3Length(XMLoadFloat3(&aModelBounds[i].Extents)))));
+            }
+        }
+
+        if (m_pSkybox)
+        {
+            requestTextures(m_pSkybox, m_viewport.Height);
+        }
+
+        m_textureStreamer->Update(m_d3dDevice.Get(), m_immediateContext.Get());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::updateDepthPrepass
+
+      Summary:  Gather the visible objects the depth pre-pass renders,
+                indexed like the casters of a shadow map so the
+                pre-pass can draw them the same way
+
+      Modifies: [m_aDepthPrepassObjects].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::updateDepthPrepass()
+    {
+        PROFILE_SCOPE("Renderer::updateDepthPrepass");
+
+        m_aDepthPrepassObjects.clear();
+        if (!m_shadowVertexShader)
+        {
+            return;
+        }
+
+        const UINT uNumRenderables = static_cast<UINT>(m_aRenderableDrawList.size());
+        const UINT uNumVoxels = static_cast<UINT>(m_aVoxelDrawList.size());
+        if (m_bDepthPrepassVoxels)
+        {
+            for (UINT i = 0u; i < uNumVoxels; ++i)
+            {
+                if (m_aVoxelVisible[i])
+                {
+                    m_aDepthPrepassObjects.push_back(uNumRenderables + i);
+                }
+            }
+        }
+
+        if (m_bDepthPrepassModels)
+        {
+            for (UINT i = 0u; i < static_cast<UINT>(m_aModelDrawList.size()); ++i)
+            {
+                if (m_aModelVisible[i] && m_aModelDrawList[i]->GetBoneTransforms().empty())
+                {
+                    m_aDepthPrepassObjects.push_back(uNumRenderables + uNumVoxels + i);
+                }
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::uploadClusters
+
+      Summary:  Write the local lights and the clusters that changed
+                to their structured buffers, growing a buffer to twice
+                its size until it fits. Nothing is written without a
+                device
+
+      Args:     RenderContext* pContext
+                  The render context to record the commands to
+
+      Modifies: [m_bClusterLightsDirty, m_bClustersDirty,
+                 m_clusterLightBuffer, m_clusterLightView,
+                 m_uClusterLightCapacity, m_clusterIndexBuffer,
+                 m_clusterIndexView, m_uClusterIndexCapacity].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::uploadClusters(_In_ RenderContext* pContext)
+    {
+        if (!m_d3dDevice)
+        {
+            return;
+        }
+
+        if (m_bClusterLightsDirty && !m_aClusterLights.empty())
+        {
+            const UINT uNumLights = static_cast<UINT>(m_aClusterLights.size());
+            if (uNumLights > m_uClusterLightCapacity)
+            {
+                while (m_uClusterLightCapacity < uNumLights)
+                {
+                    m_uClusterLightCapacity *= 2u;
+                }
+
+                if (FAILED(createStructuredBuffer(sizeof(ClusterLight), m_uClusterLightCapacity, m_clusterLightBuffer, m_clusterLightView)))
+                {
+                    OutputDebugString(L"Creating the cluster light buffer failed\n");
+                    return;
+                }
+            }
+
+            if (FAILED(pContext->UpdateDynamicConstantBuffer(m_clusterLightBuffer.Get(), 0u, m_aClusterLights.data(), uNumLights * sizeof(ClusterLight), TRUE)))
+            {
+                OutputDebugString(L"Mapping the cluster light buffer failed\n");
+                return;
+            }
+        }
+        m_bClusterLightsDirty = FALSE;
+
+        if (!m_bClustersDirty)
+        {
+            return;
+        }
+
+        const std::vector<XMUINT2>& aClusterRanges = m_lightClusters->GetClusterRanges();
+        if (FAILED(pContext->UpdateDynamicConstantBuffer(m_clusterRangeBuffer.Get(), 0u, aClusterRanges.data(), static_cast<UINT>(aClusterRanges.size() * sizeof(XMUINT2)), TRUE)))
+        {
+            OutputDebugString(L"Mapping the cluster range buffer failed\n");
+            return;
+        }
+
+        const std::vector<UINT>& aLightIndices = m_lightClusters->GetLightIndices();
+        if (!aLightIndices.empty())
+        {
+            const UINT uNumIndices = static_cast<UINT>(aLightIndices.size());
+            if (uNumIndices > m_uClusterIndexCapacity)
+            {
+                while (m_uClusterIndexCapacity < uNumIndices)
+                {
+                    m_uClusterIndexCapacity *= 2u;
+                }
+
+                if (FAILED(createStructuredBuffer(sizeof(UINT), m_uClusterIndexCapacity, m_clusterIndexBuffer, m_clusterIndexView)))
+                {
+                    OutputDebugString(L"Creating the cluster light index buffer failed\n");
+                    return;
+                }
+            }
+
+            if (FAILED(pContext->UpdateDynamicConstantBuffer(m_clusterIndexBuffer.Get(), 0u, aLightIndices.data(), uNumIndices * sizeof(UINT), TRUE)))
+            {
+                OutputDebugString(L"Mapping the cluster light index buffer failed\n");
+                return;
+            }
+        }
+        m_bClustersDirty = FALSE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::createStructuredBuffer
+
+      Summary:  Create a dynamic structured buffer the CPU rewrites
+                and a shader resource view of all of its elements
+
+      Args:     UINT uStride
+                  Size of an element in bytes
+                UINT uNumElements
+                  Number of elements
+                ComPtr<ID3D11Buffer>& outBuffer
+                  Receives the buffer
+                ComPtr<ID3D11ShaderResourceView>& outShaderResourceView
+                  Receives the view
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Renderer::createStructuredBuffer(
+        _In_ UINT uStride,
+        _In_ UINT uNumElements,
+        _Out_ ComPtr<ID3D11Buffer>& outBuffer,
+        _Out_ ComPtr<ID3D11ShaderResourceView>& outShaderResourceView
+    )
+    {
+        D3D11_BUFFER_DESC bd =
+        {
+            .ByteWidth = uStride * uNumElements,
+            .Usage = D3D11_USAGE_DYNAMIC,
+            .BindFlags = D3D11_BIND_SHADER_RESOURCE,
+            .CPUAccessFlags = D3D11_CPU_ACCESS_WRITE,
+            .MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED,
+            .StructureByteStride = uStride
+        };
+        HRESULT hr = m_d3dDevice->CreateBuffer(&bd, nullptr, outBuffer.ReleaseAndGetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        D3D11_SHADER_RESOURCE_VIEW_DESC srvd =
+        {
+            .Format = DXGI_FORMAT_UNKNOWN,
+            .ViewDimension = D3D11_SRV_DIMENSION_BUFFER,
+            .Buffer = {.FirstElement = 0u,
+                       .NumElements = uNumElements}
+        };
+        return m_d3dDevice->CreateShaderResourceView(outBuffer.Get(), &srvd, outShaderResourceView.ReleaseAndGetAddressOf());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::collectRenderStats
+
+      Summary:  Copy the counters of the frame out of the context and
+                count the objects of the draw lists. The voxels and
+                models occlusion culling hid are culled, every other
+                object of the main scene is submitted
+
+      Args:     RenderContext* pContext
+                  The render context the frame was recorded to
+
+      Modifies: [m_renderStats, m_overdrawEstimator,
+                 m_uNumRenderedFrames].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::collectRenderStats(_In_ RenderContext* pContext)
+    {
+        m_renderStats = pContext->GetStats();
+        m_renderStats.uNumRetainedBytes = m_constantBufferRing.GetRetainedSize();
+        m_renderStats.uNumSubmittedObjects = static_cast<UINT>(m_aRenderableDrawList.size() + m_aVoxelDrawList.size() + m_aModelDrawList.size());
+        if (m_pSkybox != nullptr)
+        {
+            ++m_renderStats.uNumSubmittedObjects;
+        }
+        m_renderStats.uNumCulledObjects = static_cast<UINT>(std::count(m_aVoxelVisible.begin(), m_aVoxelVisible.end(), static_cast<BYTE>(0u)) + std::count(m_aModelVisible.begin(), m_aModelVisible.end(), static_cast<BYTE>(0u)));
+        m_renderStats.uNumSubmittedObjects -= m_renderStats.uNumCulledObjects;
+
+        m_renderStats.uNumShadowMapUpdates = 0u;
+        for (const ShadowLightState& state : m_aShadowLights)
+        {
+            m_renderStats.uNumShadowMapUpdates += state.bScheduled ? 1u : 0u;
+        }
+        for (const ShadowCascadeState& state : m_aCascades)
+        {
+            m_renderStats.uNumShadowMapUpdates += state.bScheduled ? 1u : 0u;
+        }
+
+        // Estimate the overdraw of the scene passes from the bounds of the objects
+        m_overdrawEstimator.Begin(m_camera.GetView(), m_projection, static_cast<UINT>(m_viewport.Width), static_cast<UINT>(m_viewport.Height));
+        for (const BoundingBox& bounds : m_pMainScene->GetRenderables().GetBounds())
+        {
+            m_overdrawEstimator.AddBounds(bounds, FALSE);
+        }
+        const std::vector<BoundingBox>& aVoxelBounds = m_pMainScene->GetVoxels().GetBounds();
+        for (size_t i = 0u; i < aVoxelBounds.size() && i < m_aVoxelVisible.size(); ++i)
+        {
+            if (m_aVoxelVisible[i])
+            {
+                m_overdrawEstimator.AddBounds(aVoxelBounds[i], m_bDepthPrepassVoxels && m_shadowVertexShader);
+            }
+        }
+        const std::vector<BoundingBox>& aModelBounds = m_pMainScene->GetModels().GetBounds();
+        for (size_t i = 0u; i < aModelBounds.size() && i < m_aModelDrawList.size(); ++i)
+        {
+            if (m_aModelVisible[i])
+            {
+                m_overdrawEstimator.AddBounds(aModelBounds[i], m_bDepthPrepassModels && m_shadowVertexShader && m_aModelDrawList[i]->GetBoneTransforms().empty());
+            }
+        }
+        m_renderStats.uNumEstimatedFragments = m_overdrawEstimator.GetNumFragments();
+        m_renderStats.uNumEstimatedShadedFragments = m_overdrawEstimator.GetNumShadedFragments();
+        m_renderStats.uNumEstimatedCoveredPixels = m_overdrawEstimator.GetNumCoveredPixels();
+
+        ++m_uNumRenderedFrames;
+        if (m_uRenderStatsDumpInterval > 0u && m_uNumRenderedFrames % m_uRenderStatsDumpInterval == 0u)
+        {
+            DumpRenderStats();
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::bindPassState
+
+      Summary:  Bind the render targets, viewport, rasterizer state,
+                depth stencil state and topology a pass draws with
+
+      Args:     RenderContext* pContext
+                  The render context to record the commands to
+                const PassState& passState
+                  The output state of the pass
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::bindPassState(_In_ RenderContext* pContext, _In_ const PassState& passState)
+    {
+        UINT uNumRenderTargets = 0u;
+        while (uNumRenderTargets < NUM_GBUFFER_TARGETS && passState.apRenderTargetViews[uNumRenderTargets])
+        {
+            ++uNumRenderTargets;
+        }
+
+        pContext->OMSetRenderTargets(uNumRenderTargets, passState.apRenderTargetViews, passState.pDepthStencilView);
+        pContext->RSSetViewports(1u, passState.pViewport);
+        pContext->RSSetState(passState.pRasterizerState);
+        pContext->OMSetDepthStencilState(passState.pDepthStencilState, 0u);
+        pContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::getSceneDepthStencilState
+
+      Summary:  Returns the depth stencil state a scene pass draws
+                with, the equal test if its objects are in the depth
+                pre-pass
+
+      Args:     BOOL bDepthPrepass
+                  Whether the depth pre-pass renders the objects of
+                  the pass
+
+      Returns:  ID3D11DepthStencilState*
+                  The equal test, or null for the default state
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ID3D11DepthStencilState* Renderer::getSceneDepthStencilState(_In_ BOOL bDepthPrepass) const
+    {
+        return bDepthPrepass && m_shadowVertexShader ? m_depthEqualState.Get() : nullptr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::recordDraws
+
+      Summary:  Record the draws of a pass. Large passes are split
+                across the command recorder, each partition binds the
+                pass state on its own context and the recordings are
+                submitted in order. Small passes, or every pass when no
+                recorder is set, are recorded on the given context,
+                which the pass has already bound
+
+      Args:     RenderContext* pContext
+                  The immediate context
+                const PassState& passState
+                  The output state of the pass
+                UINT uNumDraws
+                  Number of draws of the pass
+                const CommandRecorder::RecordFunction& record
+                  Records the draws [uBegin, uEnd)
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::recordDraws(
+        _In_ RenderContext* pContext,
+        _In_ const PassState& passState,
+        _In_ UINT uNumDraws,
+        _In_ const CommandRecorder::RecordFunction& record
+    )
+    {
+        if (!m_commandRecorder || uNumDraws < 2u * CommandRecorder::MIN_ITEMS_PER_CONTEXT)
+        {
+            record(pContext, 0u, uNumDraws);
+            return;
+        }
+
+        HRESULT hr = m_commandRecorder->Record(
+            uNumDraws,
+            [this, passState, &record](_In_opt_ RenderContext* pRecordContext, _In_ UINT uBegin, _In_ UINT uEnd)
+            {
+                if (pRecordContext)
+                {
+                    bindPassState(pRecordContext, passState);
+                    record(pRecordContext, uBegin, uEnd);
+                }
+            }
+        );
+        if (FAILED(hr))
+        {
+            // Drop the partial recordings and draw on the immediate context instead
+            OutputDebugString(L"Recording draws on deferred contexts failed, drawing on the immediate context\n");
+            m_commandRecorder->Submit(nullptr);
+            record(pContext, 0u, uNumDraws);
+            return;
+        }
+
+        m_commandRecorder->Submit(pContext);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::updateConstantBuffers
+
+      Summary:  Build the constant buffer data of the frame and write
+                it to the frame constant buffer with a single map,
+                before any pass records. The passes only bind ranges of
+                the buffer, so deferred contexts upload nothing.
+                Constants whose owner did not change since they were
+                written are retained, so a frame without changes maps
+                nothing
+
+      Args:     RenderContext* pContext
+                  The render context to record the upload to
+
+      Modifies: [m_cbFrame, m_constantBufferRing, m_frameConstants,
+                 m_aRenderableConstants, m_aVoxelConstants,
+                 m_aModelConstants, m_skyboxConstants].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::updateConstantBuffers(_In_ RenderContext* pContext)
+    {
+        m_constantBufferRing.BeginFrame();
+
+        // Without no-overwrite maps of constant buffers every frame discards the buffer
+        if (!m_bCanMapNoOverwrite)
+        {
+            m_constantBufferRing.Reset();
+        }
+
+        allocateConstants();
+        BOOL bGrown = m_constantBufferRing.EndFrame();
+        if (!m_constantBufferRing.IsFramePlaced())
+        {
+            // The frame wrapped and the discard drops the retained constants
+            m_constantBufferRing.BeginFrame();
+            allocateConstants();
+            bGrown = m_constantBufferRing.EndFrame() || bGrown;
+        }
+        placeConstants();
+
+        if (bGrown && m_d3dDevice)
+        {
+            D3D11_BUFFER_DESC bd =
+            {
+                .ByteWidth = m_constantBufferRing.GetCapacity(),
+                .Usage = D3D11_USAGE_DYNAMIC,
+                .BindFlags = D3D11_BIND_CONSTANT_BUFFER,
+                .CPUAccessFlags = D3D11_CPU_ACCESS_WRITE
+            };
+            if (FAILED(m_d3dDevice->CreateBuffer(&bd, nullptr, m_cbFrame.ReleaseAndGetAddressOf())))
+            {
+                OutputDebugString(L"Creating the frame constant buffer failed\n");
+            }
+        }
+
+        // Every constant of the frame is retained
+        if (m_constantBufferRing.GetFrameSize() == 0u)
+        {
+            return;
+        }
+
+        HRESULT hr = pContext->UpdateDynamicConstantBuffer(
+            m_cbFrame.Get(),
+            m_constantBufferRing.GetFrameOffset(),
+            m_constantBufferRing.GetFrameData(),
+            m_constantBufferRing.GetFrameSize(),
+            m_constantBufferRing.IsFrameDiscarding()
+        );
+        if (FAILED(hr))
+        {
+            // Start the next frame on a discarded buffer
+            OutputDebugString(L"Mapping the frame constant buffer failed\n");
+            m_constantBufferRing.Reset();
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::allocateConstants
+
+      Summary:  Retain or allocate every constant of the frame. Data is
+                only built and copied for owners whose version changed.
+                Every change takes a version newer than all others, so
+                the newest version of several owners changes whenever
+                one of them does
+
+      Modifies: [m_constantBufferRing, m_frameConstants,
+                 m_aRenderableConstants, m_aVoxelConstants,
+                 m_aModelConstants, m_skyboxConstants].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::allocateConstants()
+    {
+        // Camera constants
+        if (!m_constantBufferRing.Retain(m_frameConstants.Camera, &m_camera, m_camera.GetVersion()))
+        {
+            CBChangeOnCameraMovement cbChangeOnCameraMovement =
+            {
+                .View = XMMatrixTranspose(m_camera.GetView()),
+            };
+            XMStoreFloat4(&cbChangeOnCameraMovement.CameraPosition, m_camera.GetEye());
+            m_frameConstants.Camera = m_constantBufferRing.Allocate(&cbChangeOnCameraMovement, sizeof(cbChangeOnCameraMovement), &m_camera, m_camera.GetVersion());
+        }
+
+        // Projection constants, a new projection resets the ring
+        if (!m_constantBufferRing.Retain(m_frameConstants.Projection, &m_projection, 1u))
+        {
+            CBChangeOnResize cbChangeOnResize =
+            {
+                .Projection = XMMatrixTranspose(m_projection)
+            };
+            m_frameConstants.Projection = m_constantBufferRing.Allocate(&cbChangeOnResize, sizeof(cbChangeOnResize), &m_projection, 1u);
+        }
+
+        // Lights constants, they also change when a light gets its first shadow map
+        UINT64 uLightsVersion = m_uShadowVersion;
+        for (UINT i = 0u; i < NUM_LIGHTS; ++i)
+        {
+            uLightsVersion = std::max(uLightsVersion, m_pMainScene->GetPointLight(i)->GetVersion());
+        }
+
+        if (!m_constantBufferRing.Retain(m_frameConstants.Lights, m_pMainScene, uLightsVersion))
+        {
+            CBLights cbLights = {};
+            for (UINT i = 0u; i < NUM_LIGHTS; ++i)
+            {
+                cbLights.LightPositions[i] = m_pMainScene->GetPointLight(i)->GetPosition();
+                cbLights.LightColors[i] = m_pMainScene->GetPointLight(i)->GetColor();
+                cbLights.LightViews[i] = XMMatrixTranspose(m_pMainScene->GetPointLight(i)->GetViewMatrix());
+                cbLights.LightProjections[i] = XMMatrixTranspose(m_pMainScene->GetPointLight(i)->GetProjectionMatrix());
+
+                FLOAT attenuationDistance = m_pMainScene->GetPointLight(i)->GetAttenuationDistance();
+                FLOAT attenuationDistanceSquared = attenuationDistance * attenuationDistance;
+                cbLights.LightAttenuationDistance[i] = XMFLOAT4(attenuationDistance, attenuationDistance, attenuationDistanceSquared, attenuationDistanceSquared);
+
+                // The slice of a light is sampled once it has been rendered, even while it is stale
+                const FLOAT shadowIndex = m_aShadowLights[i].bRendered ? static_cast<FLOAT>(i) : -1.0f;
+                cbLights.LightShadowIndices[i] = XMFLOAT4(shadowIndex, 0.0f, 0.0f, 0.0f);
+            };
+            m_frameConstants.Lights = m_constantBufferRing.Allocate(&cbLights, sizeof(cbLights), m_pMainScene, uLightsVersion);
+        }
+
+        // View and projection of every light for its shadow pass
+        for (UINT i = 0u; i < NUM_LIGHTS; ++i)
+        {
+            const PointLight* pLight = m_pMainScene->GetPointLight(i).get();
+            if (!m_constantBufferRing.Retain(m_frameConstants.ShadowLights[i], pLight, pLight->GetVersion()))
+            {
+                CBShadowLight cbShadowLight =
+                {
+                    .View = XMMatrixTranspose(pLight->GetViewMatrix()),
+                    .Projection = XMMatrixTranspose(pLight->GetProjectionMatrix())
+                };
+                m_frameConstants.ShadowLights[i] = m_constantBufferRing.Allocate(&cbShadowLight, sizeof(cbShadowLight), pLight, pLight->GetVersion());
+            }
+        }
+
+        // Cascades of the directional light, a scene without one gets a black light
+        const DirectionalLight* pDirectionalLight = m_pMainScene->GetDirectionalLightOrNull();
+        UINT64 uCascadesVersion = pDirectionalLight != nullptr ? pDirectionalLight->GetVersion() : 0u;
+        for (UINT i = 0u; i < NUM_CASCADES; ++i)
+        {
+            const UINT64 uCascadeVersion = m_shadowCascades.GetVersion(i);
+            uCascadesVersion = std::max(uCascadesVersion, uCascadeVersion);
+
+            if (!m_constantBufferRing.Retain(m_frameConstants.CascadeLights[i], &m_aCascades[i], uCascadeVersion))
+            {
+                CBShadowLight cbShadowLight =
+                {
+                    .View = XMMatrixTranspose(m_shadowCascades.GetViewMatrix()),
+                    .Projection = XMMatrixTranspose(m_shadowCascades.GetProjectionMatrix(i))
+                };
+                m_frameConstants.CascadeLights[i] = m_constantBufferRing.Allocate(&cbShadowLight, sizeof(cbShadowLight), &m_aCascades[i], uCascadeVersion);
+            }
+        }
+
+        if (!m_constantBufferRing.Retain(m_frameConstants.Cascades, &m_shadowCascades, uCascadesVersion))
+        {
+            CBCascades cbCascades = {};
+            for (UINT i = 0u; i < NUM_CASCADES; ++i)
+            {
+                cbCascades.CascadeViewProjections[i] = XMMatrixTranspose(m_shadowCascades.GetViewMatrix() * m_shadowCascades.GetProjectionMatrix(i));
+                cbCascades.CascadeSplits[i] = XMFLOAT4(m_shadowCascades.GetSplitDepth(i), m_shadowCascades.GetTexelSize(i), 0.0f, 0.0f);
+            }
+            if (pDirectionalLight != nullptr)
+            {
+                cbCascades.DirectionalLightDirection = pDirectionalLight->GetDirection();
+                cbCascades.DirectionalLightColor = pDirectionalLight->GetColor();
+            }
+            m_frameConstants.Cascades = m_constantBufferRing.Allocate(&cbCascades, sizeof(cbCascades), &m_shadowCascades, uCascadesVersion);
+        }
+
+        // Cluster grid of the local lights, it only changes with the projection, which resets the ring
+        if (!m_constantBufferRing.Retain(m_frameConstants.Clusters, m_lightClusters.get(), 1u))
+        {
+            CBClusters cbClusters =
+            {
+                .ClusterCounts = XMUINT4(LightClusters::NUM_CLUSTERS_X, LightClusters::NUM_CLUSTERS_Y, LightClusters::NUM_CLUSTERS_Z, 0u),
+                .ClusterScales = XMFLOAT4(
+                    static_cast<FLOAT>(LightClusters::NUM_CLUSTERS_X) / m_viewport.Width,
+                    static_cast<FLOAT>(LightClusters::NUM_CLUSTERS_Y) / m_viewport.Height,
+                    m_lightClusters->GetSliceScale(),
+                    m_lightClusters->GetSliceBias()
+                )
+            };
+            m_frameConstants.Clusters = m_constantBufferRing.Allocate(&cbClusters, sizeof(cbClusters), m_lightClusters.get(), 1u);
+        }
+
+        // View and projection of the camera for the depth pre-pass, a new projection resets the ring
+        if (!m_constantBufferRing.Retain(m_frameConstants.DepthPrepass, &m_camera, m_camera.GetVersion()))
+        {
+            CBShadowLight cbShadowLight =
+            {
+                .View = XMMatrixTranspose(m_camera.GetView()),
+                .Projection = XMMatrixTranspose(m_projection)
+            };
+            m_frameConstants.DepthPrepass = m_constantBufferRing.Allocate(&cbShadowLight, sizeof(cbShadowLight), &m_camera, m_camera.GetVersion());
+        }
+
+        // Object and shadow constants, the shadow constants do not depend on the light
+        m_aRenderableConstants.resize(m_aRenderableDrawList.size());
+        for (size_t i = 0u; i < m_aRenderableDrawList.size(); ++i)
+        {
+            allocateDrawConstants(m_aRenderableDrawList[i], FALSE, m_aRenderableConstants[i]);
+        }
+
+        m_aVoxelConstants.resize(m_aVoxelDrawList.size());
+        for (size_t i = 0u; i < m_aVoxelDrawList.size(); ++i)
+        {
+            allocateDrawConstants(m_aVoxelDrawList[i], TRUE, m_aVoxelConstants[i]);
+        }
+
+        m_aModelConstants.resize(m_aModelDrawList.size());
+        for (size_t i = 0u; i < m_aModelDrawList.size(); ++i)
+        {
+            Model* pModel = m_aModelDrawList[i];
+            allocateDrawConstants(pModel, FALSE, m_aModelConstants[i]);
+
+            if (!m_constantBufferRing.Retain(m_aModelConstants[i].Skinning, pModel, pModel->GetVersion()))
+            {
+                CBSkinning cbSkinning = {};
+                for (UINT j = 0u; j < pModel->GetBoneTransforms().size(); ++j)
+                {
+                    cbSkinning.BoneTransforms[j] = XMMatrixTranspose(pModel->GetBoneTransforms()[j]);
+                }
+                m_aModelConstants[i].Skinning = m_constantBufferRing.Allocate(&cbSkinning, sizeof(cbSkinning), pModel, pModel->GetVersion());
+            }
+        }
+
+        // The skybox follows the camera and casts no shadow
+        if (m_pSkybox != nullptr)
+        {
+            const UINT64 uSkyboxVersion = std::max(m_pSkybox->GetVersion(), m_camera.GetVersion());
+            if (!m_constantBufferRing.Retain(m_skyboxConstants.Object, m_pSkybox, uSkyboxVersion))
+            {
+                CBChangesEveryFrame cbChangesEveryFrame =
+                {
+                    .World = XMMatrixTranspose(m_pSkybox->GetWorldMatrix() * XMMatrixTranslationFromVector(m_camera.GetEye())),
+                    .OutputColor = m_pSkybox->GetOutputColor(),
+                    .HasNormalMap = m_pSkybox->HasNormalMap()
+                };
+                m_skyboxConstants.Object = m_constantBufferRing.Allocate(&cbChangesEveryFrame, sizeof(cbChangesEveryFrame), m_pSkybox, uSkyboxVersion);
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::placeConstants
+
+      Summary:  Make the constants of the placed frame relative to the
+                frame constant buffer, so the next frames can retain
+                them
+
+      Modifies: [m_frameConstants, m_aRenderableConstants,
+                 m_aVoxelConstants, m_aModelConstants,
+                 m_skyboxConstants].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::placeConstants()
+    {
+        m_constantBufferRing.Place(m_frameConstants.Camera);
+        m_constantBufferRing.Place(m_frameConstants.Projection);
+        m_constantBufferRing.Place(m_frameConstants.Lights);
+        for (UINT i = 0u; i < NUM_LIGHTS; ++i)
+        {
+            m_constantBufferRing.Place(m_frameConstants.ShadowLights[i]);
+        }
+        m_constantBufferRing.Place(m_frameConstants.Cascades);
+        for (UINT i = 0u; i < NUM_CASCADES; ++i)
+        {
+            m_constantBufferRing.Place(m_frameConstants.CascadeLights[i]);
+        }
+        m_constantBufferRing.Place(m_frameConstants.Clusters);
+        m_constantBufferRing.Place(m_frameConstants.DepthPrepass);
+
+        auto placeDrawConstants = [this](_Inout_ DrawConstants& drawConstants)
+        {
+            m_constantBufferRing.Place(drawConstants.Object);
+            m_constantBufferRing.Place(drawConstants.Shadow);
+            m_constantBufferRing.Place(drawConstants.Skinning);
+        };
+
+        for (DrawConstants& drawConstants : m_aRenderableConstants)
+        {
+            placeDrawConstants(drawConstants);
+        }
+
+        for (DrawConstants& drawConstants : m_aVoxelConstants)
+        {
+            placeDrawConstants(drawConstants);
+        }
+
+        for (DrawConstants& drawConstants : m_aModelConstants)
+        {
+            placeDrawConstants(drawConstants);
+        }
+
+        placeDrawConstants(m_skyboxConstants);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::allocateDrawConstants
+
+      Summary:  Retain or allocate the object and shadow constants of a
+                draw in the frame constant buffer
+
+      Args:     Renderable* pRenderable
+                  The renderable to draw
+                BOOL bIsVoxel
+                  TRUE if the shadow is drawn with instances
+                DrawConstants& drawConstants
+                  Ranges of the constants of the last frame, updated
+                  to the ranges of this frame. Skinning constants are
+                  left as they are
+
+      Modifies: [m_constantBufferRing].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::allocateDrawConstants(
+        _In_ Renderable* pRenderable,
+        _In_ BOOL bIsVoxel,
+        _Inout_ DrawConstants& drawConstants
+    )
+    {
+        const UINT64 uVersion = pRenderable->GetVersion();
+        if (!m_constantBufferRing.Retain(drawConstants.Object, pRenderable, uVersion))
+        {
+            CBChangesEveryFrame cbChangesEveryFrame =
+            {
+                .World = XMMatrixTranspose(pRenderable->GetWorldMatrix()),
+                .OutputColor = pRenderable->GetOutputColor(),
+                .HasNormalMap = pRenderable->HasNormalMap()
+            };
+            drawConstants.Object = m_constantBufferRing.Allocate(&cbChangesEveryFrame, sizeof(cbChangesEveryFrame), pRenderable, uVersion);
+        }
+
+        // The light is bound separately, so every shadow pass shares the shadow constants
+        if (!m_constantBufferRing.Retain(drawConstants.Shadow, pRenderable, uVersion))
+        {
+            CBShadowMatrix cbShadowMatrix =
+            {
+                .World = XMMatrixTranspose(pRenderable->GetWorldMatrix()),
+                .IsVoxel = bIsVoxel
+            };
+            drawConstants.Shadow = m_constantBufferRing.Allocate(&cbShadowMatrix, sizeof(cbShadowMatrix), pRenderable, uVersion);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::bindSceneConstantBuffers
+
+      Summary:  Bind the camera, projection, object and lights
+                constants of a draw to the slots 0 to 3 of the vertex
+                and pixel shaders, the skinning constants of a model
+                to the slot 4 of the vertex shader, and the cascades
+                and the cluster grid to the slots 5 and 6 of the pixel
+                shader
+
+      Args:     RenderContext* pContext
+                  The render context to record the commands to
+                const DrawConstants& drawConstants
+                  Constants of the draw
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::bindSceneConstantBuffers(_In_ RenderContext* pContext, _In_ const DrawConstants& drawConstants)
+    {
+        ID3D11Buffer* const apConstantBuffers[] = { m_cbFrame.Get(), m_cbFrame.Get(), m_cbFrame.Get(), m_cbFrame.Get(), m_cbFrame.Get(), m_cbFrame.Get(), m_cbFrame.Get() };
+        const ConstantBufferAllocation aAllocations[] =
+        {
+            m_frameConstants.Camera,
+            m_frameConstants.Projection,
+            drawConstants.Object,
+            m_frameConstants.Lights,
+            drawConstants.Skinning,
+            m_frameConstants.Cascades,
+            m_frameConstants.Clusters
+        };
+
+        UINT auFirstConstants[ARRAYSIZE(aAllocations)];
+        UINT auNumConstants[ARRAYSIZE(aAllocations)];
+        for (UINT i = 0u; i < ARRAYSIZE(aAllocations); ++i)
+        {
+            auFirstConstants[i] = m_constantBufferRing.GetFirstConstant(aAllocations[i]);
+            auNumConstants[i] = ConstantBufferRing::GetNumConstants(aAllocations[i]);
+        }
+
+        const UINT uNumVertexShaderBuffers = drawConstants.Skinning.uSize > 0u ? 5u : 4u;
+        pContext->VSSetConstantBuffers1(0u, uNumVertexShaderBuffers, apConstantBuffers, auFirstConstants, auNumConstants);
+        pContext->PSSetConstantBuffers1(0u, 4u, apConstantBuffers, auFirstConstants, auNumConstants);
+        pContext->PSSetConstantBuffers1(5u, 2u, &apConstantBuffers[5], &auFirstConstants[5], &auNumConstants[5]);
+    }
 
-            // Update voxel constant buffer
-            CBChangesEveryFrame cbChangesEveryFrame =
-            {
-                .World = XMMatrixTranspose(voxel->get()->GetWorldMatrix()),
-                .OutputColor = voxel->get()->GetOutputColor(),
-                .HasNormalMap = voxel->get()->HasNormalMap()
-            };
-            m_immediateContext->UpdateSubresource(voxel->get()->GetConstantBuffer().Get(), 0u, nullptr, &cbChangesEveryFrame, 0u, 0u);
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::bindLightClusters
+
+      Summary:  Bind the local lights, the light ranges of the clusters
+                and the light indices to the slots 5 to 7 of the pixel
+                shader
+
+      Args:     RenderContext* pContext
+                  The render context to record the commands to
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::bindLightClusters(_In_ RenderContext* pContext)
+    {
+        ID3D11ShaderResourceView* const apShaderResourceViews[] =
+        {
+            m_clusterLightView.Get(),
+            m_clusterRangeView.Get(),
+            m_clusterIndexView.Get()
+        };
+        pContext->PSSetShaderResources(5u, ARRAYSIZE(apShaderResourceViews), apShaderResourceViews);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::bindShadowConstantBuffers
+
+      Summary:  Bind the shadow constants of a draw to the slot 0 and
+                the view and projection of a light or a cascade to the
+                slot 1 of the vertex shader
+
+      Args:     RenderContext* pContext
+                  The render context to record the commands to
+                const DrawConstants& drawConstants
+                  Constants of the draw
+                const ConstantBufferAllocation& lightConstants
+                  View and projection the shadow is cast with
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::bindShadowConstantBuffers(_In_ RenderContext* pContext, _In_ const DrawConstants& drawConstants, _In_ const ConstantBufferAllocation& lightConstants)
+    {
+        ID3D11Buffer* const apConstantBuffers[] = { m_cbFrame.Get(), m_cbFrame.Get() };
+        const ConstantBufferAllocation aAllocations[] =
+        {
+            drawConstants.Shadow,
+            lightConstants
+        };
 
-            // Set the vertex shader and constant buffers
-            m_immediateContext->VSSetShader(voxel->get()->GetVertexShader().Get(), nullptr, 0u);
-            m_immediateContext->VSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(2u, 1u, voxel->get()->GetConstantBuffer().GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
+        UINT auFirstConstants[ARRAYSIZE(aAllocations)];
+        UINT auNumConstants[ARRAYSIZE(aAllocations)];
+        for (UINT i = 0u; i < ARRAYSIZE(aAllocations); ++i)
+        {
+            auFirstConstants[i] = m_constantBufferRing.GetFirstConstant(aAllocations[i]);
+            auNumConstants[i] = ConstantBufferRing::GetNumConstants(aAllocations[i]);
+        }
 
-            // Set the pixel shader and constant buffers
-            m_immediateContext->PSSetShader(voxel->get()->GetPixelShader().Get(), nullptr, 0u);
-            m_immediateContext->PSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-            m_immediateContext->PSSetConstantBuffers(2u, 1u, voxel->get()->GetConstantBuffer().GetAddressOf());
-            m_immediateContext->PSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
+        pContext->VSSetConstantBuffers1(0u, ARRAYSIZE(aAllocations), apConstantBuffers, auFirstConstants, auNumConstants);
+    }
 
-            if (voxel->get()->HasTexture())
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::renderCasters
+
+      Summary:  Render the casters of a shadow map into the slice the
+                pass state binds, split across the worker threads
+
+      Args:     RenderContext* pContext
+                  The render context to record the commands to
+                const PassState& passState
+                  The output state of the pass
+                const std::vector<UINT>& aCasters
+                  Indices of the renderables, voxels and models, in
+                  this order
+                const ConstantBufferAllocation& lightConstants
+                  View and projection the shadow is cast with
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::renderCasters(
+        _In_ RenderContext* pContext,
+        _In_ const PassState& passState,
+        _In_ const std::vector<UINT>& aCasters,
+        _In_ const ConstantBufferAllocation& lightConstants
+    )
+    {
+        const UINT uNumRenderables = static_cast<UINT>(m_aRenderableDrawList.size());
+        const UINT uNumVoxels = static_cast<UINT>(m_aVoxelDrawList.size());
+        recordDraws(
+            pContext,
+            passState,
+            static_cast<UINT>(aCasters.size()),
+            [this, &aCasters, &lightConstants, uNumRenderables, uNumVoxels](_In_opt_ RenderContext* pRecordContext, _In_ UINT uBegin, _In_ UINT uEnd)
             {
-                for (UINT i = 0u; i < voxel->get()->GetNumMeshes(); ++i)
+                for (UINT i = uBegin; i < uEnd; ++i)
                 {
-                    const UINT uMaterialIndex = voxel->get()->GetMesh(i).uMaterialIndex;
-                    if (voxel->get()->GetMaterial(uMaterialIndex)->pDiffuse)
+                    const UINT uCaster = aCasters[i];
+                    if (uCaster < uNumRenderables)
                     {
-                        // Set texture resource view of the renderable into the pixel shader
-                        m_immediateContext->PSSetShaderResources(0u, 1u, voxel->get()->GetMaterial(uMaterialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
-
-                        // Set sampler state of the renderable into the pixel shader
-                        eTextureSamplerType textureSamplerType = voxel->get()->GetMaterial(uMaterialIndex)->pDiffuse->GetSamplerType();
-                        m_immediateContext->PSSetSamplers(0u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
+                        renderShadow(pRecordContext, m_aRenderableDrawList[uCaster], m_aRenderableConstants[uCaster], lightConstants);
                     }
-                    if (voxel->get()->GetMaterial(uMaterialIndex)->pNormal)
+                    else if (uCaster < uNumRenderables + uNumVoxels)
                     {
-                        // Set texture resource view of the renderable into the pixel shader
-                        m_immediateContext->PSSetShaderResources(1u, 1u, voxel->get()->GetMaterial(uMaterialIndex)->pNormal->GetTextureResourceView().GetAddressOf());
-
-                        // Set sampler state of the renderable into the pixel shader
-                        eTextureSamplerType textureSamplerType = voxel->get()->GetMaterial(uMaterialIndex)->pNormal->GetSamplerType();
-                        m_immediateContext->PSSetSamplers(1u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
+                        renderVoxelShadow(pRecordContext, m_aVoxelDrawList[uCaster - uNumRenderables], m_aVoxelConstants[uCaster - uNumRenderables], lightConstants);
+                    }
+                    else
+                    {
+                        renderShadow(pRecordContext, m_aModelDrawList[uCaster - uNumRenderables - uNumVoxels], m_aModelConstants[uCaster - uNumRenderables - uNumVoxels], lightConstants);
                     }
+                }
+            }
+        );
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::renderShadow
+
+      Summary:  Render a renderable or a model from a light into the
+                bound slice of the shadow map
+
+      Args:     RenderContext* pContext
+                  The render context to record the commands to
+                Renderable* pRenderable
+                  The renderable to draw
+                const DrawConstants& drawConstants
+                  Constants of the draw
+                const ConstantBufferAllocation& lightConstants
+                  View and projection the shadow is cast with
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::renderShadow(_In_ RenderContext* pContext, _In_ Renderable* pRenderable, _In_ const DrawConstants& drawConstants, _In_ const ConstantBufferAllocation& lightConstants)
+    {
+        // Bind vertex buffer
+        UINT uStride = sizeof(SimpleVertex);
+        UINT uOffset = 0u;
+        pContext->IASetVertexBuffers(0u, 1u, pRenderable->GetVertexBuffer().GetAddressOf(), &uStride, &uOffset);
 
-                    // Set texture and sampler state of the shadow map into the pixel shader
-                    m_immediateContext->PSSetShaderResources(2u, 1u, m_shadowMapTexture->GetShaderResourceView().GetAddressOf());
-                    m_immediateContext->PSSetSamplers(2u, 1u, m_shadowMapTexture->GetSamplerState().GetAddressOf());
+        // Bind index buffer
+        pContext->IASetIndexBuffer(pRenderable->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);
 
-                    if (m_scenes[m_pszMainSceneName]->GetSkyBox() != nullptr)
-                    {
-                        for (UINT i = 0u; i < m_scenes[m_pszMainSceneName]->GetSkyBox()->GetNumMeshes(); ++i)
-                        {
-                            const UINT uMaterialIndex = m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMesh(i).uMaterialIndex;
-                            if (m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMaterial(uMaterialIndex)->pDiffuse)
-                            {
-                                // Set texture resource view of the skybox into the pixel shader
-                                m_immediateContext->PSSetShaderResources(3u, 1u, m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMaterial(uMaterialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
+        // Bind input layout
+        pContext->IASetInputLayout(m_shadowVertexShader->GetVertexLayout().Get());
 
-                                // Set sampler state of the skybox into the pixel shader
-                                eTextureSamplerType textureSamplerType = m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMaterial(uMaterialIndex)->pDiffuse->GetSamplerType();
-                                m_immediateContext->PSSetSamplers(3u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-                            }
-                        }
-                    }
+        // Bind vertex shader and shadow constant buffers
+        pContext->VSSetShader(m_shadowVertexShader->GetVertexShader().Get(), nullptr, 0u);
+        bindShadowConstantBuffers(pContext, drawConstants, lightConstants);
 
-                    // Render the triangles
-                    m_immediateContext->DrawIndexedInstanced(voxel->get()->GetMesh(i).uNumIndices,
-                                                             voxel->get()->GetNumInstances(),
-                                                             voxel->get()->GetMesh(i).uBaseIndex,
-                                                             voxel->get()->GetMesh(i).uBaseVertex,
-                                                             0u);
-                }
+        // Unbind the pixel shader, the shadow pass writes depth only
+        pContext->PSSetShader(nullptr, nullptr, 0u);
+
+        // Render the triangles
+        if (pRenderable->HasTexture())
+        {
+            for (UINT i = 0; i < pRenderable->GetNumMeshes(); ++i)
+            {
+                pContext->DrawIndexed(pRenderable->GetMesh(i).uNumIndices,
+                                      pRenderable->GetMesh(i).uBaseIndex,
+                                      pRenderable->GetMesh(i).uBaseVertex);
             }
-            else
+        }
+        else
+        {
+            pContext->DrawIndexed(pRenderable->GetNumIndices(), 0u, 0);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::renderVoxelShadow
+
+      Summary:  Render the instances of a voxel from a light into the
+                bound slice of the shadow map
+
+      Args:     RenderContext* pContext
+                  The render context to record the commands to
+                Voxel* pVoxel
+                  The voxel to draw
+                const DrawConstants& drawConstants
+                  Constants of the draw
+                const ConstantBufferAllocation& lightConstants
+                  View and projection the shadow is cast with
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::renderVoxelShadow(_In_ RenderContext* pContext, _In_ Voxel* pVoxel, _In_ const DrawConstants& drawConstants, _In_ const ConstantBufferAllocation& lightConstants)
+    {
+        // Bind vertex buffer
+        UINT uStride = sizeof(SimpleVertex);
+        UINT uOffset = 0u;
+        pContext->IASetVertexBuffers(0u, 1u, pVoxel->GetVertexBuffer().GetAddressOf(), &uStride, &uOffset);
+
+        // Bind instance buffer
+        uStride = sizeof(InstanceData);
+        pContext->IASetVertexBuffers(2u, 1u, pVoxel->GetInstanceBuffer().GetAddressOf(), &uStride, &uOffset);
+
+        // Bind index buffer
+        pContext->IASetIndexBuffer(pVoxel->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);
+
+        // Bind input layout
+        pContext->IASetInputLayout(m_shadowVertexShader->GetVertexLayout().Get());
+
+        // Bind vertex shader and shadow constant buffers
+        pContext->VSSetShader(m_shadowVertexShader->GetVertexShader().Get(), nullptr, 0u);
+        bindShadowConstantBuffers(pContext, drawConstants, lightConstants);
+
+        // Unbind the pixel shader, the shadow pass writes depth only
+        pContext->PSSetShader(nullptr, nullptr, 0u);
+
+        // Render the triangles
+        if (pVoxel->HasTexture())
+        {
+            for (UINT i = 0; i < pVoxel->GetNumMeshes(); ++i)
+            {
+                pContext->DrawIndexedInstanced(pVoxel->GetMesh(i).uNumIndices,
+                                               pVoxel->GetNumInstances(),
+                                               pVoxel->GetMesh(i).uBaseIndex,
+                                               pVoxel->GetMesh(i).uBaseVertex,
+                                               0u);
+            }
+        }
+        else
+        {
+            pContext->DrawIndexedInstanced(pVoxel->GetNumIndices(), pVoxel->GetNumInstances(), 0u, 0, 0u);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::renderRenderable
+
+      Summary:  Render a renderable
+
+      Args:     RenderContext* pContext
+                  The render context to record the commands to
+                Renderable* pRenderable
+                  The renderable to draw
+                const DrawConstants& drawConstants
+                  Constants of the draw
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::renderRenderable(_In_ RenderContext* pContext, _In_ Renderable* pRenderable, _In_ const DrawConstants& drawConstants)
+    {
+        // Set the vertex buffer
+        UINT uStride = sizeof(SimpleVertex);
+        UINT uOffset = 0u;
+        pContext->IASetVertexBuffers(0u, 1u, pRenderable->GetVertexBuffer().GetAddressOf(), &uStride, &uOffset);
+
+        // Set the normal buffer
+        uStride = sizeof(NormalData);
+        pContext->IASetVertexBuffers(1u, 1u, pRenderable->GetNormalBuffer().GetAddressOf(), &uStride, &uOffset);
+
+        // Set the index buffer
+        pContext->IASetIndexBuffer(pRenderable->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);
+
+        // Set the input layout
+        pContext->IASetInputLayout(pRenderable->GetVertexLayout().Get());
+
+        // Set the shaders and constant buffers
+        pContext->VSSetShader(pRenderable->GetVertexShader().Get(), nullptr, 0u);
+        pContext->PSSetShader(pRenderable->GetPixelShader().Get(), nullptr, 0u);
+        bindSceneConstantBuffers(pContext, drawConstants);
+        bindLightClusters(pContext);
+
+        if (pRenderable->HasTexture())
+        {
+            for (UINT i = 0u; i < pRenderable->GetNumMeshes(); ++i)
             {
+                const UINT uMaterialIndex = pRenderable->GetMesh(i).uMaterialIndex;
+                if (pRenderable->GetMaterial(uMaterialIndex)->pDiffuse)
+                {
+                    // Set texture resource view of the renderable into the pixel shader
+                    pContext->PSSetShaderResources(0u, 1u, pRenderable->GetMaterial(uMaterialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
+
+                    // Set sampler state of the renderable into the pixel shader
+                    eTextureSamplerType textureSamplerType = pRenderable->GetMaterial(uMaterialIndex)->pDiffuse->GetSamplerType();
+                    pContext->PSSetSamplers(0u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
+                }
+                if (pRenderable->GetMaterial(uMaterialIndex)->pNormal)
+                {
+                    // Set texture resource view of the renderable into the pixel shader
+                    pContext->PSSetShaderResources(1u, 1u, pRenderable->GetMaterial(uMaterialIndex)->pNormal->GetTextureResourceView().GetAddressOf());
+
+                    // Set sampler state of the renderable into the pixel shader
+                    eTextureSamplerType textureSamplerType = pRenderable->GetMaterial(uMaterialIndex)->pNormal->GetSamplerType();
+                    pContext->PSSetSamplers(1u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
+                }
+
                 // Set texture and sampler state of the shadow map into the pixel shader
-                m_immediateContext->PSSetShaderResources(2u, 1u, m_shadowMapTexture->GetShaderResourceView().GetAddressOf());
-                m_immediateContext->PSSetSamplers(2u, 1u, m_shadowMapTexture->GetSamplerState().GetAddressOf());
+                pContext->PSSetShaderResources(2u, 1u, m_shadowMap->GetShaderResourceView().GetAddressOf());
+                pContext->PSSetSamplers(2u, 1u, m_shadowMap->GetSamplerState().GetAddressOf());
 
-                if (m_scenes[m_pszMainSceneName]->GetSkyBox() != nullptr)
+                if (m_pSkybox != nullptr)
                 {
-                    for (UINT i = 0u; i < m_scenes[m_pszMainSceneName]->GetSkyBox()->GetNumMeshes(); ++i)
+                    for (UINT i = 0u; i < m_pSkybox->GetNumMeshes(); ++i)
                     {
-                        const UINT uMaterialIndex = m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMesh(i).uMaterialIndex;
-                        if (m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMaterial(uMaterialIndex)->pDiffuse)
+                        const UINT uMaterialIndex = m_pSkybox->GetMesh(i).uMaterialIndex;
+                        if (m_pSkybox->GetMaterial(uMaterialIndex)->pDiffuse)
                         {
                             // Set texture resource view of the skybox into the pixel shader
-                            m_immediateContext->PSSetShaderResources(3u, 1u, m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMaterial(uMaterialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
+                            pContext->PSSetShaderResources(3u, 1u, m_pSkybox->GetMaterial(uMaterialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
 
                             // Set sampler state of the skybox into the pixel shader
-                            eTextureSamplerType textureSamplerType = m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMaterial(uMaterialIndex)->pDiffuse->GetSamplerType();
-                            m_immediateContext->PSSetSamplers(3u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
+                            eTextureSamplerType textureSamplerType = m_pSkybox->GetMaterial(uMaterialIndex)->pDiffuse->GetSamplerType();
+                            pContext->PSSetSamplers(3u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
                         }
                     }
                 }
 
                 // Render the triangles
-                m_immediateContext->DrawIndexedInstanced(voxel->get()->GetNumIndices(), voxel->get()->GetNumInstances(), 0u, 0, 0u);
+                pContext->DrawIndexed(pRenderable->GetMesh(i).uNumIndices,
+                                      pRenderable->GetMesh(i).uBaseIndex,
+                                      pRenderable->GetMesh(i).uBaseVertex);
             }
         }
-
-        // For all models
-        std::unordered_map<std::wstring, std::shared_ptr<Model>>::iterator model;
-        for (model = m_scenes[m_pszMainSceneName]->GetModels().begin(); model != m_scenes[m_pszMainSceneName]->GetModels().end(); ++model)
+        else
         {
-            // Set the vertex buffer
-            UINT uStride = sizeof(SimpleVertex);
-            UINT uOffset = 0u;
-            m_immediateContext->IASetVertexBuffers(0u, 1u, model->second->GetVertexBuffer().GetAddressOf(), &uStride, &uOffset);
-
-            // Set the normal buffer
-            uStride = sizeof(NormalData);
-            m_immediateContext->IASetVertexBuffers(1u, 1u, model->second->GetNormalBuffer().GetAddressOf(), &uStride, &uOffset);
+            // Set texture and sampler state of the shadow map into the pixel shader
+            pContext->PSSetShaderResources(2u, 1u, m_shadowMap->GetShaderResourceView().GetAddressOf());
+            pContext->PSSetSamplers(2u, 1u, m_shadowMap->GetSamplerState().GetAddressOf());
 
-            // Set the animation buffer
-            uStride = sizeof(AnimationData);
-            m_immediateContext->IASetVertexBuffers(3u, 1u, model->second->GetAnimationBuffer().GetAddressOf(), &uStride, &uOffset);
+            if (m_pSkybox != nullptr)
+            {
+                for (UINT i = 0u; i < m_pSkybox->GetNumMeshes(); ++i)
+                {
+                    const UINT uMaterialIndex = m_pSkybox->GetMesh(i).uMaterialIndex;
+                    if (m_pSkybox->GetMaterial(uMaterialIndex)->pDiffuse)
+                    {
+                        // Set texture resource view of the skybox into the pixel shader
+                        pContext->PSSetShaderResources(3u, 1u, m_pSkybox->GetMaterial(uMaterialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
 
-            // Set the index buffer
-            m_immediateContext->IASetIndexBuffer(model->second->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);
+                        // Set sampler state of the skybox into the pixel shader
+                        eTextureSamplerType textureSamplerType = m_pSkybox->GetMaterial(uMaterialIndex)->pDiffuse->GetSamplerType();
+                        pContext->PSSetSamplers(3u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
+                    }
+                }
+            }
 
-            // Set the input layout
-            m_immediateContext->IASetInputLayout(model->second->GetVertexLayout().Get());
+            // Render the triangles
+            pContext->DrawIndexed(pRenderable->GetNumIndices(), 0u, 0);
+        }
+    }
 
-            // Update renderable constant buffer
-            CBChangesEveryFrame cbChangesEveryFrame =
-            {
-                .World = XMMatrixTranspose(model->second->GetWorldMatrix()),
-                .OutputColor = model->second->GetOutputColor(),
-                .HasNormalMap = model->second->HasNormalMap()
-            };
-            m_immediateContext->UpdateSubresource(model->second->GetConstantBuffer().Get(), 0u, nullptr, &cbChangesEveryFrame, 0u, 0u);
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::renderVoxel
 
-            // Update skinning constant buffer
-            CBSkinning cbSkinning = {};
-            for (UINT i = 0; i < model->second->GetBoneTransforms().size(); ++i)
-            {
-                cbSkinning.BoneTransforms[i] = XMMatrixTranspose(model->second->GetBoneTransforms()[i]);
-            }
-            m_immediateContext->UpdateSubresource(model->second->GetSkinningConstantBuffer().Get(), 0u, nullptr, &cbSkinning, 0u, 0u);
+      Summary:  Render the instances of a voxel
 
-            // Set the vertex shader and constant buffers
-            m_immediateContext->VSSetShader(model->second->GetVertexShader().Get(), nullptr, 0u);
-            m_immediateContext->VSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(2u, 1u, model->second->GetConstantBuffer().GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(4u, 1u, model->second->GetSkinningConstantBuffer().GetAddressOf());
+      Args:     RenderContext* pContext
+                  The render context to record the commands to
+                Voxel* pVoxel
+                  The voxel to draw
+                const DrawConstants& drawConstants
+                  Constants of the draw
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::renderVoxel(_In_ RenderContext* pContext, _In_ Voxel* pVoxel, _In_ const DrawConstants& drawConstants)
+    {
+        // Set the vertex buffer
+        UINT uStride = sizeof(SimpleVertex);
+        UINT uOffset = 0u;
+        pContext->IASetVertexBuffers(0u, 1u, pVoxel->GetVertexBuffer().GetAddressOf(), &uStride, &uOffset);
 
-            // Set the pixel shader and constant buffers
-            m_immediateContext->PSSetShader(model->second->GetPixelShader().Get(), nullptr, 0u);
-            m_immediateContext->PSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-            m_immediateContext->PSSetConstantBuffers(2u, 1u, model->second->GetConstantBuffer().GetAddressOf());
-            m_immediateContext->PSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
+        // Set the normal buffer
+        uStride = sizeof(NormalData);
+        pContext->IASetVertexBuffers(1u, 1u, pVoxel->GetNormalBuffer().GetAddressOf(), &uStride, &uOffset);
 
-            if (model->second->HasTexture())
-            {
-                for (UINT i = 0u; i < model->second->GetNumMeshes(); ++i)
-                {
-                    const UINT uMaterialIndex = model->second->GetMesh(i).uMaterialIndex;
-                    if (model->second->GetMaterial(uMaterialIndex)->pDiffuse)
-                    {
-                        // Set texture resource view of the renderable into the pixel shader
-                        m_immediateContext->PSSetShaderResources(0u, 1u, model->second->GetMaterial(uMaterialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
+        // Set the instance buffer
+        uStride = sizeof(InstanceData);
+        pContext->IASetVertexBuffers(2u, 1u, pVoxel->GetInstanceBuffer().GetAddressOf(), &uStride, &uOffset);
 
-                        // Set sampler state of the renderable into the pixel shader
-                        eTextureSamplerType textureSamplerType = model->second->GetMaterial(uMaterialIndex)->pDiffuse->GetSamplerType();
-                        m_immediateContext->PSSetSamplers(0u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-                    }
-                    if (model->second->GetMaterial(uMaterialIndex)->pNormal)
-                    {
-                        // Set texture resource view of the renderable into the pixel shader
-                        m_immediateContext->PSSetShaderResources(1u, 1u, model->second->GetMaterial(uMaterialIndex)->pNormal->GetTextureResourceView().GetAddressOf());
+        // Set the index buffer
+        pContext->IASetIndexBuffer(pVoxel->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);
 
-                        // Set sampler state of the renderable into the pixel shader
-                        eTextureSamplerType textureSamplerType = model->second->GetMaterial(uMaterialIndex)->pNormal->GetSamplerType();
-                        m_immediateContext->PSSetSamplers(1u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-                    }
+        // Set the input layout
+        pContext->IASetInputLayout(pVoxel->GetVertexLayout().Get());
 
-                    // Set texture and sampler state of the shadow map into the pixel shader
-                    m_immediateContext->PSSetShaderResources(2u, 1u, m_shadowMapTexture->GetShaderResourceView().GetAddressOf());
-                    m_immediateContext->PSSetSamplers(2u, 1u, m_shadowMapTexture->GetSamplerState().GetAddressOf());
+        // Set the shaders and constant buffers, on the deferred path the voxels only write their surface
+        ID3D11PixelShader* pPixelShader = m_renderPath == eRenderPath::DEFERRED ? m_voxelGBufferPixelShader->GetPixelShader().Get() : pVoxel->GetPixelShader().Get();
+        pContext->VSSetShader(pVoxel->GetVertexShader().Get(), nullptr, 0u);
+        pContext->PSSetShader(pPixelShader, nullptr, 0u);
+        bindSceneConstantBuffers(pContext, drawConstants);
+        bindLightClusters(pContext);
 
-                    if (m_scenes[m_pszMainSceneName]->GetSkyBox() != nullptr)
-                    {
-                        for (UINT i = 0u; i < m_scenes[m_pszMainSceneName]->GetSkyBox()->GetNumMeshes(); ++i)
-                        {
-                            const UINT uMaterialIndex = m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMesh(i).uMaterialIndex;
-                            if (m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMaterial(uMaterialIndex)->pDiffuse)
-                            {
-                                // Set texture resource view of the skybox into the pixel shader
-                                m_immediateContext->PSSetShaderResources(3u, 1u, m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMaterial(uMaterialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
+        if (pVoxel->HasTexture())
+        {
+            for (UINT i = 0u; i < pVoxel->GetNumMeshes(); ++i)
+            {
+                const UINT uMaterialIndex = pVoxel->GetMesh(i).uMaterialIndex;
+                if (pVoxel->GetMaterial(uMaterialIndex)->pDiffuse)
+                {
+                    // Set texture resource view of the renderable into the pixel shader
+                    pContext->PSSetShaderResources(0u, 1u, pVoxel->GetMaterial(uMaterialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
 
-                                // Set sampler state of the skybox into the pixel shader
-                                eTextureSamplerType textureSamplerType = m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMaterial(uMaterialIndex)->pDiffuse->GetSamplerType();
-                                m_immediateContext->PSSetSamplers(3u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-                            }
-                        }
-                    }
+                    // Set sampler state of the renderable into the pixel shader
+                    eTextureSamplerType textureSamplerType = pVoxel->GetMaterial(uMaterialIndex)->pDiffuse->GetSamplerType();
+                    pContext->PSSetSamplers(0u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
+                }
+                if (pVoxel->GetMaterial(uMaterialIndex)->pNormal)
+                {
+                    // Set texture resource view of the renderable into the pixel shader
+                    pContext->PSSetShaderResources(1u, 1u, pVoxel->GetMaterial(uMaterialIndex)->pNormal->GetTextureResourceView().GetAddressOf());
 
-                    // Render the triangles
-                    m_immediateContext->DrawIndexed(model->second->GetMesh(i).uNumIndices,
-                                                    model->second->GetMesh(i).uBaseIndex,
-                                                    model->second->GetMesh(i).uBaseVertex);
+                    // Set sampler state of the renderable into the pixel shader
+                    eTextureSamplerType textureSamplerType = pVoxel->GetMaterial(uMaterialIndex)->pNormal->GetSamplerType();
+                    pContext->PSSetSamplers(1u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
                 }
-            }
-            else
-            {
+
                 // Set texture and sampler state of the shadow map into the pixel shader
-                m_immediateContext->PSSetShaderResources(2u, 1u, m_shadowMapTexture->GetShaderResourceView().GetAddressOf());
-                m_immediateContext->PSSetSamplers(2u, 1u, m_shadowMapTexture->GetSamplerState().GetAddressOf());
+                pContext->PSSetShaderResources(2u, 1u, m_shadowMap->GetShaderResourceView().GetAddressOf());
+                pContext->PSSetSamplers(2u, 1u, m_shadowMap->GetSamplerState().GetAddressOf());
+
+                // Set the cascades of the directional light, sampled with the same comparison sampler
+                pContext->PSSetShaderResources(4u, 1u, m_cascadeShadowMap->GetShaderResourceView().GetAddressOf());
 
-                if (m_scenes[m_pszMainSceneName]->GetSkyBox() != nullptr)
+                if (m_pSkybox != nullptr)
                 {
-                    for (UINT i = 0u; i < m_scenes[m_pszMainSceneName]->GetSkyBox()->GetNumMeshes(); ++i)
+                    for (UINT i = 0u; i < m_pSkybox->GetNumMeshes(); ++i)
                     {
-                        const UINT uMaterialIndex = m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMesh(i).uMaterialIndex;
-                        if (m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMaterial(uMaterialIndex)->pDiffuse)
+                        const UINT uMaterialIndex = m_pSkybox->GetMesh(i).uMaterialIndex;
+                        if (m_pSkybox->GetMaterial(uMaterialIndex)->pDiffuse)
                         {
                             // Set texture resource view of the skybox into the pixel shader
-                            m_immediateContext->PSSetShaderResources(3u, 1u, m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMaterial(uMaterialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
+                            pContext->PSSetShaderResources(3u, 1u, m_pSkybox->GetMaterial(uMaterialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
 
                             // Set sampler state of the skybox into the pixel shader
-                            eTextureSamplerType textureSamplerType = m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMaterial(uMaterialIndex)->pDiffuse->GetSamplerType();
-                            m_immediateContext->PSSetSamplers(3u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
+                            eTextureSamplerType textureSamplerType = m_pSkybox->GetMaterial(uMaterialIndex)->pDiffuse->GetSamplerType();
+                            pContext->PSSetSamplers(3u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
                         }
                     }
                 }
 
                 // Render the triangles
-                m_immediateContext->DrawIndexed(model->second->GetNumIndices(), 0u, 0);
+                pContext->DrawIndexedInstanced(pVoxel->GetMesh(i).uNumIndices,
+                                               pVoxel->GetNumInstances(),
+                                               pVoxel->GetMesh(i).uBaseIndex,
+                                               pVoxel->GetMesh(i).uBaseVertex,
+                                               0u);
             }
         }
-
-        // For skybox
-        if (m_scenes[m_pszMainSceneName]->GetSkyBox() != nullptr)
+        else
         {
-            // Set the vertex buffer
-            UINT uStride = sizeof(SimpleVertex);
-            UINT uOffset = 0u;
-            m_immediateContext->IASetVertexBuffers(0u, 1u, m_scenes[m_pszMainSceneName]->GetSkyBox()->GetVertexBuffer().GetAddressOf(), &uStride, &uOffset);
+            // Set texture and sampler state of the shadow map into the pixel shader
+            pContext->PSSetShaderResources(2u, 1u, m_shadowMap->GetShaderResourceView().GetAddressOf());
+            pContext->PSSetSamplers(2u, 1u, m_shadowMap->GetSamplerState().GetAddressOf());
 
-            // Set the index buffer
-            m_immediateContext->IASetIndexBuffer(m_scenes[m_pszMainSceneName]->GetSkyBox()->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);
-
-            // Set the input layout
-            m_immediateContext->IASetInputLayout(m_scenes[m_pszMainSceneName]->GetSkyBox()->GetVertexLayout().Get());
-
-            // Update renderable constant buffer
-            CBChangesEveryFrame cbChangesEveryFrame =
-            {
-                .World = XMMatrixTranspose(m_scenes[m_pszMainSceneName]->GetSkyBox()->GetWorldMatrix() * XMMatrixTranslationFromVector(m_camera.GetEye())),
-                .OutputColor = m_scenes[m_pszMainSceneName]->GetSkyBox()->GetOutputColor(),
-                .HasNormalMap = m_scenes[m_pszMainSceneName]->GetSkyBox()->HasNormalMap()
-            };
-            m_immediateContext->UpdateSubresource(m_scenes[m_pszMainSceneName]->GetSkyBox()->GetConstantBuffer().Get(), 0u, nullptr, &cbChangesEveryFrame, 0u, 0u);
-
-            // Set the vertex shader and constant buffers
-            m_immediateContext->VSSetShader(m_scenes[m_pszMainSceneName]->GetSkyBox()->GetVertexShader().Get(), nullptr, 0u);
-            m_immediateContext->VSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(2u, 1u, m_scenes[m_pszMainSceneName]->GetSkyBox()->GetConstantBuffer().GetAddressOf());
+            // Set the cascades of the directional light, sampled with the same comparison sampler
+            pContext->PSSetShaderResources(4u, 1u, m_cascadeShadowMap->GetShaderResourceView().GetAddressOf());
 
-            // Set the pixel shader and constant buffers
-            m_immediateContext->PSSetShader(m_scenes[m_pszMainSceneName]->GetSkyBox()->GetPixelShader().Get(), nullptr, 0u);
-
-            if (m_scenes[m_pszMainSceneName]->GetSkyBox()->HasTexture())
+            if (m_pSkybox != nullptr)
             {
-                for (UINT i = 0u; i < m_scenes[m_pszMainSceneName]->GetSkyBox()->GetNumMeshes(); ++i)
+                for (UINT i = 0u; i < m_pSkybox->GetNumMeshes(); ++i)
                 {
-                    const UINT uMaterialIndex = m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMesh(i).uMaterialIndex;
-                    if (m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMaterial(uMaterialIndex)->pDiffuse)
+                    const UINT uMaterialIndex = m_pSkybox->GetMesh(i).uMaterialIndex;
+                    if (m_pSkybox->GetMaterial(uMaterialIndex)->pDiffuse)
                     {
                         // Set texture resource view of the skybox into the pixel shader
-                        m_immediateContext->PSSetShaderResources(0u, 1u, m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMaterial(uMaterialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
+                        pContext->PSSetShaderResources(3u, 1u, m_pSkybox->GetMaterial(uMaterialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
 
                         // Set sampler state of the skybox into the pixel shader
-                        eTextureSamplerType textureSamplerType = m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMaterial(uMaterialIndex)->pDiffuse->GetSamplerType();
-                        m_immediateContext->PSSetSamplers(0u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
+                        eTextureSamplerType textureSamplerType = m_pSkybox->GetMaterial(uMaterialIndex)->pDiffuse->GetSamplerType();
+                        pContext->PSSetSamplers(3u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
                     }
-
-                    // Render the triangles
-                    m_immediateContext->DrawIndexed(m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMesh(i).uNumIndices,
-                                                    m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMesh(i).uBaseIndex,
-                                                    m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMesh(i).uBaseVertex);
                 }
             }
-            else
-            {
-                // Render the triangles
-                m_immediateContext->DrawIndexed(m_scenes[m_pszMainSceneName]->GetSkyBox()->GetNumIndices(), 0u, 0);
-            }
-        }
 
-        // Present the information rendered to the back buffer to the front buffer
-        m_swapChain->Present(0u, 0u);
+            // Render the triangles
+            pContext->DrawIndexedInstanced(pVoxel->GetNumIndices(), pVoxel->GetNumInstances(), 0u, 0, 0u);
+        }
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Renderer::RenderSceneToTexture
+      Method:   Renderer::renderModel
 
-      Summary:  Render scene to the texture
+      Summary:  Render a skinned model
+
+      Args:     RenderContext* pContext
+                  The render context to record the commands to
+                Model* pModel
+                  The model to draw
+                const DrawConstants& drawConstants
+                  Constants of the draw, with skinning constants
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    void Renderer::RenderSceneToTexture()
+    void Renderer::renderModel(_In_ RenderContext* pContext, _In_ Model* pModel, _In_ const DrawConstants& drawConstants)
     {
-        //Unbind current pixel shader resources
-        ID3D11ShaderResourceView* const pSRV[1] = { NULL };
-        m_immediateContext->PSSetShaderResources(0, 1, pSRV);
-        m_immediateContext->PSSetShaderResources(1, 1, pSRV);
-        m_immediateContext->PSSetShaderResources(2, 1, pSRV);
-
-        // Change render target to the shadow map texture
-        m_immediateContext->OMSetRenderTargets(1u, m_shadowMapTexture->GetRenderTargetView().GetAddressOf(), m_depthStencilView.Get());
+        // Set the vertex buffer
+        UINT uStride = sizeof(SimpleVertex);
+        UINT uOffset = 0u;
+        pContext->IASetVertexBuffers(0u, 1u, pModel->GetVertexBuffer().GetAddressOf(), &uStride, &uOffset);
 
-        // Clear render target view with white color
-        m_immediateContext->ClearRenderTargetView(m_shadowMapTexture->GetRenderTargetView().Get(), Colors::White);
+        // Set the normal buffer
+        uStride = sizeof(NormalData);
+        pContext->IASetVertexBuffers(1u, 1u, pModel->GetNormalBuffer().GetAddressOf(), &uStride, &uOffset);
 
-        // Clear depth stencil view
-        m_immediateContext->ClearDepthStencilView(m_depthStencilView.Get(), D3D11_CLEAR_DEPTH, 1.0f, 0u);
+        // Set the animation buffer
+        uStride = sizeof(AnimationData);
+        pContext->IASetVertexBuffers(3u, 1u, pModel->GetAnimationBuffer().GetAddressOf(), &uStride, &uOffset);
 
-        // For all renderables
-        std::unordered_map<std::wstring, std::shared_ptr<Renderable>>::iterator renderable;
-        for (renderable = m_scenes[m_pszMainSceneName]->GetRenderables().begin(); renderable != m_scenes[m_pszMainSceneName]->GetRenderables().end(); ++renderable)
-        {
-            // Bind vertex buffer
-            UINT uStride = sizeof(SimpleVertex);
-            UINT uOffset = 0u;
-            m_immediateContext->IASetVertexBuffers(0u, 1u, renderable->second->GetVertexBuffer().GetAddressOf(), &uStride, &uOffset);
+        // Set the index buffer
+        pContext->IASetIndexBuffer(pModel->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);
 
-            // Bind index buffer
-            m_immediateContext->IASetIndexBuffer(renderable->second->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);
+        // Set the input layout
+        pContext->IASetInputLayout(pModel->GetVertexLayout().Get());
 
-            // Bind input layout
-            m_immediateContext->IASetInputLayout(m_shadowVertexShader->GetVertexLayout().Get());
+        // Set the shaders and constant buffers
+        pContext->VSSetShader(pModel->GetVertexShader().Get(), nullptr, 0u);
+        pContext->PSSetShader(pModel->GetPixelShader().Get(), nullptr, 0u);
+        bindSceneConstantBuffers(pContext, drawConstants);
+        bindLightClusters(pContext);
 
-            // Update shadow matrix constant buffer
-            CBShadowMatrix cbShadowMatrix =
+        if (pModel->HasTexture())
+        {
+            for (UINT i = 0u; i < pModel->GetNumMeshes(); ++i)
             {
-                .World = XMMatrixTranspose(renderable->second->GetWorldMatrix()),
-                .View = XMMatrixTranspose(m_scenes[m_pszMainSceneName]->GetPointLight(0ull)->GetViewMatrix()),
-                .Projection = XMMatrixTranspose(m_scenes[m_pszMainSceneName]->GetPointLight(0ull)->GetProjectionMatrix()),
-                .IsVoxel = FALSE
-            };
-            m_immediateContext->UpdateSubresource(m_cbShadowMatrix.Get(), 0u, nullptr, &cbShadowMatrix, 0u, 0u);
+                const UINT uMaterialIndex = pModel->GetMesh(i).uMaterialIndex;
+                if (pModel->GetMaterial(uMaterialIndex)->pDiffuse)
+                {
+                    // Set texture resource view of the renderable into the pixel shader
+                    pContext->PSSetShaderResources(0u, 1u, pModel->GetMaterial(uMaterialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
+
+                    // Set sampler state of the renderable into the pixel shader
+                    eTextureSamplerType textureSamplerType = pModel->GetMaterial(uMaterialIndex)->pDiffuse->GetSamplerType();
+                    pContext->PSSetSamplers(0u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
+                }
+                if (pModel->GetMaterial(uMaterialIndex)->pNormal)
+                {
+                    // Set texture resource view of the renderable into the pixel shader
+                    pContext->PSSetShaderResources(1u, 1u, pModel->GetMaterial(uMaterialIndex)->pNormal->GetTextureResourceView().GetAddressOf());
 
-            // Bind vertex shader and constant buffer
-            m_immediateContext->VSSetShader(m_shadowVertexShader->GetVertexShader().Get(), nullptr, 0u);
-            m_immediateContext->VSSetConstantBuffers(0u, 1u, m_cbShadowMatrix.GetAddressOf());
+                    // Set sampler state of the renderable into the pixel shader
+                    eTextureSamplerType textureSamplerType = pModel->GetMaterial(uMaterialIndex)->pNormal->GetSamplerType();
+                    pContext->PSSetSamplers(1u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
+                }
 
-            // Bind pixel shader
-            m_immediateContext->PSSetShader(m_shadowPixelShader->GetPixelShader().Get(), nullptr, 0u);
+                // Set texture and sampler state of the shadow map into the pixel shader
+                pContext->PSSetShaderResources(2u, 1u, m_shadowMap->GetShaderResourceView().GetAddressOf());
+                pContext->PSSetSamplers(2u, 1u, m_shadowMap->GetSamplerState().GetAddressOf());
 
-            // Render the triangles
-            if (renderable->second->HasTexture())
-            {
-                for (UINT i = 0; i < renderable->second->GetNumMeshes(); ++i)
+                if (m_pSkybox != nullptr)
                 {
-                    m_immediateContext->DrawIndexed(renderable->second->GetMesh(i).uNumIndices,
-                                                    renderable->second->GetMesh(i).uBaseIndex,
-                                                    renderable->second->GetMesh(i).uBaseVertex);
+                    for (UINT i = 0u; i < m_pSkybox->GetNumMeshes(); ++i)
+                    {
+                        const UINT uMaterialIndex = m_pSkybox->GetMesh(i).uMaterialIndex;
+                        if (m_pSkybox->GetMaterial(uMaterialIndex)->pDiffuse)
+                        {
+                            // Set texture resource view of the skybox into the pixel shader
+                            pContext->PSSetShaderResources(3u, 1u, m_pSkybox->GetMaterial(uMaterialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
+
+                            // Set sampler state of the skybox into the pixel shader
+                            eTextureSamplerType textureSamplerType = m_pSkybox->GetMaterial(uMaterialIndex)->pDiffuse->GetSamplerType();
+                            pContext->PSSetSamplers(3u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
+                        }
+                    }
                 }
+
+                // Render the triangles
+                pContext->DrawIndexed(pModel->GetMesh(i).uNumIndices,
+                                      pModel->GetMesh(i).uBaseIndex,
+                                      pModel->GetMesh(i).uBaseVertex);
             }
-            else
+        }
+        else
+        {
+            // Set texture and sampler state of the shadow map into the pixel shader
+            pContext->PSSetShaderResources(2u, 1u, m_shadowMap->GetShaderResourceView().GetAddressOf());
+            pContext->PSSetSamplers(2u, 1u, m_shadowMap->GetSamplerState().GetAddressOf());
+
+            if (m_pSkybox != nullptr)
             {
-                m_immediateContext->DrawIndexed(renderable->second->GetNumIndices(), 0u, 0);
+                for (UINT i = 0u; i < m_pSkybox->GetNumMeshes(); ++i)
+                {
+                    const UINT uMaterialIndex = m_pSkybox->GetMesh(i).uMaterialIndex;
+                    if (m_pSkybox->GetMaterial(uMaterialIndex)->pDiffuse)
+                    {
+                        // Set texture resource view of the skybox into the pixel shader
+                        pContext->PSSetShaderResources(3u, 1u, m_pSkybox->GetMaterial(uMaterialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
+
+                        // Set sampler state of the skybox into the pixel shader
+                        eTextureSamplerType textureSamplerType = m_pSkybox->GetMaterial(uMaterialIndex)->pDiffuse->GetSamplerType();
+                        pContext->PSSetSamplers(3u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
+                    }
+                }
             }
+
+            // Render the triangles
+            pContext->DrawIndexed(pModel->GetNumIndices(), 0u, 0);
         }
+    }
 
-        // For all voxels in main scene
-        std::vector<std::shared_ptr<Voxel>>::iterator voxel;
-        for (voxel = m_scenes[m_pszMainSceneName]->GetVoxels().begin(); voxel != m_scenes[m_pszMainSceneName]->GetVoxels().end(); ++voxel)
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::renderSkybox
+
+      Summary:  Render the skybox of the main scene around the camera
+
+      Args:     RenderContext* pContext
+                  The render context to record the commands to
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::renderSkybox(_In_ RenderContext* pContext)
+    {
+        // For skybox
+        if (m_pSkybox != nullptr)
         {
-            // Bind vertex buffer
+            // Set the vertex buffer
             UINT uStride = sizeof(SimpleVertex);
             UINT uOffset = 0u;
-            m_immediateContext->IASetVertexBuffers(0u, 1u, voxel->get()->GetVertexBuffer().GetAddressOf(), &uStride, &uOffset);
+            pContext->IASetVertexBuffers(0u, 1u, m_pSkybox->GetVertexBuffer().GetAddressOf(), &uStride, &uOffset);
 
-            // Bind instance buffer
-            uStride = sizeof(InstanceData);
-            m_immediateContext->IASetVertexBuffers(2u, 1u, voxel->get()->GetInstanceBuffer().GetAddressOf(), &uStride, &uOffset);
+            // Set the index buffer
+            pContext->IASetIndexBuffer(m_pSkybox->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);
 
-            // Bind index buffer
-            m_immediateContext->IASetIndexBuffer(voxel->get()->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);
+            // Set the input layout
+            pContext->IASetInputLayout(m_pSkybox->GetVertexLayout().Get());
 
-            // Bind input layout
-            m_immediateContext->IASetInputLayout(m_shadowVertexShader->GetVertexLayout().Get());
+            // Set the shaders and constant buffers
+            pContext->VSSetShader(m_pSkybox->GetVertexShader().Get(), nullptr, 0u);
+            pContext->PSSetShader(m_pSkybox->GetPixelShader().Get(), nullptr, 0u);
+            bindSceneConstantBuffers(pContext, m_skyboxConstants);
 
-            // Update shadow matrix constant buffer
-            CBShadowMatrix cbShadowMatrix =
+            if (m_pSkybox->HasTexture())
             {
-                .World = XMMatrixTranspose(voxel->get()->GetWorldMatrix()),
-                .View = XMMatrixTranspose(m_scenes[m_pszMainSceneName]->GetPointLight(0ull)->GetViewMatrix()),
-                .Projection = XMMatrixTranspose(m_scenes[m_pszMainSceneName]->GetPointLight(0ull)->GetProjectionMatrix()),
-                .IsVoxel = TRUE
-            };
-            m_immediateContext->UpdateSubresource(m_cbShadowMatrix.Get(), 0u, nullptr, &cbShadowMatrix, 0u, 0u);
-
-            // Bind vertex shader and constant buffer
-            m_immediateContext->VSSetShader(m_shadowVertexShader->GetVertexShader().Get(), nullptr, 0u);
-            m_immediateContext->VSSetConstantBuffers(0u, 1u, m_cbShadowMatrix.GetAddressOf());
+                for (UINT i = 0u; i < m_pSkybox->GetNumMeshes(); ++i)
+                {
+                    const UINT uMaterialIndex = m_pSkybox->GetMesh(i).uMaterialIndex;
+                    if (m_pSkybox->GetMaterial(uMaterialIndex)->pDiffuse)
+                    {
+                        // Set texture resource view of the skybox into the pixel shader
+                        pContext->PSSetShaderResources(0u, 1u, m_pSkybox->GetMaterial(uMaterialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
 
-            // Bind pixel shader
-            m_immediateContext->PSSetShader(m_shadowPixelShader->GetPixelShader().Get(), nullptr, 0u);
+                        // Set sampler state of the skybox into the pixel shader
+                        eTextureSamplerType textureSamplerType = m_pSkybox->GetMaterial(uMaterialIndex)->pDiffuse->GetSamplerType();
+                        pContext->PSSetSamplers(0u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
+                    }
 
-            // Render the triangles
-            if (voxel->get()->HasTexture())
-            {
-                for (UINT i = 0; i < voxel->get()->GetNumMeshes(); ++i)
-                {
-                    m_immediateContext->DrawIndexedInstanced(voxel->get()->GetMesh(i).uNumIndices,
-                                                             voxel->get()->GetNumInstances(),
-                                                             voxel->get()->GetMesh(i).uBaseIndex,
-                                                             voxel->get()->GetMesh(i).uBaseVertex,
-                                                             0u);
+                    // Render the triangles
+                    pContext->DrawIndexed(m_pSkybox->GetMesh(i).uNumIndices,
+                                          m_pSkybox->GetMesh(i).uBaseIndex,
+                                          m_pSkybox->GetMesh(i).uBaseVertex);
                 }
             }
             else
             {
-                m_immediateContext->DrawIndexedInstanced(voxel->get()->GetNumIndices(), voxel->get()->GetNumInstances(), 0u, 0, 0u);
+                // Render the triangles
+                pContext->DrawIndexed(m_pSkybox->GetNumIndices(), 0u, 0);
             }
         }
+    }
 
-        // For all models
-        std::unordered_map<std::wstring, std::shared_ptr<Model>>::iterator model;
-        for (model = m_scenes[m_pszMainSceneName]->GetModels().begin(); model != m_scenes[m_pszMainSceneName]->GetModels().end(); ++model)
-        {
-            // Bind vertex buffer
-            UINT uStride = sizeof(SimpleVertex);
-            UINT uOffset = 0u;
-            m_immediateContext->IASetVertexBuffers(0u, 1u, model->second->GetVertexBuffer().GetAddressOf(), &uStride, &uOffset);
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::renderDeferredLighting
+
+      Summary:  Light the G-buffer with one triangle covering the
+                screen. It shades with the same lights, cascades and
+                clusters as the forward voxels, bound to the same
+                slots, and reads the G-buffer from the slots 8 to 10
 
-            // Bind index buffer
-            m_immediateContext->IASetIndexBuffer(model->second->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);
+      Args:     RenderContext* pContext
+                  The render context to record the commands to
+                ID3D11ShaderResourceView* const* apGBufferViews
+                  Albedo, normal and depth of the G-buffer
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::renderDeferredLighting(_In_ RenderContext* pContext, _In_reads_(NUM_GBUFFER_TARGETS + 1) ID3D11ShaderResourceView* const* apGBufferViews)
+    {
+        // The vertices are made from their index
+        pContext->IASetInputLayout(nullptr);
 
-            // Bind input layout
-            m_immediateContext->IASetInputLayout(m_shadowVertexShader->GetVertexLayout().Get());
+        // Set the shaders and the frame constants, the lighting pass has no object constants
+        pContext->VSSetShader(m_deferredLightingVertexShader->GetVertexShader().Get(), nullptr, 0u);
+        pContext->PSSetShader(m_deferredLightingPixelShader->GetPixelShader().Get(), nullptr, 0u);
 
-            // Update shadow matrix constant buffer
-            CBShadowMatrix cbShadowMatrix =
-            {
-                .World = XMMatrixTranspose(model->second->GetWorldMatrix()),
-                .View = XMMatrixTranspose(m_scenes[m_pszMainSceneName]->GetPointLight(0ull)->GetViewMatrix()),
-                .Projection = XMMatrixTranspose(m_scenes[m_pszMainSceneName]->GetPointLight(0ull)->GetProjectionMatrix()),
-                .IsVoxel = FALSE
-            };
-            m_immediateContext->UpdateSubresource(m_cbShadowMatrix.Get(), 0u, nullptr, &cbShadowMatrix, 0u, 0u);
+        const UINT auSlots[] = { 0u, 1u, 3u, 5u, 6u };
+        const ConstantBufferAllocation aAllocations[] =
+        {
+            m_frameConstants.Camera,
+            m_frameConstants.Projection,
+            m_frameConstants.Lights,
+            m_frameConstants.Cascades,
+            m_frameConstants.Clusters
+        };
+        for (UINT i = 0u; i < ARRAYSIZE(aAllocations); ++i)
+        {
+            const UINT uFirstConstant = m_constantBufferRing.GetFirstConstant(aAllocations[i]);
+            const UINT uNumConstants = ConstantBufferRing::GetNumConstants(aAllocations[i]);
+            pContext->PSSetConstantBuffers1(auSlots[i], 1u, m_cbFrame.GetAddressOf(), &uFirstConstant, &uNumConstants);
+        }
 
-            // Bind vertex shader and constant buffer
-            m_immediateContext->VSSetShader(m_shadowVertexShader->GetVertexShader().Get(), nullptr, 0u);
-            m_immediateContext->VSSetConstantBuffers(0u, 1u, m_cbShadowMatrix.GetAddressOf());
+        // Set the cascades of the directional light with their comparison sampler, the clusters and the G-buffer
+        pContext->PSSetShaderResources(4u, 1u, m_cascadeShadowMap->GetShaderResourceView().GetAddressOf());
+        pContext->PSSetSamplers(2u, 1u, m_cascadeShadowMap->GetSamplerState().GetAddressOf());
+        bindLightClusters(pContext);
+        pContext->PSSetShaderResources(8u, NUM_GBUFFER_TARGETS + 1u, apGBufferViews);
 
-            // Bind pixel shader
-            m_immediateContext->PSSetShader(m_shadowPixelShader->GetPixelShader().Get(), nullptr, 0u);
+        // Render the triangle
+        pContext->Draw(3u, 0u);
+    }
 
-            // Render the triangles
-            if (model->second->HasTexture())
-            {
-                for (UINT i = 0; i < model->second->GetNumMeshes(); ++i)
-                {
-                    m_immediateContext->DrawIndexed(model->second->GetMesh(i).uNumIndices,
-                                                    model->second->GetMesh(i).uBaseIndex,
-                                                    model->second->GetMesh(i).uBaseVertex);
-                }
-            }
-            else
-            {
-                m_immediateContext->DrawIndexed(model->second->GetNumIndices(), 0u, 0);
-            }
-        }
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::SetDriverType
 
-        // Reset the render target to the original back buffer
-        m_immediateContext->OMSetRenderTargets(1u, m_renderTargetView.GetAddressOf(), m_depthStencilView.Get());
+      Summary:  Set the only driver type the device is created with.
+                Set before Initialize, D3D_DRIVER_TYPE_UNKNOWN tries
+                the hardware, WARP and reference drivers in this order
+
+      Args:     D3D_DRIVER_TYPE driverType
+                  Driver type to create the device with
+
+      Modifies: [m_requestedDriverType].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::SetDriverType(_In_ D3D_DRIVER_TYPE driverType)
+    {
+        m_requestedDriverType = driverType;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -14,19 +14,148 @@
 #include "Common.h"
 
 #include "Camera/Camera.h"
+#include "Light/LightClusters.h"
 #include "Light/PointLight.h"
+#include "Light/ShadowCascades.h"
 #include "Model/Model.h"
+#include "Profiler/D3D11GpuTimerBackend.h"
+#include "Profiler/GpuProfiler.h"
+#include "Profiler/Profiler.h"
+#include "Renderer/CommandRecorder.h"
+#include "Renderer/ConstantBufferRing.h"
+#include "Renderer/D3D11RenderContext.h"
 #include "Renderer/DataTypes.h"
+#include "Renderer/DeferredCommandRecorder.h"
+#include "Renderer/FrameGraph.h"
+#include "Renderer/OcclusionCuller.h"
+#include "Renderer/OverdrawEstimator.h"
 #include "Renderer/Renderable.h"
+#include "Renderer/RenderStats.h"
 #include "Scene/Scene.h"
+#include "Shader/FullscreenVertexShader.h"
 #include "Shader/PixelShader.h"
 #include "Shader/VertexShader.h"
 #include "Window/MainWindow.h"
-#include "Texture/RenderTexture.h"
+#include "Texture/ShadowMap.h"
+#include "Texture/TextureStreamer.h"
 #include "Shader/ShadowVertexShader.h"
 
 namespace library
 {
+    /*E+E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E
+      Enum:     eRenderPath
+
+      Summary:  How the voxels are lit. FORWARD shades them in their
+                own pixel shader, DEFERRED writes their surface to a
+                G-buffer and lights every pixel once in a full screen
+                pass. Renderables, models and the skybox are always
+                forward
+    E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E-E*/
+    enum class eRenderPath
+    {
+        FORWARD,
+        DEFERRED,
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   FrameConstants
+
+      Summary:  Ranges of the constants shared by every draw of a
+                frame in the frame constant buffer. ShadowLights holds
+                the view and projection of every light for its shadow
+                pass, CascadeLights the ones of every cascade of the
+                directional light. Cascades holds what the scene
+                passes need to sample the cascades, Clusters what they
+                need to find the cluster of a pixel. DepthPrepass holds
+                the view and projection of the camera for the depth
+                pre-pass, which draws with the shadow vertex shader
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct FrameConstants
+    {
+        ConstantBufferAllocation Camera;
+        ConstantBufferAllocation Projection;
+        ConstantBufferAllocation Lights;
+        ConstantBufferAllocation ShadowLights[NUM_LIGHTS];
+        ConstantBufferAllocation Cascades;
+        ConstantBufferAllocation CascadeLights[NUM_CASCADES];
+        ConstantBufferAllocation Clusters;
+        ConstantBufferAllocation DepthPrepass;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   DrawConstants
+
+      Summary:  Ranges of the constants of one object in the frame
+                constant buffer. Skinning is empty for objects that are
+                not skinned models
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct DrawConstants
+    {
+        ConstantBufferAllocation Object;
+        ConstantBufferAllocation Shadow;
+        ConstantBufferAllocation Skinning;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   ShadowLightState
+
+      Summary:  Shadow map state of one light. aCasters indexes the
+                renderables, voxels and models, in this order, that
+                are inside the frustum and the influence of the light.
+                The versions are the ones the slice was last rendered
+                with, so an unchanged light with unchanged casters
+                keeps its slice
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct ShadowLightState
+    {
+        std::vector<UINT> aCasters;
+        UINT64 uLightVersion;
+        UINT64 uCastersVersion;
+        UINT uNumCasters;
+        UINT uLastUpdateFrame;
+        BOOL bVisible;
+        BOOL bRendered;
+        BOOL bScheduled;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   ShadowCascadeState
+
+      Summary:  Shadow map state of one cascade of the directional
+                light. aCasters indexes the renderables, voxels and
+                models, in this order, that intersect the bounds of
+                the cascade. The versions are the ones the slice was
+                last rendered with, a cascade whose snapped projection
+                and casters did not change keeps its slice
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct ShadowCascadeState
+    {
+        std::vector<UINT> aCasters;
+        UINT64 uVersion;
+        UINT64 uCastersVersion;
+        UINT uNumCasters;
+        BOOL bRendered;
+        BOOL bScheduled;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   PassState
+
+      Summary:  Output state a pass draws with. The render targets
+                end at the first null one, depth only passes have none
+                and the G-buffer pass uses all of them. A null
+                rasterizer or depth stencil state selects the default
+                one
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct PassState
+    {
+        ID3D11RenderTargetView* apRenderTargetViews[NUM_GBUFFER_TARGETS];
+        ID3D11DepthStencilView* pDepthStencilView;
+        const D3D11_VIEWPORT* pViewport;
+        ID3D11RasterizerState* pRasterizerState;
+        ID3D11DepthStencilState* pDepthStencilState;
+    };
+
     /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
       Class:    Renderer
 
@@ -35,12 +164,51 @@ namespace library
 
       Methods:  Initialize
                   Creates Direct3D device and swap chain
+                InitializeHeadless
+                  Sets up the renderer without a device
                 AddRenderable
                   Add a renderable object and initialize the object
                 Update
                   Update the renderables each frame
                 Render
-                  Renders the frame
+                  Renders the frame by executing the frame graph
+                RenderHeadless
+                  Records the frame to a render context without
+                  presenting
+                SetShadowMapVertexShader
+                  Sets the vertex shader of the shadow pass
+                SetShadowMapResolution
+                  Sets the size and depth format of the shadow map
+                SetShadowBudget
+                  Sets how many shadow maps are rendered per frame
+                GetShadowCascades
+                  Returns the cascades of the directional light
+                SetRenderPath
+                  Sets whether the voxels are lit forward or deferred
+                GetRenderPath
+                  Returns how the voxels are lit
+                SetDeferredShaders
+                  Sets the shaders of the deferred path
+                SetDepthPrepass
+                  Sets which passes draw over a depth pre-pass
+                SetOcclusionCulling
+                  Sets whether hidden voxels and models are skipped
+                SetTextureStreamingBudget
+                  Sets the bytes the streamed texture mips may take
+                SetCommandRecorder
+                  Sets the recorder that splits large passes across
+                  worker threads
+                GetRenderStats
+                  Returns the counters of the last rendered frame
+                GetFrameGraph
+                  Returns the frame graph of the render passes
+                SetRenderStatsDumpInterval
+                  Sets how often the counters are written to the
+                  debug output
+                DumpRenderStats
+                  Writes the counters to the debug output
+                SetDriverType
+                  Sets the only Direct3D driver type Initialize tries
                 GetDriverType
                   Returns the Direct3D driver type
                 Renderer
@@ -59,21 +227,95 @@ namespace library
         ~Renderer() = default;
 
         HRESULT Initialize(_In_ HWND hWnd);
+        HRESULT InitializeHeadless(_In_ UINT uWidth, _In_ UINT uHeight);
 
         HRESULT AddScene(_In_ PCWSTR pszSceneName, _In_ const std::shared_ptr<Scene>& scene);
         std::shared_ptr<Scene> GetSceneOrNull(_In_ PCWSTR pszSceneName);
         HRESULT SetMainScene(_In_ PCWSTR pszSceneName);
-        void SetShadowMapShaders(_In_ std::shared_ptr<ShadowVertexShader> vertexShader, _In_ std::shared_ptr<PixelShader> pixelShader);
+        void SetShadowMapVertexShader(_In_ std::shared_ptr<ShadowVertexShader> vertexShader);
+        HRESULT SetShadowMapResolution(_In_ UINT uSize, _In_ DXGI_FORMAT depthFormat);
+        void SetShadowBudget(_In_ UINT uNumShadowMaps);
+        ShadowCascades& GetShadowCascades();
+        void SetRenderPath(_In_ eRenderPath renderPath);
+        eRenderPath GetRenderPath() const;
+        void SetDeferredShaders(
+            _In_ std::shared_ptr<PixelShader> voxelGBufferPixelShader,
+            _In_ std::shared_ptr<FullscreenVertexShader> lightingVertexShader,
+            _In_ std::shared_ptr<PixelShader> lightingPixelShader
+        );
+        void SetDepthPrepass(_In_ BOOL bVoxels, _In_ BOOL bModels);
+        void SetOcclusionCulling(_In_ BOOL bEnabled);
+        void SetTextureStreamingBudget(_In_ UINT64 uBudget);
 
         void HandleInput(_In_ const DirectionsInput& directions, _In_ const MouseRelativeMovement& mouseRelativeMovement, _In_ FLOAT deltaTime);
         void Update(_In_ FLOAT deltaTime);
         void Render();
-        void RenderSceneToTexture();
+        void RenderHeadless(_In_ RenderContext* pContext);
 
+        void SetCommandRecorder(_In_ std::unique_ptr<CommandRecorder> commandRecorder);
+
+        const RenderStats& GetRenderStats() const;
+        const FrameGraph& GetFrameGraph() const;
+        void SetRenderStatsDumpInterval(_In_ UINT uNumFrames);
+        void DumpRenderStats() const;
+
+        void SetDriverType(_In_ D3D_DRIVER_TYPE driverType);
         D3D_DRIVER_TYPE GetDriverType() const;
 
+    private:
+        HRESULT initializeFrameGraph(_In_ UINT uWidth, _In_ UINT uHeight);
+        void updateDrawLists();
+        void updateShadows();
+        void updateCascades();
+        void updateClusters();
+        void updateOcclusion();
+        void updateTextureStreaming();
+        void updateDepthPrepass();
+        ID3D11DepthStencilState* getSceneDepthStencilState(_In_ BOOL bDepthPrepass) const;
+        void uploadClusters(_In_ RenderContext* pContext);
+        HRESULT createStructuredBuffer(
+            _In_ UINT uStride,
+            _In_ UINT uNumElements,
+            _Out_ ComPtr<ID3D11Buffer>& outBuffer,
+            _Out_ ComPtr<ID3D11ShaderResourceView>& outShaderResourceView
+        );
+        UINT64 getCastersVersion(_In_ const std::vector<UINT>& aCasters) const;
+        void collectRenderStats(_In_ RenderContext* pContext);
+        void bindPassState(_In_ RenderContext* pContext, _In_ const PassState& passState);
+        void recordDraws(
+            _In_ RenderContext* pContext,
+            _In_ const PassState& passState,
+            _In_ UINT uNumDraws,
+            _In_ const CommandRecorder::RecordFunction& record
+        );
+        void updateConstantBuffers(_In_ RenderContext* pContext);
+        void allocateConstants();
+        void placeConstants();
+        void allocateDrawConstants(_In_ Renderable* pRenderable, _In_ BOOL bIsVoxel, _Inout_ DrawConstants& drawConstants);
+        void bindSceneConstantBuffers(_In_ RenderContext* pContext, _In_ const DrawConstants& drawConstants);
+        void bindLightClusters(_In_ RenderContext* pContext);
+        void bindShadowConstantBuffers(_In_ RenderContext* pContext, _In_ const DrawConstants& drawConstants, _In_ const ConstantBufferAllocation& lightConstants);
+        void renderCasters(
+            _In_ RenderContext* pContext,
+            _In_ const PassState& passState,
+            _In_ const std::vector<UINT>& aCasters,
+            _In_ const ConstantBufferAllocation& lightConstants
+        );
+        void renderShadow(_In_ RenderContext* pContext, _In_ Renderable* pRenderable, _In_ const DrawConstants& drawConstants, _In_ const ConstantBufferAllocation& lightConstants);
+        void renderVoxelShadow(_In_ RenderContext* pContext, _In_ Voxel* pVoxel, _In_ const DrawConstants& drawConstants, _In_ const ConstantBufferAllocation& lightConstants);
+        void renderRenderable(_In_ RenderContext* pContext, _In_ Renderable* pRenderable, _In_ const DrawConstants& drawConstants);
+        void renderVoxel(_In_ RenderContext* pContext, _In_ Voxel* pVoxel, _In_ const DrawConstants& drawConstants);
+        void renderModel(_In_ RenderContext* pContext, _In_ Model* pModel, _In_ const DrawConstants& drawConstants);
+        void renderSkybox(_In_ RenderContext* pContext);
+        void renderDeferredLighting(_In_ RenderContext* pContext, _In_reads_(NUM_GBUFFER_TARGETS + 1) ID3D11ShaderResourceView* const* apGBufferViews);
+
+    private:
+        // Initial number of lights and light indices of the cluster buffers, they double when too small
+        static constexpr UINT INITIAL_CLUSTER_BUFFER_SIZE = 1024u;
+
     private:
         D3D_DRIVER_TYPE m_driverType;
+        D3D_DRIVER_TYPE m_requestedDriverType;
         D3D_FEATURE_LEVEL m_featureLevel;
         ComPtr<ID3D11Device> m_d3dDevice;
         ComPtr<ID3D11Device1> m_d3dDevice1;
@@ -82,20 +324,76 @@ namespace library
         ComPtr<IDXGISwapChain> m_swapChain;
         ComPtr<IDXGISwapChain1> m_swapChain1;
         ComPtr<ID3D11RenderTargetView> m_renderTargetView;
-        ComPtr<ID3D11Texture2D> m_depthStencil;
-        ComPtr<ID3D11DepthStencilView> m_depthStencilView;
-        ComPtr<ID3D11Buffer> m_cbChangeOnResize;
-        ComPtr<ID3D11Buffer> m_cbLights;
-        ComPtr<ID3D11Buffer> m_cbShadowMatrix;
-        PCWSTR m_pszMainSceneName;
+        ComPtr<ID3D11Buffer> m_cbFrame;
+        Scene* m_pMainScene;
         BYTE m_padding[8];
         Camera m_camera;
         XMMATRIX m_projection;
 
         std::unordered_map<std::wstring, std::shared_ptr<Scene>> m_scenes;
         std::shared_ptr<Texture> m_invalidTexture;
-        std::shared_ptr<RenderTexture> m_shadowMapTexture;
+        std::shared_ptr<ShadowMap> m_shadowMap;
+        UINT m_uShadowMapSize;
+        DXGI_FORMAT m_shadowMapFormat;
         std::shared_ptr<ShadowVertexShader> m_shadowVertexShader;
-        std::shared_ptr<PixelShader> m_shadowPixelShader;
+        ShadowLightState m_aShadowLights[NUM_LIGHTS];
+        UINT m_uShadowBudget;
+        UINT64 m_uShadowVersion;
+        std::shared_ptr<ShadowMap> m_cascadeShadowMap;
+        ShadowCascades m_shadowCascades;
+        ShadowCascadeState m_aCascades[NUM_CASCADES];
+        std::unique_ptr<LightClusters> m_lightClusters;
+        std::vector<ClusterLight> m_aClusterLights;
+        UINT64 m_uClusterLightsVersion;
+        UINT64 m_uClustersVersion;
+        BOOL m_bClusterLightsDirty;
+        BOOL m_bClustersDirty;
+        ComPtr<ID3D11Buffer> m_clusterLightBuffer;
+        ComPtr<ID3D11ShaderResourceView> m_clusterLightView;
+        UINT m_uClusterLightCapacity;
+        ComPtr<ID3D11Buffer> m_clusterRangeBuffer;
+        ComPtr<ID3D11ShaderResourceView> m_clusterRangeView;
+        ComPtr<ID3D11Buffer> m_clusterIndexBuffer;
+        ComPtr<ID3D11ShaderResourceView> m_clusterIndexView;
+        UINT m_uClusterIndexCapacity;
+        eRenderPath m_renderPath;
+        std::shared_ptr<PixelShader> m_voxelGBufferPixelShader;
+        std::shared_ptr<FullscreenVertexShader> m_deferredLightingVertexShader;
+        std::shared_ptr<PixelShader> m_deferredLightingPixelShader;
+        ComPtr<ID3D11DepthStencilState> m_depthEqualState;
+        BOOL m_bDepthPrepassVoxels;
+        BOOL m_bDepthPrepassModels;
+        std::vector<UINT> m_aDepthPrepassObjects;
+        OverdrawEstimator m_overdrawEstimator;
+        std::unique_ptr<OcclusionCuller> m_occlusionCuller;
+        BOOL m_bOcclusionCulling;
+        std::vector<BoundingBox> m_aOccluders;
+        UINT64 m_uOccludersVersion;
+        UINT m_uNumOccluderVoxels;
+        std::vector<BYTE> m_aVoxelVisible;
+        std::vector<BYTE> m_aModelVisible;
+        std::unique_ptr<TextureStreamer> m_textureStreamer;
+        UINT64 m_uTextureStreamingBudget;
+
+        FrameGraph m_frameGraph;
+        std::unique_ptr<CommandRecorder> m_commandRecorder;
+        BOOL m_bHasCommandRecorder;
+        std::vector<Renderable*> m_aRenderableDrawList;
+        std::vector<Voxel*> m_aVoxelDrawList;
+        std::vector<Model*> m_aModelDrawList;
+        Skybox* m_pSkybox;
+        D3D11_VIEWPORT m_viewport;
+        std::unique_ptr<D3D11RenderContext> m_renderContext;
+        std::unique_ptr<GpuProfiler> m_gpuProfiler;
+        RenderStats m_renderStats;
+        UINT m_uRenderStatsDumpInterval;
+        UINT m_uNumRenderedFrames;
+        ConstantBufferRing m_constantBufferRing;
+        BOOL m_bCanMapNoOverwrite;
+        FrameConstants m_frameConstants;
+        std::vector<DrawConstants> m_aRenderableConstants;
+        std::vector<DrawConstants> m_aVoxelConstants;
+        std::vector<DrawConstants> m_aModelConstants;
+        DrawConstants m_skyboxConstants;
     };
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "Renderer/Skybox.h"
 
+#include "Texture/TextureCache.h"
+
 #include "assimp/Importer.hpp"	// C++ importer interface
 #include "assimp/scene.h"		// output data structure
 #include "assimp/postprocess.h"	// post processing flags
@@ -26,6 +28,33 @@ namespace library
         // empty
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Skybox::Load
+
+      Summary:  Loads the sphere model and reads the cube map texture
+
+      Modifies: [m_aMaterials].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Skybox::Load()
+    {
+        HRESULT hr = Model::Load();
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        // Set the first (0th) material's diffuse texture by the m_cubeMapFileName
+        m_aMaterials[0]->pDiffuse = TextureCache::GetTexture(m_cubeMapFileName, eTextureSamplerType::TRILINEAR_CLAMP);
+
+        // A texture that could not be read here is loaded from the file by Initialize
+        m_aMaterials[0]->pDiffuse->Load();
+
+        return hr;
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Skybox::Initialize
 
@@ -36,7 +65,7 @@ namespace library
                 ID3D11DeviceContext* pImmediateContext
                   The Direct3D context to set buffers
 
-      Modifies: [m_aMeshes, m_aMaterials].
+      Modifies: [m_aMeshes].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     HRESULT Skybox::Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext)
     {
@@ -44,6 +73,10 @@ namespace library
 
         // Call parent's initialize method
         hr = Model::Initialize(pDevice, pImmediateContext);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
 
         // Scale
         Scale(m_scale, m_scale, m_scale);
@@ -51,8 +84,7 @@ namespace library
         // Set the first meshs material index to 0
         m_aMeshes[0].uMaterialIndex = 0u;
 
-        // Set and initialize the first (0th) materials diffuse texture by the m_cubeMapFileName
-        m_aMaterials[0]->pDiffuse = std::make_shared<Texture>(m_cubeMapFileName, eTextureSamplerType::TRILINEAR_CLAMP);
+        // The cube map texture is already created by the parent unless it failed
         hr = m_aMaterials[0]->pDiffuse->Initialize(pDevice, pImmediateContext);
         if (SUCCEEDED(hr))
         {
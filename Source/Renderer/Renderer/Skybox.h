@@ -27,6 +27,7 @@ namespace library
         Skybox& operator=(Skybox&& other) = delete;
         ~Skybox() = default;
 
+        virtual HRESULT Load() override;
         virtual HRESULT Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext) override;
         //virtual void Update(_In_ FLOAT deltaTime, _In_ const XMVECTOR& lightPosition);
 
@@ -0,0 +1,22 @@
+#include "Renderer/VersionCounter.h"
+
+namespace library
+{
+    std::atomic<UINT64> VersionCounter::sm_uLastVersion = 0u;
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VersionCounter::Next
+
+      Summary:  Returns a new version. 0 is never returned, so it
+                stands for nothing cached yet
+
+      Modifies: [sm_uLastVersion].
+
+      Returns:  UINT64
+                  Version newer than every earlier one
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 VersionCounter::Next()
+    {
+        return sm_uLastVersion.fetch_add(1u, std::memory_order_relaxed) + 1u;
+    }
+}
\ No newline at end of file
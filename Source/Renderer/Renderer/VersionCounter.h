@@ -0,0 +1,49 @@
+/*+===================================================================
+  File:      VERSIONCOUNTER.H
+
+  Summary:   VersionCounter header file contains declaration of class
+             VersionCounter that hands out the versions of every
+             object the renderer caches derived data of.
+
+  Classes: VersionCounter
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include <atomic>
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    VersionCounter
+
+      Summary:  Global monotonic counter the renderables, cameras,
+                lights and shadow cascades take a new version from
+                whenever they change. No two changes share a version
+                and a change is always newer than every version handed
+                out before, so the newest version of a group of owners
+                changes with any of them. Safe to use from the loader
+                threads
+
+      Methods:  Next
+                  Returns a version newer than all earlier ones
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class VersionCounter
+    {
+    public:
+        VersionCounter() = delete;
+        VersionCounter(const VersionCounter& other) = delete;
+        VersionCounter(VersionCounter&& other) = delete;
+        VersionCounter& operator=(const VersionCounter& other) = delete;
+        VersionCounter& operator=(VersionCounter&& other) = delete;
+        ~VersionCounter() = delete;
+
+        static UINT64 Next();
+
+    private:
+        static std::atomic<UINT64> sm_uLastVersion;
+    };
+}
\ No newline at end of file
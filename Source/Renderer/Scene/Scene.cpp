@@ -1,6 +1,11 @@
 #include "Scene/Scene.h"
 
+#include <unordered_set>
+
+#include "Renderer/AssetLoader.h"
+#include "Shader/ShaderCache.h"
 #include "Shader/SkyMapVertexShader.h"
+#include "Texture/TextureCache.h"
 
 namespace library
 {
@@ -28,7 +33,14 @@ namespace library
         : m_filePath(filePath)
         , m_voxels()
         , m_renderables()
+        , m_models()
+        , m_renderableNames()
+        , m_modelNames()
+        , m_transforms()
+        , m_aTransformAttachments()
         , m_aPointLights{ nullptr, }
+        , m_aLocalLights()
+        , m_directionalLight()
         , m_vertexShaders()
         , m_pixelShaders()
         , m_skyBox()
@@ -58,6 +70,7 @@ namespace library
             }
         }
 
+        std::vector<XMFLOAT4> aColors;
         UINT uColorIdx = 0u;
         XMFLOAT4 color;
         while (!inputFile.eof() && uColorIdx < aDimension[3])
@@ -76,20 +89,16 @@ namespace library
             else
             {
                 color.w = 1.0f;
-                m_voxels.push_back(std::make_shared<Voxel>(color));
+                aColors.push_back(color);
                 ++uColorIdx;
             }
         }
 
-        std::vector<std::vector<InstanceData>> aInstanceData;
-        aInstanceData.reserve(m_voxels.size());
-        for (UINT renderableIdx = 0u; renderableIdx < m_voxels.size(); ++renderableIdx)
-        {
-            aInstanceData.push_back(std::vector<InstanceData>());
-            aInstanceData.back().reserve(
-                static_cast<size_t>(aDimension[0]) * static_cast<size_t>(aDimension[1]) * static_cast<size_t>(aDimension[2])
-            );
-        }
+        // The columns are split into square chunks with a voxel per color each, so that a shadow cascade
+        // only draws the chunks it covers instead of every instance of a color
+        const UINT uNumChunksX = (aDimension[0] + VOXEL_CHUNK_SIZE - 1u) / VOXEL_CHUNK_SIZE;
+        const UINT uNumChunksZ = (aDimension[2] + VOXEL_CHUNK_SIZE - 1u) / VOXEL_CHUNK_SIZE;
+        std::vector<std::vector<InstanceData>> aInstanceData(static_cast<size_t>(uNumChunksX) * static_cast<size_t>(uNumChunksZ) * aColors.size());
 
         UINT uDepthIdx = 0u;
         UINT uWidthIdx = 0u;
@@ -110,9 +119,11 @@ namespace library
             }
             else if (static_cast<CHAR>(eBlockType::GRASSLAND) <= voxelType && voxelType < static_cast<CHAR>(eBlockType::COUNT))
             {
+                const size_t uChunkIdx = static_cast<size_t>(uDepthIdx / VOXEL_CHUNK_SIZE) * static_cast<size_t>(uNumChunksX) + static_cast<size_t>(uWidthIdx / VOXEL_CHUNK_SIZE);
+                const size_t uInstanceDataIdx = uChunkIdx * aColors.size() + static_cast<size_t>(voxelType) - static_cast<size_t>(eBlockType::GRASSLAND);
                 for (UINT heightIdx = 0; heightIdx < static_cast<UINT>(static_cast<float>(aDimension[1]) * height); ++heightIdx)
                 {
-                    aInstanceData[static_cast<size_t>(voxelType) - static_cast<size_t>(eBlockType::GRASSLAND)].push_back(
+                    aInstanceData[uInstanceDataIdx].push_back(
                         InstanceData
                         {
                             .Transformation = XMMatrixTranslation(
@@ -139,20 +150,12 @@ namespace library
 
         inputFile.close();
 
-        UINT uVoxelIdx = 0u;
-        auto it = m_voxels.begin();
-        while (it != m_voxels.end())
+        for (size_t uVoxelIdx = 0u; uVoxelIdx < aInstanceData.size(); ++uVoxelIdx)
         {
-            if (aInstanceData[uVoxelIdx].size() <= 0)
-            {
-                it = m_voxels.erase(it);
-            }
-            else
+            if (aInstanceData[uVoxelIdx].size() > 0)
             {
-                (*it)->SetInstanceData(std::move(aInstanceData[uVoxelIdx]));
-                ++it;
+                m_voxels.Add(std::make_shared<Voxel>(std::move(aInstanceData[uVoxelIdx]), aColors[uVoxelIdx % aColors.size()]));
             }
-            ++uVoxelIdx;
         }
     }
 
@@ -160,7 +163,9 @@ namespace library
       Method:   Scene::Initialize
 
       Summary:  Initializes the voxels, shaders, renderables, models, 
-                and skybox
+                and skybox. Shaders are compiled and models and
+                textures are read on worker threads before the GPU
+                resources are created on the calling thread
 
       Args:     ID3D11Device* pDevice
                   The Direct3D device to create the buffers
@@ -169,59 +174,100 @@ namespace library
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     HRESULT Scene::Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext)
     {
-        for (auto voxel : m_voxels)
+        LARGE_INTEGER Frequency;
+        LARGE_INTEGER StartTime;
+        LARGE_INTEGER EndTime;
+        QueryPerformanceFrequency(&Frequency);
+        QueryPerformanceCounter(&StartTime);
+
+        AssetLoader loader;
+        std::vector<std::future<HRESULT>> aFutures;
+
+        // Compile the shaders and read the models on the worker threads, the device is free-threaded
+        for (auto it = m_vertexShaders.begin(); it != m_vertexShaders.end(); ++it)
         {
-            HRESULT hr = voxel->Initialize(pDevice, pImmediateContext);
-            if (FAILED(hr))
+            std::shared_ptr<VertexShader> vertexShader = it->second;
+            aFutures.push_back(loader.Submit([vertexShader, pDevice] { return vertexShader->Initialize(pDevice); }));
+        }
+
+        for (auto it = m_pixelShaders.begin(); it != m_pixelShaders.end(); ++it)
+        {
+            std::shared_ptr<PixelShader> pixelShader = it->second;
+            aFutures.push_back(loader.Submit([pixelShader, pDevice] { return pixelShader->Initialize(pDevice); }));
+        }
+
+        for (Model* pModel : m_models.GetObjects())
+        {
+            aFutures.push_back(loader.Submit([pModel] { return pModel->Load(); }));
+        }
+
+        if (m_skyBox != nullptr)
+        {
+            std::shared_ptr<Skybox> skyBox = m_skyBox;
+            aFutures.push_back(loader.Submit([skyBox] { return skyBox->Load(); }));
+        }
+
+        HRESULT hr = AssetLoader::WaitAll(aFutures);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        // Decode the textures of every material once the models know them
+        for (Model* pModel : m_models.GetObjects())
+        {
+            for (UINT i = 0u; i < pModel->GetNumMaterials(); ++i)
             {
-                return hr;
+                AddMaterial(pModel->GetMaterial(i));
             }
         }
 
-        for (auto it = m_vertexShaders.begin(); it != m_vertexShaders.end(); ++it)
+        std::unordered_set<Texture*> textures;
+        for (auto it = m_materials.begin(); it != m_materials.end(); ++it)
         {
-            HRESULT hr = it->second->Initialize(pDevice);
-            if (FAILED(hr))
+            for (Texture* pTexture : { it->second->pDiffuse.get(), it->second->pSpecularExponent.get(), it->second->pNormal.get() })
             {
-                return hr;
+                if (pTexture && textures.insert(pTexture).second)
+                {
+                    aFutures.push_back(loader.Submit([pTexture] { return pTexture->Load(); }));
+                }
             }
         }
 
-        for (auto it = m_pixelShaders.begin(); it != m_pixelShaders.end(); ++it)
+        // A texture that could not be read is loaded from the file by its Initialize, which reports the error
+        AssetLoader::WaitAll(aFutures);
+
+        // Create the GPU resources on this thread, the immediate context is not thread-safe
+        for (Voxel* pVoxel : m_voxels.GetObjects())
         {
-            HRESULT hr = it->second->Initialize(pDevice);
+            hr = pVoxel->Initialize(pDevice, pImmediateContext);
             if (FAILED(hr))
             {
                 return hr;
             }
         }
 
-        for (auto it = m_renderables.begin(); it != m_renderables.end(); ++it)
+        for (Renderable* pRenderable : m_renderables.GetObjects())
         {
-            HRESULT hr = it->second->Initialize(pDevice, pImmediateContext);
+            hr = pRenderable->Initialize(pDevice, pImmediateContext);
             if (FAILED(hr))
             {
                 return hr;
             }
         }
 
-        for (auto it = m_models.begin(); it != m_models.end(); ++it)
+        for (Model* pModel : m_models.GetObjects())
         {
-            HRESULT hr = it->second->Initialize(pDevice, pImmediateContext);
+            hr = pModel->Initialize(pDevice, pImmediateContext);
             if (FAILED(hr))
             {
                 return hr;
             }
-
-            for (int i = 0; i < it->second->GetNumMaterials(); ++i)
-            {
-                AddMaterial(it->second->GetMaterial(i));
-            }
         }
 
         for (auto it = m_materials.begin(); it != m_materials.end(); ++it)
         {
-            HRESULT hr = it->second->Initialize(pDevice, pImmediateContext);
+            hr = it->second->Initialize(pDevice, pImmediateContext);
             if (FAILED(hr))
             {
                 return hr;
@@ -230,13 +276,49 @@ namespace library
 
         if (m_skyBox != nullptr)
         {
-            HRESULT hr = m_skyBox->Initialize(pDevice, pImmediateContext);
+            hr = m_skyBox->Initialize(pDevice, pImmediateContext);
             if (FAILED(hr))
             {
                 return hr;
             }
         }
-        
+
+        m_voxels.UpdateTransforms();
+        m_renderables.UpdateTransforms();
+        m_models.UpdateTransforms();
+
+        // Release textures whose materials were replaced, such as the skybox sphere's
+        UINT uNumEvicted = TextureCache::EvictUnused();
+
+        QueryPerformanceCounter(&EndTime);
+
+        CHAR szDebugMessage[128];
+        sprintf_s(
+            szDebugMessage,
+            "Scene initialized in %.2f ms with %u loader threads\n",
+            static_cast<DOUBLE>(EndTime.QuadPart - StartTime.QuadPart) * 1000.0 / static_cast<DOUBLE>(Frequency.QuadPart),
+            loader.GetNumThreads()
+        );
+        OutputDebugStringA(szDebugMessage);
+
+        sprintf_s(
+            szDebugMessage,
+            "Texture cache: %u textures, %u hits, %u misses, %u evicted\n",
+            TextureCache::GetNumEntries(),
+            TextureCache::GetNumHits(),
+            TextureCache::GetNumMisses(),
+            uNumEvicted
+        );
+        OutputDebugStringA(szDebugMessage);
+
+        sprintf_s(
+            szDebugMessage,
+            "Shader cache: %u hits, %u compiled\n",
+            ShaderCache::GetNumHits(),
+            ShaderCache::GetNumMisses()
+        );
+        OutputDebugStringA(szDebugMessage);
+
         return S_OK;
     }
 
@@ -248,14 +330,14 @@ namespace library
       Args:     const std::shared_ptr<Voxel>& voxel
                   Shared pointer to the voxel object
 
-      Modifies: [m_renderables].
+      Modifies: [m_voxels].
 
       Returns:  HRESULT
                   Status code.
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     HRESULT Scene::AddVoxel(_In_ const std::shared_ptr<Voxel>& voxel)
     {
-        m_voxels.push_back(voxel);
+        m_voxels.Add(voxel);
 
         return S_OK;
     }
@@ -270,19 +352,19 @@ namespace library
                 const std::shared_ptr<Renderable>& renderable
                   Shared pointer to the renderable object
 
-      Modifies: [m_renderables].
+      Modifies: [m_renderables, m_renderableNames].
 
       Returns:  HRESULT
                   Status code.
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     HRESULT Scene::AddRenderable(_In_ PCWSTR pszRenderableName, _In_ const std::shared_ptr<Renderable>& renderable)
     {
-        if (m_renderables.contains(pszRenderableName))
+        if (m_renderableNames.contains(pszRenderableName))
         {
             return E_FAIL;
         }
 
-        m_renderables[pszRenderableName] = renderable;
+        m_renderableNames[pszRenderableName] = m_renderables.Add(renderable);
 
         return S_OK;
     }
@@ -297,19 +379,19 @@ namespace library
                 const std::shared_ptr<Model>& model
                   Shared pointer to the model object
 
-      Modifies: [m_models].
+      Modifies: [m_models, m_modelNames].
 
       Returns:  HRESULT
                   Status code.
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     HRESULT Scene::AddModel(_In_ PCWSTR pszModelName, _In_ const std::shared_ptr<Model>& pModel)
     {
-        if (m_models.contains(pszModelName))
+        if (m_modelNames.contains(pszModelName))
         {
             return E_FAIL;
         }
 
-        m_models[pszModelName] = pModel;
+        m_modelNames[pszModelName] = m_models.Add(pModel);
 
         return S_OK;
     }
@@ -343,6 +425,51 @@ namespace library
         return hr;
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::AddLocalLight
+
+      Summary:  Add a point light without a shadow map. Local lights
+                are binned into the clusters of the view and only
+                shade the pixels within their attenuation distance,
+                so a scene can have any number of them
+
+      Args:     const std::shared_ptr<PointLight>& pPointLight
+                  Shared pointer to the point light object
+
+      Modifies: [m_aLocalLights].
+
+      Returns:  HRESULT
+                  Status code.
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Scene::AddLocalLight(_In_ const std::shared_ptr<PointLight>& pPointLight)
+    {
+        if (!pPointLight)
+        {
+            return E_INVALIDARG;
+        }
+
+        m_aLocalLights.push_back(pPointLight);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::SetDirectionalLight
+
+      Summary:  Set the directional light, its shadows are rendered
+                into cascades. A scene has at most one
+
+      Args:     const std::shared_ptr<DirectionalLight>& pDirectionalLight
+                  Shared pointer to the directional light, null
+                  removes it
+
+      Modifies: [m_directionalLight].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Scene::SetDirectionalLight(_In_ const std::shared_ptr<DirectionalLight>& pDirectionalLight)
+    {
+        m_directionalLight = pDirectionalLight;
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Scene::AddVertexShader
 
@@ -450,22 +577,31 @@ namespace library
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Scene::Update
 
-      Summary:  Update the renderables, models, point lights, skybox 
-                each frame
+      Summary:  Update the renderables, models, point lights, the
+                directional light and skybox each frame. The stores
+                copy the transforms that changed, voxels are static
+                and only get their transforms copied. Objects attached to the transform
+                hierarchy take their world matrix from it after their
+                own update
 
       Args:     FLOAT deltaTime
                   Time difference of a frame
+
+      Modifies: [m_voxels, m_renderables, m_models, m_transforms,
+                 m_aTransformAttachments].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     void Scene::Update(_In_ FLOAT deltaTime)
     {
-        for (auto it = m_renderables.begin(); it != m_renderables.end(); ++it)
-        {
-            it->second->Update(deltaTime);
-        }
+        PROFILE_SCOPE("Scene::Update");
+
+        m_voxels.UpdateTransforms();
+        m_renderables.Update(deltaTime);
+        m_models.Update(deltaTime);
 
-        for (auto it = m_models.begin(); it != m_models.end(); ++it)
+        if (updateAttachments())
         {
-            it->second->Update(deltaTime);
+            m_renderables.UpdateTransforms();
+            m_models.UpdateTransforms();
         }
 
         for (UINT lightIdx = 0; lightIdx < NUM_LIGHTS; ++lightIdx)
@@ -473,18 +609,31 @@ namespace library
             m_aPointLights[lightIdx]->Update(deltaTime);
         }
 
-        m_skyBox->Update(deltaTime);
+        for (const std::shared_ptr<PointLight>& localLight : m_aLocalLights)
+        {
+            localLight->Update(deltaTime);
+        }
+
+        if (m_directionalLight != nullptr)
+        {
+            m_directionalLight->Update(deltaTime);
+        }
+
+        if (m_skyBox != nullptr)
+        {
+            m_skyBox->Update(deltaTime);
+        }
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Scene::GetVoxels
 
-      Summary:  Returns the vector of voxels
+      Summary:  Returns the store of voxels
 
-      Returns:  std::vector<std::shared_ptr<Voxel>>&
+      Returns:  SceneObjectStore<Voxel>&
                   Voxels
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    std::vector<std::shared_ptr<Voxel>>& Scene::GetVoxels()
+    SceneObjectStore<Voxel>& Scene::GetVoxels()
     {
         return m_voxels;
     }
@@ -493,12 +642,12 @@ namespace library
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Scene::GetRenderables
 
-      Summary:  Returns the vector of renderables
+      Summary:  Returns the store of renderables
 
-      Returns:  std::unordered_map<std::wstring, std::shared_ptr<Renderable>>&
+      Returns:  SceneObjectStore<Renderable>&
                   Renderables
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    std::unordered_map<std::wstring, std::shared_ptr<Renderable>>& Scene::GetRenderables()
+    SceneObjectStore<Renderable>& Scene::GetRenderables()
     {
         return m_renderables;
     }
@@ -506,16 +655,60 @@ namespace library
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Scene::GetModels
 
-      Summary:  Returns the vector of models
+      Summary:  Returns the store of models
 
-      Returns:  std::unordered_map<std::wstring, std::shared_ptr<Model>>&
+      Returns:  SceneObjectStore<Model>&
                   Models
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    std::unordered_map<std::wstring, std::shared_ptr<Model>>& Scene::GetModels()
+    SceneObjectStore<Model>& Scene::GetModels()
     {
         return m_models;
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::FindRenderable
+
+      Summary:  Looks a renderable up by name
+
+      Args:     PCWSTR pszRenderableName
+                  Key of the renderable
+
+      Returns:  Renderable*
+                  The renderable, null if there is none of that name
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    Renderable* Scene::FindRenderable(_In_ PCWSTR pszRenderableName) const
+    {
+        auto it = m_renderableNames.find(pszRenderableName);
+        if (it == m_renderableNames.end())
+        {
+            return nullptr;
+        }
+
+        return m_renderables.Get(it->second);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::FindModel
+
+      Summary:  Looks a model up by name
+
+      Args:     PCWSTR pszModelName
+                  Key of the model
+
+      Returns:  Model*
+                  The model, null if there is none of that name
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    Model* Scene::FindModel(_In_ PCWSTR pszModelName) const
+    {
+        auto it = m_modelNames.find(pszModelName);
+        if (it == m_modelNames.end())
+        {
+            return nullptr;
+        }
+
+        return m_models.Get(it->second);
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Scene::GetPointLight
 
@@ -534,6 +727,32 @@ namespace library
         return m_aPointLights[index];
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetLocalLights
+
+      Summary:  Returns the point lights without a shadow map
+
+      Returns:  const std::vector<std::shared_ptr<PointLight>>&
+                  Local lights
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::vector<std::shared_ptr<PointLight>>& Scene::GetLocalLights() const
+    {
+        return m_aLocalLights;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetDirectionalLightOrNull
+
+      Summary:  Returns the directional light
+
+      Returns:  DirectionalLight*
+                  Directional light, null if the scene has none
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    DirectionalLight* Scene::GetDirectionalLightOrNull() const
+    {
+        return m_directionalLight.get();
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Scene::GetVertexShaders
 
@@ -616,12 +835,13 @@ namespace library
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     HRESULT Scene::SetVertexShaderOfRenderable(_In_ PCWSTR pszRenderableName, _In_ PCWSTR pszVertexShaderName)
     {
-        if (!m_renderables.contains(pszRenderableName) || !m_vertexShaders.contains(pszVertexShaderName))
+        Renderable* pRenderable = FindRenderable(pszRenderableName);
+        if (!pRenderable || !m_vertexShaders.contains(pszVertexShaderName))
         {
             return E_FAIL;
         }
 
-        m_renderables[pszRenderableName]->SetVertexShader(m_vertexShaders[pszVertexShaderName]);
+        pRenderable->SetVertexShader(m_vertexShaders[pszVertexShaderName]);
 
         return S_OK;
     }
@@ -643,12 +863,13 @@ namespace library
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     HRESULT Scene::SetPixelShaderOfRenderable(_In_ PCWSTR pszRenderableName, _In_ PCWSTR pszPixelShaderName)
     {
-        if (!m_renderables.contains(pszRenderableName) || !m_pixelShaders.contains(pszPixelShaderName))
+        Renderable* pRenderable = FindRenderable(pszRenderableName);
+        if (!pRenderable || !m_pixelShaders.contains(pszPixelShaderName))
         {
             return E_FAIL;
         }
 
-        m_renderables[pszRenderableName]->SetPixelShader(m_pixelShaders[pszPixelShaderName]);
+        pRenderable->SetPixelShader(m_pixelShaders[pszPixelShaderName]);
 
         return S_OK;
     }
@@ -670,12 +891,13 @@ namespace library
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     HRESULT Scene::SetVertexShaderOfModel(_In_ PCWSTR pszModelName, _In_ PCWSTR pszVertexShaderName)
     {
-        if (!m_models.contains(pszModelName) || !m_vertexShaders.contains(pszVertexShaderName))
+        Model* pModel = FindModel(pszModelName);
+        if (!pModel || !m_vertexShaders.contains(pszVertexShaderName))
         {
             return E_FAIL;
         }
 
-        m_models[pszModelName]->SetVertexShader(m_vertexShaders[pszVertexShaderName]);
+        pModel->SetVertexShader(m_vertexShaders[pszVertexShaderName]);
 
         return S_OK;
     }
@@ -697,12 +919,13 @@ namespace library
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     HRESULT Scene::SetPixelShaderOfModel(_In_ PCWSTR pszModelName, _In_ PCWSTR pszPixelShaderName)
     {
-        if (!m_models.contains(pszModelName) || !m_pixelShaders.contains(pszPixelShaderName))
+        Model* pModel = FindModel(pszModelName);
+        if (!pModel || !m_pixelShaders.contains(pszPixelShaderName))
         {
             return E_FAIL;
         }
 
-        m_models[pszModelName]->SetPixelShader(m_pixelShaders[pszPixelShaderName]);
+        pModel->SetPixelShader(m_pixelShaders[pszPixelShaderName]);
 
         return S_OK;
     }
@@ -729,9 +952,9 @@ namespace library
             return E_FAIL;
         }
 
-        for (std::shared_ptr<Voxel>& voxel : m_voxels)
+        for (Voxel* pVoxel : m_voxels.GetObjects())
         {
-            voxel->SetVertexShader(m_vertexShaders[pszVertexShaderName]);
+            pVoxel->SetVertexShader(m_vertexShaders[pszVertexShaderName]);
         }
 
         return S_OK;
@@ -759,9 +982,9 @@ namespace library
             return E_FAIL;
         }
 
-        for (std::shared_ptr<Voxel>& voxel : m_voxels)
+        for (Voxel* pVoxel : m_voxels.GetObjects())
         {
-            voxel->SetPixelShader(m_pixelShaders[pszPixelShaderName]);
+            pVoxel->SetPixelShader(m_pixelShaders[pszPixelShaderName]);
         }
 
         return S_OK;
@@ -787,14 +1010,121 @@ namespace library
             return E_FAIL;
         }
 
-        for (std::shared_ptr<Voxel>& voxel : m_voxels)
+        for (Voxel* pVoxel : m_voxels.GetObjects())
         {
-            voxel->AddMaterial(m_materials[pszMaterialName]);
+            pVoxel->AddMaterial(m_materials[pszMaterialName]);
         }
 
         return S_OK;
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetTransforms
+
+      Summary:  Returns the transform hierarchy of the scene
+
+      Returns:  TransformHierarchy&
+                  Transform hierarchy
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    TransformHierarchy& Scene::GetTransforms()
+    {
+        return m_transforms;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::AttachRenderableToNode
+
+      Summary:  Makes the world matrix of a renderable follow a node of
+                the transform hierarchy. The matrix is replaced every
+                time the node changes
+
+      Args:     PCWSTR pszRenderableName
+                  Key of the renderable
+                UINT uNode
+                  Index of the node
+
+      Modifies: [m_aTransformAttachments].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Scene::AttachRenderableToNode(_In_ PCWSTR pszRenderableName, _In_ UINT uNode)
+    {
+        Renderable* pRenderable = FindRenderable(pszRenderableName);
+        if (!pRenderable || uNode >= m_transforms.GetNumNodes())
+        {
+            return E_FAIL;
+        }
+
+        m_aTransformAttachments.push_back(TransformAttachment{ .pObject = pRenderable, .uNode = uNode, .uVersion = 0u });
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::AttachModelToNode
+
+      Summary:  Makes the world matrix of a model follow a node of the
+                transform hierarchy
+
+      Args:     PCWSTR pszModelName
+                  Key of the model
+                UINT uNode
+                  Index of the node
+
+      Modifies: [m_aTransformAttachments].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Scene::AttachModelToNode(_In_ PCWSTR pszModelName, _In_ UINT uNode)
+    {
+        Model* pModel = FindModel(pszModelName);
+        if (!pModel || uNode >= m_transforms.GetNumNodes())
+        {
+            return E_FAIL;
+        }
+
+        m_aTransformAttachments.push_back(TransformAttachment{ .pObject = pModel, .uNode = uNode, .uVersion = 0u });
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::updateAttachments
+
+      Summary:  Updates the transform hierarchy and copies the world
+                matrices of the nodes that changed to their attached
+                objects
+
+      Modifies: [m_transforms, m_aTransformAttachments].
+
+      Returns:  BOOL
+                  TRUE if any attached object moved
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL Scene::updateAttachments()
+    {
+        m_transforms.Update();
+        if (m_transforms.GetNumUpdated() == 0u)
+        {
+            return FALSE;
+        }
+
+        BOOL bMoved = FALSE;
+        for (TransformAttachment& attachment : m_aTransformAttachments)
+        {
+            const UINT64 uVersion = m_transforms.GetVersion(attachment.uNode);
+            if (uVersion != attachment.uVersion)
+            {
+                attachment.pObject->SetWorldMatrix(m_transforms.GetWorldMatrix(attachment.uNode));
+                attachment.uVersion = uVersion;
+                bMoved = TRUE;
+            }
+        }
+
+        return bMoved;
+    }
+
     FLOAT Scene::getNoise2(UINT x, UINT y)
     {
         UINT temp = ms_aHashes[y % 256u];
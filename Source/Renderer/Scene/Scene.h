@@ -16,13 +16,31 @@
 #include <fstream>
 
 #include "Model/Model.h"
+#include "Light/DirectionalLight.h"
 #include "Light/PointLight.h"
+#include "Profiler/Profiler.h"
 #include "Renderer/Skybox.h"
 #include "Renderer/Renderable.h"
+#include "Scene/SceneObjectStore.h"
+#include "Scene/TransformHierarchy.h"
 #include "Scene/Voxel.h"
 
 namespace library
 {
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   TransformAttachment
+
+      Summary:  Object whose world matrix follows a node of the
+                transform hierarchy. uVersion is the version of the
+                node the matrix was last copied at
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct TransformAttachment
+    {
+        Renderable* pObject;
+        UINT uNode;
+        UINT64 uVersion;
+    };
+
     class Scene
     {
     public:
@@ -41,6 +59,8 @@ namespace library
         HRESULT AddRenderable(_In_ PCWSTR pszRenderableName, _In_ const std::shared_ptr<Renderable>& renderable);
         HRESULT AddModel(_In_ PCWSTR pszModelName, _In_ const std::shared_ptr<Model>& pModel);
         HRESULT AddPointLight(_In_ size_t index, _In_ const std::shared_ptr<PointLight>& pPointLight);
+        HRESULT AddLocalLight(_In_ const std::shared_ptr<PointLight>& pPointLight);
+        void SetDirectionalLight(_In_ const std::shared_ptr<DirectionalLight>& pDirectionalLight);
         HRESULT AddVertexShader(_In_ PCWSTR pszVertexShaderName, _In_ const std::shared_ptr<VertexShader>& vertexShader);
         HRESULT AddPixelShader(_In_ PCWSTR pszPixelShaderName, _In_ const std::shared_ptr<PixelShader>& pixelShader);
         HRESULT AddMaterial(_In_ const std::shared_ptr<Material>& material);
@@ -48,10 +68,14 @@ namespace library
 
         void Update(_In_ FLOAT deltaTime);
 
-        std::vector<std::shared_ptr<Voxel>>& GetVoxels();
-        std::unordered_map<std::wstring, std::shared_ptr<Renderable>>& GetRenderables();
-        std::unordered_map<std::wstring, std::shared_ptr<Model>>& GetModels();
+        SceneObjectStore<Voxel>& GetVoxels();
+        SceneObjectStore<Renderable>& GetRenderables();
+        SceneObjectStore<Model>& GetModels();
+        Renderable* FindRenderable(_In_ PCWSTR pszRenderableName) const;
+        Model* FindModel(_In_ PCWSTR pszModelName) const;
         std::shared_ptr<PointLight>& GetPointLight(_In_ size_t index);
+        const std::vector<std::shared_ptr<PointLight>>& GetLocalLights() const;
+        DirectionalLight* GetDirectionalLightOrNull() const;
         std::unordered_map<std::wstring, std::shared_ptr<VertexShader>>& GetVertexShaders();
         std::unordered_map<std::wstring, std::shared_ptr<PixelShader>>& GetPixelShaders();
         std::shared_ptr<Skybox>& GetSkyBox();
@@ -69,13 +93,21 @@ namespace library
         HRESULT SetPixelShaderOfVoxel(_In_ PCWSTR pszPixelShaderName);
         HRESULT SetMaterialOfVoxel(_In_ PCWSTR pszMaterialName);
 
+        TransformHierarchy& GetTransforms();
+        HRESULT AttachRenderableToNode(_In_ PCWSTR pszRenderableName, _In_ UINT uNode);
+        HRESULT AttachModelToNode(_In_ PCWSTR pszModelName, _In_ UINT uNode);
+
     private:
+        BOOL updateAttachments();
         static FLOAT getNoise2(UINT x, UINT y);
         static FLOAT getNoise2d(FLOAT x, FLOAT y);
         static FLOAT lerp(FLOAT x, FLOAT y, FLOAT s);
         static FLOAT smoothLerp(FLOAT x, FLOAT y, FLOAT s);
 
     private:
+        // Width and depth in columns of the voxel chunks, a voxel object is one color of one chunk
+        static constexpr UINT VOXEL_CHUNK_SIZE = 64u;
+
         static constexpr const UINT ms_aHashes[] =
         {
             208,34,231,213,32,248,233,56,161,78,24,140,71,48,140,254,245,255,247,247,40,
@@ -94,10 +126,16 @@ namespace library
 
     private:
         std::filesystem::path m_filePath;
-        std::vector<std::shared_ptr<Voxel>> m_voxels;
-        std::unordered_map<std::wstring, std::shared_ptr<Renderable>> m_renderables;
-        std::unordered_map<std::wstring, std::shared_ptr<Model>> m_models;
+        SceneObjectStore<Voxel> m_voxels;
+        SceneObjectStore<Renderable> m_renderables;
+        SceneObjectStore<Model> m_models;
+        std::unordered_map<std::wstring, SceneObjectHandle> m_renderableNames;
+        std::unordered_map<std::wstring, SceneObjectHandle> m_modelNames;
+        TransformHierarchy m_transforms;
+        std::vector<TransformAttachment> m_aTransformAttachments;
         std::shared_ptr<PointLight> m_aPointLights[NUM_LIGHTS];
+        std::vector<std::shared_ptr<PointLight>> m_aLocalLights;
+        std::shared_ptr<DirectionalLight> m_directionalLight;
         std::unordered_map<std::wstring, std::shared_ptr<VertexShader>> m_vertexShaders;
         std::unordered_map<std::wstring, std::shared_ptr<PixelShader>> m_pixelShaders;
         std::unordered_map<std::wstring, std::shared_ptr<Material>> m_materials;
@@ -0,0 +1,380 @@
+/*+===================================================================
+  File:      SCENEOBJECTSTORE.H
+
+  Summary:   SceneObjectStore header file contains declarations of the
+             SceneObjectStore class that keeps the objects of a scene
+             and their per-object data in dense arrays addressed by
+             stable handles.
+
+  Classes: SceneObjectStore<ObjectType>
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   SceneObjectHandle
+
+      Summary:  Stable reference to an object of a store. uIndex is the
+                slot of the object, uGeneration tells a live object
+                from a removed one whose slot was reused
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct SceneObjectHandle
+    {
+        UINT uIndex;
+        UINT uGeneration;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    SceneObjectStore
+
+      Summary:  Keeps objects in structure of arrays form. The objects,
+                their world matrices, world bounds and the versions
+                the matrices were copied at live in parallel dense
+                arrays, so per-frame loops walk contiguous memory
+                instead of hash buckets. Handles map to dense indices
+                through a slot table, removing an object moves the
+                last object into its place. Names are not stored, the
+                owner keeps a name to handle index on the side
+
+      Methods:  Add
+                  Adds an object and returns its handle
+                Remove
+                  Removes an object
+                IsValid
+                  Returns whether a handle refers to a live object
+                Get
+                  Returns the object of a handle
+                GetCount
+                  Returns the number of objects
+                Update
+                  Updates every object and its transform
+                UpdateTransforms
+                  Copies the transforms of changed objects
+                GetObjects
+                  Returns the dense array of objects
+                GetWorldMatrices
+                  Returns the dense array of world matrices
+                GetBounds
+                  Returns the dense array of world bounds
+                SceneObjectStore
+                  Constructor.
+                ~SceneObjectStore
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    template <class ObjectType>
+    class SceneObjectStore final
+    {
+    public:
+        static constexpr UINT INVALID_INDEX = 0xFFFFFFFFu;
+
+        SceneObjectStore();
+        SceneObjectStore(const SceneObjectStore& other) = delete;
+        SceneObjectStore(SceneObjectStore&& other) = delete;
+        SceneObjectStore& operator=(const SceneObjectStore& other) = delete;
+        SceneObjectStore& operator=(SceneObjectStore&& other) = delete;
+        ~SceneObjectStore() = default;
+
+        SceneObjectHandle Add(_In_ const std::shared_ptr<ObjectType>& object);
+        HRESULT Remove(_In_ SceneObjectHandle handle);
+        BOOL IsValid(_In_ SceneObjectHandle handle) const;
+        ObjectType* Get(_In_ SceneObjectHandle handle) const;
+        UINT GetCount() const;
+
+        void Update(_In_ FLOAT deltaTime);
+        void UpdateTransforms();
+
+        const std::vector<ObjectType*>& GetObjects() const;
+        const std::vector<XMFLOAT4X4>& GetWorldMatrices() const;
+        const std::vector<BoundingBox>& GetBounds() const;
+
+    private:
+        struct Slot
+        {
+            UINT uDenseIndex;
+            UINT uGeneration;
+        };
+
+        std::vector<Slot> m_aSlots;
+        std::vector<UINT> m_aFreeSlots;
+
+        std::vector<ObjectType*> m_aObjects;
+        std::vector<XMFLOAT4X4> m_aWorldMatrices;
+        std::vector<BoundingBox> m_aBounds;
+        std::vector<UINT64> m_aVersions;
+        std::vector<UINT> m_aSlotIndices;
+        std::vector<std::shared_ptr<ObjectType>> m_aOwners;
+    };
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneObjectStore<ObjectType>::SceneObjectStore
+
+      Summary:  Constructor
+
+      Modifies: [m_aSlots, m_aFreeSlots, m_aObjects, m_aWorldMatrices,
+                 m_aBounds, m_aVersions, m_aSlotIndices, m_aOwners].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    template <class ObjectType>
+    SceneObjectStore<ObjectType>::SceneObjectStore()
+        : m_aSlots()
+        , m_aFreeSlots()
+        , m_aObjects()
+        , m_aWorldMatrices()
+        , m_aBounds()
+        , m_aVersions()
+        , m_aSlotIndices()
+        , m_aOwners()
+    {
+        // empty
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneObjectStore<ObjectType>::Add
+
+      Summary:  Appends an object to the dense arrays. Its transform is
+                copied by the next UpdateTransforms
+
+      Args:     const std::shared_ptr<ObjectType>& object
+                  The object, kept alive by the store
+
+      Modifies: [m_aSlots, m_aFreeSlots, m_aObjects, m_aWorldMatrices,
+                 m_aBounds, m_aVersions, m_aSlotIndices, m_aOwners].
+
+      Returns:  SceneObjectHandle
+                  Handle of the object
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    template <class ObjectType>
+    SceneObjectHandle SceneObjectStore<ObjectType>::Add(_In_ const std::shared_ptr<ObjectType>& object)
+    {
+        UINT uSlot = INVALID_INDEX;
+        if (!m_aFreeSlots.empty())
+        {
+            uSlot = m_aFreeSlots.back();
+            m_aFreeSlots.pop_back();
+        }
+        else
+        {
+            uSlot = static_cast<UINT>(m_aSlots.size());
+            m_aSlots.push_back(Slot{ .uDenseIndex = INVALID_INDEX, .uGeneration = 0u });
+        }
+
+        m_aSlots[uSlot].uDenseIndex = static_cast<UINT>(m_aObjects.size());
+
+        XMFLOAT4X4 world;
+        XMStoreFloat4x4(&world, XMMatrixIdentity());
+
+        m_aObjects.push_back(object.get());
+        m_aWorldMatrices.push_back(world);
+        m_aBounds.push_back(BoundingBox());
+        m_aVersions.push_back(0u);
+        m_aSlotIndices.push_back(uSlot);
+        m_aOwners.push_back(object);
+
+        return SceneObjectHandle{ .uIndex = uSlot, .uGeneration = m_aSlots[uSlot].uGeneration };
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneObjectStore<ObjectType>::Remove
+
+      Summary:  Removes an object by moving the last object into its
+                place. Handles of the other objects stay valid, dense
+                indices do not
+
+      Args:     SceneObjectHandle handle
+                  Handle of the object
+
+      Modifies: [m_aSlots, m_aFreeSlots, m_aObjects, m_aWorldMatrices,
+                 m_aBounds, m_aVersions, m_aSlotIndices, m_aOwners].
+
+      Returns:  HRESULT
+                  Status code, E_INVALIDARG for a stale handle
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    template <class ObjectType>
+    HRESULT SceneObjectStore<ObjectType>::Remove(_In_ SceneObjectHandle handle)
+    {
+        if (!IsValid(handle))
+        {
+            return E_INVALIDARG;
+        }
+
+        const UINT uDenseIndex = m_aSlots[handle.uIndex].uDenseIndex;
+        const UINT uLastIndex = static_cast<UINT>(m_aObjects.size()) - 1u;
+        if (uDenseIndex != uLastIndex)
+        {
+            m_aObjects[uDenseIndex] = m_aObjects[uLastIndex];
+            m_aWorldMatrices[uDenseIndex] = m_aWorldMatrices[uLastIndex];
+            m_aBounds[uDenseIndex] = m_aBounds[uLastIndex];
+            m_aVersions[uDenseIndex] = m_aVersions[uLastIndex];
+            m_aSlotIndices[uDenseIndex] = m_aSlotIndices[uLastIndex];
+            m_aOwners[uDenseIndex] = std::move(m_aOwners[uLastIndex]);
+
+            m_aSlots[m_aSlotIndices[uDenseIndex]].uDenseIndex = uDenseIndex;
+        }
+
+        m_aObjects.pop_back();
+        m_aWorldMatrices.pop_back();
+        m_aBounds.pop_back();
+        m_aVersions.pop_back();
+        m_aSlotIndices.pop_back();
+        m_aOwners.pop_back();
+
+        m_aSlots[handle.uIndex].uDenseIndex = INVALID_INDEX;
+        ++m_aSlots[handle.uIndex].uGeneration;
+        m_aFreeSlots.push_back(handle.uIndex);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneObjectStore<ObjectType>::IsValid
+
+      Summary:  Returns whether a handle refers to a live object
+
+      Args:     SceneObjectHandle handle
+                  Handle to check
+
+      Returns:  BOOL
+                  TRUE if the object was not removed
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    template <class ObjectType>
+    BOOL SceneObjectStore<ObjectType>::IsValid(_In_ SceneObjectHandle handle) const
+    {
+        return handle.uIndex < m_aSlots.size() &&
+            m_aSlots[handle.uIndex].uGeneration == handle.uGeneration &&
+            m_aSlots[handle.uIndex].uDenseIndex != INVALID_INDEX;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneObjectStore<ObjectType>::Get
+
+      Summary:  Returns the object of a handle
+
+      Args:     SceneObjectHandle handle
+                  Handle of the object
+
+      Returns:  ObjectType*
+                  The object, null for a stale handle
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    template <class ObjectType>
+    ObjectType* SceneObjectStore<ObjectType>::Get(_In_ SceneObjectHandle handle) const
+    {
+        if (!IsValid(handle))
+        {
+            return nullptr;
+        }
+
+        return m_aObjects[m_aSlots[handle.uIndex].uDenseIndex];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneObjectStore<ObjectType>::GetCount
+
+      Summary:  Returns the number of objects
+
+      Returns:  UINT
+                  Number of live objects
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    template <class ObjectType>
+    UINT SceneObjectStore<ObjectType>::GetCount() const
+    {
+        return static_cast<UINT>(m_aObjects.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneObjectStore<ObjectType>::Update
+
+      Summary:  Updates every object in dense order, then copies the
+                transforms that changed
+
+      Args:     FLOAT deltaTime
+                  Time difference of a frame
+
+      Modifies: [m_aWorldMatrices, m_aBounds, m_aVersions].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    template <class ObjectType>
+    void SceneObjectStore<ObjectType>::Update(_In_ FLOAT deltaTime)
+    {
+        for (ObjectType* pObject : m_aObjects)
+        {
+            pObject->Update(deltaTime);
+        }
+
+        UpdateTransforms();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneObjectStore<ObjectType>::UpdateTransforms
+
+      Summary:  Copies the world matrix of every object whose version
+                changed since the last copy and transforms its local
+                bounds into world space
+
+      Modifies: [m_aWorldMatrices, m_aBounds, m_aVersions].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    template <class ObjectType>
+    void SceneObjectStore<ObjectType>::UpdateTransforms()
+    {
+        const size_t uNumObjects = m_aObjects.size();
+        for (size_t i = 0u; i < uNumObjects; ++i)
+        {
+            const UINT64 uVersion = m_aObjects[i]->GetVersion();
+            if (uVersion == m_aVersions[i])
+            {
+                continue;
+            }
+
+            const XMMATRIX& world = m_aObjects[i]->GetWorldMatrix();
+            XMStoreFloat4x4(&m_aWorldMatrices[i], world);
+            m_aObjects[i]->GetLocalBounds().Transform(m_aBounds[i], world);
+            m_aVersions[i] = uVersion;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneObjectStore<ObjectType>::GetObjects
+
+      Summary:  Returns the objects in dense order
+
+      Returns:  const std::vector<ObjectType*>&
+                  Objects, parallel to the other dense arrays
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    template <class ObjectType>
+    const std::vector<ObjectType*>& SceneObjectStore<ObjectType>::GetObjects() const
+    {
+        return m_aObjects;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneObjectStore<ObjectType>::GetWorldMatrices
+
+      Summary:  Returns the world matrices in dense order, as of the
+                last UpdateTransforms
+
+      Returns:  const std::vector<XMFLOAT4X4>&
+                  World matrices
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    template <class ObjectType>
+    const std::vector<XMFLOAT4X4>& SceneObjectStore<ObjectType>::GetWorldMatrices() const
+    {
+        return m_aWorldMatrices;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneObjectStore<ObjectType>::GetBounds
+
+      Summary:  Returns the world space bounds in dense order, as of
+                the last UpdateTransforms
+
+      Returns:  const std::vector<BoundingBox>&
+                  World space axis aligned bounds
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    template <class ObjectType>
+    const std::vector<BoundingBox>& SceneObjectStore<ObjectType>::GetBounds() const
+    {
+        return m_aBounds;
+    }
+}
\ No newline at end of file
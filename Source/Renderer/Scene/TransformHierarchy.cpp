@@ -0,0 +1,453 @@
+#include "Scene/TransformHierarchy.h"
+
+#include <algorithm>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TransformHierarchy::TransformHierarchy
+
+      Summary:  Constructor
+
+      Modifies: [m_aScales, m_aRotations, m_aTranslations, m_aParents,
+                 m_aWorldMatrices, m_aVersions, m_aDirty, m_aDirtyNodes,
+                 m_aOrder, m_aOrderIndices, m_aSubtreeEnds,
+                 m_uNumUpdated, m_bOrderDirty].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    TransformHierarchy::TransformHierarchy()
+        : m_aScales()
+        , m_aRotations()
+        , m_aTranslations()
+        , m_aParents()
+        , m_aWorldMatrices()
+        , m_aVersions()
+        , m_aDirty()
+        , m_aDirtyNodes()
+        , m_aOrder()
+        , m_aOrderIndices()
+        , m_aSubtreeEnds()
+        , m_uNumUpdated(0u)
+        , m_bOrderDirty(FALSE)
+    {
+        // empty
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TransformHierarchy::AddNode
+
+      Summary:  Adds a node with an identity local transform. A parent
+                has to be added before its children
+
+      Args:     UINT uParent
+                  Index of the parent, NO_PARENT for a root
+
+      Modifies: [m_aScales, m_aRotations, m_aTranslations, m_aParents,
+                 m_aWorldMatrices, m_aVersions, m_aDirty, m_aDirtyNodes,
+                 m_bOrderDirty].
+
+      Returns:  UINT
+                  Index of the node
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT TransformHierarchy::AddNode(_In_ UINT uParent)
+    {
+        assert(uParent == NO_PARENT || uParent < m_aParents.size());
+
+        XMFLOAT4X4A identity;
+        XMStoreFloat4x4A(&identity, XMMatrixIdentity());
+
+        m_aScales.push_back(XMFLOAT3(1.0f, 1.0f, 1.0f));
+        m_aRotations.push_back(XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f));
+        m_aTranslations.push_back(XMFLOAT3(0.0f, 0.0f, 0.0f));
+        m_aParents.push_back(uParent);
+        m_aWorldMatrices.push_back(identity);
+        m_aVersions.push_back(0u);
+        m_aDirty.push_back(FALSE);
+
+        const UINT uNode = static_cast<UINT>(m_aParents.size()) - 1u;
+        markDirty(uNode);
+        m_bOrderDirty = TRUE;
+
+        return uNode;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TransformHierarchy::SetParent
+
+      Summary:  Moves a node and its subtree under another parent. The
+                local transform is kept, so the world matrices of the
+                subtree change with the next update
+
+      Args:     UINT uNode
+                  Index of the node
+                UINT uParent
+                  Index of the new parent, NO_PARENT for a root
+
+      Modifies: [m_aParents, m_aDirty, m_aDirtyNodes, m_bOrderDirty].
+
+      Returns:  HRESULT
+                  Status code, E_INVALIDARG if the parent does not
+                  exist or is in the subtree of the node
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT TransformHierarchy::SetParent(_In_ UINT uNode, _In_ UINT uParent)
+    {
+        if (uNode >= m_aParents.size() || (uParent != NO_PARENT && uParent >= m_aParents.size()))
+        {
+            return E_INVALIDARG;
+        }
+
+        for (UINT uAncestor = uParent; uAncestor != NO_PARENT; uAncestor = m_aParents[uAncestor])
+        {
+            if (uAncestor == uNode)
+            {
+                return E_INVALIDARG;
+            }
+        }
+
+        if (m_aParents[uNode] != uParent)
+        {
+            m_aParents[uNode] = uParent;
+            markDirty(uNode);
+            m_bOrderDirty = TRUE;
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TransformHierarchy::SetLocalTransform
+
+      Summary:  Replaces the local transform of a node. The local
+                matrix is scale, then rotation, then translation
+
+      Args:     UINT uNode
+                  Index of the node
+                const XMFLOAT3& scale
+                  Scaling factors along the axes
+                const XMFLOAT4& rotation
+                  Rotation quaternion
+                const XMFLOAT3& translation
+                  Offset from the parent
+
+      Modifies: [m_aScales, m_aRotations, m_aTranslations, m_aDirty,
+                 m_aDirtyNodes].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TransformHierarchy::SetLocalTransform(_In_ UINT uNode, _In_ const XMFLOAT3& scale, _In_ const XMFLOAT4& rotation, _In_ const XMFLOAT3& translation)
+    {
+        m_aScales[uNode] = scale;
+        m_aRotations[uNode] = rotation;
+        m_aTranslations[uNode] = translation;
+        markDirty(uNode);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TransformHierarchy::SetScale
+
+      Summary:  Replaces the local scale of a node
+
+      Args:     UINT uNode
+                  Index of the node
+                const XMFLOAT3& scale
+                  Scaling factors along the axes
+
+      Modifies: [m_aScales, m_aDirty, m_aDirtyNodes].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TransformHierarchy::SetScale(_In_ UINT uNode, _In_ const XMFLOAT3& scale)
+    {
+        m_aScales[uNode] = scale;
+        markDirty(uNode);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TransformHierarchy::SetRotation
+
+      Summary:  Replaces the local rotation of a node
+
+      Args:     UINT uNode
+                  Index of the node
+                const XMFLOAT4& rotation
+                  Rotation quaternion
+
+      Modifies: [m_aRotations, m_aDirty, m_aDirtyNodes].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TransformHierarchy::SetRotation(_In_ UINT uNode, _In_ const XMFLOAT4& rotation)
+    {
+        m_aRotations[uNode] = rotation;
+        markDirty(uNode);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TransformHierarchy::SetTranslation
+
+      Summary:  Replaces the local translation of a node
+
+      Args:     UINT uNode
+                  Index of the node
+                const XMFLOAT3& translation
+                  Offset from the parent
+
+      Modifies: [m_aTranslations, m_aDirty, m_aDirtyNodes].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TransformHierarchy::SetTranslation(_In_ UINT uNode, _In_ const XMFLOAT3& translation)
+    {
+        m_aTranslations[uNode] = translation;
+        markDirty(uNode);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TransformHierarchy::Update
+
+      Summary:  Recomputes the world matrices of the subtrees of the
+                dirty nodes. The dirty nodes are sorted by preorder
+                position, so a dirty node inside a subtree that was
+                just recomputed is skipped. Within a subtree range a
+                parent precedes its children, and a parent outside the
+                range did not change, so every parent is final when
+                its children read it. Does nothing if no node changed
+                since the last update
+
+      Modifies: [m_aWorldMatrices, m_aVersions, m_aDirty, m_aDirtyNodes,
+                 m_aOrder, m_aOrderIndices, m_aSubtreeEnds,
+                 m_uNumUpdated, m_bOrderDirty].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TransformHierarchy::Update()
+    {
+        PROFILE_SCOPE("TransformHierarchy::Update");
+
+        m_uNumUpdated = 0u;
+        if (m_aDirtyNodes.empty())
+        {
+            return;
+        }
+
+        if (m_bOrderDirty)
+        {
+            buildOrder();
+        }
+
+        for (UINT& uDirtyNode : m_aDirtyNodes)
+        {
+            uDirtyNode = m_aOrderIndices[uDirtyNode];
+        }
+        std::sort(m_aDirtyNodes.begin(), m_aDirtyNodes.end());
+
+        UINT uRecomputedEnd = 0u;
+        for (UINT uDirtyPosition : m_aDirtyNodes)
+        {
+            if (uDirtyPosition < uRecomputedEnd)
+            {
+                continue;
+            }
+
+            uRecomputedEnd = m_aSubtreeEnds[uDirtyPosition];
+            for (UINT uPosition = uDirtyPosition; uPosition < uRecomputedEnd; ++uPosition)
+            {
+                const UINT uNode = m_aOrder[uPosition];
+                const UINT uParent = m_aParents[uNode];
+
+                XMMATRIX world = XMMatrixAffineTransformation(
+                XMLoadFloat3(&m_aScales[uNode]),
+                XMVectorZero(),
+                XMLoadFloat4(&m_aRotations[uNode]),
+                XMLoadFloat3(&m_aTranslations[uNode])
+            );
+                if (uParent != NO_PARENT)
+                {
+                    world = XMMatrixMultiply(world, XMLoadFloat4x4A(&m_aWorldMatrices[uParent]));
+                }
+                XMStoreFloat4x4A(&m_aWorldMatrices[uNode], world);
+
+                m_aDirty[uNode] = FALSE;
+                ++m_aVersions[uNode];
+                ++m_uNumUpdated;
+            }
+        }
+
+        m_aDirtyNodes.clear();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TransformHierarchy::GetWorldMatrix
+
+      Summary:  Returns the world matrix of a node as of the last
+                update
+
+      Args:     UINT uNode
+                  Index of the node
+
+      Returns:  XMMATRIX
+                  World matrix
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    XMMATRIX TransformHierarchy::GetWorldMatrix(_In_ UINT uNode) const
+    {
+        return XMLoadFloat4x4A(&m_aWorldMatrices[uNode]);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TransformHierarchy::GetParent
+
+      Summary:  Returns the parent of a node
+
+      Args:     UINT uNode
+                  Index of the node
+
+      Returns:  UINT
+                  Index of the parent, NO_PARENT for a root
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT TransformHierarchy::GetParent(_In_ UINT uNode) const
+    {
+        return m_aParents[uNode];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TransformHierarchy::GetVersion
+
+      Summary:  Returns the version of the world matrix of a node. It
+                changes whenever an update recomputes the matrix
+
+      Args:     UINT uNode
+                  Index of the node
+
+      Returns:  UINT64
+                  Version, 0 until the first update
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 TransformHierarchy::GetVersion(_In_ UINT uNode) const
+    {
+        return m_aVersions[uNode];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TransformHierarchy::GetNumNodes
+
+      Summary:  Returns the number of nodes
+
+      Returns:  UINT
+                  Number of nodes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT TransformHierarchy::GetNumNodes() const
+    {
+        return static_cast<UINT>(m_aParents.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TransformHierarchy::GetNumUpdated
+
+      Summary:  Returns the number of world matrices the last update
+                recomputed
+
+      Returns:  UINT
+                  Number of recomputed nodes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT TransformHierarchy::GetNumUpdated() const
+    {
+        return m_uNumUpdated;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TransformHierarchy::markDirty
+
+      Summary:  Marks the local transform of a node as changed and
+                adds it to the dirty list once
+
+      Args:     UINT uNode
+                  Index of the node
+
+      Modifies: [m_aDirty, m_aDirtyNodes].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TransformHierarchy::markDirty(_In_ UINT uNode)
+    {
+        if (!m_aDirty[uNode])
+        {
+            m_aDirty[uNode] = TRUE;
+            m_aDirtyNodes.push_back(uNode);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TransformHierarchy::buildOrder
+
+      Summary:  Lays the nodes out in preorder. The children of every
+                node are gathered into one array first, in the order
+                they were added, so siblings stay in memory order. The
+                end of each subtree range is its start plus the size
+                of the subtree, summed from the leaves up
+
+      Modifies: [m_aOrder, m_aOrderIndices, m_aSubtreeEnds,
+                 m_bOrderDirty].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TransformHierarchy::buildOrder()
+    {
+        const UINT uNumNodes = static_cast<UINT>(m_aParents.size());
+
+        std::vector<UINT> aChildOffsets(static_cast<size_t>(uNumNodes) + 1u, 0u);
+        for (UINT uParent : m_aParents)
+        {
+            if (uParent != NO_PARENT)
+            {
+                ++aChildOffsets[static_cast<size_t>(uParent) + 1u];
+            }
+        }
+        for (size_t i = 1u; i < aChildOffsets.size(); ++i)
+        {
+            aChildOffsets[i] += aChildOffsets[i - 1u];
+        }
+
+        std::vector<UINT> aChildren(aChildOffsets.back());
+        std::vector<UINT> aNextChildren(aChildOffsets.begin(), aChildOffsets.end() - 1);
+        for (UINT i = 0u; i < uNumNodes; ++i)
+        {
+            if (m_aParents[i] != NO_PARENT)
+            {
+                aChildren[aNextChildren[m_aParents[i]]++] = i;
+            }
+        }
+
+        m_aOrder.clear();
+        m_aOrder.reserve(uNumNodes);
+        std::vector<UINT> aStack;
+        for (UINT uRoot = 0u; uRoot < uNumNodes; ++uRoot)
+        {
+            if (m_aParents[uRoot] != NO_PARENT)
+            {
+                continue;
+            }
+
+            aStack.push_back(uRoot);
+            while (!aStack.empty())
+            {
+                const UINT uNode = aStack.back();
+                aStack.pop_back();
+                m_aOrder.push_back(uNode);
+
+                // Pushed last to first, so the first child is visited first
+                for (UINT i = aChildOffsets[static_cast<size_t>(uNode) + 1u]; i > aChildOffsets[uNode]; --i)
+                {
+                    aStack.push_back(aChildren[i - 1u]);
+                }
+            }
+        }
+
+        m_aOrderIndices.resize(uNumNodes);
+        for (UINT uPosition = 0u; uPosition < uNumNodes; ++uPosition)
+        {
+            m_aOrderIndices[m_aOrder[uPosition]] = uPosition;
+        }
+
+        std::vector<UINT> aSubtreeSizes(uNumNodes, 1u);
+        for (UINT uPosition = uNumNodes; uPosition > 0u; --uPosition)
+        {
+            const UINT uNode = m_aOrder[uPosition - 1u];
+            if (m_aParents[uNode] != NO_PARENT)
+            {
+                aSubtreeSizes[m_aParents[uNode]] += aSubtreeSizes[uNode];
+            }
+        }
+
+        m_aSubtreeEnds.resize(uNumNodes);
+        for (UINT uPosition = 0u; uPosition < uNumNodes; ++uPosition)
+        {
+            m_aSubtreeEnds[uPosition] = uPosition + aSubtreeSizes[m_aOrder[uPosition]];
+        }
+
+        m_bOrderDirty = FALSE;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,111 @@
+/*+===================================================================
+  File:      TRANSFORMHIERARCHY.H
+
+  Summary:   TransformHierarchy header file contains declarations of
+             the TransformHierarchy class that keeps local transforms
+             of parented nodes and propagates them to cached world
+             matrices.
+
+  Classes: TransformHierarchy
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Profiler/Profiler.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    TransformHierarchy
+
+      Summary:  Nodes with a local scale, rotation and translation and
+                the index of their parent, kept in parallel arrays.
+                World matrices are cached. The nodes are also laid out
+                in preorder, so every parent comes before its children
+                and every subtree is a contiguous range. Changing a
+                local transform only adds the node to a dirty list,
+                Update then recomputes the subtree range of each dirty
+                node and leaves the rest of the hierarchy alone. Nodes
+                cannot be removed
+
+      Methods:  AddNode
+                  Adds a node under a parent
+                SetParent
+                  Moves a node and its subtree under another parent
+                SetLocalTransform
+                  Replaces the local transform of a node
+                SetScale
+                  Replaces the local scale of a node
+                SetRotation
+                  Replaces the local rotation of a node
+                SetTranslation
+                  Replaces the local translation of a node
+                Update
+                  Recomputes the world matrices that changed
+                GetWorldMatrix
+                  Returns the world matrix of a node
+                GetParent
+                  Returns the parent of a node
+                GetVersion
+                  Returns the version of the world matrix of a node
+                GetNumNodes
+                  Returns the number of nodes
+                GetNumUpdated
+                  Returns the number of nodes the last update
+                  recomputed
+                TransformHierarchy
+                  Constructor.
+                ~TransformHierarchy
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class TransformHierarchy final
+    {
+    public:
+        static constexpr UINT NO_PARENT = 0xFFFFFFFFu;
+
+        TransformHierarchy();
+        TransformHierarchy(const TransformHierarchy& other) = delete;
+        TransformHierarchy(TransformHierarchy&& other) = delete;
+        TransformHierarchy& operator=(const TransformHierarchy& other) = delete;
+        TransformHierarchy& operator=(TransformHierarchy&& other) = delete;
+        ~TransformHierarchy() = default;
+
+        UINT AddNode(_In_ UINT uParent);
+        HRESULT SetParent(_In_ UINT uNode, _In_ UINT uParent);
+
+        void SetLocalTransform(_In_ UINT uNode, _In_ const XMFLOAT3& scale, _In_ const XMFLOAT4& rotation, _In_ const XMFLOAT3& translation);
+        void SetScale(_In_ UINT uNode, _In_ const XMFLOAT3& scale);
+        void SetRotation(_In_ UINT uNode, _In_ const XMFLOAT4& rotation);
+        void SetTranslation(_In_ UINT uNode, _In_ const XMFLOAT3& translation);
+
+        void Update();
+
+        XMMATRIX GetWorldMatrix(_In_ UINT uNode) const;
+        UINT GetParent(_In_ UINT uNode) const;
+        UINT64 GetVersion(_In_ UINT uNode) const;
+        UINT GetNumNodes() const;
+        UINT GetNumUpdated() const;
+
+    private:
+        void markDirty(_In_ UINT uNode);
+        void buildOrder();
+
+    private:
+        std::vector<XMFLOAT3> m_aScales;
+        std::vector<XMFLOAT4> m_aRotations;
+        std::vector<XMFLOAT3> m_aTranslations;
+        std::vector<UINT> m_aParents;
+        std::vector<XMFLOAT4X4A> m_aWorldMatrices;
+        std::vector<UINT64> m_aVersions;
+        std::vector<BYTE> m_aDirty;
+        std::vector<UINT> m_aDirtyNodes;
+        std::vector<UINT> m_aOrder;
+        std::vector<UINT> m_aOrderIndices;
+        std::vector<UINT> m_aSubtreeEnds;
+        UINT m_uNumUpdated;
+        BOOL m_bOrderDirty;
+    };
+}
\ No newline at end of file
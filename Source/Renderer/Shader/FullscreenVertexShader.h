@@ -0,0 +1,48 @@
+/*+===================================================================
+  File:      FULLSCREENVERTEXSHADER.H
+
+  Summary:   FullscreenVertexShader header file contains declarations
+             of FullscreenVertexShader class, a vertex shader that
+             makes its vertices from their index and reads no vertex
+             buffer.
+
+  Classes: FullscreenVertexShader
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Shader/VertexShader.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    FullscreenVertexShader
+
+      Summary:  Vertex shader of full screen passes. It only reads
+                SV_VertexID, so it has no input layout and is drawn
+                with a null one
+
+      Methods:  Initialize
+                  Initializes the vertex shader
+                FullscreenVertexShader
+                  Constructor.
+                ~FullscreenVertexShader
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class FullscreenVertexShader : public VertexShader
+    {
+    public:
+        FullscreenVertexShader() = delete;
+        FullscreenVertexShader(_In_ PCWSTR pszFileName, _In_ PCSTR pszEntryPoint, _In_ PCSTR pszShaderModel);
+        FullscreenVertexShader(const FullscreenVertexShader& other) = delete;
+        FullscreenVertexShader(FullscreenVertexShader&& other) = delete;
+        FullscreenVertexShader& operator=(const FullscreenVertexShader& other) = delete;
+        FullscreenVertexShader& operator=(FullscreenVertexShader&& other) = delete;
+        virtual ~FullscreenVertexShader() = default;
+
+        virtual HRESULT Initialize(_In_ ID3D11Device* pDevice) override;
+    };
+}
\ No newline at end of file
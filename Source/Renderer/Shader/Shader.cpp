@@ -1,5 +1,7 @@
 #include "Shader.h"
 
+#include "Shader/ShaderCache.h"
+
 namespace library
 {
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -42,7 +44,8 @@ namespace library
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Shader::compile
 
-      Summary:  Compiles the given shader file
+      Summary:  Compiles the given shader file, or reads the bytecode
+                from the shader cache if the file did not change
 
       Args:     ID3DBlob** ppOutBlob
                   Receives a pointer to the ID3DBlob interface that you
@@ -67,21 +70,11 @@ namespace library
         dwShaderFlags |= D3DCOMPILE_SKIP_OPTIMIZATION;
 #endif // _DEBUG
 
-        ID3DBlob* pErrorBlob = nullptr;
-        hr = D3DCompileFromFile(m_pszFileName, nullptr, nullptr, m_pszEntryPoint, m_pszShaderModel, dwShaderFlags, 0, ppOutBlob, &pErrorBlob);
+        hr = ShaderCache::Compile(m_pszFileName, m_pszEntryPoint, m_pszShaderModel, dwShaderFlags, ppOutBlob);
         if (FAILED(hr))
         {
-            if (pErrorBlob)
-            {
-                OutputDebugStringA(reinterpret_cast<const char*>(pErrorBlob->GetBufferPointer()));
-                pErrorBlob->Release();
-            }
             return hr;
         }
-        if (pErrorBlob)
-        {
-            pErrorBlob->Release();
-        }
 
         return hr;
     }
@@ -0,0 +1,554 @@
+#include "Shader/ShaderCache.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    ShaderIncludeRecorder
+
+      Summary:  Include handler that opens included files relative to
+                the including file and records every one of them as a
+                dependency of the compiled shader
+
+      Methods:  Open
+                  Reads an included file
+                Close
+                  Frees an included file
+                GetDependencies
+                  Returns the files included so far
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class ShaderIncludeRecorder final : public ID3DInclude
+    {
+    public:
+        ShaderIncludeRecorder(_In_ const std::filesystem::path& sourceDirectory)
+            : m_sourceDirectory(sourceDirectory)
+            , m_directories()
+            , m_aDependencies()
+        {
+            // empty
+        }
+
+        HRESULT __stdcall Open(
+            _In_ D3D_INCLUDE_TYPE includeType,
+            _In_ LPCSTR pszFileName,
+            _In_opt_ LPCVOID pParentData,
+            _Outptr_ LPCVOID* ppData,
+            _Out_ UINT* puBytes
+        ) override
+        {
+            UNREFERENCED_PARAMETER(includeType);
+
+            *ppData = nullptr;
+            *puBytes = 0u;
+
+            auto parent = m_directories.find(pParentData);
+            std::filesystem::path filePath = (parent != m_directories.end() ? parent->second : m_sourceDirectory) / pszFileName;
+
+            HANDLE hFile = CreateFile(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (hFile == INVALID_HANDLE_VALUE)
+            {
+                return HRESULT_FROM_WIN32(GetLastError());
+            }
+
+            LARGE_INTEGER fileSize = {};
+            if (!GetFileSizeEx(hFile, &fileSize) || fileSize.HighPart != 0)
+            {
+                CloseHandle(hFile);
+                return E_FAIL;
+            }
+
+            BYTE* pData = new BYTE[fileSize.LowPart + 1u];
+            DWORD dwBytesRead = 0u;
+            BOOL bRead = ReadFile(hFile, pData, fileSize.LowPart, &dwBytesRead, nullptr);
+            CloseHandle(hFile);
+
+            if (!bRead || dwBytesRead != fileSize.LowPart)
+            {
+                delete[] pData;
+                return E_FAIL;
+            }
+
+            m_directories[pData] = filePath.parent_path();
+            m_aDependencies.push_back(
+                ShaderDependency
+                {
+                    .szPath = filePath.lexically_normal().wstring(),
+                    .uHash = HashBytes(HASH_OFFSET_BASIS, pData, dwBytesRead)
+                }
+            );
+
+            *ppData = pData;
+            *puBytes = dwBytesRead;
+
+            return S_OK;
+        }
+
+        HRESULT __stdcall Close(_In_ LPCVOID pData) override
+        {
+            m_directories.erase(pData);
+            delete[] static_cast<const BYTE*>(pData);
+
+            return S_OK;
+        }
+
+        const std::vector<ShaderDependency>& GetDependencies() const
+        {
+            return m_aDependencies;
+        }
+
+    private:
+        std::filesystem::path m_sourceDirectory;
+        std::unordered_map<LPCVOID, std::filesystem::path> m_directories;
+        std::vector<ShaderDependency> m_aDependencies;
+    };
+
+    BOOL ShaderCache::sm_bCacheEnabled = TRUE;
+    std::filesystem::path ShaderCache::sm_cacheDirectory = L"Cache/Shaders";
+    std::atomic<UINT> ShaderCache::sm_uNumHits = 0u;
+    std::atomic<UINT> ShaderCache::sm_uNumMisses = 0u;
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderCache::Compile
+
+      Summary:  Returns the bytecode of the given shader. The cache
+                file is used if its key matches and none of the files
+                it includes changed, otherwise the shader is compiled
+                and the cache file is written
+
+      Args:     PCWSTR pszFileName
+                  Name of the file that contains the shader code
+                PCSTR pszEntryPoint
+                  Name of the shader entry point function
+                PCSTR pszShaderModel
+                  Shader target to compile against
+                DWORD dwShaderFlags
+                  D3DCOMPILE flags
+                ID3DBlob** ppOutBlob
+                  Receives the compiled code
+
+      Modifies: [sm_uNumHits, sm_uNumMisses].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT ShaderCache::Compile(
+        _In_ PCWSTR pszFileName,
+        _In_ PCSTR pszEntryPoint,
+        _In_ PCSTR pszShaderModel,
+        _In_ DWORD dwShaderFlags,
+        _Outptr_ ID3DBlob** ppOutBlob
+    )
+    {
+        std::filesystem::path sourcePath = pszFileName;
+
+        UINT64 uKey = 0ull;
+        BOOL bHasKey = sm_bCacheEnabled && SUCCEEDED(computeKey(sourcePath, pszEntryPoint, pszShaderModel, dwShaderFlags, uKey));
+
+        std::filesystem::path cacheFilePath;
+        if (bHasKey)
+        {
+            cacheFilePath = getCacheFilePath(sourcePath, pszEntryPoint, uKey);
+            if (SUCCEEDED(load(cacheFilePath, uKey, ppOutBlob)))
+            {
+                ++sm_uNumHits;
+                return S_OK;
+            }
+        }
+
+        ++sm_uNumMisses;
+
+        ShaderIncludeRecorder include(sourcePath.parent_path());
+
+        ComPtr<ID3DBlob> errorBlob;
+        HRESULT hr = D3DCompileFromFile(pszFileName, nullptr, &include, pszEntryPoint, pszShaderModel, dwShaderFlags, 0u, ppOutBlob, errorBlob.GetAddressOf());
+        if (errorBlob)
+        {
+            OutputDebugStringA(reinterpret_cast<const char*>(errorBlob->GetBufferPointer()));
+        }
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        if (bHasKey && FAILED(save(cacheFilePath, uKey, include.GetDependencies(), *ppOutBlob)))
+        {
+            OutputDebugString(L"Error writing shader cache \"");
+            OutputDebugString(cacheFilePath.c_str());
+            OutputDebugString(L"\"\n");
+        }
+
+        return hr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderCache::SetCacheEnabled
+
+      Summary:  Enables or disables the cache
+
+      Args:     BOOL bEnabled
+                  TRUE to read and write cache files
+
+      Modifies: [sm_bCacheEnabled].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ShaderCache::SetCacheEnabled(_In_ BOOL bEnabled)
+    {
+        sm_bCacheEnabled = bEnabled;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderCache::SetCacheDirectory
+
+      Summary:  Sets the directory that holds the cache files
+
+      Args:     const std::filesystem::path& cacheDirectory
+                  Directory of the cache files
+
+      Modifies: [sm_cacheDirectory].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ShaderCache::SetCacheDirectory(_In_ const std::filesystem::path& cacheDirectory)
+    {
+        sm_cacheDirectory = cacheDirectory;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderCache::GetNumHits
+
+      Summary:  Returns the number of shaders read from the cache
+
+      Returns:  UINT
+                  Number of cache hits
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT ShaderCache::GetNumHits()
+    {
+        return sm_uNumHits;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderCache::GetNumMisses
+
+      Summary:  Returns the number of shaders compiled
+
+      Returns:  UINT
+                  Number of cache misses
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT ShaderCache::GetNumMisses()
+    {
+        return sm_uNumMisses;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderCache::computeKey
+
+      Summary:  Hashes the source file contents and path together with
+                the entry point, the profile, the compile flags, the
+                compiler version and the cache version
+
+      Args:     const std::filesystem::path& sourcePath
+                  Path to the shader file
+                PCSTR pszEntryPoint
+                  Name of the shader entry point function
+                PCSTR pszShaderModel
+                  Shader target to compile against
+                DWORD dwShaderFlags
+                  D3DCOMPILE flags
+                UINT64& uOutKey
+                  Computed key
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT ShaderCache::computeKey(
+        _In_ const std::filesystem::path& sourcePath,
+        _In_ PCSTR pszEntryPoint,
+        _In_ PCSTR pszShaderModel,
+        _In_ DWORD dwShaderFlags,
+        _Out_ UINT64& uOutKey
+    )
+    {
+        uOutKey = 0ull;
+
+        UINT64 uHash = 0ull;
+        HRESULT hr = hashFile(sourcePath, uHash);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        std::wstring szPath = sourcePath.lexically_normal().generic_wstring();
+        uHash = HashBytes(uHash, szPath.data(), szPath.size() * sizeof(WCHAR));
+        uHash = HashBytes(uHash, pszEntryPoint, strlen(pszEntryPoint) + 1u);
+        uHash = HashBytes(uHash, pszShaderModel, strlen(pszShaderModel) + 1u);
+        uHash = HashBytes(uHash, &dwShaderFlags, sizeof(dwShaderFlags));
+
+        UINT uCompilerVersion = D3D_COMPILER_VERSION;
+        uHash = HashBytes(uHash, &uCompilerVersion, sizeof(uCompilerVersion));
+
+        UINT uVersion = VERSION;
+        uHash = HashBytes(uHash, &uVersion, sizeof(uVersion));
+
+        uOutKey = uHash;
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderCache::getCacheFilePath
+
+      Summary:  Returns the path to the cache file of the given key
+
+      Args:     const std::filesystem::path& sourcePath
+                  Path to the shader file
+                PCSTR pszEntryPoint
+                  Name of the shader entry point function
+                UINT64 uKey
+                  Key computed by computeKey
+
+      Returns:  std::filesystem::path
+                  Path to the cache file
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    std::filesystem::path ShaderCache::getCacheFilePath(
+        _In_ const std::filesystem::path& sourcePath,
+        _In_ PCSTR pszEntryPoint,
+        _In_ UINT64 uKey
+    )
+    {
+        WCHAR szKey[17];
+        swprintf_s(szKey, L"%016llx", uKey);
+
+        std::string szEntryPoint(pszEntryPoint);
+
+        return sm_cacheDirectory / (sourcePath.stem().wstring() + L"_" + std::wstring(szEntryPoint.begin(), szEntryPoint.end()) + L"_" + szKey + L".shc");
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderCache::hashFile
+
+      Summary:  Hashes the contents of a file
+
+      Args:     const std::filesystem::path& filePath
+                  Path to the file
+                UINT64& uOutHash
+                  Hash of the contents
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT ShaderCache::hashFile(_In_ const std::filesystem::path& filePath, _Out_ UINT64& uOutHash)
+    {
+        uOutHash = HASH_OFFSET_BASIS;
+
+        HANDLE hFile = CreateFile(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (hFile == INVALID_HANDLE_VALUE)
+        {
+            return HRESULT_FROM_WIN32(GetLastError());
+        }
+
+        BYTE aChunk[4096];
+        DWORD dwBytesRead = 0u;
+        BOOL bRead = FALSE;
+        while ((bRead = ReadFile(hFile, aChunk, sizeof(aChunk), &dwBytesRead, nullptr)) && dwBytesRead > 0u)
+        {
+            uOutHash = HashBytes(uOutHash, aChunk, dwBytesRead);
+        }
+
+        CloseHandle(hFile);
+
+        return bRead ? S_OK : E_FAIL;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderCache::load
+
+      Summary:  Reads the bytecode from a cache file. Fails if the file
+                is missing, was written for another key, is truncated
+                or one of the included files changed
+
+      Args:     const std::filesystem::path& cacheFilePath
+                  Path to the cache file
+                UINT64 uKey
+                  Expected key
+                ID3DBlob** ppOutBlob
+                  Receives the cached code
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT ShaderCache::load(_In_ const std::filesystem::path& cacheFilePath, _In_ UINT64 uKey, _Outptr_ ID3DBlob** ppOutBlob)
+    {
+        HANDLE hFile = CreateFile(cacheFilePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (hFile == INVALID_HANDLE_VALUE)
+        {
+            return HRESULT_FROM_WIN32(GetLastError());
+        }
+
+        LARGE_INTEGER fileSize = {};
+        if (!GetFileSizeEx(hFile, &fileSize) || fileSize.HighPart != 0)
+        {
+            CloseHandle(hFile);
+            return E_FAIL;
+        }
+
+        std::vector<BYTE> aData(fileSize.LowPart);
+        DWORD dwBytesRead = 0u;
+        BOOL bRead = ReadFile(hFile, aData.data(), fileSize.LowPart, &dwBytesRead, nullptr);
+        CloseHandle(hFile);
+
+        if (!bRead || dwBytesRead != fileSize.LowPart)
+        {
+            return E_FAIL;
+        }
+
+        const BYTE* pCursor = aData.data();
+        const BYTE* pEnd = pCursor + aData.size();
+        auto read = [&pCursor, pEnd](_Out_writes_bytes_(uSize) void* pOut, _In_ size_t uSize)
+        {
+            if (static_cast<size_t>(pEnd - pCursor) < uSize)
+            {
+                return FALSE;
+            }
+
+            memcpy(pOut, pCursor, uSize);
+            pCursor += uSize;
+
+            return TRUE;
+        };
+
+        UINT uMagic = 0u;
+        UINT uVersion = 0u;
+        UINT64 uFileKey = 0ull;
+        UINT uNumDependencies = 0u;
+        if (!read(&uMagic, sizeof(uMagic)) || !read(&uVersion, sizeof(uVersion)) || !read(&uFileKey, sizeof(uFileKey))
+            || uMagic != MAGIC || uVersion != VERSION || uFileKey != uKey
+            || !read(&uNumDependencies, sizeof(uNumDependencies)))
+        {
+            return E_FAIL;
+        }
+
+        for (UINT i = 0u; i < uNumDependencies; ++i)
+        {
+            UINT uLength = 0u;
+            if (!read(&uLength, sizeof(uLength)) || static_cast<size_t>(pEnd - pCursor) < uLength * sizeof(WCHAR))
+            {
+                return E_FAIL;
+            }
+
+            std::wstring szPath(uLength, L'\0');
+            UINT64 uHash = 0ull;
+            if (!read(szPath.data(), uLength * sizeof(WCHAR)) || !read(&uHash, sizeof(uHash)))
+            {
+                return E_FAIL;
+            }
+
+            UINT64 uCurrentHash = 0ull;
+            if (FAILED(hashFile(szPath, uCurrentHash)) || uCurrentHash != uHash)
+            {
+                return E_FAIL;
+            }
+        }
+
+        UINT uBlobSize = 0u;
+        if (!read(&uBlobSize, sizeof(uBlobSize)) || uBlobSize == 0u || static_cast<size_t>(pEnd - pCursor) != uBlobSize)
+        {
+            return E_FAIL;
+        }
+
+        HRESULT hr = D3DCreateBlob(uBlobSize, ppOutBlob);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        memcpy((*ppOutBlob)->GetBufferPointer(), pCursor, uBlobSize);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderCache::save
+
+      Summary:  Writes the bytecode and the included files to a cache
+                file. The file is written next to the destination and
+                then moved over it, so a crash never leaves a partial
+                cache file behind
+
+      Args:     const std::filesystem::path& cacheFilePath
+                  Path to the cache file
+                UINT64 uKey
+                  Key computed by computeKey
+                const std::vector<ShaderDependency>& aDependencies
+                  Files included by the shader
+                ID3DBlob* pBlob
+                  Compiled code
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT ShaderCache::save(
+        _In_ const std::filesystem::path& cacheFilePath,
+        _In_ UINT64 uKey,
+        _In_ const std::vector<ShaderDependency>& aDependencies,
+        _In_ ID3DBlob* pBlob
+    )
+    {
+        std::error_code errorCode;
+        std::filesystem::create_directories(sm_cacheDirectory, errorCode);
+        if (errorCode)
+        {
+            return HRESULT_FROM_WIN32(errorCode.value());
+        }
+
+        std::vector<BYTE> aBuffer;
+        auto write = [&aBuffer](_In_reads_bytes_(uSize) const void* pData, _In_ size_t uSize)
+        {
+            const BYTE* pBytes = static_cast<const BYTE*>(pData);
+            aBuffer.insert(aBuffer.end(), pBytes, pBytes + uSize);
+        };
+
+        UINT uMagic = MAGIC;
+        UINT uVersion = VERSION;
+        UINT uNumDependencies = static_cast<UINT>(aDependencies.size());
+        write(&uMagic, sizeof(uMagic));
+        write(&uVersion, sizeof(uVersion));
+        write(&uKey, sizeof(uKey));
+        write(&uNumDependencies, sizeof(uNumDependencies));
+
+        for (const ShaderDependency& dependency : aDependencies)
+        {
+            UINT uLength = static_cast<UINT>(dependency.szPath.size());
+            write(&uLength, sizeof(uLength));
+            write(dependency.szPath.data(), uLength * sizeof(WCHAR));
+            write(&dependency.uHash, sizeof(dependency.uHash));
+        }
+
+        UINT uBlobSize = static_cast<UINT>(pBlob->GetBufferSize());
+        write(&uBlobSize, sizeof(uBlobSize));
+        write(pBlob->GetBufferPointer(), uBlobSize);
+
+        std::filesystem::path tempFilePath = cacheFilePath;
+        tempFilePath += L".tmp";
+
+        HANDLE hFile = CreateFile(tempFilePath.c_str(), GENERIC_WRITE, 0u, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (hFile == INVALID_HANDLE_VALUE)
+        {
+            return HRESULT_FROM_WIN32(GetLastError());
+        }
+
+        DWORD dwBytesWritten = 0u;
+        BOOL bWritten = WriteFile(hFile, aBuffer.data(), static_cast<DWORD>(aBuffer.size()), &dwBytesWritten, nullptr);
+        CloseHandle(hFile);
+
+        if (!bWritten || dwBytesWritten != aBuffer.size())
+        {
+            DeleteFile(tempFilePath.c_str());
+            return E_FAIL;
+        }
+
+        if (!MoveFileEx(tempFilePath.c_str(), cacheFilePath.c_str(), MOVEFILE_REPLACE_EXISTING))
+        {
+            HRESULT hr = HRESULT_FROM_WIN32(GetLastError());
+            DeleteFile(tempFilePath.c_str());
+            return hr;
+        }
+
+        return S_OK;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+/*+===================================================================
+  File:      SHADERCACHE.H
+
+  Summary:   ShaderCache header file contains declaration of class
+             ShaderCache that keeps compiled shader bytecode on disk
+             so that unchanged shaders are not recompiled on every
+             launch.
+
+  Classes: ShaderCache
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include <atomic>
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   ShaderDependency
+
+      Summary:  File included while compiling a shader and the hash of
+                its contents at that time
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct ShaderDependency
+    {
+        std::wstring szPath;
+        UINT64 uHash;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    ShaderCache
+
+      Summary:  Compiles shaders through a bytecode cache. Cache files
+                are keyed by a hash of the source file, its path, the
+                entry point, the profile, the compile flags and the
+                compiler version. Every included file is recorded with
+                a hash of its contents, a cache file whose includes
+                changed is compiled again
+
+      Methods:  Compile
+                  Returns the bytecode of the given shader, from the
+                  cache if it is up to date
+                SetCacheEnabled
+                  Enables or disables reading and writing the cache,
+                  disabling it measures cold compilation
+                SetCacheDirectory
+                  Sets the directory that holds the cache files
+                GetNumHits
+                  Returns the number of shaders read from the cache
+                GetNumMisses
+                  Returns the number of shaders compiled
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class ShaderCache
+    {
+    public:
+        static constexpr UINT MAGIC = 0x43524853u;  // "SHRC"
+        static constexpr UINT VERSION = 1u;
+
+        ShaderCache() = delete;
+        ShaderCache(const ShaderCache& other) = delete;
+        ShaderCache(ShaderCache&& other) = delete;
+        ShaderCache& operator=(const ShaderCache& other) = delete;
+        ShaderCache& operator=(ShaderCache&& other) = delete;
+        ~ShaderCache() = delete;
+
+        static HRESULT Compile(
+            _In_ PCWSTR pszFileName,
+            _In_ PCSTR pszEntryPoint,
+            _In_ PCSTR pszShaderModel,
+            _In_ DWORD dwShaderFlags,
+            _Outptr_ ID3DBlob** ppOutBlob
+        );
+        static void SetCacheEnabled(_In_ BOOL bEnabled);
+        static void SetCacheDirectory(_In_ const std::filesystem::path& cacheDirectory);
+
+        static UINT GetNumHits();
+        static UINT GetNumMisses();
+
+    private:
+        static HRESULT computeKey(
+            _In_ const std::filesystem::path& sourcePath,
+            _In_ PCSTR pszEntryPoint,
+            _In_ PCSTR pszShaderModel,
+            _In_ DWORD dwShaderFlags,
+            _Out_ UINT64& uOutKey
+        );
+        static std::filesystem::path getCacheFilePath(
+            _In_ const std::filesystem::path& sourcePath,
+            _In_ PCSTR pszEntryPoint,
+            _In_ UINT64 uKey
+        );
+        static HRESULT hashFile(_In_ const std::filesystem::path& filePath, _Out_ UINT64& uOutHash);
+        static HRESULT load(_In_ const std::filesystem::path& cacheFilePath, _In_ UINT64 uKey, _Outptr_ ID3DBlob** ppOutBlob);
+        static HRESULT save(
+            _In_ const std::filesystem::path& cacheFilePath,
+            _In_ UINT64 uKey,
+            _In_ const std::vector<ShaderDependency>& aDependencies,
+            _In_ ID3DBlob* pBlob
+        );
+
+    private:
+        static BOOL sm_bCacheEnabled;
+        static std::filesystem::path sm_cacheDirectory;
+        static std::atomic<UINT> sm_uNumHits;
+        static std::atomic<UINT> sm_uNumMisses;
+    };
+}
\ No newline at end of file
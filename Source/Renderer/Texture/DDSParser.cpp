@@ -0,0 +1,578 @@
+#include "Texture/DDSParser.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DDSParser::ParseHeader
+
+      Summary:  Validates the magic number and header of a DDS file
+                and reads the description of its texture. Only the
+                headers are read, the surfaces may be missing
+
+      Args:     const uint8_t* pData
+                  Start of the file
+                size_t uSize
+                  Bytes available at pData
+                DDSTextureInfo& outInfo
+                  Description of the texture
+
+      Returns:  eDDSStatus
+                  OK, or why the file can not be read
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    eDDSStatus DDSParser::ParseHeader(const uint8_t* pData, size_t uSize, DDSTextureInfo& outInfo)
+    {
+        outInfo = DDSTextureInfo
+        {
+            .uWidth = 0u,
+            .uHeight = 0u,
+            .uDepth = 1u,
+            .uArraySize = 1u,
+            .uNumMips = 1u,
+            .format = eDDSFormat::UNKNOWN,
+            .dimension = eDDSDimension::TEXTURE2D,
+            .bCubeMap = false,
+            .uDataOffset = sizeof(uint32_t) + HEADER_SIZE
+        };
+
+        if (!pData)
+        {
+            return eDDSStatus::INVALID_ARGUMENT;
+        }
+
+        if (uSize < sizeof(uint32_t) + HEADER_SIZE)
+        {
+            return eDDSStatus::TRUNCATED;
+        }
+
+        const uint8_t* pHeader = pData + sizeof(uint32_t);
+        if (readUInt32(pData) != MAGIC
+            || readUInt32(pHeader) != HEADER_SIZE
+            || readUInt32(pHeader + HEADER_PIXEL_FORMAT) != PIXEL_FORMAT_SIZE)
+        {
+            return eDDSStatus::INVALID_FILE;
+        }
+
+        const uint32_t uFlags = readUInt32(pHeader + HEADER_FLAGS);
+        outInfo.uWidth = readUInt32(pHeader + HEADER_WIDTH);
+        outInfo.uHeight = readUInt32(pHeader + HEADER_HEIGHT);
+
+        const uint32_t uNumMips = readUInt32(pHeader + HEADER_MIP_COUNT);
+        outInfo.uNumMips = uNumMips > 0u ? uNumMips : 1u;
+        if (outInfo.uNumMips > MAX_MIPS)
+        {
+            return eDDSStatus::UNSUPPORTED;
+        }
+
+        const uint8_t* pPixelFormat = pHeader + HEADER_PIXEL_FORMAT;
+        if ((readUInt32(pPixelFormat + PIXEL_FORMAT_FLAGS) & DDPF_FOURCC) && readUInt32(pPixelFormat + PIXEL_FORMAT_FOURCC) == FOURCC_DX10)
+        {
+            if (uSize < sizeof(uint32_t) + HEADER_SIZE + DX10_HEADER_SIZE)
+            {
+                return eDDSStatus::TRUNCATED;
+            }
+
+            const uint8_t* pDx10Header = pHeader + HEADER_SIZE;
+            outInfo.format = static_cast<eDDSFormat>(readUInt32(pDx10Header + DX10_FORMAT));
+            outInfo.uArraySize = readUInt32(pDx10Header + DX10_ARRAY_SIZE);
+            outInfo.uDataOffset += DX10_HEADER_SIZE;
+            if (outInfo.uArraySize == 0u)
+            {
+                return eDDSStatus::INVALID_FILE;
+            }
+
+            switch (static_cast<eDDSDimension>(readUInt32(pDx10Header + DX10_DIMENSION)))
+            {
+            case eDDSDimension::TEXTURE1D:
+                if ((uFlags & DDSD_HEIGHT) && outInfo.uHeight != 1u)
+                {
+                    return eDDSStatus::INVALID_FILE;
+                }
+                outInfo.uHeight = 1u;
+                outInfo.dimension = eDDSDimension::TEXTURE1D;
+                break;
+
+            case eDDSDimension::TEXTURE2D:
+                outInfo.bCubeMap = (readUInt32(pDx10Header + DX10_MISC_FLAGS) & RESOURCE_MISC_TEXTURECUBE) != 0u;
+                break;
+
+            case eDDSDimension::TEXTURE3D:
+                if (!(uFlags & DDSD_DEPTH) || outInfo.uArraySize != 1u)
+                {
+                    return eDDSStatus::INVALID_FILE;
+                }
+                outInfo.uDepth = readUInt32(pHeader + HEADER_DEPTH);
+                outInfo.dimension = eDDSDimension::TEXTURE3D;
+                break;
+
+            default:
+                return eDDSStatus::INVALID_FILE;
+            }
+        }
+        else
+        {
+            outInfo.format = getLegacyFormat(pPixelFormat);
+
+            if (uFlags & DDSD_DEPTH)
+            {
+                outInfo.uDepth = readUInt32(pHeader + HEADER_DEPTH);
+                outInfo.dimension = eDDSDimension::TEXTURE3D;
+            }
+            else if (readUInt32(pHeader + HEADER_CAPS2) & DDSCAPS2_CUBEMAP)
+            {
+                // Cube maps without all their faces can not be created
+                if ((readUInt32(pHeader + HEADER_CAPS2) & DDSCAPS2_CUBEMAP_ALLFACES) != DDSCAPS2_CUBEMAP_ALLFACES)
+                {
+                    return eDDSStatus::UNSUPPORTED;
+                }
+                outInfo.bCubeMap = true;
+            }
+        }
+
+        if (outInfo.uWidth == 0u || outInfo.uHeight == 0u || outInfo.uDepth == 0u)
+        {
+            return eDDSStatus::INVALID_FILE;
+        }
+
+        if (GetBitsPerPixel(outInfo.format) == 0u)
+        {
+            return eDDSStatus::UNSUPPORTED;
+        }
+
+        return eDDSStatus::OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DDSParser::GetSurfaces
+
+      Summary:  Lays out the surfaces of a texture in the order the
+                file stores them: every mip of the first array item
+                (or cube face), then every mip of the next one
+
+      Args:     const DDSTextureInfo& info
+                  Texture read by ParseHeader
+                size_t uFileSize
+                  Size of the file, every surface must fit in it
+                std::vector<DDSSurface>& outSurfaces
+                  Surfaces, mips of one item are consecutive
+
+      Returns:  eDDSStatus
+                  OK, TRUNCATED if the file is too short
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    eDDSStatus DDSParser::GetSurfaces(const DDSTextureInfo& info, size_t uFileSize, std::vector<DDSSurface>& outSurfaces)
+    {
+        outSurfaces.clear();
+
+        const uint32_t uNumItems = info.uArraySize * (info.bCubeMap ? 6u : 1u);
+        outSurfaces.reserve(static_cast<size_t>(uNumItems) * info.uNumMips);
+
+        size_t uOffset = info.uDataOffset;
+        for (uint32_t uItem = 0u; uItem < uNumItems; ++uItem)
+        {
+            uint32_t uWidth = info.uWidth;
+            uint32_t uHeight = info.uHeight;
+            uint32_t uDepth = info.uDepth;
+            for (uint32_t uMip = 0u; uMip < info.uNumMips; ++uMip)
+            {
+                DDSSurface surface =
+                {
+                    .uOffset = uOffset,
+                    .uNumBytes = 0u,
+                    .uRowBytes = 0u,
+                    .uSliceBytes = 0u,
+                    .uNumRows = 0u,
+                    .uWidth = uWidth,
+                    .uHeight = uHeight,
+                    .uDepth = uDepth
+                };
+
+                eDDSStatus status = GetSurfaceInfo(info.format, uWidth, uHeight, surface.uSliceBytes, surface.uRowBytes, surface.uNumRows);
+                if (status != eDDSStatus::OK)
+                {
+                    outSurfaces.clear();
+                    return status;
+                }
+
+                surface.uNumBytes = surface.uSliceBytes * uDepth;
+                if (uOffset > uFileSize || surface.uNumBytes > uFileSize - uOffset)
+                {
+                    outSurfaces.clear();
+                    return eDDSStatus::TRUNCATED;
+                }
+
+                outSurfaces.push_back(surface);
+                uOffset += surface.uNumBytes;
+
+                uWidth = uWidth > 1u ? uWidth >> 1u : 1u;
+                uHeight = uHeight > 1u ? uHeight >> 1u : 1u;
+                uDepth = uDepth > 1u ? uDepth >> 1u : 1u;
+            }
+        }
+
+        return eDDSStatus::OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DDSParser::GetSurfaceInfo
+
+      Summary:  Returns the size of one 2D surface. Compressed formats
+                round up to whole 4x4 blocks
+
+      Args:     eDDSFormat format
+                  Format of the surface
+                uint32_t uWidth
+                  Width in texels
+                uint32_t uHeight
+                  Height in texels
+                size_t& outNumBytes
+                  Bytes of the surface
+                size_t& outRowBytes
+                  Bytes of a row of texels or blocks
+                uint32_t& outNumRows
+                  Number of rows of texels or blocks
+
+      Returns:  eDDSStatus
+                  OK, UNSUPPORTED for an unknown format or a surface
+                  too large to address
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    eDDSStatus DDSParser::GetSurfaceInfo(
+        eDDSFormat format,
+        uint32_t uWidth,
+        uint32_t uHeight,
+        size_t& outNumBytes,
+        size_t& outRowBytes,
+        uint32_t& outNumRows
+    )
+    {
+        outNumBytes = 0u;
+        outRowBytes = 0u;
+        outNumRows = 0u;
+
+        uint64_t uRowBytes = 0u;
+        uint32_t uNumRows = 0u;
+
+        const uint32_t uBlockSize = GetBlockSize(format);
+        if (uBlockSize > 0u)
+        {
+            const uint64_t uNumBlocksWide = uWidth > 0u ? (static_cast<uint64_t>(uWidth) + 3u) / 4u : 0u;
+            uRowBytes = uNumBlocksWide * uBlockSize;
+            uNumRows = uHeight > 0u ? static_cast<uint32_t>((static_cast<uint64_t>(uHeight) + 3u) / 4u) : 0u;
+        }
+        else
+        {
+            const uint32_t uBitsPerPixel = GetBitsPerPixel(format);
+            if (uBitsPerPixel == 0u)
+            {
+                return eDDSStatus::UNSUPPORTED;
+            }
+
+            uRowBytes = (static_cast<uint64_t>(uWidth) * uBitsPerPixel + 7u) / 8u;
+            uNumRows = uHeight;
+        }
+
+        const uint64_t uNumBytes = uRowBytes * uNumRows;
+        if (uNumBytes > SIZE_MAX)
+        {
+            return eDDSStatus::UNSUPPORTED;
+        }
+
+        outNumBytes = static_cast<size_t>(uNumBytes);
+        outRowBytes = static_cast<size_t>(uRowBytes);
+        outNumRows = uNumRows;
+
+        return eDDSStatus::OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DDSParser::GetBitsPerPixel
+
+      Summary:  Returns the bits a texel of a format takes, on average
+                for compressed formats
+
+      Args:     eDDSFormat format
+                  Format
+
+      Returns:  uint32_t
+                  Bits per texel, 0 for formats the parser does not know
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t DDSParser::GetBitsPerPixel(eDDSFormat format)
+    {
+        switch (format)
+        {
+        case eDDSFormat::R32G32B32A32_FLOAT:
+            return 128u;
+
+        case eDDSFormat::R16G16B16A16_FLOAT:
+        case eDDSFormat::R16G16B16A16_UNORM:
+        case eDDSFormat::R32G32_FLOAT:
+            return 64u;
+
+        case eDDSFormat::R10G10B10A2_UNORM:
+        case eDDSFormat::R8G8B8A8_UNORM:
+        case eDDSFormat::R8G8B8A8_UNORM_SRGB:
+        case eDDSFormat::R16G16_FLOAT:
+        case eDDSFormat::R16G16_UNORM:
+        case eDDSFormat::R32_FLOAT:
+        case eDDSFormat::B8G8R8A8_UNORM:
+        case eDDSFormat::B8G8R8X8_UNORM:
+        case eDDSFormat::B8G8R8A8_UNORM_SRGB:
+        case eDDSFormat::B8G8R8X8_UNORM_SRGB:
+            return 32u;
+
+        case eDDSFormat::R8G8_UNORM:
+        case eDDSFormat::R16_FLOAT:
+        case eDDSFormat::R16_UNORM:
+        case eDDSFormat::B5G6R5_UNORM:
+        case eDDSFormat::B5G5R5A1_UNORM:
+        case eDDSFormat::B4G4R4A4_UNORM:
+            return 16u;
+
+        case eDDSFormat::R8_UNORM:
+        case eDDSFormat::A8_UNORM:
+        case eDDSFormat::BC2_TYPELESS:
+        case eDDSFormat::BC2_UNORM:
+        case eDDSFormat::BC2_UNORM_SRGB:
+        case eDDSFormat::BC3_TYPELESS:
+        case eDDSFormat::BC3_UNORM:
+        case eDDSFormat::BC3_UNORM_SRGB:
+        case eDDSFormat::BC5_TYPELESS:
+        case eDDSFormat::BC5_UNORM:
+        case eDDSFormat::BC5_SNORM:
+        case eDDSFormat::BC6H_TYPELESS:
+        case eDDSFormat::BC6H_UF16:
+        case eDDSFormat::BC6H_SF16:
+        case eDDSFormat::BC7_TYPELESS:
+        case eDDSFormat::BC7_UNORM:
+        case eDDSFormat::BC7_UNORM_SRGB:
+            return 8u;
+
+        case eDDSFormat::BC1_TYPELESS:
+        case eDDSFormat::BC1_UNORM:
+        case eDDSFormat::BC1_UNORM_SRGB:
+        case eDDSFormat::BC4_TYPELESS:
+        case eDDSFormat::BC4_UNORM:
+        case eDDSFormat::BC4_SNORM:
+            return 4u;
+
+        default:
+            return 0u;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DDSParser::GetBlockSize
+
+      Summary:  Returns the bytes of a 4x4 block of a compressed format
+
+      Args:     eDDSFormat format
+                  Format
+
+      Returns:  uint32_t
+                  Bytes per block, 0 for uncompressed formats
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t DDSParser::GetBlockSize(eDDSFormat format)
+    {
+        switch (format)
+        {
+        case eDDSFormat::BC1_TYPELESS:
+        case eDDSFormat::BC1_UNORM:
+        case eDDSFormat::BC1_UNORM_SRGB:
+        case eDDSFormat::BC4_TYPELESS:
+        case eDDSFormat::BC4_UNORM:
+        case eDDSFormat::BC4_SNORM:
+            return 8u;
+
+        case eDDSFormat::BC2_TYPELESS:
+        case eDDSFormat::BC2_UNORM:
+        case eDDSFormat::BC2_UNORM_SRGB:
+        case eDDSFormat::BC3_TYPELESS:
+        case eDDSFormat::BC3_UNORM:
+        case eDDSFormat::BC3_UNORM_SRGB:
+        case eDDSFormat::BC5_TYPELESS:
+        case eDDSFormat::BC5_UNORM:
+        case eDDSFormat::BC5_SNORM:
+        case eDDSFormat::BC6H_TYPELESS:
+        case eDDSFormat::BC6H_UF16:
+        case eDDSFormat::BC6H_SF16:
+        case eDDSFormat::BC7_TYPELESS:
+        case eDDSFormat::BC7_UNORM:
+        case eDDSFormat::BC7_UNORM_SRGB:
+            return 16u;
+
+        default:
+            return 0u;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DDSParser::readUInt32
+
+      Summary:  Reads a little endian 32-bit value from any address
+
+      Args:     const uint8_t* pData
+                  First byte of the value
+
+      Returns:  uint32_t
+                  Value
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t DDSParser::readUInt32(const uint8_t* pData)
+    {
+        return static_cast<uint32_t>(pData[0])
+            | (static_cast<uint32_t>(pData[1]) << 8u)
+            | (static_cast<uint32_t>(pData[2]) << 16u)
+            | (static_cast<uint32_t>(pData[3]) << 24u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DDSParser::getLegacyFormat
+
+      Summary:  Maps the pixel format of a header without the DX10
+                extension to a format, following the FourCC codes and
+                bit masks D3DX and the DirectX Texture Tool write
+
+      Args:     const uint8_t* pPixelFormat
+                  Pixel format in the header
+
+      Returns:  eDDSFormat
+                  Format, UNKNOWN if it has no equivalent
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    eDDSFormat DDSParser::getLegacyFormat(const uint8_t* pPixelFormat)
+    {
+        const uint32_t uFlags = readUInt32(pPixelFormat + PIXEL_FORMAT_FLAGS);
+        const uint32_t uBitCount = readUInt32(pPixelFormat + PIXEL_FORMAT_BIT_COUNT);
+        const uint32_t uRedMask = readUInt32(pPixelFormat + PIXEL_FORMAT_MASKS);
+        const uint32_t uGreenMask = readUInt32(pPixelFormat + PIXEL_FORMAT_MASKS + 4u);
+        const uint32_t uBlueMask = readUInt32(pPixelFormat + PIXEL_FORMAT_MASKS + 8u);
+        const uint32_t uAlphaMask = readUInt32(pPixelFormat + PIXEL_FORMAT_MASKS + 12u);
+
+        auto hasMasks = [=](uint32_t uRed, uint32_t uGreen, uint32_t uBlue, uint32_t uAlpha)
+        {
+            return uRedMask == uRed && uGreenMask == uGreen && uBlueMask == uBlue && uAlphaMask == uAlpha;
+        };
+
+        if (uFlags & DDPF_RGB)
+        {
+            if (uBitCount == 32u)
+            {
+                if (hasMasks(0x000000ffu, 0x0000ff00u, 0x00ff0000u, 0xff000000u))
+                {
+                    return eDDSFormat::R8G8B8A8_UNORM;
+                }
+                if (hasMasks(0x00ff0000u, 0x0000ff00u, 0x000000ffu, 0xff000000u))
+                {
+                    return eDDSFormat::B8G8R8A8_UNORM;
+                }
+                if (hasMasks(0x00ff0000u, 0x0000ff00u, 0x000000ffu, 0x00000000u))
+                {
+                    return eDDSFormat::B8G8R8X8_UNORM;
+                }
+                if (hasMasks(0x0000ffffu, 0xffff0000u, 0x00000000u, 0x00000000u))
+                {
+                    return eDDSFormat::R16G16_UNORM;
+                }
+                if (hasMasks(0xffffffffu, 0x00000000u, 0x00000000u, 0x00000000u))
+                {
+                    return eDDSFormat::R32_FLOAT;
+                }
+            }
+            else if (uBitCount == 16u)
+            {
+                if (hasMasks(0xf800u, 0x07e0u, 0x001fu, 0x0000u))
+                {
+                    return eDDSFormat::B5G6R5_UNORM;
+                }
+                if (hasMasks(0x7c00u, 0x03e0u, 0x001fu, 0x8000u))
+                {
+                    return eDDSFormat::B5G5R5A1_UNORM;
+                }
+                if (hasMasks(0x0f00u, 0x00f0u, 0x000fu, 0xf000u))
+                {
+                    return eDDSFormat::B4G4R4A4_UNORM;
+                }
+            }
+
+            return eDDSFormat::UNKNOWN;
+        }
+
+        if (uFlags & DDPF_LUMINANCE)
+        {
+            if (uBitCount == 8u && hasMasks(0xffu, 0u, 0u, 0u))
+            {
+                return eDDSFormat::R8_UNORM;
+            }
+            if (uBitCount == 16u && hasMasks(0xffffu, 0u, 0u, 0u))
+            {
+                return eDDSFormat::R16_UNORM;
+            }
+            if (uBitCount == 16u && hasMasks(0x00ffu, 0u, 0u, 0xff00u))
+            {
+                return eDDSFormat::R8G8_UNORM;
+            }
+
+            return eDDSFormat::UNKNOWN;
+        }
+
+        if (uFlags & DDPF_ALPHA)
+        {
+            return uBitCount == 8u ? eDDSFormat::A8_UNORM : eDDSFormat::UNKNOWN;
+        }
+
+        if (uFlags & DDPF_FOURCC)
+        {
+            switch (readUInt32(pPixelFormat + PIXEL_FORMAT_FOURCC))
+            {
+            case FOURCC_DXT1:
+                return eDDSFormat::BC1_UNORM;
+
+            // Premultiplied alpha is not tracked, DXT2 and DXT4 load like DXT3 and DXT5
+            case FOURCC_DXT2:
+            case FOURCC_DXT3:
+                return eDDSFormat::BC2_UNORM;
+
+            case FOURCC_DXT4:
+            case FOURCC_DXT5:
+                return eDDSFormat::BC3_UNORM;
+
+            case FOURCC_ATI1:
+            case FOURCC_BC4U:
+                return eDDSFormat::BC4_UNORM;
+
+            case FOURCC_BC4S:
+                return eDDSFormat::BC4_SNORM;
+
+            case FOURCC_ATI2:
+            case FOURCC_BC5U:
+                return eDDSFormat::BC5_UNORM;
+
+            case FOURCC_BC5S:
+                return eDDSFormat::BC5_SNORM;
+
+            // D3DFORMAT values some writers store as FourCC codes
+            case 36u:  // D3DFMT_A16B16G16R16
+                return eDDSFormat::R16G16B16A16_UNORM;
+
+            case 111u:  // D3DFMT_R16F
+                return eDDSFormat::R16_FLOAT;
+
+            case 112u:  // D3DFMT_G16R16F
+                return eDDSFormat::R16G16_FLOAT;
+
+            case 113u:  // D3DFMT_A16B16G16R16F
+                return eDDSFormat::R16G16B16A16_FLOAT;
+
+            case 114u:  // D3DFMT_R32F
+                return eDDSFormat::R32_FLOAT;
+
+            case 115u:  // D3DFMT_G32R32F
+                return eDDSFormat::R32G32_FLOAT;
+
+            case 116u:  // D3DFMT_A32B32G32R32F
+                return eDDSFormat::R32G32B32A32_FLOAT;
+
+            default:
+                return eDDSFormat::UNKNOWN;
+            }
+        }
+
+        return eDDSFormat::UNKNOWN;
+    }
+}
\ No newline at end of file
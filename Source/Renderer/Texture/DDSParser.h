@@ -0,0 +1,239 @@
+/*+===================================================================
+  File:      DDSPARSER.H
+
+  Summary:   DDSParser header file contains declaration of class
+             DDSParser that reads the header of a DDS file and lays
+             out its surfaces. It only depends on the standard library,
+             not on Common.h or any Windows header, so it builds and
+             runs on any platform.
+
+  Classes:  DDSParser
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace library
+{
+    /*E+E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E
+      Enum:     eDDSFormat
+
+      Summary:  Pixel formats the parser knows the layout of. The
+                values are those of DXGI_FORMAT, so a format casts to
+                and from it
+    E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E-E*/
+    enum class eDDSFormat : uint32_t
+    {
+        UNKNOWN = 0,
+        R32G32B32A32_FLOAT = 2,
+        R16G16B16A16_FLOAT = 10,
+        R16G16B16A16_UNORM = 11,
+        R32G32_FLOAT = 16,
+        R10G10B10A2_UNORM = 24,
+        R8G8B8A8_UNORM = 28,
+        R8G8B8A8_UNORM_SRGB = 29,
+        R16G16_FLOAT = 34,
+        R16G16_UNORM = 35,
+        R32_FLOAT = 41,
+        R8G8_UNORM = 49,
+        R16_FLOAT = 54,
+        R16_UNORM = 56,
+        R8_UNORM = 61,
+        A8_UNORM = 65,
+        BC1_TYPELESS = 70,
+        BC1_UNORM = 71,
+        BC1_UNORM_SRGB = 72,
+        BC2_TYPELESS = 73,
+        BC2_UNORM = 74,
+        BC2_UNORM_SRGB = 75,
+        BC3_TYPELESS = 76,
+        BC3_UNORM = 77,
+        BC3_UNORM_SRGB = 78,
+        BC4_TYPELESS = 79,
+        BC4_UNORM = 80,
+        BC4_SNORM = 81,
+        BC5_TYPELESS = 82,
+        BC5_UNORM = 83,
+        BC5_SNORM = 84,
+        B5G6R5_UNORM = 85,
+        B5G5R5A1_UNORM = 86,
+        B8G8R8A8_UNORM = 87,
+        B8G8R8X8_UNORM = 88,
+        B8G8R8A8_UNORM_SRGB = 91,
+        B8G8R8X8_UNORM_SRGB = 93,
+        BC6H_TYPELESS = 94,
+        BC6H_UF16 = 95,
+        BC6H_SF16 = 96,
+        BC7_TYPELESS = 97,
+        BC7_UNORM = 98,
+        BC7_UNORM_SRGB = 99,
+        B4G4R4A4_UNORM = 115,
+    };
+
+    /*E+E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E
+      Enum:     eDDSDimension
+
+      Summary:  Kind of texture, the values are those of
+                D3D11_RESOURCE_DIMENSION
+    E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E-E*/
+    enum class eDDSDimension : uint32_t
+    {
+        TEXTURE1D = 2,
+        TEXTURE2D = 3,
+        TEXTURE3D = 4,
+    };
+
+    /*E+E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E
+      Enum:     eDDSStatus
+
+      Summary:  Result of parsing, the parser reports errors as values
+                rather than HRESULTs to stay free of Windows headers
+    E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E-E*/
+    enum class eDDSStatus : uint32_t
+    {
+        OK = 0,
+        INVALID_ARGUMENT,
+        INVALID_FILE,
+        TRUNCATED,
+        UNSUPPORTED,
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   DDSTextureInfo
+
+      Summary:  Description of the texture stored in a DDS file. A cube
+                map has six items per array element. The data offset is
+                where the first surface starts in the file
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct DDSTextureInfo
+    {
+        uint32_t uWidth;
+        uint32_t uHeight;
+        uint32_t uDepth;
+        uint32_t uArraySize;
+        uint32_t uNumMips;
+        eDDSFormat format;
+        eDDSDimension dimension;
+        bool bCubeMap;
+        size_t uDataOffset;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   DDSSurface
+
+      Summary:  One mip level of one array item, at an offset from the
+                start of the file. Rows are rows of blocks for block
+                compressed formats. A volume level holds all its depth
+                slices, one slice taking uSliceBytes
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct DDSSurface
+    {
+        size_t uOffset;
+        size_t uNumBytes;
+        size_t uRowBytes;
+        size_t uSliceBytes;
+        uint32_t uNumRows;
+        uint32_t uWidth;
+        uint32_t uHeight;
+        uint32_t uDepth;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    DDSParser
+
+      Summary:  Reads DDS files from memory without copying them, so
+                the surfaces can point straight into a mapped file.
+                Fields are read byte by byte, the data needs no
+                alignment. Legacy headers are mapped to the formats
+                above, DX10 headers must use one of them
+
+      Methods:  ParseHeader
+                  Reads the description of the texture
+                GetSurfaces
+                  Lays out every surface of the texture in the file
+                GetSurfaceInfo
+                  Returns the size of one surface of a format
+                GetBitsPerPixel
+                  Returns the bits per texel of a format
+                GetBlockSize
+                  Returns the bytes of a block of a compressed format
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class DDSParser final
+    {
+    public:
+        static constexpr uint32_t MAGIC = 0x20534444u;  // "DDS "
+        static constexpr size_t HEADER_SIZE = 124u;
+        static constexpr size_t DX10_HEADER_SIZE = 20u;
+        static constexpr uint32_t MAX_MIPS = 15u;
+
+        DDSParser() = delete;
+        DDSParser(const DDSParser& other) = delete;
+        DDSParser(DDSParser&& other) = delete;
+        DDSParser& operator=(const DDSParser& other) = delete;
+        DDSParser& operator=(DDSParser&& other) = delete;
+        ~DDSParser() = delete;
+
+        static eDDSStatus ParseHeader(const uint8_t* pData, size_t uSize, DDSTextureInfo& outInfo);
+        static eDDSStatus GetSurfaces(const DDSTextureInfo& info, size_t uFileSize, std::vector<DDSSurface>& outSurfaces);
+        static eDDSStatus GetSurfaceInfo(
+            eDDSFormat format,
+            uint32_t uWidth,
+            uint32_t uHeight,
+            size_t& outNumBytes,
+            size_t& outRowBytes,
+            uint32_t& outNumRows
+        );
+        static uint32_t GetBitsPerPixel(eDDSFormat format);
+        static uint32_t GetBlockSize(eDDSFormat format);
+
+    private:
+        // Header flags
+        static constexpr uint32_t DDSD_HEIGHT = 0x00000002u;
+        static constexpr uint32_t DDSD_DEPTH = 0x00800000u;
+        static constexpr uint32_t DDPF_ALPHA = 0x00000002u;
+        static constexpr uint32_t DDPF_FOURCC = 0x00000004u;
+        static constexpr uint32_t DDPF_RGB = 0x00000040u;
+        static constexpr uint32_t DDPF_LUMINANCE = 0x00020000u;
+        static constexpr uint32_t DDSCAPS2_CUBEMAP = 0x00000200u;
+        static constexpr uint32_t DDSCAPS2_CUBEMAP_ALLFACES = 0x0000fc00u;
+        static constexpr uint32_t RESOURCE_MISC_TEXTURECUBE = 0x00000004u;
+
+        // Offsets in the header, which starts after the magic number
+        static constexpr size_t HEADER_FLAGS = 4u;
+        static constexpr size_t HEADER_HEIGHT = 8u;
+        static constexpr size_t HEADER_WIDTH = 12u;
+        static constexpr size_t HEADER_DEPTH = 20u;
+        static constexpr size_t HEADER_MIP_COUNT = 24u;
+        static constexpr size_t HEADER_PIXEL_FORMAT = 72u;
+        static constexpr size_t HEADER_CAPS2 = 108u;
+        static constexpr size_t PIXEL_FORMAT_SIZE = 32u;
+        static constexpr size_t PIXEL_FORMAT_FLAGS = 4u;
+        static constexpr size_t PIXEL_FORMAT_FOURCC = 8u;
+        static constexpr size_t PIXEL_FORMAT_BIT_COUNT = 12u;
+        static constexpr size_t PIXEL_FORMAT_MASKS = 16u;
+        static constexpr size_t DX10_FORMAT = 0u;
+        static constexpr size_t DX10_DIMENSION = 4u;
+        static constexpr size_t DX10_MISC_FLAGS = 8u;
+        static constexpr size_t DX10_ARRAY_SIZE = 12u;
+
+        static constexpr uint32_t FOURCC_DX10 = 0x30315844u;  // "DX10"
+        static constexpr uint32_t FOURCC_DXT1 = 0x31545844u;  // "DXT1"
+        static constexpr uint32_t FOURCC_DXT2 = 0x32545844u;  // "DXT2"
+        static constexpr uint32_t FOURCC_DXT3 = 0x33545844u;  // "DXT3"
+        static constexpr uint32_t FOURCC_DXT4 = 0x34545844u;  // "DXT4"
+        static constexpr uint32_t FOURCC_DXT5 = 0x35545844u;  // "DXT5"
+        static constexpr uint32_t FOURCC_ATI1 = 0x31495441u;  // "ATI1"
+        static constexpr uint32_t FOURCC_ATI2 = 0x32495441u;  // "ATI2"
+        static constexpr uint32_t FOURCC_BC4U = 0x55344342u;  // "BC4U"
+        static constexpr uint32_t FOURCC_BC4S = 0x53344342u;  // "BC4S"
+        static constexpr uint32_t FOURCC_BC5U = 0x55354342u;  // "BC5U"
+        static constexpr uint32_t FOURCC_BC5S = 0x53354342u;  // "BC5S"
+
+        static uint32_t readUInt32(const uint8_t* pData);
+        static eDDSFormat getLegacyFormat(const uint8_t* pPixelFormat);
+    };
+}
\ No newline at end of file
@@ -21,6 +21,9 @@
 #include <algorithm>
 #include <memory>
 
+#include "Texture/DDSParser.h"
+#include "Texture/MappedFile.h"
+
 #ifdef __clang__
 #pragma clang diagnostic ignored "-Wcovered-switch-default"
 #pragma clang diagnostic ignored "-Wswitch-enum"
@@ -115,15 +118,16 @@ struct DDS_HEADER_DXT10
 
 #pragma pack(pop)
 
+// The parser keeps the numbering of DXGI_FORMAT and D3D11_RESOURCE_DIMENSION
+static_assert(static_cast<uint32_t>(library::eDDSFormat::R8G8B8A8_UNORM) == DXGI_FORMAT_R8G8B8A8_UNORM, "eDDSFormat must match DXGI_FORMAT");
+static_assert(static_cast<uint32_t>(library::eDDSFormat::BC1_UNORM) == DXGI_FORMAT_BC1_UNORM, "eDDSFormat must match DXGI_FORMAT");
+static_assert(static_cast<uint32_t>(library::eDDSFormat::BC7_UNORM_SRGB) == DXGI_FORMAT_BC7_UNORM_SRGB, "eDDSFormat must match DXGI_FORMAT");
+static_assert(static_cast<uint32_t>(library::eDDSFormat::B4G4R4A4_UNORM) == DXGI_FORMAT_B4G4R4A4_UNORM, "eDDSFormat must match DXGI_FORMAT");
+static_assert(static_cast<uint32_t>(library::eDDSDimension::TEXTURE2D) == D3D11_RESOURCE_DIMENSION_TEXTURE2D, "eDDSDimension must match D3D11_RESOURCE_DIMENSION");
+
 //--------------------------------------------------------------------------------------
 namespace
 {
-    struct handle_closer { void operator()(HANDLE h) noexcept { if (h) CloseHandle(h); } };
-
-    using ScopedHandle = std::unique_ptr<void, handle_closer>;
-
-    inline HANDLE safe_handle(HANDLE h) noexcept { return (h == INVALID_HANDLE_VALUE) ? nullptr : h; }
-
     template<UINT TNameLength>
     inline void SetDebugObjectName(_In_ ID3D11DeviceChild* resource, _In_ const char(&name)[TNameLength]) noexcept
     {
@@ -201,9 +205,10 @@ namespace
 
 
     //--------------------------------------------------------------------------------------
+    // Maps the file rather than reading it into the heap, the bit data points into the view
     HRESULT LoadTextureDataFromFile(
         _In_z_ const wchar_t* fileName,
-        std::unique_ptr<uint8_t[]>& ddsData,
+        library::MappedFile& ddsFile,
         const DDS_HEADER** header,
         const uint8_t** bitData,
         size_t* bitSize) noexcept
@@ -213,109 +218,34 @@ namespace
             return E_POINTER;
         }
 
-        // open the file
-#if (_WIN32_WINNT >= _WIN32_WINNT_WIN8)
-        ScopedHandle hFile(safe_handle(CreateFile2(fileName,
-            GENERIC_READ,
-            FILE_SHARE_READ,
-            OPEN_EXISTING,
-            nullptr)));
-#else
-        ScopedHandle hFile(safe_handle(CreateFileW(fileName,
-            GENERIC_READ,
-            FILE_SHARE_READ,
-            nullptr,
-            OPEN_EXISTING,
-            FILE_ATTRIBUTE_NORMAL,
-            nullptr)));
-#endif
-
-        if (!hFile)
-        {
-            return HRESULT_FROM_WIN32(GetLastError());
-        }
-
-        // Get the file size
-        FILE_STANDARD_INFO fileInfo;
-        if (!GetFileInformationByHandleEx(hFile.get(), FileStandardInfo, &fileInfo, sizeof(fileInfo)))
-        {
-            return HRESULT_FROM_WIN32(GetLastError());
-        }
-
-        // File is too big for 32-bit allocation, so reject read
-        if (fileInfo.EndOfFile.HighPart > 0)
-        {
-            return E_FAIL;
-        }
-
-        // Need at least enough data to fill the header and magic number to be a valid DDS
-        if (fileInfo.EndOfFile.LowPart < (sizeof(uint32_t) + sizeof(DDS_HEADER)))
+        if (!ddsFile.Open(fileName))
         {
-            return E_FAIL;
+            return HRESULT_FROM_WIN32(ERROR_OPEN_FAILED);
         }
 
-        // create enough space for the file data
-        ddsData.reset(new (std::nothrow) uint8_t[fileInfo.EndOfFile.LowPart]);
-        if (!ddsData)
-        {
-            return E_OUTOFMEMORY;
-        }
+        return LoadTextureDataFromMemory(ddsFile.GetData(), ddsFile.GetSize(), header, bitData, bitSize);
+    }
 
-        // read the data in
-        DWORD BytesRead = 0;
-        if (!ReadFile(hFile.get(),
-            ddsData.get(),
-            fileInfo.EndOfFile.LowPart,
-            &BytesRead,
-            nullptr
-        ))
+    //--------------------------------------------------------------------------------------
+    HRESULT HResultFromDDSStatus(library::eDDSStatus status) noexcept
+    {
+        switch (status)
         {
-            return HRESULT_FROM_WIN32(GetLastError());
-        }
+        case library::eDDSStatus::OK:
+            return S_OK;
 
-        if (BytesRead < fileInfo.EndOfFile.LowPart)
-        {
-            return E_FAIL;
-        }
+        case library::eDDSStatus::INVALID_ARGUMENT:
+            return E_INVALIDARG;
 
-        // DDS files always start with the same magic number ("DDS ")
-        auto dwMagicNumber = *reinterpret_cast<const uint32_t*>(ddsData.get());
-        if (dwMagicNumber != DDS_MAGIC)
-        {
-            return E_FAIL;
-        }
+        case library::eDDSStatus::TRUNCATED:
+            return HRESULT_FROM_WIN32(ERROR_HANDLE_EOF);
 
-        auto hdr = reinterpret_cast<const DDS_HEADER*>(ddsData.get() + sizeof(uint32_t));
+        case library::eDDSStatus::UNSUPPORTED:
+            return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
 
-        // Verify header to validate DDS file
-        if (hdr->size != sizeof(DDS_HEADER) ||
-            hdr->ddspf.size != sizeof(DDS_PIXELFORMAT))
-        {
+        default:
             return E_FAIL;
         }
-
-        // Check for DX10 extension
-        bool bDXT10Header = false;
-        if ((hdr->ddspf.flags & DDS_FOURCC) &&
-            (MAKEFOURCC('D', 'X', '1', '0') == hdr->ddspf.fourCC))
-        {
-            // Must be long enough for both headers and magic value
-            if (fileInfo.EndOfFile.LowPart < (sizeof(DDS_HEADER) + sizeof(uint32_t) + sizeof(DDS_HEADER_DXT10)))
-            {
-                return E_FAIL;
-            }
-
-            bDXT10Header = true;
-        }
-
-        // setup the pointers in the process request
-        *header = hdr;
-        auto offset = sizeof(uint32_t) + sizeof(DDS_HEADER)
-            + (bDXT10Header ? sizeof(DDS_HEADER_DXT10) : 0);
-        *bitData = ddsData.get() + offset;
-        *bitSize = fileInfo.EndOfFile.LowPart - offset;
-
-        return S_OK;
     }
 
 
@@ -1929,9 +1859,9 @@ HRESULT DirectX::CreateDDSTextureFromFileEx(
     const uint8_t* bitData = nullptr;
     size_t bitSize = 0;
 
-    std::unique_ptr<uint8_t[]> ddsData;
+    library::MappedFile ddsFile;
     HRESULT hr = LoadTextureDataFromFile(fileName,
-        ddsData,
+        ddsFile,
         &header,
         &bitData,
         &bitSize
@@ -1957,4 +1887,69 @@ HRESULT DirectX::CreateDDSTextureFromFileEx(
     }
 
     return hr;
+}
+
+//--------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::GetDDSTextureMipLevels(
+    const uint8_t* ddsData,
+    size_t ddsDataSize,
+    DXGI_FORMAT* format,
+    DDS_MIP_LEVEL* levels,
+    size_t* mipCount) noexcept
+{
+    if (format)
+    {
+        *format = DXGI_FORMAT_UNKNOWN;
+    }
+    if (mipCount)
+    {
+        *mipCount = 0;
+    }
+
+    if (!ddsData || !format || !levels || !mipCount)
+    {
+        return E_INVALIDARG;
+    }
+
+    library::DDSTextureInfo info;
+    HRESULT hr = HResultFromDDSStatus(library::DDSParser::ParseHeader(ddsData, ddsDataSize, info));
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    // Only single 2D textures have one surface per level
+    if (info.dimension != library::eDDSDimension::TEXTURE2D || info.uArraySize != 1 || info.bCubeMap)
+    {
+        return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+    }
+
+    std::vector<library::DDSSurface> surfaces;
+    try
+    {
+        hr = HResultFromDDSStatus(library::DDSParser::GetSurfaces(info, ddsDataSize, surfaces));
+    }
+    catch (const std::bad_alloc&)
+    {
+        return E_OUTOFMEMORY;
+    }
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    for (size_t i = 0; i < surfaces.size(); i++)
+    {
+        levels[i].offset = surfaces[i].uOffset;
+        levels[i].numBytes = surfaces[i].uNumBytes;
+        levels[i].rowBytes = surfaces[i].uRowBytes;
+        levels[i].width = surfaces[i].uWidth;
+        levels[i].height = surfaces[i].uHeight;
+    }
+
+    *format = static_cast<DXGI_FORMAT>(info.format);
+    *mipCount = surfaces.size();
+
+    return S_OK;
 }
\ No newline at end of file
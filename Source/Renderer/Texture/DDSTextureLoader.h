@@ -129,4 +129,22 @@ namespace DirectX
         _Outptr_opt_ ID3D11Resource** texture,
         _Outptr_opt_ ID3D11ShaderResourceView** textureView,
         _Out_opt_ DDS_ALPHA_MODE* alphaMode = nullptr) noexcept;
+
+    // Offset from the start of the file, size and dimensions of one mip level
+    struct DDS_MIP_LEVEL
+    {
+        size_t offset;
+        size_t numBytes;
+        size_t rowBytes;
+        uint32_t width;
+        uint32_t height;
+    };
+
+    // Mip chain of a single 2D texture, so that levels can be read from the file on their own
+    HRESULT GetDDSTextureMipLevels(
+        _In_reads_bytes_(ddsDataSize) const uint8_t* ddsData,
+        _In_ size_t ddsDataSize,
+        _Out_ DXGI_FORMAT* format,
+        _Out_writes_(D3D11_REQ_MIP_LEVELS) DDS_MIP_LEVEL* levels,
+        _Out_ size_t* mipCount) noexcept;
 }
\ No newline at end of file
@@ -0,0 +1,182 @@
+#include "Texture/MappedFile.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif // ! WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MappedFile::MappedFile
+
+      Summary:  Constructor, no file is mapped
+
+      Modifies: [m_pData, m_uSize].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    MappedFile::MappedFile()
+        : m_pData(nullptr)
+        , m_uSize(0u)
+    {
+        // empty
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MappedFile::~MappedFile
+
+      Summary:  Destructor, unmaps the file
+
+      Modifies: [m_pData, m_uSize].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MappedFile::Open
+
+      Summary:  Maps the whole file read-only. The file and mapping
+                handles are closed right away, the view keeps the file
+                open by itself
+
+      Args:     const std::filesystem::path& filePath
+                  Path to the file
+
+      Modifies: [m_pData, m_uSize].
+
+      Returns:  bool
+                  True if the file is mapped
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    bool MappedFile::Open(const std::filesystem::path& filePath)
+    {
+        Close();
+
+#ifdef _WIN32
+        HANDLE hFile = CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (hFile == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(hFile, &fileSize) || fileSize.QuadPart <= 0 || static_cast<uint64_t>(fileSize.QuadPart) > SIZE_MAX)
+        {
+            CloseHandle(hFile);
+            return false;
+        }
+
+        HANDLE hMapping = CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0u, 0u, nullptr);
+        CloseHandle(hFile);
+        if (!hMapping)
+        {
+            return false;
+        }
+
+        const void* pView = MapViewOfFile(hMapping, FILE_MAP_READ, 0u, 0u, 0u);
+        CloseHandle(hMapping);
+        if (!pView)
+        {
+            return false;
+        }
+
+        m_pData = static_cast<const uint8_t*>(pView);
+        m_uSize = static_cast<size_t>(fileSize.QuadPart);
+#else
+        int fd = open(filePath.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        struct stat fileStatus;
+        if (fstat(fd, &fileStatus) != 0 || fileStatus.st_size <= 0 || static_cast<uint64_t>(fileStatus.st_size) > SIZE_MAX)
+        {
+            close(fd);
+            return false;
+        }
+
+        void* pView = mmap(nullptr, static_cast<size_t>(fileStatus.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (pView == MAP_FAILED)
+        {
+            return false;
+        }
+
+        m_pData = static_cast<const uint8_t*>(pView);
+        m_uSize = static_cast<size_t>(fileStatus.st_size);
+#endif
+
+        return true;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MappedFile::Close
+
+      Summary:  Unmaps the file, pointers into it become invalid
+
+      Modifies: [m_pData, m_uSize].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void MappedFile::Close()
+    {
+        if (!m_pData)
+        {
+            return;
+        }
+
+#ifdef _WIN32
+        UnmapViewOfFile(m_pData);
+#else
+        munmap(const_cast<uint8_t*>(m_pData), m_uSize);
+#endif
+
+        m_pData = nullptr;
+        m_uSize = 0u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MappedFile::IsOpen
+
+      Summary:  Returns whether a file is mapped
+
+      Returns:  bool
+                  True if a file is mapped
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    bool MappedFile::IsOpen() const
+    {
+        return m_pData != nullptr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MappedFile::GetData
+
+      Summary:  Returns the first byte of the mapped file
+
+      Returns:  const uint8_t*
+                  Start of the view, null if no file is mapped
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const uint8_t* MappedFile::GetData() const
+    {
+        return m_pData;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MappedFile::GetSize
+
+      Summary:  Returns the size of the mapped file
+
+      Returns:  size_t
+                  Size in bytes, 0 if no file is mapped
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    size_t MappedFile::GetSize() const
+    {
+        return m_uSize;
+    }
+}
\ No newline at end of file
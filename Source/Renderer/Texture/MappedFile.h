@@ -0,0 +1,67 @@
+/*+===================================================================
+  File:      MAPPEDFILE.H
+
+  Summary:   MappedFile header file contains declaration of class
+             MappedFile that maps a file read-only into memory, with a
+             file mapping on Windows and mmap elsewhere. Like the DDS
+             parser it does not include Common.h, so it builds on any
+             platform.
+
+  Classes:  MappedFile
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    MappedFile
+
+      Summary:  Read-only view of a whole file. Pages are read from the
+                disk when first touched and shared with the file cache,
+                so nothing is copied into the heap. The view stays
+                valid until the file is closed or the object destroyed.
+                Empty files can not be mapped
+
+      Methods:  Open
+                  Maps a file, closing the previous one
+                Close
+                  Unmaps the file
+                IsOpen
+                  Returns whether a file is mapped
+                GetData
+                  Returns the first byte of the file
+                GetSize
+                  Returns the size of the file
+                MappedFile
+                  Constructor.
+                ~MappedFile
+                  Destructor, unmaps the file.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class MappedFile final
+    {
+    public:
+        MappedFile();
+        MappedFile(const MappedFile& other) = delete;
+        MappedFile(MappedFile&& other) = delete;
+        MappedFile& operator=(const MappedFile& other) = delete;
+        MappedFile& operator=(MappedFile&& other) = delete;
+        ~MappedFile();
+
+        bool Open(const std::filesystem::path& filePath);
+        void Close();
+
+        bool IsOpen() const;
+        const uint8_t* GetData() const;
+        size_t GetSize() const;
+
+    private:
+        const uint8_t* m_pData;
+        size_t m_uSize;
+    };
+}
\ No newline at end of file
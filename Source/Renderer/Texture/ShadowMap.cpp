@@ -0,0 +1,329 @@
+#include "Texture/ShadowMap.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowMap::ShadowMap
+
+      Summary:  Constructor
+
+      Args:     UINT uSize
+                  Width and height in texels
+                DXGI_FORMAT depthFormat
+                  DXGI_FORMAT_D32_FLOAT or DXGI_FORMAT_D16_UNORM
+                UINT uNumSlices
+                  Number of shadow maps in the array
+
+      Modifies: [m_uSize, m_depthFormat, m_uNumSlices, m_viewport,
+                 m_texture2D, m_aDepthStencilViews,
+                 m_shaderResourceView, m_samplerComparison,
+                 m_rasterizerState].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ShadowMap::ShadowMap(_In_ UINT uSize, _In_ DXGI_FORMAT depthFormat, _In_ UINT uNumSlices)
+        : m_uSize(uSize)
+        , m_depthFormat(depthFormat)
+        , m_uNumSlices(uNumSlices)
+        , m_viewport
+        {
+            .TopLeftX = 0.0f,
+            .TopLeftY = 0.0f,
+            .Width = static_cast<FLOAT>(uSize),
+            .Height = static_cast<FLOAT>(uSize),
+            .MinDepth = 0.0f,
+            .MaxDepth = 1.0f,
+        }
+        , m_texture2D()
+        , m_aDepthStencilViews(uNumSlices)
+        , m_shaderResourceView()
+        , m_samplerComparison()
+        , m_rasterizerState()
+    {
+        assert(IsSupportedFormat(depthFormat) && uNumSlices > 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowMap::Initialize
+
+      Summary:  Creates a typeless texture array whose slices are
+                written through one depth stencil view each and read
+                through a shader resource view of the whole array, the
+                comparison sampler and the rasterizer state
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the resources
+
+      Modifies: [m_texture2D, m_aDepthStencilViews,
+                 m_shaderResourceView, m_samplerComparison,
+                 m_rasterizerState].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT ShadowMap::Initialize(_In_ ID3D11Device* pDevice)
+    {
+        HRESULT hr = S_OK;
+
+        const BOOL bIsFloat = m_depthFormat == DXGI_FORMAT_D32_FLOAT;
+
+        // Create a texture2D array used as the shadow maps
+        D3D11_TEXTURE2D_DESC descShadowTexture =
+        {
+            .Width = m_uSize,
+            .Height = m_uSize,
+            .MipLevels = 1u,
+            .ArraySize = m_uNumSlices,
+            .Format = bIsFloat ? DXGI_FORMAT_R32_TYPELESS : DXGI_FORMAT_R16_TYPELESS,
+            .SampleDesc = {.Count = 1u},
+            .Usage = D3D11_USAGE_DEFAULT,
+            .BindFlags = D3D11_BIND_DEPTH_STENCIL | D3D11_BIND_SHADER_RESOURCE,
+            .CPUAccessFlags = 0u,
+            .MiscFlags = 0u
+        };
+        hr = pDevice->CreateTexture2D(&descShadowTexture, nullptr, m_texture2D.GetAddressOf());
+        if (FAILED(hr))
+        {
+            MessageBox(
+                nullptr,
+                L"Call to CreateShadowMapTexture2D failed!",
+                L"Game Graphics Programming",
+                NULL
+            );
+            return hr;
+        }
+
+        // Create a depth stencil view for every slice
+        for (UINT i = 0u; i < m_uNumSlices; ++i)
+        {
+            D3D11_DEPTH_STENCIL_VIEW_DESC descShadowDepthStencilView =
+            {
+                .Format = m_depthFormat,
+                .ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2DARRAY,
+                .Flags = 0u,
+                .Texture2DArray = {.MipSlice = 0u,
+                                   .FirstArraySlice = i,
+                                   .ArraySize = 1u}
+            };
+            hr = pDevice->CreateDepthStencilView(m_texture2D.Get(), &descShadowDepthStencilView, m_aDepthStencilViews[i].GetAddressOf());
+            if (FAILED(hr))
+            {
+                MessageBox(
+                    nullptr,
+                    L"Call to CreateShadowDepthStencilView failed!",
+                    L"Game Graphics Programming",
+                    NULL
+                );
+                return hr;
+            }
+        }
+
+        // Create a shader resource view of the whole array
+        D3D11_SHADER_RESOURCE_VIEW_DESC descShadowShaderResourceView =
+        {
+            .Format = bIsFloat ? DXGI_FORMAT_R32_FLOAT : DXGI_FORMAT_R16_UNORM,
+            .ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2DARRAY,
+            .Texture2DArray = {.MostDetailedMip = 0u,
+                               .MipLevels = 1u,
+                               .FirstArraySlice = 0u,
+                               .ArraySize = m_uNumSlices}
+        };
+        hr = pDevice->CreateShaderResourceView(m_texture2D.Get(), &descShadowShaderResourceView, m_shaderResourceView.GetAddressOf());
+        if (FAILED(hr))
+        {
+            MessageBox(
+                nullptr,
+                L"Call to CreateShadowShaderResourceView failed!",
+                L"Game Graphics Programming",
+                NULL
+            );
+            return hr;
+        }
+
+        // Create a comparison sampler, texels outside the map compare as lit
+        D3D11_SAMPLER_DESC descShadowSamplerState =
+        {
+            .Filter = D3D11_FILTER_COMPARISON_MIN_MAG_LINEAR_MIP_POINT,
+            .AddressU = D3D11_TEXTURE_ADDRESS_BORDER,
+            .AddressV = D3D11_TEXTURE_ADDRESS_BORDER,
+            .AddressW = D3D11_TEXTURE_ADDRESS_BORDER,
+            .MipLODBias = 0.0f,
+            .MaxAnisotropy = 1u,
+            .ComparisonFunc = D3D11_COMPARISON_LESS_EQUAL,
+            .BorderColor = { 1.0f, 1.0f, 1.0f, 1.0f },
+            .MinLOD = 0.0f,
+            .MaxLOD = D3D11_FLOAT32_MAX
+        };
+        hr = pDevice->CreateSamplerState(&descShadowSamplerState, m_samplerComparison.GetAddressOf());
+        if (FAILED(hr))
+        {
+            MessageBox(
+                nullptr,
+                L"Call to CreateShadowSamplerState failed!",
+                L"Game Graphics Programming",
+                NULL
+            );
+            return hr;
+        }
+
+        // Bias the rendered depth, more on slopes, so lit surfaces do not shadow themselves
+        D3D11_RASTERIZER_DESC descShadowRasterizerState =
+        {
+            .FillMode = D3D11_FILL_SOLID,
+            .CullMode = D3D11_CULL_BACK,
+            .FrontCounterClockwise = FALSE,
+            .DepthBias = bIsFloat ? 1000 : 100,
+            .DepthBiasClamp = 0.0f,
+            .SlopeScaledDepthBias = 2.0f,
+            .DepthClipEnable = TRUE,
+            .ScissorEnable = FALSE,
+            .MultisampleEnable = FALSE,
+            .AntialiasedLineEnable = FALSE
+        };
+        hr = pDevice->CreateRasterizerState(&descShadowRasterizerState, m_rasterizerState.GetAddressOf());
+        if (FAILED(hr))
+        {
+            MessageBox(
+                nullptr,
+                L"Call to CreateShadowRasterizerState failed!",
+                L"Game Graphics Programming",
+                NULL
+            );
+            return hr;
+        }
+
+        return hr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowMap::GetDepthStencilView
+
+      Summary:  Returns the depth stencil view the shadow pass of a
+                slice renders to
+
+      Args:     UINT uSlice
+                  Index of the slice
+
+      Returns:  ComPtr<ID3D11DepthStencilView>&
+                  Depth stencil view
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ComPtr<ID3D11DepthStencilView>& ShadowMap::GetDepthStencilView(_In_ UINT uSlice)
+    {
+        assert(uSlice < m_aDepthStencilViews.size());
+        return m_aDepthStencilViews[uSlice];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowMap::GetShaderResourceView
+
+      Summary:  Returns the shader resource view of the array the
+                scene passes sample
+
+      Returns:  ComPtr<ID3D11ShaderResourceView>&
+                  Shader resource view
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ComPtr<ID3D11ShaderResourceView>& ShadowMap::GetShaderResourceView()
+    {
+        return m_shaderResourceView;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowMap::GetSamplerState
+
+      Summary:  Returns the comparison sampler. Sampling returns the
+                filtered fraction of texels that are not in front of
+                the compared depth
+
+      Returns:  ComPtr<ID3D11SamplerState>&
+                  Comparison sampler
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ComPtr<ID3D11SamplerState>& ShadowMap::GetSamplerState()
+    {
+        return m_samplerComparison;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowMap::GetRasterizerState
+
+      Summary:  Returns the rasterizer state of the shadow pass
+
+      Returns:  ComPtr<ID3D11RasterizerState>&
+                  Rasterizer state with depth bias
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ComPtr<ID3D11RasterizerState>& ShadowMap::GetRasterizerState()
+    {
+        return m_rasterizerState;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowMap::GetViewport
+
+      Summary:  Returns the viewport covering the whole shadow map
+
+      Returns:  const D3D11_VIEWPORT&
+                  Viewport of the shadow pass
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const D3D11_VIEWPORT& ShadowMap::GetViewport() const
+    {
+        return m_viewport;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowMap::GetSize
+
+      Summary:  Returns the width and height of the shadow map
+
+      Returns:  UINT
+                  Size in texels
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT ShadowMap::GetSize() const
+    {
+        return m_uSize;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowMap::GetNumSlices
+
+      Summary:  Returns the number of shadow maps in the array
+
+      Returns:  UINT
+                  Number of slices
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT ShadowMap::GetNumSlices() const
+    {
+        return m_uNumSlices;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowMap::GetMemorySize
+
+      Summary:  Returns the size of the texture array. A full clear
+                and fill of one slice writes the size divided by the
+                number of slices
+
+      Returns:  UINT64
+                  Size in bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 ShadowMap::GetMemorySize() const
+    {
+        const UINT64 uBytesPerTexel = m_depthFormat == DXGI_FORMAT_D32_FLOAT ? 4u : 2u;
+
+        return static_cast<UINT64>(m_uSize) * static_cast<UINT64>(m_uSize) * uBytesPerTexel * m_uNumSlices;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowMap::IsSupportedFormat
+
+      Summary:  Returns whether a depth format can be used for a
+                shadow map
+
+      Args:     DXGI_FORMAT depthFormat
+                  Depth format to check
+
+      Returns:  BOOL
+                  TRUE for DXGI_FORMAT_D32_FLOAT and
+                  DXGI_FORMAT_D16_UNORM
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL ShadowMap::IsSupportedFormat(_In_ DXGI_FORMAT depthFormat)
+    {
+        return depthFormat == DXGI_FORMAT_D32_FLOAT || depthFormat == DXGI_FORMAT_D16_UNORM;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+/*+===================================================================
+  File:      SHADOWMAP.H
+
+  Summary:   ShadowMap header file contains declaration of class
+             ShadowMap, a depth only texture array the scene is
+             rendered to from the lights and sampled with depth
+             comparison.
+
+  Classes:  ShadowMap
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    ShadowMap
+
+      Summary:  Array of square depth textures, one slice per shadow
+                casting light. Every slice has a depth stencil view
+                for its shadow pass, the scene passes sample the whole
+                array through one shader resource view and a
+                comparison sampler. A rasterizer state biases the
+                rendered depth against acne. The resolution does not
+                depend on the window
+
+      Methods:  Initialize
+                  Creates the texture, views and states
+                GetDepthStencilView
+                  Returns the depth stencil view of a slice
+                GetShaderResourceView
+                  Returns the shader resource view of the array
+                GetSamplerState
+                  Returns the comparison sampler
+                GetRasterizerState
+                  Returns the biased rasterizer state
+                GetViewport
+                  Returns the viewport covering the texture
+                GetSize
+                  Returns the width and height in texels
+                GetNumSlices
+                  Returns the number of slices
+                GetMemorySize
+                  Returns the size of the texture in bytes
+                IsSupportedFormat
+                  Returns whether a depth format can be used
+                ShadowMap
+                  Constructor.
+                ~ShadowMap
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class ShadowMap final
+    {
+    public:
+        static constexpr UINT DEFAULT_SIZE = 2048u;
+
+        ShadowMap() = delete;
+        ShadowMap(_In_ UINT uSize, _In_ DXGI_FORMAT depthFormat, _In_ UINT uNumSlices);
+        ShadowMap(const ShadowMap& other) = delete;
+        ShadowMap(ShadowMap&& other) = delete;
+        ShadowMap& operator=(const ShadowMap& other) = delete;
+        ShadowMap& operator=(ShadowMap&& other) = delete;
+        ~ShadowMap() = default;
+
+        HRESULT Initialize(_In_ ID3D11Device* pDevice);
+
+        ComPtr<ID3D11DepthStencilView>& GetDepthStencilView(_In_ UINT uSlice);
+        ComPtr<ID3D11ShaderResourceView>& GetShaderResourceView();
+        ComPtr<ID3D11SamplerState>& GetSamplerState();
+        ComPtr<ID3D11RasterizerState>& GetRasterizerState();
+        const D3D11_VIEWPORT& GetViewport() const;
+        UINT GetSize() const;
+        UINT GetNumSlices() const;
+        UINT64 GetMemorySize() const;
+
+        static BOOL IsSupportedFormat(_In_ DXGI_FORMAT depthFormat);
+
+    private:
+        UINT m_uSize;
+        DXGI_FORMAT m_depthFormat;
+        UINT m_uNumSlices;
+        D3D11_VIEWPORT m_viewport;
+
+        ComPtr<ID3D11Texture2D> m_texture2D;
+        std::vector<ComPtr<ID3D11DepthStencilView>> m_aDepthStencilViews;
+        ComPtr<ID3D11ShaderResourceView> m_shaderResourceView;
+        ComPtr<ID3D11SamplerState> m_samplerComparison;
+        ComPtr<ID3D11RasterizerState> m_rasterizerState;
+    };
+}
\ No newline at end of file
@@ -1,11 +1,15 @@
 #include "Texture.h"
 
+#include <fstream>
+
 #include "Texture/DDSTextureLoader.h"
+#include "Texture/TextureCooker.h"
 #include "Texture/WICTextureLoader.h"
 
 namespace library
 {
     ComPtr<ID3D11SamplerState> Texture::s_samplers[static_cast<size_t>(eTextureSamplerType::COUNT)];
+    BOOL Texture::sm_bStreamingEnabled = FALSE;
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Texture::Texture
@@ -17,40 +21,214 @@ namespace library
                 eTextureSamplerType textureSamplerType
                   Texture sampler type of this texture
 
-      Modifies: [m_filePath, m_textureRV, m_textureSamplerType].
+      Modifies: [m_filePath, m_textureRV, m_textureSamplerType,
+                 m_aFileData, m_mappedFile, m_aPixels, m_uWidth,
+                 m_uHeight, m_streamFilePath, m_format, m_aMipLevels,
+                 m_uResidentMip, m_uTailMip, m_texture2D].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     Texture::Texture(_In_ const std::filesystem::path& filePath, _In_opt_ eTextureSamplerType textureSamplerType)
         : m_filePath(filePath)
         , m_textureRV()
         , m_textureSamplerType(textureSamplerType)
+        , m_aFileData()
+        , m_mappedFile()
+        , m_aPixels()
+        , m_uWidth(0u)
+        , m_uHeight(0u)
+        , m_streamFilePath()
+        , m_format(DXGI_FORMAT_UNKNOWN)
+        , m_aMipLevels()
+        , m_uResidentMip(0u)
+        , m_uTailMip(0u)
+        , m_texture2D()
     {
         // empty
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Texture::Load
+
+      Summary:  Decodes the image into RGBA pixels with WIC. Files WIC
+                can not decode, such as DDS, are mapped as they are, so
+                their surfaces are uploaded straight from the file.
+                When cooking is enabled, the decoded image is
+                compressed with its mips into a cached DDS file, which
+                later loads read instead of decoding. Touches neither
+                the device nor the context, so it can run on a worker
+                thread with COM initialized. Remembers the DDS file the
+                data came from so that streaming can read its levels
+
+      Modifies: [m_aFileData, m_mappedFile, m_aPixels, m_uWidth,
+                 m_uHeight, m_streamFilePath].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Texture::Load()
+    {
+        // Shared textures are requested by every material using them, decode them once
+        if (m_textureRV || !m_aPixels.empty() || !m_aFileData.empty() || m_mappedFile.IsOpen())
+        {
+            return S_OK;
+        }
+
+        // DDS files are already compressed, everything else is cooked once and read from the cache
+        UINT64 uCookKey = 0ull;
+        BOOL bCook = TextureCooker::IsEnabled()
+            && _wcsicmp(m_filePath.extension().c_str(), L".dds") != 0
+            && SUCCEEDED(TextureCooker::ComputeKey(m_filePath, uCookKey));
+        if (bCook && SUCCEEDED(TextureCooker::Load(m_filePath, uCookKey, m_aFileData)))
+        {
+            m_streamFilePath = TextureCooker::GetCacheFilePath(m_filePath, uCookKey);
+            return S_OK;
+        }
+
+        ComPtr<IWICImagingFactory> wicFactory;
+        HRESULT hr = CoCreateInstance(CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(wicFactory.GetAddressOf()));
+        if (FAILED(hr))
+        {
+            // COM is not initialized on this thread, Initialize loads the file instead
+            return hr;
+        }
+
+        ComPtr<IWICBitmapDecoder> decoder;
+        hr = wicFactory->CreateDecoderFromFilename(m_filePath.c_str(), nullptr, GENERIC_READ, WICDecodeMetadataCacheOnDemand, decoder.GetAddressOf());
+
+        if (SUCCEEDED(hr))
+        {
+            ComPtr<IWICBitmapFrameDecode> frame;
+            hr = decoder->GetFrame(0u, frame.GetAddressOf());
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+
+            ComPtr<IWICFormatConverter> converter;
+            hr = wicFactory->CreateFormatConverter(converter.GetAddressOf());
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+
+            hr = converter->Initialize(frame.Get(), GUID_WICPixelFormat32bppRGBA, WICBitmapDitherTypeNone, nullptr, 0.0, WICBitmapPaletteTypeCustom);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+
+            hr = converter->GetSize(&m_uWidth, &m_uHeight);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+
+            UINT uStride = m_uWidth * 4u;
+            m_aPixels.resize(static_cast<size_t>(uStride) * m_uHeight);
+
+            hr = converter->CopyPixels(nullptr, uStride, static_cast<UINT>(m_aPixels.size()), m_aPixels.data());
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+
+            // Images that can not be block compressed keep their pixels and mips generated on the GPU
+            std::vector<BYTE> aCookedFile;
+            if (bCook && SUCCEEDED(TextureCooker::Cook(m_filePath, uCookKey, m_uWidth, m_uHeight, m_aPixels, aCookedFile)))
+            {
+                if (FAILED(TextureCooker::Save(m_filePath, uCookKey, aCookedFile)))
+                {
+                    OutputDebugString(L"Error writing texture cache of ");
+                    OutputDebugString(m_filePath.c_str());
+                    OutputDebugString(L"\n");
+                }
+                else
+                {
+                    m_streamFilePath = TextureCooker::GetCacheFilePath(m_filePath, uCookKey);
+                }
+
+                m_aFileData = std::move(aCookedFile);
+                m_aPixels = std::vector<BYTE>();
+            }
+
+            return S_OK;
+        }
+
+        // Not an image WIC can decode, map the file for the DDS loader
+        if (!m_mappedFile.Open(m_filePath))
+        {
+            OutputDebugString(L"Can't open texture file \"");
+            OutputDebugString(m_filePath.c_str());
+            OutputDebugString(L"\"\n");
+
+            return HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND);
+        }
+
+        m_streamFilePath = m_filePath;
+
+        return S_OK;
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Texture::Initialize
 
-      Summary:  Initializes the texture and samplers if not initialized
+      Summary:  Initializes the texture and samplers if not initialized.
+                With streaming enabled, DDS files only get their tail
+                levels created and the streamer brings in the rest
 
       Args:     ID3D11Device* pDevice
                   The Direct3D device to create the buffers
                 ID3D11DeviceContext* pImmediateContext
                   The Direct3D context to set buffers
 
-      Modifies: [m_textureRV].
+      Modifies: [m_textureRV, m_aFileData, m_mappedFile, m_aPixels].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     HRESULT Texture::Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext)
 	{
-        HRESULT hr = CreateWICTextureFromFile(
-            pDevice,
-            pImmediateContext,
-            m_filePath.c_str(),
-            nullptr,
-            m_textureRV.GetAddressOf()
-            );
-        if (FAILED(hr))
+        HRESULT hr = S_OK;
+
+        if (!m_textureRV)
         {
-            hr = CreateDDSTextureFromFile(pDevice, m_filePath.c_str(), nullptr, m_textureRV.GetAddressOf());
+            if (!m_aPixels.empty())
+            {
+                hr = createFromPixels(pDevice, pImmediateContext);
+            }
+            else if (!m_aFileData.empty() || m_mappedFile.IsOpen())
+            {
+                const BYTE* pFileData = m_mappedFile.IsOpen() ? m_mappedFile.GetData() : m_aFileData.data();
+                size_t uFileSize = m_mappedFile.IsOpen() ? m_mappedFile.GetSize() : m_aFileData.size();
+
+                if (sm_bStreamingEnabled && !m_streamFilePath.empty())
+                {
+                    hr = createStreamed(pDevice, pImmediateContext, pFileData, uFileSize);
+                }
+
+                // Textures that can not be streamed are created whole
+                if (!m_textureRV)
+                {
+                    hr = CreateDDSTextureFromMemory(pDevice, pFileData, uFileSize, nullptr, m_textureRV.GetAddressOf());
+                }
+            }
+            else
+            {
+                // Not loaded in advance, load it on this thread
+                hr = CreateWICTextureFromFile(
+                    pDevice,
+                    pImmediateContext,
+                    m_filePath.c_str(),
+                    nullptr,
+                    m_textureRV.GetAddressOf()
+                    );
+                if (FAILED(hr))
+                {
+                    hr = CreateDDSTextureFromFile(pDevice, m_filePath.c_str(), nullptr, m_textureRV.GetAddressOf());
+                }
+            }
+
+            // The GPU copy is all that is needed from now on
+            m_aFileData = std::vector<BYTE>();
+            m_mappedFile.Close();
+            m_aPixels = std::vector<BYTE>();
+
             if (FAILED(hr))
             {
                 OutputDebugString(L"Can't load texture from \"");
@@ -121,4 +299,472 @@ namespace library
 	{
 		return m_textureSamplerType;
 	}
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Texture::GetFilePath
+
+      Summary:  Returns the path to the texture file
+
+      Returns:  const std::filesystem::path&
+                  Path to the texture file
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::filesystem::path& Texture::GetFilePath() const
+    {
+        return m_filePath;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Texture::IsStreamable
+
+      Summary:  Returns whether the levels above the tail are streamed
+
+      Returns:  BOOL
+                  TRUE if the texture was created with its tail only
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL Texture::IsStreamable() const
+    {
+        return m_texture2D && m_uTailMip > 0u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Texture::GetNumMips
+
+      Summary:  Returns the number of levels of a streamed texture
+
+      Returns:  UINT
+                  Number of levels in the file
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Texture::GetNumMips() const
+    {
+        return static_cast<UINT>(m_aMipLevels.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Texture::GetResidentMip
+
+      Summary:  Returns the most detailed level in video memory
+
+      Returns:  UINT
+                  Resident mip
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Texture::GetResidentMip() const
+    {
+        return m_uResidentMip;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Texture::GetTailMip
+
+      Summary:  Returns the most detailed level that is always resident
+
+      Returns:  UINT
+                  Tail mip
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Texture::GetTailMip() const
+    {
+        return m_uTailMip;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Texture::GetWidth
+
+      Summary:  Returns the width of the top level of a streamed
+                texture
+
+      Returns:  UINT
+                  Width in texels
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Texture::GetWidth() const
+    {
+        return m_aMipLevels.empty() ? m_uWidth : m_aMipLevels[0].width;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Texture::GetHeight
+
+      Summary:  Returns the height of the top level of a streamed
+                texture
+
+      Returns:  UINT
+                  Height in texels
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Texture::GetHeight() const
+    {
+        return m_aMipLevels.empty() ? m_uHeight : m_aMipLevels[0].height;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Texture::GetMipSize
+
+      Summary:  Returns the bytes of one level of a streamed texture
+
+      Args:     UINT uMip
+                  Level
+
+      Returns:  UINT64
+                  Size in bytes, 0 past the last level
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 Texture::GetMipSize(_In_ UINT uMip) const
+    {
+        return uMip < m_aMipLevels.size() ? static_cast<UINT64>(m_aMipLevels[uMip].numBytes) : 0ull;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Texture::ReadMips
+
+      Summary:  Reads consecutive levels of a streamed texture from its
+                DDS file, where they are stored back to back. Only
+                reads state set by Initialize, so it can run on a
+                worker thread
+
+      Args:     UINT uFirstMip
+                  Most detailed level to read
+                UINT uEndMip
+                  Level past the last one to read
+                std::vector<BYTE>& aOutData
+                  Levels as stored in the file
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Texture::ReadMips(_In_ UINT uFirstMip, _In_ UINT uEndMip, _Out_ std::vector<BYTE>& aOutData) const
+    {
+        aOutData.clear();
+
+        if (uFirstMip >= uEndMip || uEndMip > m_aMipLevels.size())
+        {
+            return E_INVALIDARG;
+        }
+
+        size_t uSize = 0u;
+        for (UINT uMip = uFirstMip; uMip < uEndMip; ++uMip)
+        {
+            uSize += m_aMipLevels[uMip].numBytes;
+        }
+
+        std::ifstream file(m_streamFilePath, std::ios::binary);
+        if (!file)
+        {
+            return HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND);
+        }
+
+        aOutData.resize(uSize);
+        file.seekg(static_cast<std::streamoff>(m_aMipLevels[uFirstMip].offset));
+        file.read(reinterpret_cast<char*>(aOutData.data()), static_cast<std::streamsize>(uSize));
+        if (!file)
+        {
+            aOutData.clear();
+            return HRESULT_FROM_WIN32(ERROR_HANDLE_EOF);
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Texture::SetResidentMip
+
+      Summary:  Makes the levels from the given mip on resident. A
+                finer mip needs the levels up to the resident one in
+                aMipData, a coarser one drops levels and needs none
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the texture
+                ID3D11DeviceContext* pImmediateContext
+                  The Direct3D context to upload and copy the levels
+                UINT uMip
+                  New most detailed level, at most the tail
+                const std::vector<BYTE>& aMipData
+                  Levels [uMip, resident mip) as read by ReadMips
+
+      Modifies: [m_texture2D, m_textureRV, m_uResidentMip].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Texture::SetResidentMip(
+        _In_ ID3D11Device* pDevice,
+        _In_ ID3D11DeviceContext* pImmediateContext,
+        _In_ UINT uMip,
+        _In_ const std::vector<BYTE>& aMipData
+    )
+    {
+        if (!IsStreamable() || uMip > m_uTailMip)
+        {
+            return E_INVALIDARG;
+        }
+
+        if (uMip == m_uResidentMip)
+        {
+            return S_OK;
+        }
+
+        UINT64 uSize = 0ull;
+        for (UINT uLevel = uMip; uLevel < m_uResidentMip; ++uLevel)
+        {
+            uSize += m_aMipLevels[uLevel].numBytes;
+        }
+
+        if (aMipData.size() != uSize)
+        {
+            return E_INVALIDARG;
+        }
+
+        return createMips(pDevice, pImmediateContext, uMip, aMipData.empty() ? nullptr : aMipData.data());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Texture::SetStreamingEnabled
+
+      Summary:  Sets whether textures loaded from DDS files are created
+                with their tail levels only and streamed
+
+      Args:     BOOL bEnabled
+                  TRUE to stream the mips
+
+      Modifies: [sm_bStreamingEnabled].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Texture::SetStreamingEnabled(_In_ BOOL bEnabled)
+    {
+        sm_bStreamingEnabled = bEnabled;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Texture::IsStreamingEnabled
+
+      Summary:  Returns whether mips are streamed
+
+      Returns:  BOOL
+                  TRUE if streaming is enabled
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL Texture::IsStreamingEnabled()
+    {
+        return sm_bStreamingEnabled;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Texture::createFromPixels
+
+      Summary:  Creates the texture from the decoded pixels and
+                generates its mip chain
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the texture
+                ID3D11DeviceContext* pImmediateContext
+                  The Direct3D context to upload and generate mips
+
+      Modifies: [m_textureRV].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Texture::createFromPixels(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext)
+    {
+        D3D11_TEXTURE2D_DESC textureDesc =
+        {
+            .Width = m_uWidth,
+            .Height = m_uHeight,
+            .MipLevels = 0u,
+            .ArraySize = 1u,
+            .Format = DXGI_FORMAT_R8G8B8A8_UNORM,
+            .SampleDesc = {.Count = 1u, .Quality = 0u },
+            .Usage = D3D11_USAGE_DEFAULT,
+            .BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET,
+            .CPUAccessFlags = 0u,
+            .MiscFlags = D3D11_RESOURCE_MISC_GENERATE_MIPS
+        };
+
+        ComPtr<ID3D11Texture2D> texture;
+        HRESULT hr = pDevice->CreateTexture2D(&textureDesc, nullptr, texture.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc =
+        {
+            .Format = textureDesc.Format,
+            .ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D,
+            .Texture2D = {.MostDetailedMip = 0u, .MipLevels = static_cast<UINT>(-1) }
+        };
+
+        hr = pDevice->CreateShaderResourceView(texture.Get(), &srvDesc, m_textureRV.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        pImmediateContext->UpdateSubresource(texture.Get(), 0u, nullptr, m_aPixels.data(), m_uWidth * 4u, static_cast<UINT>(m_aPixels.size()));
+        pImmediateContext->GenerateMips(m_textureRV.Get());
+
+        return hr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Texture::createStreamed
+
+      Summary:  Reads the mip chain of the DDS file in memory and
+                creates the texture with the levels from the tail on.
+                The tail is the first level no larger than
+                STREAMING_TAIL_SIZE. Leaves the texture uncreated if
+                there is nothing above the tail or a level above it
+                can not start a texture
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the texture
+                ID3D11DeviceContext* pImmediateContext
+                  The Direct3D context to upload the levels
+                const BYTE* pFileData
+                  The whole DDS file, read or mapped
+                size_t uFileSize
+                  Size of the file in bytes
+
+      Modifies: [m_format, m_aMipLevels, m_uResidentMip, m_uTailMip,
+                 m_texture2D, m_textureRV].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Texture::createStreamed(
+        _In_ ID3D11Device* pDevice,
+        _In_ ID3D11DeviceContext* pImmediateContext,
+        _In_reads_bytes_(uFileSize) const BYTE* pFileData,
+        _In_ size_t uFileSize
+    )
+    {
+        DDS_MIP_LEVEL aLevels[D3D11_REQ_MIP_LEVELS];
+        size_t uNumMips = 0u;
+        HRESULT hr = GetDDSTextureMipLevels(pFileData, uFileSize, &m_format, aLevels, &uNumMips);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        UINT uTailMip = 0u;
+        while (uTailMip + 1u < uNumMips
+            && (aLevels[uTailMip].width > STREAMING_TAIL_SIZE || aLevels[uTailMip].height > STREAMING_TAIL_SIZE))
+        {
+            // Compressed levels can only start a texture when they are whole blocks
+            if (aLevels[uTailMip].width % 4u != 0u || aLevels[uTailMip].height % 4u != 0u)
+            {
+                return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+            }
+
+            ++uTailMip;
+        }
+
+        if (uTailMip == 0u)
+        {
+            return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+        }
+
+        m_aMipLevels.assign(aLevels, aLevels + uNumMips);
+        m_uTailMip = uTailMip;
+        m_uResidentMip = static_cast<UINT>(uNumMips);
+
+        hr = createMips(pDevice, pImmediateContext, m_uTailMip, pFileData + m_aMipLevels[m_uTailMip].offset);
+        if (FAILED(hr))
+        {
+            m_aMipLevels.clear();
+            m_uTailMip = 0u;
+            m_uResidentMip = 0u;
+        }
+
+        return hr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Texture::createMips
+
+      Summary:  Creates the texture with the levels from the given mip
+                on and swaps it in. Levels finer than the resident mip
+                are uploaded from the given data, the others are copied
+                from the current texture on the GPU
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the texture
+                ID3D11DeviceContext* pImmediateContext
+                  The Direct3D context to upload and copy the levels
+                UINT uFirstMip
+                  Most detailed level of the new texture
+                const BYTE* pMipData
+                  Levels [uFirstMip, resident mip) stored back to back
+
+      Modifies: [m_texture2D, m_textureRV, m_uResidentMip].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Texture::createMips(
+        _In_ ID3D11Device* pDevice,
+        _In_ ID3D11DeviceContext* pImmediateContext,
+        _In_ UINT uFirstMip,
+        _In_opt_ const BYTE* pMipData
+    )
+    {
+        UINT uNumMips = static_cast<UINT>(m_aMipLevels.size());
+
+        D3D11_TEXTURE2D_DESC textureDesc =
+        {
+            .Width = m_aMipLevels[uFirstMip].width,
+            .Height = m_aMipLevels[uFirstMip].height,
+            .MipLevels = uNumMips - uFirstMip,
+            .ArraySize = 1u,
+            .Format = m_format,
+            .SampleDesc = {.Count = 1u, .Quality = 0u },
+            .Usage = D3D11_USAGE_DEFAULT,
+            .BindFlags = D3D11_BIND_SHADER_RESOURCE,
+            .CPUAccessFlags = 0u,
+            .MiscFlags = 0u
+        };
+
+        ComPtr<ID3D11Texture2D> texture;
+        HRESULT hr = pDevice->CreateTexture2D(&textureDesc, nullptr, texture.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc =
+        {
+            .Format = textureDesc.Format,
+            .ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D,
+            .Texture2D = {.MostDetailedMip = 0u, .MipLevels = static_cast<UINT>(-1) }
+        };
+
+        ComPtr<ID3D11ShaderResourceView> textureRV;
+        hr = pDevice->CreateShaderResourceView(texture.Get(), &srvDesc, textureRV.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        size_t uOffset = 0u;
+        for (UINT uMip = uFirstMip; uMip < uNumMips; ++uMip)
+        {
+            if (uMip < m_uResidentMip)
+            {
+                const DDS_MIP_LEVEL& level = m_aMipLevels[uMip];
+                pImmediateContext->UpdateSubresource(
+                    texture.Get(),
+                    uMip - uFirstMip,
+                    nullptr,
+                    pMipData + uOffset,
+                    static_cast<UINT>(level.rowBytes),
+                    static_cast<UINT>(level.numBytes)
+                );
+                uOffset += level.numBytes;
+            }
+            else
+            {
+                pImmediateContext->CopySubresourceRegion(texture.Get(), uMip - uFirstMip, 0u, 0u, 0u, m_texture2D.Get(), uMip - m_uResidentMip, nullptr);
+            }
+        }
+
+        // Draws fetch the view from the texture every frame, so the swap is picked up by the next one
+        m_texture2D = texture;
+        m_textureRV = textureRV;
+        m_uResidentMip = uFirstMip;
+
+        return hr;
+    }
 }
\ No newline at end of file
@@ -12,6 +12,9 @@
 
 #include "Common.h"
 
+#include "Texture/DDSTextureLoader.h"
+#include "Texture/MappedFile.h"
+
 namespace library
 {
     enum class eTextureSamplerType : size_t
@@ -24,6 +27,9 @@ namespace library
     class Texture
     {
     public:
+        // Levels this size or smaller are always resident when streaming
+        static constexpr UINT STREAMING_TAIL_SIZE = 64u;
+
         Texture() = delete;
         Texture(_In_ const std::filesystem::path& filePath, _In_opt_ eTextureSamplerType textureSamplerType = eTextureSamplerType::TRILINEAR_WRAP);
         Texture(const Texture& other) = delete;
@@ -32,18 +38,76 @@ namespace library
         Texture& operator=(Texture&& other) = delete;
         virtual ~Texture() = default;
 
-        // Should be called once to load the texture
+        // Reads and decodes the file, safe to call from a worker thread
+        virtual HRESULT Load();
+
+        // Creates the texture, does nothing if it is already created
         virtual HRESULT Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext);
 
         ComPtr<ID3D11ShaderResourceView>& GetTextureResourceView();
         eTextureSamplerType GetSamplerType() const;
+        const std::filesystem::path& GetFilePath() const;
+
+        // Mip streaming, only textures created from a DDS file with levels above the tail are streamable
+        BOOL IsStreamable() const;
+        UINT GetNumMips() const;
+        UINT GetResidentMip() const;
+        UINT GetTailMip() const;
+        UINT GetWidth() const;
+        UINT GetHeight() const;
+        UINT64 GetMipSize(_In_ UINT uMip) const;
+
+        // Reads the levels [uFirstMip, uEndMip) from the file, safe to call from a worker thread
+        HRESULT ReadMips(_In_ UINT uFirstMip, _In_ UINT uEndMip, _Out_ std::vector<BYTE>& aOutData) const;
+
+        // Recreates the texture with the levels from uMip on, aMipData holds the levels not yet resident
+        HRESULT SetResidentMip(
+            _In_ ID3D11Device* pDevice,
+            _In_ ID3D11DeviceContext* pImmediateContext,
+            _In_ UINT uMip,
+            _In_ const std::vector<BYTE>& aMipData
+        );
+
+        static void SetStreamingEnabled(_In_ BOOL bEnabled);
+        static BOOL IsStreamingEnabled();
 
     public:
         static ComPtr<ID3D11SamplerState> s_samplers[static_cast<size_t>(eTextureSamplerType::COUNT)];
 
+    protected:
+        HRESULT createFromPixels(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext);
+        HRESULT createStreamed(
+            _In_ ID3D11Device* pDevice,
+            _In_ ID3D11DeviceContext* pImmediateContext,
+            _In_reads_bytes_(uFileSize) const BYTE* pFileData,
+            _In_ size_t uFileSize
+        );
+        HRESULT createMips(
+            _In_ ID3D11Device* pDevice,
+            _In_ ID3D11DeviceContext* pImmediateContext,
+            _In_ UINT uFirstMip,
+            _In_opt_ const BYTE* pMipData
+        );
+
+    protected:
+        static BOOL sm_bStreamingEnabled;
+
     protected:
         std::filesystem::path m_filePath;
         ComPtr<ID3D11ShaderResourceView> m_textureRV;
         eTextureSamplerType m_textureSamplerType;
+
+        std::vector<BYTE> m_aFileData;
+        MappedFile m_mappedFile;
+        std::vector<BYTE> m_aPixels;
+        UINT m_uWidth;
+        UINT m_uHeight;
+
+        std::filesystem::path m_streamFilePath;
+        DXGI_FORMAT m_format;
+        std::vector<DirectX::DDS_MIP_LEVEL> m_aMipLevels;
+        UINT m_uResidentMip;
+        UINT m_uTailMip;
+        ComPtr<ID3D11Texture2D> m_texture2D;
     };
 }
\ No newline at end of file
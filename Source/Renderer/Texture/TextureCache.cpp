@@ -0,0 +1,179 @@
+#include "Texture/TextureCache.h"
+
+namespace library
+{
+    std::unordered_map<std::wstring, std::shared_ptr<Texture>> TextureCache::sm_textures;
+    std::mutex TextureCache::sm_mutex;
+    UINT TextureCache::sm_uNumHits = 0u;
+    UINT TextureCache::sm_uNumMisses = 0u;
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCache::GetTexture
+
+      Summary:  Returns the texture of the given file and sampler type.
+                A new texture is created on a miss, it is neither
+                loaded nor initialized
+
+      Args:     const std::filesystem::path& filePath
+                  Path to the image file
+                eTextureSamplerType textureSamplerType
+                  Sampler type of the texture
+
+      Modifies: [sm_textures, sm_uNumHits, sm_uNumMisses].
+
+      Returns:  std::shared_ptr<Texture>
+                  Shared texture
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    std::shared_ptr<Texture> TextureCache::GetTexture(
+        _In_ const std::filesystem::path& filePath,
+        _In_opt_ eTextureSamplerType textureSamplerType
+    )
+    {
+        std::wstring szKey = getKey(filePath, textureSamplerType);
+
+        std::lock_guard<std::mutex> lock(sm_mutex);
+
+        auto it = sm_textures.find(szKey);
+        if (it != sm_textures.end())
+        {
+            ++sm_uNumHits;
+            return it->second;
+        }
+
+        ++sm_uNumMisses;
+
+        std::shared_ptr<Texture> texture = std::make_shared<Texture>(filePath, textureSamplerType);
+        sm_textures.emplace(std::move(szKey), texture);
+
+        return texture;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCache::EvictUnused
+
+      Summary:  Removes the textures that are referenced only by the
+                cache, releasing their GPU resources
+
+      Modifies: [sm_textures].
+
+      Returns:  UINT
+                  Number of evicted textures
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT TextureCache::EvictUnused()
+    {
+        std::lock_guard<std::mutex> lock(sm_mutex);
+
+        UINT uNumEvicted = 0u;
+        for (auto it = sm_textures.begin(); it != sm_textures.end();)
+        {
+            if (it->second.use_count() == 1l)
+            {
+                it = sm_textures.erase(it);
+                ++uNumEvicted;
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        return uNumEvicted;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCache::Clear
+
+      Summary:  Removes every texture and resets the counters.
+                Textures still referenced elsewhere stay alive but are
+                no longer shared with new requests
+
+      Modifies: [sm_textures, sm_uNumHits, sm_uNumMisses].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TextureCache::Clear()
+    {
+        std::lock_guard<std::mutex> lock(sm_mutex);
+
+        sm_textures.clear();
+        sm_uNumHits = 0u;
+        sm_uNumMisses = 0u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCache::GetNumEntries
+
+      Summary:  Returns the number of cached textures
+
+      Returns:  UINT
+                  Number of cached textures
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT TextureCache::GetNumEntries()
+    {
+        std::lock_guard<std::mutex> lock(sm_mutex);
+
+        return static_cast<UINT>(sm_textures.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCache::GetNumHits
+
+      Summary:  Returns the number of requests that found a texture
+
+      Returns:  UINT
+                  Number of cache hits
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT TextureCache::GetNumHits()
+    {
+        std::lock_guard<std::mutex> lock(sm_mutex);
+
+        return sm_uNumHits;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCache::GetNumMisses
+
+      Summary:  Returns the number of requests that created a texture
+
+      Returns:  UINT
+                  Number of cache misses
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT TextureCache::GetNumMisses()
+    {
+        std::lock_guard<std::mutex> lock(sm_mutex);
+
+        return sm_uNumMisses;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCache::getKey
+
+      Summary:  Builds the cache key from the canonical, lower case
+                path and the sampler type, so that different spellings
+                of the same file share one texture
+
+      Args:     const std::filesystem::path& filePath
+                  Path to the image file
+                eTextureSamplerType textureSamplerType
+                  Sampler type of the texture
+
+      Returns:  std::wstring
+                  Cache key
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    std::wstring TextureCache::getKey(_In_ const std::filesystem::path& filePath, _In_ eTextureSamplerType textureSamplerType)
+    {
+        std::error_code errorCode;
+        std::filesystem::path canonicalPath = std::filesystem::weakly_canonical(filePath, errorCode);
+        if (errorCode)
+        {
+            canonicalPath = filePath.lexically_normal();
+        }
+
+        // File names are case-insensitive on Windows
+        std::wstring szKey = canonicalPath.wstring();
+        CharLowerBuffW(szKey.data(), static_cast<DWORD>(szKey.size()));
+
+        szKey += L'|';
+        szKey += std::to_wstring(static_cast<size_t>(textureSamplerType));
+
+        return szKey;
+    }
+}
\ No newline at end of file
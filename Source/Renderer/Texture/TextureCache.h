@@ -0,0 +1,77 @@
+/*+===================================================================
+  File:      TEXTURECACHE.H
+
+  Summary:   TextureCache header file contains declaration of class
+             TextureCache that shares one Texture object between all
+             materials using the same image file, so that every file
+             is decoded and uploaded only once.
+
+  Classes: TextureCache
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include <mutex>
+#include <unordered_map>
+
+#include "Texture/Texture.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    TextureCache
+
+      Summary:  Global cache of textures keyed by the canonical path of
+                the image file and the sampler type. The cache holds a
+                reference to every texture it hands out until the
+                texture is evicted. Safe to use from the loader threads
+
+      Methods:  GetTexture
+                  Returns the shared texture of the given file,
+                  creating it on a miss
+                EvictUnused
+                  Removes the textures no one else references
+                Clear
+                  Removes every texture and resets the counters
+                GetNumEntries
+                  Returns the number of cached textures
+                GetNumHits
+                  Returns the number of requests that found a texture
+                GetNumMisses
+                  Returns the number of requests that created a
+                  texture
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class TextureCache
+    {
+    public:
+        TextureCache() = delete;
+        TextureCache(const TextureCache& other) = delete;
+        TextureCache(TextureCache&& other) = delete;
+        TextureCache& operator=(const TextureCache& other) = delete;
+        TextureCache& operator=(TextureCache&& other) = delete;
+        ~TextureCache() = delete;
+
+        static std::shared_ptr<Texture> GetTexture(
+            _In_ const std::filesystem::path& filePath,
+            _In_opt_ eTextureSamplerType textureSamplerType = eTextureSamplerType::TRILINEAR_WRAP
+        );
+        static UINT EvictUnused();
+        static void Clear();
+
+        static UINT GetNumEntries();
+        static UINT GetNumHits();
+        static UINT GetNumMisses();
+
+    private:
+        static std::wstring getKey(_In_ const std::filesystem::path& filePath, _In_ eTextureSamplerType textureSamplerType);
+
+    private:
+        static std::unordered_map<std::wstring, std::shared_ptr<Texture>> sm_textures;
+        static std::mutex sm_mutex;
+        static UINT sm_uNumHits;
+        static UINT sm_uNumMisses;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,1299 @@
+#include "Texture/TextureCooker.h"
+
+#include <array>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <fstream>
+
+namespace library
+{
+    std::filesystem::path TextureCooker::sm_cacheDirectory = L"Cache/Textures";
+    BOOL TextureCooker::sm_bEnabled = TRUE;
+    BOOL TextureCooker::sm_bHighQuality = FALSE;
+    TextureCookStats TextureCooker::sm_stats = {};
+    std::mutex TextureCooker::sm_mutex;
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCooker::ComputeKey
+
+      Summary:  Hashes the contents and the path of the source file
+                together with the quality setting and the cooker
+                version
+
+      Args:     const std::filesystem::path& sourcePath
+                  Path to the image file
+                UINT64& uOutKey
+                  Computed key
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT TextureCooker::ComputeKey(_In_ const std::filesystem::path& sourcePath, _Out_ UINT64& uOutKey)
+    {
+        uOutKey = 0ull;
+
+        std::ifstream file(sourcePath, std::ios::binary | std::ios::ate);
+        if (!file)
+        {
+            return HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND);
+        }
+
+        std::vector<BYTE> aData(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(aData.data()), static_cast<std::streamsize>(aData.size()));
+        if (!file)
+        {
+            return E_FAIL;
+        }
+
+        UINT64 uHash = HashBytes(HASH_OFFSET_BASIS, aData.data(), aData.size());
+
+        std::wstring szPath = sourcePath.lexically_normal().generic_wstring();
+        uHash = HashBytes(uHash, szPath.data(), szPath.size() * sizeof(WCHAR));
+        uHash = HashBytes(uHash, &sm_bHighQuality, sizeof(sm_bHighQuality));
+
+        UINT uVersion = VERSION;
+        uHash = HashBytes(uHash, &uVersion, sizeof(uVersion));
+
+        uOutKey = uHash;
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCooker::Cook
+
+      Summary:  Generates the mip chain of the image, compresses every
+                level and writes them after a DDS header. The time
+                taken and the sizes are added to the totals and
+                written to the debug output
+
+      Args:     const std::filesystem::path& sourcePath
+                  Path to the image file
+                UINT64 uKey
+                  Key computed by ComputeKey
+                UINT uWidth
+                  Width of the image, a multiple of the block
+                  dimension
+                UINT uHeight
+                  Height of the image, a multiple of the block
+                  dimension
+                const std::vector<BYTE>& aPixels
+                  RGBA8 pixels of the image
+                std::vector<BYTE>& outFile
+                  Contents of the DDS file
+
+      Modifies: [sm_stats].
+
+      Returns:  HRESULT
+                  Status code, E_INVALIDARG if the image can not be
+                  block compressed
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT TextureCooker::Cook(
+        _In_ const std::filesystem::path& sourcePath,
+        _In_ UINT64 uKey,
+        _In_ UINT uWidth,
+        _In_ UINT uHeight,
+        _In_ const std::vector<BYTE>& aPixels,
+        _Out_ std::vector<BYTE>& outFile
+    )
+    {
+        outFile.clear();
+
+        // Direct3D 11 needs the top level of a block compressed texture to be whole blocks
+        if (uWidth == 0u || uHeight == 0u || uWidth % BLOCK_DIMENSION != 0u || uHeight % BLOCK_DIMENSION != 0u
+            || aPixels.size() != static_cast<size_t>(uWidth) * uHeight * 4u)
+        {
+            return E_INVALIDARG;
+        }
+
+        LARGE_INTEGER Frequency;
+        LARGE_INTEGER StartTime;
+        LARGE_INTEGER MipTime;
+        LARGE_INTEGER EndTime;
+        QueryPerformanceFrequency(&Frequency);
+        QueryPerformanceCounter(&StartTime);
+
+        eTextureFormat format = ChooseFormat(sourcePath, aPixels);
+
+        std::vector<std::vector<BYTE>> aMips;
+        GenerateMips(uWidth, uHeight, aPixels, format == eTextureFormat::BC5, aMips);
+
+        QueryPerformanceCounter(&MipTime);
+
+        writeHeader(format, uWidth, uHeight, static_cast<UINT>(aMips.size()), uKey, outFile);
+
+        UINT64 uNumTexels = 0ull;
+        UINT uMipWidth = uWidth;
+        UINT uMipHeight = uHeight;
+        for (const std::vector<BYTE>& aMip : aMips)
+        {
+            EncodeBlocks(format, uMipWidth, uMipHeight, aMip.data(), outFile);
+
+            uNumTexels += static_cast<UINT64>(uMipWidth) * uMipHeight;
+            uMipWidth = uMipWidth > 1u ? uMipWidth / 2u : 1u;
+            uMipHeight = uMipHeight > 1u ? uMipHeight / 2u : 1u;
+        }
+
+        QueryPerformanceCounter(&EndTime);
+
+        DOUBLE mipSeconds = static_cast<DOUBLE>(MipTime.QuadPart - StartTime.QuadPart) / static_cast<DOUBLE>(Frequency.QuadPart);
+        DOUBLE encodeSeconds = static_cast<DOUBLE>(EndTime.QuadPart - MipTime.QuadPart) / static_cast<DOUBLE>(Frequency.QuadPart);
+        UINT64 uUncompressedSize = uNumTexels * 4u;
+        UINT64 uCookedSize = outFile.size() - DDS_HEADER_SIZE;
+
+        {
+            std::lock_guard<std::mutex> lock(sm_mutex);
+
+            ++sm_stats.uNumTextures;
+            sm_stats.uNumTexels += uNumTexels;
+            sm_stats.uUncompressedSize += uUncompressedSize;
+            sm_stats.uCookedSize += uCookedSize;
+            sm_stats.MipSeconds += mipSeconds;
+            sm_stats.EncodeSeconds += encodeSeconds;
+        }
+
+        static constexpr PCSTR s_aszFormatNames[static_cast<size_t>(eTextureFormat::COUNT)] = { "BC1", "BC3", "BC5", "BC7" };
+
+        CHAR szDebugMessage[160];
+        sprintf_s(
+            szDebugMessage,
+            "\" to %s, %llu KiB to %llu KiB (%.1f:1), mips in %.2f ms, encoded at %.1f Mtexels/s\n",
+            s_aszFormatNames[static_cast<size_t>(format)],
+            uUncompressedSize / 1024ull,
+            uCookedSize / 1024ull,
+            static_cast<DOUBLE>(uUncompressedSize) / static_cast<DOUBLE>(uCookedSize),
+            mipSeconds * 1000.0,
+            encodeSeconds > 0.0 ? static_cast<DOUBLE>(uNumTexels) / encodeSeconds / 1000000.0 : 0.0
+        );
+        OutputDebugString(L"Cooked texture \"");
+        OutputDebugString(sourcePath.c_str());
+        OutputDebugStringA(szDebugMessage);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCooker::Load
+
+      Summary:  Reads the cached DDS file of the given key. Files whose
+                header does not carry the key and version are rejected
+
+      Args:     const std::filesystem::path& sourcePath
+                  Path to the image file
+                UINT64 uKey
+                  Key computed by ComputeKey
+                std::vector<BYTE>& outFile
+                  Contents of the DDS file
+
+      Returns:  HRESULT
+                  Status code, failure means a cache miss
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT TextureCooker::Load(_In_ const std::filesystem::path& sourcePath, _In_ UINT64 uKey, _Out_ std::vector<BYTE>& outFile)
+    {
+        outFile.clear();
+
+        std::filesystem::path cacheFilePath = GetCacheFilePath(sourcePath, uKey);
+
+        std::ifstream file(cacheFilePath, std::ios::binary | std::ios::ate);
+        if (!file)
+        {
+            return HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND);
+        }
+
+        outFile.resize(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(outFile.data()), static_cast<std::streamsize>(outFile.size()));
+
+        UINT aHeader[DDS_HEADER_SIZE / sizeof(UINT)] = {};
+        if (file && outFile.size() > DDS_HEADER_SIZE)
+        {
+            memcpy(aHeader, outFile.data(), DDS_HEADER_SIZE);
+        }
+
+        if (aHeader[0] != DDS_MAGIC
+            || aHeader[21] != DDS_FOURCC_DX10
+            || aHeader[8] != static_cast<UINT>(uKey)
+            || aHeader[9] != static_cast<UINT>(uKey >> 32u)
+            || aHeader[10] != VERSION)
+        {
+            outFile.clear();
+
+            OutputDebugString(L"Ignoring corrupted texture cache \"");
+            OutputDebugString(cacheFilePath.c_str());
+            OutputDebugString(L"\"\n");
+
+            return E_FAIL;
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCooker::Save
+
+      Summary:  Writes the DDS file to the cache file of the given key.
+                The file is written next to the destination and then
+                moved over it, so a crash never leaves a partial cache
+                file behind
+
+      Args:     const std::filesystem::path& sourcePath
+                  Path to the image file
+                UINT64 uKey
+                  Key computed by ComputeKey
+                const std::vector<BYTE>& file
+                  Contents of the DDS file
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT TextureCooker::Save(_In_ const std::filesystem::path& sourcePath, _In_ UINT64 uKey, _In_ const std::vector<BYTE>& file)
+    {
+        std::error_code errorCode;
+        std::filesystem::create_directories(sm_cacheDirectory, errorCode);
+        if (errorCode)
+        {
+            return HRESULT_FROM_WIN32(errorCode.value());
+        }
+
+        std::filesystem::path cacheFilePath = GetCacheFilePath(sourcePath, uKey);
+        std::filesystem::path tempFilePath = cacheFilePath;
+        tempFilePath += L".tmp";
+
+        HANDLE hFile = CreateFile(
+            tempFilePath.c_str(),
+            GENERIC_WRITE,
+            0u,
+            nullptr,
+            CREATE_ALWAYS,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+            nullptr
+        );
+        if (hFile == INVALID_HANDLE_VALUE)
+        {
+            return HRESULT_FROM_WIN32(GetLastError());
+        }
+
+        DWORD dwBytesWritten = 0u;
+        BOOL bWritten = WriteFile(hFile, file.data(), static_cast<DWORD>(file.size()), &dwBytesWritten, nullptr);
+        CloseHandle(hFile);
+
+        if (!bWritten || dwBytesWritten != file.size())
+        {
+            DeleteFile(tempFilePath.c_str());
+            return E_FAIL;
+        }
+
+        if (!MoveFileEx(tempFilePath.c_str(), cacheFilePath.c_str(), MOVEFILE_REPLACE_EXISTING))
+        {
+            HRESULT hr = HRESULT_FROM_WIN32(GetLastError());
+            DeleteFile(tempFilePath.c_str());
+            return hr;
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCooker::ChooseFormat
+
+      Summary:  Returns the BC format of an image. Normal maps, told
+                apart by their file name, use BC5. Colors use BC7 when
+                high quality is set, otherwise BC1 if every pixel is
+                opaque and BC3 if not
+
+      Args:     const std::filesystem::path& sourcePath
+                  Path to the image file
+                const std::vector<BYTE>& aPixels
+                  RGBA8 pixels of the image
+
+      Returns:  eTextureFormat
+                  BC format
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    eTextureFormat TextureCooker::ChooseFormat(_In_ const std::filesystem::path& sourcePath, _In_ const std::vector<BYTE>& aPixels)
+    {
+        if (isNormalMap(sourcePath))
+        {
+            return eTextureFormat::BC5;
+        }
+
+        if (sm_bHighQuality)
+        {
+            return eTextureFormat::BC7;
+        }
+
+        for (size_t i = 3u; i < aPixels.size(); i += 4u)
+        {
+            if (aPixels[i] != 0xFFu)
+            {
+                return eTextureFormat::BC3;
+            }
+        }
+
+        return eTextureFormat::BC1;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCooker::GenerateMips
+
+      Summary:  Builds the mip chain of an image down to one texel by
+                averaging 2x2 texels of the level above, the last row
+                or column repeated for odd sizes. Colors are averaged
+                in linear space so dark and bright texels keep their
+                brightness, alpha is averaged as is. Normals are
+                averaged as vectors and normalized again
+
+      Args:     UINT uWidth
+                  Width of the image
+                UINT uHeight
+                  Height of the image
+                const std::vector<BYTE>& aPixels
+                  RGBA8 pixels of the image
+                BOOL bNormalMap
+                  Whether the image stores normals
+                std::vector<std::vector<BYTE>>& aOutMips
+                  RGBA8 pixels of every level, the first being the
+                  image itself
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TextureCooker::GenerateMips(
+        _In_ UINT uWidth,
+        _In_ UINT uHeight,
+        _In_ const std::vector<BYTE>& aPixels,
+        _In_ BOOL bNormalMap,
+        _Out_ std::vector<std::vector<BYTE>>& aOutMips
+    )
+    {
+        aOutMips.clear();
+        aOutMips.push_back(aPixels);
+
+        UINT uSourceWidth = uWidth;
+        UINT uSourceHeight = uHeight;
+        while (uSourceWidth > 1u || uSourceHeight > 1u)
+        {
+            UINT uMipWidth = uSourceWidth > 1u ? uSourceWidth / 2u : 1u;
+            UINT uMipHeight = uSourceHeight > 1u ? uSourceHeight / 2u : 1u;
+
+            std::vector<BYTE> aMip(static_cast<size_t>(uMipWidth) * uMipHeight * 4u);
+            const BYTE* pSource = aOutMips.back().data();
+
+            for (UINT y = 0u; y < uMipHeight; ++y)
+            {
+                UINT uRow0 = 2u * y;
+                UINT uRow1 = 2u * y + 1u < uSourceHeight ? 2u * y + 1u : uSourceHeight - 1u;
+
+                for (UINT x = 0u; x < uMipWidth; ++x)
+                {
+                    UINT uColumn0 = 2u * x;
+                    UINT uColumn1 = 2u * x + 1u < uSourceWidth ? 2u * x + 1u : uSourceWidth - 1u;
+
+                    const BYTE* apSourceTexels[4] =
+                    {
+                        pSource + (static_cast<size_t>(uRow0) * uSourceWidth + uColumn0) * 4u,
+                        pSource + (static_cast<size_t>(uRow0) * uSourceWidth + uColumn1) * 4u,
+                        pSource + (static_cast<size_t>(uRow1) * uSourceWidth + uColumn0) * 4u,
+                        pSource + (static_cast<size_t>(uRow1) * uSourceWidth + uColumn1) * 4u,
+                    };
+
+                    XMVECTOR texel;
+                    if (bNormalMap)
+                    {
+                        XMVECTOR aTexels[4] =
+                        {
+                            loadTexel(apSourceTexels[0]),
+                            loadTexel(apSourceTexels[1]),
+                            loadTexel(apSourceTexels[2]),
+                            loadTexel(apSourceTexels[3]),
+                        };
+
+                        XMVECTOR sum = XMVectorZero();
+                        for (const XMVECTOR& normal : aTexels)
+                        {
+                            sum = XMVectorAdd(sum, XMVectorMultiplyAdd(normal, XMVectorReplicate(2.0f), XMVectorReplicate(-1.0f)));
+                        }
+
+                        // Opposite normals cancel out, point the average straight out of the surface
+                        XMVECTOR normal = XMVectorGetX(XMVector3LengthSq(sum)) > 1e-8f ? XMVector3Normalize(sum) : g_XMIdentityR2.v;
+                        texel = XMVectorMultiplyAdd(normal, XMVectorReplicate(0.5f), XMVectorReplicate(0.5f));
+                        texel = XMVectorSetW(texel, XMVectorGetW(sum) * 0.125f + 0.5f);
+                    }
+                    else
+                    {
+                        XMVECTOR sum = XMVectorZero();
+                        for (const BYTE* pTexel : apSourceTexels)
+                        {
+                            sum = XMVectorAdd(sum, loadLinearTexel(pTexel));
+                        }
+
+                        texel = XMColorRGBToSRGB(XMVectorScale(sum, 0.25f));
+                    }
+
+                    storeTexel(texel, aMip.data() + (static_cast<size_t>(y) * uMipWidth + x) * 4u);
+                }
+            }
+
+            aOutMips.push_back(std::move(aMip));
+            uSourceWidth = uMipWidth;
+            uSourceHeight = uMipHeight;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCooker::EncodeBlocks
+
+      Summary:  Compresses one level block by block, blocks reaching
+                past the edge of a small level repeat its last texels
+
+      Args:     eTextureFormat format
+                  BC format
+                UINT uWidth
+                  Width of the level
+                UINT uHeight
+                  Height of the level
+                const BYTE* pPixels
+                  RGBA8 pixels of the level
+                std::vector<BYTE>& aBlocks
+                  Buffer the blocks are appended to
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TextureCooker::EncodeBlocks(
+        _In_ eTextureFormat format,
+        _In_ UINT uWidth,
+        _In_ UINT uHeight,
+        _In_reads_bytes_(uWidth * uHeight * 4u) const BYTE* pPixels,
+        _Inout_ std::vector<BYTE>& aBlocks
+    )
+    {
+        UINT uBlockSize = GetBlockSize(format);
+        UINT uNumBlocksX = (uWidth + BLOCK_DIMENSION - 1u) / BLOCK_DIMENSION;
+        UINT uNumBlocksY = (uHeight + BLOCK_DIMENSION - 1u) / BLOCK_DIMENSION;
+
+        size_t uOffset = aBlocks.size();
+        aBlocks.resize(uOffset + static_cast<size_t>(uNumBlocksX) * uNumBlocksY * uBlockSize);
+        BYTE* pBlock = aBlocks.data() + uOffset;
+
+        BYTE aTexels[BLOCK_DIMENSION * BLOCK_DIMENSION * 4u];
+        for (UINT uBlockY = 0u; uBlockY < uNumBlocksY; ++uBlockY)
+        {
+            for (UINT uBlockX = 0u; uBlockX < uNumBlocksX; ++uBlockX)
+            {
+                fetchBlock(uWidth, uHeight, pPixels, uBlockX, uBlockY, aTexels);
+
+                switch (format)
+                {
+                case eTextureFormat::BC1:
+                    encodeColorBlock(aTexels, pBlock);
+                    break;
+                case eTextureFormat::BC3:
+                    encodeChannelBlock(aTexels, 3u, pBlock);
+                    encodeColorBlock(aTexels, pBlock + 8u);
+                    break;
+                case eTextureFormat::BC5:
+                    encodeChannelBlock(aTexels, 0u, pBlock);
+                    encodeChannelBlock(aTexels, 1u, pBlock + 8u);
+                    break;
+                case eTextureFormat::BC7:
+                    encodeBC7Block(aTexels, pBlock);
+                    break;
+                default:
+                    assert(FALSE);
+                    break;
+                }
+
+                pBlock += uBlockSize;
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCooker::GetDxgiFormat
+
+      Summary:  Returns the DXGI format of a BC format. The formats
+                are not sRGB, the shaders read the texels as they are
+                like the uncompressed textures
+
+      Args:     eTextureFormat format
+                  BC format
+
+      Returns:  DXGI_FORMAT
+                  DXGI format
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    DXGI_FORMAT TextureCooker::GetDxgiFormat(_In_ eTextureFormat format)
+    {
+        switch (format)
+        {
+        case eTextureFormat::BC1:
+            return DXGI_FORMAT_BC1_UNORM;
+        case eTextureFormat::BC3:
+            return DXGI_FORMAT_BC3_UNORM;
+        case eTextureFormat::BC5:
+            return DXGI_FORMAT_BC5_UNORM;
+        case eTextureFormat::BC7:
+            return DXGI_FORMAT_BC7_UNORM;
+        default:
+            return DXGI_FORMAT_UNKNOWN;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCooker::GetBlockSize
+
+      Summary:  Returns the bytes of a 4x4 block of a BC format
+
+      Args:     eTextureFormat format
+                  BC format
+
+      Returns:  UINT
+                  Bytes of a block
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT TextureCooker::GetBlockSize(_In_ eTextureFormat format)
+    {
+        return format == eTextureFormat::BC1 ? 8u : 16u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCooker::SetEnabled
+
+      Summary:  Enables or disables cooking. When disabled, textures
+                are uploaded uncompressed and their mips are generated
+                on the GPU
+
+      Args:     BOOL bEnabled
+                  TRUE to cook textures
+
+      Modifies: [sm_bEnabled].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TextureCooker::SetEnabled(_In_ BOOL bEnabled)
+    {
+        sm_bEnabled = bEnabled;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCooker::IsEnabled
+
+      Summary:  Returns whether textures are cooked
+
+      Returns:  BOOL
+                  TRUE if textures are cooked
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL TextureCooker::IsEnabled()
+    {
+        return sm_bEnabled;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCooker::SetHighQuality
+
+      Summary:  Sets whether color textures are cooked to BC7 instead
+                of BC1 and BC3. The setting is part of the key, so
+                changing it cooks the textures again
+
+      Args:     BOOL bHighQuality
+                  TRUE to use BC7
+
+      Modifies: [sm_bHighQuality].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TextureCooker::SetHighQuality(_In_ BOOL bHighQuality)
+    {
+        sm_bHighQuality = bHighQuality;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCooker::SetCacheDirectory
+
+      Summary:  Sets the directory that holds the cooked files
+
+      Args:     const std::filesystem::path& cacheDirectory
+                  Directory of the cooked files
+
+      Modifies: [sm_cacheDirectory].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TextureCooker::SetCacheDirectory(_In_ const std::filesystem::path& cacheDirectory)
+    {
+        sm_cacheDirectory = cacheDirectory;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCooker::GetStats
+
+      Summary:  Returns the totals of the textures cooked since the
+                last reset
+
+      Returns:  TextureCookStats
+                  Totals of the cooked textures
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    TextureCookStats TextureCooker::GetStats()
+    {
+        std::lock_guard<std::mutex> lock(sm_mutex);
+
+        return sm_stats;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCooker::ResetStats
+
+      Summary:  Clears the totals
+
+      Modifies: [sm_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TextureCooker::ResetStats()
+    {
+        std::lock_guard<std::mutex> lock(sm_mutex);
+
+        sm_stats = {};
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCooker::isNormalMap
+
+      Summary:  Returns whether the file name marks a normal map, like
+                the "_ddn" maps of the models
+
+      Args:     const std::filesystem::path& sourcePath
+                  Path to the image file
+
+      Returns:  BOOL
+                  TRUE if the image stores normals
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL TextureCooker::isNormalMap(_In_ const std::filesystem::path& sourcePath)
+    {
+        std::wstring szStem = sourcePath.stem().wstring();
+        CharLowerBuffW(szStem.data(), static_cast<DWORD>(szStem.size()));
+
+        return szStem.ends_with(L"ddn") || szStem.ends_with(L"normal");
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCooker::GetCacheFilePath
+
+      Summary:  Returns the path to the cooked file of the given key
+
+      Args:     const std::filesystem::path& sourcePath
+                  Path to the image file
+                UINT64 uKey
+                  Key computed by ComputeKey
+
+      Returns:  std::filesystem::path
+                  Path to the cooked file
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    std::filesystem::path TextureCooker::GetCacheFilePath(_In_ const std::filesystem::path& sourcePath, _In_ UINT64 uKey)
+    {
+        WCHAR szKey[17];
+        swprintf_s(szKey, L"%016llx", uKey);
+
+        return sm_cacheDirectory / (sourcePath.stem().wstring() + L"_" + szKey + L".dds");
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCooker::writeHeader
+
+      Summary:  Appends the magic number, the DDS header and the DX10
+                header of a 2D texture with a mip chain. The key and
+                version go to the reserved words of the header
+
+      Args:     eTextureFormat format
+                  BC format
+                UINT uWidth
+                  Width of the top level
+                UINT uHeight
+                  Height of the top level
+                UINT uNumMips
+                  Number of levels
+                UINT64 uKey
+                  Key computed by ComputeKey
+                std::vector<BYTE>& aFile
+                  Buffer to append to
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TextureCooker::writeHeader(
+        _In_ eTextureFormat format,
+        _In_ UINT uWidth,
+        _In_ UINT uHeight,
+        _In_ UINT uNumMips,
+        _In_ UINT64 uKey,
+        _Inout_ std::vector<BYTE>& aFile
+    )
+    {
+        UINT aHeader[DDS_HEADER_SIZE / sizeof(UINT)] = {};
+
+        aHeader[0] = DDS_MAGIC;
+
+        // DDS_HEADER: caps, height, width, pixel format, mip count and linear size are valid
+        aHeader[1] = 124u;
+        aHeader[2] = 0x000A1007u;
+        aHeader[3] = uHeight;
+        aHeader[4] = uWidth;
+        aHeader[5] = ((uWidth + BLOCK_DIMENSION - 1u) / BLOCK_DIMENSION) * ((uHeight + BLOCK_DIMENSION - 1u) / BLOCK_DIMENSION) * GetBlockSize(format);
+        aHeader[7] = uNumMips;
+        aHeader[8] = static_cast<UINT>(uKey);
+        aHeader[9] = static_cast<UINT>(uKey >> 32u);
+        aHeader[10] = VERSION;
+
+        // DDS_PIXELFORMAT: the format is in the DX10 header
+        aHeader[19] = 32u;
+        aHeader[20] = 0x00000004u;
+        aHeader[21] = DDS_FOURCC_DX10;
+
+        // Texture, complex and mipmap caps
+        aHeader[27] = 0x00401008u;
+
+        // DDS_HEADER_DXT10: a single 2D texture
+        aHeader[32] = static_cast<UINT>(GetDxgiFormat(format));
+        aHeader[33] = static_cast<UINT>(D3D11_RESOURCE_DIMENSION_TEXTURE2D);
+        aHeader[35] = 1u;
+
+        const BYTE* pBytes = reinterpret_cast<const BYTE*>(aHeader);
+        aFile.insert(aFile.end(), pBytes, pBytes + DDS_HEADER_SIZE);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCooker::fetchBlock
+
+      Summary:  Copies the 4x4 texels of a block, clamping to the last
+                row and column of the level
+
+      Args:     UINT uWidth
+                  Width of the level
+                UINT uHeight
+                  Height of the level
+                const BYTE* pPixels
+                  RGBA8 pixels of the level
+                UINT uBlockX
+                  Column of the block
+                UINT uBlockY
+                  Row of the block
+                BYTE* pOutTexels
+                  RGBA8 texels of the block in rows
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TextureCooker::fetchBlock(
+        _In_ UINT uWidth,
+        _In_ UINT uHeight,
+        _In_ const BYTE* pPixels,
+        _In_ UINT uBlockX,
+        _In_ UINT uBlockY,
+        _Out_writes_(64) BYTE* pOutTexels
+    )
+    {
+        for (UINT y = 0u; y < BLOCK_DIMENSION; ++y)
+        {
+            UINT uRow = uBlockY * BLOCK_DIMENSION + y;
+            uRow = uRow < uHeight ? uRow : uHeight - 1u;
+
+            for (UINT x = 0u; x < BLOCK_DIMENSION; ++x)
+            {
+                UINT uColumn = uBlockX * BLOCK_DIMENSION + x;
+                uColumn = uColumn < uWidth ? uColumn : uWidth - 1u;
+
+                memcpy(pOutTexels + (y * BLOCK_DIMENSION + x) * 4u, pPixels + (static_cast<size_t>(uRow) * uWidth + uColumn) * 4u, 4u);
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCooker::loadTexel
+
+      Summary:  Loads an RGBA8 texel as a vector in [0, 1]
+
+      Args:     const BYTE* pTexel
+                  RGBA8 texel
+
+      Returns:  XMVECTOR
+                  Texel
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    XMVECTOR TextureCooker::loadTexel(_In_reads_(4) const BYTE* pTexel)
+    {
+        XMVECTOR texel = XMVectorSet(
+            static_cast<FLOAT>(pTexel[0]),
+            static_cast<FLOAT>(pTexel[1]),
+            static_cast<FLOAT>(pTexel[2]),
+            static_cast<FLOAT>(pTexel[3])
+        );
+
+        return XMVectorScale(texel, 1.0f / 255.0f);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCooker::loadLinearTexel
+
+      Summary:  Loads an sRGB RGBA8 texel as a linear color in [0, 1],
+                alpha as is. The 256 values a channel can take are
+                converted once into a table, the power in the sRGB
+                curve otherwise takes most of the mip time
+
+      Args:     const BYTE* pTexel
+                  RGBA8 texel
+
+      Returns:  XMVECTOR
+                  Linear texel
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    XMVECTOR TextureCooker::loadLinearTexel(_In_reads_(4) const BYTE* pTexel)
+    {
+        static const std::array<FLOAT, 256> s_aLinearValues = []()
+        {
+            std::array<FLOAT, 256> aValues;
+            for (UINT i = 0u; i < 256u; ++i)
+            {
+                aValues[i] = XMVectorGetX(XMColorSRGBToRGB(XMVectorReplicate(static_cast<FLOAT>(i) / 255.0f)));
+            }
+
+            return aValues;
+        }();
+
+        return XMVectorSet(
+            s_aLinearValues[pTexel[0]],
+            s_aLinearValues[pTexel[1]],
+            s_aLinearValues[pTexel[2]],
+            static_cast<FLOAT>(pTexel[3]) * (1.0f / 255.0f)
+        );
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCooker::storeTexel
+
+      Summary:  Rounds a vector in [0, 1] to an RGBA8 texel
+
+      Args:     FXMVECTOR texel
+                  Texel
+                BYTE* pOutTexel
+                  RGBA8 texel
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TextureCooker::storeTexel(_In_ FXMVECTOR texel, _Out_writes_(4) BYTE* pOutTexel)
+    {
+        XMFLOAT4 value;
+        XMStoreFloat4(&value, XMVectorMultiplyAdd(XMVectorSaturate(texel), XMVectorReplicate(255.0f), XMVectorReplicate(0.5f)));
+
+        pOutTexel[0] = static_cast<BYTE>(value.x);
+        pOutTexel[1] = static_cast<BYTE>(value.y);
+        pOutTexel[2] = static_cast<BYTE>(value.z);
+        pOutTexel[3] = static_cast<BYTE>(value.w);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCooker::packColor565
+
+      Summary:  Rounds a color in [0, 255] to 5:6:5 bits
+
+      Args:     FXMVECTOR color
+                  Color
+
+      Returns:  WORD
+                  Packed color
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    WORD TextureCooker::packColor565(_In_ FXMVECTOR color)
+    {
+        XMFLOAT4 value;
+        XMStoreFloat4(&value, XMVectorMultiplyAdd(color, XMVectorSet(31.0f / 255.0f, 63.0f / 255.0f, 31.0f / 255.0f, 0.0f), XMVectorReplicate(0.5f)));
+
+        return static_cast<WORD>((static_cast<UINT>(value.x) << 11u) | (static_cast<UINT>(value.y) << 5u) | static_cast<UINT>(value.z));
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCooker::unpackColor565
+
+      Summary:  Expands a 5:6:5 color to [0, 255] the way the GPU does
+
+      Args:     WORD uColor
+                  Packed color
+
+      Returns:  XMVECTOR
+                  Color
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    XMVECTOR TextureCooker::unpackColor565(_In_ WORD uColor)
+    {
+        UINT uRed = (uColor >> 11u) & 0x1Fu;
+        UINT uGreen = (uColor >> 5u) & 0x3Fu;
+        UINT uBlue = uColor & 0x1Fu;
+
+        return XMVectorSet(
+            static_cast<FLOAT>((uRed << 3u) | (uRed >> 2u)),
+            static_cast<FLOAT>((uGreen << 2u) | (uGreen >> 4u)),
+            static_cast<FLOAT>((uBlue << 3u) | (uBlue >> 2u)),
+            0.0f
+        );
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCooker::encodeColorBlock
+
+      Summary:  Compresses the colors of a block to a BC1 block in four
+                color mode. The endpoints are the extremes of the
+                colors along their principal axis, moved inwards by a
+                sixteenth of their range, and every texel takes the
+                nearest of the four palette colors
+
+      Args:     const BYTE* pTexels
+                  RGBA8 texels of the block
+                BYTE* pOutBlock
+                  BC1 block
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TextureCooker::encodeColorBlock(_In_reads_(64) const BYTE* pTexels, _Out_writes_bytes_(8) BYTE* pOutBlock)
+    {
+        XMVECTOR aColors[16];
+        XMVECTOR mean = XMVectorZero();
+        for (UINT i = 0u; i < 16u; ++i)
+        {
+            aColors[i] = XMVectorSetW(XMVectorScale(loadTexel(pTexels + i * 4u), 255.0f), 0.0f);
+            mean = XMVectorAdd(mean, aColors[i]);
+        }
+        mean = XMVectorScale(mean, 1.0f / 16.0f);
+
+        XMVECTOR axis = findPrincipalAxis(aColors, mean);
+
+        FLOAT minProjection = 0.0f;
+        FLOAT maxProjection = 0.0f;
+        for (const XMVECTOR& color : aColors)
+        {
+            FLOAT projection = XMVectorGetX(XMVector3Dot(XMVectorSubtract(color, mean), axis));
+            minProjection = projection < minProjection ? projection : minProjection;
+            maxProjection = projection > maxProjection ? projection : maxProjection;
+        }
+
+        XMVECTOR end0 = XMVectorMultiplyAdd(axis, XMVectorReplicate(maxProjection), mean);
+        XMVECTOR end1 = XMVectorMultiplyAdd(axis, XMVectorReplicate(minProjection), mean);
+        XMVECTOR inset = XMVectorScale(XMVectorSubtract(end0, end1), 1.0f / 16.0f);
+        end0 = XMVectorClamp(XMVectorSubtract(end0, inset), XMVectorZero(), XMVectorReplicate(255.0f));
+        end1 = XMVectorClamp(XMVectorAdd(end1, inset), XMVectorZero(), XMVectorReplicate(255.0f));
+
+        WORD uColor0 = packColor565(end0);
+        WORD uColor1 = packColor565(end1);
+
+        // The first color must be the larger one to select the four color mode
+        if (uColor0 < uColor1)
+        {
+            WORD uTemp = uColor0;
+            uColor0 = uColor1;
+            uColor1 = uTemp;
+        }
+
+        UINT uIndices = 0u;
+        if (uColor0 != uColor1)
+        {
+            XMVECTOR aPalette[4];
+            aPalette[0] = unpackColor565(uColor0);
+            aPalette[1] = unpackColor565(uColor1);
+            aPalette[2] = XMVectorLerp(aPalette[0], aPalette[1], 1.0f / 3.0f);
+            aPalette[3] = XMVectorLerp(aPalette[0], aPalette[1], 2.0f / 3.0f);
+
+            for (UINT i = 0u; i < 16u; ++i)
+            {
+                UINT uBestIndex = 0u;
+                FLOAT bestDistance = FLT_MAX;
+                for (UINT uIndex = 0u; uIndex < 4u; ++uIndex)
+                {
+                    FLOAT distance = XMVectorGetX(XMVector3LengthSq(XMVectorSubtract(aColors[i], aPalette[uIndex])));
+                    if (distance < bestDistance)
+                    {
+                        bestDistance = distance;
+                        uBestIndex = uIndex;
+                    }
+                }
+
+                uIndices |= uBestIndex << (2u * i);
+            }
+        }
+
+        memcpy(pOutBlock, &uColor0, sizeof(WORD));
+        memcpy(pOutBlock + 2u, &uColor1, sizeof(WORD));
+        memcpy(pOutBlock + 4u, &uIndices, sizeof(UINT));
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCooker::encodeChannelBlock
+
+      Summary:  Compresses one channel of a block to a BC4 block, the
+                alpha block of BC3 and each half of BC5. The endpoints
+                are the extremes of the channel in eight value mode
+
+      Args:     const BYTE* pTexels
+                  RGBA8 texels of the block
+                UINT uChannel
+                  Channel to compress
+                BYTE* pOutBlock
+                  BC4 block
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TextureCooker::encodeChannelBlock(_In_reads_(64) const BYTE* pTexels, _In_ UINT uChannel, _Out_writes_bytes_(8) BYTE* pOutBlock)
+    {
+        BYTE uMax = 0u;
+        BYTE uMin = 0xFFu;
+        for (UINT i = 0u; i < 16u; ++i)
+        {
+            BYTE uValue = pTexels[i * 4u + uChannel];
+            uMax = uValue > uMax ? uValue : uMax;
+            uMin = uValue < uMin ? uValue : uMin;
+        }
+
+        UINT64 uIndices = 0ull;
+        if (uMax != uMin)
+        {
+            // Index 0 and 1 are the endpoints, 2 to 7 step from the first to the second
+            FLOAT aPalette[8];
+            aPalette[0] = static_cast<FLOAT>(uMax);
+            aPalette[1] = static_cast<FLOAT>(uMin);
+            for (UINT uIndex = 2u; uIndex < 8u; ++uIndex)
+            {
+                aPalette[uIndex] = (static_cast<FLOAT>(8u - uIndex) * aPalette[0] + static_cast<FLOAT>(uIndex - 1u) * aPalette[1]) / 7.0f;
+            }
+
+            for (UINT i = 0u; i < 16u; ++i)
+            {
+                FLOAT value = static_cast<FLOAT>(pTexels[i * 4u + uChannel]);
+
+                UINT64 uBestIndex = 0ull;
+                FLOAT bestDistance = FLT_MAX;
+                for (UINT uIndex = 0u; uIndex < 8u; ++uIndex)
+                {
+                    FLOAT distance = fabsf(value - aPalette[uIndex]);
+                    if (distance < bestDistance)
+                    {
+                        bestDistance = distance;
+                        uBestIndex = uIndex;
+                    }
+                }
+
+                uIndices |= uBestIndex << (3u * i);
+            }
+        }
+
+        pOutBlock[0] = uMax;
+        pOutBlock[1] = uMin;
+        memcpy(pOutBlock + 2u, &uIndices, 6u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCooker::encodeBC7Block
+
+      Summary:  Compresses a block to BC7 mode 6, a single subset of
+                RGBA with 7 bit endpoints, a p-bit per endpoint and 4
+                bit indices. The endpoints are the extremes of the
+                texels along their principal axis, each rounded with
+                the p-bit that brings it closest
+
+      Args:     const BYTE* pTexels
+                  RGBA8 texels of the block
+                BYTE* pOutBlock
+                  BC7 block
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TextureCooker::encodeBC7Block(_In_reads_(64) const BYTE* pTexels, _Out_writes_bytes_(16) BYTE* pOutBlock)
+    {
+        static constexpr UINT s_auWeights[16] = { 0u, 4u, 9u, 13u, 17u, 21u, 26u, 30u, 34u, 38u, 43u, 47u, 51u, 55u, 60u, 64u };
+
+        XMVECTOR aColors[16];
+        XMVECTOR mean = XMVectorZero();
+        for (UINT i = 0u; i < 16u; ++i)
+        {
+            aColors[i] = XMVectorScale(loadTexel(pTexels + i * 4u), 255.0f);
+            mean = XMVectorAdd(mean, aColors[i]);
+        }
+        mean = XMVectorScale(mean, 1.0f / 16.0f);
+
+        XMVECTOR axis = findPrincipalAxis(aColors, mean);
+
+        FLOAT minProjection = 0.0f;
+        FLOAT maxProjection = 0.0f;
+        for (const XMVECTOR& color : aColors)
+        {
+            FLOAT projection = XMVectorGetX(XMVector4Dot(XMVectorSubtract(color, mean), axis));
+            minProjection = projection < minProjection ? projection : minProjection;
+            maxProjection = projection > maxProjection ? projection : maxProjection;
+        }
+
+        XMFLOAT4 aEndpoints[2];
+        XMStoreFloat4(&aEndpoints[0], XMVectorClamp(XMVectorMultiplyAdd(axis, XMVectorReplicate(minProjection), mean), XMVectorZero(), XMVectorReplicate(255.0f)));
+        XMStoreFloat4(&aEndpoints[1], XMVectorClamp(XMVectorMultiplyAdd(axis, XMVectorReplicate(maxProjection), mean), XMVectorZero(), XMVectorReplicate(255.0f)));
+
+        // Round every endpoint to 7 bits with the p-bit giving the smallest error
+        UINT aauQuantized[2][4] = {};
+        UINT auPBits[2] = {};
+        INT aaiEndpoints[2][4] = {};
+        for (UINT uEndpoint = 0u; uEndpoint < 2u; ++uEndpoint)
+        {
+            const FLOAT* pEndpoint = &aEndpoints[uEndpoint].x;
+
+            FLOAT bestError = FLT_MAX;
+            for (UINT uPBit = 0u; uPBit < 2u; ++uPBit)
+            {
+                UINT auQuantized[4];
+                FLOAT error = 0.0f;
+                for (UINT c = 0u; c < 4u; ++c)
+                {
+                    INT iQuantized = static_cast<INT>((pEndpoint[c] - static_cast<FLOAT>(uPBit)) * 0.5f + 0.5f);
+                    auQuantized[c] = static_cast<UINT>(iQuantized < 0 ? 0 : (iQuantized > 127 ? 127 : iQuantized));
+
+                    FLOAT difference = static_cast<FLOAT>((auQuantized[c] << 1u) | uPBit) - pEndpoint[c];
+                    error += difference * difference;
+                }
+
+                if (error < bestError)
+                {
+                    bestError = error;
+                    auPBits[uEndpoint] = uPBit;
+                    memcpy(aauQuantized[uEndpoint], auQuantized, sizeof(auQuantized));
+                }
+            }
+
+            for (UINT c = 0u; c < 4u; ++c)
+            {
+                aaiEndpoints[uEndpoint][c] = static_cast<INT>((aauQuantized[uEndpoint][c] << 1u) | auPBits[uEndpoint]);
+            }
+        }
+
+        INT aaiPalette[16][4];
+        for (UINT uIndex = 0u; uIndex < 16u; ++uIndex)
+        {
+            for (UINT c = 0u; c < 4u; ++c)
+            {
+                aaiPalette[uIndex][c] = ((64 - static_cast<INT>(s_auWeights[uIndex])) * aaiEndpoints[0][c] + static_cast<INT>(s_auWeights[uIndex]) * aaiEndpoints[1][c] + 32) >> 6;
+            }
+        }
+
+        UINT auIndices[16];
+        for (UINT i = 0u; i < 16u; ++i)
+        {
+            const BYTE* pTexel = pTexels + i * 4u;
+
+            INT iBestDistance = INT_MAX;
+            for (UINT uIndex = 0u; uIndex < 16u; ++uIndex)
+            {
+                INT iDistance = 0;
+                for (UINT c = 0u; c < 4u; ++c)
+                {
+                    INT iDifference = static_cast<INT>(pTexel[c]) - aaiPalette[uIndex][c];
+                    iDistance += iDifference * iDifference;
+                }
+
+                if (iDistance < iBestDistance)
+                {
+                    iBestDistance = iDistance;
+                    auIndices[i] = uIndex;
+                }
+            }
+        }
+
+        // The top bit of the first index is implied zero, swap the endpoints if it is set
+        if (auIndices[0] & 8u)
+        {
+            for (UINT c = 0u; c < 4u; ++c)
+            {
+                UINT uTemp = aauQuantized[0][c];
+                aauQuantized[0][c] = aauQuantized[1][c];
+                aauQuantized[1][c] = uTemp;
+            }
+
+            UINT uTemp = auPBits[0];
+            auPBits[0] = auPBits[1];
+            auPBits[1] = uTemp;
+
+            for (UINT& uIndex : auIndices)
+            {
+                uIndex = 15u - uIndex;
+            }
+        }
+
+        UINT64 auBits[2] = {};
+        UINT uOffset = 0u;
+        writeBits(auBits, uOffset, 1u << 6u, 7u);
+        for (UINT c = 0u; c < 4u; ++c)
+        {
+            writeBits(auBits, uOffset, aauQuantized[0][c], 7u);
+            writeBits(auBits, uOffset, aauQuantized[1][c], 7u);
+        }
+        writeBits(auBits, uOffset, auPBits[0], 1u);
+        writeBits(auBits, uOffset, auPBits[1], 1u);
+        writeBits(auBits, uOffset, auIndices[0], 3u);
+        for (UINT i = 1u; i < 16u; ++i)
+        {
+            writeBits(auBits, uOffset, auIndices[i], 4u);
+        }
+
+        memcpy(pOutBlock, auBits, sizeof(auBits));
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCooker::findPrincipalAxis
+
+      Summary:  Returns the direction along which the colors of a block
+                vary the most, by power iteration on their covariance.
+                Starts from the channel with the largest variance, so
+                the iteration does not begin orthogonal to the axis
+
+      Args:     const XMVECTOR* pColors
+                  16 colors of the block
+                FXMVECTOR mean
+                  Mean of the colors
+
+      Returns:  XMVECTOR
+                  Unit axis, zero if every color is the same
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    XMVECTOR TextureCooker::findPrincipalAxis(_In_reads_(16) const XMVECTOR* pColors, _In_ FXMVECTOR mean)
+    {
+        XMVECTOR aCovariance[4] = { XMVectorZero(), XMVectorZero(), XMVectorZero(), XMVectorZero() };
+        for (UINT i = 0u; i < 16u; ++i)
+        {
+            XMVECTOR difference = XMVectorSubtract(pColors[i], mean);
+            aCovariance[0] = XMVectorMultiplyAdd(difference, XMVectorSplatX(difference), aCovariance[0]);
+            aCovariance[1] = XMVectorMultiplyAdd(difference, XMVectorSplatY(difference), aCovariance[1]);
+            aCovariance[2] = XMVectorMultiplyAdd(difference, XMVectorSplatZ(difference), aCovariance[2]);
+            aCovariance[3] = XMVectorMultiplyAdd(difference, XMVectorSplatW(difference), aCovariance[3]);
+        }
+
+        XMFLOAT4 variances(
+            XMVectorGetX(aCovariance[0]),
+            XMVectorGetY(aCovariance[1]),
+            XMVectorGetZ(aCovariance[2]),
+            XMVectorGetW(aCovariance[3])
+        );
+        UINT uLargest = 0u;
+        FLOAT largestVariance = variances.x;
+        const FLOAT* pVariances = &variances.x;
+        for (UINT c = 1u; c < 4u; ++c)
+        {
+            if (pVariances[c] > largestVariance)
+            {
+                largestVariance = pVariances[c];
+                uLargest = c;
+            }
+        }
+
+        if (largestVariance < 1e-4f)
+        {
+            return XMVectorZero();
+        }
+
+        XMVECTOR axis = XMVector4Normalize(aCovariance[uLargest]);
+        for (UINT uIteration = 0u; uIteration < 8u; ++uIteration)
+        {
+            XMVECTOR product = XMVectorMultiply(aCovariance[0], XMVectorSplatX(axis));
+            product = XMVectorMultiplyAdd(aCovariance[1], XMVectorSplatY(axis), product);
+            product = XMVectorMultiplyAdd(aCovariance[2], XMVectorSplatZ(axis), product);
+            product = XMVectorMultiplyAdd(aCovariance[3], XMVectorSplatW(axis), product);
+
+            axis = XMVector4Normalize(product);
+        }
+
+        return axis;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCooker::writeBits
+
+      Summary:  Writes the low bits of a value to a 128 bit block,
+                least significant bit first
+
+      Args:     UINT64* pBits
+                  Two words of the block
+                UINT& uOffset
+                  Bit position to write at, advanced past the value
+                UINT uValue
+                  Value to write
+                UINT uNumBits
+                  Number of bits to write
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TextureCooker::writeBits(_Inout_updates_(2) UINT64* pBits, _Inout_ UINT& uOffset, _In_ UINT uValue, _In_ UINT uNumBits)
+    {
+        for (UINT i = 0u; i < uNumBits; ++i, ++uOffset)
+        {
+            if ((uValue >> i) & 1u)
+            {
+                pBits[uOffset / 64u] |= 1ull << (uOffset % 64u);
+            }
+        }
+    }
+}
\ No newline at end of file
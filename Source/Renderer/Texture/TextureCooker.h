@@ -0,0 +1,186 @@
+/*+===================================================================
+  File:      TEXTURECOOKER.H
+
+  Summary:   TextureCooker header file contains declaration of class
+             TextureCooker that generates the mip chain of a decoded
+             image on the CPU, compresses it to a BC format and stores
+             it as a DDS file in a cache, so that textures are
+             compressed once and uploaded with their mips.
+
+  Classes: TextureCooker
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include <mutex>
+
+namespace library
+{
+    enum class eTextureFormat : size_t
+    {
+        BC1 = 0,
+        BC3,
+        BC5,
+        BC7,
+        COUNT,
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   TextureCookStats
+
+      Summary:  Totals of the cooked textures. The uncompressed size is
+                what the textures with all their mips take as RGBA8,
+                the cooked size what their blocks take
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct TextureCookStats
+    {
+        UINT uNumTextures;
+        UINT64 uNumTexels;
+        UINT64 uUncompressedSize;
+        UINT64 uCookedSize;
+        DOUBLE MipSeconds;
+        DOUBLE EncodeSeconds;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    TextureCooker
+
+      Summary:  Cooks decoded RGBA8 images into DDS files. Mips are box
+                filtered four texels at a time, in linear space for
+                colors and as unit vectors for normal maps. Normal maps
+                keep only x and y in BC5, colors use BC1 when opaque
+                and BC3 otherwise, or BC7 when high quality is set.
+                BC7 blocks use the single subset RGBA mode only. Cached
+                files are keyed like the model cache by a hash of the
+                source file, its path and the settings, the key is kept
+                in the reserved words of the DDS header. Safe to use
+                from the loader threads
+
+      Methods:  ComputeKey
+                  Hashes the source file and cook settings
+                Cook
+                  Generates the mips and writes the compressed DDS
+                Load
+                  Reads the cached DDS of the given key
+                Save
+                  Writes the DDS to the cache file of the given key
+                GetCacheFilePath
+                  Returns the path to the cache file of the given key
+                ChooseFormat
+                  Returns the BC format an image is cooked to
+                GenerateMips
+                  Builds the mip chain of an image
+                EncodeBlocks
+                  Compresses one mip level
+                GetDxgiFormat
+                  Returns the DXGI format of a BC format
+                GetBlockSize
+                  Returns the bytes of a block of a BC format
+                SetEnabled
+                  Enables or disables cooking
+                IsEnabled
+                  Returns whether textures are cooked
+                SetHighQuality
+                  Sets whether color textures use BC7
+                SetCacheDirectory
+                  Sets the directory that holds the cooked files
+                GetStats
+                  Returns the totals of the cooked textures
+                ResetStats
+                  Clears the totals
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class TextureCooker
+    {
+    public:
+        static constexpr UINT VERSION = 1u;
+        static constexpr UINT BLOCK_DIMENSION = 4u;
+
+        TextureCooker() = delete;
+        TextureCooker(const TextureCooker& other) = delete;
+        TextureCooker(TextureCooker&& other) = delete;
+        TextureCooker& operator=(const TextureCooker& other) = delete;
+        TextureCooker& operator=(TextureCooker&& other) = delete;
+        ~TextureCooker() = delete;
+
+        static HRESULT ComputeKey(_In_ const std::filesystem::path& sourcePath, _Out_ UINT64& uOutKey);
+        static HRESULT Cook(
+            _In_ const std::filesystem::path& sourcePath,
+            _In_ UINT64 uKey,
+            _In_ UINT uWidth,
+            _In_ UINT uHeight,
+            _In_ const std::vector<BYTE>& aPixels,
+            _Out_ std::vector<BYTE>& outFile
+        );
+        static HRESULT Load(_In_ const std::filesystem::path& sourcePath, _In_ UINT64 uKey, _Out_ std::vector<BYTE>& outFile);
+        static HRESULT Save(_In_ const std::filesystem::path& sourcePath, _In_ UINT64 uKey, _In_ const std::vector<BYTE>& file);
+        static std::filesystem::path GetCacheFilePath(_In_ const std::filesystem::path& sourcePath, _In_ UINT64 uKey);
+
+        static eTextureFormat ChooseFormat(_In_ const std::filesystem::path& sourcePath, _In_ const std::vector<BYTE>& aPixels);
+        static void GenerateMips(
+            _In_ UINT uWidth,
+            _In_ UINT uHeight,
+            _In_ const std::vector<BYTE>& aPixels,
+            _In_ BOOL bNormalMap,
+            _Out_ std::vector<std::vector<BYTE>>& aOutMips
+        );
+        static void EncodeBlocks(
+            _In_ eTextureFormat format,
+            _In_ UINT uWidth,
+            _In_ UINT uHeight,
+            _In_reads_bytes_(uWidth * uHeight * 4u) const BYTE* pPixels,
+            _Inout_ std::vector<BYTE>& aBlocks
+        );
+        static DXGI_FORMAT GetDxgiFormat(_In_ eTextureFormat format);
+        static UINT GetBlockSize(_In_ eTextureFormat format);
+
+        static void SetEnabled(_In_ BOOL bEnabled);
+        static BOOL IsEnabled();
+        static void SetHighQuality(_In_ BOOL bHighQuality);
+        static void SetCacheDirectory(_In_ const std::filesystem::path& cacheDirectory);
+        static TextureCookStats GetStats();
+        static void ResetStats();
+
+    private:
+        static constexpr UINT DDS_MAGIC = 0x20534444u;  // "DDS "
+        static constexpr UINT DDS_FOURCC_DX10 = 0x30315844u;  // "DX10"
+        static constexpr UINT DDS_HEADER_SIZE = 148u;
+
+        static BOOL isNormalMap(_In_ const std::filesystem::path& sourcePath);
+        static void writeHeader(
+            _In_ eTextureFormat format,
+            _In_ UINT uWidth,
+            _In_ UINT uHeight,
+            _In_ UINT uNumMips,
+            _In_ UINT64 uKey,
+            _Inout_ std::vector<BYTE>& aFile
+        );
+        static void fetchBlock(
+            _In_ UINT uWidth,
+            _In_ UINT uHeight,
+            _In_ const BYTE* pPixels,
+            _In_ UINT uBlockX,
+            _In_ UINT uBlockY,
+            _Out_writes_(64) BYTE* pOutTexels
+        );
+        static XMVECTOR loadTexel(_In_reads_(4) const BYTE* pTexel);
+        static XMVECTOR loadLinearTexel(_In_reads_(4) const BYTE* pTexel);
+        static void storeTexel(_In_ FXMVECTOR texel, _Out_writes_(4) BYTE* pOutTexel);
+        static WORD packColor565(_In_ FXMVECTOR color);
+        static XMVECTOR unpackColor565(_In_ WORD uColor);
+        static void encodeColorBlock(_In_reads_(64) const BYTE* pTexels, _Out_writes_bytes_(8) BYTE* pOutBlock);
+        static void encodeChannelBlock(_In_reads_(64) const BYTE* pTexels, _In_ UINT uChannel, _Out_writes_bytes_(8) BYTE* pOutBlock);
+        static void encodeBC7Block(_In_reads_(64) const BYTE* pTexels, _Out_writes_bytes_(16) BYTE* pOutBlock);
+        static XMVECTOR findPrincipalAxis(_In_reads_(16) const XMVECTOR* pColors, _In_ FXMVECTOR mean);
+        static void writeBits(_Inout_updates_(2) UINT64* pBits, _Inout_ UINT& uOffset, _In_ UINT uValue, _In_ UINT uNumBits);
+
+    private:
+        static std::filesystem::path sm_cacheDirectory;
+        static BOOL sm_bEnabled;
+        static BOOL sm_bHighQuality;
+        static TextureCookStats sm_stats;
+        static std::mutex sm_mutex;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,155 @@
+#include "Texture/TextureResidency.h"
+
+#include <cmath>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureResidency::ComputeDesiredMip
+
+      Summary:  Returns the most detailed level worth keeping for a
+                texture covering the given number of pixels along its
+                larger side, one texel per pixel or more
+
+      Args:     UINT uWidth
+                  Width of the top level
+                UINT uHeight
+                  Height of the top level
+                UINT uNumMips
+                  Number of levels
+                FLOAT screenSize
+                  Pixels the texture covers, 0 if it is not visible
+
+      Returns:  UINT
+                  Desired mip, the last level if nothing is visible
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT TextureResidency::ComputeDesiredMip(_In_ UINT uWidth, _In_ UINT uHeight, _In_ UINT uNumMips, _In_ FLOAT screenSize)
+    {
+        if (uNumMips == 0u)
+        {
+            return 0u;
+        }
+
+        if (screenSize <= 0.0f)
+        {
+            return uNumMips - 1u;
+        }
+
+        FLOAT ratio = static_cast<FLOAT>(uWidth > uHeight ? uWidth : uHeight) / screenSize;
+        if (ratio <= 1.0f)
+        {
+            return 0u;
+        }
+
+        UINT uMip = static_cast<UINT>(floorf(log2f(ratio)));
+        return uMip < uNumMips ? uMip : uNumMips - 1u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureResidency::GetResidentSize
+
+      Summary:  Returns the bytes a texture takes with the levels from
+                the given mip to the last in memory
+
+      Args:     const TextureResidencyEntry& entry
+                  Streamed texture
+                UINT uFirstMip
+                  Most detailed resident level
+
+      Returns:  UINT64
+                  Size in bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 TextureResidency::GetResidentSize(_In_ const TextureResidencyEntry& entry, _In_ UINT uFirstMip)
+    {
+        UINT64 uSize = 0ull;
+        for (UINT uMip = uFirstMip; uMip < entry.uNumMips; ++uMip)
+        {
+            uSize += entry.auMipSizes[uMip];
+        }
+
+        return uSize;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureResidency::Resolve
+
+      Summary:  Decides the most detailed level every texture should
+                keep. A texture wants its desired level and keeps any
+                finer resident level as long as the budget allows.
+                While over the budget, the finer levels that are not
+                desired are dropped first and the desired ones after,
+                never going past the tail. Textures with only their
+                tail can exceed the budget
+
+      Args:     const std::vector<TextureResidencyEntry>& aEntries
+                  Streamed textures
+                UINT64 uBudget
+                  Bytes the textures may take
+                UINT64 uFrame
+                  Current frame, to age the textures
+                std::vector<UINT>& aOutTargetMips
+                  Most detailed level to keep for every texture
+
+      Returns:  UINT64
+                  Bytes the textures take at their target levels
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 TextureResidency::Resolve(
+        _In_ const std::vector<TextureResidencyEntry>& aEntries,
+        _In_ UINT64 uBudget,
+        _In_ UINT64 uFrame,
+        _Out_ std::vector<UINT>& aOutTargetMips
+    )
+    {
+        aOutTargetMips.resize(aEntries.size());
+
+        UINT64 uTotalSize = 0ull;
+        for (size_t i = 0u; i < aEntries.size(); ++i)
+        {
+            const TextureResidencyEntry& entry = aEntries[i];
+
+            UINT uWantedMip = entry.uDesiredMip < entry.uTailMip ? entry.uDesiredMip : entry.uTailMip;
+            aOutTargetMips[i] = entry.uResidentMip < uWantedMip ? entry.uResidentMip : uWantedMip;
+            uTotalSize += GetResidentSize(entry, aOutTargetMips[i]);
+        }
+
+        // The first pass only drops levels finer than desired, the second also the desired ones
+        for (UINT uPass = 0u; uPass < 2u && uTotalSize > uBudget; ++uPass)
+        {
+            while (uTotalSize > uBudget)
+            {
+                size_t uVictim = aEntries.size();
+                UINT64 uVictimAge = 0ull;
+                UINT64 uVictimSize = 0ull;
+                for (size_t i = 0u; i < aEntries.size(); ++i)
+                {
+                    const TextureResidencyEntry& entry = aEntries[i];
+
+                    UINT uLimitMip = uPass == 0u && entry.uDesiredMip < entry.uTailMip ? entry.uDesiredMip : entry.uTailMip;
+                    if (aOutTargetMips[i] >= uLimitMip)
+                    {
+                        continue;
+                    }
+
+                    UINT64 uAge = uFrame > entry.uLastUsedFrame ? uFrame - entry.uLastUsedFrame : 0ull;
+                    UINT64 uSize = entry.auMipSizes[aOutTargetMips[i]];
+                    if (uVictim == aEntries.size() || uAge > uVictimAge || (uAge == uVictimAge && uSize > uVictimSize))
+                    {
+                        uVictim = i;
+                        uVictimAge = uAge;
+                        uVictimSize = uSize;
+                    }
+                }
+
+                if (uVictim == aEntries.size())
+                {
+                    break;
+                }
+
+                uTotalSize -= uVictimSize;
+                ++aOutTargetMips[uVictim];
+            }
+        }
+
+        return uTotalSize;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+/*+===================================================================
+  File:      TEXTURERESIDENCY.H
+
+  Summary:   TextureResidency header file contains declaration of
+             class TextureResidency, the policy that decides which mip
+             levels of the streamed textures stay in video memory.
+
+  Classes:  TextureResidency
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   TextureResidencyEntry
+
+      Summary:  State of one streamed texture. Levels from the tail mip
+                to the last are always resident. The resident mip is
+                the most detailed level in memory, the desired mip the
+                one the screen size of the texture asks for
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct TextureResidencyEntry
+    {
+        UINT uNumMips;
+        UINT uTailMip;
+        UINT uResidentMip;
+        UINT uDesiredMip;
+        UINT64 uLastUsedFrame;
+        UINT64 auMipSizes[D3D11_REQ_MIP_LEVELS];
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    TextureResidency
+
+      Summary:  Residency policy of the texture streamer, free of any
+                device so it can run and be checked on the CPU alone.
+                Every texture aims for the level its screen size asks
+                for and keeps the finer levels it already has. Over
+                the budget, levels are dropped one at a time from the
+                texture unused the longest, the largest level first
+                among textures used as recently: first the levels finer
+                than desired, then the desired ones down to the tail
+
+      Methods:  ComputeDesiredMip
+                  Returns the level a screen size asks for
+                GetResidentSize
+                  Returns the bytes of the levels from a mip on
+                Resolve
+                  Returns the level every texture should keep
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class TextureResidency final
+    {
+    public:
+        TextureResidency() = delete;
+        TextureResidency(const TextureResidency& other) = delete;
+        TextureResidency(TextureResidency&& other) = delete;
+        TextureResidency& operator=(const TextureResidency& other) = delete;
+        TextureResidency& operator=(TextureResidency&& other) = delete;
+        ~TextureResidency() = delete;
+
+        static UINT ComputeDesiredMip(_In_ UINT uWidth, _In_ UINT uHeight, _In_ UINT uNumMips, _In_ FLOAT screenSize);
+        static UINT64 GetResidentSize(_In_ const TextureResidencyEntry& entry, _In_ UINT uFirstMip);
+        static UINT64 Resolve(
+            _In_ const std::vector<TextureResidencyEntry>& aEntries,
+            _In_ UINT64 uBudget,
+            _In_ UINT64 uFrame,
+            _Out_ std::vector<UINT>& aOutTargetMips
+        );
+    };
+}
\ No newline at end of file
@@ -0,0 +1,403 @@
+#include "Texture/TextureStreamer.h"
+
+#include <chrono>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureStreamer::TextureStreamer
+
+      Summary:  Constructor, streams within the default budget
+
+      Modifies: [m_aTextures, m_aLockedTextures, m_textureIndices,
+                 m_aPendingLoads, m_aEntries, m_aTargetMips, m_uBudget,
+                 m_uFrame, m_uResidentSize, m_uNumStreamedMips,
+                 m_uNumEvictedMips, m_loader].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    TextureStreamer::TextureStreamer()
+        : TextureStreamer(DEFAULT_BUDGET)
+    {
+        // empty
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureStreamer::TextureStreamer
+
+      Summary:  Constructor, starts the loader thread
+
+      Args:     UINT64 uBudget
+                  Bytes the streamed textures may take
+
+      Modifies: [m_aTextures, m_aLockedTextures, m_textureIndices,
+                 m_aPendingLoads, m_aEntries, m_aTargetMips, m_uBudget,
+                 m_uFrame, m_uResidentSize, m_uNumStreamedMips,
+                 m_uNumEvictedMips, m_loader].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    TextureStreamer::TextureStreamer(_In_ UINT64 uBudget)
+        : m_aTextures()
+        , m_aLockedTextures()
+        , m_textureIndices()
+        , m_aPendingLoads()
+        , m_aEntries()
+        , m_aTargetMips()
+        , m_uBudget(uBudget)
+        , m_uFrame(0u)
+        , m_uResidentSize(0u)
+        , m_uNumStreamedMips(0u)
+        , m_uNumEvictedMips(0u)
+        , m_loader(1u)
+    {
+        // empty
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureStreamer::BeginFrame
+
+      Summary:  Starts a new frame, textures not requested in it are
+                no longer wanted above their tail and age
+
+      Modifies: [m_uFrame].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TextureStreamer::BeginFrame()
+    {
+        ++m_uFrame;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureStreamer::RequestTexture
+
+      Summary:  Marks a texture as used this frame. A texture used by
+                several objects keeps the largest screen size. Textures
+                that are not streamable are ignored. The streamer only
+                watches the texture, the caller keeps it alive
+
+      Args:     const std::shared_ptr<Texture>& texture
+                  Texture to request, may be null
+                FLOAT screenSize
+                  Pixels the texture covers along its larger side
+
+      Modifies: [m_aTextures, m_textureIndices].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TextureStreamer::RequestTexture(_In_ const std::shared_ptr<Texture>& texture, _In_ FLOAT screenSize)
+    {
+        if (!texture || !texture->IsStreamable())
+        {
+            return;
+        }
+
+        auto it = m_textureIndices.find(texture.get());
+        if (it == m_textureIndices.end())
+        {
+            m_textureIndices.emplace(texture.get(), m_aTextures.size());
+            m_aTextures.push_back(
+                StreamedTexture
+                {
+                    .texture = texture,
+                    .ScreenSize = screenSize,
+                    .uLastUsedFrame = m_uFrame,
+                    .bLoading = FALSE
+                }
+            );
+            return;
+        }
+
+        // A released texture may have left its address to this one before the next update dropped it
+        StreamedTexture& streamedTexture = m_aTextures[it->second];
+        if (streamedTexture.texture.expired())
+        {
+            streamedTexture =
+            {
+                .texture = texture,
+                .ScreenSize = screenSize,
+                .uLastUsedFrame = m_uFrame,
+                .bLoading = FALSE
+            };
+            return;
+        }
+
+        if (streamedTexture.uLastUsedFrame != m_uFrame || screenSize > streamedTexture.ScreenSize)
+        {
+            streamedTexture.ScreenSize = screenSize;
+        }
+        streamedTexture.uLastUsedFrame = m_uFrame;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureStreamer::Update
+
+      Summary:  Applies the levels read since the last frame, forgets
+                the textures released since, resolves the level every
+                texture keeps within the budget, drops the levels past
+                it and queues the next finer level of the textures
+                below their target. Textures with a load in flight are
+                left alone until it is applied
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the textures
+                ID3D11DeviceContext* pImmediateContext
+                  The Direct3D context to upload and copy the levels
+
+      Modifies: [m_aTextures, m_aLockedTextures, m_textureIndices,
+                 m_aPendingLoads, m_aEntries, m_aTargetMips,
+                 m_uResidentSize, m_uNumStreamedMips,
+                 m_uNumEvictedMips, m_loader].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TextureStreamer::Update(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext)
+    {
+        PROFILE_SCOPE("TextureStreamer::Update");
+
+        completeLoads(pDevice, pImmediateContext);
+        lockTextures();
+
+        m_aEntries.resize(m_aTextures.size());
+        for (size_t i = 0u; i < m_aTextures.size(); ++i)
+        {
+            fillEntry(m_aTextures[i], *m_aLockedTextures[i], m_aEntries[i]);
+        }
+
+        TextureResidency::Resolve(m_aEntries, m_uBudget, m_uFrame, m_aTargetMips);
+
+        m_uResidentSize = 0u;
+        for (size_t i = 0u; i < m_aTextures.size(); ++i)
+        {
+            StreamedTexture& streamedTexture = m_aTextures[i];
+            const std::shared_ptr<Texture>& texture = m_aLockedTextures[i];
+            UINT uResidentMip = texture->GetResidentMip();
+            UINT uTargetMip = m_aTargetMips[i];
+
+            if (!streamedTexture.bLoading && uTargetMip > uResidentMip)
+            {
+                if (SUCCEEDED(texture->SetResidentMip(pDevice, pImmediateContext, uTargetMip, std::vector<BYTE>())))
+                {
+                    m_uNumEvictedMips += uTargetMip - uResidentMip;
+                    uResidentMip = uTargetMip;
+                }
+            }
+            else if (!streamedTexture.bLoading && uTargetMip < uResidentMip && m_aPendingLoads.size() < MAX_PENDING_LOADS)
+            {
+                // One level at a time, so a texture sharpens gradually and a far away one is never read in full
+                std::shared_ptr<std::vector<BYTE>> data = std::make_shared<std::vector<BYTE>>();
+                UINT uMip = uResidentMip - 1u;
+
+                m_aPendingLoads.push_back(
+                    PendingMipLoad
+                    {
+                        .texture = texture,
+                        .uMip = uMip,
+                        .data = data,
+                        .result = m_loader.Submit([texture, data, uMip]() { return texture->ReadMips(uMip, uMip + 1u, *data); })
+                    }
+                );
+                streamedTexture.bLoading = TRUE;
+            }
+
+            m_uResidentSize += TextureResidency::GetResidentSize(m_aEntries[i], uResidentMip);
+        }
+
+        m_aLockedTextures.clear();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureStreamer::SetBudget
+
+      Summary:  Sets the bytes the streamed textures may take, levels
+                over it are dropped on the next update. The tails are
+                always resident and may exceed it
+
+      Args:     UINT64 uBudget
+                  Budget in bytes
+
+      Modifies: [m_uBudget].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TextureStreamer::SetBudget(_In_ UINT64 uBudget)
+    {
+        m_uBudget = uBudget;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureStreamer::GetBudget
+
+      Summary:  Returns the bytes the streamed textures may take
+
+      Returns:  UINT64
+                  Budget in bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 TextureStreamer::GetBudget() const
+    {
+        return m_uBudget;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureStreamer::GetResidentSize
+
+      Summary:  Returns the bytes of the resident levels of the
+                requested textures after the last update
+
+      Returns:  UINT64
+                  Size in bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 TextureStreamer::GetResidentSize() const
+    {
+        return m_uResidentSize;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureStreamer::GetNumPendingLoads
+
+      Summary:  Returns the number of levels being read
+
+      Returns:  UINT
+                  Number of loads in flight
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT TextureStreamer::GetNumPendingLoads() const
+    {
+        return static_cast<UINT>(m_aPendingLoads.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureStreamer::GetNumStreamedMips
+
+      Summary:  Returns the number of levels made resident so far
+
+      Returns:  UINT
+                  Number of streamed levels
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT TextureStreamer::GetNumStreamedMips() const
+    {
+        return m_uNumStreamedMips;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureStreamer::GetNumEvictedMips
+
+      Summary:  Returns the number of levels dropped so far
+
+      Returns:  UINT
+                  Number of evicted levels
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT TextureStreamer::GetNumEvictedMips() const
+    {
+        return m_uNumEvictedMips;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureStreamer::completeLoads
+
+      Summary:  Makes the levels read by the finished loads resident,
+                without waiting for the ones still running. A failed
+                read leaves the texture as it was and is retried on a
+                later update
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the textures
+                ID3D11DeviceContext* pImmediateContext
+                  The Direct3D context to upload and copy the levels
+
+      Modifies: [m_aTextures, m_aPendingLoads, m_uNumStreamedMips].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TextureStreamer::completeLoads(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext)
+    {
+        for (auto it = m_aPendingLoads.begin(); it != m_aPendingLoads.end();)
+        {
+            if (it->result.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            {
+                ++it;
+                continue;
+            }
+
+            // The load keeps its texture alive, so the texture is still known to the streamer
+            StreamedTexture& streamedTexture = m_aTextures[m_textureIndices.at(it->texture.get())];
+
+            HRESULT hr = it->result.get();
+            if (SUCCEEDED(hr))
+            {
+                hr = it->texture->SetResidentMip(pDevice, pImmediateContext, it->uMip, *it->data);
+            }
+
+            if (SUCCEEDED(hr))
+            {
+                ++m_uNumStreamedMips;
+            }
+            else
+            {
+                OutputDebugString(L"Can't stream a mip of \"");
+                OutputDebugString(it->texture->GetFilePath().c_str());
+                OutputDebugString(L"\"\n");
+            }
+
+            streamedTexture.bLoading = FALSE;
+            it = m_aPendingLoads.erase(it);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureStreamer::lockTextures
+
+      Summary:  Forgets the textures nobody holds anymore and holds the
+                others until the end of the update, so the texture
+                cache can evict a texture as soon as its last object
+                is gone
+
+      Modifies: [m_aTextures, m_aLockedTextures, m_textureIndices].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TextureStreamer::lockTextures()
+    {
+        m_aLockedTextures.clear();
+        m_textureIndices.clear();
+
+        size_t uNumTextures = 0u;
+        for (StreamedTexture& streamedTexture : m_aTextures)
+        {
+            std::shared_ptr<Texture> texture = streamedTexture.texture.lock();
+            if (!texture)
+            {
+                continue;
+            }
+
+            m_textureIndices.emplace(texture.get(), uNumTextures);
+            m_aLockedTextures.push_back(std::move(texture));
+            if (&streamedTexture != &m_aTextures[uNumTextures])
+            {
+                m_aTextures[uNumTextures] = std::move(streamedTexture);
+            }
+            ++uNumTextures;
+        }
+
+        m_aTextures.resize(uNumTextures);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureStreamer::fillEntry
+
+      Summary:  Describes a texture to the residency policy. A texture
+                not requested this frame only wants its tail
+
+      Args:     const StreamedTexture& streamedTexture
+                  Streaming state of the texture
+                const Texture& texture
+                  Texture to describe
+                TextureResidencyEntry& outEntry
+                  Residency state of the texture
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TextureStreamer::fillEntry(
+        _In_ const StreamedTexture& streamedTexture,
+        _In_ const Texture& texture,
+        _Out_ TextureResidencyEntry& outEntry
+    ) const
+    {
+        outEntry.uNumMips = texture.GetNumMips();
+        outEntry.uTailMip = texture.GetTailMip();
+        outEntry.uResidentMip = texture.GetResidentMip();
+        outEntry.uDesiredMip = TextureResidency::ComputeDesiredMip(
+            texture.GetWidth(),
+            texture.GetHeight(),
+            outEntry.uNumMips,
+            streamedTexture.uLastUsedFrame == m_uFrame ? streamedTexture.ScreenSize : 0.0f
+        );
+        outEntry.uLastUsedFrame = streamedTexture.uLastUsedFrame;
+        for (UINT uMip = 0u; uMip < D3D11_REQ_MIP_LEVELS; ++uMip)
+        {
+            outEntry.auMipSizes[uMip] = texture.GetMipSize(uMip);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,138 @@
+/*+===================================================================
+  File:      TEXTURESTREAMER.H
+
+  Summary:   TextureStreamer header file contains declaration of class
+             TextureStreamer that reads the mip levels of the visible
+             textures from their files on a loader thread and keeps
+             the resident levels within a memory budget.
+
+  Classes:  TextureStreamer
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Profiler/Profiler.h"
+#include "Renderer/AssetLoader.h"
+#include "Texture/Texture.h"
+#include "Texture/TextureResidency.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   StreamedTexture
+
+      Summary:  Texture known to the streamer. ScreenSize is the largest
+                size in pixels it was requested with in its last used
+                frame. A texture loads at most one level at a time. The
+                streamer does not own the texture, so the texture cache
+                can evict it once no object uses it
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct StreamedTexture
+    {
+        std::weak_ptr<Texture> texture;
+        FLOAT ScreenSize;
+        UINT64 uLastUsedFrame;
+        BOOL bLoading;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   PendingMipLoad
+
+      Summary:  Level being read on the loader thread, the data is
+                shared with the task so either side can finish first.
+                The texture is kept alive until the level is applied
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct PendingMipLoad
+    {
+        std::shared_ptr<Texture> texture;
+        UINT uMip;
+        std::shared_ptr<std::vector<BYTE>> data;
+        std::future<HRESULT> result;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    TextureStreamer
+
+      Summary:  Streams the levels above the tail of the streamable
+                textures. Every frame the renderer requests the
+                textures of the visible objects with their size on
+                screen, and Update applies the finished loads, lets
+                TextureResidency pick the level every texture keeps,
+                drops the levels over the budget right away and queues
+                the next finer level of the textures that want more.
+                Levels only reach the device on the thread calling
+                Update
+
+      Methods:  BeginFrame
+                  Starts collecting the requests of a frame
+                RequestTexture
+                  Marks a texture as used at the given screen size
+                Update
+                  Applies loads and evictions and queues new loads
+                SetBudget
+                  Sets the bytes the streamed textures may take
+                GetBudget
+                  Returns the budget
+                GetResidentSize
+                  Returns the bytes of the resident levels
+                GetNumPendingLoads
+                  Returns the number of levels being read
+                GetNumStreamedMips
+                  Returns the number of levels loaded so far
+                GetNumEvictedMips
+                  Returns the number of levels dropped so far
+                TextureStreamer
+                  Constructor.
+                ~TextureStreamer
+                  Destructor, waits for the loads in flight.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class TextureStreamer final
+    {
+    public:
+        static constexpr UINT64 DEFAULT_BUDGET = 64ull * 1024ull * 1024ull;
+        static constexpr UINT MAX_PENDING_LOADS = 4u;
+
+        TextureStreamer();
+        TextureStreamer(_In_ UINT64 uBudget);
+        TextureStreamer(const TextureStreamer& other) = delete;
+        TextureStreamer(TextureStreamer&& other) = delete;
+        TextureStreamer& operator=(const TextureStreamer& other) = delete;
+        TextureStreamer& operator=(TextureStreamer&& other) = delete;
+        ~TextureStreamer() = default;
+
+        void BeginFrame();
+        void RequestTexture(_In_ const std::shared_ptr<Texture>& texture, _In_ FLOAT screenSize);
+        void Update(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext);
+
+        void SetBudget(_In_ UINT64 uBudget);
+        UINT64 GetBudget() const;
+        UINT64 GetResidentSize() const;
+        UINT GetNumPendingLoads() const;
+        UINT GetNumStreamedMips() const;
+        UINT GetNumEvictedMips() const;
+
+    private:
+        void completeLoads(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext);
+        void lockTextures();
+        void fillEntry(_In_ const StreamedTexture& streamedTexture, _In_ const Texture& texture, _Out_ TextureResidencyEntry& outEntry) const;
+
+    private:
+        std::vector<StreamedTexture> m_aTextures;
+        std::vector<std::shared_ptr<Texture>> m_aLockedTextures;
+        std::unordered_map<Texture*, size_t> m_textureIndices;
+        std::vector<PendingMipLoad> m_aPendingLoads;
+        std::vector<TextureResidencyEntry> m_aEntries;
+        std::vector<UINT> m_aTargetMips;
+        UINT64 m_uBudget;
+        UINT64 m_uFrame;
+        UINT64 m_uResidentSize;
+        UINT m_uNumStreamedMips;
+        UINT m_uNumEvictedMips;
+
+        // A single thread, so the levels are read from the disk one after another
+        AssetLoader m_loader;
+    };
+}
\ No newline at end of file
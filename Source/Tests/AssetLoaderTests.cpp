@@ -0,0 +1,155 @@
+#include "Test.h"
+
+#include "Renderer/AssetLoader.h"
+
+#include <atomic>
+
+using namespace library;
+
+// Enough tasks to keep every worker busy and queue the rest
+constexpr UINT NUM_TASKS = 1000u;
+
+TEST_CASE(RunsEveryTaskExactlyOnce)
+{
+    std::vector<std::atomic<UINT>> aNumRuns(NUM_TASKS);
+
+    AssetLoader loader(4u);
+    CHECK_EQUAL(4u, loader.GetNumThreads());
+
+    std::vector<std::future<HRESULT>> aFutures;
+    for (UINT i = 0u; i < NUM_TASKS; ++i)
+    {
+        aFutures.push_back(loader.Submit(
+            [&aNumRuns, i]()
+            {
+                aNumRuns[i].fetch_add(1u);
+                return S_OK;
+            }
+        ));
+    }
+
+    CHECK_EQUAL(S_OK, AssetLoader::WaitAll(aFutures));
+    CHECK(aFutures.empty());
+
+    for (const std::atomic<UINT>& uNumRuns : aNumRuns)
+    {
+        CHECK_EQUAL(1u, uNumRuns.load());
+    }
+}
+
+TEST_CASE(WaitAllReturnsTheFirstFailureAfterEveryTaskRan)
+{
+    std::atomic<UINT> uNumRuns(0u);
+
+    AssetLoader loader(2u);
+
+    std::vector<std::future<HRESULT>> aFutures;
+    for (UINT i = 0u; i < 8u; ++i)
+    {
+        aFutures.push_back(loader.Submit(
+            [&uNumRuns, i]()
+            {
+                uNumRuns.fetch_add(1u);
+                return i == 2u ? E_INVALIDARG : (i == 5u ? E_FAIL : S_OK);
+            }
+        ));
+    }
+
+    CHECK_EQUAL(E_INVALIDARG, AssetLoader::WaitAll(aFutures));
+    CHECK_EQUAL(8u, uNumRuns.load());
+}
+
+TEST_CASE(DestructorFinishesQueuedTasks)
+{
+    std::atomic<UINT> uNumRuns(0u);
+
+    {
+        AssetLoader loader(1u);
+        for (UINT i = 0u; i < NUM_TASKS; ++i)
+        {
+            loader.Submit(
+                [&uNumRuns]()
+                {
+                    uNumRuns.fetch_add(1u);
+                    return S_OK;
+                }
+            );
+        }
+    }
+
+    CHECK_EQUAL(NUM_TASKS, uNumRuns.load());
+}
+
+TEST_CASE(StartsAtLeastOneThread)
+{
+    AssetLoader loader(0u);
+
+    CHECK_EQUAL(1u, loader.GetNumThreads());
+}
+
+TEST_CASE(PartitionsCoverEveryItemOnce)
+{
+    for (UINT uNumItems : { 0u, 1u, 7u, 64u, 1001u })
+    {
+        for (UINT uNumPartitions = 1u; uNumPartitions <= 9u; ++uNumPartitions)
+        {
+            UINT uExpectedBegin = 0u;
+            for (UINT uPartition = 0u; uPartition < uNumPartitions; ++uPartition)
+            {
+                UINT uBegin = 0u;
+                UINT uEnd = 0u;
+                AssetLoader::GetPartition(uNumItems, uNumPartitions, uPartition, uBegin, uEnd);
+
+                CHECK_EQUAL(uExpectedBegin, uBegin);
+                CHECK(uEnd - uBegin <= uNumItems / uNumPartitions + 1u);
+                CHECK(uEnd - uBegin >= uNumItems / uNumPartitions);
+                uExpectedBegin = uEnd;
+            }
+            CHECK_EQUAL(uNumItems, uExpectedBegin);
+        }
+    }
+}
+
+TEST_CASE(ParallelForRunsEveryItemOnce)
+{
+    std::vector<std::atomic<UINT>> aNumRuns(NUM_TASKS);
+
+    AssetLoader workers(3u);
+    HRESULT hr = AssetLoader::ParallelFor(
+        &workers,
+        NUM_TASKS,
+        4u,
+        [&aNumRuns](_In_ UINT uBegin, _In_ UINT uEnd)
+        {
+            for (UINT i = uBegin; i < uEnd; ++i)
+            {
+                aNumRuns[i].fetch_add(1u);
+            }
+        }
+    );
+    CHECK_EQUAL(S_OK, hr);
+
+    for (const std::atomic<UINT>& uNumRuns : aNumRuns)
+    {
+        CHECK_EQUAL(1u, uNumRuns.load());
+    }
+}
+
+TEST_CASE(ParallelForRunsOnePartitionWithoutWorkers)
+{
+    UINT uNumCalls = 0u;
+    HRESULT hr = AssetLoader::ParallelFor(
+        nullptr,
+        NUM_TASKS,
+        1u,
+        [&uNumCalls](_In_ UINT uBegin, _In_ UINT uEnd)
+        {
+            CHECK_EQUAL(0u, uBegin);
+            CHECK_EQUAL(NUM_TASKS, uEnd);
+            ++uNumCalls;
+        }
+    );
+
+    CHECK_EQUAL(S_OK, hr);
+    CHECK_EQUAL(1u, uNumCalls);
+}
\ No newline at end of file
@@ -0,0 +1,203 @@
+#include "Test.h"
+
+#include "Renderer/MockCommandRecorder.h"
+
+#include <algorithm>
+#include <atomic>
+
+using namespace library;
+
+// Contexts of the recorder, more than one so partitions record on worker threads
+constexpr UINT NUM_CONTEXTS = 4u;
+
+// Items of a pass large enough to use every context
+constexpr UINT NUM_ITEMS = 1000u;
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: recordItems
+
+  Summary:  Records one draw per item, the vertex count of the draw
+            is the item plus one so the item can be told from the
+            recorded call
+
+  Args:     CommandRecorder& recorder
+              Recorder to record with
+            UINT uNumItems
+              Number of items
+
+  Returns:  HRESULT
+              Status code of Record
+-----------------------------------------------------------------F-F*/
+static HRESULT recordItems(_In_ CommandRecorder& recorder, _In_ UINT uNumItems)
+{
+    return recorder.Record(
+        uNumItems,
+        [](_In_opt_ RenderContext* pContext, _In_ UINT uBegin, _In_ UINT uEnd)
+        {
+            for (UINT i = uBegin; i < uEnd; ++i)
+            {
+                pContext->Draw(i + 1u, 0u);
+            }
+        }
+    );
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: getEvents
+
+  Summary:  Returns the logged events of one kind in the order they
+            were logged
+
+  Args:     MockCommandRecorder& recorder
+              Recorder that logged the events
+            eCommandRecorderEvent event
+              Kind of event
+
+  Returns:  std::vector<CommandRecorderEvent>
+              Events of the kind
+-----------------------------------------------------------------F-F*/
+static std::vector<CommandRecorderEvent> getEvents(_In_ MockCommandRecorder& recorder, _In_ eCommandRecorderEvent event)
+{
+    std::vector<CommandRecorderEvent> aEvents = recorder.GetEvents();
+    aEvents.erase(
+        std::remove_if(aEvents.begin(), aEvents.end(), [event](const CommandRecorderEvent& recorded) { return recorded.Event != event; }),
+        aEvents.end()
+    );
+
+    return aEvents;
+}
+
+TEST_CASE(RecordPartitionsCoverEveryItemOnce)
+{
+    for (UINT uNumContexts : { 1u, 3u, NUM_CONTEXTS, 8u })
+    {
+        MockCommandRecorder recorder(uNumContexts);
+
+        for (UINT uNumItems : { 0u, 1u, 31u, 32u, 33u, 64u, 100u, 1023u, NUM_ITEMS })
+        {
+            std::vector<std::atomic<UINT>> aNumRecords(uNumItems);
+            recorder.ClearEvents();
+
+            const HRESULT hr = recorder.Record(
+                uNumItems,
+                [&aNumRecords](_In_opt_ RenderContext* pContext, _In_ UINT uBegin, _In_ UINT uEnd)
+                {
+                    UNREFERENCED_PARAMETER(pContext);
+
+                    for (UINT i = uBegin; i < uEnd; ++i)
+                    {
+                        aNumRecords[i].fetch_add(1u);
+                    }
+                }
+            );
+            CHECK_EQUAL(S_OK, hr);
+
+            for (const std::atomic<UINT>& uNumRecords : aNumRecords)
+            {
+                CHECK_EQUAL(1u, uNumRecords.load());
+            }
+
+            // Partitions are contiguous in context order and no smaller than the minimum unless there is only one
+            std::vector<CommandRecorderEvent> aBegins = getEvents(recorder, eCommandRecorderEvent::BEGIN_RECORDING);
+            std::sort(aBegins.begin(), aBegins.end(), [](const CommandRecorderEvent& a, const CommandRecorderEvent& b) { return a.uContext < b.uContext; });
+            CHECK_EQUAL(recorder.GetNumRecorded(), aBegins.size());
+            CHECK(aBegins.size() <= uNumContexts);
+            CHECK_EQUAL(uNumItems > 0u ? 1u : 0u, aBegins.empty() ? 0u : 1u);
+
+            UINT uNextItem = 0u;
+            for (UINT i = 0u; i < aBegins.size(); ++i)
+            {
+                CHECK_EQUAL(i, aBegins[i].uContext);
+                CHECK_EQUAL(uNextItem, aBegins[i].uBegin);
+                CHECK(aBegins[i].uBegin < aBegins[i].uEnd);
+                CHECK(aBegins.size() == 1u || aBegins[i].uEnd - aBegins[i].uBegin >= CommandRecorder::MIN_ITEMS_PER_CONTEXT);
+                uNextItem = aBegins[i].uEnd;
+            }
+            CHECK_EQUAL(uNumItems, uNextItem);
+            CHECK_EQUAL(aBegins.size(), getEvents(recorder, eCommandRecorderEvent::END_RECORDING).size());
+
+            recorder.Submit(nullptr);
+        }
+    }
+}
+
+TEST_CASE(RecordingsSubmitInPartitionOrder)
+{
+    MockCommandRecorder recorder(NUM_CONTEXTS);
+    CHECK_EQUAL(S_OK, recordItems(recorder, NUM_ITEMS));
+    CHECK_EQUAL(NUM_CONTEXTS, recorder.GetNumRecorded());
+
+    // Every partition recorded its own items in order
+    UINT uNextItem = 0u;
+    for (UINT i = 0u; i < NUM_CONTEXTS; ++i)
+    {
+        for (const RecordedRenderCommand& command : recorder.GetRenderContext(i).GetCommands())
+        {
+            CHECK(command.Command == eRenderCommand::DRAW);
+            CHECK_EQUAL(++uNextItem, command.uCount);
+        }
+    }
+    CHECK_EQUAL(NUM_ITEMS, uNextItem);
+
+    RecordingRenderContext immediateContext;
+    recorder.ClearEvents();
+    recorder.Submit(&immediateContext);
+
+    const std::vector<CommandRecorderEvent> aSubmits = recorder.GetEvents();
+    CHECK_EQUAL(NUM_CONTEXTS, aSubmits.size());
+    for (UINT i = 0u; i < aSubmits.size(); ++i)
+    {
+        CHECK(aSubmits[i].Event == eCommandRecorderEvent::SUBMIT);
+        CHECK_EQUAL(i, aSubmits[i].uContext);
+    }
+
+    CHECK_EQUAL(NUM_CONTEXTS, immediateContext.GetNumCalls(eRenderCommand::EXECUTE_COMMAND_LIST));
+    CHECK_EQUAL(NUM_ITEMS, immediateContext.GetStats().uNumDrawCalls);
+    CHECK_EQUAL(0u, recorder.GetNumRecorded());
+
+    // The recordings were consumed, a second submit plays nothing
+    recorder.Submit(&immediateContext);
+    CHECK_EQUAL(NUM_CONTEXTS, immediateContext.GetNumCalls(eRenderCommand::EXECUTE_COMMAND_LIST));
+}
+
+TEST_CASE(FailedRecordReturnsTheFirstFailure)
+{
+    MockCommandRecorder recorder(NUM_CONTEXTS);
+
+    // The first partition records on the calling thread, the others on workers
+    recorder.SetEndRecordingResult(0u, E_OUTOFMEMORY);
+    recorder.SetEndRecordingResult(2u, E_FAIL);
+    CHECK_EQUAL(E_OUTOFMEMORY, recordItems(recorder, NUM_ITEMS));
+    recorder.Submit(nullptr);
+
+    recorder.SetEndRecordingResult(0u, S_OK);
+    CHECK_EQUAL(E_FAIL, recordItems(recorder, NUM_ITEMS));
+    recorder.Submit(nullptr);
+
+    recorder.SetEndRecordingResult(2u, S_OK);
+    CHECK_EQUAL(S_OK, recordItems(recorder, NUM_ITEMS));
+}
+
+TEST_CASE(SubmitToNullDropsThePartialRecordings)
+{
+    MockCommandRecorder recorder(NUM_CONTEXTS);
+    recorder.SetEndRecordingResult(2u, E_FAIL);
+
+    CHECK_EQUAL(E_FAIL, recordItems(recorder, NUM_ITEMS));
+
+    // The partitions that did not fail still hold their draws until they are dropped
+    CHECK_EQUAL(NUM_CONTEXTS, recorder.GetNumRecorded());
+    CHECK(recorder.GetRenderContext(0u).GetNumDrawCalls() > 0u);
+
+    recorder.Submit(nullptr);
+    CHECK_EQUAL(0u, recorder.GetNumRecorded());
+    for (UINT i = 0u; i < NUM_CONTEXTS; ++i)
+    {
+        CHECK_EQUAL(0u, recorder.GetRenderContext(i).GetNumDrawCalls());
+    }
+
+    RecordingRenderContext immediateContext;
+    recorder.Submit(&immediateContext);
+    CHECK_EQUAL(0u, immediateContext.GetNumCalls(eRenderCommand::EXECUTE_COMMAND_LIST));
+    CHECK_EQUAL(0u, immediateContext.GetStats().uNumDrawCalls);
+}
\ No newline at end of file
@@ -0,0 +1,222 @@
+#include "Test.h"
+
+#include "Renderer/ConstantBufferRing.h"
+
+using namespace library;
+
+// A quarter of the initial capacity, so the fifth frame of this size wraps
+constexpr UINT FRAME_SIZE = ConstantBufferRing::MIN_CAPACITY / 4u;
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: allocateBytes
+
+  Summary:  Allocates zeroed data of the given size without an owner
+
+  Args:     ConstantBufferRing& ring
+              Ring with a frame begun
+            UINT uSize
+              Size of the data in bytes
+
+  Returns:  ConstantBufferAllocation
+              Range of the data in the frame
+-----------------------------------------------------------------F-F*/
+static ConstantBufferAllocation allocateBytes(_Inout_ ConstantBufferRing& ring, _In_ UINT uSize)
+{
+    const std::vector<BYTE> aData(uSize, static_cast<BYTE>(0u));
+
+    return ring.Allocate(aData.data(), uSize, nullptr, 0u);
+}
+
+TEST_CASE(PadsAllocationsToTheAlignment)
+{
+    ConstantBufferRing ring;
+    ring.BeginFrame();
+
+    const UINT aFirst[4] = { 1u, 2u, 3u, 4u };
+    const ConstantBufferAllocation first = ring.Allocate(aFirst, sizeof(aFirst), aFirst, 1u);
+    const ConstantBufferAllocation second = allocateBytes(ring, ConstantBufferRing::ALIGNMENT + 1u);
+
+    CHECK_EQUAL(0u, first.uOffset);
+    CHECK_EQUAL(ConstantBufferRing::ALIGNMENT, first.uSize);
+    CHECK_EQUAL(ConstantBufferRing::ALIGNMENT, second.uOffset);
+    CHECK_EQUAL(2u * ConstantBufferRing::ALIGNMENT, second.uSize);
+    CHECK_EQUAL(3u * ConstantBufferRing::ALIGNMENT, ring.GetFrameSize());
+    CHECK_EQUAL(ConstantBufferRing::ALIGNMENT / ConstantBufferRing::CONSTANT_SIZE, ConstantBufferRing::GetNumConstants(first));
+    CHECK(memcmp(ring.GetFrameData(), aFirst, sizeof(aFirst)) == 0);
+}
+
+TEST_CASE(DiscardsTheFirstFrame)
+{
+    ConstantBufferRing ring;
+    ring.BeginFrame();
+    ConstantBufferAllocation allocation = allocateBytes(ring, 64u);
+
+    // The ring starts without capacity, so the first frame sizes the buffer
+    CHECK(ring.EndFrame());
+    CHECK_EQUAL(ConstantBufferRing::MIN_CAPACITY, ring.GetCapacity());
+    CHECK(ring.IsFramePlaced());
+    CHECK(ring.IsFrameDiscarding());
+    CHECK_EQUAL(0u, ring.GetFrameOffset());
+
+    ring.Place(allocation);
+    CHECK(allocation.bPlaced);
+    CHECK_EQUAL(0u, allocation.uOffset);
+}
+
+TEST_CASE(PlacesFramesAfterThePreviousOneWithoutOverwrite)
+{
+    ConstantBufferRing ring;
+    ring.BeginFrame();
+    allocateBytes(ring, FRAME_SIZE);
+    ring.EndFrame();
+
+    ring.BeginFrame();
+    allocateBytes(ring, 64u);
+    ConstantBufferAllocation allocation = allocateBytes(ring, 64u);
+
+    // Unplaced allocations are relative to the frame until EndFrame places it
+    CHECK(!ring.EndFrame());
+    CHECK(ring.IsFramePlaced());
+    CHECK(!ring.IsFrameDiscarding());
+    CHECK_EQUAL(FRAME_SIZE, ring.GetFrameOffset());
+    CHECK_EQUAL((FRAME_SIZE + ConstantBufferRing::ALIGNMENT) / ConstantBufferRing::CONSTANT_SIZE, ring.GetFirstConstant(allocation));
+
+    ring.Place(allocation);
+    CHECK_EQUAL(FRAME_SIZE + ConstantBufferRing::ALIGNMENT, allocation.uOffset);
+    CHECK_EQUAL((FRAME_SIZE + ConstantBufferRing::ALIGNMENT) / ConstantBufferRing::CONSTANT_SIZE, ring.GetFirstConstant(allocation));
+}
+
+TEST_CASE(RetainsAllocationsOfUnchangedOwners)
+{
+    const INT owner = 0;
+    const INT otherOwner = 0;
+    const BYTE aData[64] = {};
+
+    ConstantBufferRing ring;
+    ring.BeginFrame();
+    ConstantBufferAllocation allocation = ring.Allocate(aData, sizeof(aData), &owner, 1u);
+
+    // Nothing is retained before the allocation is placed
+    CHECK(!ring.Retain(allocation, &owner, 1u));
+    ring.EndFrame();
+    ring.Place(allocation);
+
+    ring.BeginFrame();
+    CHECK(!ring.Retain(allocation, &owner, 2u));
+    CHECK(!ring.Retain(allocation, &otherOwner, 1u));
+    CHECK(ring.Retain(allocation, &owner, 1u));
+    CHECK_EQUAL(ConstantBufferRing::ALIGNMENT, ring.GetRetainedSize());
+    CHECK_EQUAL(0u, ring.GetFrameSize());
+
+    // A frame of retained allocations only is placed without writing anything
+    CHECK(!ring.EndFrame());
+    CHECK(ring.IsFramePlaced());
+    CHECK(!ring.IsFrameDiscarding());
+}
+
+TEST_CASE(WrapsToTheStartWithDiscard)
+{
+    const INT owner = 0;
+    const BYTE aData[64] = {};
+
+    ConstantBufferRing ring;
+    ring.BeginFrame();
+    ConstantBufferAllocation allocation = ring.Allocate(aData, sizeof(aData), &owner, 1u);
+    ring.EndFrame();
+    ring.Place(allocation);
+
+    // Frames of FRAME_SIZE fit behind the first allocation until the end of the buffer
+    for (UINT i = 0u; i < 3u; ++i)
+    {
+        ring.BeginFrame();
+        allocateBytes(ring, FRAME_SIZE);
+        ring.EndFrame();
+        CHECK(!ring.IsFrameDiscarding());
+        CHECK_EQUAL(ConstantBufferRing::ALIGNMENT + i * FRAME_SIZE, ring.GetFrameOffset());
+    }
+
+    ring.BeginFrame();
+    allocateBytes(ring, FRAME_SIZE);
+    CHECK(!ring.EndFrame());
+    CHECK(ring.IsFramePlaced());
+    CHECK(ring.IsFrameDiscarding());
+    CHECK_EQUAL(0u, ring.GetFrameOffset());
+    CHECK_EQUAL(ConstantBufferRing::MIN_CAPACITY, ring.GetCapacity());
+
+    // The discard started a new generation, the data of the first frame is gone
+    ring.BeginFrame();
+    CHECK(!ring.Retain(allocation, &owner, 1u));
+}
+
+TEST_CASE(AllocatesAgainWhenAWrappedFrameRetained)
+{
+    const INT owner = 0;
+    const BYTE aData[64] = {};
+
+    ConstantBufferRing ring;
+    ring.BeginFrame();
+    ConstantBufferAllocation allocation = ring.Allocate(aData, sizeof(aData), &owner, 1u);
+    allocateBytes(ring, FRAME_SIZE);
+    ring.EndFrame();
+    ring.Place(allocation);
+
+    UINT uNumPlacedFrames = 0u;
+    while (ring.IsFramePlaced())
+    {
+        ring.BeginFrame();
+        CHECK(ring.Retain(allocation, &owner, 1u));
+        allocateBytes(ring, FRAME_SIZE);
+        ring.EndFrame();
+        uNumPlacedFrames += ring.IsFramePlaced() ? 1u : 0u;
+    }
+    CHECK_EQUAL(2u, uNumPlacedFrames);
+
+    // The frame wrapped but a discard would lose the retained data, so it is allocated again
+    ring.BeginFrame();
+    CHECK(!ring.Retain(allocation, &owner, 1u));
+    allocation = ring.Allocate(aData, sizeof(aData), &owner, 1u);
+    allocateBytes(ring, FRAME_SIZE);
+    ring.EndFrame();
+    CHECK(ring.IsFramePlaced());
+    CHECK(ring.IsFrameDiscarding());
+    CHECK_EQUAL(0u, ring.GetFrameOffset());
+
+    ring.Place(allocation);
+    ring.BeginFrame();
+    CHECK(ring.Retain(allocation, &owner, 1u));
+}
+
+TEST_CASE(GrowsForFramesLargerThanTheBuffer)
+{
+    ConstantBufferRing ring;
+    ring.BeginFrame();
+    allocateBytes(ring, 64u);
+    ring.EndFrame();
+
+    ring.BeginFrame();
+    allocateBytes(ring, ConstantBufferRing::MIN_CAPACITY + 64u);
+    CHECK(ring.EndFrame());
+    CHECK_EQUAL(2u * ConstantBufferRing::MIN_CAPACITY, ring.GetCapacity());
+    CHECK(ring.IsFrameDiscarding());
+    CHECK_EQUAL(0u, ring.GetFrameOffset());
+}
+
+TEST_CASE(DiscardsAfterReset)
+{
+    ConstantBufferRing ring;
+    ring.BeginFrame();
+    allocateBytes(ring, 64u);
+    ring.EndFrame();
+
+    ring.BeginFrame();
+    allocateBytes(ring, 64u);
+    ring.EndFrame();
+    CHECK(!ring.IsFrameDiscarding());
+
+    ring.Reset();
+    ring.BeginFrame();
+    allocateBytes(ring, 64u);
+    CHECK(!ring.EndFrame());
+    CHECK(ring.IsFrameDiscarding());
+    CHECK_EQUAL(0u, ring.GetFrameOffset());
+}
\ No newline at end of file
@@ -0,0 +1,269 @@
+#include "Test.h"
+
+#include "Texture/DDSParser.h"
+
+using namespace library;
+
+// Offsets in a file, the header starts after the four byte magic number
+constexpr size_t FLAGS_OFFSET = 8u;
+constexpr size_t HEIGHT_OFFSET = 12u;
+constexpr size_t WIDTH_OFFSET = 16u;
+constexpr size_t DEPTH_OFFSET = 24u;
+constexpr size_t MIP_COUNT_OFFSET = 28u;
+constexpr size_t PIXEL_FORMAT_OFFSET = 76u;
+constexpr size_t CAPS2_OFFSET = 112u;
+constexpr size_t DX10_HEADER_OFFSET = sizeof(uint32_t) + DDSParser::HEADER_SIZE;
+
+// Header flags the tests set
+constexpr uint32_t DDSD_HEIGHT = 0x00000002u;
+constexpr uint32_t DDSD_DEPTH = 0x00800000u;
+constexpr uint32_t DDPF_FOURCC = 0x00000004u;
+constexpr uint32_t DDSCAPS2_CUBEMAP = 0x00000200u;
+constexpr uint32_t DDSCAPS2_CUBEMAP_ALLFACES = 0x0000fc00u;
+
+constexpr uint32_t FOURCC_DX10 = 0x30315844u;  // "DX10"
+constexpr uint32_t FOURCC_DXT1 = 0x31545844u;  // "DXT1"
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: writeUInt32
+
+  Summary:  Stores a little-endian value in a file
+
+  Args:     std::vector<uint8_t>& aFile
+              File to write to, grown to hold the value
+            size_t uOffset
+              Offset of the value
+            uint32_t uValue
+              Value to write
+-----------------------------------------------------------------F-F*/
+static void writeUInt32(_Inout_ std::vector<uint8_t>& aFile, _In_ size_t uOffset, _In_ uint32_t uValue)
+{
+    if (aFile.size() < uOffset + sizeof(uint32_t))
+    {
+        aFile.resize(uOffset + sizeof(uint32_t));
+    }
+
+    for (size_t i = 0u; i < sizeof(uint32_t); ++i)
+    {
+        aFile[uOffset + i] = static_cast<uint8_t>(uValue >> (8u * i));
+    }
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: makeHeader
+
+  Summary:  Returns the headers of a DDS file whose pixel format is
+            given by a FourCC code, without any surface
+
+  Args:     uint32_t uWidth
+              Width of the first level
+            uint32_t uHeight
+              Height of the first level
+            uint32_t uNumMips
+              Number of levels
+            uint32_t uFourCC
+              Pixel format code
+
+  Returns:  std::vector<uint8_t>
+              Magic number and header
+-----------------------------------------------------------------F-F*/
+static std::vector<uint8_t> makeHeader(_In_ uint32_t uWidth, _In_ uint32_t uHeight, _In_ uint32_t uNumMips, _In_ uint32_t uFourCC)
+{
+    std::vector<uint8_t> aFile(DX10_HEADER_OFFSET, 0u);
+    writeUInt32(aFile, 0u, DDSParser::MAGIC);
+    writeUInt32(aFile, sizeof(uint32_t), static_cast<uint32_t>(DDSParser::HEADER_SIZE));
+    writeUInt32(aFile, FLAGS_OFFSET, DDSD_HEIGHT);
+    writeUInt32(aFile, HEIGHT_OFFSET, uHeight);
+    writeUInt32(aFile, WIDTH_OFFSET, uWidth);
+    writeUInt32(aFile, MIP_COUNT_OFFSET, uNumMips);
+    writeUInt32(aFile, PIXEL_FORMAT_OFFSET, 32u);
+    writeUInt32(aFile, PIXEL_FORMAT_OFFSET + 4u, DDPF_FOURCC);
+    writeUInt32(aFile, PIXEL_FORMAT_OFFSET + 8u, uFourCC);
+
+    return aFile;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: makeDx10Header
+
+  Summary:  Returns the headers of a DDS file with the DX10
+            extension, without any surface
+
+  Args:     uint32_t uWidth
+              Width of the first level
+            uint32_t uHeight
+              Height of the first level
+            uint32_t uNumMips
+              Number of levels
+            eDDSFormat format
+              Pixel format
+            eDDSDimension dimension
+              Kind of texture
+            uint32_t uArraySize
+              Number of array items
+
+  Returns:  std::vector<uint8_t>
+              Magic number, header and DX10 header
+-----------------------------------------------------------------F-F*/
+static std::vector<uint8_t> makeDx10Header(
+    _In_ uint32_t uWidth,
+    _In_ uint32_t uHeight,
+    _In_ uint32_t uNumMips,
+    _In_ eDDSFormat format,
+    _In_ eDDSDimension dimension,
+    _In_ uint32_t uArraySize
+)
+{
+    std::vector<uint8_t> aFile = makeHeader(uWidth, uHeight, uNumMips, FOURCC_DX10);
+    writeUInt32(aFile, DX10_HEADER_OFFSET, static_cast<uint32_t>(format));
+    writeUInt32(aFile, DX10_HEADER_OFFSET + 4u, static_cast<uint32_t>(dimension));
+    writeUInt32(aFile, DX10_HEADER_OFFSET + 12u, uArraySize);
+    writeUInt32(aFile, DX10_HEADER_OFFSET + 16u, 0u);
+
+    return aFile;
+}
+
+TEST_CASE(ReadsALegacyBlockCompressedHeader)
+{
+    std::vector<uint8_t> aFile = makeHeader(256u, 128u, 9u, FOURCC_DXT1);
+
+    DDSTextureInfo info;
+    CHECK(DDSParser::ParseHeader(aFile.data(), aFile.size(), info) == eDDSStatus::OK);
+    CHECK_EQUAL(256u, info.uWidth);
+    CHECK_EQUAL(128u, info.uHeight);
+    CHECK_EQUAL(1u, info.uDepth);
+    CHECK_EQUAL(1u, info.uArraySize);
+    CHECK_EQUAL(9u, info.uNumMips);
+    CHECK(info.format == eDDSFormat::BC1_UNORM);
+    CHECK(info.dimension == eDDSDimension::TEXTURE2D);
+    CHECK(!info.bCubeMap);
+    CHECK_EQUAL(DX10_HEADER_OFFSET, info.uDataOffset);
+}
+
+TEST_CASE(ReadsADx10ArrayHeader)
+{
+    std::vector<uint8_t> aFile = makeDx10Header(64u, 32u, 1u, eDDSFormat::R8G8B8A8_UNORM, eDDSDimension::TEXTURE2D, 4u);
+
+    DDSTextureInfo info;
+    CHECK(DDSParser::ParseHeader(aFile.data(), aFile.size(), info) == eDDSStatus::OK);
+    CHECK(info.format == eDDSFormat::R8G8B8A8_UNORM);
+    CHECK_EQUAL(4u, info.uArraySize);
+    CHECK_EQUAL(DX10_HEADER_OFFSET + DDSParser::DX10_HEADER_SIZE, info.uDataOffset);
+}
+
+TEST_CASE(ReadsACubeMapWithAllItsFaces)
+{
+    std::vector<uint8_t> aFile = makeHeader(16u, 16u, 5u, FOURCC_DXT1);
+    writeUInt32(aFile, CAPS2_OFFSET, DDSCAPS2_CUBEMAP | DDSCAPS2_CUBEMAP_ALLFACES);
+
+    DDSTextureInfo info;
+    CHECK(DDSParser::ParseHeader(aFile.data(), aFile.size(), info) == eDDSStatus::OK);
+    CHECK(info.bCubeMap);
+
+    // Every face holds its own chain of levels
+    aFile.resize(info.uDataOffset + 6u * (128u + 32u + 8u + 8u + 8u));
+    std::vector<DDSSurface> aSurfaces;
+    CHECK(DDSParser::GetSurfaces(info, aFile.size(), aSurfaces) == eDDSStatus::OK);
+    CHECK_EQUAL(30u, aSurfaces.size());
+    CHECK_EQUAL(info.uDataOffset + 184u, aSurfaces[5].uOffset);
+    CHECK_EQUAL(16u, aSurfaces[5].uWidth);
+}
+
+TEST_CASE(RejectsACubeMapMissingFaces)
+{
+    std::vector<uint8_t> aFile = makeHeader(16u, 16u, 1u, FOURCC_DXT1);
+    writeUInt32(aFile, CAPS2_OFFSET, DDSCAPS2_CUBEMAP | 0x00000400u);
+
+    DDSTextureInfo info;
+    CHECK(DDSParser::ParseHeader(aFile.data(), aFile.size(), info) == eDDSStatus::UNSUPPORTED);
+}
+
+TEST_CASE(RejectsFilesThatAreNotDDS)
+{
+    std::vector<uint8_t> aFile = makeHeader(16u, 16u, 1u, FOURCC_DXT1);
+    aFile[0] = 'P';
+
+    DDSTextureInfo info;
+    CHECK(DDSParser::ParseHeader(aFile.data(), aFile.size(), info) == eDDSStatus::INVALID_FILE);
+    CHECK(DDSParser::ParseHeader(nullptr, aFile.size(), info) == eDDSStatus::INVALID_ARGUMENT);
+}
+
+TEST_CASE(RejectsTruncatedHeaders)
+{
+    std::vector<uint8_t> aFile = makeHeader(16u, 16u, 1u, FOURCC_DXT1);
+
+    DDSTextureInfo info;
+    CHECK(DDSParser::ParseHeader(aFile.data(), aFile.size() - 1u, info) == eDDSStatus::TRUNCATED);
+
+    // The DX10 header follows the legacy one
+    aFile = makeDx10Header(16u, 16u, 1u, eDDSFormat::BC7_UNORM, eDDSDimension::TEXTURE2D, 1u);
+    CHECK(DDSParser::ParseHeader(aFile.data(), DX10_HEADER_OFFSET, info) == eDDSStatus::TRUNCATED);
+}
+
+TEST_CASE(RejectsTooManyMips)
+{
+    std::vector<uint8_t> aFile = makeHeader(65536u, 65536u, DDSParser::MAX_MIPS + 1u, FOURCC_DXT1);
+
+    DDSTextureInfo info;
+    CHECK(DDSParser::ParseHeader(aFile.data(), aFile.size(), info) == eDDSStatus::UNSUPPORTED);
+}
+
+TEST_CASE(LaysOutTheMipsOfABlockCompressedTexture)
+{
+    std::vector<uint8_t> aFile = makeHeader(16u, 16u, 5u, FOURCC_DXT1);
+
+    DDSTextureInfo info;
+    CHECK(DDSParser::ParseHeader(aFile.data(), aFile.size(), info) == eDDSStatus::OK);
+
+    // Levels smaller than a block still take a whole block of 8 bytes
+    const size_t auNumBytes[] = { 128u, 32u, 8u, 8u, 8u };
+    const uint32_t auNumRows[] = { 4u, 2u, 1u, 1u, 1u };
+    aFile.resize(info.uDataOffset + 184u);
+
+    std::vector<DDSSurface> aSurfaces;
+    CHECK(DDSParser::GetSurfaces(info, aFile.size(), aSurfaces) == eDDSStatus::OK);
+    CHECK_EQUAL(5u, aSurfaces.size());
+
+    size_t uOffset = info.uDataOffset;
+    for (size_t i = 0u; i < aSurfaces.size(); ++i)
+    {
+        CHECK_EQUAL(uOffset, aSurfaces[i].uOffset);
+        CHECK_EQUAL(auNumBytes[i], aSurfaces[i].uNumBytes);
+        CHECK_EQUAL(auNumRows[i], aSurfaces[i].uNumRows);
+        CHECK_EQUAL(16u >> i, aSurfaces[i].uWidth);
+        uOffset += auNumBytes[i];
+    }
+}
+
+TEST_CASE(LaysOutTheSlicesOfAVolumeTexture)
+{
+    std::vector<uint8_t> aFile = makeDx10Header(8u, 8u, 2u, eDDSFormat::R8G8B8A8_UNORM, eDDSDimension::TEXTURE3D, 1u);
+    writeUInt32(aFile, FLAGS_OFFSET, DDSD_HEIGHT | DDSD_DEPTH);
+    writeUInt32(aFile, DEPTH_OFFSET, 4u);
+
+    DDSTextureInfo info;
+    CHECK(DDSParser::ParseHeader(aFile.data(), aFile.size(), info) == eDDSStatus::OK);
+    CHECK(info.dimension == eDDSDimension::TEXTURE3D);
+    CHECK_EQUAL(4u, info.uDepth);
+
+    aFile.resize(info.uDataOffset + 1024u + 128u);
+    std::vector<DDSSurface> aSurfaces;
+    CHECK(DDSParser::GetSurfaces(info, aFile.size(), aSurfaces) == eDDSStatus::OK);
+    CHECK_EQUAL(2u, aSurfaces.size());
+    CHECK_EQUAL(256u, aSurfaces[0].uSliceBytes);
+    CHECK_EQUAL(1024u, aSurfaces[0].uNumBytes);
+    CHECK_EQUAL(2u, aSurfaces[1].uDepth);
+    CHECK_EQUAL(128u, aSurfaces[1].uNumBytes);
+}
+
+TEST_CASE(RejectsSurfacesPastTheEndOfTheFile)
+{
+    std::vector<uint8_t> aFile = makeHeader(16u, 16u, 5u, FOURCC_DXT1);
+
+    DDSTextureInfo info;
+    CHECK(DDSParser::ParseHeader(aFile.data(), aFile.size(), info) == eDDSStatus::OK);
+
+    std::vector<DDSSurface> aSurfaces;
+    CHECK(DDSParser::GetSurfaces(info, info.uDataOffset + 183u, aSurfaces) == eDDSStatus::TRUNCATED);
+    CHECK(aSurfaces.empty());
+}
\ No newline at end of file
@@ -0,0 +1,353 @@
+#include "Test.h"
+
+#include "Renderer/FrameGraph.h"
+
+#include <algorithm>
+
+using namespace library;
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: getTraceNames
+
+  Summary:  Returns the names of the trace entries of one event, in
+            trace order
+
+  Args:     const FrameGraph& graph
+              Compiled and executed frame graph
+            eFrameGraphTraceEvent event
+              Event to collect
+
+  Returns:  std::vector<std::wstring>
+              Pass or texture names
+-----------------------------------------------------------------F-F*/
+static std::vector<std::wstring> getTraceNames(_In_ const FrameGraph& graph, _In_ eFrameGraphTraceEvent event)
+{
+    std::vector<std::wstring> aszNames;
+    for (const FrameGraphTraceEntry& entry : graph.GetTrace())
+    {
+        if (entry.Event == event)
+        {
+            aszNames.push_back(entry.szName);
+        }
+    }
+
+    return aszNames;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: compileAndExecute
+
+  Summary:  Compiles the graph and, if that succeeds, executes it
+            without a context so the trace holds the pass order
+
+  Args:     FrameGraph& graph
+              Frame graph to run
+
+  Returns:  HRESULT
+              Status code of the compile
+-----------------------------------------------------------------F-F*/
+static HRESULT compileAndExecute(_In_ FrameGraph& graph)
+{
+    HRESULT hr = graph.Compile();
+    if (SUCCEEDED(hr))
+    {
+        graph.Execute(nullptr);
+    }
+
+    return hr;
+}
+
+constexpr FrameGraphTextureDesc COLOR_DESC = { .uWidth = 64u, .uHeight = 64u, .Format = DXGI_FORMAT_R8G8B8A8_UNORM };
+
+TEST_CASE(CullsPassesThatDoNotReachAnOutput)
+{
+    FrameGraph graph;
+    UINT uBackBuffer = graph.ImportRenderTarget(L"BackBuffer", nullptr, nullptr);
+    UINT uUnused = graph.CreateTexture(L"Unused", COLOR_DESC);
+    UINT uIntermediate = graph.CreateTexture(L"Intermediate", COLOR_DESC);
+    graph.MarkOutput(uBackBuffer);
+
+    UINT uDead = graph.AddPass(L"Dead", nullptr);
+    graph.WriteTexture(uDead, uUnused);
+
+    UINT uProducer = graph.AddPass(L"Producer", nullptr);
+    graph.WriteTexture(uProducer, uIntermediate);
+
+    UINT uDeadReader = graph.AddPass(L"DeadReader", nullptr);
+    graph.ReadTexture(uDeadReader, uUnused, 0u);
+    graph.WriteTexture(uDeadReader, uUnused);
+
+    UINT uPresent = graph.AddPass(L"Present", nullptr);
+    graph.ReadTexture(uPresent, uIntermediate, 0u);
+    graph.WriteTexture(uPresent, uBackBuffer);
+
+    CHECK(SUCCEEDED(compileAndExecute(graph)));
+    CHECK(getTraceNames(graph, eFrameGraphTraceEvent::CULL_PASS) == std::vector<std::wstring>({ L"Dead", L"DeadReader" }));
+    CHECK(getTraceNames(graph, eFrameGraphTraceEvent::EXECUTE_PASS) == std::vector<std::wstring>({ L"Producer", L"Present" }));
+    CHECK(getTraceNames(graph, eFrameGraphTraceEvent::ALLOCATE_TEXTURE) == std::vector<std::wstring>({ L"Intermediate" }));
+}
+
+TEST_CASE(KeepsEveryPassWhenNothingIsCulled)
+{
+    FrameGraph graph;
+    UINT uBackBuffer = graph.ImportRenderTarget(L"BackBuffer", nullptr, nullptr);
+    graph.MarkOutput(uBackBuffer);
+
+    UINT uFirst = graph.AddPass(L"First", nullptr);
+    graph.WriteTexture(uFirst, uBackBuffer);
+    UINT uSecond = graph.AddPass(L"Second", nullptr);
+    graph.WriteTexture(uSecond, uBackBuffer);
+
+    CHECK(SUCCEEDED(compileAndExecute(graph)));
+    CHECK(getTraceNames(graph, eFrameGraphTraceEvent::CULL_PASS).empty());
+    CHECK(getTraceNames(graph, eFrameGraphTraceEvent::EXECUTE_PASS) == std::vector<std::wstring>({ L"First", L"Second" }));
+}
+
+TEST_CASE(OrdersReadersAfterWritersAddedLater)
+{
+    FrameGraph graph;
+    UINT uBackBuffer = graph.ImportRenderTarget(L"BackBuffer", nullptr, nullptr);
+    UINT uShadowMap = graph.CreateTexture(L"ShadowMap", { .uWidth = 64u, .uHeight = 64u, .Format = DXGI_FORMAT_D32_FLOAT });
+    graph.MarkOutput(uBackBuffer);
+
+    UINT uScene = graph.AddPass(L"Scene", nullptr);
+    graph.ReadTexture(uScene, uShadowMap, 2u);
+    graph.WriteTexture(uScene, uBackBuffer);
+
+    UINT uShadow0 = graph.AddPass(L"Shadow0", nullptr);
+    graph.WriteTexture(uShadow0, uShadowMap);
+    UINT uShadow1 = graph.AddPass(L"Shadow1", nullptr);
+    graph.WriteTexture(uShadow1, uShadowMap);
+
+    CHECK(SUCCEEDED(compileAndExecute(graph)));
+    CHECK(getTraceNames(graph, eFrameGraphTraceEvent::EXECUTE_PASS) == std::vector<std::wstring>({ L"Shadow0", L"Shadow1", L"Scene" }));
+}
+
+TEST_CASE(UnbindsSampledSlotBeforeTheTextureIsWritten)
+{
+    FrameGraph graph;
+    UINT uBackBuffer = graph.ImportRenderTarget(L"BackBuffer", nullptr, nullptr);
+    UINT uShadowMap = graph.CreateTexture(L"ShadowMap", { .uWidth = 64u, .uHeight = 64u, .Format = DXGI_FORMAT_D32_FLOAT });
+    graph.MarkOutput(uBackBuffer);
+
+    UINT uShadow = graph.AddPass(L"Shadow", nullptr);
+    graph.WriteTexture(uShadow, uShadowMap);
+
+    UINT uScene = graph.AddPass(L"Scene", nullptr);
+    graph.ReadTexture(uScene, uShadowMap, 2u);
+    graph.WriteTexture(uScene, uBackBuffer);
+
+    CHECK(SUCCEEDED(compileAndExecute(graph)));
+
+    const std::vector<FrameGraphTraceEntry>& aTrace = graph.GetTrace();
+    auto shadow = std::find_if(aTrace.begin(), aTrace.end(), [](const FrameGraphTraceEntry& entry) { return entry.szName == L"Shadow"; });
+    CHECK(shadow != aTrace.end() && shadow != aTrace.begin());
+    if (shadow != aTrace.end() && shadow != aTrace.begin())
+    {
+        const FrameGraphTraceEntry& unbind = *(shadow - 1);
+        CHECK(unbind.Event == eFrameGraphTraceEvent::UNBIND_SHADER_RESOURCE);
+        CHECK_EQUAL(2u, unbind.uValue);
+    }
+}
+
+TEST_CASE(AliasesTexturesWhoseLifetimesDoNotOverlap)
+{
+    FrameGraph graph;
+    UINT uBackBuffer = graph.ImportRenderTarget(L"BackBuffer", nullptr, nullptr);
+    UINT uFirst = graph.CreateTexture(L"First", COLOR_DESC);
+    UINT uSecond = graph.CreateTexture(L"Second", COLOR_DESC);
+    UINT uThird = graph.CreateTexture(L"Third", COLOR_DESC);
+    graph.MarkOutput(uBackBuffer);
+
+    UINT uWriteFirst = graph.AddPass(L"WriteFirst", nullptr);
+    graph.WriteTexture(uWriteFirst, uFirst);
+
+    UINT uFirstToSecond = graph.AddPass(L"FirstToSecond", nullptr);
+    graph.ReadTexture(uFirstToSecond, uFirst, 0u);
+    graph.WriteTexture(uFirstToSecond, uSecond);
+
+    UINT uSecondToThird = graph.AddPass(L"SecondToThird", nullptr);
+    graph.ReadTexture(uSecondToThird, uSecond, 0u);
+    graph.WriteTexture(uSecondToThird, uThird);
+
+    UINT uPresent = graph.AddPass(L"Present", nullptr);
+    graph.ReadTexture(uPresent, uThird, 0u);
+    graph.WriteTexture(uPresent, uBackBuffer);
+
+    CHECK(SUCCEEDED(compileAndExecute(graph)));
+    CHECK_EQUAL(2u, graph.GetNumPhysicalTextures());
+}
+
+TEST_CASE(FailsOnCycle)
+{
+    FrameGraph graph;
+    UINT uBackBuffer = graph.ImportRenderTarget(L"BackBuffer", nullptr, nullptr);
+    UINT uFirst = graph.CreateTexture(L"First", COLOR_DESC);
+    UINT uSecond = graph.CreateTexture(L"Second", COLOR_DESC);
+    graph.MarkOutput(uBackBuffer);
+
+    UINT uA = graph.AddPass(L"A", nullptr);
+    graph.ReadTexture(uA, uSecond, 0u);
+    graph.WriteTexture(uA, uFirst);
+    graph.WriteTexture(uA, uBackBuffer);
+
+    UINT uB = graph.AddPass(L"B", nullptr);
+    graph.ReadTexture(uB, uFirst, 0u);
+    graph.WriteTexture(uB, uSecond);
+
+    CHECK_EQUAL(E_FAIL, graph.Compile());
+}
+
+TEST_CASE(SamplesBetweenTheWritersAroundTheReader)
+{
+    FrameGraph graph;
+    UINT uBackBuffer = graph.ImportRenderTarget(L"BackBuffer", nullptr, nullptr);
+    UINT uDepth = graph.CreateTexture(L"Depth", { .uWidth = 64u, .uHeight = 64u, .Format = DXGI_FORMAT_D24_UNORM_S8_UINT });
+    graph.MarkOutput(uBackBuffer);
+
+    UINT uOpaque = graph.AddPass(L"Opaque", nullptr);
+    graph.WriteTexture(uOpaque, uBackBuffer);
+    graph.WriteTexture(uOpaque, uDepth);
+
+    // Samples the depth of the opaque pass, and must run before the transparent pass writes it again
+    UINT uLighting = graph.AddPass(L"Lighting", nullptr);
+    graph.ReadTexture(uLighting, uDepth, 10u);
+    graph.WriteTexture(uLighting, uBackBuffer);
+
+    UINT uTransparent = graph.AddPass(L"Transparent", nullptr);
+    graph.WriteTexture(uTransparent, uBackBuffer);
+    graph.WriteTexture(uTransparent, uDepth);
+
+    CHECK(SUCCEEDED(compileAndExecute(graph)));
+    CHECK(getTraceNames(graph, eFrameGraphTraceEvent::EXECUTE_PASS) == std::vector<std::wstring>({ L"Opaque", L"Lighting", L"Transparent" }));
+}
+
+TEST_CASE(OrdersTheDeferredScenePasses)
+{
+    // The passes of the deferred path of the renderer, in the order it adds them
+    FrameGraph graph;
+    UINT uBackBuffer = graph.ImportRenderTarget(L"BackBuffer", nullptr, nullptr);
+    UINT uShadowMap = graph.ImportDepthStencil(L"ShadowMap", nullptr, nullptr);
+    UINT uCascadeShadowMap = graph.ImportDepthStencil(L"CascadeShadowMap", nullptr, nullptr);
+    UINT uSceneDepth = graph.CreateTexture(L"SceneDepth", { .uWidth = 64u, .uHeight = 64u, .Format = DXGI_FORMAT_D24_UNORM_S8_UINT });
+    UINT uGBufferAlbedo = graph.CreateTexture(L"GBufferAlbedo", COLOR_DESC);
+    UINT uGBufferNormal = graph.CreateTexture(L"GBufferNormal", { .uWidth = 64u, .uHeight = 64u, .Format = DXGI_FORMAT_R16G16_SNORM });
+    graph.MarkOutput(uBackBuffer);
+
+    UINT uShadow = graph.AddPass(L"Shadow0", nullptr);
+    graph.WriteTexture(uShadow, uShadowMap);
+    UINT uCascade = graph.AddPass(L"Cascade0", nullptr);
+    graph.WriteTexture(uCascade, uCascadeShadowMap);
+
+    UINT uBeginScene = graph.AddPass(L"BeginScene", nullptr);
+    graph.WriteTexture(uBeginScene, uBackBuffer);
+    graph.WriteTexture(uBeginScene, uSceneDepth);
+
+    UINT uDepthPrepass = graph.AddPass(L"DepthPrepass", nullptr);
+    graph.WriteTexture(uDepthPrepass, uSceneDepth);
+
+    UINT uGBuffer = graph.AddPass(L"GBuffer", nullptr);
+    graph.WriteTexture(uGBuffer, uGBufferAlbedo);
+    graph.WriteTexture(uGBuffer, uGBufferNormal);
+    graph.WriteTexture(uGBuffer, uSceneDepth);
+    graph.ReadDepthStencil(uGBuffer, uSceneDepth);
+    graph.ReadTexture(uGBuffer, uShadowMap, 2u);
+    graph.ReadTexture(uGBuffer, uCascadeShadowMap, 4u);
+
+    UINT uDeferredLighting = graph.AddPass(L"DeferredLighting", nullptr);
+    graph.WriteTexture(uDeferredLighting, uBackBuffer);
+    graph.ReadTexture(uDeferredLighting, uGBufferAlbedo, 8u);
+    graph.ReadTexture(uDeferredLighting, uGBufferNormal, 9u);
+    graph.ReadTexture(uDeferredLighting, uSceneDepth, 10u);
+    graph.ReadTexture(uDeferredLighting, uCascadeShadowMap, 4u);
+
+    for (PCWSTR pszName : { L"Renderables", L"Models", L"Skybox" })
+    {
+        UINT uScenePass = graph.AddPass(pszName, nullptr);
+        graph.WriteTexture(uScenePass, uBackBuffer);
+        graph.WriteTexture(uScenePass, uSceneDepth);
+        graph.ReadDepthStencil(uScenePass, uSceneDepth);
+        graph.ReadTexture(uScenePass, uShadowMap, 2u);
+    }
+
+    CHECK(SUCCEEDED(compileAndExecute(graph)));
+    CHECK(getTraceNames(graph, eFrameGraphTraceEvent::CULL_PASS).empty());
+    CHECK(
+        getTraceNames(graph, eFrameGraphTraceEvent::EXECUTE_PASS) == std::vector<std::wstring>(
+            { L"Shadow0", L"Cascade0", L"BeginScene", L"DepthPrepass", L"GBuffer", L"DeferredLighting", L"Renderables", L"Models", L"Skybox" }
+        )
+    );
+
+    // The sampled depth is unbound before the forward passes test against it again
+    const std::vector<FrameGraphTraceEntry>& aTrace = graph.GetTrace();
+    auto renderables = std::find_if(aTrace.begin(), aTrace.end(), [](const FrameGraphTraceEntry& entry) { return entry.szName == L"Renderables"; });
+    auto lighting = std::find_if(aTrace.begin(), aTrace.end(), [](const FrameGraphTraceEntry& entry) { return entry.szName == L"DeferredLighting"; });
+    CHECK(lighting < renderables && renderables != aTrace.end());
+    CHECK(
+        std::any_of(
+            lighting,
+            renderables,
+            [](const FrameGraphTraceEntry& entry) { return entry.Event == eFrameGraphTraceEvent::UNBIND_SHADER_RESOURCE && entry.uValue == 10u; }
+        )
+    );
+}
+
+TEST_CASE(KeepsPassesWritingATestedDepthStencil)
+{
+    FrameGraph graph;
+    UINT uBackBuffer = graph.ImportRenderTarget(L"BackBuffer", nullptr, nullptr);
+    UINT uDepth = graph.CreateTexture(L"Depth", { .uWidth = 64u, .uHeight = 64u, .Format = DXGI_FORMAT_D24_UNORM_S8_UINT });
+    graph.MarkOutput(uBackBuffer);
+
+    UINT uPrepass = graph.AddPass(L"Prepass", nullptr);
+    graph.WriteTexture(uPrepass, uDepth);
+
+    UINT uScene = graph.AddPass(L"Scene", nullptr);
+    graph.WriteTexture(uScene, uBackBuffer);
+    graph.WriteTexture(uScene, uDepth);
+    graph.ReadDepthStencil(uScene, uDepth);
+
+    CHECK(SUCCEEDED(compileAndExecute(graph)));
+    CHECK(getTraceNames(graph, eFrameGraphTraceEvent::CULL_PASS).empty());
+    CHECK(getTraceNames(graph, eFrameGraphTraceEvent::EXECUTE_PASS) == std::vector<std::wstring>({ L"Prepass", L"Scene" }));
+
+    // The depth stencil is never bound as a shader resource, so nothing is unbound
+    CHECK(getTraceNames(graph, eFrameGraphTraceEvent::UNBIND_SHADER_RESOURCE).empty());
+}
+
+TEST_CASE(OrdersTheDepthPrepassBeforeTheForwardScenePasses)
+{
+    // The passes of the forward path of the renderer, in the order it adds them
+    FrameGraph graph;
+    UINT uBackBuffer = graph.ImportRenderTarget(L"BackBuffer", nullptr, nullptr);
+    UINT uShadowMap = graph.ImportDepthStencil(L"ShadowMap", nullptr, nullptr);
+    UINT uSceneDepth = graph.CreateTexture(L"SceneDepth", { .uWidth = 64u, .uHeight = 64u, .Format = DXGI_FORMAT_D24_UNORM_S8_UINT });
+    graph.MarkOutput(uBackBuffer);
+
+    UINT uShadow = graph.AddPass(L"Shadow0", nullptr);
+    graph.WriteTexture(uShadow, uShadowMap);
+
+    UINT uBeginScene = graph.AddPass(L"BeginScene", nullptr);
+    graph.WriteTexture(uBeginScene, uBackBuffer);
+    graph.WriteTexture(uBeginScene, uSceneDepth);
+
+    UINT uDepthPrepass = graph.AddPass(L"DepthPrepass", nullptr);
+    graph.WriteTexture(uDepthPrepass, uSceneDepth);
+
+    for (PCWSTR pszName : { L"Renderables", L"Voxels", L"Models", L"Skybox" })
+    {
+        UINT uScenePass = graph.AddPass(pszName, nullptr);
+        graph.WriteTexture(uScenePass, uBackBuffer);
+        graph.WriteTexture(uScenePass, uSceneDepth);
+        graph.ReadDepthStencil(uScenePass, uSceneDepth);
+        graph.ReadTexture(uScenePass, uShadowMap, 2u);
+    }
+
+    CHECK(SUCCEEDED(compileAndExecute(graph)));
+    CHECK(getTraceNames(graph, eFrameGraphTraceEvent::CULL_PASS).empty());
+    CHECK(
+        getTraceNames(graph, eFrameGraphTraceEvent::EXECUTE_PASS) == std::vector<std::wstring>(
+            { L"Shadow0", L"BeginScene", L"DepthPrepass", L"Renderables", L"Voxels", L"Models", L"Skybox" }
+        )
+    );
+}
\ No newline at end of file
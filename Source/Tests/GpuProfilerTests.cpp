@@ -0,0 +1,194 @@
+#include "Test.h"
+
+#include "Profiler/GpuProfiler.h"
+#include "Profiler/MockGpuTimerBackend.h"
+
+#include <cstring>
+
+using namespace library;
+
+// Simulated ticks per second, a millisecond per tick
+constexpr UINT64 GPU_FREQUENCY = 1000u;
+
+// Frames profiled by each test, several times the frames in flight
+constexpr UINT NUM_PROFILED_FRAMES = 12u;
+
+// Name of the scope of each frame, so a collected frame can be told apart
+static constexpr PCSTR PASS_NAMES[NUM_PROFILED_FRAMES] =
+{
+    "Pass0", "Pass1", "Pass2", "Pass3", "Pass4", "Pass5",
+    "Pass6", "Pass7", "Pass8", "Pass9", "Pass10", "Pass11",
+};
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: createGpuProfiler
+
+  Summary:  Creates a GPU profiler over a mock backend
+
+  Args:     UINT uLatency
+              Frames that end before the results of a frame are ready
+            MockGpuTimerBackend*& pOutBackend
+              The backend, owned by the profiler
+
+  Returns:  std::unique_ptr<GpuProfiler>
+              The initialized profiler
+-----------------------------------------------------------------F-F*/
+static std::unique_ptr<GpuProfiler> createGpuProfiler(_In_ UINT uLatency, _Out_ MockGpuTimerBackend*& pOutBackend)
+{
+    std::unique_ptr<MockGpuTimerBackend> backend = std::make_unique<MockGpuTimerBackend>(uLatency, GPU_FREQUENCY, 1u);
+    pOutBackend = backend.get();
+
+    std::unique_ptr<GpuProfiler> gpuProfiler = std::make_unique<GpuProfiler>(std::move(backend));
+    CHECK_EQUAL(S_OK, gpuProfiler->Initialize());
+
+    return gpuProfiler;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: profileFrame
+
+  Summary:  Profiles a frame with one scope on the GPU, then ends the
+            frame of the profiler. The scope is used directly since
+            PROFILE_GPU_SCOPE is compiled out of release builds
+
+  Args:     GpuProfiler& gpuProfiler
+              Profiler to time with
+            UINT uFrame
+              Index of the frame, picks the name of the scope
+-----------------------------------------------------------------F-F*/
+static void profileFrame(_In_ GpuProfiler& gpuProfiler, _In_ UINT uFrame)
+{
+    gpuProfiler.BeginFrame();
+    {
+        GpuProfileScope scope(&gpuProfiler, PASS_NAMES[uFrame]);
+    }
+    gpuProfiler.EndFrame();
+    Profiler::EndFrame();
+}
+
+TEST_CASE(GpuProfilerReportsFramesAfterTheirLatency)
+{
+    for (UINT uLatency = 0u; uLatency < GpuProfiler::NUM_FRAMES; ++uLatency)
+    {
+        Profiler::Reset();
+        MockGpuTimerBackend* pBackend = nullptr;
+        std::unique_ptr<GpuProfiler> gpuProfiler = createGpuProfiler(uLatency, pBackend);
+
+        for (UINT i = 0u; i < NUM_PROFILED_FRAMES; ++i)
+        {
+            profileFrame(*gpuProfiler, i);
+
+            // Frame i - latency is the only one finished during frame i
+            const std::vector<ProfilerGpuEvent>& aGpuEvents = Profiler::GetFrames().back().aGpuEvents;
+            if (i < uLatency)
+            {
+                CHECK_EQUAL(0u, gpuProfiler->GetNumCollectedFrames());
+                CHECK(aGpuEvents.empty());
+                continue;
+            }
+
+            CHECK_EQUAL(static_cast<UINT64>(i + 1u - uLatency), gpuProfiler->GetNumCollectedFrames());
+            CHECK_EQUAL(2u, aGpuEvents.size());
+            if (aGpuEvents.size() == 2u)
+            {
+                CHECK(std::strcmp(aGpuEvents[0].pszName, "GPU frame") == 0);
+                CHECK(std::strcmp(aGpuEvents[1].pszName, PASS_NAMES[i - uLatency]) == 0);
+
+                // The frame begins, the scope takes a tick, then the frame ends
+                CHECK_CLOSE(3.0f, aGpuEvents[0].durationMs, 0.0001f);
+                CHECK_CLOSE(1.0f, aGpuEvents[1].startMs, 0.0001f);
+                CHECK_CLOSE(1.0f, aGpuEvents[1].durationMs, 0.0001f);
+            }
+        }
+
+        CHECK_EQUAL(0u, gpuProfiler->GetNumDroppedFrames());
+        CHECK_CLOSE(3.0f, gpuProfiler->GetLastFrameMs(), 0.0001f);
+    }
+}
+
+TEST_CASE(GpuProfilerNeverWaitsForResults)
+{
+    Profiler::Reset();
+
+    // Results arrive only after the slot of their frame is needed again
+    MockGpuTimerBackend* pBackend = nullptr;
+    std::unique_ptr<GpuProfiler> gpuProfiler = createGpuProfiler(GpuProfiler::NUM_FRAMES, pBackend);
+
+    for (UINT i = 0u; i < NUM_PROFILED_FRAMES; ++i)
+    {
+        profileFrame(*gpuProfiler, i);
+        CHECK(Profiler::GetFrames().back().aGpuEvents.empty());
+
+        // One poll when a slot is reused and one when collecting the oldest frame, never a spin
+        CHECK(pBackend->GetNumPollsNotReady() <= 2u * (i + 1u));
+        CHECK_EQUAL(pBackend->GetNumPolls(), pBackend->GetNumPollsNotReady());
+    }
+
+    CHECK_EQUAL(0u, gpuProfiler->GetNumCollectedFrames());
+    CHECK_EQUAL(static_cast<UINT64>(NUM_PROFILED_FRAMES - GpuProfiler::NUM_FRAMES), gpuProfiler->GetNumDroppedFrames());
+}
+
+TEST_CASE(GpuProfilerDropsDisjointFrames)
+{
+    Profiler::Reset();
+
+    MockGpuTimerBackend* pBackend = nullptr;
+    std::unique_ptr<GpuProfiler> gpuProfiler = createGpuProfiler(1u, pBackend);
+
+    UINT uNumReported = 0u;
+    for (UINT i = 0u; i < NUM_PROFILED_FRAMES; ++i)
+    {
+        // Frames 4 and 5 are disjoint, as when the GPU clock changes
+        pBackend->SetDisjoint(i == 4u || i == 5u);
+        profileFrame(*gpuProfiler, i);
+
+        for (const ProfilerGpuEvent& event : Profiler::GetFrames().back().aGpuEvents)
+        {
+            CHECK(std::strcmp(event.pszName, "Pass4") != 0 && std::strcmp(event.pszName, "Pass5") != 0);
+            uNumReported += std::strncmp(event.pszName, "Pass", 4u) == 0 ? 1u : 0u;
+        }
+
+        // The timings of the last good frame are kept while disjoint frames are dropped
+        if (i == 5u || i == 6u)
+        {
+            CHECK(std::strcmp(gpuProfiler->GetLastTimings().back().pszName, "Pass3") == 0);
+        }
+    }
+
+    CHECK_EQUAL(2u, gpuProfiler->GetNumDroppedFrames());
+    CHECK_EQUAL(static_cast<UINT64>(NUM_PROFILED_FRAMES - 1u - 2u), gpuProfiler->GetNumCollectedFrames());
+    CHECK_EQUAL(NUM_PROFILED_FRAMES - 1u - 2u, uNumReported);
+}
+
+TEST_CASE(GpuProfilerIgnoresScopesItCannotTime)
+{
+    Profiler::Reset();
+
+    MockGpuTimerBackend* pBackend = nullptr;
+    std::unique_ptr<GpuProfiler> gpuProfiler = createGpuProfiler(0u, pBackend);
+
+    // Outside a frame
+    CHECK_EQUAL(GpuProfiler::INVALID_SCOPE, gpuProfiler->BeginScope("Outside"));
+
+    gpuProfiler->BeginFrame();
+    for (UINT i = 0u; i < GpuProfiler::MAX_SCOPES; ++i)
+    {
+        CHECK_EQUAL(i, gpuProfiler->BeginScope(PASS_NAMES[i % NUM_PROFILED_FRAMES]));
+        gpuProfiler->EndScope(i);
+    }
+
+    // Past the queries of a frame
+    const UINT uScope = gpuProfiler->BeginScope("Overflow");
+    CHECK_EQUAL(GpuProfiler::INVALID_SCOPE, uScope);
+    gpuProfiler->EndScope(uScope);
+    gpuProfiler->EndFrame();
+
+    CHECK_EQUAL(1u, gpuProfiler->GetNumCollectedFrames());
+    CHECK_EQUAL(1u + GpuProfiler::MAX_SCOPES, gpuProfiler->GetLastTimings().size());
+    CHECK_CLOSE(static_cast<FLOAT>(1u + 2u * GpuProfiler::MAX_SCOPES), gpuProfiler->GetLastFrameMs(), 0.0001f);
+
+    // Without a profiler the scope does nothing
+    {
+        GpuProfileScope scope(nullptr, "Null");
+    }
+}
\ No newline at end of file
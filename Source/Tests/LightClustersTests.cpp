@@ -0,0 +1,277 @@
+#include "Test.h"
+
+#include "Light/LightClusters.h"
+
+using namespace library;
+
+constexpr FLOAT CAMERA_NEAR = 0.01f;
+constexpr FLOAT CAMERA_FAR = 1000.0f;
+
+// Field of view of the camera along y, and the aspect of a 16:9 screen
+constexpr FLOAT CAMERA_FOV = XM_PIDIV4;
+constexpr FLOAT CAMERA_ASPECT = 16.0f / 9.0f;
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: getProjection
+
+  Summary:  Returns the projection of the camera of the tests
+
+  Returns:  XMMATRIX
+              Left handed perspective projection
+-----------------------------------------------------------------F-F*/
+static XMMATRIX getProjection()
+{
+    return XMMatrixPerspectiveFovLH(CAMERA_FOV, CAMERA_ASPECT, CAMERA_NEAR, CAMERA_FAR);
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: makeLight
+
+  Summary:  Returns a white light
+
+  Args:     FLOAT x
+            FLOAT y
+            FLOAT z
+              Position in the view space of the camera at the origin
+            FLOAT radius
+              Radius of the light
+
+  Returns:  ClusterLight
+              Light to bin
+-----------------------------------------------------------------F-F*/
+static ClusterLight makeLight(_In_ FLOAT x, _In_ FLOAT y, _In_ FLOAT z, _In_ FLOAT radius)
+{
+    return ClusterLight{ .PositionAndRadius = XMFLOAT4(x, y, z, radius), .Color = XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f) };
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: getTile
+
+  Summary:  Returns the screen tile a point in view space projects to
+
+  Args:     FLOAT x
+            FLOAT y
+            FLOAT z
+              Position in the view space of the camera
+
+  Returns:  XMUINT2
+              Tile along x, and along y from the top of the screen
+-----------------------------------------------------------------F-F*/
+static XMUINT2 getTile(_In_ FLOAT x, _In_ FLOAT y, _In_ FLOAT z)
+{
+    const FLOAT halfHeight = z * std::tan(CAMERA_FOV * 0.5f);
+    const FLOAT halfWidth = halfHeight * CAMERA_ASPECT;
+    const FLOAT u = (x / halfWidth + 1.0f) * 0.5f;
+    const FLOAT v = (1.0f - y / halfHeight) * 0.5f;
+
+    return XMUINT2(
+        static_cast<UINT>(u * static_cast<FLOAT>(LightClusters::NUM_CLUSTERS_X)),
+        static_cast<UINT>(v * static_cast<FLOAT>(LightClusters::NUM_CLUSTERS_Y))
+    );
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: isInCluster
+
+  Summary:  Checks whether a light is among the lights of a cluster
+
+  Args:     const LightClusters& clusters
+              Built clusters
+            UINT uCluster
+              Index of the cluster
+            UINT uLight
+              Index of the light
+
+  Returns:  BOOL
+              TRUE if the cluster holds the light
+-----------------------------------------------------------------F-F*/
+static BOOL isInCluster(_In_ const LightClusters& clusters, _In_ UINT uCluster, _In_ UINT uLight)
+{
+    const XMUINT2& range = clusters.GetClusterRanges()[uCluster];
+    for (UINT i = range.x; i < range.x + range.y; ++i)
+    {
+        if (clusters.GetLightIndices()[i] == uLight)
+        {
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+TEST_CASE(EndsTheFirstSliceAtTheMinimumSliceDepth)
+{
+    LightClusters clusters(1u);
+    CHECK(SUCCEEDED(clusters.Build(XMMatrixIdentity(), getProjection(), std::vector<ClusterLight>())));
+
+    CHECK_EQUAL(0u, clusters.GetSlice(0.0f));
+    CHECK_EQUAL(0u, clusters.GetSlice(CAMERA_NEAR));
+    CHECK_EQUAL(0u, clusters.GetSlice(LightClusters::MIN_SLICE_DEPTH * 0.999f));
+    CHECK_EQUAL(1u, clusters.GetSlice(LightClusters::MIN_SLICE_DEPTH * 1.001f));
+    CHECK_EQUAL(LightClusters::NUM_CLUSTERS_Z - 1u, clusters.GetSlice(CAMERA_FAR * 0.999f));
+    CHECK_EQUAL(LightClusters::NUM_CLUSTERS_Z - 1u, clusters.GetSlice(CAMERA_FAR * 2.0f));
+}
+
+TEST_CASE(SplitsTheViewDepthExponentially)
+{
+    LightClusters clusters(1u);
+    CHECK(SUCCEEDED(clusters.Build(XMMatrixIdentity(), getProjection(), std::vector<ClusterLight>())));
+
+    // Slice k starts at the minimum slice depth times (far / minimum slice depth) ^ ((k - 1) / (slices - 1))
+    const FLOAT ratio = CAMERA_FAR / LightClusters::MIN_SLICE_DEPTH;
+    for (UINT k = 1u; k < LightClusters::NUM_CLUSTERS_Z; ++k)
+    {
+        const FLOAT exponent = static_cast<FLOAT>(k - 1u) / static_cast<FLOAT>(LightClusters::NUM_CLUSTERS_Z - 1u);
+        const FLOAT boundary = LightClusters::MIN_SLICE_DEPTH * std::pow(ratio, exponent);
+        CHECK_EQUAL(k - 1u, clusters.GetSlice(boundary * 0.999f));
+        CHECK_EQUAL(k, clusters.GetSlice(boundary * 1.001f));
+    }
+}
+
+TEST_CASE(BinsALightIntoTheClustersItReaches)
+{
+    LightClusters clusters(1u);
+    const std::vector<ClusterLight> aLights = { makeLight(0.3f, -0.2f, 10.0f, 1.0f) };
+    CHECK(SUCCEEDED(clusters.Build(XMMatrixIdentity(), getProjection(), aLights)));
+    CHECK_EQUAL(1u, clusters.GetNumVisibleLights());
+
+    ClusterLightBounds bounds;
+    CHECK(clusters.GetLightBounds(0u, bounds));
+    CHECK_EQUAL(clusters.GetSlice(9.0f), bounds.uMinZ);
+    CHECK_EQUAL(clusters.GetSlice(11.0f), bounds.uMaxZ);
+
+    const XMUINT2 tile = getTile(0.3f, -0.2f, 10.0f);
+    CHECK(bounds.uMinX <= tile.x && tile.x <= bounds.uMaxX);
+    CHECK(bounds.uMinY <= tile.y && tile.y <= bounds.uMaxY);
+    CHECK(bounds.uMaxX - bounds.uMinX < LightClusters::NUM_CLUSTERS_X - 1u);
+    CHECK(bounds.uMaxY - bounds.uMinY < LightClusters::NUM_CLUSTERS_Y - 1u);
+
+    // The light is in every cluster of its bounds and in no other
+    UINT uNumClusters = 0u;
+    for (UINT z = 0u; z < LightClusters::NUM_CLUSTERS_Z; ++z)
+    {
+        for (UINT y = 0u; y < LightClusters::NUM_CLUSTERS_Y; ++y)
+        {
+            for (UINT x = 0u; x < LightClusters::NUM_CLUSTERS_X; ++x)
+            {
+                const BOOL bInBounds = x >= bounds.uMinX && x <= bounds.uMaxX && y >= bounds.uMinY && y <= bounds.uMaxY && z >= bounds.uMinZ && z <= bounds.uMaxZ;
+                CHECK_EQUAL(bInBounds, isInCluster(clusters, LightClusters::GetClusterIndex(x, y, z), 0u));
+                uNumClusters += bInBounds ? 1u : 0u;
+            }
+        }
+    }
+    CHECK_EQUAL(uNumClusters, static_cast<UINT>(clusters.GetLightIndices().size()));
+}
+
+TEST_CASE(CountsTilesFromTheTopLeftOfTheScreen)
+{
+    LightClusters clusters(1u);
+    const std::vector<ClusterLight> aLights =
+    {
+        makeLight(-6.5f, 3.6f, 10.0f, 0.2f),
+        makeLight(6.5f, -3.6f, 10.0f, 0.2f)
+    };
+    CHECK(SUCCEEDED(clusters.Build(XMMatrixIdentity(), getProjection(), aLights)));
+
+    ClusterLightBounds topLeft;
+    CHECK(clusters.GetLightBounds(0u, topLeft));
+    CHECK_EQUAL(0u, topLeft.uMinX);
+    CHECK_EQUAL(0u, topLeft.uMinY);
+    CHECK(topLeft.uMaxX <= 1u);
+    CHECK(topLeft.uMaxY <= 1u);
+
+    ClusterLightBounds bottomRight;
+    CHECK(clusters.GetLightBounds(1u, bottomRight));
+    CHECK_EQUAL(LightClusters::NUM_CLUSTERS_X - 1u, bottomRight.uMaxX);
+    CHECK_EQUAL(LightClusters::NUM_CLUSTERS_Y - 1u, bottomRight.uMaxY);
+    CHECK(bottomRight.uMinX >= LightClusters::NUM_CLUSTERS_X - 2u);
+    CHECK(bottomRight.uMinY >= LightClusters::NUM_CLUSTERS_Y - 2u);
+}
+
+TEST_CASE(SkipsLightsOutsideTheView)
+{
+    LightClusters clusters(1u);
+    const std::vector<ClusterLight> aLights =
+    {
+        makeLight(0.0f, 0.0f, -10.0f, 1.0f),
+        makeLight(-100.0f, 0.0f, 10.0f, 1.0f),
+        makeLight(0.0f, 100.0f, 10.0f, 1.0f),
+        makeLight(0.0f, 0.0f, CAMERA_FAR + 10.0f, 1.0f),
+        makeLight(0.0f, 0.0f, 10.0f, 0.0f)
+    };
+    CHECK(SUCCEEDED(clusters.Build(XMMatrixIdentity(), getProjection(), aLights)));
+
+    CHECK_EQUAL(0u, clusters.GetNumVisibleLights());
+    CHECK(clusters.GetLightIndices().empty());
+    for (UINT i = 0u; i < static_cast<UINT>(aLights.size()); ++i)
+    {
+        ClusterLightBounds bounds;
+        CHECK(!clusters.GetLightBounds(i, bounds));
+    }
+}
+
+TEST_CASE(ReachesEveryTileWithALightAroundTheEye)
+{
+    LightClusters clusters(1u);
+    const std::vector<ClusterLight> aLights = { makeLight(0.0f, 0.0f, 0.5f, 2.0f) };
+    CHECK(SUCCEEDED(clusters.Build(XMMatrixIdentity(), getProjection(), aLights)));
+
+    ClusterLightBounds bounds;
+    CHECK(clusters.GetLightBounds(0u, bounds));
+    CHECK_EQUAL(0u, bounds.uMinX);
+    CHECK_EQUAL(LightClusters::NUM_CLUSTERS_X - 1u, bounds.uMaxX);
+    CHECK_EQUAL(0u, bounds.uMinY);
+    CHECK_EQUAL(LightClusters::NUM_CLUSTERS_Y - 1u, bounds.uMaxY);
+    CHECK_EQUAL(0u, bounds.uMinZ);
+    CHECK_EQUAL(clusters.GetSlice(2.5f), bounds.uMaxZ);
+}
+
+TEST_CASE(KeepsTheInputOrderOfTheLightsOfACluster)
+{
+    LightClusters clusters(1u);
+    const std::vector<ClusterLight> aLights =
+    {
+        makeLight(0.0f, 0.0f, 20.0f, 2.0f),
+        makeLight(0.0f, 0.0f, -20.0f, 2.0f),
+        makeLight(0.1f, 0.1f, 20.0f, 2.0f)
+    };
+    CHECK(SUCCEEDED(clusters.Build(XMMatrixIdentity(), getProjection(), aLights)));
+    CHECK_EQUAL(2u, clusters.GetNumVisibleLights());
+
+    const XMUINT2 tile = getTile(0.0f, 0.0f, 20.0f);
+    const XMUINT2& range = clusters.GetClusterRanges()[LightClusters::GetClusterIndex(tile.x, tile.y, clusters.GetSlice(20.0f))];
+    CHECK_EQUAL(2u, range.y);
+    CHECK_EQUAL(0u, clusters.GetLightIndices()[range.x]);
+    CHECK_EQUAL(2u, clusters.GetLightIndices()[range.x + 1u]);
+}
+
+TEST_CASE(BinsTheSameClustersOnWorkerThreads)
+{
+    // Enough lights for every thread to take a partition
+    std::vector<ClusterLight> aLights;
+    UINT uSeed = 1u;
+    auto random = [&uSeed]()
+    {
+        uSeed = uSeed * 1664525u + 1013904223u;
+        return static_cast<FLOAT>(uSeed >> 8u) / static_cast<FLOAT>(1u << 24u);
+    };
+    for (UINT i = 0u; i < LightClusters::MIN_LIGHTS_PER_THREAD * 8u; ++i)
+    {
+        aLights.push_back(makeLight(random() * 80.0f - 40.0f, random() * 40.0f - 20.0f, random() * 120.0f - 20.0f, random() * 4.0f + 0.5f));
+    }
+
+    const XMMATRIX view = XMMatrixLookAtLH(XMVectorSet(3.0f, 2.0f, -5.0f, 1.0f), XMVectorSet(0.0f, 0.0f, 30.0f, 1.0f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+    LightClusters serial(1u);
+    LightClusters parallel(4u);
+    CHECK(SUCCEEDED(serial.Build(view, getProjection(), aLights)));
+    CHECK(SUCCEEDED(parallel.Build(view, getProjection(), aLights)));
+
+    CHECK(serial.GetNumVisibleLights() > 0u);
+    CHECK_EQUAL(serial.GetNumVisibleLights(), parallel.GetNumVisibleLights());
+    CHECK(serial.GetLightIndices() == parallel.GetLightIndices());
+    for (UINT i = 0u; i < LightClusters::NUM_CLUSTERS; ++i)
+    {
+        CHECK_EQUAL(serial.GetClusterRanges()[i].x, parallel.GetClusterRanges()[i].x);
+        CHECK_EQUAL(serial.GetClusterRanges()[i].y, parallel.GetClusterRanges()[i].y);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+/*+===================================================================
+  File:      MAIN.CPP
+
+  Summary:   Runs the unit tests of the renderer that do not need a
+             device. Returns a nonzero exit code if any test fails.
+             Content paths are relative to Source/Game, so run it from
+             there.
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+
+#include "Common.h"
+
+#include "Test.h"
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: main
+
+  Summary:  Entry point of the test runner
+
+  Returns:  INT
+              EXIT_SUCCESS if every test passed, EXIT_FAILURE
+              otherwise
+-----------------------------------------------------------------F-F*/
+INT main()
+{
+    return test::TestRegistry::RunAll() == 0u ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file
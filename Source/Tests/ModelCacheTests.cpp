@@ -0,0 +1,361 @@
+#include "Test.h"
+
+#include "Model/ModelCache.h"
+
+#include <cstring>
+#include <fstream>
+
+using namespace library;
+
+// Key of the test model, any value works as long as saving and loading agree
+constexpr UINT64 MODEL_KEY = 0x0123456789abcdefull;
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: getCacheDirectory
+
+  Summary:  Returns an empty directory for the cache files of a test
+
+  Args:     PCWSTR pszName
+              Name of the test
+
+  Returns:  std::filesystem::path
+              Emptied directory
+-----------------------------------------------------------------F-F*/
+static std::filesystem::path getCacheDirectory(_In_ PCWSTR pszName)
+{
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / L"ModelCacheTests" / pszName;
+
+    std::error_code errorCode;
+    std::filesystem::remove_all(directory, errorCode);
+    std::filesystem::create_directories(directory, errorCode);
+
+    return directory;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: writeFile
+
+  Summary:  Replaces the contents of a file
+
+  Args:     const std::filesystem::path& filePath
+              Path to the file
+            const std::string& szContents
+              New contents
+-----------------------------------------------------------------F-F*/
+static void writeFile(_In_ const std::filesystem::path& filePath, _In_ const std::string& szContents)
+{
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    file << szContents;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: getOnlyFile
+
+  Summary:  Returns the single file of a directory
+
+  Args:     const std::filesystem::path& directory
+              Directory with one file
+
+  Returns:  std::filesystem::path
+              Path to the file, empty if there is not exactly one
+-----------------------------------------------------------------F-F*/
+static std::filesystem::path getOnlyFile(_In_ const std::filesystem::path& directory)
+{
+    std::vector<std::filesystem::path> aFiles;
+    for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(directory))
+    {
+        aFiles.push_back(entry.path());
+    }
+
+    return aFiles.size() == 1u ? aFiles[0] : std::filesystem::path();
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: makeMatrix
+
+  Summary:  Returns a matrix whose elements count up from a value
+
+  Args:     FLOAT first
+              Value of the first element
+
+  Returns:  XMFLOAT4X4
+              Matrix with distinct elements
+-----------------------------------------------------------------F-F*/
+static XMFLOAT4X4 makeMatrix(_In_ FLOAT first)
+{
+    XMFLOAT4X4 matrix;
+    for (UINT uRow = 0u; uRow < 4u; ++uRow)
+    {
+        for (UINT uColumn = 0u; uColumn < 4u; ++uColumn)
+        {
+            matrix.m[uRow][uColumn] = first + static_cast<FLOAT>(uRow * 4u + uColumn);
+        }
+    }
+
+    return matrix;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: makeModel
+
+  Summary:  Returns a cooked model that uses every part of the format
+
+  Args:     const std::filesystem::path& dependencyPath
+              Material library the model depends on
+
+  Returns:  CookedModel
+              Skinned, animated model of two meshes
+-----------------------------------------------------------------F-F*/
+static CookedModel makeModel(_In_ const std::filesystem::path& dependencyPath)
+{
+    CookedModel model;
+    for (UINT i = 0u; i < 6u; ++i)
+    {
+        const FLOAT value = static_cast<FLOAT>(i);
+        model.aVertices.push_back(SimpleVertex{ .Position = XMFLOAT3(value, value + 0.5f, -value), .TexCoord = XMFLOAT2(value * 0.1f, 1.0f - value * 0.1f), .Normal = XMFLOAT3(0.0f, 1.0f, 0.0f) });
+        model.aNormalData.push_back(NormalData{ .Tangent = XMFLOAT3(1.0f, 0.0f, value), .Bitangent = XMFLOAT3(0.0f, 0.0f, -value) });
+        model.aAnimationData.push_back(AnimationData{ .aBoneIndices = XMUINT4(i % 2u, 1u - i % 2u, 0u, 0u), .aBoneWeights = XMFLOAT4(0.75f, 0.25f, 0.0f, 0.0f) });
+    }
+    model.aIndices = { 0u, 1u, 2u, 3u, 4u, 5u };
+    model.aMeshes =
+    {
+        CookedMeshEntry{ .uNumIndices = 3u, .uBaseVertex = 0u, .uBaseIndex = 0u, .uMaterialIndex = 0u },
+        CookedMeshEntry{ .uNumIndices = 3u, .uBaseVertex = 3u, .uBaseIndex = 3u, .uMaterialIndex = 1u },
+    };
+    model.aMaterials =
+    {
+        CookedMaterial{ .szDiffusePath = L"Content/diffuse.png", .szSpecularPath = L"", .szNormalPath = L"Content/normal.png" },
+        CookedMaterial{ .szDiffusePath = L"", .szSpecularPath = L"Content/specular.png", .szNormalPath = L"" },
+    };
+    model.aBones =
+    {
+        CookedBone{ .szName = "Hip", .OffsetMatrix = makeMatrix(1.0f) },
+        CookedBone{ .szName = "Knee", .OffsetMatrix = makeMatrix(17.0f) },
+    };
+    model.aNodes =
+    {
+        CookedNode{ .szName = "Root", .iParentIndex = -1, .iBoneIndex = -1, .Transformation = makeMatrix(-16.0f) },
+        CookedNode{ .szName = "Hip", .iParentIndex = 0, .iBoneIndex = 0, .Transformation = makeMatrix(33.0f) },
+        CookedNode{ .szName = "Knee", .iParentIndex = 1, .iBoneIndex = 1, .Transformation = makeMatrix(49.0f) },
+    };
+
+    CookedChannel channel =
+    {
+        .uNodeIndex = 2u,
+        .aPositionKeys = { CookedVectorKey{ .Time = 0.0f, .Value = XMFLOAT3(0.0f, 1.0f, 2.0f) }, CookedVectorKey{ .Time = 10.0f, .Value = XMFLOAT3(3.0f, 4.0f, 5.0f) } },
+        .aRotationKeys = { CookedQuaternionKey{ .Time = 5.0f, .Value = XMFLOAT4(0.0f, 0.70710678f, 0.0f, 0.70710678f) } },
+        .aScalingKeys = {},
+    };
+    model.aAnimations = { CookedAnimation{ .Duration = 10.0f, .TicksPerSecond = 25.0f, .aChannels = { channel } } };
+    model.aDependencies = { dependencyPath.wstring() };
+
+    return model;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: isBytewiseEqual
+
+  Summary:  Returns whether two arrays of trivially copyable values
+            hold the same bytes
+
+  Args:     const std::vector<T>& aExpected
+              Expected values
+            const std::vector<T>& aActual
+              Values read back
+
+  Returns:  BOOL
+              TRUE if the sizes and bytes match
+-----------------------------------------------------------------F-F*/
+template <typename T>
+static BOOL isBytewiseEqual(_In_ const std::vector<T>& aExpected, _In_ const std::vector<T>& aActual)
+{
+    return aExpected.size() == aActual.size()
+        && (aExpected.empty() || std::memcmp(aExpected.data(), aActual.data(), aExpected.size() * sizeof(T)) == 0);
+}
+
+TEST_CASE(ModelCacheRoundTripsEveryPartOfTheModel)
+{
+    const std::filesystem::path directory = getCacheDirectory(L"RoundTrip");
+    const std::filesystem::path dependencyPath = directory / L"model.mtl";
+    writeFile(dependencyPath, "newmtl Default\n");
+    ModelCache::SetCacheDirectory(directory / L"Cache");
+
+    const CookedModel model = makeModel(dependencyPath);
+    CHECK_EQUAL(S_OK, ModelCache::Save(L"Content/model.obj", MODEL_KEY, model));
+
+    CookedModel loaded;
+    CHECK_EQUAL(S_OK, ModelCache::Load(L"Content/model.obj", MODEL_KEY, loaded));
+
+    CHECK(isBytewiseEqual(model.aVertices, loaded.aVertices));
+    CHECK(isBytewiseEqual(model.aNormalData, loaded.aNormalData));
+    CHECK(isBytewiseEqual(model.aAnimationData, loaded.aAnimationData));
+    CHECK(isBytewiseEqual(model.aIndices, loaded.aIndices));
+    CHECK(isBytewiseEqual(model.aMeshes, loaded.aMeshes));
+    CHECK(model.aDependencies == loaded.aDependencies);
+
+    CHECK_EQUAL(model.aMaterials.size(), loaded.aMaterials.size());
+    for (size_t i = 0u; i < model.aMaterials.size() && i < loaded.aMaterials.size(); ++i)
+    {
+        CHECK(model.aMaterials[i].szDiffusePath == loaded.aMaterials[i].szDiffusePath);
+        CHECK(model.aMaterials[i].szSpecularPath == loaded.aMaterials[i].szSpecularPath);
+        CHECK(model.aMaterials[i].szNormalPath == loaded.aMaterials[i].szNormalPath);
+    }
+
+    CHECK_EQUAL(model.aBones.size(), loaded.aBones.size());
+    for (size_t i = 0u; i < model.aBones.size() && i < loaded.aBones.size(); ++i)
+    {
+        CHECK(model.aBones[i].szName == loaded.aBones[i].szName);
+        CHECK(std::memcmp(&model.aBones[i].OffsetMatrix, &loaded.aBones[i].OffsetMatrix, sizeof(XMFLOAT4X4)) == 0);
+    }
+
+    CHECK_EQUAL(model.aNodes.size(), loaded.aNodes.size());
+    for (size_t i = 0u; i < model.aNodes.size() && i < loaded.aNodes.size(); ++i)
+    {
+        CHECK(model.aNodes[i].szName == loaded.aNodes[i].szName);
+        CHECK_EQUAL(model.aNodes[i].iParentIndex, loaded.aNodes[i].iParentIndex);
+        CHECK_EQUAL(model.aNodes[i].iBoneIndex, loaded.aNodes[i].iBoneIndex);
+        CHECK(std::memcmp(&model.aNodes[i].Transformation, &loaded.aNodes[i].Transformation, sizeof(XMFLOAT4X4)) == 0);
+    }
+
+    CHECK_EQUAL(1u, loaded.aAnimations.size());
+    if (loaded.aAnimations.size() == 1u && loaded.aAnimations[0].aChannels.size() == 1u)
+    {
+        const CookedChannel& expected = model.aAnimations[0].aChannels[0];
+        const CookedChannel& actual = loaded.aAnimations[0].aChannels[0];
+        CHECK_EQUAL(model.aAnimations[0].Duration, loaded.aAnimations[0].Duration);
+        CHECK_EQUAL(model.aAnimations[0].TicksPerSecond, loaded.aAnimations[0].TicksPerSecond);
+        CHECK_EQUAL(expected.uNodeIndex, actual.uNodeIndex);
+        CHECK(isBytewiseEqual(expected.aPositionKeys, actual.aPositionKeys));
+        CHECK(isBytewiseEqual(expected.aRotationKeys, actual.aRotationKeys));
+        CHECK(isBytewiseEqual(expected.aScalingKeys, actual.aScalingKeys));
+    }
+    else
+    {
+        CHECK(loaded.aAnimations.size() == 1u && loaded.aAnimations[0].aChannels.size() == 1u);
+    }
+}
+
+TEST_CASE(ModelCacheMissesOnAnotherKey)
+{
+    const std::filesystem::path directory = getCacheDirectory(L"AnotherKey");
+    ModelCache::SetCacheDirectory(directory);
+
+    CHECK_EQUAL(S_OK, ModelCache::Save(L"Content/model.obj", MODEL_KEY, makeModel(directory / L"missing.mtl")));
+
+    CookedModel loaded;
+    CHECK(FAILED(ModelCache::Load(L"Content/model.obj", MODEL_KEY + 1u, loaded)));
+    CHECK(FAILED(ModelCache::Load(L"Content/other.obj", MODEL_KEY, loaded)));
+    CHECK(loaded.aVertices.empty());
+}
+
+TEST_CASE(ModelCacheRejectsEveryTruncation)
+{
+    const std::filesystem::path directory = getCacheDirectory(L"Truncation");
+    ModelCache::SetCacheDirectory(directory);
+
+    CHECK_EQUAL(S_OK, ModelCache::Save(L"Content/model.obj", MODEL_KEY, makeModel(directory / L"missing.mtl")));
+
+    const std::filesystem::path cacheFilePath = getOnlyFile(directory);
+    CHECK(!cacheFilePath.empty());
+    if (cacheFilePath.empty())
+    {
+        return;
+    }
+
+    std::ifstream file(cacheFilePath, std::ios::binary);
+    const std::string szContents((std::istreambuf_iterator<CHAR>(file)), std::istreambuf_iterator<CHAR>());
+    file.close();
+
+    UINT uNumAccepted = 0u;
+    for (size_t uSize = 0u; uSize < szContents.size(); ++uSize)
+    {
+        writeFile(cacheFilePath, szContents.substr(0u, uSize));
+
+        CookedModel loaded;
+        HRESULT hr = ModelCache::Load(L"Content/model.obj", MODEL_KEY, loaded);
+        uNumAccepted += SUCCEEDED(hr) || !loaded.aVertices.empty() || !loaded.aNodes.empty() ? 1u : 0u;
+    }
+    CHECK_EQUAL(0u, uNumAccepted);
+
+    // Trailing bytes are rejected as well
+    writeFile(cacheFilePath, szContents + '\0');
+    CookedModel loaded;
+    CHECK(FAILED(ModelCache::Load(L"Content/model.obj", MODEL_KEY, loaded)));
+}
+
+TEST_CASE(ModelCacheRejectsCorruptedHeaderAndHierarchy)
+{
+    const std::filesystem::path directory = getCacheDirectory(L"Corruption");
+    ModelCache::SetCacheDirectory(directory);
+
+    CHECK_EQUAL(S_OK, ModelCache::Save(L"Content/model.obj", MODEL_KEY, makeModel(directory / L"missing.mtl")));
+
+    const std::filesystem::path cacheFilePath = getOnlyFile(directory);
+    std::ifstream file(cacheFilePath, std::ios::binary);
+    const std::string szContents((std::istreambuf_iterator<CHAR>(file)), std::istreambuf_iterator<CHAR>());
+    file.close();
+
+    // Magic, version and key
+    for (size_t uOffset : { 0u, 4u, 8u })
+    {
+        std::string szCorrupted = szContents;
+        szCorrupted[uOffset] = static_cast<CHAR>(szCorrupted[uOffset] ^ 0x5a);
+        writeFile(cacheFilePath, szCorrupted);
+
+        CookedModel loaded;
+        CHECK(FAILED(ModelCache::Load(L"Content/model.obj", MODEL_KEY, loaded)));
+    }
+
+    // A node that names itself as its parent would make the hierarchy walk read ahead
+    CookedModel model = makeModel(directory / L"missing.mtl");
+    model.aNodes[2].iParentIndex = 2;
+    CHECK_EQUAL(S_OK, ModelCache::Save(L"Content/model.obj", MODEL_KEY, model));
+
+    CookedModel loaded;
+    CHECK(FAILED(ModelCache::Load(L"Content/model.obj", MODEL_KEY, loaded)));
+    CHECK(loaded.aNodes.empty());
+}
+
+TEST_CASE(ModelCacheMissesWhenADependencyChanges)
+{
+    const std::filesystem::path directory = getCacheDirectory(L"Dependency");
+    const std::filesystem::path dependencyPath = directory / L"model.mtl";
+    writeFile(dependencyPath, "newmtl Default\n");
+    ModelCache::SetCacheDirectory(directory / L"Cache");
+
+    CHECK_EQUAL(S_OK, ModelCache::Save(L"Content/model.obj", MODEL_KEY, makeModel(dependencyPath)));
+
+    CookedModel loaded;
+    CHECK_EQUAL(S_OK, ModelCache::Load(L"Content/model.obj", MODEL_KEY, loaded));
+
+    writeFile(dependencyPath, "newmtl Default\nKd 1 0 0\n");
+    CHECK(FAILED(ModelCache::Load(L"Content/model.obj", MODEL_KEY, loaded)));
+    CHECK(loaded.aVertices.empty());
+}
+
+TEST_CASE(ModelCacheKeyChangesWithContentsFlagsAndVariant)
+{
+    const std::filesystem::path directory = getCacheDirectory(L"Key");
+    const std::filesystem::path sourcePath = directory / L"model.obj";
+    writeFile(sourcePath, "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n");
+
+    UINT64 uKey = 0ull;
+    UINT64 uSameKey = 0ull;
+    UINT64 uFlagsKey = 0ull;
+    UINT64 uVariantKey = 0ull;
+    CHECK_EQUAL(S_OK, ModelCache::ComputeKey(sourcePath, 1u, "Model", uKey));
+    CHECK_EQUAL(S_OK, ModelCache::ComputeKey(sourcePath, 1u, "Model", uSameKey));
+    CHECK_EQUAL(S_OK, ModelCache::ComputeKey(sourcePath, 2u, "Model", uFlagsKey));
+    CHECK_EQUAL(S_OK, ModelCache::ComputeKey(sourcePath, 1u, "Skybox", uVariantKey));
+    CHECK_EQUAL(uKey, uSameKey);
+    CHECK(uKey != uFlagsKey);
+    CHECK(uKey != uVariantKey);
+
+    writeFile(sourcePath, "v 0 0 0\nv 2 0 0\nv 0 1 0\nf 1 2 3\n");
+    UINT64 uEditedKey = 0ull;
+    CHECK_EQUAL(S_OK, ModelCache::ComputeKey(sourcePath, 1u, "Model", uEditedKey));
+    CHECK(uKey != uEditedKey);
+
+    UINT64 uMissingKey = 0ull;
+    CHECK(FAILED(ModelCache::ComputeKey(directory / L"missing.obj", 1u, "Model", uMissingKey)));
+}
\ No newline at end of file
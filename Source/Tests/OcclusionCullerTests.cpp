@@ -0,0 +1,146 @@
+#include "Test.h"
+
+#include "Renderer/OcclusionCuller.h"
+
+using namespace library;
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: getView
+
+  Summary:  Returns the view of a camera at the origin looking along
+            +z
+
+  Returns:  XMMATRIX
+              View matrix
+-----------------------------------------------------------------F-F*/
+static XMMATRIX getView()
+{
+    return XMMatrixLookToLH(XMVectorZero(), XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: getProjection
+
+  Summary:  Returns a projection with the aspect of the depth buffer
+
+  Returns:  XMMATRIX
+              Left handed perspective projection
+-----------------------------------------------------------------F-F*/
+static XMMATRIX getProjection()
+{
+    const FLOAT aspect = static_cast<FLOAT>(OcclusionCuller::DEPTH_WIDTH) / static_cast<FLOAT>(OcclusionCuller::DEPTH_HEIGHT);
+
+    return XMMatrixPerspectiveFovLH(XM_PIDIV4, aspect, 0.1f, 1000.0f);
+}
+
+TEST_CASE(HidesBoxesBehindAWall)
+{
+    OcclusionCuller culler(1u);
+    const std::vector<BoundingBox> aOccluders = { BoundingBox(XMFLOAT3(0.0f, 0.0f, 20.0f), XMFLOAT3(100.0f, 100.0f, 1.0f)) };
+    CHECK(SUCCEEDED(culler.Rasterize(getView(), getProjection(), aOccluders)));
+
+    // Only the face towards the camera is rasterized
+    CHECK_EQUAL(2u, culler.GetNumOccluderTriangles());
+
+    const std::vector<BoundingBox> aBounds =
+    {
+        BoundingBox(XMFLOAT3(0.0f, 0.0f, 40.0f), XMFLOAT3(1.0f, 1.0f, 1.0f)),
+        BoundingBox(XMFLOAT3(-8.0f, 3.0f, 40.0f), XMFLOAT3(1.0f, 1.0f, 1.0f)),
+        BoundingBox(XMFLOAT3(8.0f, -3.0f, 60.0f), XMFLOAT3(4.0f, 4.0f, 4.0f)),
+        BoundingBox(XMFLOAT3(0.0f, 0.0f, 10.0f), XMFLOAT3(1.0f, 1.0f, 1.0f)),
+        BoundingBox(XMFLOAT3(2.0f, 1.0f, 15.0f), XMFLOAT3(1.0f, 1.0f, 1.0f)),
+        BoundingBox(XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT3(1.0f, 1.0f, 1.0f)),
+        BoundingBox(XMFLOAT3(0.0f, 0.0f, -10.0f), XMFLOAT3(1.0f, 1.0f, 1.0f))
+    };
+
+    // Behind the wall, in front of it, around the eye and behind the camera
+    const std::vector<BYTE> aExpected = { 0u, 0u, 0u, 1u, 1u, 1u, 0u };
+    std::vector<BYTE> aVisible;
+    CHECK_EQUAL(4u, culler.TestBounds(aBounds, aVisible));
+    CHECK(aVisible == aExpected);
+    CHECK_EQUAL(3u, culler.GetNumVisible());
+    CHECK_EQUAL(4u, culler.GetNumHidden());
+}
+
+TEST_CASE(SeesBoxesAroundASmallOccluder)
+{
+    OcclusionCuller culler(1u);
+    const std::vector<BoundingBox> aOccluders = { BoundingBox(XMFLOAT3(0.0f, 0.0f, 20.0f), XMFLOAT3(2.0f, 2.0f, 1.0f)) };
+    CHECK(SUCCEEDED(culler.Rasterize(getView(), getProjection(), aOccluders)));
+
+    const std::vector<BoundingBox> aBounds =
+    {
+        BoundingBox(XMFLOAT3(0.0f, 0.0f, 40.0f), XMFLOAT3(0.5f, 0.5f, 0.5f)),
+        BoundingBox(XMFLOAT3(10.0f, 0.0f, 40.0f), XMFLOAT3(0.5f, 0.5f, 0.5f)),
+        BoundingBox(XMFLOAT3(0.0f, -10.0f, 40.0f), XMFLOAT3(0.5f, 0.5f, 0.5f)),
+        BoundingBox(XMFLOAT3(0.0f, 0.0f, 40.0f), XMFLOAT3(20.0f, 20.0f, 0.5f))
+    };
+
+    // Only the box straight behind the occluder is hidden, the large one reaches past its edges
+    std::vector<BYTE> aVisible;
+    CHECK_EQUAL(1u, culler.TestBounds(aBounds, aVisible));
+    CHECK(aVisible == std::vector<BYTE>({ 0u, 1u, 1u, 1u }));
+    CHECK_EQUAL(3u, culler.GetNumVisible());
+    CHECK_EQUAL(1u, culler.GetNumHidden());
+}
+
+TEST_CASE(SeesEveryBoxInViewWithoutOccluders)
+{
+    OcclusionCuller culler(1u);
+    CHECK(SUCCEEDED(culler.Rasterize(getView(), getProjection(), std::vector<BoundingBox>())));
+    CHECK_EQUAL(0u, culler.GetNumOccluderTriangles());
+    CHECK_EQUAL(1.0f, culler.GetDepth(OcclusionCuller::DEPTH_WIDTH / 2u, OcclusionCuller::DEPTH_HEIGHT / 2u, 0u));
+
+    const std::vector<BoundingBox> aBounds =
+    {
+        BoundingBox(XMFLOAT3(0.0f, 0.0f, 40.0f), XMFLOAT3(1.0f, 1.0f, 1.0f)),
+        BoundingBox(XMFLOAT3(0.0f, 0.0f, 900.0f), XMFLOAT3(1.0f, 1.0f, 1.0f)),
+        BoundingBox(XMFLOAT3(500.0f, 0.0f, 40.0f), XMFLOAT3(1.0f, 1.0f, 1.0f))
+    };
+
+    std::vector<BYTE> aVisible;
+    CHECK_EQUAL(1u, culler.TestBounds(aBounds, aVisible));
+    CHECK(aVisible == std::vector<BYTE>({ 1u, 1u, 0u }));
+}
+
+TEST_CASE(RasterizesTheSameDepthOnWorkerThreads)
+{
+    // A wall of small boxes, enough for every thread to set up a partition
+    std::vector<BoundingBox> aOccluders;
+    for (UINT y = 0u; y < 16u; ++y)
+    {
+        for (UINT x = 0u; x < 32u; ++x)
+        {
+            aOccluders.push_back(BoundingBox(XMFLOAT3(static_cast<FLOAT>(x) * 2.0f - 31.0f, static_cast<FLOAT>(y) * 2.0f - 15.0f, 20.0f + static_cast<FLOAT>(x % 3u)), XMFLOAT3(1.0f, 1.0f, 1.0f)));
+        }
+    }
+    CHECK(aOccluders.size() >= OcclusionCuller::MIN_OCCLUDERS_PER_THREAD * 4u);
+
+    OcclusionCuller serial(1u);
+    OcclusionCuller parallel(4u);
+    CHECK(SUCCEEDED(serial.Rasterize(getView(), getProjection(), aOccluders)));
+    CHECK(SUCCEEDED(parallel.Rasterize(getView(), getProjection(), aOccluders)));
+    CHECK(serial.GetNumOccluderTriangles() > 0u);
+    CHECK_EQUAL(serial.GetNumOccluderTriangles(), parallel.GetNumOccluderTriangles());
+
+    UINT uNumDifferent = 0u;
+    for (UINT uY = 0u; uY < OcclusionCuller::DEPTH_HEIGHT; ++uY)
+    {
+        for (UINT uX = 0u; uX < OcclusionCuller::DEPTH_WIDTH; ++uX)
+        {
+            uNumDifferent += serial.GetDepth(uX, uY, 0u) == parallel.GetDepth(uX, uY, 0u) ? 0u : 1u;
+        }
+    }
+    CHECK_EQUAL(0u, uNumDifferent);
+
+    const std::vector<BoundingBox> aBounds =
+    {
+        BoundingBox(XMFLOAT3(0.0f, 0.0f, 40.0f), XMFLOAT3(1.0f, 1.0f, 1.0f)),
+        BoundingBox(XMFLOAT3(0.0f, 0.0f, 10.0f), XMFLOAT3(1.0f, 1.0f, 1.0f))
+    };
+    std::vector<BYTE> aSerialVisible;
+    std::vector<BYTE> aParallelVisible;
+    CHECK_EQUAL(1u, serial.TestBounds(aBounds, aSerialVisible));
+    CHECK_EQUAL(1u, parallel.TestBounds(aBounds, aParallelVisible));
+    CHECK(aSerialVisible == aParallelVisible);
+}
\ No newline at end of file
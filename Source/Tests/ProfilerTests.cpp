@@ -0,0 +1,381 @@
+#include "Test.h"
+
+#include "Profiler/Profiler.h"
+
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+using namespace library;
+
+// Threads that record events into the same frame
+constexpr UINT NUM_THREADS = 4u;
+
+// Seconds from the start of a capture to the late event of the trace test, long enough to lose microseconds in a float
+constexpr LONGLONG LATE_EVENT_SECONDS = 3600ll;
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: getFrequency
+
+  Summary:  Returns the performance counter frequency
+
+  Returns:  LONGLONG
+              Ticks per second
+-----------------------------------------------------------------F-F*/
+static LONGLONG getFrequency()
+{
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+
+    return frequency.QuadPart;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: findScope
+
+  Summary:  Returns the aggregate of a scope name
+
+  Args:     const std::vector<ProfilerScopeStats>& aScopes
+              Aggregates of a frame
+            PCSTR pszName
+              Name of the scope
+
+  Returns:  const ProfilerScopeStats*
+              Aggregate of the scope, null if it was not called
+-----------------------------------------------------------------F-F*/
+static const ProfilerScopeStats* findScope(_In_ const std::vector<ProfilerScopeStats>& aScopes, _In_ PCSTR pszName)
+{
+    for (const ProfilerScopeStats& scope : aScopes)
+    {
+        if (std::strcmp(scope.pszName, pszName) == 0)
+        {
+            return &scope;
+        }
+    }
+
+    return nullptr;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: skipJsonValue
+
+  Summary:  Skips one JSON value and the whitespace around it
+
+  Args:     PCSTR& pszJson
+              Start of the value, moved past it
+
+  Returns:  BOOL
+              TRUE if the value is well-formed
+-----------------------------------------------------------------F-F*/
+static BOOL skipJsonValue(_Inout_ PCSTR& pszJson)
+{
+    auto skipSpace = [&pszJson]()
+    {
+        while (*pszJson != '\0' && std::isspace(static_cast<unsigned char>(*pszJson)))
+        {
+            ++pszJson;
+        }
+    };
+    auto skipString = [&pszJson]()
+    {
+        if (*pszJson++ != '"')
+        {
+            return FALSE;
+        }
+        for (; *pszJson != '"'; ++pszJson)
+        {
+            if (*pszJson == '\0' || static_cast<unsigned char>(*pszJson) < 0x20u)
+            {
+                return FALSE;
+            }
+            if (*pszJson == '\\' && std::strchr("\"\\/bfnrtu", *++pszJson) == nullptr)
+            {
+                return FALSE;
+            }
+        }
+        ++pszJson;
+
+        return TRUE;
+    };
+
+    skipSpace();
+    if (*pszJson == '{' || *pszJson == '[')
+    {
+        const CHAR close = *pszJson == '{' ? '}' : ']';
+        const BOOL bObject = *pszJson == '{';
+        ++pszJson;
+        skipSpace();
+        if (*pszJson == close)
+        {
+            ++pszJson;
+            skipSpace();
+            return TRUE;
+        }
+
+        for (;;)
+        {
+            if (bObject)
+            {
+                skipSpace();
+                if (!skipString())
+                {
+                    return FALSE;
+                }
+                skipSpace();
+                if (*pszJson++ != ':')
+                {
+                    return FALSE;
+                }
+            }
+            if (!skipJsonValue(pszJson))
+            {
+                return FALSE;
+            }
+            if (*pszJson == close)
+            {
+                ++pszJson;
+                skipSpace();
+                return TRUE;
+            }
+            if (*pszJson++ != ',')
+            {
+                return FALSE;
+            }
+        }
+    }
+
+    if (*pszJson == '"')
+    {
+        if (!skipString())
+        {
+            return FALSE;
+        }
+    }
+    else if (std::strncmp(pszJson, "true", 4u) == 0 || std::strncmp(pszJson, "null", 4u) == 0)
+    {
+        pszJson += 4;
+    }
+    else if (std::strncmp(pszJson, "false", 5u) == 0)
+    {
+        pszJson += 5;
+    }
+    else
+    {
+        CHAR* pszEnd = nullptr;
+        std::strtod(pszJson, &pszEnd);
+        if (pszEnd == pszJson)
+        {
+            return FALSE;
+        }
+        pszJson = pszEnd;
+    }
+    skipSpace();
+
+    return TRUE;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: getEventNumber
+
+  Summary:  Returns a number of the first trace event with a name
+
+  Args:     const std::string& szJson
+              Trace JSON
+            PCSTR pszName
+              Escaped name of the event
+            PCSTR pszKey
+              Key of the number, such as "ts"
+
+  Returns:  DOUBLE
+              The number, -1 if the event or the key is missing
+-----------------------------------------------------------------F-F*/
+static DOUBLE getEventNumber(_In_ const std::string& szJson, _In_ PCSTR pszName, _In_ PCSTR pszKey)
+{
+    const size_t uEvent = szJson.find(std::string("{\"name\":\"") + pszName + "\"");
+    if (uEvent == std::string::npos)
+    {
+        return -1.0;
+    }
+
+    const size_t uKey = szJson.find(std::string("\"") + pszKey + "\":", uEvent);
+    if (uKey == std::string::npos || uKey > szJson.find('}', uEvent))
+    {
+        return -1.0;
+    }
+
+    return std::strtod(szJson.c_str() + uKey + std::strlen(pszKey) + 3u, nullptr);
+}
+
+TEST_CASE(ProfilerRingWrapsAndCountsDroppedEvents)
+{
+    Profiler::Reset();
+
+    // Fill the ring past its capacity before it is read
+    for (UINT i = 0u; i < Profiler::RING_CAPACITY + 10u; ++i)
+    {
+        Profiler::RecordEvent("Fill", static_cast<LONGLONG>(i), static_cast<LONGLONG>(i) + 1ll);
+    }
+    CHECK_EQUAL(10u, Profiler::GetNumDroppedEvents());
+
+    Profiler::EndFrame();
+    CHECK_EQUAL(static_cast<size_t>(Profiler::RING_CAPACITY), Profiler::GetFrames().back().aEvents.size());
+
+    // The indices are past the capacity now, so these events wrap around the ring
+    for (UINT i = 0u; i < 100u; ++i)
+    {
+        Profiler::RecordEvent("Wrapped", static_cast<LONGLONG>(i), static_cast<LONGLONG>(i) + 2ll);
+    }
+    Profiler::EndFrame();
+
+    const std::vector<ProfilerEvent>& aEvents = Profiler::GetFrames().back().aEvents;
+    CHECK_EQUAL(100u, aEvents.size());
+    for (UINT i = 0u; i < aEvents.size(); ++i)
+    {
+        CHECK(std::strcmp(aEvents[i].pszName, "Wrapped") == 0);
+        CHECK_EQUAL(static_cast<LONGLONG>(i), aEvents[i].llStart);
+        CHECK_EQUAL(static_cast<LONGLONG>(i) + 2ll, aEvents[i].llEnd);
+    }
+    CHECK_EQUAL(10u, Profiler::GetNumDroppedEvents());
+}
+
+TEST_CASE(ProfilerSumsScopesOfEveryThread)
+{
+    Profiler::Reset();
+
+    const LONGLONG llTicksPerMs = getFrequency() / 1000ll;
+    std::vector<std::thread> aThreads;
+    for (UINT i = 0u; i < NUM_THREADS; ++i)
+    {
+        aThreads.emplace_back(
+            [llTicksPerMs, i]()
+            {
+                Profiler::RecordEvent("Record", 0ll, llTicksPerMs * static_cast<LONGLONG>(i + 1u));
+                Profiler::RecordEvent("Record", 0ll, llTicksPerMs);
+            }
+        );
+    }
+    for (std::thread& thread : aThreads)
+    {
+        thread.join();
+    }
+    Profiler::RecordEvent("Submit", 0ll, llTicksPerMs * 5ll);
+
+    Profiler::RecordGpuEvent(ProfilerGpuEvent{ .pszName = "Shadows", .startMs = 0.0f, .durationMs = 1.5f });
+    Profiler::RecordGpuEvent(ProfilerGpuEvent{ .pszName = "Shadows", .startMs = 2.0f, .durationMs = 0.5f });
+    Profiler::EndFrame();
+
+    const ProfilerFrame& frame = Profiler::GetFrames().back();
+    CHECK_EQUAL(2u * NUM_THREADS + 1u, frame.aEvents.size());
+
+    const ProfilerScopeStats* pRecord = findScope(frame.aScopes, "Record");
+    CHECK(pRecord != nullptr);
+    if (pRecord)
+    {
+        // 1 + 2 + 3 + 4 ms of the first events and 1 ms for each second event
+        CHECK_EQUAL(2u * NUM_THREADS, pRecord->uNumCalls);
+        CHECK_CLOSE(14.0f, pRecord->totalMs, 0.01f);
+        CHECK_CLOSE(4.0f, pRecord->maxMs, 0.01f);
+    }
+
+    const ProfilerScopeStats* pSubmit = findScope(frame.aScopes, "Submit");
+    CHECK(pSubmit != nullptr && pSubmit->uNumCalls == 1u);
+
+    const ProfilerScopeStats* pShadows = findScope(frame.aGpuScopes, "Shadows");
+    CHECK(pShadows != nullptr);
+    if (pShadows)
+    {
+        CHECK_EQUAL(2u, pShadows->uNumCalls);
+        CHECK_CLOSE(2.0f, pShadows->totalMs, 0.0001f);
+        CHECK_CLOSE(1.5f, pShadows->maxMs, 0.0001f);
+    }
+
+    // The GPU events were collected by this frame only
+    Profiler::EndFrame();
+    CHECK(Profiler::GetFrames().back().aGpuEvents.empty());
+    CHECK(Profiler::GetFrames().back().aEvents.empty());
+}
+
+TEST_CASE(ProfilerKeepsTheLastFrames)
+{
+    Profiler::Reset();
+
+    for (UINT i = 0u; i < Profiler::MAX_FRAMES + 5u; ++i)
+    {
+        Profiler::EndFrame();
+    }
+
+    const std::deque<ProfilerFrame>& aFrames = Profiler::GetFrames();
+    CHECK_EQUAL(static_cast<size_t>(Profiler::MAX_FRAMES), aFrames.size());
+    for (size_t i = 1u; i < aFrames.size(); ++i)
+    {
+        CHECK_EQUAL(aFrames[i - 1u].uFrameIndex + 1u, aFrames[i].uFrameIndex);
+        CHECK_EQUAL(aFrames[i - 1u].llEnd, aFrames[i].llStart);
+    }
+}
+
+TEST_CASE(ProfilerResetDrainsTheRings)
+{
+    Profiler::Reset();
+
+    for (UINT i = 0u; i < Profiler::RING_CAPACITY + 1u; ++i)
+    {
+        Profiler::RecordEvent("Stale", 0ll, 1ll);
+    }
+    std::thread([]() { Profiler::RecordEvent("StaleWorker", 0ll, 1ll); }).join();
+    Profiler::RecordGpuEvent(ProfilerGpuEvent{ .pszName = "StaleGpu", .startMs = 0.0f, .durationMs = 1.0f });
+    CHECK_EQUAL(1u, Profiler::GetNumDroppedEvents());
+
+    Profiler::Reset();
+    CHECK(Profiler::GetFrames().empty());
+    CHECK_EQUAL(0u, Profiler::GetNumDroppedEvents());
+
+    Profiler::RecordEvent("Fresh", 0ll, 1ll);
+    Profiler::EndFrame();
+
+    const ProfilerFrame& frame = Profiler::GetFrames().back();
+    CHECK_EQUAL(1u, frame.aEvents.size());
+    CHECK(frame.aEvents.size() == 1u && std::strcmp(frame.aEvents[0].pszName, "Fresh") == 0);
+    CHECK(frame.aGpuEvents.empty());
+}
+
+TEST_CASE(ProfilerExportsWellFormedChromeTrace)
+{
+    Profiler::Reset();
+
+    Profiler::EndFrame();
+    const LONGLONG llOrigin = Profiler::GetFrames().front().llStart;
+    const LONGLONG llFrequency = getFrequency();
+
+    // One microsecond past an hour, a float has 256 microsecond steps there
+    const LONGLONG llLateStart = llOrigin + LATE_EVENT_SECONDS * llFrequency + llFrequency / 1000000ll;
+    Profiler::RecordEvent("Late", llLateStart, llLateStart + llFrequency / 1000ll);
+    Profiler::RecordEvent("Quoted \"name\" with \\", llOrigin, llOrigin + 1ll);
+    Profiler::RecordGpuEvent(ProfilerGpuEvent{ .pszName = "GpuPass", .startMs = 0.25f, .durationMs = 0.5f });
+    Profiler::EndFrame();
+
+    const std::filesystem::path tracePath = std::filesystem::temp_directory_path() / L"ProfilerTrace.json";
+    CHECK_EQUAL(S_OK, Profiler::ExportChromeTrace(tracePath));
+
+    std::ifstream file(tracePath, std::ios::binary);
+    std::stringstream stream;
+    stream << file.rdbuf();
+    const std::string szJson = stream.str();
+
+    PCSTR pszJson = szJson.c_str();
+    CHECK(skipJsonValue(pszJson));
+    CHECK(*pszJson == '\0');
+
+    CHECK(szJson.find("\"Quoted \\\"name\\\" with \\\\\"") != std::string::npos);
+
+    const DOUBLE expectedLateTs = static_cast<DOUBLE>(LATE_EVENT_SECONDS) * 1000000.0 + 1.0;
+    CHECK_CLOSE(expectedLateTs, getEventNumber(szJson, "Late", "ts"), 0.01);
+    CHECK_CLOSE(1000.0, getEventNumber(szJson, "Late", "dur"), 0.01);
+
+    // GPU events are placed relative to the start of the frame that collected them
+    const DOUBLE secondFrameTs = static_cast<DOUBLE>(Profiler::GetFrames().back().llStart - llOrigin) * 1000000.0 / static_cast<DOUBLE>(llFrequency);
+    CHECK_CLOSE(secondFrameTs + 250.0, getEventNumber(szJson, "GpuPass", "ts"), 0.01);
+    CHECK_CLOSE(500.0, getEventNumber(szJson, "GpuPass", "dur"), 0.01);
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include "Test.h"
+
+#include "Renderer/RecordingRenderContext.h"
+
+using namespace library;
+
+TEST_CASE(CountsTrianglesByTopology)
+{
+    RecordingRenderContext context;
+
+    context.IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    context.DrawIndexed(36u, 0u, 0);
+    context.DrawIndexedInstanced(6u, 10u, 0u, 0, 0u);
+
+    context.IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
+    context.Draw(4u, 0u);
+
+    context.IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED);
+    context.Draw(3u, 0u);
+
+    const RenderStats& stats = context.GetStats();
+    CHECK_EQUAL(4u, stats.uNumDrawCalls);
+    CHECK_EQUAL(13ull, stats.uNumInstances);
+    CHECK_EQUAL(12ull + 20ull + 2ull, stats.uNumTriangles);
+    CHECK_EQUAL(4u, context.GetNumDrawCalls());
+    CHECK_EQUAL(36ull + 60ull, context.GetNumIndices());
+}
+
+TEST_CASE(CountsBoundObjectsAndUploadedBytes)
+{
+    RecordingRenderContext context;
+
+    ID3D11Buffer* const apBuffers[3] = { nullptr, nullptr, nullptr };
+    ID3D11ShaderResourceView* const apViews[2] = { nullptr, nullptr };
+    ID3D11SamplerState* const pSampler = nullptr;
+    context.VSSetShader(nullptr, nullptr, 0u);
+    context.PSSetShader(nullptr, nullptr, 0u);
+    context.VSSetConstantBuffers(0u, 3u, apBuffers);
+    context.PSSetConstantBuffers(2u, 1u, apBuffers);
+    context.PSSetShaderResources(0u, 2u, apViews);
+    context.PSSetSamplers(0u, 1u, &pSampler);
+
+    const BYTE aData[256] = {};
+    context.UpdateConstantBuffer(nullptr, aData, 64u);
+    CHECK(SUCCEEDED(context.UpdateDynamicConstantBuffer(nullptr, 0u, aData, 256u, TRUE)));
+
+    const RenderStats& stats = context.GetStats();
+    CHECK_EQUAL(2u, stats.uNumShaderBinds);
+    CHECK_EQUAL(4u, stats.uNumConstantBufferBinds);
+    CHECK_EQUAL(2u, stats.uNumShaderResourceBinds);
+    CHECK_EQUAL(1u, stats.uNumSamplerBinds);
+    CHECK_EQUAL(2u, stats.uNumUploads);
+    CHECK_EQUAL(320ull, stats.uNumUploadedBytes);
+    CHECK_EQUAL(320ull, context.GetNumUploadedBytes());
+}
+
+TEST_CASE(RecordsCommandsInOrder)
+{
+    RecordingRenderContext context;
+
+    ID3D11ShaderResourceView* const apViews[2] = { nullptr, nullptr };
+    context.PSSetShaderResources(4u, 2u, apViews);
+    context.IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    context.DrawIndexedInstanced(6u, 3u, 0u, 0, 0u);
+
+    const std::vector<RecordedRenderCommand>& aCommands = context.GetCommands();
+    CHECK_EQUAL(3u, aCommands.size());
+    if (aCommands.size() == 3u)
+    {
+        CHECK(aCommands[0].Command == eRenderCommand::SET_PIXEL_SHADER_RESOURCES);
+        CHECK_EQUAL(4u, aCommands[0].uStart);
+        CHECK_EQUAL(2u, aCommands[0].uCount);
+        CHECK(aCommands[1].Command == eRenderCommand::SET_PRIMITIVE_TOPOLOGY);
+        CHECK(aCommands[2].Command == eRenderCommand::DRAW_INDEXED_INSTANCED);
+        CHECK_EQUAL(6u, aCommands[2].uCount);
+        CHECK_EQUAL(3u, aCommands[2].uNumInstances);
+    }
+    CHECK_EQUAL(1u, context.GetNumCalls(eRenderCommand::SET_PIXEL_SHADER_RESOURCES));
+}
+
+TEST_CASE(KeepsCountersWithoutCommandLog)
+{
+    RecordingRenderContext context;
+    context.SetCommandLogEnabled(FALSE);
+
+    context.IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    context.DrawIndexed(3u, 0u, 0);
+
+    CHECK(context.GetCommands().empty());
+    CHECK_EQUAL(1u, context.GetNumDrawCalls());
+    CHECK_EQUAL(1ull, context.GetStats().uNumTriangles);
+}
+
+TEST_CASE(ResetAndAddStats)
+{
+    RecordingRenderContext worker;
+    worker.IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    worker.DrawIndexed(30u, 0u, 0);
+
+    RecordingRenderContext context;
+    context.IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    context.DrawIndexed(3u, 0u, 0);
+    context.AddStats(worker.GetStats());
+    CHECK_EQUAL(2u, context.GetStats().uNumDrawCalls);
+    CHECK_EQUAL(11ull, context.GetStats().uNumTriangles);
+
+    context.Reset();
+    CHECK(context.GetCommands().empty());
+    CHECK_EQUAL(0u, context.GetNumDrawCalls());
+    CHECK_EQUAL(0u, context.GetStats().uNumDrawCalls);
+    CHECK_EQUAL(0ull, context.GetStats().uNumTriangles);
+}
\ No newline at end of file
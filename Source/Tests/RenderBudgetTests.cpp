@@ -0,0 +1,245 @@
+#include "Test.h"
+
+#include "Light/PointLight.h"
+#include "Renderer/MockCommandRecorder.h"
+#include "Renderer/RecordingRenderContext.h"
+#include "Renderer/Renderable.h"
+#include "Renderer/Renderer.h"
+#include "Scene/Scene.h"
+#include "Shader/PixelShader.h"
+#include "Shader/ShadowVertexShader.h"
+#include "Shader/VertexShader.h"
+
+#include <fstream>
+
+using namespace library;
+
+// Cubes of the budget scene, every one is in view and lit by both lights
+constexpr UINT NUM_CUBES = 16u;
+
+// Budgets of a frame: one scene draw and one draw per shadow map for every cube, with room for the fullscreen passes
+constexpr UINT MAX_DRAW_CALLS = NUM_CUBES * (1u + NUM_LIGHTS) + 2u;
+constexpr UINT MAX_STATIC_DRAW_CALLS = NUM_CUBES + 2u;
+constexpr UINT MAX_UPLOADS = 1u;
+
+// Cubes of the recorded scene, enough for the command recorder to split the scene pass
+constexpr UINT NUM_RECORDED_CUBES = 4u * CommandRecorder::MIN_ITEMS_PER_CONTEXT;
+
+// Contexts of the command recorder of the recorded scene
+constexpr UINT NUM_RECORDER_CONTEXTS = 4u;
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+  Class:    BudgetCube
+
+  Summary:  Renderable with the index count of a cube and no GPU
+            buffers, the headless renderer only records its draws
+
+  Methods:  Initialize
+              Does nothing.
+            Update
+              Does nothing.
+            GetNumVertices
+              Returns the number of vertices of a cube
+            GetNumIndices
+              Returns the number of indices of a cube
+            BudgetCube
+              Constructor.
+            ~BudgetCube
+              Destructor.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class BudgetCube final : public Renderable
+{
+public:
+    BudgetCube()
+        : Renderable(XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f))
+    {
+        // empty
+    }
+
+    BudgetCube(const BudgetCube& other) = delete;
+    BudgetCube(BudgetCube&& other) = delete;
+    BudgetCube& operator=(const BudgetCube& other) = delete;
+    BudgetCube& operator=(BudgetCube&& other) = delete;
+    ~BudgetCube() = default;
+
+    HRESULT Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext) override
+    {
+        UNREFERENCED_PARAMETER(pDevice);
+        UNREFERENCED_PARAMETER(pImmediateContext);
+
+        return S_OK;
+    }
+
+    void Update(_In_ FLOAT deltaTime) override
+    {
+        UNREFERENCED_PARAMETER(deltaTime);
+    }
+
+    UINT GetNumVertices() const override
+    {
+        return 24u;
+    }
+
+    UINT GetNumIndices() const override
+    {
+        return 36u;
+    }
+
+protected:
+    const SimpleVertex* getVertices() const override
+    {
+        return nullptr;
+    }
+
+    const WORD* getIndices() const override
+    {
+        return nullptr;
+    }
+};
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: createBudgetScene
+
+  Summary:  Creates a scene of rows of four cubes in front of the
+            camera and two point lights above them. The shaders are
+            never compiled, the recorded draws bind null shaders
+
+  Args:     UINT uNumCubes
+              Number of cubes
+
+  Returns:  std::shared_ptr<Scene>
+              The scene, without voxels or a skybox
+-----------------------------------------------------------------F-F*/
+static std::shared_ptr<Scene> createBudgetScene(_In_ UINT uNumCubes)
+{
+    // An empty height map leaves the scene without voxels
+    const std::filesystem::path heightMapPath = std::filesystem::temp_directory_path() / L"BudgetHeightMap.txt";
+    std::ofstream(heightMapPath).close();
+    std::shared_ptr<Scene> scene = std::make_shared<Scene>(heightMapPath);
+
+    CHECK(SUCCEEDED(scene->AddPointLight(0u, std::make_shared<PointLight>(XMFLOAT4(-4.0f, 6.0f, 4.0f, 1.0f), XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f), 50.0f))));
+    CHECK(SUCCEEDED(scene->AddPointLight(1u, std::make_shared<PointLight>(XMFLOAT4(4.0f, 6.0f, 4.0f, 1.0f), XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f), 50.0f))));
+
+    std::shared_ptr<VertexShader> vertexShader = std::make_shared<VertexShader>(L"Shaders/PhongShaders.fxh", "VSPhong", "vs_5_0");
+    std::shared_ptr<PixelShader> pixelShader = std::make_shared<PixelShader>(L"Shaders/PhongShaders.fxh", "PSPhong", "ps_5_0");
+    for (UINT i = 0u; i < uNumCubes; ++i)
+    {
+        std::shared_ptr<BudgetCube> cube = std::make_shared<BudgetCube>();
+        cube->SetVertexShader(vertexShader);
+        cube->SetPixelShader(pixelShader);
+        cube->Translate(XMVectorSet(static_cast<FLOAT>(i % 4u) * 2.0f - 3.0f, 0.0f, static_cast<FLOAT>(i / 4u) * 2.0f + 2.0f, 0.0f));
+
+        const std::wstring szName = L"BudgetCube" + std::to_wstring(i);
+        CHECK(SUCCEEDED(scene->AddRenderable(szName.c_str(), cube)));
+    }
+
+    return scene;
+}
+
+TEST_CASE(RendersFrameWithinBudget)
+{
+    Renderer renderer;
+    CHECK(SUCCEEDED(renderer.AddScene(L"Budget", createBudgetScene(NUM_CUBES))));
+    CHECK(SUCCEEDED(renderer.SetMainScene(L"Budget")));
+    renderer.SetShadowMapVertexShader(std::make_shared<ShadowVertexShader>(L"Shaders/ShadowShaders.fxh", "VSShadow", "vs_5_0"));
+    CHECK(SUCCEEDED(renderer.InitializeHeadless(800u, 600u)));
+
+    RecordingRenderContext context;
+    renderer.Update(0.0f);
+    renderer.RenderHeadless(&context);
+
+    const RenderStats& stats = renderer.GetRenderStats();
+    CHECK_EQUAL(NUM_CUBES, stats.uNumSubmittedObjects);
+    CHECK_EQUAL(0u, stats.uNumCulledObjects);
+    CHECK(stats.uNumDrawCalls >= NUM_CUBES);
+    CHECK(stats.uNumDrawCalls <= MAX_DRAW_CALLS);
+    CHECK(stats.uNumShadowMapUpdates <= static_cast<UINT>(NUM_LIGHTS));
+    CHECK(stats.uNumUploads <= MAX_UPLOADS);
+}
+
+TEST_CASE(RendersUnchangedFrameWithoutUploads)
+{
+    Renderer renderer;
+    CHECK(SUCCEEDED(renderer.AddScene(L"Budget", createBudgetScene(NUM_CUBES))));
+    CHECK(SUCCEEDED(renderer.SetMainScene(L"Budget")));
+    renderer.SetShadowMapVertexShader(std::make_shared<ShadowVertexShader>(L"Shaders/ShadowShaders.fxh", "VSShadow", "vs_5_0"));
+    CHECK(SUCCEEDED(renderer.InitializeHeadless(800u, 600u)));
+
+    RecordingRenderContext context;
+    renderer.Update(0.0f);
+    renderer.RenderHeadless(&context);
+
+    // Nothing moved, every constant is retained and no shadow map is stale
+    renderer.RenderHeadless(&context);
+
+    const RenderStats& stats = renderer.GetRenderStats();
+    CHECK_EQUAL(0u, stats.uNumUploads);
+    CHECK_EQUAL(0ull, stats.uNumUploadedBytes);
+    CHECK_EQUAL(0u, stats.uNumShadowMapUpdates);
+    CHECK(stats.uNumDrawCalls >= NUM_CUBES);
+    CHECK(stats.uNumDrawCalls <= MAX_STATIC_DRAW_CALLS);
+    CHECK(stats.uNumRetainedBytes > 0ull);
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: renderRecordedScene
+
+  Summary:  Records a headless frame of the recorded scene
+
+  Args:     std::unique_ptr<CommandRecorder> commandRecorder
+              Command recorder of the renderer, null to record every
+              draw on the immediate context
+            RecordingRenderContext& context
+              Immediate context to record the frame to
+
+  Returns:  UINT
+              Number of draw calls of the frame
+-----------------------------------------------------------------F-F*/
+static UINT renderRecordedScene(_In_ std::unique_ptr<CommandRecorder> commandRecorder, _Inout_ RecordingRenderContext& context)
+{
+    Renderer renderer;
+    renderer.SetCommandRecorder(std::move(commandRecorder));
+    CHECK(SUCCEEDED(renderer.AddScene(L"Recorded", createBudgetScene(NUM_RECORDED_CUBES))));
+    CHECK(SUCCEEDED(renderer.SetMainScene(L"Recorded")));
+    renderer.SetShadowMapVertexShader(std::make_shared<ShadowVertexShader>(L"Shaders/ShadowShaders.fxh", "VSShadow", "vs_5_0"));
+    CHECK(SUCCEEDED(renderer.InitializeHeadless(800u, 600u)));
+
+    renderer.Update(0.0f);
+    renderer.RenderHeadless(&context);
+
+    return renderer.GetRenderStats().uNumDrawCalls;
+}
+
+TEST_CASE(RecordsTheSameDrawsThroughACommandRecorder)
+{
+    RecordingRenderContext immediateContext;
+    const UINT uNumDrawCalls = renderRecordedScene(nullptr, immediateContext);
+    CHECK(uNumDrawCalls >= NUM_RECORDED_CUBES);
+
+    std::unique_ptr<MockCommandRecorder> commandRecorder = std::make_unique<MockCommandRecorder>(NUM_RECORDER_CONTEXTS);
+    MockCommandRecorder* pCommandRecorder = commandRecorder.get();
+
+    RecordingRenderContext context;
+    CHECK_EQUAL(uNumDrawCalls, renderRecordedScene(std::move(commandRecorder), context));
+    CHECK(context.GetNumCalls(eRenderCommand::EXECUTE_COMMAND_LIST) >= NUM_RECORDER_CONTEXTS);
+    CHECK(context.GetNumDrawCalls() < uNumDrawCalls);
+    CHECK_EQUAL(0u, pCommandRecorder->GetNumRecorded());
+}
+
+TEST_CASE(DrawsOnTheImmediateContextWhenRecordingFails)
+{
+    RecordingRenderContext immediateContext;
+    const UINT uNumDrawCalls = renderRecordedScene(nullptr, immediateContext);
+
+    std::unique_ptr<MockCommandRecorder> commandRecorder = std::make_unique<MockCommandRecorder>(NUM_RECORDER_CONTEXTS);
+    commandRecorder->SetEndRecordingResult(1u, E_FAIL);
+    MockCommandRecorder* pCommandRecorder = commandRecorder.get();
+
+    // Every split pass is recorded, dropped and drawn again on the immediate context
+    RecordingRenderContext context;
+    CHECK_EQUAL(uNumDrawCalls, renderRecordedScene(std::move(commandRecorder), context));
+    CHECK_EQUAL(uNumDrawCalls, context.GetNumDrawCalls());
+    CHECK_EQUAL(0u, context.GetNumCalls(eRenderCommand::EXECUTE_COMMAND_LIST));
+    CHECK(!pCommandRecorder->GetEvents().empty());
+    CHECK_EQUAL(0u, pCommandRecorder->GetNumRecorded());
+}
\ No newline at end of file
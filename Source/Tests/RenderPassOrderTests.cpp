@@ -0,0 +1,125 @@
+#include "Test.h"
+
+#include "Light/PointLight.h"
+#include "Renderer/RecordingRenderContext.h"
+#include "Renderer/Renderer.h"
+#include "Scene/Scene.h"
+#include "Shader/FullscreenVertexShader.h"
+#include "Shader/PixelShader.h"
+#include "Shader/ShadowVertexShader.h"
+
+#include <algorithm>
+#include <fstream>
+
+using namespace library;
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: createEmptyScene
+
+  Summary:  Creates a scene of only the point lights, which the
+            headless renderer needs to set up its shadow maps
+
+  Returns:  std::shared_ptr<Scene>
+              The scene, without voxels, objects or a skybox
+-----------------------------------------------------------------F-F*/
+static std::shared_ptr<Scene> createEmptyScene()
+{
+    // An empty height map leaves the scene without voxels
+    const std::filesystem::path heightMapPath = std::filesystem::temp_directory_path() / L"PassOrderHeightMap.txt";
+    std::ofstream(heightMapPath).close();
+    std::shared_ptr<Scene> scene = std::make_shared<Scene>(heightMapPath);
+
+    for (UINT i = 0u; i < NUM_LIGHTS; ++i)
+    {
+        CHECK(SUCCEEDED(scene->AddPointLight(i, std::make_shared<PointLight>(XMFLOAT4(0.0f, 6.0f, 0.0f, 1.0f), XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f), 50.0f))));
+    }
+
+    return scene;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: renderPassOrder
+
+  Summary:  Records a headless frame of an empty scene and returns
+            the passes it ran
+
+  Args:     Renderer& renderer
+              Renderer with its render path and depth pre-pass set,
+              not yet initialized
+
+  Returns:  std::vector<std::wstring>
+              Names of the executed passes, in the order they ran
+-----------------------------------------------------------------F-F*/
+static std::vector<std::wstring> renderPassOrder(_In_ Renderer& renderer)
+{
+    CHECK(SUCCEEDED(renderer.AddScene(L"PassOrder", createEmptyScene())));
+    CHECK(SUCCEEDED(renderer.SetMainScene(L"PassOrder")));
+    renderer.SetShadowMapVertexShader(std::make_shared<ShadowVertexShader>(L"Shaders/ShadowShaders.fxh", "VSShadow", "vs_5_0"));
+    CHECK(SUCCEEDED(renderer.InitializeHeadless(800u, 600u)));
+
+    RecordingRenderContext context;
+    renderer.Update(0.0f);
+    renderer.RenderHeadless(&context);
+
+    std::vector<std::wstring> aszPasses;
+    for (const FrameGraphTraceEntry& entry : renderer.GetFrameGraph().GetTrace())
+    {
+        if (entry.Event == eFrameGraphTraceEvent::EXECUTE_PASS)
+        {
+            aszPasses.push_back(entry.szName);
+        }
+    }
+
+    return aszPasses;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: getPosition
+
+  Summary:  Returns where a pass is in a pass order
+
+  Args:     const std::vector<std::wstring>& aszPasses
+              Names of the passes in the order they ran
+            PCWSTR pszName
+              Name of the pass
+
+  Returns:  size_t
+              Position of the pass, the size of the order if it did
+              not run
+-----------------------------------------------------------------F-F*/
+static size_t getPosition(_In_ const std::vector<std::wstring>& aszPasses, _In_ PCWSTR pszName)
+{
+    return static_cast<size_t>(std::find(aszPasses.begin(), aszPasses.end(), pszName) - aszPasses.begin());
+}
+
+TEST_CASE(RendersTheDepthPrepassBeforeTheEqualDepthPasses)
+{
+    Renderer renderer;
+    renderer.SetDepthPrepass(TRUE, TRUE);
+
+    const std::vector<std::wstring> aszPasses = renderPassOrder(renderer);
+    const size_t uDepthPrepass = getPosition(aszPasses, L"DepthPrepass");
+    CHECK(getPosition(aszPasses, L"BeginScene") < uDepthPrepass);
+    CHECK(uDepthPrepass < getPosition(aszPasses, L"Voxels"));
+    CHECK(getPosition(aszPasses, L"Voxels") < getPosition(aszPasses, L"Models"));
+    CHECK(getPosition(aszPasses, L"Models") < aszPasses.size());
+}
+
+TEST_CASE(RendersTheDeferredPathInOrder)
+{
+    Renderer renderer;
+    renderer.SetRenderPath(eRenderPath::DEFERRED);
+    renderer.SetDeferredShaders(
+        std::make_shared<PixelShader>(L"Shaders/VoxelShaders.fxh", "PSVoxelGBuffer", "ps_5_0"),
+        std::make_shared<FullscreenVertexShader>(L"Shaders/DeferredShaders.fxh", "VSDeferredLighting", "vs_5_0"),
+        std::make_shared<PixelShader>(L"Shaders/DeferredShaders.fxh", "PSDeferredLighting", "ps_5_0")
+    );
+
+    const std::vector<std::wstring> aszPasses = renderPassOrder(renderer);
+    const std::vector<std::wstring> aszScenePasses = { L"BeginScene", L"DepthPrepass", L"GBuffer", L"DeferredLighting", L"Renderables", L"Models", L"Skybox" };
+    for (size_t i = 1u; i < aszScenePasses.size(); ++i)
+    {
+        CHECK(getPosition(aszPasses, aszScenePasses[i].c_str()) < aszPasses.size());
+        CHECK(getPosition(aszPasses, aszScenePasses[i - 1u].c_str()) < getPosition(aszPasses, aszScenePasses[i].c_str()));
+    }
+}
\ No newline at end of file
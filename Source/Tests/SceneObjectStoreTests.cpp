@@ -0,0 +1,245 @@
+#include "Test.h"
+
+#include "Scene/SceneObjectStore.h"
+
+#include <algorithm>
+
+using namespace library;
+
+// Objects of each store, enough to remove from the front, the middle and the back
+constexpr UINT NUM_OBJECTS = 5u;
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+  Class:    StoreObject
+
+  Summary:  Object with the interface the store needs. Moving it
+            bumps its version, as Renderable does
+
+  Methods:  Update
+              Counts the update
+            MoveTo
+              Moves the object and bumps its version
+            MoveWithoutVersion
+              Moves the object without bumping its version
+            GetVersion
+              Returns the version
+            GetWorldMatrix
+              Returns the world matrix
+            GetLocalBounds
+              Returns the unit box
+            GetNumUpdates
+              Returns the number of updates
+            StoreObject
+              Constructor.
+            ~StoreObject
+              Destructor.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class StoreObject final
+{
+public:
+    StoreObject(_In_ FLOAT x)
+        : m_world(XMMatrixTranslation(x, 0.0f, 0.0f))
+        , m_uVersion(1u)
+        , m_uNumUpdates(0u)
+        , m_localBounds()
+    {
+        // empty
+    }
+
+    StoreObject(const StoreObject& other) = delete;
+    StoreObject(StoreObject&& other) = delete;
+    StoreObject& operator=(const StoreObject& other) = delete;
+    StoreObject& operator=(StoreObject&& other) = delete;
+    ~StoreObject() = default;
+
+    void Update(_In_ FLOAT deltaTime)
+    {
+        UNREFERENCED_PARAMETER(deltaTime);
+
+        ++m_uNumUpdates;
+    }
+
+    void MoveTo(_In_ FLOAT x)
+    {
+        MoveWithoutVersion(x);
+        ++m_uVersion;
+    }
+
+    void MoveWithoutVersion(_In_ FLOAT x)
+    {
+        m_world = XMMatrixTranslation(x, 0.0f, 0.0f);
+    }
+
+    UINT64 GetVersion() const
+    {
+        return m_uVersion;
+    }
+
+    const XMMATRIX& GetWorldMatrix() const
+    {
+        return m_world;
+    }
+
+    const BoundingBox& GetLocalBounds() const
+    {
+        return m_localBounds;
+    }
+
+    UINT GetNumUpdates() const
+    {
+        return m_uNumUpdates;
+    }
+
+private:
+    XMMATRIX m_world;
+    UINT64 m_uVersion;
+    UINT m_uNumUpdates;
+    BoundingBox m_localBounds;
+};
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: addObjects
+
+  Summary:  Adds objects at x = 0, 1, 2, ... to a store
+
+  Args:     SceneObjectStore<StoreObject>& store
+              Store to add to
+            std::vector<std::shared_ptr<StoreObject>>& aObjects
+              Receives the objects
+            std::vector<SceneObjectHandle>& aHandles
+              Receives their handles
+-----------------------------------------------------------------F-F*/
+static void addObjects(
+    _In_ SceneObjectStore<StoreObject>& store,
+    _Out_ std::vector<std::shared_ptr<StoreObject>>& aObjects,
+    _Out_ std::vector<SceneObjectHandle>& aHandles
+)
+{
+    aObjects.clear();
+    aHandles.clear();
+    for (UINT i = 0u; i < NUM_OBJECTS; ++i)
+    {
+        aObjects.push_back(std::make_shared<StoreObject>(static_cast<FLOAT>(i)));
+        aHandles.push_back(store.Add(aObjects.back()));
+    }
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: getDenseIndex
+
+  Summary:  Returns where an object is in the dense arrays
+
+  Args:     const SceneObjectStore<StoreObject>& store
+              Store of the object
+            const StoreObject* pObject
+              The object
+
+  Returns:  size_t
+              Dense index, the count of the store if it is not there
+-----------------------------------------------------------------F-F*/
+static size_t getDenseIndex(_In_ const SceneObjectStore<StoreObject>& store, _In_ const StoreObject* pObject)
+{
+    const std::vector<StoreObject*>& aObjects = store.GetObjects();
+
+    return static_cast<size_t>(std::find(aObjects.begin(), aObjects.end(), pObject) - aObjects.begin());
+}
+
+TEST_CASE(RemovingAnObjectKeepsTheOtherHandles)
+{
+    SceneObjectStore<StoreObject> store;
+    std::vector<std::shared_ptr<StoreObject>> aObjects;
+    std::vector<SceneObjectHandle> aHandles;
+    addObjects(store, aObjects, aHandles);
+    store.UpdateTransforms();
+
+    // The middle, then the back, then the front
+    for (UINT uRemoved : { NUM_OBJECTS / 2u, NUM_OBJECTS - 1u, 0u })
+    {
+        CHECK_EQUAL(S_OK, store.Remove(aHandles[uRemoved]));
+        aObjects[uRemoved].reset();
+    }
+    CHECK_EQUAL(NUM_OBJECTS - 3u, store.GetCount());
+
+    // Every live handle finds its object, whose dense data moved with it
+    for (UINT i = 0u; i < NUM_OBJECTS; ++i)
+    {
+        if (!aObjects[i])
+        {
+            CHECK(store.Get(aHandles[i]) == nullptr);
+            continue;
+        }
+
+        CHECK(store.Get(aHandles[i]) == aObjects[i].get());
+
+        const size_t uDenseIndex = getDenseIndex(store, aObjects[i].get());
+        CHECK(uDenseIndex < store.GetCount());
+        CHECK_CLOSE(static_cast<FLOAT>(i), store.GetWorldMatrices()[uDenseIndex](3, 0), 0.0001f);
+        CHECK_CLOSE(static_cast<FLOAT>(i), store.GetBounds()[uDenseIndex].Center.x, 0.0001f);
+    }
+
+    CHECK_EQUAL(static_cast<size_t>(store.GetCount()), store.GetWorldMatrices().size());
+    CHECK_EQUAL(static_cast<size_t>(store.GetCount()), store.GetBounds().size());
+}
+
+TEST_CASE(StaleHandlesAreRejected)
+{
+    SceneObjectStore<StoreObject> store;
+    std::vector<std::shared_ptr<StoreObject>> aObjects;
+    std::vector<SceneObjectHandle> aHandles;
+    addObjects(store, aObjects, aHandles);
+
+    const SceneObjectHandle removed = aHandles[1];
+    CHECK_EQUAL(S_OK, store.Remove(removed));
+    CHECK(!store.IsValid(removed));
+    CHECK_EQUAL(E_INVALIDARG, store.Remove(removed));
+
+    // The new object reuses the slot under a new generation
+    std::shared_ptr<StoreObject> reused = std::make_shared<StoreObject>(10.0f);
+    const SceneObjectHandle reusedHandle = store.Add(reused);
+    CHECK_EQUAL(removed.uIndex, reusedHandle.uIndex);
+    CHECK(reusedHandle.uGeneration != removed.uGeneration);
+
+    CHECK(!store.IsValid(removed));
+    CHECK(store.Get(removed) == nullptr);
+    CHECK_EQUAL(E_INVALIDARG, store.Remove(removed));
+    CHECK(store.Get(reusedHandle) == reused.get());
+    CHECK_EQUAL(NUM_OBJECTS, store.GetCount());
+
+    // Handles of slots that were never allocated
+    CHECK(!store.IsValid(SceneObjectHandle{ .uIndex = NUM_OBJECTS + 1u, .uGeneration = 0u }));
+    CHECK(store.Get(SceneObjectHandle{ .uIndex = SceneObjectStore<StoreObject>::INVALID_INDEX, .uGeneration = 0u }) == nullptr);
+}
+
+TEST_CASE(StoreCopiesTransformsOnlyWhenTheVersionChanges)
+{
+    SceneObjectStore<StoreObject> store;
+    std::vector<std::shared_ptr<StoreObject>> aObjects;
+    std::vector<SceneObjectHandle> aHandles;
+    addObjects(store, aObjects, aHandles);
+
+    store.Update(1.0f / 60.0f);
+    for (UINT i = 0u; i < NUM_OBJECTS; ++i)
+    {
+        CHECK_EQUAL(1u, aObjects[i]->GetNumUpdates());
+        CHECK_CLOSE(static_cast<FLOAT>(i), store.GetBounds()[getDenseIndex(store, aObjects[i].get())].Center.x, 0.0001f);
+    }
+
+    // Without a new version the copy stays as it was
+    aObjects[2]->MoveWithoutVersion(20.0f);
+    store.UpdateTransforms();
+    const size_t uDenseIndex = getDenseIndex(store, aObjects[2].get());
+    CHECK_CLOSE(2.0f, store.GetWorldMatrices()[uDenseIndex](3, 0), 0.0001f);
+    CHECK_CLOSE(2.0f, store.GetBounds()[uDenseIndex].Center.x, 0.0001f);
+
+    aObjects[2]->MoveTo(30.0f);
+    store.UpdateTransforms();
+    CHECK_CLOSE(30.0f, store.GetWorldMatrices()[uDenseIndex](3, 0), 0.0001f);
+    CHECK_CLOSE(30.0f, store.GetBounds()[uDenseIndex].Center.x, 0.0001f);
+    CHECK_CLOSE(1.0f, store.GetBounds()[uDenseIndex].Extents.x, 0.0001f);
+
+    // An object moved into the removed slot keeps its own copy
+    CHECK_EQUAL(S_OK, store.Remove(aHandles[0]));
+    store.UpdateTransforms();
+    CHECK_CLOSE(30.0f, store.GetBounds()[getDenseIndex(store, aObjects[2].get())].Center.x, 0.0001f);
+    CHECK_CLOSE(4.0f, store.GetBounds()[getDenseIndex(store, aObjects[4].get())].Center.x, 0.0001f);
+}
\ No newline at end of file
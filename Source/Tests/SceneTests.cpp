@@ -0,0 +1,54 @@
+#include "Test.h"
+
+#include "Model/Model.h"
+#include "Scene/Scene.h"
+
+#include <fstream>
+
+using namespace library;
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: createEmptyScene
+
+  Summary:  Creates a scene without voxels
+
+  Returns:  std::unique_ptr<Scene>
+              The scene
+-----------------------------------------------------------------F-F*/
+static std::unique_ptr<Scene> createEmptyScene()
+{
+    // An empty height map leaves the scene without voxels
+    const std::filesystem::path heightMapPath = std::filesystem::temp_directory_path() / L"EmptyHeightMap.txt";
+    std::ofstream(heightMapPath).close();
+
+    return std::make_unique<Scene>(heightMapPath);
+}
+
+TEST_CASE(SceneFindsObjectsByName)
+{
+    std::unique_ptr<Scene> scene = createEmptyScene();
+
+    // The models are never loaded, the scene only keeps them
+    std::shared_ptr<Model> first = std::make_shared<Model>(L"Content/cyborg/cyborg.obj");
+    std::shared_ptr<Model> second = std::make_shared<Model>(L"Content/Nanosuit/nanosuit.obj");
+    std::shared_ptr<Model> duplicate = std::make_shared<Model>(L"Content/cyborg/cyborg.obj");
+    CHECK_EQUAL(S_OK, scene->AddRenderable(L"First", first));
+    CHECK_EQUAL(S_OK, scene->AddRenderable(L"Second", second));
+
+    // A taken name keeps the object it names
+    CHECK_EQUAL(E_FAIL, scene->AddRenderable(L"First", duplicate));
+    CHECK_EQUAL(2u, scene->GetRenderables().GetCount());
+
+    CHECK(scene->FindRenderable(L"First") == first.get());
+    CHECK(scene->FindRenderable(L"Second") == second.get());
+    CHECK(scene->FindRenderable(L"Third") == nullptr);
+
+    // Models are named apart from the renderables
+    std::shared_ptr<Model> model = std::make_shared<Model>(L"Content/BobLampClean/boblampclean.md5mesh");
+    CHECK_EQUAL(S_OK, scene->AddModel(L"First", model));
+    CHECK_EQUAL(E_FAIL, scene->AddModel(L"First", duplicate));
+    CHECK(scene->FindModel(L"First") == model.get());
+    CHECK(scene->FindRenderable(L"First") == first.get());
+    CHECK(scene->FindModel(L"Second") == nullptr);
+    CHECK_EQUAL(1u, scene->GetModels().GetCount());
+}
\ No newline at end of file
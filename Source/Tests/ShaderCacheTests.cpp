@@ -0,0 +1,199 @@
+#include "Test.h"
+
+#include "Shader/ShaderCache.h"
+
+#include <cstring>
+#include <fstream>
+
+using namespace library;
+
+// Shader that takes its scale from an include, which takes its offset from a nested include
+constexpr CHAR SHADER_SOURCE[] =
+    "#include \"Scale.fxh\"\n"
+    "float4 VSMain(float4 position : POSITION) : SV_POSITION { return Transform(position); }\n";
+constexpr CHAR SCALE_SOURCE[] =
+    "#include \"Offset.fxh\"\n"
+    "#define SCALE 2.0\n"
+    "float4 Transform(float4 position) { return position * SCALE + OFFSET; }\n";
+constexpr CHAR OFFSET_SOURCE[] = "#define OFFSET 1.0\n";
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: writeFile
+
+  Summary:  Replaces the contents of a file
+
+  Args:     const std::filesystem::path& filePath
+              Path to the file
+            const std::string& szContents
+              New contents
+-----------------------------------------------------------------F-F*/
+static void writeFile(_In_ const std::filesystem::path& filePath, _In_ const std::string& szContents)
+{
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    file << szContents;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: writeShader
+
+  Summary:  Writes the test shader and its includes to an empty
+            directory and points the shader cache at a subdirectory
+
+  Args:     PCWSTR pszName
+              Name of the test
+
+  Returns:  std::filesystem::path
+              Path to the shader
+-----------------------------------------------------------------F-F*/
+static std::filesystem::path writeShader(_In_ PCWSTR pszName)
+{
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / L"ShaderCacheTests" / pszName;
+
+    std::error_code errorCode;
+    std::filesystem::remove_all(directory, errorCode);
+    std::filesystem::create_directories(directory, errorCode);
+
+    writeFile(directory / L"Shader.fx", SHADER_SOURCE);
+    writeFile(directory / L"Scale.fxh", SCALE_SOURCE);
+    writeFile(directory / L"Offset.fxh", OFFSET_SOURCE);
+    ShaderCache::SetCacheDirectory(directory / L"Cache");
+
+    return directory / L"Shader.fx";
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: compile
+
+  Summary:  Compiles the test shader through the cache
+
+  Args:     const std::filesystem::path& shaderPath
+              Path to the shader
+            DWORD dwShaderFlags
+              D3DCOMPILE flags
+            BOOL& bOutHit
+              TRUE if the bytecode came from the cache
+
+  Returns:  std::string
+              Bytecode, empty if the shader failed to compile
+-----------------------------------------------------------------F-F*/
+static std::string compile(_In_ const std::filesystem::path& shaderPath, _In_ DWORD dwShaderFlags, _Out_ BOOL& bOutHit)
+{
+    const UINT uNumHits = ShaderCache::GetNumHits();
+
+    ComPtr<ID3DBlob> blob;
+    HRESULT hr = ShaderCache::Compile(shaderPath.c_str(), "VSMain", "vs_5_0", dwShaderFlags, blob.GetAddressOf());
+
+    bOutHit = ShaderCache::GetNumHits() != uNumHits;
+    if (FAILED(hr))
+    {
+        return std::string();
+    }
+
+    return std::string(static_cast<const CHAR*>(blob->GetBufferPointer()), blob->GetBufferSize());
+}
+
+TEST_CASE(ShaderCacheHitsWhenNothingChanged)
+{
+    const std::filesystem::path shaderPath = writeShader(L"Unchanged");
+
+    BOOL bHit = TRUE;
+    const std::string szCompiled = compile(shaderPath, 0u, bHit);
+    CHECK(!szCompiled.empty());
+    CHECK(!bHit);
+
+    const std::string szCached = compile(shaderPath, 0u, bHit);
+    CHECK(bHit);
+    CHECK(szCompiled == szCached);
+}
+
+TEST_CASE(ShaderCacheMissesWhenTheSourceChanges)
+{
+    const std::filesystem::path shaderPath = writeShader(L"Source");
+
+    BOOL bHit = TRUE;
+    compile(shaderPath, 0u, bHit);
+
+    writeFile(shaderPath, std::string(SHADER_SOURCE) + "float4 Unused() { return 0.0; }\n");
+    compile(shaderPath, 0u, bHit);
+    CHECK(!bHit);
+    compile(shaderPath, 0u, bHit);
+    CHECK(bHit);
+}
+
+TEST_CASE(ShaderCacheMissesWhenADefineChanges)
+{
+    const std::filesystem::path shaderPath = writeShader(L"Define");
+
+    BOOL bHit = TRUE;
+    const std::string szCompiled = compile(shaderPath, 0u, bHit);
+
+    // Only the included file changes, the key of the source stays the same
+    std::string szScaleSource = SCALE_SOURCE;
+    szScaleSource.replace(szScaleSource.find("2.0"), 3u, "3.0");
+    writeFile(shaderPath.parent_path() / L"Scale.fxh", szScaleSource);
+
+    const std::string szRecompiled = compile(shaderPath, 0u, bHit);
+    CHECK(!bHit);
+    CHECK(!szRecompiled.empty());
+    CHECK(szCompiled != szRecompiled);
+}
+
+TEST_CASE(ShaderCacheMissesWhenANestedIncludeChanges)
+{
+    const std::filesystem::path shaderPath = writeShader(L"Include");
+
+    BOOL bHit = TRUE;
+    const std::string szCompiled = compile(shaderPath, 0u, bHit);
+
+    writeFile(shaderPath.parent_path() / L"Offset.fxh", "#define OFFSET 4.0\n");
+
+    const std::string szRecompiled = compile(shaderPath, 0u, bHit);
+    CHECK(!bHit);
+    CHECK(szCompiled != szRecompiled);
+
+    // An include that is removed cannot be hashed, so the shader compiles again and fails
+    std::filesystem::remove(shaderPath.parent_path() / L"Offset.fxh");
+    CHECK(compile(shaderPath, 0u, bHit).empty());
+    CHECK(!bHit);
+}
+
+TEST_CASE(ShaderCacheMissesWhenTheFlagsChange)
+{
+    const std::filesystem::path shaderPath = writeShader(L"Flags");
+
+    BOOL bHit = TRUE;
+    compile(shaderPath, 0u, bHit);
+    compile(shaderPath, D3DCOMPILE_SKIP_OPTIMIZATION, bHit);
+    CHECK(!bHit);
+    compile(shaderPath, 0u, bHit);
+    CHECK(bHit);
+}
+
+TEST_CASE(ShaderCacheRecompilesATruncatedCacheFile)
+{
+    const std::filesystem::path shaderPath = writeShader(L"Truncated");
+
+    BOOL bHit = TRUE;
+    const std::string szCompiled = compile(shaderPath, 0u, bHit);
+
+    std::vector<std::filesystem::path> aCacheFilePaths;
+    for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(shaderPath.parent_path() / L"Cache"))
+    {
+        aCacheFilePaths.push_back(entry.path());
+    }
+    CHECK_EQUAL(1u, aCacheFilePaths.size());
+    if (aCacheFilePaths.size() != 1u)
+    {
+        return;
+    }
+
+    std::filesystem::resize_file(aCacheFilePaths[0], std::filesystem::file_size(aCacheFilePaths[0]) / 2u);
+
+    const std::string szRecompiled = compile(shaderPath, 0u, bHit);
+    CHECK(!bHit);
+    CHECK(szCompiled == szRecompiled);
+
+    // The recompiled shader replaced the truncated file
+    compile(shaderPath, 0u, bHit);
+    CHECK(bHit);
+}
\ No newline at end of file
@@ -0,0 +1,203 @@
+#include "Test.h"
+
+#include "Light/ShadowCascades.h"
+
+using namespace library;
+
+constexpr UINT SHADOW_MAP_SIZE = 1024u;
+
+// The direction of the sun of the game
+const XMFLOAT4 LIGHT_DIRECTION(0.577f, -0.577f, 0.577f, 0.0f);
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: getCameraView
+
+  Summary:  Returns the view of a camera at the given position looking
+            along +z, turned around the y axis by the given angle
+
+  Args:     const XMVECTOR& eye
+              Position of the camera
+            FLOAT yaw
+              Rotation around the y axis in radians
+
+  Returns:  XMMATRIX
+              View matrix
+-----------------------------------------------------------------F-F*/
+static XMMATRIX getCameraView(_In_ const XMVECTOR& eye, _In_ FLOAT yaw)
+{
+    return XMMatrixLookToLH(eye, XMVectorSet(std::sin(yaw), 0.0f, std::cos(yaw), 0.0f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: getProjectionCenter
+
+  Summary:  Reads the center of an off center orthographic projection
+            back from the matrix
+
+  Args:     const XMMATRIX& projection
+              Projection of a cascade
+
+  Returns:  XMFLOAT2
+              Center in the view space of the light
+-----------------------------------------------------------------F-F*/
+static XMFLOAT2 getProjectionCenter(_In_ const XMMATRIX& projection)
+{
+    XMFLOAT4X4 matrix;
+    XMStoreFloat4x4(&matrix, projection);
+
+    return XMFLOAT2(-matrix._41 / matrix._11, -matrix._42 / matrix._22);
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: isWholeTexels
+
+  Summary:  Checks whether a length is a whole number of texels, up to
+            float precision
+
+  Args:     FLOAT length
+              Length in the view space of the light
+            FLOAT texelSize
+              Width of a texel
+
+  Returns:  BOOL
+              TRUE if the length is a multiple of the texel size
+-----------------------------------------------------------------F-F*/
+static BOOL isWholeTexels(_In_ FLOAT length, _In_ FLOAT texelSize)
+{
+    const FLOAT texels = length / texelSize;
+
+    return std::fabs(texels - std::round(texels)) < 1.0e-2f;
+}
+
+TEST_CASE(ComputesUniformSplits)
+{
+    FLOAT aSplits[5];
+    ShadowCascades::ComputeSplits(1.0f, 101.0f, 0.0f, 4u, aSplits);
+
+    CHECK_CLOSE(1.0f, aSplits[0], 1.0e-4f);
+    CHECK_CLOSE(26.0f, aSplits[1], 1.0e-4f);
+    CHECK_CLOSE(51.0f, aSplits[2], 1.0e-4f);
+    CHECK_CLOSE(76.0f, aSplits[3], 1.0e-4f);
+    CHECK_CLOSE(101.0f, aSplits[4], 1.0e-4f);
+}
+
+TEST_CASE(ComputesLogarithmicSplits)
+{
+    FLOAT aSplits[5];
+    ShadowCascades::ComputeSplits(1.0f, 10000.0f, 1.0f, 4u, aSplits);
+
+    CHECK_CLOSE(1.0f, aSplits[0], 1.0e-4f);
+    CHECK_CLOSE(10.0f, aSplits[1], 1.0e-3f);
+    CHECK_CLOSE(100.0f, aSplits[2], 1.0e-2f);
+    CHECK_CLOSE(1000.0f, aSplits[3], 1.0e-1f);
+    CHECK_CLOSE(10000.0f, aSplits[4], 1.0e-4f);
+}
+
+TEST_CASE(BlendsLogarithmicAndUniformSplits)
+{
+    FLOAT aUniform[NUM_CASCADES + 1];
+    FLOAT aLogarithmic[NUM_CASCADES + 1];
+    FLOAT aPractical[NUM_CASCADES + 1];
+    ShadowCascades::ComputeSplits(0.1f, 256.0f, 0.0f, NUM_CASCADES, aUniform);
+    ShadowCascades::ComputeSplits(0.1f, 256.0f, 1.0f, NUM_CASCADES, aLogarithmic);
+    ShadowCascades::ComputeSplits(0.1f, 256.0f, ShadowCascades::DEFAULT_SPLIT_LAMBDA, NUM_CASCADES, aPractical);
+
+    for (UINT i = 1u; i < NUM_CASCADES; ++i)
+    {
+        const FLOAT expected = ShadowCascades::DEFAULT_SPLIT_LAMBDA * aLogarithmic[i] + (1.0f - ShadowCascades::DEFAULT_SPLIT_LAMBDA) * aUniform[i];
+        CHECK_CLOSE(expected, aPractical[i], 1.0e-3f);
+
+        // Logarithmic splits crowd the near plane, so the blend lies between the two
+        CHECK(aLogarithmic[i] < aPractical[i]);
+        CHECK(aPractical[i] < aUniform[i]);
+        CHECK(aPractical[i - 1u] < aPractical[i]);
+    }
+}
+
+TEST_CASE(EndsTheLastCascadeAtTheShadowDistance)
+{
+    ShadowCascades cascades;
+    const XMMATRIX projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, 4.0f / 3.0f, 0.01f, 1000.0f);
+    cascades.Fit(getCameraView(XMVectorSet(0.0f, 3.0f, -6.0f, 1.0f), 0.0f), projection, LIGHT_DIRECTION, SHADOW_MAP_SIZE);
+    CHECK_CLOSE(ShadowCascades::DEFAULT_SHADOW_DISTANCE, cascades.GetSplitDepth(NUM_CASCADES - 1u), 1.0e-3f);
+
+    // A far plane closer than the shadow distance ends the cascades
+    const XMMATRIX nearProjection = XMMatrixPerspectiveFovLH(XM_PIDIV4, 4.0f / 3.0f, 0.01f, 100.0f);
+    cascades.Fit(getCameraView(XMVectorSet(0.0f, 3.0f, -6.0f, 1.0f), 0.0f), nearProjection, LIGHT_DIRECTION, SHADOW_MAP_SIZE);
+    CHECK_CLOSE(100.0f, cascades.GetSplitDepth(NUM_CASCADES - 1u), 1.0e-2f);
+
+    for (UINT i = 1u; i < NUM_CASCADES; ++i)
+    {
+        CHECK(cascades.GetSplitDepth(i - 1u) < cascades.GetSplitDepth(i));
+        CHECK(cascades.GetTexelSize(i - 1u) < cascades.GetTexelSize(i));
+    }
+}
+
+TEST_CASE(SnapsCascadesToWholeTexels)
+{
+    ShadowCascades cascades;
+    const XMMATRIX projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, 4.0f / 3.0f, 0.01f, 1000.0f);
+    cascades.Fit(getCameraView(XMVectorSet(1.3f, 3.0f, -6.7f, 1.0f), 0.4f), projection, LIGHT_DIRECTION, SHADOW_MAP_SIZE);
+
+    for (UINT i = 0u; i < NUM_CASCADES; ++i)
+    {
+        const FLOAT texelSize = cascades.GetTexelSize(i);
+        const XMFLOAT2 center = getProjectionCenter(cascades.GetProjectionMatrix(i));
+        CHECK(isWholeTexels(center.x, texelSize));
+        CHECK(isWholeTexels(center.y, texelSize));
+    }
+}
+
+TEST_CASE(KeepsCascadesOfAStillCamera)
+{
+    ShadowCascades cascades;
+    const XMMATRIX projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, 4.0f / 3.0f, 0.01f, 1000.0f);
+    const XMMATRIX view = getCameraView(XMVectorSet(0.0f, 3.0f, -6.0f, 1.0f), 0.0f);
+    cascades.Fit(view, projection, LIGHT_DIRECTION, SHADOW_MAP_SIZE);
+
+    UINT64 auVersions[NUM_CASCADES];
+    for (UINT i = 0u; i < NUM_CASCADES; ++i)
+    {
+        auVersions[i] = cascades.GetVersion(i);
+        CHECK(auVersions[i] > 0u);
+    }
+
+    cascades.Fit(view, projection, LIGHT_DIRECTION, SHADOW_MAP_SIZE);
+    for (UINT i = 0u; i < NUM_CASCADES; ++i)
+    {
+        CHECK_EQUAL(auVersions[i], cascades.GetVersion(i));
+    }
+
+    // Turning the light changes every cascade
+    cascades.Fit(view, projection, XMFLOAT4(0.0f, -1.0f, 0.0f, 0.0f), SHADOW_MAP_SIZE);
+    for (UINT i = 0u; i < NUM_CASCADES; ++i)
+    {
+        CHECK(cascades.GetVersion(i) > auVersions[i]);
+    }
+}
+
+TEST_CASE(MovesCascadesByWholeTexels)
+{
+    ShadowCascades cascades;
+    const XMMATRIX projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, 4.0f / 3.0f, 0.01f, 1000.0f);
+    cascades.Fit(getCameraView(XMVectorSet(0.0f, 3.0f, -6.0f, 1.0f), 0.0f), projection, LIGHT_DIRECTION, SHADOW_MAP_SIZE);
+
+    XMFLOAT2 aCenters[NUM_CASCADES];
+    FLOAT aTexelSizes[NUM_CASCADES];
+    for (UINT i = 0u; i < NUM_CASCADES; ++i)
+    {
+        aCenters[i] = getProjectionCenter(cascades.GetProjectionMatrix(i));
+        aTexelSizes[i] = cascades.GetTexelSize(i);
+    }
+
+    // Turning the camera keeps the size of the cascades, moving it moves them by whole texels
+    cascades.Fit(getCameraView(XMVectorSet(7.3f, 3.0f, -2.1f, 1.0f), 1.1f), projection, LIGHT_DIRECTION, SHADOW_MAP_SIZE);
+    for (UINT i = 0u; i < NUM_CASCADES; ++i)
+    {
+        CHECK_EQUAL(aTexelSizes[i], cascades.GetTexelSize(i));
+
+        const XMFLOAT2 center = getProjectionCenter(cascades.GetProjectionMatrix(i));
+        CHECK(isWholeTexels(center.x - aCenters[i].x, aTexelSizes[i]));
+        CHECK(isWholeTexels(center.y - aCenters[i].y, aTexelSizes[i]));
+    }
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+/*+===================================================================
+  File:      DIRECTXCOLLISION.H
+
+  Summary:   Stand-in for the DirectXMath collision header. Declares
+             only the bounding volumes the portable part of the
+             renderer uses.
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include <DirectXMath.h>
+
+#include <cfloat>
+
+namespace DirectX
+{
+    struct BoundingBox
+    {
+        XMFLOAT3 Center;
+        XMFLOAT3 Extents;
+
+        BoundingBox()
+            : Center(0.0f, 0.0f, 0.0f)
+            , Extents(1.0f, 1.0f, 1.0f)
+        {
+        }
+
+        constexpr BoundingBox(const XMFLOAT3& center, const XMFLOAT3& extents)
+            : Center(center)
+            , Extents(extents)
+        {
+        }
+
+        void XM_CALLCONV Transform(BoundingBox& Out, FXMMATRIX M) const
+        {
+            XMVECTOR min = XMVectorReplicate(FLT_MAX);
+            XMVECTOR max = XMVectorReplicate(-FLT_MAX);
+            for (int i = 0; i < 8; ++i)
+            {
+                XMVECTOR corner = XMVectorSet(
+                    Center.x + ((i & 1) ? Extents.x : -Extents.x),
+                    Center.y + ((i & 2) ? Extents.y : -Extents.y),
+                    Center.z + ((i & 4) ? Extents.z : -Extents.z),
+                    0.0f
+                );
+                corner = XMVector3Transform(corner, M);
+                min = XMVectorMin(min, corner);
+                max = XMVectorMax(max, corner);
+            }
+
+            XMStoreFloat3(&Out.Center, XMVectorScale(XMVectorAdd(min, max), 0.5f));
+            XMStoreFloat3(&Out.Extents, XMVectorScale(XMVectorSubtract(max, min), 0.5f));
+        }
+    };
+}
\ No newline at end of file
@@ -0,0 +1,487 @@
+/*+===================================================================
+  File:      DIRECTXMATH.H
+
+  Summary:   Stand-in for the DirectXMath header when the portable
+             part of the renderer is built on another platform. A
+             scalar implementation of the types and functions that
+             part uses, with the conventions of DirectXMath: row
+             vectors, row major matrices and v * M.
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#define XM_CALLCONV
+
+namespace DirectX
+{
+    constexpr float XM_PI = 3.141592654f;
+    constexpr float XM_2PI = 6.283185307f;
+    constexpr float XM_PIDIV2 = 1.570796327f;
+    constexpr float XM_PIDIV4 = 0.785398163f;
+
+    constexpr float XMConvertToRadians(float fDegrees)
+    {
+        return fDegrees * (XM_PI / 180.0f);
+    }
+
+    struct alignas(16) XMVECTOR
+    {
+        float f[4];
+    };
+
+    typedef const XMVECTOR FXMVECTOR;
+    typedef const XMVECTOR GXMVECTOR;
+    typedef const XMVECTOR HXMVECTOR;
+    typedef const XMVECTOR& CXMVECTOR;
+
+    struct alignas(16) XMVECTORF32
+    {
+        union
+        {
+            float f[4];
+            XMVECTOR v;
+        };
+
+        operator XMVECTOR() const
+        {
+            return XMVECTOR{ { f[0], f[1], f[2], f[3] } };
+        }
+    };
+
+    inline constexpr XMVECTORF32 g_XMIdentityR2 = { { { 0.0f, 0.0f, 1.0f, 0.0f } } };
+
+    struct alignas(16) XMMATRIX
+    {
+        XMVECTOR r[4];
+
+        XMMATRIX() = default;
+        constexpr XMMATRIX(FXMVECTOR r0, FXMVECTOR r1, FXMVECTOR r2, CXMVECTOR r3)
+            : r{ r0, r1, r2, r3 }
+        {
+        }
+
+        XMMATRIX& operator*=(const XMMATRIX& other);
+        XMMATRIX operator*(const XMMATRIX& other) const;
+    };
+
+    typedef const XMMATRIX& FXMMATRIX;
+    typedef const XMMATRIX& CXMMATRIX;
+
+    struct XMFLOAT2
+    {
+        float x;
+        float y;
+
+        XMFLOAT2() = default;
+        constexpr XMFLOAT2(float _x, float _y) : x(_x), y(_y) {}
+    };
+
+    struct XMFLOAT3
+    {
+        float x;
+        float y;
+        float z;
+
+        XMFLOAT3() = default;
+        constexpr XMFLOAT3(float _x, float _y, float _z) : x(_x), y(_y), z(_z) {}
+    };
+
+    struct XMFLOAT4
+    {
+        float x;
+        float y;
+        float z;
+        float w;
+
+        XMFLOAT4() = default;
+        constexpr XMFLOAT4(float _x, float _y, float _z, float _w) : x(_x), y(_y), z(_z), w(_w) {}
+    };
+
+    struct alignas(16) XMFLOAT4A : public XMFLOAT4
+    {
+        using XMFLOAT4::XMFLOAT4;
+    };
+
+    struct XMUINT2
+    {
+        std::uint32_t x;
+        std::uint32_t y;
+
+        XMUINT2() = default;
+        constexpr XMUINT2(std::uint32_t _x, std::uint32_t _y) : x(_x), y(_y) {}
+    };
+
+    struct XMUINT4
+    {
+        std::uint32_t x;
+        std::uint32_t y;
+        std::uint32_t z;
+        std::uint32_t w;
+
+        XMUINT4() = default;
+        constexpr XMUINT4(std::uint32_t _x, std::uint32_t _y, std::uint32_t _z, std::uint32_t _w) : x(_x), y(_y), z(_z), w(_w) {}
+    };
+
+    struct XMFLOAT4X4
+    {
+        float m[4][4];
+
+        XMFLOAT4X4() = default;
+        float operator()(std::size_t uRow, std::size_t uColumn) const { return m[uRow][uColumn]; }
+        float& operator()(std::size_t uRow, std::size_t uColumn) { return m[uRow][uColumn]; }
+    };
+
+    struct alignas(16) XMFLOAT4X4A : public XMFLOAT4X4
+    {
+    };
+
+    inline XMVECTOR XM_CALLCONV XMVectorSet(float x, float y, float z, float w)
+    {
+        return XMVECTOR{ { x, y, z, w } };
+    }
+
+    inline XMVECTOR XM_CALLCONV XMVectorZero()
+    {
+        return XMVectorSet(0.0f, 0.0f, 0.0f, 0.0f);
+    }
+
+    inline XMVECTOR XM_CALLCONV XMVectorReplicate(float fValue)
+    {
+        return XMVectorSet(fValue, fValue, fValue, fValue);
+    }
+
+    inline float XM_CALLCONV XMVectorGetX(FXMVECTOR V) { return V.f[0]; }
+    inline float XM_CALLCONV XMVectorGetY(FXMVECTOR V) { return V.f[1]; }
+    inline float XM_CALLCONV XMVectorGetZ(FXMVECTOR V) { return V.f[2]; }
+    inline float XM_CALLCONV XMVectorGetW(FXMVECTOR V) { return V.f[3]; }
+
+    inline XMVECTOR XM_CALLCONV XMVectorSplatX(FXMVECTOR V) { return XMVectorReplicate(V.f[0]); }
+    inline XMVECTOR XM_CALLCONV XMVectorSplatY(FXMVECTOR V) { return XMVectorReplicate(V.f[1]); }
+    inline XMVECTOR XM_CALLCONV XMVectorSplatZ(FXMVECTOR V) { return XMVectorReplicate(V.f[2]); }
+    inline XMVECTOR XM_CALLCONV XMVectorSplatW(FXMVECTOR V) { return XMVectorReplicate(V.f[3]); }
+
+    inline XMVECTOR XM_CALLCONV XMVectorSetW(FXMVECTOR V, float w)
+    {
+        return XMVectorSet(V.f[0], V.f[1], V.f[2], w);
+    }
+
+    inline XMVECTOR XM_CALLCONV XMVectorAdd(FXMVECTOR V1, FXMVECTOR V2)
+    {
+        return XMVectorSet(V1.f[0] + V2.f[0], V1.f[1] + V2.f[1], V1.f[2] + V2.f[2], V1.f[3] + V2.f[3]);
+    }
+
+    inline XMVECTOR XM_CALLCONV XMVectorSubtract(FXMVECTOR V1, FXMVECTOR V2)
+    {
+        return XMVectorSet(V1.f[0] - V2.f[0], V1.f[1] - V2.f[1], V1.f[2] - V2.f[2], V1.f[3] - V2.f[3]);
+    }
+
+    inline XMVECTOR XM_CALLCONV XMVectorMultiply(FXMVECTOR V1, FXMVECTOR V2)
+    {
+        return XMVectorSet(V1.f[0] * V2.f[0], V1.f[1] * V2.f[1], V1.f[2] * V2.f[2], V1.f[3] * V2.f[3]);
+    }
+
+    inline XMVECTOR XM_CALLCONV XMVectorDivide(FXMVECTOR V1, FXMVECTOR V2)
+    {
+        return XMVectorSet(V1.f[0] / V2.f[0], V1.f[1] / V2.f[1], V1.f[2] / V2.f[2], V1.f[3] / V2.f[3]);
+    }
+
+    inline XMVECTOR XM_CALLCONV XMVectorMultiplyAdd(FXMVECTOR V1, FXMVECTOR V2, FXMVECTOR V3)
+    {
+        return XMVectorAdd(XMVectorMultiply(V1, V2), V3);
+    }
+
+    inline XMVECTOR XM_CALLCONV XMVectorScale(FXMVECTOR V, float fScale)
+    {
+        return XMVectorSet(V.f[0] * fScale, V.f[1] * fScale, V.f[2] * fScale, V.f[3] * fScale);
+    }
+
+    inline XMVECTOR XM_CALLCONV XMVectorNegate(FXMVECTOR V)
+    {
+        return XMVectorSet(-V.f[0], -V.f[1], -V.f[2], -V.f[3]);
+    }
+
+    inline XMVECTOR XM_CALLCONV XMVectorMin(FXMVECTOR V1, FXMVECTOR V2)
+    {
+        return XMVectorSet(std::min(V1.f[0], V2.f[0]), std::min(V1.f[1], V2.f[1]), std::min(V1.f[2], V2.f[2]), std::min(V1.f[3], V2.f[3]));
+    }
+
+    inline XMVECTOR XM_CALLCONV XMVectorMax(FXMVECTOR V1, FXMVECTOR V2)
+    {
+        return XMVectorSet(std::max(V1.f[0], V2.f[0]), std::max(V1.f[1], V2.f[1]), std::max(V1.f[2], V2.f[2]), std::max(V1.f[3], V2.f[3]));
+    }
+
+    inline XMVECTOR XM_CALLCONV XMVectorClamp(FXMVECTOR V, FXMVECTOR Min, FXMVECTOR Max)
+    {
+        return XMVectorMin(XMVectorMax(V, Min), Max);
+    }
+
+    inline XMVECTOR XM_CALLCONV XMVectorSaturate(FXMVECTOR V)
+    {
+        return XMVectorClamp(V, XMVectorZero(), XMVectorReplicate(1.0f));
+    }
+
+    inline XMVECTOR XM_CALLCONV XMVectorLerp(FXMVECTOR V0, FXMVECTOR V1, float t)
+    {
+        return XMVectorAdd(V0, XMVectorScale(XMVectorSubtract(V1, V0), t));
+    }
+
+    inline XMVECTOR XM_CALLCONV XMVector3Dot(FXMVECTOR V1, FXMVECTOR V2)
+    {
+        return XMVectorReplicate(V1.f[0] * V2.f[0] + V1.f[1] * V2.f[1] + V1.f[2] * V2.f[2]);
+    }
+
+    inline XMVECTOR XM_CALLCONV XMVector4Dot(FXMVECTOR V1, FXMVECTOR V2)
+    {
+        return XMVectorReplicate(V1.f[0] * V2.f[0] + V1.f[1] * V2.f[1] + V1.f[2] * V2.f[2] + V1.f[3] * V2.f[3]);
+    }
+
+    inline XMVECTOR XM_CALLCONV XMVector3LengthSq(FXMVECTOR V)
+    {
+        return XMVector3Dot(V, V);
+    }
+
+    inline XMVECTOR XM_CALLCONV XMVector3Length(FXMVECTOR V)
+    {
+        return XMVectorReplicate(std::sqrt(XMVectorGetX(XMVector3LengthSq(V))));
+    }
+
+    inline XMVECTOR XM_CALLCONV XMVector3Normalize(FXMVECTOR V)
+    {
+        float fLength = XMVectorGetX(XMVector3Length(V));
+
+        return fLength > 0.0f ? XMVectorScale(V, 1.0f / fLength) : V;
+    }
+
+    inline XMVECTOR XM_CALLCONV XMVector4Normalize(FXMVECTOR V)
+    {
+        float fLength = std::sqrt(XMVectorGetX(XMVector4Dot(V, V)));
+
+        return fLength > 0.0f ? XMVectorScale(V, 1.0f / fLength) : V;
+    }
+
+    inline XMVECTOR operator+(FXMVECTOR V1, FXMVECTOR V2) { return XMVectorAdd(V1, V2); }
+    inline XMVECTOR operator-(FXMVECTOR V1, FXMVECTOR V2) { return XMVectorSubtract(V1, V2); }
+    inline XMVECTOR operator*(FXMVECTOR V1, FXMVECTOR V2) { return XMVectorMultiply(V1, V2); }
+    inline XMVECTOR operator/(FXMVECTOR V1, FXMVECTOR V2) { return XMVectorDivide(V1, V2); }
+    inline XMVECTOR operator*(FXMVECTOR V, float fScale) { return XMVectorScale(V, fScale); }
+    inline XMVECTOR operator-(FXMVECTOR V) { return XMVectorNegate(V); }
+
+    inline XMVECTOR XM_CALLCONV XMLoadFloat2(const XMFLOAT2* pSource)
+    {
+        return XMVectorSet(pSource->x, pSource->y, 0.0f, 0.0f);
+    }
+
+    inline XMVECTOR XM_CALLCONV XMLoadFloat3(const XMFLOAT3* pSource)
+    {
+        return XMVectorSet(pSource->x, pSource->y, pSource->z, 0.0f);
+    }
+
+    inline XMVECTOR XM_CALLCONV XMLoadFloat4(const XMFLOAT4* pSource)
+    {
+        return XMVectorSet(pSource->x, pSource->y, pSource->z, pSource->w);
+    }
+
+    inline void XM_CALLCONV XMStoreFloat2(XMFLOAT2* pDestination, FXMVECTOR V)
+    {
+        *pDestination = XMFLOAT2(V.f[0], V.f[1]);
+    }
+
+    inline void XM_CALLCONV XMStoreFloat3(XMFLOAT3* pDestination, FXMVECTOR V)
+    {
+        *pDestination = XMFLOAT3(V.f[0], V.f[1], V.f[2]);
+    }
+
+    inline void XM_CALLCONV XMStoreFloat4(XMFLOAT4* pDestination, FXMVECTOR V)
+    {
+        *pDestination = XMFLOAT4(V.f[0], V.f[1], V.f[2], V.f[3]);
+    }
+
+    inline XMMATRIX XM_CALLCONV XMLoadFloat4x4(const XMFLOAT4X4* pSource)
+    {
+        XMMATRIX M;
+        for (int i = 0; i < 4; ++i)
+        {
+            M.r[i] = XMVectorSet(pSource->m[i][0], pSource->m[i][1], pSource->m[i][2], pSource->m[i][3]);
+        }
+
+        return M;
+    }
+
+    inline XMMATRIX XM_CALLCONV XMLoadFloat4x4A(const XMFLOAT4X4A* pSource)
+    {
+        return XMLoadFloat4x4(pSource);
+    }
+
+    inline void XM_CALLCONV XMStoreFloat4x4(XMFLOAT4X4* pDestination, FXMMATRIX M)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            for (int j = 0; j < 4; ++j)
+            {
+                pDestination->m[i][j] = M.r[i].f[j];
+            }
+        }
+    }
+
+    inline void XM_CALLCONV XMStoreFloat4x4A(XMFLOAT4X4A* pDestination, FXMMATRIX M)
+    {
+        XMStoreFloat4x4(pDestination, M);
+    }
+
+    inline XMVECTOR XM_CALLCONV XMVector4Transform(FXMVECTOR V, FXMMATRIX M)
+    {
+        XMVECTOR result = XMVectorScale(M.r[0], V.f[0]);
+        result = XMVectorMultiplyAdd(XMVectorReplicate(V.f[1]), M.r[1], result);
+        result = XMVectorMultiplyAdd(XMVectorReplicate(V.f[2]), M.r[2], result);
+
+        return XMVectorMultiplyAdd(XMVectorReplicate(V.f[3]), M.r[3], result);
+    }
+
+    inline XMVECTOR XM_CALLCONV XMVector3Transform(FXMVECTOR V, FXMMATRIX M)
+    {
+        return XMVector4Transform(XMVectorSetW(V, 1.0f), M);
+    }
+
+    inline XMVECTOR XM_CALLCONV XMVector3TransformCoord(FXMVECTOR V, FXMMATRIX M)
+    {
+        XMVECTOR result = XMVector3Transform(V, M);
+
+        return XMVectorScale(result, 1.0f / result.f[3]);
+    }
+
+    inline XMVECTOR XM_CALLCONV XMVector3TransformNormal(FXMVECTOR V, FXMMATRIX M)
+    {
+        return XMVector4Transform(XMVectorSetW(V, 0.0f), M);
+    }
+
+    inline XMMATRIX XM_CALLCONV XMMatrixIdentity()
+    {
+        return XMMATRIX(XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f), XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f), XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f));
+    }
+
+    inline XMMATRIX XM_CALLCONV XMMatrixMultiply(FXMMATRIX M1, CXMMATRIX M2)
+    {
+        return XMMATRIX(XMVector4Transform(M1.r[0], M2), XMVector4Transform(M1.r[1], M2), XMVector4Transform(M1.r[2], M2), XMVector4Transform(M1.r[3], M2));
+    }
+
+    inline XMMATRIX& XMMATRIX::operator*=(const XMMATRIX& other)
+    {
+        *this = XMMatrixMultiply(*this, other);
+
+        return *this;
+    }
+
+    inline XMMATRIX XMMATRIX::operator*(const XMMATRIX& other) const
+    {
+        return XMMatrixMultiply(*this, other);
+    }
+
+    inline XMMATRIX XM_CALLCONV XMMatrixTranslation(float x, float y, float z)
+    {
+        return XMMATRIX(XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f), XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f), XMVectorSet(x, y, z, 1.0f));
+    }
+
+    inline XMMATRIX XM_CALLCONV XMMatrixScaling(float x, float y, float z)
+    {
+        return XMMATRIX(XMVectorSet(x, 0.0f, 0.0f, 0.0f), XMVectorSet(0.0f, y, 0.0f, 0.0f), XMVectorSet(0.0f, 0.0f, z, 0.0f), XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f));
+    }
+
+    inline XMMATRIX XM_CALLCONV XMMatrixRotationX(float fAngle)
+    {
+        float fSin = std::sin(fAngle);
+        float fCos = std::cos(fAngle);
+
+        return XMMATRIX(XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f), XMVectorSet(0.0f, fCos, fSin, 0.0f), XMVectorSet(0.0f, -fSin, fCos, 0.0f), XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f));
+    }
+
+    inline XMMATRIX XM_CALLCONV XMMatrixRotationY(float fAngle)
+    {
+        float fSin = std::sin(fAngle);
+        float fCos = std::cos(fAngle);
+
+        return XMMATRIX(XMVectorSet(fCos, 0.0f, -fSin, 0.0f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f), XMVectorSet(fSin, 0.0f, fCos, 0.0f), XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f));
+    }
+
+    inline XMMATRIX XM_CALLCONV XMMatrixRotationZ(float fAngle)
+    {
+        float fSin = std::sin(fAngle);
+        float fCos = std::cos(fAngle);
+
+        return XMMATRIX(XMVectorSet(fCos, fSin, 0.0f, 0.0f), XMVectorSet(-fSin, fCos, 0.0f, 0.0f), XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f), XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f));
+    }
+
+    inline XMMATRIX XM_CALLCONV XMMatrixRotationQuaternion(FXMVECTOR Quaternion)
+    {
+        const float x = Quaternion.f[0];
+        const float y = Quaternion.f[1];
+        const float z = Quaternion.f[2];
+        const float w = Quaternion.f[3];
+
+        return XMMATRIX(
+            XMVectorSet(1.0f - 2.0f * (y * y + z * z), 2.0f * (x * y + z * w), 2.0f * (x * z - y * w), 0.0f),
+            XMVectorSet(2.0f * (x * y - z * w), 1.0f - 2.0f * (x * x + z * z), 2.0f * (y * z + x * w), 0.0f),
+            XMVectorSet(2.0f * (x * z + y * w), 2.0f * (y * z - x * w), 1.0f - 2.0f * (x * x + y * y), 0.0f),
+            XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f)
+        );
+    }
+
+    inline XMMATRIX XM_CALLCONV XMMatrixAffineTransformation(FXMVECTOR Scaling, FXMVECTOR RotationOrigin, FXMVECTOR RotationQuaternion, GXMVECTOR Translation)
+    {
+        XMMATRIX M = XMMatrixScaling(Scaling.f[0], Scaling.f[1], Scaling.f[2]);
+        M.r[3] = XMVectorSubtract(M.r[3], XMVectorSetW(RotationOrigin, 0.0f));
+        M = XMMatrixMultiply(M, XMMatrixRotationQuaternion(RotationQuaternion));
+        M.r[3] = XMVectorAdd(M.r[3], XMVectorSetW(XMVectorAdd(RotationOrigin, Translation), 0.0f));
+
+        return M;
+    }
+
+    inline XMVECTOR XM_CALLCONV XMQuaternionIdentity()
+    {
+        return XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f);
+    }
+
+    inline XMVECTOR XM_CALLCONV XMQuaternionRotationRollPitchYaw(float fPitch, float fYaw, float fRoll)
+    {
+        const float fSinPitch = std::sin(fPitch * 0.5f);
+        const float fCosPitch = std::cos(fPitch * 0.5f);
+        const float fSinYaw = std::sin(fYaw * 0.5f);
+        const float fCosYaw = std::cos(fYaw * 0.5f);
+        const float fSinRoll = std::sin(fRoll * 0.5f);
+        const float fCosRoll = std::cos(fRoll * 0.5f);
+
+        return XMVectorSet(
+            fSinPitch * fCosYaw * fCosRoll + fCosPitch * fSinYaw * fSinRoll,
+            fCosPitch * fSinYaw * fCosRoll - fSinPitch * fCosYaw * fSinRoll,
+            fCosPitch * fCosYaw * fSinRoll - fSinPitch * fSinYaw * fCosRoll,
+            fCosPitch * fCosYaw * fCosRoll + fSinPitch * fSinYaw * fSinRoll
+        );
+    }
+
+    inline XMVECTOR XM_CALLCONV XMColorSRGBToRGB(FXMVECTOR srgb)
+    {
+        XMVECTOR result = srgb;
+        for (int i = 0; i < 3; ++i)
+        {
+            result.f[i] = srgb.f[i] <= 0.04045f ? srgb.f[i] / 12.92f : std::pow((srgb.f[i] + 0.055f) / 1.055f, 2.4f);
+        }
+
+        return result;
+    }
+
+    inline XMVECTOR XM_CALLCONV XMColorRGBToSRGB(FXMVECTOR rgb)
+    {
+        XMVECTOR result = XMVectorSaturate(rgb);
+        for (int i = 0; i < 3; ++i)
+        {
+            result.f[i] = result.f[i] < 0.0031308f ? result.f[i] * 12.92f : 1.055f * std::pow(result.f[i], 1.0f / 2.4f) - 0.055f;
+        }
+        result.f[3] = rgb.f[3];
+
+        return result;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,9 @@
+/*+===================================================================
+  File:      CRTDBG.H
+
+  Summary:   Stand-in for the debug C runtime header. Leak checks are
+             only done by the Windows build.
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
\ No newline at end of file
@@ -0,0 +1,11 @@
+/*+===================================================================
+  File:      D3DCOMPILER.H
+
+  Summary:   Stand-in for the shader compiler header. The portable
+             part of the renderer does not compile shaders.
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include <d3d11_4.h>
\ No newline at end of file
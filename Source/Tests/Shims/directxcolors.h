@@ -0,0 +1,15 @@
+/*+===================================================================
+  File:      DIRECTXCOLORS.H
+
+  Summary:   Stand-in for the DirectXMath colors header. The portable
+             part of the renderer does not use the named colors.
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include <DirectXMath.h>
+
+namespace DirectX
+{
+}
\ No newline at end of file
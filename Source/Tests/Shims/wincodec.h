@@ -0,0 +1,11 @@
+/*+===================================================================
+  File:      WINCODEC.H
+
+  Summary:   Stand-in for the Windows Imaging Component header. The
+             portable part of the renderer does not decode images.
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include <windows.h>
\ No newline at end of file
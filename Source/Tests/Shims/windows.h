@@ -0,0 +1,333 @@
+/*+===================================================================
+  File:      WINDOWS.H
+
+  Summary:   Stand-in for the Windows header when the portable part
+             of the renderer is built on another platform. Declares
+             only the types, SAL annotations and functions that part
+             uses.
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include <chrono>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <cwchar>
+#include <cwctype>
+#include <filesystem>
+#include <functional>
+#include <thread>
+
+#define _In_
+#define _In_opt_
+#define _In_z_
+#define _Inout_
+#define _Inout_opt_
+#define _Inout_updates_(size)
+#define _Out_
+#define _Out_opt_
+#define _In_reads_(size)
+#define _In_reads_opt_(size)
+#define _In_reads_bytes_(size)
+#define _In_reads_bytes_opt_(size)
+#define _Out_writes_(size)
+#define _Out_writes_opt_(size)
+#define _Out_writes_bytes_(size)
+
+typedef int BOOL;
+typedef unsigned char BYTE;
+typedef char CHAR;
+typedef wchar_t WCHAR;
+typedef int INT;
+typedef unsigned int UINT;
+typedef std::int8_t INT8;
+typedef std::uint8_t UINT8;
+typedef std::int16_t INT16;
+typedef std::uint16_t UINT16;
+typedef std::int32_t INT32;
+typedef std::uint32_t UINT32;
+typedef std::int64_t INT64;
+typedef std::uint64_t UINT64;
+typedef std::int32_t LONG;
+typedef std::int64_t LONGLONG;
+typedef std::uint32_t ULONG;
+typedef std::uint16_t WORD;
+typedef std::uint32_t DWORD;
+typedef float FLOAT;
+typedef double DOUBLE;
+typedef std::size_t SIZE_T;
+typedef const char* LPCSTR;
+typedef const char* PCSTR;
+typedef const wchar_t* LPCWSTR;
+typedef const wchar_t* PCWSTR;
+typedef std::int32_t HRESULT;
+typedef void* HANDLE;
+
+union LARGE_INTEGER
+{
+    struct
+    {
+        DWORD LowPart;
+        LONG HighPart;
+    };
+    LONGLONG QuadPart;
+};
+
+#ifndef TRUE
+#define TRUE 1
+#endif
+#ifndef FALSE
+#define FALSE 0
+#endif
+
+#define S_OK ((HRESULT)0)
+#define S_FALSE ((HRESULT)1)
+#define E_NOTIMPL ((HRESULT)0x80004001)
+#define E_FAIL ((HRESULT)0x80004005)
+#define E_OUTOFMEMORY ((HRESULT)0x8007000E)
+#define E_INVALIDARG ((HRESULT)0x80070057)
+
+#define SUCCEEDED(hr) (((HRESULT)(hr)) >= 0)
+#define FAILED(hr) (((HRESULT)(hr)) < 0)
+
+#define ERROR_FILE_NOT_FOUND 2L
+#define ERROR_INVALID_DATA 13L
+#define ERROR_HANDLE_EOF 38L
+#define ERROR_NOT_SUPPORTED 50L
+#define ERROR_OPEN_FAILED 110L
+
+#define INVALID_HANDLE_VALUE (reinterpret_cast<HANDLE>(static_cast<std::intptr_t>(-1)))
+#define GENERIC_READ 0x80000000u
+#define GENERIC_WRITE 0x40000000u
+#define FILE_SHARE_READ 0x00000001u
+#define CREATE_ALWAYS 2u
+#define OPEN_EXISTING 3u
+#define FILE_ATTRIBUTE_NORMAL 0x00000080u
+#define FILE_FLAG_SEQUENTIAL_SCAN 0x08000000u
+#define MOVEFILE_REPLACE_EXISTING 0x00000001u
+
+inline HRESULT HRESULT_FROM_WIN32(long x)
+{
+    return x <= 0 ? static_cast<HRESULT>(x) : static_cast<HRESULT>((static_cast<std::uint32_t>(x) & 0x0000FFFFu) | 0x80070000u);
+}
+
+#define UNREFERENCED_PARAMETER(P) (static_cast<void>(P))
+
+inline void OutputDebugStringA(_In_opt_ LPCSTR pszOutputString)
+{
+    std::fputs(pszOutputString ? pszOutputString : "", stderr);
+}
+
+inline void OutputDebugStringW(_In_opt_ LPCWSTR pszOutputString)
+{
+    std::fprintf(stderr, "%ls", pszOutputString ? pszOutputString : L"");
+}
+
+// Paths are narrow on this platform, so path.c_str() is logged through this overload
+inline void OutputDebugStringW(_In_opt_ LPCSTR pszOutputString)
+{
+    OutputDebugStringA(pszOutputString);
+}
+
+#define OutputDebugString OutputDebugStringW
+
+template <std::size_t uSize>
+inline int sprintf_s(char (&szBuffer)[uSize], _In_z_ const char* pszFormat, ...)
+{
+    va_list args;
+    va_start(args, pszFormat);
+    int iResult = std::vsnprintf(szBuffer, uSize, pszFormat, args);
+    va_end(args);
+
+    return iResult;
+}
+
+template <std::size_t uSize>
+inline int swprintf_s(wchar_t (&szBuffer)[uSize], _In_z_ const wchar_t* pszFormat, ...)
+{
+    va_list args;
+    va_start(args, pszFormat);
+    int iResult = std::vswprintf(szBuffer, uSize, pszFormat, args);
+    va_end(args);
+
+    return iResult;
+}
+
+inline DWORD CharLowerBuffW(_Inout_updates_(dwLength) WCHAR* pszString, _In_ DWORD dwLength)
+{
+    for (DWORD i = 0u; i < dwLength; ++i)
+    {
+        pszString[i] = static_cast<WCHAR>(std::towlower(static_cast<std::wint_t>(pszString[i])));
+    }
+
+    return dwLength;
+}
+
+inline BOOL QueryPerformanceCounter(_Out_ LARGE_INTEGER* pPerformanceCount)
+{
+    pPerformanceCount->QuadPart = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    return TRUE;
+}
+
+inline BOOL QueryPerformanceFrequency(_Out_ LARGE_INTEGER* pFrequency)
+{
+    pFrequency->QuadPart = 1000000000ll;
+
+    return TRUE;
+}
+
+inline DWORD GetCurrentThreadId()
+{
+    return static_cast<DWORD>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+}
+
+// Files are std::FILE streams, paths are narrow on this platform and wide ones are converted
+
+inline DWORD& getLastErrorShim()
+{
+    static thread_local DWORD s_dwLastError = 0u;
+
+    return s_dwLastError;
+}
+
+inline DWORD GetLastError()
+{
+    return getLastErrorShim();
+}
+
+inline HANDLE CreateFileW(
+    _In_ const char* pszFileName,
+    _In_ DWORD dwDesiredAccess,
+    _In_ DWORD dwShareMode,
+    _In_opt_ void* pSecurityAttributes,
+    _In_ DWORD dwCreationDisposition,
+    _In_ DWORD dwFlagsAndAttributes,
+    _In_opt_ HANDLE hTemplateFile
+)
+{
+    UNREFERENCED_PARAMETER(dwDesiredAccess);
+    UNREFERENCED_PARAMETER(dwShareMode);
+    UNREFERENCED_PARAMETER(pSecurityAttributes);
+    UNREFERENCED_PARAMETER(dwFlagsAndAttributes);
+    UNREFERENCED_PARAMETER(hTemplateFile);
+
+    std::FILE* pFile = std::fopen(pszFileName, dwCreationDisposition == CREATE_ALWAYS ? "wb" : "rb");
+    if (!pFile)
+    {
+        getLastErrorShim() = dwCreationDisposition == OPEN_EXISTING ? ERROR_FILE_NOT_FOUND : ERROR_OPEN_FAILED;
+        return INVALID_HANDLE_VALUE;
+    }
+
+    return pFile;
+}
+
+inline HANDLE CreateFileW(
+    _In_ const wchar_t* pszFileName,
+    _In_ DWORD dwDesiredAccess,
+    _In_ DWORD dwShareMode,
+    _In_opt_ void* pSecurityAttributes,
+    _In_ DWORD dwCreationDisposition,
+    _In_ DWORD dwFlagsAndAttributes,
+    _In_opt_ HANDLE hTemplateFile
+)
+{
+    return CreateFileW(std::filesystem::path(pszFileName).c_str(), dwDesiredAccess, dwShareMode, pSecurityAttributes, dwCreationDisposition, dwFlagsAndAttributes, hTemplateFile);
+}
+
+inline BOOL ReadFile(_In_ HANDLE hFile, _Out_ void* pBuffer, _In_ DWORD dwNumBytesToRead, _Out_opt_ DWORD* pdwNumBytesRead, _Inout_opt_ void* pOverlapped)
+{
+    UNREFERENCED_PARAMETER(pOverlapped);
+
+    std::FILE* pFile = static_cast<std::FILE*>(hFile);
+    size_t uNumBytesRead = std::fread(pBuffer, 1u, dwNumBytesToRead, pFile);
+    if (pdwNumBytesRead)
+    {
+        *pdwNumBytesRead = static_cast<DWORD>(uNumBytesRead);
+    }
+
+    return !std::ferror(pFile);
+}
+
+inline BOOL WriteFile(_In_ HANDLE hFile, _In_ const void* pBuffer, _In_ DWORD dwNumBytesToWrite, _Out_opt_ DWORD* pdwNumBytesWritten, _Inout_opt_ void* pOverlapped)
+{
+    UNREFERENCED_PARAMETER(pOverlapped);
+
+    size_t uNumBytesWritten = std::fwrite(pBuffer, 1u, dwNumBytesToWrite, static_cast<std::FILE*>(hFile));
+    if (pdwNumBytesWritten)
+    {
+        *pdwNumBytesWritten = static_cast<DWORD>(uNumBytesWritten);
+    }
+
+    return uNumBytesWritten == dwNumBytesToWrite;
+}
+
+inline BOOL GetFileSizeEx(_In_ HANDLE hFile, _Out_ LARGE_INTEGER* pFileSize)
+{
+    std::FILE* pFile = static_cast<std::FILE*>(hFile);
+    long lPosition = std::ftell(pFile);
+    if (std::fseek(pFile, 0, SEEK_END) != 0)
+    {
+        return FALSE;
+    }
+    pFileSize->QuadPart = std::ftell(pFile);
+
+    return std::fseek(pFile, lPosition, SEEK_SET) == 0;
+}
+
+inline BOOL CloseHandle(_In_ HANDLE hObject)
+{
+    return std::fclose(static_cast<std::FILE*>(hObject)) == 0;
+}
+
+inline BOOL DeleteFileW(_In_ const std::filesystem::path::value_type* pszFileName)
+{
+    std::error_code errorCode;
+
+    return std::filesystem::remove(pszFileName, errorCode);
+}
+
+inline BOOL MoveFileExW(_In_ const std::filesystem::path::value_type* pszExistingFileName, _In_ const std::filesystem::path::value_type* pszNewFileName, _In_ DWORD dwFlags)
+{
+    UNREFERENCED_PARAMETER(dwFlags);
+
+    std::error_code errorCode;
+    std::filesystem::rename(pszExistingFileName, pszNewFileName, errorCode);
+    if (errorCode)
+    {
+        getLastErrorShim() = ERROR_OPEN_FAILED;
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+#define CreateFile CreateFileW
+#define DeleteFile DeleteFileW
+#define MoveFileEx MoveFileExW
+
+#define COINIT_MULTITHREADED 0x0
+
+inline HRESULT CoInitializeEx(_In_opt_ void* pvReserved, _In_ DWORD dwCoInit)
+{
+    UNREFERENCED_PARAMETER(pvReserved);
+    UNREFERENCED_PARAMETER(dwCoInit);
+
+    return S_FALSE;
+}
+
+inline void CoUninitialize()
+{
+}
+
+struct IUnknown
+{
+    virtual ULONG AddRef() = 0;
+    virtual ULONG Release() = 0;
+
+protected:
+    ~IUnknown() = default;
+};
\ No newline at end of file
@@ -0,0 +1,95 @@
+/*+===================================================================
+  File:      WRL.H
+
+  Summary:   Stand-in for the Windows Runtime Library header with the
+             part of ComPtr the portable code uses.
+
+  Classes: Microsoft::WRL::ComPtr
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include <windows.h>
+
+#include <cstddef>
+#include <utility>
+
+namespace Microsoft::WRL
+{
+    template <typename T>
+    class ComPtr
+    {
+    public:
+        ComPtr() noexcept : m_ptr(nullptr) {}
+        ComPtr(std::nullptr_t) noexcept : m_ptr(nullptr) {}
+        ComPtr(T* ptr) noexcept : m_ptr(ptr) { addRef(); }
+        ComPtr(const ComPtr& other) noexcept : m_ptr(other.m_ptr) { addRef(); }
+        ComPtr(ComPtr&& other) noexcept : m_ptr(std::exchange(other.m_ptr, nullptr)) {}
+        ~ComPtr() { release(); }
+
+        ComPtr& operator=(ComPtr other) noexcept
+        {
+            std::swap(m_ptr, other.m_ptr);
+            return *this;
+        }
+
+        ComPtr& operator=(std::nullptr_t) noexcept
+        {
+            Reset();
+            return *this;
+        }
+
+        T* Get() const noexcept { return m_ptr; }
+        T* operator->() const noexcept { return m_ptr; }
+        explicit operator bool() const noexcept { return m_ptr != nullptr; }
+
+        T* const* GetAddressOf() const noexcept { return &m_ptr; }
+        T** GetAddressOf() noexcept { return &m_ptr; }
+
+        T** ReleaseAndGetAddressOf() noexcept
+        {
+            Reset();
+            return &m_ptr;
+        }
+
+        void Reset() noexcept
+        {
+            release();
+            m_ptr = nullptr;
+        }
+
+        void Attach(T* ptr) noexcept
+        {
+            release();
+            m_ptr = ptr;
+        }
+
+        T* Detach() noexcept { return std::exchange(m_ptr, nullptr); }
+
+    private:
+        void addRef() const noexcept
+        {
+            if (m_ptr)
+            {
+                m_ptr->AddRef();
+            }
+        }
+
+        void release() noexcept
+        {
+            if (m_ptr)
+            {
+                std::exchange(m_ptr, nullptr)->Release();
+            }
+        }
+
+        T* m_ptr;
+    };
+
+    template <typename T, typename U>
+    bool operator==(const ComPtr<T>& a, const ComPtr<U>& b) noexcept { return a.Get() == b.Get(); }
+
+    template <typename T>
+    bool operator==(const ComPtr<T>& a, std::nullptr_t) noexcept { return a.Get() == nullptr; }
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+#include "Test.h"
+
+#include <cstdio>
+
+namespace test
+{
+    UINT TestRegistry::sm_uNumFailedChecks = 0u;
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TestRegistry::Add
+
+      Summary:  Registers a test, called by TEST_CASE during static
+                initialization
+
+      Args:     PCSTR pszName
+                  Name of the test
+                TestFunction test
+                  Body of the test
+
+      Returns:  BOOL
+                  Always TRUE
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL TestRegistry::Add(_In_ PCSTR pszName, _In_ TestFunction test)
+    {
+        getTests().push_back(Test{ .pszName = pszName, .Run = test });
+
+        return TRUE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TestRegistry::RunAll
+
+      Summary:  Runs every registered test in registration order and
+                prints the result of each
+
+      Modifies: [sm_uNumFailedChecks].
+
+      Returns:  UINT
+                  Number of failed tests
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT TestRegistry::RunAll()
+    {
+        UINT uNumFailedTests = 0u;
+        for (const Test& test : getTests())
+        {
+            sm_uNumFailedChecks = 0u;
+            test.Run();
+
+            uNumFailedTests += sm_uNumFailedChecks > 0u ? 1u : 0u;
+            std::printf("%s %s\n", sm_uNumFailedChecks > 0u ? "FAILED" : "passed", test.pszName);
+        }
+
+        std::printf("%zu tests, %u failed\n", getTests().size(), uNumFailedTests);
+
+        return uNumFailedTests;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TestRegistry::Fail
+
+      Summary:  Prints a failed check and marks the running test as
+                failed
+
+      Args:     PCSTR pszFile
+                  Source file of the check
+                INT iLine
+                  Line of the check
+                PCSTR pszExpression
+                  Checked expression
+
+      Modifies: [sm_uNumFailedChecks].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TestRegistry::Fail(_In_ PCSTR pszFile, _In_ INT iLine, _In_ PCSTR pszExpression)
+    {
+        ++sm_uNumFailedChecks;
+        std::printf("%s(%d): CHECK(%s) failed\n", pszFile, iLine, pszExpression);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TestRegistry::getTests
+
+      Summary:  Returns the registered tests. A function local static,
+                so tests in other translation units can register
+                before it would otherwise be constructed
+
+      Returns:  std::vector<Test>&
+                  Registered tests
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    std::vector<TestRegistry::Test>& TestRegistry::getTests()
+    {
+        static std::vector<Test> s_aTests;
+
+        return s_aTests;
+    }
+}
\ No newline at end of file
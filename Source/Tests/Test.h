@@ -0,0 +1,84 @@
+/*+===================================================================
+  File:      TEST.H
+
+  Summary:   Test header file contains declarations of the
+             TestRegistry class that collects and runs the unit tests,
+             and of the macros the tests are written with.
+
+  Classes: TestRegistry
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include <cmath>
+#include <functional>
+
+namespace test
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    TestRegistry
+
+      Summary:  Unit tests registered by TEST_CASE before main runs.
+                A test fails if any of its CHECKs fails, the remaining
+                checks and tests still run
+
+      Methods:  Add
+                  Registers a test
+                RunAll
+                  Runs every test and prints the failures
+                Fail
+                  Records a failed check of the running test
+                TestRegistry
+                  Constructor.
+                ~TestRegistry
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class TestRegistry final
+    {
+    public:
+        using TestFunction = void (*)();
+
+        TestRegistry() = delete;
+        TestRegistry(const TestRegistry& other) = delete;
+        TestRegistry(TestRegistry&& other) = delete;
+        TestRegistry& operator=(const TestRegistry& other) = delete;
+        TestRegistry& operator=(TestRegistry&& other) = delete;
+        ~TestRegistry() = delete;
+
+        static BOOL Add(_In_ PCSTR pszName, _In_ TestFunction test);
+        static UINT RunAll();
+        static void Fail(_In_ PCSTR pszFile, _In_ INT iLine, _In_ PCSTR pszExpression);
+
+    private:
+        struct Test
+        {
+            PCSTR pszName;
+            TestFunction Run;
+        };
+
+        static std::vector<Test>& getTests();
+
+        static UINT sm_uNumFailedChecks;
+    };
+}
+
+#define TEST_CASE(name) \
+    static void name(); \
+    static const BOOL name##Registered = test::TestRegistry::Add(#name, name); \
+    static void name()
+
+#define CHECK(expression) \
+    do \
+    { \
+        if (!(expression)) \
+        { \
+            test::TestRegistry::Fail(__FILE__, __LINE__, #expression); \
+        } \
+    } while (false)
+
+#define CHECK_EQUAL(expected, actual) CHECK((expected) == (actual))
+
+#define CHECK_CLOSE(expected, actual, tolerance) CHECK(std::fabs((expected) - (actual)) <= (tolerance))
\ No newline at end of file
@@ -0,0 +1,67 @@
+#include "Test.h"
+
+#include "Model/Model.h"
+#include "Texture/TextureCache.h"
+
+using namespace library;
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: collectTextures
+
+  Summary:  Adds the textures of every material of a model and their
+            paths to the given sets
+
+  Args:     const Model& model
+              Loaded model
+            std::unordered_set<const Texture*>& textures
+              Distinct texture objects
+            std::unordered_set<std::wstring>& paths
+              Distinct lexically normal texture paths
+-----------------------------------------------------------------F-F*/
+static void collectTextures(
+    _In_ const Model& model,
+    _Inout_ std::unordered_set<const Texture*>& textures,
+    _Inout_ std::unordered_set<std::wstring>& paths
+)
+{
+    for (UINT i = 0u; i < model.GetNumMaterials(); ++i)
+    {
+        const std::shared_ptr<Material>& material = model.GetMaterial(i);
+        for (const std::shared_ptr<Texture>& texture : { material->pDiffuse, material->pSpecularExponent, material->pNormal })
+        {
+            if (texture)
+            {
+                textures.insert(texture.get());
+                paths.insert(texture->GetFilePath().lexically_normal().wstring());
+            }
+        }
+    }
+}
+
+TEST_CASE(CreatesEachNanosuitTextureOnce)
+{
+    TextureCache::Clear();
+    Model::SetCacheEnabled(FALSE);
+
+    Model first(L"Content/Nanosuit/nanosuit.obj");
+    Model second(L"Content/Nanosuit/nanosuit.obj");
+    CHECK(SUCCEEDED(first.Load()));
+    UINT uNumFirstMisses = TextureCache::GetNumMisses();
+    CHECK(SUCCEEDED(second.Load()));
+
+    std::unordered_set<const Texture*> textures;
+    std::unordered_set<std::wstring> paths;
+    collectTextures(first, textures, paths);
+    collectTextures(second, textures, paths);
+
+    // One texture object per file, created by the first model and reused by the second
+    CHECK(!paths.empty());
+    CHECK_EQUAL(paths.size(), textures.size());
+    CHECK_EQUAL(static_cast<UINT>(paths.size()), uNumFirstMisses);
+    CHECK_EQUAL(uNumFirstMisses, TextureCache::GetNumMisses());
+    CHECK_EQUAL(uNumFirstMisses, TextureCache::GetNumEntries());
+    CHECK(TextureCache::GetNumHits() >= uNumFirstMisses);
+
+    Model::SetCacheEnabled(TRUE);
+    TextureCache::Clear();
+}
\ No newline at end of file
@@ -0,0 +1,534 @@
+#include "Test.h"
+
+#include "Texture/DDSParser.h"
+#include "Texture/TextureCooker.h"
+
+#include <cfloat>
+#include <climits>
+#include <cmath>
+
+using namespace library;
+
+// Size of the test images, several blocks wide so the blocks differ
+constexpr UINT IMAGE_SIZE = 32u;
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: makeColorImage
+
+  Summary:  Returns an image of smooth color gradients with a little
+            deterministic noise, like a photographed texture
+
+  Args:     BOOL bAlpha
+              Whether alpha is a gradient too, otherwise it is opaque
+
+  Returns:  std::vector<BYTE>
+              RGBA8 pixels of an IMAGE_SIZE square image
+-----------------------------------------------------------------F-F*/
+static std::vector<BYTE> makeColorImage(_In_ BOOL bAlpha)
+{
+    std::vector<BYTE> aPixels(IMAGE_SIZE * IMAGE_SIZE * 4u);
+
+    UINT uSeed = 12345u;
+    for (UINT y = 0u; y < IMAGE_SIZE; ++y)
+    {
+        for (UINT x = 0u; x < IMAGE_SIZE; ++x)
+        {
+            BYTE* pTexel = aPixels.data() + (y * IMAGE_SIZE + x) * 4u;
+            for (UINT c = 0u; c < 4u; ++c)
+            {
+                uSeed = uSeed * 1664525u + 1013904223u;
+                INT iNoise = static_cast<INT>(uSeed >> 29u) - 4;
+
+                INT iGradient = c == 0u ? static_cast<INT>(x * 8u) : (c == 1u ? static_cast<INT>(y * 8u) : static_cast<INT>((x + y) * 4u));
+                INT iValue = iGradient + iNoise;
+                pTexel[c] = static_cast<BYTE>(iValue < 0 ? 0 : (iValue > 255 ? 255 : iValue));
+            }
+
+            if (!bAlpha)
+            {
+                pTexel[3] = 0xFFu;
+            }
+        }
+    }
+
+    return aPixels;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: makeNormalImage
+
+  Summary:  Returns a normal map of smooth bumps, every normal of unit
+            length pointing out of the surface
+
+  Returns:  std::vector<BYTE>
+              RGBA8 pixels of an IMAGE_SIZE square image
+-----------------------------------------------------------------F-F*/
+static std::vector<BYTE> makeNormalImage()
+{
+    std::vector<BYTE> aPixels(IMAGE_SIZE * IMAGE_SIZE * 4u);
+
+    for (UINT y = 0u; y < IMAGE_SIZE; ++y)
+    {
+        for (UINT x = 0u; x < IMAGE_SIZE; ++x)
+        {
+            XMVECTOR normal = XMVector3Normalize(XMVectorSet(
+                0.6f * std::sin(static_cast<FLOAT>(x) * 0.4f),
+                0.6f * std::cos(static_cast<FLOAT>(y) * 0.3f),
+                1.0f,
+                0.0f
+            ));
+
+            BYTE* pTexel = aPixels.data() + (y * IMAGE_SIZE + x) * 4u;
+            pTexel[0] = static_cast<BYTE>(XMVectorGetX(normal) * 127.5f + 128.0f);
+            pTexel[1] = static_cast<BYTE>(XMVectorGetY(normal) * 127.5f + 128.0f);
+            pTexel[2] = static_cast<BYTE>(XMVectorGetZ(normal) * 127.5f + 128.0f);
+            pTexel[3] = 0xFFu;
+        }
+    }
+
+    return aPixels;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: decodeColorBlock
+
+  Summary:  Decodes a BC1 block the way the GPU does, leaving alpha
+
+  Args:     const BYTE* pBlock
+              BC1 block
+            BYTE* pOutTexels
+              RGBA8 texels of the block in rows
+-----------------------------------------------------------------F-F*/
+static void decodeColorBlock(_In_reads_bytes_(8) const BYTE* pBlock, _Out_writes_(64) BYTE* pOutTexels)
+{
+    WORD auColors[2];
+    UINT uIndices;
+    memcpy(auColors, pBlock, sizeof(auColors));
+    memcpy(&uIndices, pBlock + 4u, sizeof(uIndices));
+
+    INT aaiPalette[4][3];
+    for (UINT uEndpoint = 0u; uEndpoint < 2u; ++uEndpoint)
+    {
+        UINT uRed = (auColors[uEndpoint] >> 11u) & 0x1Fu;
+        UINT uGreen = (auColors[uEndpoint] >> 5u) & 0x3Fu;
+        UINT uBlue = auColors[uEndpoint] & 0x1Fu;
+        aaiPalette[uEndpoint][0] = static_cast<INT>((uRed << 3u) | (uRed >> 2u));
+        aaiPalette[uEndpoint][1] = static_cast<INT>((uGreen << 2u) | (uGreen >> 4u));
+        aaiPalette[uEndpoint][2] = static_cast<INT>((uBlue << 3u) | (uBlue >> 2u));
+    }
+
+    for (UINT c = 0u; c < 3u; ++c)
+    {
+        if (auColors[0] > auColors[1])
+        {
+            aaiPalette[2][c] = (2 * aaiPalette[0][c] + aaiPalette[1][c]) / 3;
+            aaiPalette[3][c] = (aaiPalette[0][c] + 2 * aaiPalette[1][c]) / 3;
+        }
+        else
+        {
+            aaiPalette[2][c] = (aaiPalette[0][c] + aaiPalette[1][c]) / 2;
+            aaiPalette[3][c] = 0;
+        }
+    }
+
+    for (UINT i = 0u; i < 16u; ++i)
+    {
+        UINT uIndex = (uIndices >> (2u * i)) & 3u;
+        for (UINT c = 0u; c < 3u; ++c)
+        {
+            pOutTexels[i * 4u + c] = static_cast<BYTE>(aaiPalette[uIndex][c]);
+        }
+    }
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: decodeChannelBlock
+
+  Summary:  Decodes a BC4 block into one channel of the texels
+
+  Args:     const BYTE* pBlock
+              BC4 block
+            UINT uChannel
+              Channel to write
+            BYTE* pOutTexels
+              RGBA8 texels of the block in rows
+-----------------------------------------------------------------F-F*/
+static void decodeChannelBlock(_In_reads_bytes_(8) const BYTE* pBlock, _In_ UINT uChannel, _Out_writes_(64) BYTE* pOutTexels)
+{
+    UINT64 uIndices = 0ull;
+    memcpy(&uIndices, pBlock + 2u, 6u);
+
+    INT aiPalette[8];
+    aiPalette[0] = pBlock[0];
+    aiPalette[1] = pBlock[1];
+    for (INT iIndex = 2; iIndex < 8; ++iIndex)
+    {
+        if (aiPalette[0] > aiPalette[1])
+        {
+            aiPalette[iIndex] = ((8 - iIndex) * aiPalette[0] + (iIndex - 1) * aiPalette[1]) / 7;
+        }
+        else
+        {
+            aiPalette[iIndex] = iIndex < 6 ? ((6 - iIndex) * aiPalette[0] + (iIndex - 1) * aiPalette[1]) / 5 : (iIndex == 6 ? 0 : 255);
+        }
+    }
+
+    for (UINT i = 0u; i < 16u; ++i)
+    {
+        pOutTexels[i * 4u + uChannel] = static_cast<BYTE>(aiPalette[(uIndices >> (3u * i)) & 7u]);
+    }
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: decodeBC7Block
+
+  Summary:  Decodes a BC7 block in mode 6, the only mode the cooker
+            writes
+
+  Args:     const BYTE* pBlock
+              BC7 block
+            BYTE* pOutTexels
+              RGBA8 texels of the block in rows
+
+  Returns:  BOOL
+              TRUE if the block is in mode 6
+-----------------------------------------------------------------F-F*/
+static BOOL decodeBC7Block(_In_reads_bytes_(16) const BYTE* pBlock, _Out_writes_(64) BYTE* pOutTexels)
+{
+    static constexpr INT s_aiWeights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+    UINT uOffset = 0u;
+    auto readBits = [pBlock, &uOffset](UINT uNumBits)
+    {
+        UINT uValue = 0u;
+        for (UINT i = 0u; i < uNumBits; ++i, ++uOffset)
+        {
+            uValue |= static_cast<UINT>((pBlock[uOffset / 8u] >> (uOffset % 8u)) & 1u) << i;
+        }
+
+        return uValue;
+    };
+
+    if (readBits(7u) != 1u << 6u)
+    {
+        return FALSE;
+    }
+
+    INT aaiEndpoints[2][4];
+    for (UINT c = 0u; c < 4u; ++c)
+    {
+        aaiEndpoints[0][c] = static_cast<INT>(readBits(7u));
+        aaiEndpoints[1][c] = static_cast<INT>(readBits(7u));
+    }
+    for (UINT uEndpoint = 0u; uEndpoint < 2u; ++uEndpoint)
+    {
+        INT iPBit = static_cast<INT>(readBits(1u));
+        for (INT& iValue : aaiEndpoints[uEndpoint])
+        {
+            iValue = (iValue << 1) | iPBit;
+        }
+    }
+
+    for (UINT i = 0u; i < 16u; ++i)
+    {
+        INT iWeight = s_aiWeights[readBits(i == 0u ? 3u : 4u)];
+        for (UINT c = 0u; c < 4u; ++c)
+        {
+            pOutTexels[i * 4u + c] = static_cast<BYTE>(((64 - iWeight) * aaiEndpoints[0][c] + iWeight * aaiEndpoints[1][c] + 32) >> 6);
+        }
+    }
+
+    return TRUE;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: encodeAndDecode
+
+  Summary:  Compresses an IMAGE_SIZE square image and decodes it back.
+            Channels a format does not store come back as 0, and
+            alpha as 255 when it is not stored
+
+  Args:     eTextureFormat format
+              BC format
+            const std::vector<BYTE>& aPixels
+              RGBA8 pixels of the image
+
+  Returns:  std::vector<BYTE>
+              Decoded RGBA8 pixels, empty if a block does not decode
+-----------------------------------------------------------------F-F*/
+static std::vector<BYTE> encodeAndDecode(_In_ eTextureFormat format, _In_ const std::vector<BYTE>& aPixels)
+{
+    constexpr UINT NUM_BLOCKS = IMAGE_SIZE / TextureCooker::BLOCK_DIMENSION;
+
+    std::vector<BYTE> aBlocks;
+    TextureCooker::EncodeBlocks(format, IMAGE_SIZE, IMAGE_SIZE, aPixels.data(), aBlocks);
+    if (aBlocks.size() != NUM_BLOCKS * NUM_BLOCKS * TextureCooker::GetBlockSize(format))
+    {
+        return std::vector<BYTE>();
+    }
+
+    std::vector<BYTE> aDecoded(aPixels.size());
+    const BYTE* pBlock = aBlocks.data();
+    for (UINT uBlockY = 0u; uBlockY < NUM_BLOCKS; ++uBlockY)
+    {
+        for (UINT uBlockX = 0u; uBlockX < NUM_BLOCKS; ++uBlockX)
+        {
+            BYTE aTexels[64] = {};
+            for (UINT i = 0u; i < 16u; ++i)
+            {
+                aTexels[i * 4u + 3u] = 0xFFu;
+            }
+
+            switch (format)
+            {
+            case eTextureFormat::BC1:
+                decodeColorBlock(pBlock, aTexels);
+                break;
+            case eTextureFormat::BC3:
+                decodeChannelBlock(pBlock, 3u, aTexels);
+                decodeColorBlock(pBlock + 8u, aTexels);
+                break;
+            case eTextureFormat::BC5:
+                decodeChannelBlock(pBlock, 0u, aTexels);
+                decodeChannelBlock(pBlock + 8u, 1u, aTexels);
+                break;
+            case eTextureFormat::BC7:
+                if (!decodeBC7Block(pBlock, aTexels))
+                {
+                    return std::vector<BYTE>();
+                }
+                break;
+            default:
+                return std::vector<BYTE>();
+            }
+            pBlock += TextureCooker::GetBlockSize(format);
+
+            for (UINT y = 0u; y < TextureCooker::BLOCK_DIMENSION; ++y)
+            {
+                size_t uRow = uBlockY * TextureCooker::BLOCK_DIMENSION + y;
+                memcpy(
+                    aDecoded.data() + (uRow * IMAGE_SIZE + uBlockX * TextureCooker::BLOCK_DIMENSION) * 4u,
+                    aTexels + y * TextureCooker::BLOCK_DIMENSION * 4u,
+                    TextureCooker::BLOCK_DIMENSION * 4u
+                );
+            }
+        }
+    }
+
+    return aDecoded;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: measureError
+
+  Summary:  Compares the given channels of two images
+
+  Args:     const std::vector<BYTE>& aExpected
+              RGBA8 pixels of the source image
+            const std::vector<BYTE>& aActual
+              RGBA8 pixels of the decoded image
+            UINT uFirstChannel
+              First channel compared
+            UINT uNumChannels
+              Number of channels compared
+            FLOAT& outRootMeanSquare
+              Root mean square of the differences
+
+  Returns:  INT
+              Largest difference
+-----------------------------------------------------------------F-F*/
+static INT measureError(
+    _In_ const std::vector<BYTE>& aExpected,
+    _In_ const std::vector<BYTE>& aActual,
+    _In_ UINT uFirstChannel,
+    _In_ UINT uNumChannels,
+    _Out_ FLOAT& outRootMeanSquare
+)
+{
+    outRootMeanSquare = FLT_MAX;
+    if (aActual.size() != aExpected.size())
+    {
+        return INT_MAX;
+    }
+
+    INT iMaxError = 0;
+    DOUBLE sumOfSquares = 0.0;
+    for (size_t i = 0u; i < aExpected.size(); i += 4u)
+    {
+        for (UINT c = uFirstChannel; c < uFirstChannel + uNumChannels; ++c)
+        {
+            INT iError = std::abs(static_cast<INT>(aExpected[i + c]) - static_cast<INT>(aActual[i + c]));
+            iMaxError = iError > iMaxError ? iError : iMaxError;
+            sumOfSquares += static_cast<DOUBLE>(iError * iError);
+        }
+    }
+    outRootMeanSquare = static_cast<FLOAT>(std::sqrt(sumOfSquares / static_cast<DOUBLE>(aExpected.size() / 4u * uNumChannels)));
+
+    return iMaxError;
+}
+
+TEST_CASE(TextureCookerSolidBlocksKeepTheirColor)
+{
+    // Only the endpoint precision is lost: 5:6:5 bits in BC1, 7 bits and a p-bit in BC7
+    std::vector<BYTE> aPixels(IMAGE_SIZE * IMAGE_SIZE * 4u);
+    for (size_t i = 0u; i < aPixels.size(); i += 4u)
+    {
+        aPixels[i] = 93u;
+        aPixels[i + 1u] = 180u;
+        aPixels[i + 2u] = 37u;
+        aPixels[i + 3u] = 201u;
+    }
+
+    FLOAT rootMeanSquare;
+    CHECK(measureError(aPixels, encodeAndDecode(eTextureFormat::BC1, aPixels), 0u, 3u, rootMeanSquare) <= 4);
+    CHECK_EQUAL(0, measureError(aPixels, encodeAndDecode(eTextureFormat::BC3, aPixels), 3u, 1u, rootMeanSquare));
+    CHECK_EQUAL(0, measureError(aPixels, encodeAndDecode(eTextureFormat::BC5, aPixels), 0u, 2u, rootMeanSquare));
+    CHECK(measureError(aPixels, encodeAndDecode(eTextureFormat::BC7, aPixels), 0u, 4u, rootMeanSquare) <= 1);
+}
+
+TEST_CASE(TextureCookerColorRoundTripsStayClose)
+{
+    // Bounds a little above what the encoders reach, the blocks hold two dimensional gradients no endpoint line fits exactly
+    std::vector<BYTE> aOpaque = makeColorImage(FALSE);
+    std::vector<BYTE> aTranslucent = makeColorImage(TRUE);
+
+    FLOAT rootMeanSquare;
+    CHECK(measureError(aOpaque, encodeAndDecode(eTextureFormat::BC1, aOpaque), 0u, 3u, rootMeanSquare) <= 24);
+    CHECK(rootMeanSquare <= 7.0f);
+
+    std::vector<BYTE> aDecoded = encodeAndDecode(eTextureFormat::BC3, aTranslucent);
+    CHECK(measureError(aTranslucent, aDecoded, 0u, 3u, rootMeanSquare) <= 24);
+    CHECK(rootMeanSquare <= 7.0f);
+    CHECK(measureError(aTranslucent, aDecoded, 3u, 1u, rootMeanSquare) <= 3);
+    CHECK(rootMeanSquare <= 1.5f);
+
+    // BC7 fits all four channels with one line and still beats BC1 on color alone
+    CHECK(measureError(aTranslucent, encodeAndDecode(eTextureFormat::BC7, aTranslucent), 0u, 4u, rootMeanSquare) <= 20);
+    CHECK(rootMeanSquare <= 5.5f);
+}
+
+TEST_CASE(TextureCookerBC5KeepsTheNormals)
+{
+    std::vector<BYTE> aPixels = makeNormalImage();
+    std::vector<BYTE> aDecoded = encodeAndDecode(eTextureFormat::BC5, aPixels);
+
+    FLOAT rootMeanSquare;
+    CHECK(measureError(aPixels, aDecoded, 0u, 2u, rootMeanSquare) <= 6);
+    CHECK(rootMeanSquare <= 2.5f);
+
+    // The shaders rebuild z from x and y, the rebuilt normals stay within four degrees
+    FLOAT minCosine = 1.0f;
+    for (size_t i = 0u; i < aPixels.size(); i += 4u)
+    {
+        XMVECTOR expected = XMVectorSet(aPixels[i] / 127.5f - 1.0f, aPixels[i + 1u] / 127.5f - 1.0f, aPixels[i + 2u] / 127.5f - 1.0f, 0.0f);
+        FLOAT x = aDecoded[i] / 127.5f - 1.0f;
+        FLOAT y = aDecoded[i + 1u] / 127.5f - 1.0f;
+        XMVECTOR actual = XMVectorSet(x, y, std::sqrt(std::fmax(1.0f - x * x - y * y, 0.0f)), 0.0f);
+
+        FLOAT cosine = XMVectorGetX(XMVector3Dot(XMVector3Normalize(expected), XMVector3Normalize(actual)));
+        minCosine = cosine < minCosine ? cosine : minCosine;
+    }
+    CHECK(minCosine >= std::cos(4.0f * XM_PI / 180.0f));
+}
+
+TEST_CASE(TextureCookerAveragesColorMipsInLinearSpace)
+{
+    // Black and white texels with transparent and opaque alpha, the last column repeated
+    const std::vector<BYTE> aPixels =
+    {
+        0u, 0u, 0u, 0u,  255u, 255u, 255u, 255u,  0u, 0u, 0u, 0u,
+        255u, 255u, 255u, 255u,  0u, 0u, 0u, 0u,  255u, 255u, 255u, 255u,
+    };
+
+    std::vector<std::vector<BYTE>> aMips;
+    TextureCooker::GenerateMips(3u, 2u, aPixels, FALSE, aMips);
+    CHECK_EQUAL(2u, aMips.size());
+    CHECK(aMips[0] == aPixels);
+    CHECK_EQUAL(4u, aMips[1].size());
+
+    // Half the light is 188 in sRGB, averaging the encoded values would darken it to 128
+    CHECK_EQUAL(188u, aMips[1][0]);
+    CHECK_EQUAL(188u, aMips[1][1]);
+    CHECK_EQUAL(188u, aMips[1][2]);
+    CHECK_EQUAL(128u, aMips[1][3]);
+
+    // Down to one texel, each side halved until it is one
+    TextureCooker::GenerateMips(8u, 2u, std::vector<BYTE>(8u * 2u * 4u, 0x80u), FALSE, aMips);
+    CHECK_EQUAL(4u, aMips.size());
+    CHECK_EQUAL(4u * 1u * 4u, aMips[1].size());
+    CHECK_EQUAL(2u * 1u * 4u, aMips[2].size());
+    CHECK_EQUAL(1u * 1u * 4u, aMips[3].size());
+    CHECK(aMips[3] == std::vector<BYTE>(4u, 0x80u));
+}
+
+TEST_CASE(TextureCookerRenormalizesNormalMips)
+{
+    // Normals tilted 60 degrees to either side of +z, their box average would shorten to half
+    const std::vector<BYTE> aPixels =
+    {
+        238u, 128u, 192u, 255u,  18u, 128u, 192u, 255u,
+        18u, 128u, 192u, 255u,  238u, 128u, 192u, 255u,
+    };
+
+    std::vector<std::vector<BYTE>> aMips;
+    TextureCooker::GenerateMips(2u, 2u, aPixels, TRUE, aMips);
+    CHECK_EQUAL(2u, aMips.size());
+    CHECK(std::abs(static_cast<INT>(aMips[1][0]) - 128) <= 1);
+    CHECK(std::abs(static_cast<INT>(aMips[1][1]) - 128) <= 1);
+    CHECK_EQUAL(255u, aMips[1][2]);
+    CHECK_EQUAL(255u, aMips[1][3]);
+
+    // Every level of a bumpy map keeps unit normals
+    TextureCooker::GenerateMips(IMAGE_SIZE, IMAGE_SIZE, makeNormalImage(), TRUE, aMips);
+    for (const std::vector<BYTE>& aMip : aMips)
+    {
+        for (size_t i = 0u; i < aMip.size(); i += 4u)
+        {
+            XMVECTOR normal = XMVectorSet(aMip[i] / 127.5f - 1.0f, aMip[i + 1u] / 127.5f - 1.0f, aMip[i + 2u] / 127.5f - 1.0f, 0.0f);
+            CHECK_CLOSE(1.0f, XMVectorGetX(XMVector3Length(normal)), 0.02f);
+        }
+    }
+}
+
+TEST_CASE(TextureCookerCooksEveryMipIntoTheDDS)
+{
+    std::vector<BYTE> aFile;
+    CHECK_EQUAL(E_INVALIDARG, TextureCooker::Cook(L"Bricks.png", 1ull, 6u, 6u, std::vector<BYTE>(6u * 6u * 4u), aFile));
+
+    // Normal maps are told apart by name, opaque colors use BC1 and translucent ones BC3
+    const struct
+    {
+        PCWSTR pszFileName;
+        BOOL bAlpha;
+        eDDSFormat format;
+    } aCases[] =
+    {
+        { L"Bricks_ddn.png", FALSE, eDDSFormat::BC5_UNORM },
+        { L"Bricks.png", FALSE, eDDSFormat::BC1_UNORM },
+        { L"Leaves.png", TRUE, eDDSFormat::BC3_UNORM },
+    };
+
+    for (const auto& testCase : aCases)
+    {
+        std::vector<BYTE> aPixels = makeColorImage(testCase.bAlpha);
+        CHECK_EQUAL(S_OK, TextureCooker::Cook(testCase.pszFileName, 1ull, IMAGE_SIZE, IMAGE_SIZE, aPixels, aFile));
+
+        DDSTextureInfo info;
+        std::vector<DDSSurface> surfaces;
+        CHECK(DDSParser::ParseHeader(aFile.data(), aFile.size(), info) == eDDSStatus::OK);
+        CHECK(DDSParser::GetSurfaces(info, aFile.size(), surfaces) == eDDSStatus::OK);
+        CHECK(info.format == testCase.format);
+        CHECK_EQUAL(IMAGE_SIZE, info.uWidth);
+        CHECK_EQUAL(6u, info.uNumMips);
+        CHECK_EQUAL(6u, surfaces.size());
+        CHECK_EQUAL(aFile.size(), surfaces.back().uOffset + surfaces.back().uNumBytes);
+    }
+
+    TextureCooker::SetHighQuality(TRUE);
+    CHECK_EQUAL(S_OK, TextureCooker::Cook(L"Bricks.png", 1ull, IMAGE_SIZE, IMAGE_SIZE, makeColorImage(FALSE), aFile));
+    TextureCooker::SetHighQuality(FALSE);
+
+    DDSTextureInfo info;
+    CHECK(DDSParser::ParseHeader(aFile.data(), aFile.size(), info) == eDDSStatus::OK);
+    CHECK(info.format == eDDSFormat::BC7_UNORM);
+}
\ No newline at end of file
@@ -0,0 +1,175 @@
+#include "Test.h"
+
+#include "Texture/TextureResidency.h"
+
+using namespace library;
+
+// Bytes of the last level of every test texture, each finer level is four times larger
+constexpr UINT64 LAST_MIP_SIZE = 16ull;
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: makeEntry
+
+  Summary:  Returns the state of a square streamed texture
+
+  Args:     UINT uNumMips
+              Number of levels
+            UINT uTailMip
+              First level that is always resident
+            UINT uResidentMip
+              Most detailed level in memory
+            UINT uDesiredMip
+              Level the screen size asks for
+            UINT64 uLastUsedFrame
+              Frame the texture was last drawn
+
+  Returns:  TextureResidencyEntry
+              Streamed texture
+-----------------------------------------------------------------F-F*/
+static TextureResidencyEntry makeEntry(
+    _In_ UINT uNumMips,
+    _In_ UINT uTailMip,
+    _In_ UINT uResidentMip,
+    _In_ UINT uDesiredMip,
+    _In_ UINT64 uLastUsedFrame
+)
+{
+    TextureResidencyEntry entry =
+    {
+        .uNumMips = uNumMips,
+        .uTailMip = uTailMip,
+        .uResidentMip = uResidentMip,
+        .uDesiredMip = uDesiredMip,
+        .uLastUsedFrame = uLastUsedFrame,
+        .auMipSizes = {}
+    };
+    for (UINT uMip = 0u; uMip < uNumMips; ++uMip)
+    {
+        entry.auMipSizes[uMip] = LAST_MIP_SIZE << (2u * (uNumMips - 1u - uMip));
+    }
+
+    return entry;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: getTotalSize
+
+  Summary:  Returns the bytes the textures take at the given levels
+
+  Args:     const std::vector<TextureResidencyEntry>& aEntries
+              Streamed textures
+            const std::vector<UINT>& aMips
+              Most detailed resident level of every texture
+
+  Returns:  UINT64
+              Size in bytes
+-----------------------------------------------------------------F-F*/
+static UINT64 getTotalSize(_In_ const std::vector<TextureResidencyEntry>& aEntries, _In_ const std::vector<UINT>& aMips)
+{
+    UINT64 uSize = 0ull;
+    for (size_t i = 0u; i < aEntries.size(); ++i)
+    {
+        uSize += TextureResidency::GetResidentSize(aEntries[i], aMips[i]);
+    }
+
+    return uSize;
+}
+
+TEST_CASE(ComputesTheDesiredMipFromTheScreenSize)
+{
+    CHECK_EQUAL(0u, TextureResidency::ComputeDesiredMip(1024u, 512u, 11u, 2048.0f));
+    CHECK_EQUAL(0u, TextureResidency::ComputeDesiredMip(1024u, 512u, 11u, 1024.0f));
+    CHECK_EQUAL(1u, TextureResidency::ComputeDesiredMip(1024u, 512u, 11u, 512.0f));
+    CHECK_EQUAL(1u, TextureResidency::ComputeDesiredMip(1024u, 512u, 11u, 300.0f));
+    CHECK_EQUAL(10u, TextureResidency::ComputeDesiredMip(1024u, 512u, 11u, 1.0f));
+
+    // Textures out of view or smaller than a pixel keep only their last level
+    CHECK_EQUAL(10u, TextureResidency::ComputeDesiredMip(1024u, 512u, 11u, 0.0f));
+    CHECK_EQUAL(10u, TextureResidency::ComputeDesiredMip(1024u, 512u, 11u, 0.01f));
+}
+
+TEST_CASE(KeepsFinerResidentLevelsWithinTheBudget)
+{
+    const std::vector<TextureResidencyEntry> aEntries =
+    {
+        makeEntry(8u, 5u, 0u, 3u, 10ull),
+        makeEntry(8u, 5u, 5u, 2u, 10ull)
+    };
+
+    std::vector<UINT> aMips;
+    const UINT64 uSize = TextureResidency::Resolve(aEntries, ~0ull, 10ull, aMips);
+    CHECK(aMips == std::vector<UINT>({ 0u, 2u }));
+    CHECK_EQUAL(getTotalSize(aEntries, aMips), uSize);
+}
+
+TEST_CASE(ClampsTheTargetMipToTheTail)
+{
+    // The desired level is past the tail, the tail stays even with no budget at all
+    const std::vector<TextureResidencyEntry> aEntries =
+    {
+        makeEntry(8u, 5u, 5u, 7u, 10ull),
+        makeEntry(8u, 5u, 0u, 7u, 10ull),
+        makeEntry(8u, 5u, 1u, 2u, 10ull)
+    };
+
+    std::vector<UINT> aMips;
+    TextureResidency::Resolve(aEntries, ~0ull, 10ull, aMips);
+    CHECK(aMips == std::vector<UINT>({ 5u, 0u, 1u }));
+
+    const UINT64 uSize = TextureResidency::Resolve(aEntries, 0ull, 10ull, aMips);
+    CHECK(aMips == std::vector<UINT>({ 5u, 5u, 5u }));
+    CHECK_EQUAL(3ull * TextureResidency::GetResidentSize(aEntries[0], 5u), uSize);
+}
+
+TEST_CASE(DropsLevelsOfTheTextureUnusedTheLongestFirst)
+{
+    const std::vector<TextureResidencyEntry> aEntries =
+    {
+        makeEntry(8u, 5u, 0u, 0u, 10ull),
+        makeEntry(8u, 5u, 0u, 0u, 4ull),
+        makeEntry(8u, 5u, 0u, 0u, 7ull)
+    };
+
+    // Room for all but one top level
+    std::vector<UINT> aMips;
+    const UINT64 uBudget = 3ull * TextureResidency::GetResidentSize(aEntries[0], 0u) - aEntries[0].auMipSizes[0];
+    const UINT64 uSize = TextureResidency::Resolve(aEntries, uBudget, 10ull, aMips);
+    CHECK(aMips == std::vector<UINT>({ 0u, 1u, 0u }));
+    CHECK_EQUAL(uBudget, uSize);
+
+    // Without room for the next one either, the oldest keeps losing levels before the next oldest
+    TextureResidency::Resolve(aEntries, uBudget - aEntries[0].auMipSizes[1], 10ull, aMips);
+    CHECK(aMips == std::vector<UINT>({ 0u, 2u, 0u }));
+}
+
+TEST_CASE(DropsTheLargestLevelAmongTexturesUsedAsRecently)
+{
+    const std::vector<TextureResidencyEntry> aEntries =
+    {
+        makeEntry(6u, 4u, 0u, 0u, 10ull),
+        makeEntry(9u, 6u, 0u, 0u, 10ull)
+    };
+
+    std::vector<UINT> aMips;
+    const UINT64 uSize = TextureResidency::Resolve(aEntries, getTotalSize(aEntries, { 0u, 0u }) - 1ull, 10ull, aMips);
+    CHECK(aMips == std::vector<UINT>({ 0u, 1u }));
+    CHECK_EQUAL(getTotalSize(aEntries, aMips), uSize);
+}
+
+TEST_CASE(DropsLevelsFinerThanDesiredBeforeDesiredOnes)
+{
+    // The recent texture keeps levels it no longer needs, the old one needs all of its levels
+    const std::vector<TextureResidencyEntry> aEntries =
+    {
+        makeEntry(8u, 5u, 0u, 2u, 10ull),
+        makeEntry(8u, 5u, 0u, 0u, 1ull)
+    };
+
+    std::vector<UINT> aMips;
+    TextureResidency::Resolve(aEntries, getTotalSize(aEntries, { 0u, 0u }) - 1ull, 10ull, aMips);
+    CHECK(aMips == std::vector<UINT>({ 1u, 0u }));
+
+    // Once the recent texture is down to its desired level, the old one loses its desired levels
+    TextureResidency::Resolve(aEntries, getTotalSize(aEntries, { 2u, 0u }) - 1ull, 10ull, aMips);
+    CHECK(aMips == std::vector<UINT>({ 2u, 1u }));
+}
\ No newline at end of file
@@ -0,0 +1,260 @@
+#include "Test.h"
+
+#include "Scene/TransformHierarchy.h"
+
+#include <numbers>
+
+using namespace library;
+
+// Nodes of the reversed chain, each one the parent of the node added before it
+constexpr UINT NUM_CHAIN_NODES = 8u;
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: getTranslation
+
+  Summary:  Returns the translation of the world matrix of a node
+
+  Args:     const TransformHierarchy& transforms
+              Updated hierarchy
+            UINT uNode
+              Index of the node
+
+  Returns:  XMFLOAT3
+              World position of the node
+-----------------------------------------------------------------F-F*/
+static XMFLOAT3 getTranslation(_In_ const TransformHierarchy& transforms, _In_ UINT uNode)
+{
+    XMFLOAT4X4 world;
+    XMStoreFloat4x4(&world, transforms.GetWorldMatrix(uNode));
+
+    return XMFLOAT3(world(3, 0), world(3, 1), world(3, 2));
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: checkTranslation
+
+  Summary:  Checks the world position of a node
+
+  Args:     const TransformHierarchy& transforms
+              Updated hierarchy
+            UINT uNode
+              Index of the node
+            FLOAT x
+              Expected position along X
+            FLOAT y
+              Expected position along Y
+            FLOAT z
+              Expected position along Z
+-----------------------------------------------------------------F-F*/
+static void checkTranslation(_In_ const TransformHierarchy& transforms, _In_ UINT uNode, _In_ FLOAT x, _In_ FLOAT y, _In_ FLOAT z)
+{
+    const XMFLOAT3 translation = getTranslation(transforms, uNode);
+    CHECK_CLOSE(x, translation.x, 0.0001f);
+    CHECK_CLOSE(y, translation.y, 0.0001f);
+    CHECK_CLOSE(z, translation.z, 0.0001f);
+}
+
+/*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+  Struct:   SampleTree
+
+  Summary:  Nodes of a root with two subtrees: A with the leaves A1
+            and A2, and B with the leaf B1. Every node is offset from
+            its parent along X by a different power of two, so a world
+            position tells which ancestors it went through
+S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+struct SampleTree
+{
+    UINT uRoot;
+    UINT uA;
+    UINT uA1;
+    UINT uA2;
+    UINT uB;
+    UINT uB1;
+};
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: addSampleTree
+
+  Summary:  Adds the sample tree and updates the hierarchy once
+
+  Args:     TransformHierarchy& transforms
+              Hierarchy to add to
+
+  Returns:  SampleTree
+              Indices of the nodes
+-----------------------------------------------------------------F-F*/
+static SampleTree addSampleTree(_Inout_ TransformHierarchy& transforms)
+{
+    SampleTree tree;
+    tree.uRoot = transforms.AddNode(TransformHierarchy::NO_PARENT);
+    tree.uA = transforms.AddNode(tree.uRoot);
+    tree.uB = transforms.AddNode(tree.uRoot);
+    tree.uA1 = transforms.AddNode(tree.uA);
+    tree.uB1 = transforms.AddNode(tree.uB);
+    tree.uA2 = transforms.AddNode(tree.uA);
+
+    transforms.SetTranslation(tree.uRoot, XMFLOAT3(1.0f, 0.0f, 0.0f));
+    transforms.SetTranslation(tree.uA, XMFLOAT3(2.0f, 0.0f, 0.0f));
+    transforms.SetTranslation(tree.uA1, XMFLOAT3(4.0f, 0.0f, 0.0f));
+    transforms.SetTranslation(tree.uA2, XMFLOAT3(8.0f, 0.0f, 0.0f));
+    transforms.SetTranslation(tree.uB, XMFLOAT3(16.0f, 0.0f, 0.0f));
+    transforms.SetTranslation(tree.uB1, XMFLOAT3(32.0f, 0.0f, 0.0f));
+    transforms.Update();
+
+    return tree;
+}
+
+TEST_CASE(TransformUpdateRecomputesOnlyDirtySubtrees)
+{
+    TransformHierarchy transforms;
+    const SampleTree tree = addSampleTree(transforms);
+    CHECK_EQUAL(6u, transforms.GetNumUpdated());
+    checkTranslation(transforms, tree.uA2, 11.0f, 0.0f, 0.0f);
+    checkTranslation(transforms, tree.uB1, 49.0f, 0.0f, 0.0f);
+
+    // Nothing changed
+    transforms.Update();
+    CHECK_EQUAL(0u, transforms.GetNumUpdated());
+
+    std::vector<UINT64> auVersions;
+    for (UINT i = 0u; i < transforms.GetNumNodes(); ++i)
+    {
+        auVersions.push_back(transforms.GetVersion(i));
+    }
+
+    // A and its leaves, the rest keeps its version
+    transforms.SetTranslation(tree.uA, XMFLOAT3(64.0f, 0.0f, 0.0f));
+    transforms.Update();
+    CHECK_EQUAL(3u, transforms.GetNumUpdated());
+    for (UINT uNode : { tree.uA, tree.uA1, tree.uA2 })
+    {
+        CHECK_EQUAL(auVersions[uNode] + 1u, transforms.GetVersion(uNode));
+    }
+    for (UINT uNode : { tree.uRoot, tree.uB, tree.uB1 })
+    {
+        CHECK_EQUAL(auVersions[uNode], transforms.GetVersion(uNode));
+    }
+    checkTranslation(transforms, tree.uA1, 69.0f, 0.0f, 0.0f);
+    checkTranslation(transforms, tree.uB1, 49.0f, 0.0f, 0.0f);
+
+    // A dirty node inside a dirty subtree is recomputed once
+    transforms.SetTranslation(tree.uA1, XMFLOAT3(128.0f, 0.0f, 0.0f));
+    transforms.SetScale(tree.uA, XMFLOAT3(1.0f, 1.0f, 1.0f));
+    transforms.SetRotation(tree.uA1, XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f));
+    transforms.Update();
+    CHECK_EQUAL(3u, transforms.GetNumUpdated());
+    CHECK_EQUAL(auVersions[tree.uA1] + 2u, transforms.GetVersion(tree.uA1));
+    checkTranslation(transforms, tree.uA1, 193.0f, 0.0f, 0.0f);
+
+    // Two separate leaves
+    transforms.SetTranslation(tree.uB1, XMFLOAT3(0.0f, 1.0f, 0.0f));
+    transforms.SetTranslation(tree.uA2, XMFLOAT3(0.0f, 2.0f, 0.0f));
+    transforms.Update();
+    CHECK_EQUAL(2u, transforms.GetNumUpdated());
+    checkTranslation(transforms, tree.uB1, 17.0f, 1.0f, 0.0f);
+    checkTranslation(transforms, tree.uA2, 65.0f, 2.0f, 0.0f);
+
+    // The root covers every node
+    transforms.SetTranslation(tree.uA2, XMFLOAT3(0.0f, 0.0f, 0.0f));
+    transforms.SetTranslation(tree.uRoot, XMFLOAT3(0.0f, 0.0f, 0.0f));
+    transforms.Update();
+    CHECK_EQUAL(6u, transforms.GetNumUpdated());
+    checkTranslation(transforms, tree.uA2, 64.0f, 0.0f, 0.0f);
+}
+
+TEST_CASE(TransformParentsAreFinalBeforeTheirChildren)
+{
+    // Every node becomes the child of the node added after it, so the last node is the root
+    TransformHierarchy transforms;
+    for (UINT i = 0u; i < NUM_CHAIN_NODES; ++i)
+    {
+        transforms.AddNode(TransformHierarchy::NO_PARENT);
+        transforms.SetTranslation(i, XMFLOAT3(0.0f, 1.0f, 0.0f));
+    }
+    for (UINT i = 0u; i + 1u < NUM_CHAIN_NODES; ++i)
+    {
+        CHECK_EQUAL(S_OK, transforms.SetParent(i, i + 1u));
+    }
+    transforms.Update();
+
+    for (UINT i = 0u; i < NUM_CHAIN_NODES; ++i)
+    {
+        checkTranslation(transforms, i, 0.0f, static_cast<FLOAT>(NUM_CHAIN_NODES - i), 0.0f);
+    }
+
+    // Turning the root a quarter around Y carries the whole chain along
+    XMFLOAT4 rotation;
+    XMStoreFloat4(&rotation, XMQuaternionRotationRollPitchYaw(0.0f, std::numbers::pi_v<FLOAT> * 0.5f, 0.0f));
+    transforms.SetRotation(NUM_CHAIN_NODES - 1u, rotation);
+    transforms.SetTranslation(NUM_CHAIN_NODES - 2u, XMFLOAT3(1.0f, 1.0f, 0.0f));
+    transforms.Update();
+    CHECK_EQUAL(NUM_CHAIN_NODES, transforms.GetNumUpdated());
+
+    // The child offset along X of the turned root points along -Z
+    checkTranslation(transforms, NUM_CHAIN_NODES - 2u, 0.0f, 2.0f, -1.0f);
+    checkTranslation(transforms, 0u, 0.0f, static_cast<FLOAT>(NUM_CHAIN_NODES), -1.0f);
+}
+
+TEST_CASE(TransformReparentingMovesTheSubtree)
+{
+    TransformHierarchy transforms;
+    const SampleTree tree = addSampleTree(transforms);
+
+    std::vector<UINT64> auVersions;
+    for (UINT i = 0u; i < transforms.GetNumNodes(); ++i)
+    {
+        auVersions.push_back(transforms.GetVersion(i));
+    }
+
+    // A moves under B with its leaves
+    CHECK_EQUAL(S_OK, transforms.SetParent(tree.uA, tree.uB));
+    CHECK_EQUAL(tree.uB, transforms.GetParent(tree.uA));
+    transforms.Update();
+    CHECK_EQUAL(3u, transforms.GetNumUpdated());
+    checkTranslation(transforms, tree.uA1, 23.0f, 0.0f, 0.0f);
+    checkTranslation(transforms, tree.uA2, 27.0f, 0.0f, 0.0f);
+    for (UINT uNode : { tree.uA, tree.uA1, tree.uA2 })
+    {
+        CHECK_EQUAL(auVersions[uNode] + 1u, transforms.GetVersion(uNode));
+    }
+    for (UINT uNode : { tree.uRoot, tree.uB, tree.uB1 })
+    {
+        CHECK_EQUAL(auVersions[uNode], transforms.GetVersion(uNode));
+    }
+
+    // B now covers A, A1 and A2
+    transforms.SetTranslation(tree.uB, XMFLOAT3(0.0f, 0.0f, 0.0f));
+    transforms.Update();
+    CHECK_EQUAL(5u, transforms.GetNumUpdated());
+    checkTranslation(transforms, tree.uA1, 7.0f, 0.0f, 0.0f);
+
+    // Detaching makes A a root of its own
+    CHECK_EQUAL(S_OK, transforms.SetParent(tree.uA, TransformHierarchy::NO_PARENT));
+    transforms.Update();
+    CHECK_EQUAL(3u, transforms.GetNumUpdated());
+    checkTranslation(transforms, tree.uA, 2.0f, 0.0f, 0.0f);
+    checkTranslation(transforms, tree.uA2, 10.0f, 0.0f, 0.0f);
+
+    // The same parent again changes nothing
+    CHECK_EQUAL(S_OK, transforms.SetParent(tree.uB1, tree.uB));
+    transforms.Update();
+    CHECK_EQUAL(0u, transforms.GetNumUpdated());
+}
+
+TEST_CASE(TransformSetParentRejectsCycles)
+{
+    TransformHierarchy transforms;
+    const SampleTree tree = addSampleTree(transforms);
+
+    CHECK_EQUAL(E_INVALIDARG, transforms.SetParent(tree.uA, tree.uA));
+    CHECK_EQUAL(E_INVALIDARG, transforms.SetParent(tree.uA, tree.uA1));
+    CHECK_EQUAL(E_INVALIDARG, transforms.SetParent(tree.uRoot, tree.uB1));
+    CHECK_EQUAL(E_INVALIDARG, transforms.SetParent(tree.uA, transforms.GetNumNodes()));
+    CHECK_EQUAL(E_INVALIDARG, transforms.SetParent(transforms.GetNumNodes(), tree.uRoot));
+
+    // Nothing moved
+    CHECK_EQUAL(tree.uRoot, transforms.GetParent(tree.uA));
+    CHECK_EQUAL(TransformHierarchy::NO_PARENT, transforms.GetParent(tree.uRoot));
+    transforms.Update();
+    CHECK_EQUAL(0u, transforms.GetNumUpdated());
+}
\ No newline at end of file